@@ -0,0 +1,34 @@
+# - Find LuaJIT
+#
+#  LuaJIT::LuaJIT - Imported target to use for building a library
+#  LUAJIT_FOUND - True if LuaJIT was found.
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_LUAJIT QUIET luajit)
+
+find_path(LUAJIT_INCLUDE_DIR
+  NAMES luajit.h
+  HINTS ${PC_LUAJIT_INCLUDEDIR} ${PC_LUAJIT_INCLUDE_DIRS}
+  PATH_SUFFIXES luajit-2.1 luajit-2.0 luajit
+)
+
+find_library(LUAJIT_LIBRARY
+  NAMES luajit-5.1 luajit lua51
+  HINTS ${PC_LUAJIT_LIBDIR} ${PC_LUAJIT_LIBRARY_DIRS}
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LuaJIT
+  REQUIRED_VARS LUAJIT_LIBRARY LUAJIT_INCLUDE_DIR
+)
+
+if(LUAJIT_FOUND AND NOT TARGET LuaJIT::LuaJIT)
+  add_library(LuaJIT::LuaJIT UNKNOWN IMPORTED)
+  set_target_properties(LuaJIT::LuaJIT PROPERTIES
+    IMPORTED_LOCATION "${LUAJIT_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${LUAJIT_INCLUDE_DIR}"
+    INTERFACE_COMPILE_DEFINITIONS USE_LUAJIT=1
+  )
+endif()
+
+mark_as_advanced(LUAJIT_INCLUDE_DIR LUAJIT_LIBRARY)
@@ -132,6 +132,12 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s[1] = read_buffer((indexR - 2) & INDEX_MASK);
   s[0] = (s[0] * rvolume) >> 8;
   s[1] = (s[1] * lvolume) >> 8;
+
+  // The samples are already clamped, so padding with silence (like all the time for the FIFOs
+  // that aren't in use) doesn't change them.
+  if (s[0] == 0 && s[1] == 0)
+    currentSample = numSamples * 2;
+
   for (; currentSample < numSamples * 2; currentSample += 2)
   {
     int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
@@ -154,7 +160,20 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
-  if (SConfig::GetInstance().m_audio_stretch)
+  // Nothing can be heard, so the samples are dropped instead of being resampled.
+  const SConfig& config = SConfig::GetInstance();
+  if (config.m_IsMuted || config.m_Volume == 0)
+  {
+    m_dma_mixer.DiscardSamples();
+    m_streaming_mixer.DiscardSamples();
+    m_wiimote_speaker_mixer.DiscardSamples();
+    for (auto& mixer : m_gba_mixers)
+      mixer.DiscardSamples();
+    m_is_stretching = false;
+    return num_samples;
+  }
+
+  if (config.m_audio_stretch)
   {
     unsigned int available_samples =
         std::min(m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples());
@@ -415,3 +434,11 @@ unsigned int Mixer::MixerFifo::AvailableSamples() const
     return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
   return (samples_in_fifo - 1) * m_mixer->m_sampleRate / m_input_sample_rate;
 }
+
+void Mixer::MixerFifo::DiscardSamples()
+{
+  // Like Mix, keep the last sample, which the interpolation continues from.
+  const u32 indexW = m_indexW.load();
+  if (((indexW - m_indexR.load()) & INDEX_MASK) > 2)
+    m_indexR.store(indexW - 2);
+}
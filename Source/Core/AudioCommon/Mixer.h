@@ -48,6 +48,10 @@ public:
   void StartLogDSPAudio(const std::string& filename);
   void StopLogDSPAudio();
 
+  // Samples of the DSP audio which haven't been mixed yet, at the DMA input sample rate
+  unsigned int GetBufferedDMASamples() const { return m_dma_mixer.AvailableSamples(); }
+  unsigned int GetDMAInputSampleRate() const { return m_dma_mixer.GetInputSampleRate(); }
+
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
@@ -74,6 +78,7 @@ private:
     unsigned int GetInputSampleRate() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     unsigned int AvailableSamples() const;
+    void DiscardSamples();
 
   private:
     Mixer* m_mixer;
@@ -3,6 +3,8 @@
 
 #include "AudioCommon/WaveFile.h"
 
+#include <algorithm>
+#include <sstream>
 #include <string>
 
 #include "Common/CommonTypes.h"
@@ -12,6 +14,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/ConfigManager.h"
 
 constexpr size_t WaveFileWriter::BUFFER_SIZE;
@@ -26,6 +29,28 @@ WaveFileWriter::~WaveFileWriter()
 }
 
 bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRate)
+{
+  if (!OpenFile(filename, HLESampleRate))
+    return false;
+
+  exit_writer.Clear();
+  writer_thread = std::thread(&WaveFileWriter::WriterThread, this);
+  return true;
+}
+
+void WaveFileWriter::Stop()
+{
+  if (writer_thread.joinable())
+  {
+    exit_writer.Set();
+    queue_event.Set();
+    writer_thread.join();
+  }
+
+  CloseFile();
+}
+
+bool WaveFileWriter::OpenFile(const std::string& filename, unsigned int HLESampleRate)
 {
   // Ask to delete file
   if (File::Exists(filename))
@@ -92,9 +117,11 @@ bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRa
   return true;
 }
 
-void WaveFileWriter::Stop()
+void WaveFileWriter::CloseFile()
 {
-  // u32 file_size = (u32)ftello(file);
+  if (!file)
+    return;
+
   file.Seek(4, SEEK_SET);
   Write(audio_size + 36);
 
@@ -116,11 +143,11 @@ void WaveFileWriter::Write4(const char* ptr)
 
 void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count, int sample_rate)
 {
-  if (!file)
+  if (!writer_thread.joinable())
+  {
     ERROR_LOG_FMT(AUDIO, "WaveFileWriter - file not open.");
-
-  if (count > BUFFER_SIZE * 2)
-    ERROR_LOG_FMT(AUDIO, "WaveFileWriter - buffer too small (count = {}).", count);
+    return;
+  }
 
   if (skip_silence)
   {
@@ -136,23 +163,61 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count, int
       return;
   }
 
-  for (u32 i = 0; i < count; i++)
+  queue.Push(SampleChunk{std::vector<short>(sample_data, sample_data + count * 2), sample_rate});
+  queue_event.Set();
+}
+
+void WaveFileWriter::WriterThread()
+{
+  Common::SetCurrentThreadName("Audio dump writer");
+
+  while (true)
   {
-    // Flip the audio channels from RL to LR
-    conv_buffer[2 * i] = Common::swap16((u16)sample_data[2 * i + 1]);
-    conv_buffer[2 * i + 1] = Common::swap16((u16)sample_data[2 * i]);
+    queue_event.Wait();
+
+    // The exit flag is checked before draining, so that the samples pushed before Stop() are
+    // always written
+    const bool exit = exit_writer.IsSet();
+
+    SampleChunk chunk;
+    while (queue.Pop(chunk))
+      WriteChunk(chunk);
+
+    if (exit)
+      break;
   }
+}
 
-  if (sample_rate != current_sample_rate)
+void WaveFileWriter::WriteChunk(const SampleChunk& chunk)
+{
+  if (chunk.sample_rate != current_sample_rate)
   {
-    Stop();
+    CloseFile();
     file_index++;
     std::ostringstream filename;
     filename << File::GetUserPath(D_DUMPAUDIO_IDX) << basename << file_index << ".wav";
-    Start(filename.str(), sample_rate);
-    current_sample_rate = sample_rate;
+    OpenFile(filename.str(), chunk.sample_rate);
+    current_sample_rate = chunk.sample_rate;
   }
 
-  file.WriteBytes(conv_buffer.data(), count * 4);
-  audio_size += count * 4;
+  if (!file)
+    return;
+
+  const short* sample_data = chunk.samples.data();
+  u32 remaining = static_cast<u32>(chunk.samples.size() / 2);
+  while (remaining != 0)
+  {
+    const u32 count = std::min<u32>(remaining, BUFFER_SIZE / 2);
+    for (u32 i = 0; i < count; i++)
+    {
+      // Flip the audio channels from RL to LR
+      conv_buffer[2 * i] = Common::swap16((u16)sample_data[2 * i + 1]);
+      conv_buffer[2 * i + 1] = Common::swap16((u16)sample_data[2 * i]);
+    }
+
+    file.WriteBytes(conv_buffer.data(), count * 4);
+    audio_size += count * 4;
+    sample_data += count * 2;
+    remaining -= count;
+  }
 }
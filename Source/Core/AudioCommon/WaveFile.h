@@ -8,6 +8,8 @@
 // Use Start() to start recording to a file, and AddStereoSamples to add wave data.
 // The float variant will convert from -1.0-1.0 range and clamp.
 // Alternatively, AddSamplesBE for big endian wave data.
+// The samples are converted and written to disk on a background thread, so that dumping doesn't
+// stall the thread producing the audio. Stop() waits for all queued samples to be written.
 // If Stop is not called when it destructs, the destructor will call Stop().
 // ---------------------------------------------------------------------------------
 
@@ -15,9 +17,14 @@
 
 #include <array>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/IOFile.h"
+#include "Common/SPSCQueue.h"
 
 class WaveFileWriter
 {
@@ -40,6 +47,22 @@ public:
 private:
   static constexpr size_t BUFFER_SIZE = 32 * 1024;
 
+  struct SampleChunk
+  {
+    std::vector<short> samples;
+    int sample_rate = 0;
+  };
+
+  bool OpenFile(const std::string& filename, unsigned int HLESampleRate);
+  void CloseFile();
+  void WriterThread();
+  void WriteChunk(const SampleChunk& chunk);
+
+  std::thread writer_thread;
+  Common::SPSCQueue<SampleChunk, false> queue;
+  Common::Event queue_event;
+  Common::Flag exit_writer;
+
   File::IOFile file;
   bool skip_silence = false;
   u32 audio_size = 0;
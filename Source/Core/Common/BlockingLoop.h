@@ -4,9 +4,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
+#include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 
@@ -176,7 +178,9 @@ public:
         [[fallthrough]];
 
       case STATE_SLEEPING:
+      {
         // Just relax
+        const auto sleep_start = std::chrono::steady_clock::now();
         if (timeout > 0)
         {
           m_new_work_event.WaitFor(std::chrono::milliseconds(timeout));
@@ -185,8 +189,13 @@ public:
         {
           m_new_work_event.Wait();
         }
+        const auto slept = std::chrono::steady_clock::now() - sleep_start;
+        m_time_slept_us.fetch_add(
+            std::chrono::duration_cast<std::chrono::microseconds>(slept).count(),
+            std::memory_order_relaxed);
         break;
       }
+      }
     }
 
     // Shutdown down, so get a safe state
@@ -232,6 +241,9 @@ public:
   // that we will fall back from the busy loop to sleeping.
   void AllowSleep() { m_may_sleep.Set(); }
 
+  // Total time the main loop has spent sleeping, can be called from any thread
+  u64 GetTimeSleptUs() const { return m_time_slept_us.load(std::memory_order_relaxed); }
+
 private:
   std::mutex m_wait_lock;
   std::mutex m_prepare_lock;
@@ -253,5 +265,7 @@ private:
 
   Flag m_may_sleep;  // If this is set, we fall back from the busy loop to an event based
                      // synchronization.
+
+  std::atomic<u64> m_time_slept_us{0};
 };
 }  // namespace Common
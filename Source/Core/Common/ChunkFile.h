@@ -21,6 +21,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -50,6 +51,12 @@ public:
   PointerWrap(u8** ptr_, Mode mode_) : ptr(ptr_), mode(mode_) {}
   void SetMode(Mode mode_) { mode = mode_; }
   Mode GetMode() const { return mode; }
+
+  // Lets a write into a buffer of unknown size start without measuring first. Once the data
+  // doesn't fit before end anymore, the wrap switches to MODE_MEASURE and keeps advancing the
+  // pointer, so the size that would have been needed can still be determined.
+  void SetWriteLimit(u8* end_) { end = end_; }
+  bool HasOverflowed() const { return overflowed; }
   template <typename K, class V>
   void Do(std::map<K, V>& x)
   {
@@ -199,6 +206,7 @@ public:
   [[nodiscard]] u8* DoExternal(u32& count)
   {
     Do(count);
+    CheckWriteLimit(count);
     u8* current = *ptr;
     *ptr += count;
     return current;
@@ -264,7 +272,7 @@ public:
     }
   }
 
-  void DoMarker(const std::string& prevName, u32 arbitraryNumber = 0x42)
+  void DoMarker(std::string_view prevName, u32 arbitraryNumber = 0x42)
   {
     u32 cookie = arbitraryNumber;
     Do(cookie);
@@ -310,6 +318,7 @@ private:
 
   DOLPHIN_FORCE_INLINE void DoVoid(void* data, u32 size)
   {
+    CheckWriteLimit(size);
     switch (mode)
     {
     case MODE_READ:
@@ -332,4 +341,17 @@ private:
 
     *ptr += size;
   }
+
+private:
+  DOLPHIN_FORCE_INLINE void CheckWriteLimit(u32 size)
+  {
+    if (mode == MODE_WRITE && end != nullptr && size > static_cast<size_t>(end - *ptr))
+    {
+      overflowed = true;
+      mode = MODE_MEASURE;
+    }
+  }
+
+  u8* end = nullptr;
+  bool overflowed = false;
 };
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <vector>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
@@ -48,12 +49,15 @@ public:
   CodeBlock(CodeBlock&&) = delete;
   CodeBlock& operator=(CodeBlock&&) = delete;
 
-  // Call this before you generate any code.
-  void AllocCodeSpace(size_t size)
+  // Call this before you generate any code. With large_pages, the size is rounded up to whole huge
+  // pages, and the extra space goes to this block rather than its children.
+  void AllocCodeSpace(size_t size, bool large_pages = false)
   {
+    if (large_pages)
+      size = Common::AlignUp(size, Common::LARGE_PAGE_SIZE);
     region_size = size;
     total_region_size = size;
-    region = static_cast<u8*>(Common::AllocateExecutableMemory(total_region_size));
+    region = static_cast<u8*>(Common::AllocateExecutableMemory(total_region_size, large_pages));
     T::SetCodePtr(region, region + size);
   }
 
@@ -82,6 +86,7 @@ public:
   }
 
   bool IsInSpace(const u8* ptr) const { return ptr >= region && ptr < (region + region_size); }
+  size_t GetRegionSize() const { return region_size; }
   // Cannot currently be undone. Will write protect the entire code region.
   // Start over if you need to change the code (call FreeCodeSpace(), AllocCodeSpace()).
   void WriteProtect() { Common::WriteProtectMemory(region, region_size, true); }
@@ -105,6 +105,9 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define FRAMESTEP_SOCKET "FrameStep"
+#define FRAMESTATS_SOCKET "FrameStats"
+#define REMOTECONTROL_SOCKET "RemoteControl"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
@@ -76,6 +76,9 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_FRAMESTEPSOCKET_IDX,
+  F_FRAMESTATSSOCKET_IDX,
+  F_REMOTECONTROLSOCKET_IDX,
   F_WIISDCARD_IDX,
   F_DUALSHOCKUDPCLIENTCONFIG_IDX,
   F_FREELOOKCONFIG_IDX,
@@ -114,6 +117,8 @@ public:
   bool IsFile() const;
   // Returns the size of a file (or returns 0 if the path doesn't refer to a file)
   u64 GetSize() const;
+  // Returns the last modification time in seconds since the epoch (or 0 if the path doesn't exist)
+  s64 GetModificationTime() const;
 
 private:
 #ifdef ANDROID
@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <xxhash.h>
+
 #include "Common/BitUtils.h"
 #include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
@@ -506,6 +508,12 @@ static u64 GetMurmurHash3(const u8* src, u32 len, u32 samples)
 
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
+  // The CRC32 functions above add up four independent 32-bit lanes, which collide far more often
+  // than a 64-bit hash should. When every word would be read anyway, use XXH64, which mixes all of
+  // the data into the whole hash. Sampled hashes skip data, so they keep using the functions above.
+  if (samples == 0 || samples >= len / 8)
+    return XXH64(src, len, 0);
+
   return ptrHashFunction(src, len, samples);
 }
 
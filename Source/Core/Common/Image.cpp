@@ -3,11 +3,19 @@
 
 #include "Common/Image.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <vector>
 
 #include <png.h>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 
@@ -107,4 +115,82 @@ std::vector<u8> RGBAToRGB(const u8* input, u32 width, u32 height, int row_stride
   }
   return buffer;
 }
+
+static void CompareRGBAPixels(const u8* a, const u8* b, size_t num_pixels, ImageDifference* result)
+{
+  for (size_t i = 0; i < num_pixels * 4; i += 4)
+  {
+    bool mismatch = false;
+    for (size_t c = 0; c < 3; ++c)
+    {
+      const int diff = a[i + c] - b[i + c];
+      result->squared_error += diff * diff;
+      mismatch |= diff != 0;
+    }
+    result->mismatched_pixels += mismatch;
+  }
+}
+
+ImageDifference CompareRGBAImages(const u8* a, const u8* b, size_t num_pixels)
+{
+  ImageDifference result;
+  size_t pixel = 0;
+
+#if defined(_M_X86_64)
+  // Four pixels at a time. The squared errors of a block are summed in 32-bit lanes, which can't
+  // overflow within a block, and the equal pixels are counted as -1s.
+  constexpr size_t PIXELS_PER_BLOCK = 4 * 1024;
+  const __m128i color_mask = _mm_set1_epi32(0x00FFFFFF);
+  const __m128i zero = _mm_setzero_si128();
+
+  while (num_pixels - pixel >= 4)
+  {
+    const size_t block_start = pixel;
+    const size_t block_end =
+        pixel + std::min(PIXELS_PER_BLOCK, (num_pixels - pixel) & ~size_t(3));
+    __m128i squared_error = zero;
+    __m128i equal_pixels = zero;
+    for (; pixel < block_end; pixel += 4)
+    {
+      __m128i pixels_a;
+      __m128i pixels_b;
+      std::memcpy(&pixels_a, a + pixel * 4, sizeof(pixels_a));
+      std::memcpy(&pixels_b, b + pixel * 4, sizeof(pixels_b));
+      pixels_a = _mm_and_si128(pixels_a, color_mask);
+      pixels_b = _mm_and_si128(pixels_b, color_mask);
+
+      equal_pixels = _mm_add_epi32(equal_pixels, _mm_cmpeq_epi32(pixels_a, pixels_b));
+
+      const __m128i diff =
+          _mm_or_si128(_mm_subs_epu8(pixels_a, pixels_b), _mm_subs_epu8(pixels_b, pixels_a));
+      const __m128i diff_lo = _mm_unpacklo_epi8(diff, zero);
+      const __m128i diff_hi = _mm_unpackhi_epi8(diff, zero);
+      squared_error = _mm_add_epi32(squared_error, _mm_madd_epi16(diff_lo, diff_lo));
+      squared_error = _mm_add_epi32(squared_error, _mm_madd_epi16(diff_hi, diff_hi));
+    }
+
+    u32 lanes[4];
+    s32 equal_lanes[4];
+    std::memcpy(lanes, &squared_error, sizeof(lanes));
+    std::memcpy(equal_lanes, &equal_pixels, sizeof(equal_lanes));
+    const s64 equal_count =
+        -(s64{equal_lanes[0]} + equal_lanes[1] + equal_lanes[2] + equal_lanes[3]);
+    result.squared_error += u64{lanes[0]} + lanes[1] + lanes[2] + lanes[3];
+    result.mismatched_pixels += (block_end - block_start) - static_cast<u64>(equal_count);
+  }
+#endif
+
+  CompareRGBAPixels(a + pixel * 4, b + pixel * 4, num_pixels - pixel, &result);
+  return result;
+}
+
+double GetPSNR(const ImageDifference& difference, size_t num_pixels)
+{
+  if (difference.squared_error == 0)
+    return std::numeric_limits<double>::infinity();
+
+  const double mean_squared_error =
+      static_cast<double>(difference.squared_error) / (static_cast<double>(num_pixels) * 3);
+  return 10.0 * std::log10(255.0 * 255.0 / mean_squared_error);
+}
 }  // namespace Common
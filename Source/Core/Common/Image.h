@@ -26,4 +26,16 @@ bool ConvertRGBAToRGBAndSavePNG(const std::string& path, const u8* input, u32 wi
 
 std::vector<u8> RGBAToRGB(const u8* input, u32 width, u32 height, int row_stride = 0);
 
+struct ImageDifference
+{
+  // Sum of the squared differences of the colour components. Alpha is ignored.
+  u64 squared_error = 0;
+  u64 mismatched_pixels = 0;
+};
+
+// Compares two tightly packed RGBA images of the same size.
+ImageDifference CompareRGBAImages(const u8* a, const u8* b, size_t num_pixels);
+// Peak signal-to-noise ratio of the colour components in dB, infinity if the images are identical.
+double GetPSNR(const ImageDifference& difference, size_t num_pixels);
+
 }  // namespace Common
@@ -11,6 +11,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
@@ -35,7 +36,9 @@ public:
 };
 
 // Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+// No random read functionality, all reading is done in OpenAndRead. The file is read through a
+// memory mapping, and the values passed to the reader point into it until Close is called, so a
+// reader can keep them around and only use the ones it ends up needing.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
@@ -56,53 +59,53 @@ public:
     // Since we're reading/writing directly to the storage of K instances,
     // K must be trivially copyable.
     static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
+    // Values are passed to the reader in place, so they can't need more alignment than the file
+    static_assert(alignof(V) == 1, "V must not need any alignment");
 
     // close any currently opened file
     Close();
     m_num_entries = 0;
 
-    // try opening for reading/writing
-    m_file.Open(filename, "r+b");
-
-    const u64 file_size = m_file.GetSize();
-
     m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+    size_t valid_size = 0;
+    if (m_mapped_file.Open(filename) && m_mapped_file.GetSize() >= sizeof(Header) &&
+        !std::memcmp(&m_header, m_mapped_file.GetData(), sizeof(Header)))
     {
       // good header, read some key/value pairs
-      K key;
-
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
+      const u8* const data = m_mapped_file.GetData();
+      const size_t file_size = m_mapped_file.GetSize();
+      const size_t entry_overhead = sizeof(u32) + sizeof(K) + sizeof(u32);
+      size_t offset = sizeof(Header);
 
-      while (m_file.ReadArray(&value_size, 1))
+      while (file_size - offset >= entry_overhead)
       {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
+        u32 value_size;
+        std::memcpy(&value_size, data + offset, sizeof(value_size));
+        const size_t entry_size = entry_overhead + size_t{value_size} * sizeof(V);
+        if (entry_size > file_size - offset)
           break;
 
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
+        u32 entry_number;
+        std::memcpy(&entry_number, data + offset + entry_size - sizeof(u32), sizeof(entry_number));
+        if (entry_number != m_num_entries + 1)
           break;
-        }
+
+        K key;
+        std::memcpy(&key, data + offset + sizeof(u32), sizeof(K));
+        reader.Read(key, reinterpret_cast<const V*>(data + offset + sizeof(u32) + sizeof(K)),
+                    value_size);
 
         m_num_entries++;
+        offset += entry_size;
       }
-      m_file.Clear();
-      m_file.Seek(last_valid_value_start, SEEK_SET);
+      valid_size = offset;
+    }
 
+    if (valid_size != 0)
+    {
+      // Broken entries at the end are overwritten by the next append
+      m_file.Open(filename, "r+b");
+      m_file.Seek(valid_size, SEEK_SET);
       return m_num_entries;
     }
 
@@ -119,6 +122,7 @@ public:
   {
     if (m_file.IsOpen())
       m_file.Close();
+    m_mapped_file.Close();
   }
 
   // Appends a key-value pair to the store.
@@ -161,5 +165,7 @@ private:
   } m_header;
 
   File::IOFile m_file;
+  // The values passed to the reader point into this mapping
+  File::MappedFile m_mapped_file;
   u32 m_num_entries;
 };
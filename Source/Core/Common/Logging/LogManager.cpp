@@ -4,13 +4,16 @@
 #include "Common/Logging/LogManager.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdarg>
 #include <cstring>
+#include <ctime>
 #include <locale>
 #include <mutex>
 #include <ostream>
 #include <string>
 
+#include <fmt/chrono.h>
 #include <fmt/format.h>
 
 #include "Common/CommonPaths.h"
@@ -19,11 +22,14 @@
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
-#include "Common/Timer.h"
+#include "Common/Thread.h"
 
 namespace Common::Log
 {
 constexpr size_t MAX_MSGLEN = 1024;
+// The writer thread is woken up early once this many messages are queued, otherwise it polls
+constexpr size_t WRITER_WAKE_UP_THRESHOLD = 256;
+constexpr auto WRITER_POLL_INTERVAL = std::chrono::milliseconds(20);
 
 const Config::Info<bool> LOGGER_WRITE_TO_FILE{{Config::System::Logger, "Options", "WriteToFile"},
                                               false};
@@ -190,10 +196,17 @@ LogManager::LogManager()
         Config::Info<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  m_writer_thread = std::thread(&LogManager::WriterThread, this);
 }
 
 LogManager::~LogManager()
 {
+  m_writer_quit.store(true);
+  m_writer_event.Set();
+  m_writer_thread.join();
+  Flush();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -225,20 +238,66 @@ void LogManager::Log(LOG_LEVELS level, LOG_TYPE type, const char* file, int line
   if (!IsEnabled(type, level) || !static_cast<bool>(m_listener_ids))
     return;
 
-  LogWithFullPath(level, type, file + m_path_cutoff_point, line, message);
+  LogRecord record{level, type, file + m_path_cutoff_point, line,
+                   std::chrono::system_clock::now(), message};
+  if (!m_queue.TryPush(std::move(record)))
+  {
+    m_dropped_records.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if (m_queue.Size() >= WRITER_WAKE_UP_THRESHOLD)
+    m_writer_event.Set();
+}
+
+void LogManager::Flush()
+{
+  std::lock_guard lk(m_listener_lock);
+  DrainQueue();
+}
+
+void LogManager::WriterThread()
+{
+  Common::SetCurrentThreadName("Log writer");
+
+  while (!m_writer_quit.load())
+  {
+    m_writer_event.WaitFor(WRITER_POLL_INTERVAL);
+    Flush();
+  }
+}
+
+void LogManager::DrainQueue()
+{
+  LogRecord record;
+  while (m_queue.TryPop(record))
+    WriteRecord(record);
+
+  const u64 dropped_records = m_dropped_records.exchange(0, std::memory_order_relaxed);
+  if (dropped_records != 0)
+  {
+    WriteRecord({LWARNING, COMMON, __FILE__ + m_path_cutoff_point, __LINE__,
+                 std::chrono::system_clock::now(),
+                 fmt::format("{} log messages were dropped because the log queue was full",
+                             dropped_records)});
+  }
 }
 
-void LogManager::LogWithFullPath(LOG_LEVELS level, LOG_TYPE type, const char* file, int line,
-                                 const char* message)
+void LogManager::WriteRecord(const LogRecord& record)
 {
-  const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", Common::Timer::GetTimeFormatted(), file, line,
-                  LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
+  const auto since_epoch = record.time.time_since_epoch();
+  const auto milliseconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count() % 1000;
+  const std::string msg = fmt::format(
+      "{:%M:%S}:{:03} {}:{} {}[{}]: {}\n",
+      fmt::localtime(std::chrono::system_clock::to_time_t(record.time)), milliseconds,
+      record.file, record.line, LOG_LEVEL_TO_CHAR[static_cast<int>(record.level)],
+      GetShortName(record.type), record.message);
 
   for (const auto listener_id : m_listener_ids)
   {
     if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+      m_listeners[listener_id]->Log(record.level, msg.c_str());
   }
 }
 
@@ -285,11 +344,14 @@ const char* LogManager::GetFullName(LOG_TYPE type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  // Once this returns, the writer thread doesn't use the previous listener anymore
+  std::lock_guard lk(m_listener_lock);
   m_listeners[id] = listener;
 }
 
 void LogManager::EnableListener(LogListener::LISTENER id, bool enable)
 {
+  std::lock_guard lk(m_listener_lock);
   m_listener_ids[id] = enable;
 }
 
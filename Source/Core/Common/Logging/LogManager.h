@@ -4,16 +4,24 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Common/Logging/Log.h"
+#include "Common/MPSCQueue.h"
 
 namespace Common::Log
 {
 // pure virtual interface
+// Listeners are called from the log writer thread, never from the thread that logged the message.
 class LogListener
 {
 public:
@@ -37,7 +45,11 @@ public:
   static void Init();
   static void Shutdown();
 
+  // Only queues the message, it is formatted and passed to the listeners by the writer thread.
+  // Messages are dropped and counted if the queue is full.
   void Log(LOG_LEVELS level, LOG_TYPE type, const char* file, int line, const char* message);
+  // Blocks until all messages logged so far have been passed to the listeners
+  void Flush();
 
   LOG_LEVELS GetLogLevel() const;
   void SetLogLevel(LOG_LEVELS level);
@@ -72,13 +84,34 @@ private:
   LogManager(LogManager&&) = delete;
   LogManager& operator=(LogManager&&) = delete;
 
-  void LogWithFullPath(LOG_LEVELS level, LOG_TYPE type, const char* file, int line,
-                       const char* message);
+  struct LogRecord
+  {
+    LOG_LEVELS level = LNOTICE;
+    LOG_TYPE type = MASTER_LOG;
+    const char* file = nullptr;
+    int line = 0;
+    std::chrono::system_clock::time_point time;
+    std::string message;
+  };
+
+  static constexpr size_t QUEUE_CAPACITY = 4096;
+
+  void WriterThread();
+  // Requires m_listener_lock, which also makes sure that there is only one consumer of m_queue
+  void DrainQueue();
+  void WriteRecord(const LogRecord& record);
 
   LOG_LEVELS m_level;
   std::array<LogContainer, NUMBER_OF_LOGS> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  Common::MPSCQueue<LogRecord, QUEUE_CAPACITY> m_queue;
+  std::atomic<u64> m_dropped_records{0};
+  std::mutex m_listener_lock;
+  Common::Event m_writer_event;
+  std::atomic<bool> m_writer_quit{false};
+  std::thread m_writer_thread;
 };
 }  // namespace Common::Log
@@ -0,0 +1,110 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a bounded lockless thread-safe,
+// multiple producer, single consumer queue
+//
+// Every slot has a sequence number which tells the producers and the consumer whose turn it is,
+// so pushing is a single compare-exchange on the write position and never allocates.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename T, size_t Capacity>
+class MPSCQueue
+{
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "MPSCQueue capacity must be a power of two");
+
+public:
+  MPSCQueue()
+  {
+    for (size_t i = 0; i < Capacity; ++i)
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  // Returns false without touching t if the queue is full
+  template <typename Arg>
+  bool TryPush(Arg&& t)
+  {
+    size_t position = m_write_position.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true)
+    {
+      slot = &m_slots[position & (Capacity - 1)];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const auto difference =
+          static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0)
+      {
+        if (m_write_position.compare_exchange_weak(position, position + 1,
+                                                   std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        // The consumer hasn't popped this slot since the previous lap
+        return false;
+      }
+      else
+      {
+        position = m_write_position.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = std::forward<Arg>(t);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Must only be called from the consumer thread. Returns false if the queue is empty or the
+  // oldest element is still being written.
+  bool TryPop(T& t)
+  {
+    const size_t position = m_read_position.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[position & (Capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+      return false;
+
+    t = std::move(slot.value);
+    slot.sequence.store(position + Capacity, std::memory_order_release);
+    m_read_position.store(position + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Approximate when called concurrently with TryPush
+  size_t Size() const
+  {
+    const size_t write_position = m_write_position.load(std::memory_order_relaxed);
+    const size_t read_position = m_read_position.load(std::memory_order_relaxed);
+    return write_position > read_position ? write_position - read_position : 0;
+  }
+
+  static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    T value{};
+  };
+
+  std::array<Slot, Capacity> m_slots;
+  // Producers and the consumer are kept on separate cache lines
+  alignas(64) std::atomic<size_t> m_write_position{0};
+  alignas(64) std::atomic<size_t> m_read_position{0};
+};
+}  // namespace Common
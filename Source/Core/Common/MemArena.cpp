@@ -10,6 +10,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -66,8 +67,9 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 }
 #endif
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool large_pages)
 {
+  m_large_pages = large_pages;
 #ifdef _WIN32
   const std::string name = "dolphin-emu." + std::to_string(GetCurrentProcessId());
   hMemoryMapping = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
@@ -118,6 +120,8 @@ void* MemArena::CreateView(s64 offset, size_t size, void* base)
   }
   else
   {
+    if (m_large_pages)
+      AdviseLargePages(retval, size);
     return retval;
   }
 #endif
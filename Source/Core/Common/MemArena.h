@@ -20,7 +20,8 @@ namespace Common
 class MemArena
 {
 public:
-  void GrabSHMSegment(size_t size);
+  // With large_pages, views are created with a hint to back them with transparent huge pages
+  void GrabSHMSegment(size_t size, bool large_pages = false);
   void ReleaseSHMSegment();
   void* CreateView(s64 offset, size_t size, void* base = nullptr);
   void ReleaseView(void* view, size_t size);
@@ -34,6 +35,7 @@ private:
 #else
   int fd;
 #endif
+  bool m_large_pages = false;
 };
 
 }  // namespace Common
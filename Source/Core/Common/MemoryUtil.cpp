@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 
@@ -33,10 +34,76 @@ namespace Common
 // This is purposely not a full wrapper for virtualalloc/mmap, but it
 // provides exactly the primitive operations that Dolphin needs.
 
-void* AllocateExecutableMemory(size_t size)
+#ifdef _WIN32
+static bool EnableLockMemoryPrivilege()
+{
+  HANDLE token;
+  if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    return false;
+
+  TOKEN_PRIVILEGES privileges = {};
+  privileges.PrivilegeCount = 1;
+  privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  // AdjustTokenPrivileges succeeds without enabling anything if the privilege isn't granted
+  const bool result =
+      LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+      AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+      GetLastError() == ERROR_SUCCESS;
+  CloseHandle(token);
+  return result;
+}
+
+static void* AllocateLargePages(size_t size, DWORD protect)
+{
+  const size_t large_page_size = GetLargePageMinimum();
+  if (large_page_size == 0 || size % large_page_size != 0)
+    return nullptr;
+
+  // The privilege isn't granted to users by default, in which case this fails every time
+  static const bool has_privilege = EnableLockMemoryPrivilege();
+  if (!has_privilege)
+    return nullptr;
+
+  void* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, protect);
+  if (ptr == nullptr)
+    WARN_LOG_FMT(MEMMAP, "Failed to allocate large pages: {}", GetLastErrorString());
+  return ptr;
+}
+#elif defined(__linux__)
+static void* MapLargePages(size_t size, int prot, int flags)
+{
+  if (size % LARGE_PAGE_SIZE == 0)
+  {
+    void* ptr = mmap(nullptr, size, prot, flags | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED)
+      return ptr;
+  }
+
+  // No huge pages are reserved, so map with 2 MiB alignment and let the kernel back the mapping
+  // with transparent huge pages. The ends that don't line up are unmapped again.
+  const size_t padded_size = size + LARGE_PAGE_SIZE;
+  u8* const padded = static_cast<u8*>(mmap(nullptr, padded_size, prot, flags, -1, 0));
+  if (padded == MAP_FAILED)
+    return nullptr;
+
+  const uintptr_t address = reinterpret_cast<uintptr_t>(padded);
+  u8* const ptr = padded + (LARGE_PAGE_SIZE - address % LARGE_PAGE_SIZE) % LARGE_PAGE_SIZE;
+  if (ptr != padded)
+    munmap(padded, ptr - padded);
+  if (ptr + size != padded + padded_size)
+    munmap(ptr + size, padded + padded_size - (ptr + size));
+
+  AdviseLargePages(ptr, size);
+  return ptr;
+}
+#endif
+
+void* AllocateExecutableMemory(size_t size, bool large_pages)
 {
 #if defined(_WIN32)
-  void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+  void* ptr = large_pages ? AllocateLargePages(size, PAGE_EXECUTE_READWRITE) : nullptr;
+  if (ptr == nullptr)
+    ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
 #else
   int map_flags = MAP_ANON | MAP_PRIVATE;
 #if defined(__APPLE__)
@@ -46,9 +113,17 @@ void* AllocateExecutableMemory(size_t size)
   if (__builtin_available(macOS 10.14, *))
     map_flags |= MAP_JIT;
 #endif
-  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
-  if (ptr == MAP_FAILED)
-    ptr = nullptr;
+  void* ptr = nullptr;
+#if defined(__linux__)
+  if (large_pages)
+    ptr = MapLargePages(size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags);
+#endif
+  if (ptr == nullptr)
+  {
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
+    if (ptr == MAP_FAILED)
+      ptr = nullptr;
+  }
 #endif
 
   if (ptr == nullptr)
@@ -56,6 +131,15 @@ void* AllocateExecutableMemory(size_t size)
 
   return ptr;
 }
+
+void AdviseLargePages(void* ptr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+  // Only a hint, it fails when transparent huge pages are disabled or unsupported for the mapping
+  if (madvise(ptr, size, MADV_HUGEPAGE) != 0)
+    DEBUG_LOG_FMT(MEMMAP, "madvise(MADV_HUGEPAGE) failed: {}", LastStrerrorString());
+#endif
+}
 // This function is used to provide a counter for the JITPageWrite*Execute*
 // functions to enable nesting. The static variable is wrapped in a a function
 // to allow those functions to be called inside of the constructor of a static
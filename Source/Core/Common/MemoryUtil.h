@@ -8,7 +8,16 @@
 
 namespace Common
 {
-void* AllocateExecutableMemory(size_t size);
+// Size of the huge pages which large page allocations try to use
+constexpr size_t LARGE_PAGE_SIZE = 0x200000;
+
+// With large_pages, the memory is backed by huge pages when the system allows it, which cuts down
+// on TLB misses in big code regions. Otherwise normal pages are used. Reserved huge pages
+// (MAP_HUGETLB, or MEM_LARGE_PAGES on Windows, which needs the "Lock pages in memory" privilege)
+// are only used when size is a multiple of LARGE_PAGE_SIZE.
+void* AllocateExecutableMemory(size_t size, bool large_pages = false);
+// Asks the system to back an existing mapping with transparent huge pages, where supported
+void AdviseLargePages(void* ptr, size_t size);
 
 // These two functions control the executable/writable state of the W^X memory
 // allocations. More detailed documentation about them is in the .cpp file.
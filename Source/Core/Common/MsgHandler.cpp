@@ -17,12 +17,21 @@
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/LogManager.h"
 #include "Common/StringUtil.h"
 
 namespace Common
 {
 namespace
 {
+// The log is written asynchronously, so make sure that the message is written before the alert
+// blocks or aborts
+void FlushLog()
+{
+  if (auto* log_manager = Log::LogManager::GetInstance())
+    log_manager->Flush();
+}
+
 // Default non library dependent panic alert
 bool DefaultMsgHandler(const char* caption, const char* text, bool yes_no, MsgType style)
 {
@@ -120,6 +129,7 @@ bool MsgAlert(bool yes_no, MsgType style, const char* format, ...)
   va_end(args);
 
   ERROR_LOG_FMT(MASTER_LOG, "{}: {}", caption, buffer);
+  FlushLog();
 
   // Panic alerts.
   if (style == MsgType::Warning && s_abort_on_panic_alert)
@@ -143,6 +153,7 @@ bool MsgAlertFmtImpl(bool yes_no, MsgType style, fmt::string_view format,
   const char* caption = GetCaption(style);
   const auto message = fmt::vformat(format, args);
   ERROR_LOG_FMT(MASTER_LOG, "{}: {}", caption, message);
+  FlushLog();
 
   // Don't ignore questions, especially AskYesNo, PanicYesNo could be ignored
   if (s_msg_handler != nullptr &&
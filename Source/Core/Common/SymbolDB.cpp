@@ -5,6 +5,7 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -51,6 +52,7 @@ void SymbolDB::Clear(const char* prefix)
   // TODO: honor prefix
   m_functions.clear();
   m_checksum_to_function.clear();
+  m_symbols_by_address_dirty = true;
 }
 
 void SymbolDB::Index()
@@ -62,12 +64,26 @@ void SymbolDB::Index()
   }
 }
 
+const std::vector<std::pair<u32, Symbol*>>& SymbolDB::GetSymbolsByAddress()
+{
+  if (m_symbols_by_address_dirty)
+  {
+    m_symbols_by_address.clear();
+    m_symbols_by_address.reserve(m_functions.size());
+    for (auto& func : m_functions)
+      m_symbols_by_address.emplace_back(func.first, &func.second);
+    m_symbols_by_address_dirty = false;
+  }
+
+  return m_symbols_by_address;
+}
+
 Symbol* SymbolDB::GetSymbolFromName(std::string_view name)
 {
-  for (auto& func : m_functions)
+  for (const auto& [address, symbol] : GetSymbolsByAddress())
   {
-    if (func.second.function_name == name)
-      return &func.second;
+    if (symbol->function_name == name)
+      return symbol;
   }
 
   return nullptr;
@@ -77,10 +93,10 @@ std::vector<Symbol*> SymbolDB::GetSymbolsFromName(std::string_view name)
 {
   std::vector<Symbol*> symbols;
 
-  for (auto& func : m_functions)
+  for (const auto& [address, symbol] : GetSymbolsByAddress())
   {
-    if (func.second.function_name == name)
-      symbols.push_back(&func.second);
+    if (symbol->function_name == name)
+      symbols.push_back(symbol);
   }
 
   return symbols;
@@ -107,6 +123,7 @@ std::vector<Symbol*> SymbolDB::GetSymbolsFromHash(u32 hash)
 
 void SymbolDB::AddCompleteSymbol(const Symbol& symbol)
 {
-  m_functions.emplace(symbol.address, symbol);
+  if (m_functions.emplace(symbol.address, symbol).second)
+    m_symbols_by_address_dirty = true;
 }
 }  // namespace Common
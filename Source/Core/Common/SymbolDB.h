@@ -77,14 +77,25 @@ public:
   std::vector<Symbol*> GetSymbolsFromHash(u32 hash);
 
   const XFuncMap& Symbols() const { return m_functions; }
-  XFuncMap& AccessSymbols() { return m_functions; }
+  XFuncMap& AccessSymbols()
+  {
+    // The caller may add or remove symbols
+    m_symbols_by_address_dirty = true;
+    return m_functions;
+  }
   bool IsEmpty() const;
   void Clear(const char* prefix = "");
   void List();
   void Index();
 
 protected:
+  // The start addresses and symbols in a flat array, for binary searches. It is rebuilt on first
+  // use after symbols were added or removed, which has to set m_symbols_by_address_dirty.
+  const std::vector<std::pair<u32, Symbol*>>& GetSymbolsByAddress();
+
   XFuncMap m_functions;
   XFuncPtrMap m_checksum_to_function;
+  std::vector<std::pair<u32, Symbol*>> m_symbols_by_address;
+  bool m_symbols_by_address_dirty = true;
 };
 }  // namespace Common
@@ -2,9 +2,18 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "Common/Thread.h"
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -13,6 +22,13 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include "Common/FileUtil.h"
+#endif
+
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined BSD4_4 || defined __FreeBSD__ || defined __OpenBSD__
@@ -43,14 +59,63 @@ int CurrentThreadId()
 
 #ifdef _WIN32
 
-void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask)
+void SetThreadAffinity(std::thread::native_handle_type thread, u64 mask)
+{
+  SetThreadAffinityMask(thread, static_cast<DWORD_PTR>(mask));
+}
+
+void SetCurrentThreadAffinity(u64 mask)
+{
+  SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask));
+}
+
+static u64 GetProcessCoreMask()
 {
-  SetThreadAffinityMask(thread, mask);
+  DWORD_PTR process_mask, system_mask;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+    return ~u64(0);
+  return process_mask;
 }
 
-void SetCurrentThreadAffinity(u32 mask)
+static void SetCurrentThreadPriority(ThreadPriority priority)
 {
-  SetThreadAffinityMask(GetCurrentThread(), mask);
+  if (priority != ThreadPriority::Normal)
+  {
+    SetThreadPriority(GetCurrentThread(), priority == ThreadPriority::High ?
+                                              THREAD_PRIORITY_ABOVE_NORMAL :
+                                              THREAD_PRIORITY_BELOW_NORMAL);
+  }
+}
+
+// Returns the efficiency class of each logical processor in the first processor group, higher
+// classes are faster. Cores which don't exist are left at -1.
+static std::array<int, 64> GetCoreClasses()
+{
+  std::array<int, 64> classes;
+  classes.fill(-1);
+
+  ULONG length = 0;
+  GetSystemCpuSetInformation(nullptr, 0, &length, GetCurrentProcess(), 0);
+  std::vector<u8> buffer(length);
+  if (length == 0 ||
+      !GetSystemCpuSetInformation(reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data()),
+                                  length, &length, GetCurrentProcess(), 0))
+  {
+    return classes;
+  }
+
+  for (ULONG offset = 0; offset < length;)
+  {
+    const auto* info = reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(&buffer[offset]);
+    offset += info->Size;
+    if (info->Type != CpuSetInformation || info->CpuSet.Group != 0 ||
+        info->CpuSet.LogicalProcessorIndex >= classes.size())
+    {
+      continue;
+    }
+    classes[info->CpuSet.LogicalProcessorIndex] = info->CpuSet.EfficiencyClass;
+  }
+  return classes;
 }
 
 // Supporting functions
@@ -112,14 +177,18 @@ void SetCurrentThreadName(const char* name)
 {
   SetCurrentThreadNameViaException(name);
   SetCurrentThreadNameViaApi(name);
+#ifdef USE_TRACING
+  Tracing::SetCurrentThreadName(name);
+#endif
 }
 
 #else  // !WIN32, so must be POSIX threads
 
-void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask)
+void SetThreadAffinity(std::thread::native_handle_type thread, u64 mask)
 {
 #ifdef __APPLE__
-  thread_policy_set(pthread_mach_thread_np(thread), THREAD_AFFINITY_POLICY, (integer_t*)&mask, 1);
+  integer_t tag = static_cast<integer_t>(mask);
+  thread_policy_set(pthread_mach_thread_np(thread), THREAD_AFFINITY_POLICY, &tag, 1);
 #elif (defined __linux__ || defined BSD4_4 || defined __FreeBSD__ || defined __NetBSD__) &&        \
     !(defined ANDROID)
 #ifndef __NetBSD__
@@ -148,11 +217,87 @@ void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask)
 #endif
 }
 
-void SetCurrentThreadAffinity(u32 mask)
+void SetCurrentThreadAffinity(u64 mask)
 {
   SetThreadAffinity(pthread_self(), mask);
 }
 
+static u64 GetProcessCoreMask()
+{
+#if defined(__linux__) && !defined(ANDROID)
+  // The affinity of the main thread, which threads started with a role don't change
+  cpu_set_t cpu_set;
+  if (sched_getaffinity(getpid(), sizeof(cpu_set), &cpu_set) != 0)
+    return ~u64(0);
+
+  u64 mask = 0;
+  for (int i = 0; i != 64; ++i)
+  {
+    if (CPU_ISSET(i, &cpu_set))
+      mask |= u64(1) << i;
+  }
+  return mask;
+#else
+  return ~u64(0);
+#endif
+}
+
+static void SetCurrentThreadPriority(ThreadPriority priority)
+{
+  if (priority == ThreadPriority::Normal)
+    return;
+
+#ifdef __APPLE__
+  pthread_set_qos_class_self_np(priority == ThreadPriority::High ? QOS_CLASS_USER_INTERACTIVE :
+                                                                   QOS_CLASS_UTILITY,
+                                0);
+#elif defined(__linux__)
+  // Linux applies nice values to single threads. Raising the priority needs CAP_SYS_NICE and
+  // fails quietly without it.
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)),
+              priority == ThreadPriority::High ? -5 : 10);
+#endif
+}
+
+static std::array<int, 64> GetCoreClasses()
+{
+  std::array<int, 64> classes;
+  classes.fill(-1);
+
+#ifdef __linux__
+  // Intel hybrid CPUs list their two kinds of cores as separate PMUs
+  std::string performance_cores, efficiency_cores;
+  if (File::ReadFileToString("/sys/devices/cpu_core/cpus", performance_cores) &&
+      File::ReadFileToString("/sys/devices/cpu_atom/cpus", efficiency_cores))
+  {
+    const u64 performance_mask = ParseCoreList(StripSpaces(performance_cores));
+    const u64 efficiency_mask = ParseCoreList(StripSpaces(efficiency_cores));
+    for (size_t i = 0; i < classes.size(); ++i)
+    {
+      if (performance_mask & (u64(1) << i))
+        classes[i] = 1;
+      else if (efficiency_mask & (u64(1) << i))
+        classes[i] = 0;
+    }
+    return classes;
+  }
+
+  // Other hosts such as ARM big.LITTLE systems give the relative capacity of each core
+  for (size_t i = 0; i < classes.size(); ++i)
+  {
+    std::string capacity;
+    if (!File::ReadFileToString(fmt::format("/sys/devices/system/cpu/cpu{}/cpu_capacity", i),
+                                capacity))
+    {
+      break;
+    }
+    TryParse(std::string(StripSpaces(capacity)), &classes[i], 10);
+  }
+#endif
+
+  return classes;
+}
+
 void SleepCurrentThread(int ms)
 {
   usleep(1000 * ms);
@@ -182,8 +327,121 @@ void SetCurrentThreadName(const char* name)
   // API.
   __itt_thread_set_name(name);
 #endif
+#ifdef USE_TRACING
+  Tracing::SetCurrentThreadName(name);
+#endif
 }
 
 #endif
 
+namespace
+{
+struct CoreMasks
+{
+  u64 performance = 0;
+  u64 efficiency = 0;
+};
+}  // namespace
+
+static std::mutex s_thread_policies_mutex;
+static std::array<ThreadPolicy, static_cast<size_t>(ThreadRole::Count)> s_thread_policies;
+
+static CoreMasks DetectCoreMasks()
+{
+  const std::array<int, 64> classes = GetCoreClasses();
+
+  int fastest_class = -1;
+  int slowest_class = -1;
+  for (int core_class : classes)
+  {
+    if (core_class < 0)
+      continue;
+    if (fastest_class < 0 || core_class > fastest_class)
+      fastest_class = core_class;
+    if (slowest_class < 0 || core_class < slowest_class)
+      slowest_class = core_class;
+  }
+
+  CoreMasks masks;
+  if (fastest_class == slowest_class)
+    return masks;
+
+  for (size_t i = 0; i < classes.size(); ++i)
+  {
+    if (classes[i] == fastest_class)
+      masks.performance |= u64(1) << i;
+    else if (classes[i] >= 0)
+      masks.efficiency |= u64(1) << i;
+  }
+  return masks;
+}
+
+static const CoreMasks& GetCoreMasks()
+{
+  static const CoreMasks masks = DetectCoreMasks();
+  return masks;
+}
+
+u64 GetPerformanceCoreMask()
+{
+  return GetCoreMasks().performance;
+}
+
+u64 GetEfficiencyCoreMask()
+{
+  return GetCoreMasks().efficiency;
+}
+
+void SetThreadRolePolicy(ThreadRole role, const ThreadPolicy& policy)
+{
+  std::lock_guard lk(s_thread_policies_mutex);
+  s_thread_policies[static_cast<size_t>(role)] = policy;
+}
+
+void ApplyThreadRole(ThreadRole role)
+{
+  ThreadPolicy policy;
+  {
+    std::lock_guard lk(s_thread_policies_mutex);
+    policy = s_thread_policies[static_cast<size_t>(role)];
+  }
+
+#ifndef __APPLE__
+  // macOS only takes affinity tags as hints, the priority picks the kind of core there instead
+  const u64 mask = policy.affinity_mask & GetProcessCoreMask();
+  if (mask != 0)
+    SetCurrentThreadAffinity(mask);
+#endif
+
+  SetCurrentThreadPriority(policy.priority);
+}
+
+u64 ParseCoreList(std::string_view list)
+{
+  u64 mask = 0;
+  for (const std::string& item : SplitString(std::string(list), ','))
+  {
+    const std::string_view range = StripSpaces(item);
+    const size_t dash = range.find('-');
+    u32 first, last;
+    if (dash == std::string_view::npos)
+    {
+      if (!TryParse(std::string(range), &first, 10))
+        return 0;
+      last = first;
+    }
+    else if (!TryParse(std::string(StripSpaces(range.substr(0, dash))), &first, 10) ||
+             !TryParse(std::string(StripSpaces(range.substr(dash + 1))), &last, 10))
+    {
+      return 0;
+    }
+
+    if (first > last || last >= 64)
+      return 0;
+    for (u32 i = first; i <= last; ++i)
+      mask |= u64(1) << i;
+  }
+  return mask;
+}
+
 }  // namespace Common
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <string_view>
 #include <thread>
 
 // Don't include Common.h here as it will break LogManager
@@ -19,8 +20,8 @@ namespace Common
 {
 int CurrentThreadId();
 
-void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask);
-void SetCurrentThreadAffinity(u32 mask);
+void SetThreadAffinity(std::thread::native_handle_type thread, u64 mask);
+void SetCurrentThreadAffinity(u64 mask);
 
 void SleepCurrentThread(int ms);
 void SwitchCurrentThread();  // On Linux, this is equal to sleep 1ms
@@ -35,4 +36,46 @@ inline void YieldCPU()
 
 void SetCurrentThreadName(const char* name);
 
+// Threads which the host's scheduler should treat differently. Each role can be given its own
+// cores and priority, which its threads apply to themselves once they have started.
+enum class ThreadRole
+{
+  CPU,
+  GPU,
+  DSP,
+  Audio,
+  // Shader compilation, savestate compression and other work which emulation doesn't wait on
+  Background,
+  Count
+};
+
+enum class ThreadPriority
+{
+  Low,
+  // Leaves the priority the thread was created with
+  Normal,
+  High,
+};
+
+struct ThreadPolicy
+{
+  // Cores the threads may run on, 0 leaves the choice to the system
+  u64 affinity_mask = 0;
+  ThreadPriority priority = ThreadPriority::Normal;
+};
+
+void SetThreadRolePolicy(ThreadRole role, const ThreadPolicy& policy);
+// Applies the role's policy to the calling thread. The cores are restricted to the ones the
+// process may run on, so that an affinity set when launching the process is respected.
+void ApplyThreadRole(ThreadRole role);
+
+// The fastest and the slower cores on hosts which have both kinds, such as P-cores and E-cores.
+// Both are 0 on hosts where all cores are the same or which can't tell them apart.
+u64 GetPerformanceCoreMask();
+u64 GetEfficiencyCoreMask();
+
+// Parses a list of core numbers and ranges like "0-3,8" into a mask. Returns 0 if the list is
+// empty or invalid.
+u64 ParseCoreList(std::string_view list);
+
 }  // namespace Common
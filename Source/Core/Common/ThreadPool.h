@@ -0,0 +1,125 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A fixed set of worker threads that split up the jobs of a parallel loop with the calling thread,
+// which waits for all of them to finish.
+
+namespace Common
+{
+class ThreadPool
+{
+public:
+  explicit ThreadPool(unsigned int max_worker_threads)
+  {
+    const unsigned int thread_count =
+        std::clamp(std::thread::hardware_concurrency(), 2u, max_worker_threads + 1) - 1;
+    for (unsigned int i = 0; i < thread_count; ++i)
+      m_threads.emplace_back(&ThreadPool::WorkerThread, this);
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      m_exit = true;
+    }
+    m_job_available.notify_all();
+    for (std::thread& thread : m_threads)
+      thread.join();
+  }
+
+  // The number of threads that run jobs, including the calling thread
+  size_t GetThreadCount() const { return m_threads.size() + 1; }
+
+  // Calls job(i) for every i in [0, count) and returns once all of them have finished
+  void Run(size_t count, const std::function<void(size_t)>& job)
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      m_job = &job;
+      m_job_count = count;
+      m_next_index.store(0, std::memory_order_relaxed);
+      m_remaining = count;
+      ++m_generation;
+    }
+    m_job_available.notify_all();
+
+    const size_t done = RunJobs(job, count);
+
+    // Workers that picked up the job may still be looking for a job, so wait for them to leave
+    // before the job goes out of scope
+    std::unique_lock lock(m_mutex);
+    m_remaining -= done;
+    m_job_done.wait(lock, [this] { return m_remaining == 0 && m_active_workers == 0; });
+    m_job = nullptr;
+  }
+
+private:
+  size_t RunJobs(const std::function<void(size_t)>& job, size_t count)
+  {
+    size_t done = 0;
+    for (size_t i = m_next_index.fetch_add(1); i < count; i = m_next_index.fetch_add(1))
+    {
+      job(i);
+      ++done;
+    }
+    return done;
+  }
+
+  void WorkerThread()
+  {
+    u64 seen_generation = 0;
+    while (true)
+    {
+      const std::function<void(size_t)>* job;
+      size_t count;
+      {
+        std::unique_lock lock(m_mutex);
+        m_job_available.wait(lock, [&] { return m_exit || m_generation != seen_generation; });
+        if (m_exit)
+          return;
+        seen_generation = m_generation;
+        job = m_job;
+        count = m_job_count;
+        if (!job)
+          continue;
+        ++m_active_workers;
+      }
+
+      const size_t done = RunJobs(*job, count);
+
+      std::lock_guard lock(m_mutex);
+      m_remaining -= done;
+      --m_active_workers;
+      if (m_remaining == 0 && m_active_workers == 0)
+        m_job_done.notify_all();
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_job_available;
+  std::condition_variable m_job_done;
+  const std::function<void(size_t)>* m_job = nullptr;
+  size_t m_job_count = 0;
+  std::atomic<size_t> m_next_index{0};
+  size_t m_remaining = 0;
+  size_t m_active_workers = 0;
+  u64 m_generation = 0;
+  bool m_exit = false;
+};
+
+}  // namespace Common
@@ -0,0 +1,147 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Tracing.h"
+
+#ifdef USE_TRACING
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::Tracing
+{
+struct Span
+{
+  const char* name;
+  Clock::time_point start;
+  Clock::time_point end;
+};
+
+// Every thread records into its own buffer, so the lock is only contended while writing the file
+struct ThreadBuffer
+{
+  std::mutex mutex;
+  std::vector<Span> spans;
+  std::string name;
+  u32 index;
+  bool full = false;
+};
+
+// Bounds the memory of long recordings, to about 24 MiB per thread
+constexpr size_t MAX_SPANS_PER_THREAD = 1 << 20;
+
+std::atomic<bool> g_active{false};
+
+static std::mutex s_mutex;
+// Buffers stay alive after their thread exits, so their spans are still written
+static std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+static File::IOFile s_file;
+static Clock::time_point s_start;
+
+static ThreadBuffer& GetThreadBuffer()
+{
+  thread_local const std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto new_buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard lock(s_mutex);
+    // Small numbers are easier to read in trace viewers than native thread IDs
+    new_buffer->index = static_cast<u32>(s_buffers.size()) + 1;
+    s_buffers.push_back(new_buffer);
+    return new_buffer;
+  }();
+  return *buffer;
+}
+
+bool Start(std::string filename)
+{
+  std::lock_guard lock(s_mutex);
+  g_active.store(false);
+  if (!s_file.Open(filename, "w"))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open trace file {}", filename);
+    return false;
+  }
+
+  for (const auto& buffer : s_buffers)
+  {
+    std::lock_guard buffer_lock(buffer->mutex);
+    buffer->spans.clear();
+    buffer->full = false;
+  }
+  s_start = Clock::now();
+  g_active.store(true);
+  return true;
+}
+
+void Stop()
+{
+  std::lock_guard lock(s_mutex);
+  if (!g_active.exchange(false))
+    return;
+
+  const auto to_us = [](Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+
+  s_file.WriteString("[\n");
+  for (const auto& buffer : s_buffers)
+  {
+    std::lock_guard buffer_lock(buffer->mutex);
+    if (!buffer->name.empty())
+    {
+      s_file.WriteString(fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                                     "\"args\":{{\"name\":\"{}\"}}}},\n",
+                                     buffer->index, buffer->name));
+    }
+    if (buffer->full)
+    {
+      WARN_LOG_FMT(COMMON, "Thread {} recorded more than {} spans, later ones were dropped",
+                   buffer->name, MAX_SPANS_PER_THREAD);
+    }
+
+    for (const Span& span : buffer->spans)
+    {
+      // Spans which started before the recording have a negative timestamp and are skipped
+      if (span.start < s_start)
+        continue;
+      s_file.WriteString(fmt::format(
+          "{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}},\n",
+          span.name, to_us(span.start - s_start), to_us(span.end - span.start), buffer->index));
+    }
+    buffer->spans.clear();
+    buffer->spans.shrink_to_fit();
+  }
+  // Trailing commas aren't valid JSON, so the list ends with an event every viewer accepts
+  s_file.WriteString(fmt::format(
+      "{{\"name\":\"End\",\"ph\":\"i\",\"s\":\"g\",\"ts\":{:.3f},\"pid\":1,\"tid\":0}}\n]\n",
+      to_us(Clock::now() - s_start)));
+  s_file.Close();
+}
+
+void SetCurrentThreadName(const char* name)
+{
+  ThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard lock(buffer.mutex);
+  buffer.name = name;
+}
+
+void AddSpan(const char* name, Clock::time_point start, Clock::time_point end)
+{
+  ThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard lock(buffer.mutex);
+  if (buffer.spans.size() >= MAX_SPANS_PER_THREAD)
+  {
+    buffer.full = true;
+    return;
+  }
+  buffer.spans.push_back({name, start, end});
+}
+}  // namespace Common::Tracing
+
+#endif
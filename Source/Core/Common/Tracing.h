@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Spans of the emulation hot paths on every thread, written as a Chrome trace event file which
+// chrome://tracing and Perfetto can open. Only available in builds configured with
+// ENABLE_TRACING, in other builds TRACE_SCOPE compiles to nothing.
+//
+//   void VertexManagerBase::Flush()
+//   {
+//     TRACE_SCOPE("VertexManager::Flush");
+//     ...
+//   }
+
+#pragma once
+
+#ifdef USE_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace Common::Tracing
+{
+using Clock = std::chrono::steady_clock;
+
+// Discards the spans of any previous recording and starts recording. Returns false if the file
+// can't be created.
+bool Start(std::string filename);
+// Stops recording and writes the spans to the file given to Start
+void Stop();
+
+// Names the calling thread in the trace. Called by Common::SetCurrentThreadName.
+void SetCurrentThreadName(const char* name);
+
+extern std::atomic<bool> g_active;
+
+inline bool IsActive()
+{
+  return g_active.load(std::memory_order_relaxed);
+}
+
+void AddSpan(const char* name, Clock::time_point start, Clock::time_point end);
+
+// Records the time between its construction and destruction. Names must be string literals.
+class Scope
+{
+public:
+  explicit Scope(const char* name)
+  {
+    if (IsActive())
+    {
+      m_name = name;
+      m_start = Clock::now();
+    }
+  }
+
+  ~Scope()
+  {
+    if (m_name)
+      AddSpan(m_name, m_start, Clock::now());
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  const char* m_name = nullptr;
+  Clock::time_point m_start;
+};
+}  // namespace Common::Tracing
+
+#define TRACE_SCOPE_CONCAT_INNER(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name)                                                                          \
+  Common::Tracing::Scope TRACE_SCOPE_CONCAT(trace_scope_, __LINE__)(name)
+
+#else
+
+#define TRACE_SCOPE(name)                                                                          \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+
+#endif
@@ -59,6 +59,7 @@ public:
   }
 
   bool IsCancelled() const { return m_cancelled.IsSet(); }
+  bool IsRunning() const { return m_thread.joinable(); }
 
 private:
   void Shutdown()
@@ -22,8 +22,10 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <variant>
@@ -37,9 +39,11 @@
 #include "Common/IniFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Swap.h"
 
 #include "Core/ARDecrypt.h"
 #include "Core/CheatCodes.h"
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/PowerPC/MMU.h"
 
@@ -90,6 +94,8 @@ static std::atomic<bool> s_use_internal_log{false};
 // pointer to the code currently being run, (used by log messages that include the code name)
 static const ARCode* s_current_code = nullptr;
 static bool s_disable_logging = false;
+// Whether s_compiled_codes matches s_active_codes
+static bool s_codes_compiled = false;
 
 struct ARAddr
 {
@@ -119,6 +125,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
 
   std::lock_guard guard(s_lock);
   s_disable_logging = false;
+  s_codes_compiled = false;
   s_active_codes.clear();
   std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                [](const ARCode& code) { return code.enabled; });
@@ -127,6 +134,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
 
 void SetSyncedCodesAsActive()
 {
+  s_codes_compiled = false;
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
@@ -147,6 +155,7 @@ std::vector<ARCode> ApplyAndReturnCodes(const std::vector<ARCode>& codes)
   {
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
+    s_codes_compiled = false;
     s_active_codes.clear();
     std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                  [](const ARCode& code) { return code.enabled; });
@@ -165,6 +174,7 @@ void AddCode(ARCode code)
   {
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
+    s_codes_compiled = false;
     s_active_codes.emplace_back(std::move(code));
   }
 }
@@ -977,23 +987,406 @@ static bool RunCodeLocked(const ARCode& arcode)
   return true;
 }
 
+// ----------------------
+// Compiled Codes
+// After the first run, which logs and reports invalid codes, the lines of every code are decoded
+// once and their fixed addresses are resolved to host pointers while the DBATs don't change.
+struct CompiledLine
+{
+  enum class Type : u8
+  {
+    RamWrite,
+    WriteToPointer,
+    Add,
+    Conditional,
+    EndOfCodes,
+    Nop,
+    FillAndSlide,
+    MemoryCopy,
+  };
+
+  // The raw line, used when it is the second line of a fill and slide or a memory copy
+  u32 cmd_addr;
+  u32 data;
+
+  Type type = Type::Nop;
+  u8 size = DATATYPE_8BIT;
+  u8 compare_type = 0;
+  u8 subtype = 0;
+  u32 address = 0;
+  u32 value = 0;
+  u32 count = 1;
+  u32 offset = 0;
+  u8* host_pointer = nullptr;
+};
+
+struct CompiledCode
+{
+  // Index into s_active_codes
+  size_t index;
+  // Empty if a line isn't supported, the code is interpreted then
+  std::vector<CompiledLine> lines;
+};
+
+static std::vector<CompiledCode> s_compiled_codes;
+static std::optional<u32> s_resolved_generation;
+
+static u32 GetDataTypeBytes(u8 size)
+{
+  return size == DATATYPE_8BIT ? 1 : size == DATATYPE_16BIT ? 2 : 4;
+}
+
+// Returns std::nullopt for the lines that RunCodeLocked rejects
+static std::optional<CompiledLine> CompileLine(const AREntry& entry)
+{
+  const ARAddr addr(entry.cmd_addr);
+  const u32 data = entry.value;
+  CompiledLine line{entry.cmd_addr, data};
+
+  if (addr >= 0x00002000 && addr < 0x00003000)
+    return std::nullopt;
+
+  if (0x0 == addr)
+  {
+    switch (data >> 29)
+    {
+    case ZCODE_END:
+      line.type = CompiledLine::Type::EndOfCodes;
+      return line;
+    case ZCODE_NORM:
+      line.type = CompiledLine::Type::Nop;
+      return line;
+    case ZCODE_04:
+      line.type = 0x3 == ((data >> 25) & 0x03) ? CompiledLine::Type::MemoryCopy :
+                                                 CompiledLine::Type::FillAndSlide;
+      return line;
+    default:
+      return std::nullopt;
+    }
+  }
+
+  line.size = addr.size;
+  line.address = addr.GCAddress();
+
+  if (addr.type != 0x00)
+  {
+    line.type = CompiledLine::Type::Conditional;
+    line.compare_type = addr.type;
+    line.subtype = addr.subtype;
+    line.value = addr.size == DATATYPE_8BIT  ? data & 0xFF :
+                 addr.size == DATATYPE_16BIT ? data & 0xFFFF :
+                                               data;
+    return line;
+  }
+
+  switch (addr.subtype)
+  {
+  case SUB_RAM_WRITE:
+    line.type = CompiledLine::Type::RamWrite;
+    if (addr.size == DATATYPE_8BIT)
+    {
+      line.value = data & 0xFF;
+      line.count = (data >> 8) + 1;
+    }
+    else if (addr.size == DATATYPE_16BIT)
+    {
+      line.value = data & 0xFFFF;
+      line.count = (data >> 16) + 1;
+    }
+    else
+    {
+      line.value = data;
+    }
+    return line;
+
+  case SUB_WRITE_POINTER:
+    line.type = CompiledLine::Type::WriteToPointer;
+    if (addr.size == DATATYPE_8BIT)
+    {
+      line.value = data & 0xFF;
+      line.offset = data >> 8;
+    }
+    else if (addr.size == DATATYPE_16BIT)
+    {
+      line.value = data & 0xFFFF;
+      line.offset = (data >> 16) << 1;
+    }
+    else
+    {
+      line.value = data;
+    }
+    return line;
+
+  case SUB_ADD_CODE:
+    line.type = CompiledLine::Type::Add;
+    line.value = data;
+    return line;
+
+  default:
+    return std::nullopt;
+  }
+}
+
+static void CompileActiveCodesLocked()
+{
+  s_compiled_codes.clear();
+  s_compiled_codes.reserve(s_active_codes.size());
+  for (size_t i = 0; i < s_active_codes.size(); ++i)
+  {
+    CompiledCode& compiled = s_compiled_codes.emplace_back(CompiledCode{i});
+    compiled.lines.reserve(s_active_codes[i].ops.size());
+    for (const AREntry& entry : s_active_codes[i].ops)
+    {
+      const std::optional<CompiledLine> line = CompileLine(entry);
+      if (!line)
+      {
+        compiled.lines.clear();
+        break;
+      }
+      compiled.lines.push_back(*line);
+    }
+  }
+  s_resolved_generation.reset();
+  s_codes_compiled = true;
+}
+
+static void ResolveCompiledCodesLocked()
+{
+  for (CompiledCode& compiled : s_compiled_codes)
+  {
+    for (CompiledLine& line : compiled.lines)
+    {
+      u32 length;
+      switch (line.type)
+      {
+      case CompiledLine::Type::RamWrite:
+        length = GetDataTypeBytes(line.size) * line.count;
+        break;
+      case CompiledLine::Type::Add:
+      case CompiledLine::Type::Conditional:
+        length = GetDataTypeBytes(line.size);
+        break;
+      case CompiledLine::Type::WriteToPointer:
+        length = 4;
+        break;
+      default:
+        continue;
+      }
+
+      size_t direct_length = length;
+      u8* pointer = PowerPC::HostGetDirectPointer(line.address, &direct_length);
+      line.host_pointer = direct_length == length ? pointer : nullptr;
+    }
+  }
+  s_resolved_generation = PowerPC::GetDBATGeneration();
+}
+
+static u32 ReadValue(const u8* host_pointer, u32 address, u8 size)
+{
+  if (!host_pointer)
+  {
+    return size == DATATYPE_8BIT  ? PowerPC::HostRead_U8(address) :
+           size == DATATYPE_16BIT ? PowerPC::HostRead_U16(address) :
+                                    PowerPC::HostRead_U32(address);
+  }
+
+  switch (size)
+  {
+  case DATATYPE_8BIT:
+    return *host_pointer;
+  case DATATYPE_16BIT:
+  {
+    u16 value;
+    std::memcpy(&value, host_pointer, sizeof(value));
+    return Common::FromBigEndian(value);
+  }
+  default:
+  {
+    u32 value;
+    std::memcpy(&value, host_pointer, sizeof(value));
+    return Common::FromBigEndian(value);
+  }
+  }
+}
+
+static void WriteValue(u8* host_pointer, u32 address, u8 size, u32 value)
+{
+  if (!host_pointer)
+  {
+    if (size == DATATYPE_8BIT)
+      PowerPC::HostWrite_U8(value, address);
+    else if (size == DATATYPE_16BIT)
+      PowerPC::HostWrite_U16(value, address);
+    else
+      PowerPC::HostWrite_U32(value, address);
+    return;
+  }
+
+  switch (size)
+  {
+  case DATATYPE_8BIT:
+    *host_pointer = static_cast<u8>(value);
+    break;
+  case DATATYPE_16BIT:
+  {
+    const u16 swapped = Common::FromBigEndian(static_cast<u16>(value));
+    std::memcpy(host_pointer, &swapped, sizeof(swapped));
+    break;
+  }
+  default:
+  {
+    const u32 swapped = Common::FromBigEndian(value);
+    std::memcpy(host_pointer, &swapped, sizeof(swapped));
+    break;
+  }
+  }
+}
+
+// Same as RunCodeLocked, for the compiled lines of a code
+static bool RunCompiledCodeLocked(const ARCode& arcode, const std::vector<CompiledLine>& lines)
+{
+  bool do_fill_and_slide = false;
+  bool do_memory_copy = false;
+  int skip_count = 0;
+  u32 val_last = 0;
+
+  s_current_code = &arcode;
+
+  for (const CompiledLine& line : lines)
+  {
+    if (skip_count)
+    {
+      if (skip_count > 0)
+        --skip_count;
+      else if (-CONDTIONAL_ALL_LINES == skip_count)
+        return true;
+      else if (-CONDTIONAL_ALL_LINES_UNTIL == skip_count && line.cmd_addr == 0 &&
+               0x40000000 == line.data)
+        skip_count = 0;
+      continue;
+    }
+
+    if (do_fill_and_slide)
+    {
+      do_fill_and_slide = false;
+      if (false == ZeroCode_FillAndSlide(val_last, line.cmd_addr, line.data))
+        return false;
+      continue;
+    }
+
+    if (do_memory_copy)
+    {
+      do_memory_copy = false;
+      if (false == ZeroCode_MemoryCopy(val_last, line.cmd_addr, line.data))
+        return false;
+      continue;
+    }
+
+    const u32 bytes = GetDataTypeBytes(line.size);
+    switch (line.type)
+    {
+    case CompiledLine::Type::RamWrite:
+      for (u32 i = 0; i < line.count; ++i)
+      {
+        WriteValue(line.host_pointer ? line.host_pointer + i * bytes : nullptr,
+                   line.address + i * bytes, line.size, line.value);
+      }
+      break;
+
+    case CompiledLine::Type::WriteToPointer:
+    {
+      const u32 ptr = ReadValue(line.host_pointer, line.address, DATATYPE_32BIT);
+      WriteValue(nullptr, ptr + line.offset, line.size, line.value);
+      break;
+    }
+
+    case CompiledLine::Type::Add:
+    {
+      const u32 read = ReadValue(line.host_pointer, line.address, line.size);
+      u32 result = read + line.value;
+      if (line.size == DATATYPE_32BIT_FLOAT)
+      {
+        result = Common::BitCast<u32>(Common::BitCast<float>(read) +
+                                      static_cast<float>(line.value));
+      }
+      WriteValue(line.host_pointer, line.address, line.size, result);
+      break;
+    }
+
+    case CompiledLine::Type::Conditional:
+      if (!CompareValues(ReadValue(line.host_pointer, line.address, line.size), line.value,
+                         line.compare_type))
+      {
+        if (line.subtype == CONDTIONAL_ONE_LINE || line.subtype == CONDTIONAL_TWO_LINES)
+          skip_count = line.subtype + 1;
+        else
+          skip_count = -static_cast<int>(line.subtype);
+      }
+      break;
+
+    case CompiledLine::Type::EndOfCodes:
+      return true;
+
+    case CompiledLine::Type::Nop:
+      break;
+
+    case CompiledLine::Type::FillAndSlide:
+      do_fill_and_slide = true;
+      val_last = line.data;
+      break;
+
+    case CompiledLine::Type::MemoryCopy:
+      do_memory_copy = true;
+      val_last = line.data;
+      break;
+    }
+  }
+
+  return true;
+}
+
 void RunAllActive()
 {
-  if (!Config::Get(Config::MAIN_ENABLE_CHEATS))
+  if (!Config::GetSnapshot().enable_cheats)
     return;
 
   // If the mutex is idle then acquiring it should be cheap, fast mutexes
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard guard(s_lock);
-  s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
-                                        LogInfo("\n");
-                                        return !success;
-                                      }),
-                       s_active_codes.end());
-  s_disable_logging = true;
+  if (!s_codes_compiled)
+  {
+    s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
+                                        [](const ARCode& code) {
+                                          bool success = RunCodeLocked(code);
+                                          LogInfo("\n");
+                                          return !success;
+                                        }),
+                         s_active_codes.end());
+    s_disable_logging = true;
+    CompileActiveCodesLocked();
+    return;
+  }
+
+  if (s_resolved_generation != PowerPC::GetDBATGeneration())
+    ResolveCompiledCodesLocked();
+
+  std::vector<size_t> failed_codes;
+  for (const CompiledCode& compiled : s_compiled_codes)
+  {
+    const ARCode& code = s_active_codes[compiled.index];
+    const bool success = compiled.lines.empty() ? RunCodeLocked(code) :
+                                                  RunCompiledCodeLocked(code, compiled.lines);
+    if (!success)
+      failed_codes.push_back(compiled.index);
+  }
+
+  if (!failed_codes.empty())
+  {
+    for (auto it = failed_codes.rbegin(); it != failed_codes.rend(); ++it)
+      s_active_codes.erase(s_active_codes.begin() + *it);
+    CompileActiveCodesLocked();
+  }
 }
 
 }  // namespace ActionReplay
@@ -0,0 +1,215 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/CPUTimeBreakdown.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <mutex>
+
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/Movie.h"
+
+namespace CPUTimeBreakdown
+{
+std::atomic<bool> g_enabled{false};
+
+// Counters are only modified on the CPU thread. The mutex protects the deque itself, so counters
+// can be created from any thread.
+static std::mutex s_counters_mutex;
+static std::deque<Counter> s_counters;
+
+constexpr u32 EFB_COUNTER_INDEX = 128;
+
+static Scope* s_current_scope = nullptr;
+static bool s_frame_started = false;
+static Clock::time_point s_frame_start;
+
+static std::mutex s_last_frame_mutex;
+static FrameBreakdown s_last_frame;
+
+const char* GetCategoryName(Category category)
+{
+  switch (category)
+  {
+  case Category::CoreTiming:
+    return "CoreTiming";
+  case Category::MMIO:
+    return "MMIO";
+  case Category::HLE:
+    return "HLE";
+  case Category::Patches:
+    return "Patches";
+  case Category::Lua:
+    return "Lua";
+  }
+  return "Unknown";
+}
+
+Counter* GetCounter(Category category, const std::string& name)
+{
+  std::lock_guard lock(s_counters_mutex);
+  const auto it = std::find_if(s_counters.begin(), s_counters.end(), [&](const Counter& counter) {
+    return counter.category == category && counter.name == name;
+  });
+  if (it != s_counters.end())
+    return &*it;
+  return &s_counters.emplace_back(Counter{category, name});
+}
+
+static const char* GetMMIOBlockName(u32 index)
+{
+  if (index == EFB_COUNTER_INDEX)
+    return "EFB";
+
+  // Besides the GameCube blocks, the Wii has its own registers everywhere except 0x0D006000,
+  // where DI, SI, EXI and AI are mirrored
+  const bool wii = (index & 0x40) != 0;
+  const u32 block = (index >> 2) & 0xF;
+  if (wii && block != 6)
+    return "Hollywood";
+
+  switch (block)
+  {
+  case 0x0:
+    return "CP";
+  case 0x1:
+    return "PE";
+  case 0x2:
+    return "VI";
+  case 0x3:
+    return "PI";
+  case 0x4:
+    return "MI";
+  case 0x5:
+    return "DSP";
+  case 0x6:
+  {
+    static constexpr std::array<const char*, 4> names{"DI", "SI", "EXI", "AI"};
+    return names[index & 3];
+  }
+  case 0x8:
+    return "GPFifo";
+  default:
+    return "Unknown";
+  }
+}
+
+// Indexed by bits 10-15 of the address, plus 64 for the 0x0D000000 range of the Wii. The last one
+// is the EFB.
+static const std::array<Counter*, EFB_COUNTER_INDEX + 1> s_mmio_counters = [] {
+  std::array<Counter*, EFB_COUNTER_INDEX + 1> counters;
+  for (u32 i = 0; i < counters.size(); i++)
+    counters[i] = GetCounter(Category::MMIO, GetMMIOBlockName(i));
+  return counters;
+}();
+
+Counter* GetMMIOCounter(u32 address)
+{
+  if (address < 0x0C000000)
+    return s_mmio_counters[EFB_COUNTER_INDEX];
+  return s_mmio_counters[((address >> 18) & 0x40) | ((address >> 10) & 0x3F)];
+}
+
+bool IsCPUThread()
+{
+  return Core::IsCPUThread();
+}
+
+void Scope::Begin(Counter* counter)
+{
+  m_counter = counter;
+  m_parent = s_current_scope;
+  s_current_scope = this;
+  m_start = Clock::now();
+}
+
+void Scope::End()
+{
+  const Clock::duration elapsed = Clock::now() - m_start;
+  m_counter->time += elapsed - m_children;
+  m_counter->calls++;
+  if (m_parent)
+    m_parent->m_children += elapsed;
+  s_current_scope = m_parent;
+}
+
+static void ResetCounters()
+{
+  std::lock_guard lock(s_counters_mutex);
+  for (Counter& counter : s_counters)
+  {
+    counter.time = {};
+    counter.calls = 0;
+  }
+}
+
+void OnFrameEnd()
+{
+  const bool enabled = Config::Get(Config::MAIN_CPU_TIME_BREAKDOWN);
+  if (!enabled)
+  {
+    if (g_enabled.exchange(false))
+      Shutdown();
+    return;
+  }
+
+  const Clock::time_point now = Clock::now();
+  if (!s_frame_started)
+  {
+    // The first frame only starts the measurement, its counters are incomplete
+    ResetCounters();
+    s_frame_start = now;
+    s_frame_started = true;
+    g_enabled.store(true);
+    return;
+  }
+
+  const auto to_ms = [](Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+
+  FrameBreakdown breakdown;
+  breakdown.frame = Movie::GetCurrentFrame();
+  breakdown.frame_ms = to_ms(now - s_frame_start);
+  double measured_ms = 0.0;
+  {
+    std::lock_guard lock(s_counters_mutex);
+    for (Counter& counter : s_counters)
+    {
+      if (counter.calls == 0)
+        continue;
+      const double time_ms = to_ms(counter.time);
+      breakdown.entries.push_back({counter.category, counter.name, time_ms, counter.calls});
+      measured_ms += time_ms;
+      counter.time = {};
+      counter.calls = 0;
+    }
+  }
+  breakdown.emulated_code_ms = std::max(breakdown.frame_ms - measured_ms, 0.0);
+  std::sort(breakdown.entries.begin(), breakdown.entries.end(),
+            [](const FrameEntry& a, const FrameEntry& b) { return a.time_ms > b.time_ms; });
+
+  s_frame_start = now;
+  std::lock_guard lock(s_last_frame_mutex);
+  s_last_frame = std::move(breakdown);
+}
+
+FrameBreakdown GetLastFrame()
+{
+  std::lock_guard lock(s_last_frame_mutex);
+  return s_last_frame;
+}
+
+void Shutdown()
+{
+  g_enabled.store(false);
+  s_frame_started = false;
+  ResetCounters();
+  std::lock_guard lock(s_last_frame_mutex);
+  s_last_frame = {};
+}
+}  // namespace CPUTimeBreakdown
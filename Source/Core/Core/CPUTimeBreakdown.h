@@ -0,0 +1,120 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures the host time the CPU thread spends outside of the emulated code in every frame, split
+// by CoreTiming event, MMIO block, HLE function, frame patches and Lua scripts. Enabled by
+// Core.CPUTimeBreakdown, the result is shown in the statistics overlay and sent to the FrameStats
+// socket.
+//
+// Times are exclusive: the time of a nested scope, like an MMIO access of an HLE function, only
+// counts for the inner one. The remainder of the frame is the time spent running the JIT or the
+// interpreter, which includes the memory accesses that don't go through MMIO.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace CPUTimeBreakdown
+{
+using Clock = std::chrono::steady_clock;
+
+enum class Category
+{
+  CoreTiming,
+  MMIO,
+  HLE,
+  Patches,
+  Lua,
+};
+
+const char* GetCategoryName(Category category);
+
+struct Counter
+{
+  Category category;
+  std::string name;
+  Clock::duration time{};
+  u64 calls = 0;
+};
+
+struct FrameEntry
+{
+  Category category;
+  std::string name;
+  double time_ms;
+  u64 calls;
+};
+
+struct FrameBreakdown
+{
+  u64 frame = 0;
+  // Host time of the whole frame on the CPU thread
+  double frame_ms = 0.0;
+  // Frame time minus the entries, spent running the emulated code
+  double emulated_code_ms = 0.0;
+  // Sorted by descending time
+  std::vector<FrameEntry> entries;
+};
+
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// Returns the counter with this name, creating it if needed. Counters are never destroyed, so the
+// pointer can be kept by the caller.
+Counter* GetCounter(Category category, const std::string& name);
+
+// Returns the counter of the hardware block of a physical address, e.g. "PI" for 0x0C003000 or
+// "EFB" for 0x08000000
+Counter* GetMMIOCounter(u32 address);
+
+bool IsCPUThread();
+
+// Adds the time between its construction and destruction to a counter, minus the time of the
+// scopes nested inside it. Only active on the CPU thread while the breakdown is enabled.
+class Scope
+{
+public:
+  explicit Scope(Counter* counter)
+  {
+    if (IsEnabled() && IsCPUThread())
+      Begin(counter);
+  }
+
+  ~Scope()
+  {
+    if (m_counter)
+      End();
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  void Begin(Counter* counter);
+  void End();
+
+  Counter* m_counter = nullptr;
+  Scope* m_parent = nullptr;
+  Clock::time_point m_start;
+  Clock::duration m_children{};
+};
+
+// Called at the end of every emulated frame on the CPU thread. Reads the config, moves the counters
+// of the frame to the breakdown which GetLastFrame returns and resets them.
+void OnFrameEnd();
+
+// The breakdown of the last finished frame. Can be called from any thread.
+FrameBreakdown GetLastFrame();
+
+// Forgets the breakdown of the last frame, called when emulation stops
+void Shutdown();
+}  // namespace CPUTimeBreakdown
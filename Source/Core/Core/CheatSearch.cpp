@@ -3,6 +3,8 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <functional>
 #include <memory>
@@ -15,6 +17,7 @@
 #include "Common/Align.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -185,6 +188,29 @@ PowerPC::TryReadResult<double> TryReadValueFromEmulatedMemory(u32 addr,
 {
   return PowerPC::HostTryReadF64(addr, space);
 }
+
+// Memory is read a page at a time, so that each page only gets translated once
+constexpr u32 SEARCH_CHUNK_SIZE = PowerPC::HW_PAGE_SIZE;
+
+template <typename T>
+static T ReadBigEndianValue(const u8* data)
+{
+  if constexpr (sizeof(T) == 1)
+    return Common::BitCast<T>(*data);
+  else if constexpr (sizeof(T) == 2)
+    return Common::BitCast<T>(Common::swap16(data));
+  else if constexpr (sizeof(T) == 4)
+    return Common::BitCast<T>(Common::swap32(data));
+  else
+    return Common::BitCast<T>(Common::swap64(data));
+}
+
+// Whether a successful range read in the given address space went through address translation
+static bool IsTranslated(PowerPC::RequestedAddressSpace space)
+{
+  return space == PowerPC::RequestedAddressSpace::Virtual ||
+         (space == PowerPC::RequestedAddressSpace::Effective && MSR.DR);
+}
 }  // namespace
 
 template <typename T>
@@ -210,27 +236,60 @@ Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
       return;
     }
 
+    const auto chunk_value_state = IsTranslated(address_space) ?
+                                       Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                       Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+    std::array<u8, SEARCH_CHUNK_SIZE + sizeof(T) - 1> chunk;
+
     for (const Cheats::MemoryRange& range : memory_ranges)
     {
       const u32 increment_per_loop = aligned ? data_size : 1;
       const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
       const u64 aligned_length = range.m_length - (start_address - range.m_start);
       const u64 length = aligned_length - (data_size - 1);
-      for (u64 i = 0; i < length; i += increment_per_loop)
+      u64 i = 0;
+      while (i < length)
       {
-        const u32 addr = start_address + i;
-        const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
-        if (!current_value)
+        // Values starting within the same page are read from a single copy of that page, which
+        // also holds the bytes of the last values that reach into the next page
+        const u32 chunk_address = start_address + i;
+        const u64 chunk_end = std::min<u64>(
+            length, i + SEARCH_CHUNK_SIZE - (chunk_address & (SEARCH_CHUNK_SIZE - 1)));
+        const size_t chunk_size = chunk_end - i + (data_size - 1);
+
+        if (PowerPC::HostTryReadRange(chunk_address, chunk.data(), chunk_size, address_space))
+        {
+          for (; i < chunk_end; i += increment_per_loop)
+          {
+            const T value = ReadBigEndianValue<T>(&chunk[start_address + i - chunk_address]);
+            if (validator(value))
+            {
+              auto& r = results.emplace_back();
+              r.m_value = value;
+              r.m_value_state = chunk_value_state;
+              r.m_address = start_address + i;
+            }
+          }
           continue;
+        }
 
-        if (validator(current_value.value))
+        // Parts of this chunk aren't RAM, so check each value on its own
+        for (; i < chunk_end; i += increment_per_loop)
         {
-          auto& r = results.emplace_back();
-          r.m_value = current_value.value;
-          r.m_value_state = current_value.translated ?
-                                Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                                Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-          r.m_address = addr;
+          const u32 addr = start_address + i;
+          const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
+          if (!current_value)
+            continue;
+
+          if (validator(current_value.value))
+          {
+            auto& r = results.emplace_back();
+            r.m_value = current_value.value;
+            r.m_value_state = current_value.translated ?
+                                  Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                  Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+            r.m_address = addr;
+          }
         }
       }
     }
@@ -262,10 +321,38 @@ Cheats::NextSearch(const std::vector<Cheats::SearchResult<T>>& previous_results,
       return;
     }
 
+    results.reserve(previous_results.size());
+    const bool translated = IsTranslated(address_space);
+    std::array<u8, SEARCH_CHUNK_SIZE> chunk;
+    u32 chunk_address = 0;
+    bool chunk_loaded = false;
+    bool chunk_valid = false;
+
     for (const auto& previous_result : previous_results)
     {
       const u32 addr = previous_result.m_address;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
+      const u32 page_address = addr & ~(SEARCH_CHUNK_SIZE - 1);
+      const bool fits_in_page = addr - page_address <= SEARCH_CHUNK_SIZE - sizeof(T);
+
+      // Results are usually sorted by address, so most of them share a page with the previous one
+      if (fits_in_page && (!chunk_loaded || chunk_address != page_address))
+      {
+        chunk_address = page_address;
+        chunk_loaded = true;
+        chunk_valid =
+            PowerPC::HostTryReadRange(chunk_address, chunk.data(), chunk.size(), address_space);
+      }
+
+      PowerPC::TryReadResult<T> current_value;
+      if (fits_in_page && chunk_valid)
+      {
+        current_value = PowerPC::TryReadResult<T>(
+            translated, ReadBigEndianValue<T>(&chunk[addr - chunk_address]));
+      }
+      else
+      {
+        current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
+      }
       if (!current_value)
       {
         auto& r = results.emplace_back();
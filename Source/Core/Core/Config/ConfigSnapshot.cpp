@@ -0,0 +1,63 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Config/ConfigSnapshot.h"
+
+#include <atomic>
+#include <memory>
+
+#include "Common/Config/Config.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Config/NetplaySettings.h"
+#include "Core/Config/SYSCONFSettings.h"
+
+namespace Config
+{
+// The latest published snapshot, only accessed with std::atomic_load and std::atomic_store. Every
+// thread keeps a reference to the one it uses, so older snapshots live until no thread uses them.
+static std::shared_ptr<const Snapshot> s_snapshot;
+
+static std::shared_ptr<const Snapshot> BuildSnapshot(u64 config_version)
+{
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->config_version = config_version;
+
+  snapshot->enable_cheats = Get(MAIN_ENABLE_CHEATS);
+  snapshot->dsp_hle_thread = Get(MAIN_DSP_HLE_THREAD);
+  snapshot->rewind_enabled = Get(MAIN_REWIND_ENABLED);
+  snapshot->rewind_interval = Get(MAIN_REWIND_INTERVAL);
+  snapshot->greenzone_enabled = Get(MAIN_GREENZONE_ENABLED);
+  snapshot->greenzone_interval = Get(MAIN_GREENZONE_INTERVAL);
+  snapshot->osd_messages = Get(MAIN_OSD_MESSAGES);
+  snapshot->sensor_bar_position = Get(SYSCONF_SENSOR_BAR_POSITION);
+  snapshot->late_input_latch = Get(MAIN_LATE_INPUT_LATCH);
+
+  snapshot->early_xfb_output = Get(GFX_HACK_EARLY_XFB_OUTPUT);
+  snapshot->fast_frame_dumps = Get(GFX_FAST_FRAME_DUMPS);
+  snapshot->netplay_golf_mode_overlay = Get(NETPLAY_GOLF_MODE_OVERLAY);
+
+  return snapshot;
+}
+
+const Snapshot& GetSnapshot()
+{
+  thread_local std::shared_ptr<const Snapshot> t_snapshot;
+
+  const u64 config_version = GetConfigVersion();
+  if (t_snapshot && t_snapshot->config_version == config_version)
+    return *t_snapshot;
+
+  std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&s_snapshot);
+  if (!snapshot || snapshot->config_version != config_version)
+  {
+    // Threads racing here build equivalent snapshots, whichever is stored last wins. If the config
+    // changes while building, the next call sees the new version and builds again.
+    snapshot = BuildSnapshot(config_version);
+    std::atomic_store(&s_snapshot, snapshot);
+  }
+
+  t_snapshot = std::move(snapshot);
+  return *t_snapshot;
+}
+}  // namespace Config
@@ -0,0 +1,34 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace Config
+{
+// The settings read on the hot paths of the CPU, audio and GPU threads. A new snapshot is built
+// once per config version, so reading it doesn't take the locks of Config::Get.
+struct Snapshot
+{
+  u64 config_version = 0;
+
+  bool enable_cheats = false;
+  bool dsp_hle_thread = false;
+  bool rewind_enabled = false;
+  int rewind_interval = 1;
+  bool greenzone_enabled = false;
+  int greenzone_interval = 1;
+  bool osd_messages = false;
+  u32 sensor_bar_position = 0;
+  bool late_input_latch = false;
+
+  bool early_xfb_output = false;
+  bool fast_frame_dumps = false;
+  bool netplay_golf_mode_overlay = false;
+};
+
+// Returns the snapshot of the current config version. The reference stays valid until the next
+// call on the same thread.
+const Snapshot& GetSnapshot();
+}  // namespace Config
@@ -7,6 +7,7 @@
 
 #include "AudioCommon/AudioCommon.h"
 #include "Common/Config/Config.h"
+#include "Common/Thread.h"
 #include "Core/Config/DefaultLocale.h"
 #include "Core/HW/EXI/EXI_Device.h"
 #include "Core/HW/Memmap.h"
@@ -23,13 +24,41 @@ const Info<bool> MAIN_SKIP_IPL{{System::Main, "Core", "SkipIPL"}, true};
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_TIERING{{System::Main, "Core", "JITTiering"}, false};
+const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD{{System::Main, "Core", "JITTierUpThreshold"}, 1000};
+const Info<bool> MAIN_JIT_INTERPRET_COLD_BLOCKS{{System::Main, "Core", "JITInterpretColdBlocks"},
+                                                false};
+const Info<bool> MAIN_JIT_EVICT_COLD_BLOCKS{{System::Main, "Core", "JITEvictColdBlocks"}, false};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
+// Backs emulated RAM and the JIT code caches with huge pages where the host allows it
+const Info<bool> MAIN_LARGE_PAGES{{System::Main, "Core", "LargePages"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
 const Info<bool> MAIN_CPU_THREAD{{System::Main, "Core", "CPUThread"}, true};
+// Core lists like "0-3,8" for the threads of each Common::ThreadRole. When empty, the CPU and GPU
+// threads prefer performance cores and background work efficiency cores on hybrid hosts.
+const Info<std::string> MAIN_CPU_THREAD_CORES{{System::Main, "Core", "CPUThreadCores"}, ""};
+const Info<Common::ThreadPriority> MAIN_CPU_THREAD_PRIORITY{
+    {System::Main, "Core", "CPUThreadPriority"}, Common::ThreadPriority::Normal};
+const Info<std::string> MAIN_GPU_THREAD_CORES{{System::Main, "Core", "GPUThreadCores"}, ""};
+const Info<Common::ThreadPriority> MAIN_GPU_THREAD_PRIORITY{
+    {System::Main, "Core", "GPUThreadPriority"}, Common::ThreadPriority::Normal};
+const Info<std::string> MAIN_DSP_THREAD_CORES{{System::Main, "Core", "DSPThreadCores"}, ""};
+const Info<Common::ThreadPriority> MAIN_DSP_THREAD_PRIORITY{
+    {System::Main, "Core", "DSPThreadPriority"}, Common::ThreadPriority::Normal};
+const Info<std::string> MAIN_AUDIO_THREAD_CORES{{System::Main, "Core", "AudioThreadCores"}, ""};
+const Info<Common::ThreadPriority> MAIN_AUDIO_THREAD_PRIORITY{
+    {System::Main, "Core", "AudioThreadPriority"}, Common::ThreadPriority::Normal};
+const Info<std::string> MAIN_BACKGROUND_THREAD_CORES{
+    {System::Main, "Core", "BackgroundThreadCores"}, ""};
+const Info<Common::ThreadPriority> MAIN_BACKGROUND_THREAD_PRIORITY{
+    {System::Main, "Core", "BackgroundThreadPriority"}, Common::ThreadPriority::Low};
 const Info<bool> MAIN_SYNC_ON_SKIP_IDLE{{System::Main, "Core", "SyncOnSkipIdle"}, true};
 const Info<std::string> MAIN_DEFAULT_ISO{{System::Main, "Core", "DefaultISO"}, ""};
 const Info<bool> MAIN_ENABLE_CHEATS{{System::Main, "Core", "EnableCheats"}, false};
+// Replaces memcpy and similar functions with host implementations when their symbols are known.
+// This skips the emulated cycles of the functions, so it changes the timing of the game.
+const Info<bool> MAIN_HLE_LIBRARY_FUNCTIONS{{System::Main, "Core", "HLELibraryFunctions"}, false};
 const Info<int> MAIN_GC_LANGUAGE{{System::Main, "Core", "SelectedLanguage"}, 0};
 const Info<bool> MAIN_OVERRIDE_REGION_SETTINGS{{System::Main, "Core", "OverrideRegionSettings"},
                                                false};
@@ -71,6 +100,10 @@ Info<bool> GetInfoForSimulateKonga(u32 channel)
   return {{System::Main, "Core", fmt::format("SimulateKonga{}", channel)}, false};
 }
 
+// Samples the GC controllers when the game reads the SI input buffer instead of at the SI poll,
+// which shortens the delay between the host input and the game seeing it
+const Info<bool> MAIN_LATE_INPUT_LATCH{{System::Main, "Core", "LateInputLatch"}, false};
+
 const Info<bool> MAIN_WII_SD_CARD{{System::Main, "Core", "WiiSDCard"}, true};
 const Info<bool> MAIN_WII_KEYBOARD{{System::Main, "Core", "WiiKeyboard"}, false};
 const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING{
@@ -110,6 +143,13 @@ const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrit
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
+// 0 uses one thread per hardware thread
+const Info<int> MAIN_SAVESTATE_COMPRESSION_THREADS{
+    {System::Main, "Core", "SavestateCompressionThreads"}, 0};
+// Measure the CPU thread time outside of the emulated code, see CPUTimeBreakdown.h
+const Info<bool> MAIN_CPU_TIME_BREAKDOWN{{System::Main, "Core", "CPUTimeBreakdown"}, false};
+// Set by the game INIs of the games which stay in sync when netplay rolls them back
+const Info<bool> MAIN_NETPLAY_ROLLBACK_SUPPORTED{{System::Main, "Core", "NetPlayRollback"}, false};
 
 // Main.Display
 
@@ -130,6 +170,7 @@ const Info<bool> MAIN_DISABLE_SCREENSAVER{{System::Main, "Display", "DisableScre
 
 const Info<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const Info<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
+const Info<bool> MAIN_DSP_HLE_THREAD{{System::Main, "DSP", "HLEThread"}, false};
 const Info<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
 const Info<bool> MAIN_DUMP_AUDIO_SILENT{{System::Main, "DSP", "DumpAudioSilent"}, false};
 const Info<bool> MAIN_DUMP_UCODE{{System::Main, "DSP", "DumpUCode"}, false};
@@ -172,6 +213,46 @@ const Info<bool> MAIN_NETWORK_DUMP_AS_PCAP{{System::Main, "Network", "DumpAsPCAP
 //  - https://dolp.in/pr8759 hwtest (3 minutes and 10 seconds)
 const Info<int> MAIN_NETWORK_TIMEOUT{{System::Main, "Network", "NetworkTimeout"}, 190};
 
+// Main.Rewind
+
+const Info<bool> MAIN_REWIND_ENABLED{{System::Main, "Rewind", "Enabled"}, false};
+// Frames between two captured states
+const Info<int> MAIN_REWIND_INTERVAL{{System::Main, "Rewind", "Interval"}, 5};
+// Captured states that share one RAM copy
+const Info<int> MAIN_REWIND_KEYFRAME_INTERVAL{{System::Main, "Rewind", "KeyframeInterval"}, 60};
+const Info<int> MAIN_REWIND_MEMORY_MB{{System::Main, "Rewind", "MemoryMB"}, 512};
+
+// Main.Greenzone
+
+const Info<bool> MAIN_GREENZONE_ENABLED{{System::Main, "Greenzone", "Enabled"}, false};
+// Movie frames between two captured states
+const Info<int> MAIN_GREENZONE_INTERVAL{{System::Main, "Greenzone", "Interval"}, 60};
+const Info<int> MAIN_GREENZONE_MEMORY_MB{{System::Main, "Greenzone", "MemoryMB"}, 1024};
+
+// Main.Movie
+
+// Frames per hash of the emulated state stored in recorded movies, 0 to store none. Playback
+// compares the hashes to report the first interval which desynced.
+const Info<int> MAIN_MOVIE_STATE_HASH_INTERVAL{{System::Main, "Movie", "StateHashInterval"}, 0};
+
+// Main.MemoryWatcher
+
+const Info<bool> MAIN_MEMORYWATCHER_BINARY{{System::Main, "MemoryWatcher", "Binary"}, false};
+// Poll when the game polls its controllers instead of at the end of each field
+const Info<bool> MAIN_MEMORYWATCHER_POLL_ON_INPUT{{System::Main, "MemoryWatcher", "PollOnInput"},
+                                                  false};
+// Polls between two reads of the watched addresses
+const Info<int> MAIN_MEMORYWATCHER_INTERVAL{{System::Main, "MemoryWatcher", "Interval"}, 1};
+// Send the statistics of every presented frame to the FrameStats socket
+const Info<bool> MAIN_MEMORYWATCHER_FRAME_STATS{{System::Main, "MemoryWatcher", "FrameStats"},
+                                                false};
+
+// Main.RAMExport
+
+const Info<bool> MAIN_RAM_EXPORT_ENABLED{{System::Main, "RAMExport", "Enabled"}, false};
+// Frames between two copies of emulated RAM into the shared memory segment
+const Info<int> MAIN_RAM_EXPORT_INTERVAL{{System::Main, "RAMExport", "Interval"}, 1};
+
 // Main.Interface
 
 const Info<bool> MAIN_USE_HIGH_CONTRAST_TOOLTIPS{
@@ -19,6 +19,11 @@ namespace AudioCommon
 enum class DPL2Quality;
 }
 
+namespace Common
+{
+enum class ThreadPriority;
+}
+
 namespace Config
 {
 // Main.Core
@@ -26,14 +31,30 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_TIERING;
+extern const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD;
+extern const Info<bool> MAIN_JIT_INTERPRET_COLD_BLOCKS;
+extern const Info<bool> MAIN_JIT_EVICT_COLD_BLOCKS;
 extern const Info<bool> MAIN_FASTMEM;
+extern const Info<bool> MAIN_LARGE_PAGES;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
 extern const Info<int> MAIN_TIMING_VARIANCE;
 extern const Info<bool> MAIN_CPU_THREAD;
+extern const Info<std::string> MAIN_CPU_THREAD_CORES;
+extern const Info<Common::ThreadPriority> MAIN_CPU_THREAD_PRIORITY;
+extern const Info<std::string> MAIN_GPU_THREAD_CORES;
+extern const Info<Common::ThreadPriority> MAIN_GPU_THREAD_PRIORITY;
+extern const Info<std::string> MAIN_DSP_THREAD_CORES;
+extern const Info<Common::ThreadPriority> MAIN_DSP_THREAD_PRIORITY;
+extern const Info<std::string> MAIN_AUDIO_THREAD_CORES;
+extern const Info<Common::ThreadPriority> MAIN_AUDIO_THREAD_PRIORITY;
+extern const Info<std::string> MAIN_BACKGROUND_THREAD_CORES;
+extern const Info<Common::ThreadPriority> MAIN_BACKGROUND_THREAD_PRIORITY;
 extern const Info<bool> MAIN_SYNC_ON_SKIP_IDLE;
 extern const Info<std::string> MAIN_DEFAULT_ISO;
 extern const Info<bool> MAIN_ENABLE_CHEATS;
+extern const Info<bool> MAIN_HLE_LIBRARY_FUNCTIONS;
 extern const Info<int> MAIN_GC_LANGUAGE;
 extern const Info<bool> MAIN_OVERRIDE_REGION_SETTINGS;
 extern const Info<bool> MAIN_DPL2_DECODER;
@@ -54,6 +75,7 @@ extern const Info<std::string> MAIN_BBA_MAC;
 Info<u32> GetInfoForSIDevice(u32 channel);
 Info<bool> GetInfoForAdapterRumble(u32 channel);
 Info<bool> GetInfoForSimulateKonga(u32 channel);
+extern const Info<bool> MAIN_LATE_INPUT_LATCH;
 extern const Info<bool> MAIN_WII_SD_CARD;
 extern const Info<bool> MAIN_WII_KEYBOARD;
 extern const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING;
@@ -88,11 +110,15 @@ extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
+extern const Info<int> MAIN_SAVESTATE_COMPRESSION_THREADS;
+extern const Info<bool> MAIN_CPU_TIME_BREAKDOWN;
+extern const Info<bool> MAIN_NETPLAY_ROLLBACK_SUPPORTED;
 
 // Main.DSP
 
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+extern const Info<bool> MAIN_DSP_HLE_THREAD;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const Info<bool> MAIN_DUMP_UCODE;
@@ -138,6 +164,35 @@ extern const Info<bool> MAIN_NETWORK_SSL_DUMP_PEER_CERT;
 extern const Info<bool> MAIN_NETWORK_DUMP_AS_PCAP;
 extern const Info<int> MAIN_NETWORK_TIMEOUT;
 
+// Main.Rewind
+
+extern const Info<bool> MAIN_REWIND_ENABLED;
+extern const Info<int> MAIN_REWIND_INTERVAL;
+extern const Info<int> MAIN_REWIND_KEYFRAME_INTERVAL;
+extern const Info<int> MAIN_REWIND_MEMORY_MB;
+
+// Main.Greenzone
+
+extern const Info<bool> MAIN_GREENZONE_ENABLED;
+extern const Info<int> MAIN_GREENZONE_INTERVAL;
+extern const Info<int> MAIN_GREENZONE_MEMORY_MB;
+
+// Main.Movie
+
+extern const Info<int> MAIN_MOVIE_STATE_HASH_INTERVAL;
+
+// Main.MemoryWatcher
+
+extern const Info<bool> MAIN_MEMORYWATCHER_BINARY;
+extern const Info<bool> MAIN_MEMORYWATCHER_POLL_ON_INPUT;
+extern const Info<int> MAIN_MEMORYWATCHER_INTERVAL;
+extern const Info<bool> MAIN_MEMORYWATCHER_FRAME_STATS;
+
+// Main.RAMExport
+
+extern const Info<bool> MAIN_RAM_EXPORT_ENABLED;
+extern const Info<int> MAIN_RAM_EXPORT_INTERVAL;
+
 // Main.Interface
 
 extern const Info<bool> MAIN_USE_HIGH_CONTRAST_TOOLTIPS;
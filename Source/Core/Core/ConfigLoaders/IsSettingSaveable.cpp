@@ -26,7 +26,8 @@ bool IsSettingSaveable(const Config::Location& config_location)
   if (config_location.system == Config::System::Main)
   {
     for (const std::string_view section :
-         {"NetPlay", "General", "GBA", "Display", "Network", "Analytics", "AndroidOverlayButtons"})
+         {"NetPlay", "General", "GBA", "Display", "Network", "Analytics", "AndroidOverlayButtons",
+          "Rewind", "Greenzone"})
     {
       if (config_location.section == section)
         return true;
@@ -64,6 +65,11 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_ENABLE_SAVESTATES.GetLocation(),
       &Config::MAIN_FALLBACK_REGION.GetLocation(),
       &Config::MAIN_REAL_WII_REMOTE_REPEAT_REPORTS.GetLocation(),
+      &Config::MAIN_SAVESTATE_COMPRESSION_THREADS.GetLocation(),
+
+      // Main.DSP
+
+      &Config::MAIN_DSP_HLE_THREAD.GetLocation(),
 
       // Main.Interface
 
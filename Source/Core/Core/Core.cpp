@@ -7,6 +7,7 @@
 #include <atomic>
 #include <cstring>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <utility>
 #include <variant>
@@ -40,12 +41,16 @@
 
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/CPUTimeBreakdown.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/FreeLookManager.h"
+#include "Core/Greenzone.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/HW/DSP.h"
@@ -64,8 +69,13 @@
 #include "Core/NetPlayClient.h"
 #include "Core/NetPlayProto.h"
 #include "Core/PatchEngine.h"
+#include "Core/PowerPC/InstructionTrace.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/ProfileTrace.h"
+#include "Core/RAMExport.h"
+#include "Core/Rewind.h"
+#include "Core/StartupTrace.h"
 #include "Core/State.h"
 #include "Core/WiiRoot.h"
 
@@ -77,6 +87,18 @@
 #include "Core/MemoryWatcher.h"
 #endif
 
+#ifdef USE_FRAMESTEP_SOCKET
+#include "Core/FrameStepSocket.h"
+#endif
+
+#ifdef USE_FRAMESTATS_SOCKET
+#include "Core/FrameStatsSocket.h"
+#endif
+
+#ifdef USE_REMOTECONTROL_SOCKET
+#include "Core/RemoteControlSocket.h"
+#endif
+
 #include "InputCommon/ControlReference/ControlReference.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 #include "InputCommon/GCAdapter.h"
@@ -87,7 +109,6 @@
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
-#include "VideoCommon/Statistics.h"
 
 #ifdef ANDROID
 #include "jni/AndroidCommon/IDCache.h"
@@ -108,6 +129,7 @@ static bool s_is_started = false;
 static Common::Flag s_is_booting;
 static std::thread s_emu_thread;
 static std::vector<StateChangedCallbackFunc> s_on_state_changed_callbacks;
+static FrameEndCallbackFunc s_on_frame_end_callback;
 
 static std::thread s_cpu_thread;
 static bool s_request_refresh_info = false;
@@ -115,11 +137,26 @@ static bool s_is_throttler_temp_disabled = false;
 static std::atomic<double> s_last_actual_emulation_speed{1.0};
 static bool s_frame_step = false;
 static std::atomic<bool> s_stop_frame_step;
+static std::atomic<u32> s_frames_to_step{0};
+static Common::Event s_frame_steps_done;
 
 #ifdef USE_MEMORYWATCHER
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
 #endif
 
+#ifdef USE_FRAMESTEP_SOCKET
+static std::unique_ptr<FrameStepSocket> s_frame_step_socket;
+#endif
+
+#ifdef USE_REMOTECONTROL_SOCKET
+static std::unique_ptr<RemoteControlSocket> s_remote_control_socket;
+#endif
+
+#ifdef USE_FRAMESTATS_SOCKET
+// Used by the thread that presents frames, so it lives until both the CPU and GPU threads are done
+static std::unique_ptr<FrameStatsSocket> s_frame_stats_socket;
+#endif
+
 struct HostJob
 {
   std::function<void()> job;
@@ -135,7 +172,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
 bool GetIsThrottlerTempDisabled()
 {
-  return s_is_throttler_temp_disabled;
+  return s_is_throttler_temp_disabled || s_frames_to_step.load() != 0 || Greenzone::IsSeeking();
 }
 
 void SetIsThrottlerTempDisabled(bool disable)
@@ -158,7 +195,33 @@ void OnFrameEnd()
 {
 #ifdef USE_MEMORYWATCHER
   if (s_memory_watcher)
-    s_memory_watcher->Step();
+    s_memory_watcher->Step(MemoryWatcher::PollPoint::FrameEnd);
+#endif
+
+  Rewind::OnFrameEnd();
+  if (NetPlay::IsNetPlayRunning())
+    NetPlay::NetPlayClient::OnFrameEnd();
+  Greenzone::OnFrameEnd();
+  ProfileTrace::OnFrameEnd();
+  CPUTimeBreakdown::OnFrameEnd();
+  RAMExport::OnFrameEnd();
+
+  if (s_on_frame_end_callback)
+    s_on_frame_end_callback();
+
+  if (s_frames_to_step.load() != 0 && s_frames_to_step.fetch_sub(1) == 1)
+  {
+    CPU::Break();
+    CallOnStateChangedCallbacks(GetState());
+    s_frame_steps_done.Set();
+  }
+}
+
+void OnInputPoll()
+{
+#ifdef USE_MEMORYWATCHER
+  if (s_memory_watcher)
+    s_memory_watcher->Step(MemoryWatcher::PollPoint::InputPoll);
 #endif
 }
 
@@ -222,6 +285,38 @@ bool WantsDeterminism()
   return s_wants_determinism;
 }
 
+static void SetThreadRolePolicy(Common::ThreadRole role, const Config::Info<std::string>& cores,
+                                const Config::Info<Common::ThreadPriority>& priority,
+                                u64 default_mask)
+{
+  Common::ThreadPolicy policy;
+  const std::string& core_list = Config::Get(cores);
+  policy.affinity_mask = core_list.empty() ? default_mask : Common::ParseCoreList(core_list);
+  if (!core_list.empty() && policy.affinity_mask == 0)
+  {
+    WARN_LOG_FMT(BOOT, "Ignoring invalid core list \"{}\" in {}", core_list,
+                 cores.GetLocation().key);
+  }
+  policy.priority = Config::Get(priority);
+  Common::SetThreadRolePolicy(role, policy);
+}
+
+static void SetThreadRolePolicies()
+{
+  const u64 performance_cores = Common::GetPerformanceCoreMask();
+  const u64 efficiency_cores = Common::GetEfficiencyCoreMask();
+  SetThreadRolePolicy(Common::ThreadRole::CPU, Config::MAIN_CPU_THREAD_CORES,
+                      Config::MAIN_CPU_THREAD_PRIORITY, performance_cores);
+  SetThreadRolePolicy(Common::ThreadRole::GPU, Config::MAIN_GPU_THREAD_CORES,
+                      Config::MAIN_GPU_THREAD_PRIORITY, performance_cores);
+  SetThreadRolePolicy(Common::ThreadRole::DSP, Config::MAIN_DSP_THREAD_CORES,
+                      Config::MAIN_DSP_THREAD_PRIORITY, 0);
+  SetThreadRolePolicy(Common::ThreadRole::Audio, Config::MAIN_AUDIO_THREAD_CORES,
+                      Config::MAIN_AUDIO_THREAD_PRIORITY, 0);
+  SetThreadRolePolicy(Common::ThreadRole::Background, Config::MAIN_BACKGROUND_THREAD_CORES,
+                      Config::MAIN_BACKGROUND_THREAD_PRIORITY, efficiency_cores);
+}
+
 // This is called from the GUI thread. See the booting call schedule in
 // BootManager.cpp
 bool Init(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
@@ -253,6 +348,9 @@ bool Init(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
   WindowSystemInfo prepared_wsi(wsi);
   g_video_backend->PrepareWindow(prepared_wsi);
 
+  // Before any of the emulation threads start
+  SetThreadRolePolicies();
+
   // Start the emu thread
   s_is_booting.Set();
   s_emu_thread = std::thread(EmuThread, std::move(boot), prepared_wsi);
@@ -293,7 +391,6 @@ void Stop()  // - Hammertime!
 
   // Stop the CPU
   INFO_LOG_FMT(CONSOLE, "{}", StopMessage(true, "Stop CPU"));
-  Statistics::ClearLuaText(); // Clear Lua text so we don't have to do this manually
   CPU::Stop();
 
   if (_CoreParameter.bCPUThread)
@@ -342,6 +439,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
     Common::SetCurrentThreadName("CPU thread");
   else
     Common::SetCurrentThreadName("CPU-GPU thread");
+  Common::ApplyThreadRole(Common::ThreadRole::CPU);
 
   // This needs to be delayed until after the video backend is ready.
   DolphinAnalytics::Instance().ReportGameStart();
@@ -359,6 +457,14 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   s_memory_watcher = std::make_unique<MemoryWatcher>();
 #endif
 
+#ifdef USE_FRAMESTEP_SOCKET
+  s_frame_step_socket = std::make_unique<FrameStepSocket>();
+#endif
+
+#ifdef USE_REMOTECONTROL_SOCKET
+  s_remote_control_socket = std::make_unique<RemoteControlSocket>();
+#endif
+
   if (savestate_path)
   {
     ::State::LoadAs(*savestate_path);
@@ -389,12 +495,26 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   // Enter CPU run loop. When we leave it - we are done.
   CPU::Run();
 
+  // Release anyone still waiting for a frame step
+  s_frames_to_step = 0;
+  s_frame_steps_done.Set();
+
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
 
   s_is_started = false;
 
+#ifdef USE_FRAMESTEP_SOCKET
+  // After s_is_started is cleared, so that a step requested during shutdown can't block this
+  s_frame_step_socket.reset();
+#endif
+
+#ifdef USE_REMOTECONTROL_SOCKET
+  // Also after s_is_started is cleared, for the same reason
+  s_remote_control_socket.reset();
+#endif
+
   if (_CoreParameter.bFastmem)
     EMM::UninstallExceptionHandler();
 }
@@ -409,6 +529,7 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
     Common::SetCurrentThreadName("FIFO player thread");
   else
     Common::SetCurrentThreadName("FIFO-GPU thread");
+  Common::ApplyThreadRole(Common::ThreadRole::CPU);
 
   // Enter CPU run loop. When we leave it - we are done.
   if (auto cpu_core = FifoPlayer::GetInstance().GetCPUCore())
@@ -437,6 +558,7 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
 // See the BootManager.cpp file description for a complete call schedule.
 static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi)
 {
+  StartupTrace::Begin();
   const SConfig& core_parameter = SConfig::GetInstance();
   CallOnStateChangedCallbacks(State::Starting);
   Common::ScopeGuard flag_guard{[] {
@@ -460,6 +582,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   // it to provide the configuration dialogs. In this case, instead of re-initializing
   // entirely, we switch the window used for inputs to the render window. This way, the
   // cursor position is relative to the render window, instead of the main window.
+  std::optional<StartupTrace::Span> controller_span{"Initialize controllers"};
   bool init_controllers = false;
   if (!g_controller_interface.IsInit())
   {
@@ -507,6 +630,12 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   {
     FreeLook::LoadInputConfig();
   }
+  controller_span.reset();
+
+  // Loading the inputs may have generated dynamic custom textures, so the texture directories must
+  // only be searched now. This runs while the hardware and the video backend are initialized.
+  if (Config::Get(Config::GFX_HIRES_TEXTURES))
+    HiresTexture::StartIndexing(SConfig::GetInstance().GetGameID());
 
   Common::ScopeGuard controller_guard{[init_controllers, init_wiimotes] {
     if (!init_controllers)
@@ -531,12 +660,23 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   Movie::Init(*boot);
   Common::ScopeGuard movie_guard{&Movie::Shutdown};
 
-  AudioCommon::InitSoundStream();
+  {
+    StartupTrace::Span span("Initialize sound stream");
+    AudioCommon::InitSoundStream();
+  }
   Common::ScopeGuard audio_guard{&AudioCommon::ShutdownSoundStream};
 
-  Lua::Init();
+  {
+    StartupTrace::Span span("Initialize Lua");
+    Lua::Init();
+  }
+  Rewind::Init();
+  Greenzone::Init();
 
-  HW::Init();
+  {
+    StartupTrace::Span span("Initialize hardware");
+    HW::Init();
+  }
 
   Common::ScopeGuard hw_guard{[] {
     // We must set up this flag before executing HW::Shutdown()
@@ -554,16 +694,25 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
     PatchEngine::Shutdown();
     Lua::Shutdown();
+    Rewind::Shutdown();
+    Greenzone::Shutdown();
+    ProfileTrace::Stop();
+    InstructionTrace::Stop();
+    CPUTimeBreakdown::Shutdown();
+    RAMExport::Shutdown();
     HLE::Clear();
     PowerPC::debug_interface.Clear();
   }};
 
-  VideoBackendBase::PopulateBackendInfo();
-
-  if (!g_video_backend->Initialize(wsi))
   {
-    PanicAlertFmt("Failed to initialize video backend!");
-    return;
+    StartupTrace::Span span("Initialize video backend");
+    VideoBackendBase::PopulateBackendInfo();
+
+    if (!g_video_backend->Initialize(wsi))
+    {
+      PanicAlertFmt("Failed to initialize video backend!");
+      return;
+    }
   }
   Common::ScopeGuard video_guard{[] { g_video_backend->Shutdown(); }};
 
@@ -577,15 +726,21 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   else
     SConfig::GetInstance().bDSPThread = cpu_info.num_cores > 2;
 
-  if (!DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread))
   {
-    PanicAlertFmt("Failed to initialize DSP emulation!");
-    return;
+    StartupTrace::Span span("Initialize DSP");
+    if (!DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread))
+    {
+      PanicAlertFmt("Failed to initialize DSP emulation!");
+      return;
+    }
   }
 
   // Inputs loading may have generated custom dynamic textures
   // it's now ok to initialize any custom textures
-  HiresTexture::Update();
+  {
+    StartupTrace::Span span("Load custom textures");
+    HiresTexture::Update();
+  }
 
   AudioCommon::PostInitSoundStream();
 
@@ -606,17 +761,25 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   else
     cpuThreadFunc = CpuThread;
 
-  if (!CBoot::BootUp(std::move(boot)))
-    return;
+  {
+    StartupTrace::Span span("Boot");
+    if (!CBoot::BootUp(std::move(boot)))
+      return;
+  }
 
   // Initialise Wii filesystem contents.
   // This is done here after Boot and not in BootManager to ensure that we operate
   // with the correct title context since save copying requires title directories to exist.
   Common::ScopeGuard wiifs_guard{&Core::CleanUpWiiFileSystemContents};
   if (SConfig::GetInstance().bWii)
+  {
+    StartupTrace::Span span("Initialize Wii filesystem contents");
     Core::InitializeWiiFileSystemContents();
+  }
   else
+  {
     wiifs_guard.Dismiss();
+  }
 
   // This adds the SyncGPU handler to CoreTiming, so now CoreTiming::Advance might block.
   Fifo::Prepare();
@@ -632,12 +795,19 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     PowerPC::SetMode(PowerPC::CoreMode::Interpreter);
   }
 
+#ifdef USE_FRAMESTATS_SOCKET
+  if (Config::Get(Config::MAIN_MEMORYWATCHER_FRAME_STATS))
+    s_frame_stats_socket = std::make_unique<FrameStatsSocket>();
+  Common::ScopeGuard frame_stats_guard{[] { s_frame_stats_socket.reset(); }};
+#endif
+
   // ENTER THE VIDEO THREAD LOOP
   if (core_parameter.bCPUThread)
   {
     // This thread, after creating the EmuWindow, spawns a CPU
     // thread, and then takes over and becomes the video thread
     Common::SetCurrentThreadName("Video thread");
+    Common::ApplyThreadRole(Common::ThreadRole::GPU);
     UndeclareAsCPUThread();
     FPURoundMode::LoadDefaultSIMDState();
 
@@ -898,6 +1068,12 @@ void Callback_FramePresented(double actual_emulation_speed)
 
   s_drawn_frame++;
   s_stop_frame_step.store(true);
+  StartupTrace::OnFramePresented();
+
+#ifdef USE_FRAMESTATS_SOCKET
+  if (s_frame_stats_socket)
+    s_frame_stats_socket->OnFramePresented(actual_emulation_speed);
+#endif
 }
 
 // Called from VideoInterface::Update (CPU thread) at emulated field boundaries
@@ -1046,6 +1222,11 @@ void CallOnStateChangedCallbacks(Core::State state)
   }
 }
 
+void SetOnFrameEndCallback(FrameEndCallbackFunc callback)
+{
+  s_on_frame_end_callback = std::move(callback);
+}
+
 void UpdateWantDeterminism(bool initial)
 {
   // For now, this value is not itself configurable.  Instead, individual
@@ -1128,6 +1309,28 @@ void DoFrameStep()
   }
 }
 
+bool StepFrames(u32 frames, bool wait)
+{
+  if (frames == 0 || !IsRunningAndStarted())
+    return false;
+
+  s_frame_steps_done.Reset();
+  s_frames_to_step = frames;
+  if (GetState() == State::Paused)
+    SetState(State::Running);
+
+  if (wait && !IsCPUThread())
+  {
+    while (!s_frame_steps_done.WaitFor(std::chrono::milliseconds(10)))
+    {
+      if (!IsRunningAndStarted())
+        return false;
+    }
+  }
+
+  return true;
+}
+
 void UpdateInputGate(bool require_focus, bool require_full_focus)
 {
   // If the user accepts background input, controls should pass even if an on screen interface is on
@@ -121,6 +121,8 @@ void DisplayMessage(std::string message, int time_in_ms);
 
 void FrameUpdateOnCPUThread();
 void OnFrameEnd();
+// Called on the CPU thread right after the emulated controllers have been polled.
+void OnInputPoll();
 
 void VideoThrottle();
 void RequestRefreshInfo();
@@ -148,6 +150,11 @@ int AddOnStateChangedCallback(StateChangedCallbackFunc callback);
 bool RemoveOnStateChangedCallback(int* handle);
 void CallOnStateChangedCallbacks(Core::State state);
 
+// Called on the CPU thread at the end of every emulated frame. Pass an empty function to clear it.
+// Must only be changed while the core is not running.
+using FrameEndCallbackFunc = std::function<void()>;
+void SetOnFrameEndCallback(FrameEndCallbackFunc callback);
+
 // Run on the Host thread when the factors change. [NOT THREADSAFE]
 void UpdateWantDeterminism(bool initial = false);
 
@@ -168,6 +175,12 @@ void HostDispatchJobs();
 
 void DoFrameStep();
 
+// Runs the emulation for the given number of frames, then pauses. Unlike DoFrameStep, frames are
+// counted on the CPU thread at the end of each VI field without waiting for the GPU, and the
+// throttler is skipped while stepping. If wait is set, blocks until the step has completed; this
+// must not be done from the CPU thread or from a thread the UI depends on.
+bool StepFrames(u32 frames, bool wait);
+
 void UpdateInputGate(bool require_focus, bool require_full_focus = false);
 
 }  // namespace Core
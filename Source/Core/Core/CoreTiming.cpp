@@ -15,7 +15,9 @@
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Tracing.h"
 
+#include "Core/CPUTimeBreakdown.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -29,6 +31,10 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  // Number of events of this type in s_event_queue, so RemoveEvent can skip searching the queue
+  // for the common case of a type that has nothing scheduled.
+  u32 pending;
+  CPUTimeBreakdown::Counter* time_counter;
 };
 
 struct Event
@@ -40,10 +46,6 @@ struct Event
 };
 
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
@@ -54,10 +56,10 @@ static bool operator<(const Event& left, const Event& right)
 static std::unordered_map<std::string, EventType> s_event_types;
 
 // STATE_TO_SAVE
-// The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-// We don't use std::priority_queue because we need to be able to serialize, unserialize and
-// erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-// by the standard adaptor class.
+// The queue is a 4-ary min-heap. It's shallower than a binary heap, so scheduling takes fewer
+// swaps, and the children of a node are adjacent in memory. We don't use std::priority_queue
+// because we need to be able to serialize, unserialize and erase arbitrary events (RemoveEvent())
+// regardless of the queue order.
 static std::vector<Event> s_event_queue;
 static u64 s_event_fifo_id;
 static std::mutex s_ts_write_lock;
@@ -77,6 +79,93 @@ Globals g;
 
 static EventType* s_ev_lost = nullptr;
 
+constexpr size_t EVENT_QUEUE_ARITY = 4;
+// Enough for every event the emulated hardware keeps scheduled at once, so the queue never has to
+// grow while running
+constexpr size_t EVENT_QUEUE_INITIAL_CAPACITY = 64;
+
+static void SiftUp(size_t index)
+{
+  Event event = std::move(s_event_queue[index]);
+  while (index > 0)
+  {
+    const size_t parent = (index - 1) / EVENT_QUEUE_ARITY;
+    if (!(event < s_event_queue[parent]))
+      break;
+    s_event_queue[index] = std::move(s_event_queue[parent]);
+    index = parent;
+  }
+  s_event_queue[index] = std::move(event);
+}
+
+static void SiftDown(size_t index)
+{
+  const size_t size = s_event_queue.size();
+  Event event = std::move(s_event_queue[index]);
+  while (true)
+  {
+    const size_t first_child = index * EVENT_QUEUE_ARITY + 1;
+    if (first_child >= size)
+      break;
+
+    const size_t last_child = std::min(first_child + EVENT_QUEUE_ARITY, size);
+    size_t smallest = first_child;
+    for (size_t child = first_child + 1; child < last_child; ++child)
+    {
+      if (s_event_queue[child] < s_event_queue[smallest])
+        smallest = child;
+    }
+
+    if (!(s_event_queue[smallest] < event))
+      break;
+    s_event_queue[index] = std::move(s_event_queue[smallest]);
+    index = smallest;
+  }
+  s_event_queue[index] = std::move(event);
+}
+
+static void PushEvent(Event event)
+{
+  event.type->pending++;
+  s_event_queue.emplace_back(std::move(event));
+  SiftUp(s_event_queue.size() - 1);
+}
+
+// Removes the event at the given position of the heap and restores the heap invariant
+static void EraseEventAt(size_t index)
+{
+  s_event_queue[index].type->pending--;
+  const size_t last = s_event_queue.size() - 1;
+  if (index != last)
+  {
+    const bool moves_up = s_event_queue[last] < s_event_queue[index];
+    s_event_queue[index] = std::move(s_event_queue[last]);
+    s_event_queue.pop_back();
+    if (moves_up)
+      SiftUp(index);
+    else
+      SiftDown(index);
+  }
+  else
+  {
+    s_event_queue.pop_back();
+  }
+}
+
+static void RebuildEventQueue()
+{
+  for (auto& [name, event_type] : s_event_types)
+    event_type.pending = 0;
+  for (const Event& event : s_event_queue)
+    event.type->pending++;
+
+  for (size_t i = s_event_queue.size() / EVENT_QUEUE_ARITY + 1; i-- > 0;)
+  {
+    if (i < s_event_queue.size())
+      SiftDown(i);
+  }
+}
+
 static void EmptyTimedCallback(u64 userdata, s64 cyclesLate)
 {
 }
@@ -107,9 +196,11 @@ EventType* RegisterEvent(const std::string& name, TimedCallback callback)
              "during Init to avoid breaking save states.",
              name.c_str());
 
-  auto info = s_event_types.emplace(name, EventType{callback, nullptr});
+  auto info = s_event_types.emplace(name, EventType{callback, nullptr, 0, nullptr});
   EventType* event_type = &info.first->second;
   event_type->name = &info.first->first;
+  event_type->time_counter =
+      CPUTimeBreakdown::GetCounter(CPUTimeBreakdown::Category::CoreTiming, name);
   return event_type;
 }
 
@@ -135,6 +226,7 @@ void Init()
   s_is_global_timer_sane = true;
 
   s_event_fifo_id = 0;
+  s_event_queue.reserve(EVENT_QUEUE_INITIAL_CAPACITY);
   s_ev_lost = RegisterEvent("_lost_event", &EmptyTimedCallback);
 }
 
@@ -200,7 +292,7 @@ void DoState(PointerWrap& p)
   // The exact layout of the heap in memory is implementation defined, therefore it is platform
   // and library version specific.
   if (p.GetMode() == PointerWrap::MODE_READ)
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    RebuildEventQueue();
 }
 
 // This should only be called from the CPU thread. If you are calling
@@ -223,6 +315,8 @@ u64 GetIdleTicks()
 
 void ClearPendingEvents()
 {
+  for (const Event& event : s_event_queue)
+    event.type->pending = 0;
   s_event_queue.clear();
 }
 
@@ -251,8 +345,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!s_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    PushEvent(Event{timeout, s_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -271,14 +364,14 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
 
 void RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(s_event_queue.begin(), s_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != s_event_queue.end())
+  // Most callers remove an event type before rescheduling it, which usually has nothing pending
+  // because the previous event has already fired.
+  for (size_t i = s_event_queue.size(); event_type->pending != 0 && i-- > 0;)
   {
-    s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    // Erasing can move an event that hasn't been visited yet into position i but never past it,
+    // so walking backwards visits every event as long as position i is checked again.
+    while (i < s_event_queue.size() && s_event_queue[i].type == event_type)
+      EraseEventAt(i);
   }
 }
 
@@ -305,13 +398,14 @@ void MoveEvents()
   for (Event ev; s_ts_queue.Pop(ev);)
   {
     ev.fifo_order = s_event_fifo_id++;
-    s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    PushEvent(std::move(ev));
   }
 }
 
 void Advance()
 {
+  TRACE_SCOPE("CoreTiming::Advance");
+
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
@@ -324,9 +418,9 @@ void Advance()
 
   while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
   {
-    Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-    s_event_queue.pop_back();
+    Event evt = s_event_queue.front();
+    EraseEventAt(0);
+    CPUTimeBreakdown::Scope time_scope(evt.type->time_counter);
     evt.type->callback(evt.userdata, g.global_timer - evt.time);
   }
 
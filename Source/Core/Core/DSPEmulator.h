@@ -30,6 +30,10 @@ public:
   virtual void DSP_StopSoundStream() = 0;
   virtual u32 DSP_UpdateRate() = 0;
 
+  // Waits for work the emulator runs on another thread and whose results the CPU is about to be
+  // able to observe.
+  virtual void FinishPendingWork() {}
+
 protected:
   bool m_wii = false;
 };
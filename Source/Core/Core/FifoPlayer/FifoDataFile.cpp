@@ -7,9 +7,15 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <xxhash.h>
+#include <zstd.h>
+
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
@@ -24,6 +30,11 @@ enum
   MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5,
 };
 
+// Number of decoded frames that are kept in memory
+constexpr size_t FRAME_CACHE_SIZE = 4;
+// Recorded frames are compressed while recording continues, so this favours speed
+constexpr int FRAME_COMPRESSION_LEVEL = 1;
+
 #pragma pack(push, 1)
 
 struct FileHeader
@@ -79,7 +90,11 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 FifoDataFile::FifoDataFile() = default;
 
-FifoDataFile::~FifoDataFile() = default;
+FifoDataFile::~FifoDataFile()
+{
+  // Frames that are about to be destroyed don't need to be compressed anymore
+  m_compression_thread.Cancel();
+}
 
 bool FifoDataFile::ShouldGenerateFakeVIUpdates() const
 {
@@ -101,9 +116,152 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+void FifoDataFile::AddFrame(FifoFrameInfo frameInfo)
+{
+  if (!m_compression_thread.IsRunning())
+    m_compression_thread.Reset([this](u32 frame) { CompressRecordedFrame(frame); });
+
+  u32 frame;
+  {
+    std::lock_guard lk(m_frames_mutex);
+
+    m_recorded_fifo_bytes += frameInfo.fifoData.size();
+    for (const MemoryUpdate& update : frameInfo.memoryUpdates)
+      m_recorded_memory_bytes += update.data.size();
+
+    frame = static_cast<u32>(m_Frames.size());
+    m_Frames.push_back({std::make_shared<const FifoFrameInfo>(std::move(frameInfo)), {}});
+  }
+
+  m_compression_thread.EmplaceItem(frame);
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  std::lock_guard lk(m_frames_mutex);
+
+  if (!m_mapped_file.IsOpen() && m_Frames[frame].frame)
+    return m_Frames[frame].frame;
+
+  const auto it = std::find_if(m_frame_cache.begin(), m_frame_cache.end(),
+                               [frame](const auto& entry) { return entry.first == frame; });
+  if (it != m_frame_cache.end())
+    return it->second;
+
+  if (m_frame_cache.size() >= FRAME_CACHE_SIZE)
+    m_frame_cache.pop_front();
+  m_frame_cache.emplace_back(frame, m_mapped_file.IsOpen() ?
+                                        DecodeFrame(m_frame_table[frame]) :
+                                        DecompressFrame(m_Frames[frame].compressed));
+  return m_frame_cache.back().second;
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  if (m_mapped_file.IsOpen())
+    return static_cast<u32>(m_frame_table.size());
+
+  std::lock_guard lk(m_frames_mutex);
+  return static_cast<u32>(m_Frames.size());
+}
+
+u64 FifoDataFile::GetRecordedFifoBytes() const
+{
+  std::lock_guard lk(m_frames_mutex);
+  return m_recorded_fifo_bytes;
+}
+
+u64 FifoDataFile::GetRecordedMemoryBytes() const
+{
+  std::lock_guard lk(m_frames_mutex);
+  return m_recorded_memory_bytes;
+}
+
+// Layout of a recorded frame before compression: fifoStart, fifoEnd, the size of the FIFO data,
+// the FIFO data, the number of memory updates, then each update's fifoPosition, address, type and
+// size followed by its data. All values are native-endian u32s.
+template <typename T>
+static void AppendValue(std::vector<u8>& buffer, const T& value)
+{
+  const size_t offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+static void AppendBytes(std::vector<u8>& buffer, const std::vector<u8>& bytes)
+{
+  AppendValue(buffer, static_cast<u32>(bytes.size()));
+  buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+}
+
+void FifoDataFile::CompressRecordedFrame(u32 frame)
+{
+  std::shared_ptr<const FifoFrameInfo> frameInfo;
+  {
+    std::lock_guard lk(m_frames_mutex);
+    frameInfo = m_Frames[frame].frame;
+  }
+
+  std::vector<u8> buffer;
+  AppendValue(buffer, frameInfo->fifoStart);
+  AppendValue(buffer, frameInfo->fifoEnd);
+  AppendBytes(buffer, frameInfo->fifoData);
+  AppendValue(buffer, static_cast<u32>(frameInfo->memoryUpdates.size()));
+  for (const MemoryUpdate& update : frameInfo->memoryUpdates)
+  {
+    AppendValue(buffer, update.fifoPosition);
+    AppendValue(buffer, update.address);
+    AppendValue(buffer, static_cast<u32>(update.type));
+    AppendBytes(buffer, update.data);
+  }
+
+  std::vector<u8> compressed(ZSTD_compressBound(buffer.size()));
+  const size_t result = ZSTD_compress(compressed.data(), compressed.size(), buffer.data(),
+                                      buffer.size(), FRAME_COMPRESSION_LEVEL);
+  // The frame simply stays uncompressed if this fails
+  if (ZSTD_isError(result))
+    return;
+  compressed.resize(result);
+  compressed.shrink_to_fit();
+
+  std::lock_guard lk(m_frames_mutex);
+  m_Frames[frame].compressed = std::move(compressed);
+  m_Frames[frame].frame.reset();
+}
+
+std::shared_ptr<const FifoFrameInfo>
+FifoDataFile::DecompressFrame(const std::vector<u8>& compressed)
 {
-  m_Frames.push_back(frameInfo);
+  std::vector<u8> buffer(ZSTD_getFrameContentSize(compressed.data(), compressed.size()));
+  ZSTD_decompress(buffer.data(), buffer.size(), compressed.data(), compressed.size());
+
+  const u8* ptr = buffer.data();
+  const auto read_u32 = [&ptr] {
+    u32 value;
+    std::memcpy(&value, ptr, sizeof(u32));
+    ptr += sizeof(u32);
+    return value;
+  };
+  const auto read_bytes = [&ptr, &read_u32](std::vector<u8>& bytes) {
+    const u32 size = read_u32();
+    bytes.assign(ptr, ptr + size);
+    ptr += size;
+  };
+
+  auto frameInfo = std::make_shared<FifoFrameInfo>();
+  frameInfo->fifoStart = read_u32();
+  frameInfo->fifoEnd = read_u32();
+  read_bytes(frameInfo->fifoData);
+  frameInfo->memoryUpdates.resize(read_u32());
+  for (MemoryUpdate& update : frameInfo->memoryUpdates)
+  {
+    update.fifoPosition = read_u32();
+    update.address = read_u32();
+    update.type = static_cast<MemoryUpdate::Type>(read_u32());
+    read_bytes(update.data);
+  }
+
+  return frameInfo;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -115,9 +273,11 @@ bool FifoDataFile::Save(const std::string& filename)
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
+  const u32 frameCount = GetFrameCount();
+
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(frameCount * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem, BP_MEM_SIZE);
@@ -160,7 +320,7 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frameCount;
 
   header.flags = m_Flags;
 
@@ -170,17 +330,21 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, SEEK_SET);
   file.WriteBytes(&header, sizeof(FileHeader));
 
+  // Memory updates that repeat data which was already written point to the earlier copy
+  std::unordered_map<u64, u64> writtenData;
+
   // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
+  for (u32 i = 0; i < frameCount; ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
+    const std::shared_ptr<const FifoFrameInfo> frameData = GetFrame(i);
+    const FifoFrameInfo& srcFrame = *frameData;
 
     // Write FIFO data
     file.Seek(0, SEEK_END);
     u64 dataOffset = file.Tell();
     file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, writtenData, file);
 
     FileFrameInfo dstFrame;
     dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
@@ -315,30 +479,24 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
-  {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, SEEK_SET);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
-      return panic_failed_to_read();
-
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-
-    file.Seek(srcFrame.fifoDataOffset, SEEK_SET);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
+  // Only the frame list is read here. The frames themselves are decoded from the mapped file when
+  // they are needed, so long recordings don't have to fit in memory.
+  dataFile->m_frame_table.resize(header.frameCount);
+  file.Seek(header.frameListOffset, SEEK_SET);
+  if (!file.ReadArray(dataFile->m_frame_table.data(), header.frameCount))
+    return panic_failed_to_read();
 
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+  if (!dataFile->m_mapped_file.Open(filename))
+    return panic_failed_to_read();
 
-    if (!file.IsGood())
+  for (const FileFrameInfo& srcFrame : dataFile->m_frame_table)
+  {
+    if (!dataFile->IsInMappedFile(srcFrame.fifoDataOffset, srcFrame.fifoDataSize) ||
+        !dataFile->IsInMappedFile(srcFrame.memoryUpdatesOffset,
+                                  u64{srcFrame.numMemoryUpdates} * sizeof(FileMemoryUpdate)))
+    {
       return panic_failed_to_read();
-
-    dataFile->AddFrame(dstFrame);
+    }
   }
 
   return dataFile;
@@ -364,6 +522,7 @@ bool FifoDataFile::GetFlag(u32 flag) const
 }
 
 u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
+                                     std::unordered_map<u64, u64>& writtenData,
                                      File::IOFile& file)
 {
   // Add space for memory update list
@@ -374,10 +533,17 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   {
     const MemoryUpdate& srcUpdate = memUpdates[i];
 
-    // Write memory
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+    // Write memory, unless the same data is already in the file. The size is the seed, so data
+    // of different sizes can't share a hash.
+    const u64 hash = XXH64(srcUpdate.data.data(), srcUpdate.data.size(), srcUpdate.data.size());
+    const auto [it, inserted] = writtenData.try_emplace(hash, 0);
+    if (inserted)
+    {
+      file.Seek(0, SEEK_END);
+      it->second = file.Tell();
+      file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+    }
+    const u64 dataOffset = it->second;
 
     FileMemoryUpdate dstUpdate;
     dstUpdate.address = srcUpdate.address;
@@ -394,25 +560,45 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   return updateListOffset;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+bool FifoDataFile::IsInMappedFile(u64 offset, u64 size) const
 {
-  memUpdates.resize(numUpdates);
+  const u64 file_size = m_mapped_file.GetSize();
+  return offset <= file_size && size <= file_size - offset;
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::DecodeFrame(const FileFrameInfo& srcFrame) const
+{
+  const u8* const data = m_mapped_file.GetData();
+
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
 
-  for (u32 i = 0; i < numUpdates; ++i)
+  const u8* const fifoData = data + srcFrame.fifoDataOffset;
+  dstFrame->fifoData.assign(fifoData, fifoData + srcFrame.fifoDataSize);
+
+  dstFrame->memoryUpdates.resize(srcFrame.numMemoryUpdates);
+  for (u32 i = 0; i < srcFrame.numMemoryUpdates; ++i)
   {
-    u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, SEEK_SET);
     FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    std::memcpy(&srcUpdate, data + srcFrame.memoryUpdatesOffset + i * sizeof(FileMemoryUpdate),
+                sizeof(FileMemoryUpdate));
 
-    MemoryUpdate& dstUpdate = memUpdates[i];
+    MemoryUpdate& dstUpdate = dstFrame->memoryUpdates[i];
     dstUpdate.address = srcUpdate.address;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    file.Seek(srcUpdate.dataOffset, SEEK_SET);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    if (!IsInMappedFile(srcUpdate.dataOffset, srcUpdate.dataSize))
+    {
+      ERROR_LOG_FMT(VIDEO, "DFF memory update at {:08x} is outside of the file",
+                    srcUpdate.address);
+      continue;
+    }
+
+    const u8* const updateData = data + srcUpdate.dataOffset;
+    dstUpdate.data.assign(updateData, updateData + srcUpdate.dataSize);
   }
+
+  return dstFrame;
 }
@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace File
@@ -42,6 +48,8 @@ struct FifoFrameInfo
   std::vector<MemoryUpdate> memoryUpdates;
 };
 
+struct FileFrameInfo;
+
 class FifoDataFile
 {
 public:
@@ -71,9 +79,16 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
-  void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Recorded frames are compressed in memory on a background thread.
+  void AddFrame(FifoFrameInfo frameInfo);
+  // The frames of a loaded file stay in the memory mapped file, and recorded frames stay
+  // compressed. Both are only decoded when they are requested. A few of the most recently used
+  // ones are kept around.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // Uncompressed sizes of the frames added with AddFrame
+  u64 GetRecordedFifoBytes() const;
+  u64 GetRecordedMemoryBytes() const;
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -89,9 +104,14 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
+                         std::unordered_map<u64, u64>& writtenData, File::IOFile& file);
+
+  bool IsInMappedFile(u64 offset, u64 size) const;
+  std::shared_ptr<const FifoFrameInfo> DecodeFrame(const FileFrameInfo& srcFrame) const;
+
+  void CompressRecordedFrame(u32 frame);
+  static std::shared_ptr<const FifoFrameInfo> DecompressFrame(const std::vector<u8>& compressed);
 
   u32 m_BPMem[BP_MEM_SIZE];
   u32 m_CPMem[CP_MEM_SIZE];
@@ -104,5 +124,26 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  struct RecordedFrame
+  {
+    // Only set until the frame has been compressed
+    std::shared_ptr<const FifoFrameInfo> frame;
+    std::vector<u8> compressed;
+  };
+
+  mutable std::mutex m_frames_mutex;
+
+  // Frames of a file that is being recorded
+  std::vector<RecordedFrame> m_Frames;
+  u64 m_recorded_fifo_bytes = 0;
+  u64 m_recorded_memory_bytes = 0;
+
+  // Frames of a loaded file
+  File::MappedFile m_mapped_file;
+  std::vector<FileFrameInfo> m_frame_table;
+
+  mutable std::deque<std::pair<u32, std::shared_ptr<const FifoFrameInfo>>> m_frame_cache;
+
+  // Declared last so that it finishes its queue before the frames are destroyed
+  Common::WorkQueueThread<u32> m_compression_thread;
 };
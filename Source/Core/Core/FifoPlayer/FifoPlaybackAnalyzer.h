@@ -16,7 +16,6 @@ struct AnalyzedFrameInfo
   std::vector<FifoAnalyzer::CPMemory> objectCPStates;
   // End of the primitives for the object
   std::vector<u32> objectEnds;
-  std::vector<MemoryUpdate> memoryUpdates;
 };
 
 namespace FifoPlaybackAnalyzer
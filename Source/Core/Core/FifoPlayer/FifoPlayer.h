@@ -93,6 +93,9 @@ public:
   // If enabled then all memory updates happen at once before the first frame
   // Default is disabled
   void SetEarlyMemoryUpdates(bool enabled) { m_EarlyMemoryUpdates = enabled; }
+  // Plays the frame range this many times before stopping, whether looping is enabled or not.
+  // 0 leaves it to the looping setting.
+  void SetLoopLimit(u32 loops) { m_LoopLimit = loops; }
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback);
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = std::move(callback); }
@@ -141,6 +144,8 @@ private:
   static bool IsHighWatermarkSet();
 
   bool m_Loop;
+  u32 m_LoopLimit = 0;
+  u32 m_LoopsPlayed = 0;
 
   u32 m_CurrentFrame = 0;
   u32 m_FrameRangeStart = 0;
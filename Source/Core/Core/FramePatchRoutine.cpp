@@ -0,0 +1,325 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/FramePatchRoutine.h"
+
+#include <cstring>
+
+#include "Common/Swap.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace PatchEngine
+{
+void FramePatchRoutine::Clear()
+{
+  m_ops.clear();
+  m_resolved_generation.reset();
+}
+
+bool FramePatchRoutine::IsEmpty() const
+{
+  return m_ops.empty();
+}
+
+void FramePatchRoutine::Append(const FramePatchRoutine& other)
+{
+  m_ops.insert(m_ops.end(), other.m_ops.begin(), other.m_ops.end());
+  m_resolved_generation.reset();
+}
+
+void FramePatchRoutine::AddWrite(u32 address, bool pointer_relative, u32 size, u32 value,
+                                 u32 count)
+{
+  Op op{OpType::Write};
+  op.pointer_relative = pointer_relative;
+  op.size = static_cast<u8>(size);
+  op.address = address;
+  op.value = value;
+  op.count = count;
+  m_ops.push_back(op);
+  m_resolved_generation.reset();
+}
+
+void FramePatchRoutine::AddIf(Condition condition, u32 address, bool pointer_relative, u32 size,
+                              u32 value, u32 mask)
+{
+  Op op{OpType::If};
+  op.condition = condition;
+  op.pointer_relative = pointer_relative;
+  op.size = static_cast<u8>(size);
+  op.address = address;
+  op.value = value;
+  op.mask = mask;
+  m_ops.push_back(op);
+  m_resolved_generation.reset();
+}
+
+void FramePatchRoutine::AddEndIf(u32 count, std::optional<u32> new_pointer)
+{
+  Op op{OpType::EndIf};
+  op.count = count;
+  op.set_pointer = new_pointer.has_value();
+  op.value = new_pointer.value_or(0);
+  m_ops.push_back(op);
+}
+
+void FramePatchRoutine::AddEndAll(std::optional<u32> new_pointer)
+{
+  Op op{OpType::EndAll};
+  op.set_pointer = new_pointer.has_value();
+  op.value = new_pointer.value_or(0);
+  m_ops.push_back(op);
+}
+
+void FramePatchRoutine::AddLoadPointer(u32 address, bool pointer_relative)
+{
+  Op op{OpType::LoadPointer};
+  op.pointer_relative = pointer_relative;
+  op.size = 4;
+  op.address = address;
+  m_ops.push_back(op);
+  m_resolved_generation.reset();
+}
+
+void FramePatchRoutine::AddSetPointer(u32 value)
+{
+  Op op{OpType::SetPointer};
+  op.value = value;
+  m_ops.push_back(op);
+}
+
+void FramePatchRoutine::Resolve()
+{
+  for (Op& op : m_ops)
+  {
+    op.host_pointer = nullptr;
+    if (op.pointer_relative || op.size == 0)
+      continue;
+
+    const size_t length = size_t{op.size} * op.count;
+    size_t direct_length = length;
+    u8* pointer = PowerPC::HostGetDirectPointer(op.address, &direct_length);
+    if (pointer && direct_length == length)
+      op.host_pointer = pointer;
+  }
+  m_resolved_generation = PowerPC::GetDBATGeneration();
+}
+
+u8* FramePatchRoutine::GetHostPointer(const Op& op, u32 pointer, u32 length) const
+{
+  if (!op.pointer_relative)
+    return op.host_pointer;
+
+  size_t direct_length = length;
+  u8* host_pointer = PowerPC::HostGetDirectPointer(pointer + op.address, &direct_length);
+  return direct_length == length ? host_pointer : nullptr;
+}
+
+static u32 LoadBigEndian(const u8* src, u32 size)
+{
+  switch (size)
+  {
+  case 1:
+    return *src;
+  case 2:
+  {
+    u16 value;
+    std::memcpy(&value, src, sizeof(value));
+    return Common::swap16(value);
+  }
+  default:
+  {
+    u32 value;
+    std::memcpy(&value, src, sizeof(value));
+    return Common::swap32(value);
+  }
+  }
+}
+
+static void StoreBigEndian(u8* dest, u32 size, u32 value)
+{
+  switch (size)
+  {
+  case 1:
+    *dest = static_cast<u8>(value);
+    break;
+  case 2:
+  {
+    const u16 swapped = Common::swap16(static_cast<u16>(value));
+    std::memcpy(dest, &swapped, sizeof(swapped));
+    break;
+  }
+  default:
+  {
+    const u32 swapped = Common::swap32(value);
+    std::memcpy(dest, &swapped, sizeof(swapped));
+    break;
+  }
+  }
+}
+
+// Fallback for memory that can't be accessed directly, e.g. while memory checks are set
+static std::optional<u32> HostTryRead(u32 address, u32 size)
+{
+  switch (size)
+  {
+  case 1:
+    if (const auto result = PowerPC::HostTryReadU8(address))
+      return result.value;
+    return std::nullopt;
+  case 2:
+    if (const auto result = PowerPC::HostTryReadU16(address))
+      return result.value;
+    return std::nullopt;
+  default:
+    if (const auto result = PowerPC::HostTryReadU32(address))
+      return result.value;
+    return std::nullopt;
+  }
+}
+
+static bool HostTryWrite(u32 address, u32 size, u32 value)
+{
+  switch (size)
+  {
+  case 1:
+    return static_cast<bool>(PowerPC::HostTryWriteU8(value, address));
+  case 2:
+    return static_cast<bool>(PowerPC::HostTryWriteU16(value, address));
+  default:
+    return static_cast<bool>(PowerPC::HostTryWriteU32(value, address));
+  }
+}
+
+std::optional<u32> FramePatchRoutine::Read(const Op& op, u32 pointer) const
+{
+  if (const u8* host_pointer = GetHostPointer(op, pointer, op.size))
+    return LoadBigEndian(host_pointer, op.size);
+
+  const u32 address = op.pointer_relative ? pointer + op.address : op.address;
+  return HostTryRead(address, op.size);
+}
+
+void FramePatchRoutine::Write(const Op& op, u32 pointer) const
+{
+  const u32 address = op.pointer_relative ? pointer + op.address : op.address;
+  const u32 length = u32{op.size} * op.count;
+
+  // Patches usually rewrite the same values every frame, so only changed memory is written
+  bool changed = false;
+  if (u8* host_pointer = GetHostPointer(op, pointer, length))
+  {
+    for (u32 i = 0; i < op.count; ++i)
+    {
+      u8* dest = host_pointer + i * op.size;
+      if (LoadBigEndian(dest, op.size) != op.value)
+      {
+        StoreBigEndian(dest, op.size, op.value);
+        changed = true;
+      }
+    }
+  }
+  else
+  {
+    for (u32 i = 0; i < op.count; ++i)
+    {
+      const u32 element_address = address + i * op.size;
+      if (HostTryRead(element_address, op.size) != op.value &&
+          HostTryWrite(element_address, op.size, op.value))
+      {
+        changed = true;
+      }
+    }
+  }
+
+  // Patches often replace instructions, which must not stay stale in the JIT and the icache
+  if (changed)
+  {
+    const u32 last_line = (address + length - 1) & ~31u;
+    for (u32 line = address & ~31u;; line += 32)
+    {
+      PowerPC::ppcState.iCache.Invalidate(line);
+      if (line == last_line)
+        break;
+    }
+    JitInterface::InvalidateICache(address, length, true);
+  }
+}
+
+static bool MeetsCondition(FramePatchRoutine::Condition condition, u32 value, u32 comparand)
+{
+  switch (condition)
+  {
+  case FramePatchRoutine::Condition::Equal:
+    return value == comparand;
+  case FramePatchRoutine::Condition::NotEqual:
+    return value != comparand;
+  case FramePatchRoutine::Condition::Greater:
+    return value > comparand;
+  case FramePatchRoutine::Condition::Less:
+    return value < comparand;
+  }
+  return false;
+}
+
+void FramePatchRoutine::Run()
+{
+  if (m_resolved_generation != PowerPC::GetDBATGeneration())
+    Resolve();
+
+  u32 pointer = DEFAULT_POINTER;
+  // The number of open conditions, and the one which failed first or 0 if all of them are met
+  u32 depth = 0;
+  u32 failed_depth = 0;
+  for (const Op& op : m_ops)
+  {
+    const bool executing = failed_depth == 0;
+    switch (op.type)
+    {
+    case OpType::Write:
+      if (executing)
+        Write(op, pointer);
+      break;
+    case OpType::If:
+    {
+      ++depth;
+      if (!executing)
+        break;
+      const std::optional<u32> value = Read(op, pointer);
+      if (!value || !MeetsCondition(op.condition, *value & ~op.mask, op.value))
+        failed_depth = depth;
+      break;
+    }
+    case OpType::EndIf:
+      for (u32 i = 0; i < op.count && depth > 0; ++i)
+      {
+        if (failed_depth == depth)
+          failed_depth = 0;
+        --depth;
+      }
+      if (op.set_pointer)
+        pointer = op.value;
+      break;
+    case OpType::EndAll:
+      depth = 0;
+      failed_depth = 0;
+      if (op.set_pointer)
+        pointer = op.value;
+      break;
+    case OpType::LoadPointer:
+      if (executing)
+      {
+        if (const std::optional<u32> value = Read(op, pointer))
+          pointer = *value;
+      }
+      break;
+    case OpType::SetPointer:
+      if (executing)
+        pointer = op.value;
+      break;
+    }
+  }
+}
+}  // namespace PatchEngine
@@ -0,0 +1,90 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// A list of memory writes and conditions that is run on the host once per frame. The INI patches
+// and the Gecko codes that don't need the emulated code handler are compiled into one.
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace PatchEngine
+{
+class FramePatchRoutine
+{
+public:
+  enum class Condition : u8
+  {
+    Equal,
+    NotEqual,
+    Greater,
+    Less,
+  };
+
+  // The address of an operation is either an effective address or relative to the pointer, which
+  // starts at DEFAULT_POINTER and can be loaded and set by the routine like the Gecko pointer
+  // offset.
+  static constexpr u32 DEFAULT_POINTER = 0x80000000;
+
+  void Clear();
+  bool IsEmpty() const;
+  void Append(const FramePatchRoutine& other);
+
+  // Writes count consecutive values of size bytes
+  void AddWrite(u32 address, bool pointer_relative, u32 size, u32 value, u32 count = 1);
+  // Skips the following operations up to the matching AddEndIf unless the value at the address,
+  // with the bits of mask cleared, meets the condition. Conditions nest.
+  void AddIf(Condition condition, u32 address, bool pointer_relative, u32 size, u32 value,
+             u32 mask = 0);
+  // Closes count conditions, then sets the pointer if new_pointer is given. Unlike the other
+  // operations this also happens when skipping.
+  void AddEndIf(u32 count, std::optional<u32> new_pointer = std::nullopt);
+  // Closes all conditions, then sets the pointer if new_pointer is given
+  void AddEndAll(std::optional<u32> new_pointer = std::nullopt);
+  // Sets the pointer to the 32-bit value at the address
+  void AddLoadPointer(u32 address, bool pointer_relative);
+  void AddSetPointer(u32 value);
+
+  // Requires MSR.DR, like the emulated code would
+  void Run();
+
+private:
+  enum class OpType : u8
+  {
+    Write,
+    If,
+    EndIf,
+    EndAll,
+    LoadPointer,
+    SetPointer,
+  };
+
+  struct Op
+  {
+    OpType type;
+    Condition condition = Condition::Equal;
+    bool pointer_relative = false;
+    bool set_pointer = false;
+    // In bytes
+    u8 size = 0;
+    u32 address = 0;
+    u32 value = 0;
+    u32 mask = 0;
+    u32 count = 1;
+    // Resolved from an effective address while the DBATs don't change, nullptr if the memory
+    // can't be accessed directly
+    u8* host_pointer = nullptr;
+  };
+
+  void Resolve();
+  u8* GetHostPointer(const Op& op, u32 pointer, u32 length) const;
+  std::optional<u32> Read(const Op& op, u32 pointer) const;
+  void Write(const Op& op, u32 pointer) const;
+
+  std::vector<Op> m_ops;
+  std::optional<u32> m_resolved_generation;
+};
+}  // namespace PatchEngine
@@ -0,0 +1,132 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/FrameStatsSocket.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "AudioCommon/AudioCommon.h"
+#include "AudioCommon/Mixer.h"
+#include "Common/FileUtil.h"
+#include "Common/Timer.h"
+#include "Core/CPUTimeBreakdown.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/HW/VideoInterface.h"
+#include "VideoCommon/Fifo.h"
+#include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/Statistics.h"
+
+FrameStatsSocket::FrameStatsSocket()
+{
+  const std::string path = File::GetUserPath(F_FRAMESTATSSOCKET_IDX);
+  m_addr.sun_family = AF_UNIX;
+  strncpy(m_addr.sun_path, path.c_str(), sizeof(m_addr.sun_path) - 1);
+
+  m_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  m_last_time_us = Common::Timer::GetTimeUs();
+  m_last_cpu_sleep_us = SystemTimers::GetTimeSpentSleepingUs();
+  m_last_gpu_sleep_us = Fifo::GetGpuTimeSleptUs();
+  m_last_jit = JitInterface::GetCompileStats();
+  m_last_input_delay = SerialInterface::GetInputDelayStats();
+}
+
+FrameStatsSocket::~FrameStatsSocket()
+{
+  if (m_fd >= 0)
+    close(m_fd);
+}
+
+// Percentage of the elapsed time that wasn't spent sleeping
+static double GetBusyPercent(u64 slept_us, u64 elapsed_us)
+{
+  return 100.0 * (1.0 - std::min<double>(slept_us, elapsed_us) / elapsed_us);
+}
+
+void FrameStatsSocket::OnFramePresented(double emulation_speed)
+{
+  if (m_fd < 0)
+    return;
+
+  const u64 now_us = Common::Timer::GetTimeUs();
+  const u64 cpu_sleep_us = SystemTimers::GetTimeSpentSleepingUs();
+  const u64 gpu_sleep_us = Fifo::GetGpuTimeSleptUs();
+  const u64 elapsed_us = std::max<u64>(now_us - m_last_time_us, 1);
+
+  const std::string gpu_busy =
+      SConfig::GetInstance().bCPUThread ?
+          fmt::format("{:.1f}", GetBusyPercent(gpu_sleep_us - m_last_gpu_sleep_us, elapsed_us)) :
+          "null";
+
+  double audio_buffer_ms = 0.0;
+  if (g_sound_stream)
+  {
+    const Mixer* mixer = g_sound_stream->GetMixer();
+    audio_buffer_ms = mixer->GetBufferedDMASamples() * 1000.0 / mixer->GetDMAInputSampleRate();
+  }
+
+  const JitInterface::CompileStats jit = JitInterface::GetCompileStats();
+  const u64 jit_calls = jit.calls - m_last_jit.calls;
+  const double jit_compile_us =
+      jit_calls ? static_cast<double>(jit.time_us - m_last_jit.time_us) / jit_calls : 0.0;
+  const double jit_code_used_percent =
+      jit.code_space_size ? 100.0 * jit.code_space_used / jit.code_space_size : 0.0;
+
+  const SerialInterface::InputDelayStats input_delay = SerialInterface::GetInputDelayStats();
+  const u64 input_samples = input_delay.samples - m_last_input_delay.samples;
+  const u64 input_delay_total_us = input_delay.total_us - m_last_input_delay.total_us;
+  const std::string input_delay_us =
+      input_samples ?
+          fmt::format("{:.1f}", static_cast<double>(input_delay_total_us) / input_samples) :
+          "null";
+
+  const Statistics::ThisFrame& frame = g_stats.last_frame;
+  std::string message = fmt::format(
+      "{{\"frame\": {}, \"fps\": {:.2f}, \"vps\": {:.2f}, \"speed\": {:.1f}, \"cpu_busy\": {:.1f}, "
+      "\"gpu_busy\": {}, \"draw_calls\": {}, \"primitives\": {}, \"pending_shader_compiles\": {}, "
+      "\"texture_cache_kb\": {}, \"audio_buffer_ms\": {:.1f}, \"jit_blocks_per_s\": {:.1f}, "
+      "\"jit_compile_us\": {:.1f}, \"jit_code_used_percent\": {:.1f}, "
+      "\"jit_cache_full_clears\": {}, \"jit_blocks_evicted\": {}, \"input_delay_us\": {}",
+      m_frame, 1000000.0 / elapsed_us, emulation_speed * VideoInterface::GetTargetRefreshRate(),
+      emulation_speed * 100.0, GetBusyPercent(cpu_sleep_us - m_last_cpu_sleep_us, elapsed_us),
+      gpu_busy, frame.num_draw_calls, frame.num_prims + frame.num_dl_prims,
+      g_shader_cache ? g_shader_cache->GetPendingAsyncCompileCount() : 0,
+      g_stats.texture_cache_vram_kb, audio_buffer_ms,
+      (jit.blocks_compiled - m_last_jit.blocks_compiled) * 1000000.0 / elapsed_us, jit_compile_us,
+      jit_code_used_percent, jit.cache_full_clears, jit.blocks_evicted, input_delay_us);
+
+  // The CPU thread breakdown is of the last emulated frame, which may lag behind a bit
+  const CPUTimeBreakdown::FrameBreakdown breakdown = CPUTimeBreakdown::GetLastFrame();
+  if (breakdown.frame_ms > 0.0)
+  {
+    message += fmt::format(", \"cpu_breakdown\": {{\"frame\": {}, \"frame_ms\": {:.3f}, "
+                           "\"emulated_code_ms\": {:.3f}, \"entries\": [",
+                           breakdown.frame, breakdown.frame_ms, breakdown.emulated_code_ms);
+    for (size_t i = 0; i < breakdown.entries.size(); i++)
+    {
+      const CPUTimeBreakdown::FrameEntry& entry = breakdown.entries[i];
+      message += fmt::format(
+          "{}{{\"category\": \"{}\", \"name\": \"{}\", \"ms\": {:.3f}, \"calls\": {}}}",
+          i ? ", " : "", CPUTimeBreakdown::GetCategoryName(entry.category), entry.name,
+          entry.time_ms, entry.calls);
+    }
+    message += "]}";
+  }
+  message += "}\n";
+
+  // Never block the GPU thread on a slow monitor, the datagram is dropped instead
+  sendto(m_fd, message.data(), message.size(), MSG_DONTWAIT,
+         reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
+
+  m_frame++;
+  m_last_time_us = now_us;
+  m_last_cpu_sleep_us = cpu_sleep_us;
+  m_last_gpu_sleep_us = gpu_sleep_us;
+  m_last_jit = jit;
+  m_last_input_delay = input_delay;
+}
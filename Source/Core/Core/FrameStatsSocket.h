@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/SI/SI.h"
+#include "Core/PowerPC/JitInterface.h"
+
+// FrameStatsSocket sends the statistics of every presented frame to a unix domain datagram socket
+// in the MemoryWatcher directory, so that the instances of a fleet can be monitored. It is enabled
+// by MemoryWatcher.FrameStats.
+//
+// Like the MemoryWatcher socket, the monitoring program binds the socket and Dolphin only sends to
+// it. Each datagram is a single line JSON object with the frame number, the frame rate, the VI rate
+// and emulation speed in percent, the host time the CPU and GPU threads were busy in percent (the
+// GPU one is null in single core mode), the draw calls and primitives of the frame, the number of
+// pending asynchronous shader compiles, the texture cache size in KiB and the buffered DSP audio
+// in milliseconds. It also has the JIT code cache telemetry: blocks compiled per second, the
+// average time of a compile in microseconds, the code space in use in percent and the totals of
+// full cache clears and evicted blocks, and the average time in microseconds from sampling a
+// controller to the game reading it (null if no sample was read). With Core.CPUTimeBreakdown, it
+// also has the CPU thread time breakdown of the last emulated frame.
+class FrameStatsSocket final
+{
+public:
+  FrameStatsSocket();
+  ~FrameStatsSocket();
+
+  // Called from Renderer::Swap on the GPU thread for every presented frame
+  void OnFramePresented(double emulation_speed);
+
+private:
+  int m_fd = -1;
+  sockaddr_un m_addr{};
+
+  u64 m_frame = 0;
+  u64 m_last_time_us = 0;
+  u64 m_last_cpu_sleep_us = 0;
+  u64 m_last_gpu_sleep_us = 0;
+  JitInterface::CompileStats m_last_jit;
+  SerialInterface::InputDelayStats m_last_input_delay;
+};
@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/FrameStepSocket.h"
+
+#include <cstring>
+#include <string>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/Movie.h"
+
+FrameStepSocket::FrameStepSocket()
+{
+  const std::string path = File::GetUserPath(F_FRAMESTEPSOCKET_IDX);
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+  m_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (m_fd < 0)
+    return;
+
+  // A socket file left behind by a previous run would make bind fail
+  unlink(addr.sun_path);
+  if (bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+  {
+    close(m_fd);
+    m_fd = -1;
+    return;
+  }
+
+  m_running.Set();
+  m_thread = std::thread(&FrameStepSocket::ThreadFunc, this);
+}
+
+FrameStepSocket::~FrameStepSocket()
+{
+  if (m_fd < 0)
+    return;
+
+  m_running.Clear();
+  m_thread.join();
+  close(m_fd);
+  unlink(File::GetUserPath(F_FRAMESTEPSOCKET_IDX).c_str());
+}
+
+void FrameStepSocket::ThreadFunc()
+{
+  Common::SetCurrentThreadName("FrameStepSocket");
+
+  while (m_running.IsSet())
+  {
+    // Wake up regularly to notice shutdown
+    pollfd pfd{m_fd, POLLIN, 0};
+    if (poll(&pfd, 1, 100) <= 0)
+      continue;
+
+    char buffer[32];
+    sockaddr_un sender{};
+    socklen_t sender_length = sizeof(sender);
+    const ssize_t size = recvfrom(m_fd, buffer, sizeof(buffer) - 1, 0,
+                                  reinterpret_cast<sockaddr*>(&sender), &sender_length);
+    if (size < 0)
+      continue;
+    buffer[size] = '\0';
+
+    u32 frames = 1;
+    const std::string request(StripSpaces(buffer));
+    if (!request.empty() && !TryParse(request, &frames))
+      continue;
+
+    if (!Core::StepFrames(frames, true))
+      continue;
+
+    if (sender_length > sizeof(sa_family_t))
+    {
+      const std::string reply = std::to_string(Movie::GetCurrentFrame()) + '\n';
+      sendto(m_fd, reply.c_str(), reply.size(), 0, reinterpret_cast<sockaddr*>(&sender),
+             sender_length);
+    }
+  }
+}
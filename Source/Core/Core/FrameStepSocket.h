@@ -0,0 +1,28 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <thread>
+
+#include "Common/Flag.h"
+
+// FrameStepSocket lets external programs (e.g. bots) advance the emulation frame by frame through
+// a unix domain datagram socket in the MemoryWatcher directory.
+//
+// Each datagram holds a decimal frame count (1 if empty). The emulation runs for that many frames
+// and pauses, after which the current movie frame number is sent back as a decimal line to the
+// sender, provided it bound its socket to an address.
+class FrameStepSocket final
+{
+public:
+  FrameStepSocket();
+  ~FrameStepSocket();
+
+private:
+  void ThreadFunc();
+
+  int m_fd = -1;
+  Common::Flag m_running;
+  std::thread m_thread;
+};
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -15,8 +16,10 @@
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
 
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/FramePatchRoutine.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -63,8 +66,136 @@ static Installation s_code_handler_installed = Installation::Uninstalled;
 // the currently active codes
 static std::vector<GeckoCode> s_active_codes;
 static std::vector<GeckoCode> s_synced_codes;
+// The active codes are split into the ones run natively and the ones left to the code handler
+static PatchEngine::FramePatchRoutine s_native_codes;
+static std::vector<const GeckoCode*> s_handler_codes;
 static std::mutex s_active_codes_lock;
 
+// Translates a code into the routine if it only consists of writes, conditions, pointer loads and
+// terminators that don't change the base address. The codes in the code handler share the base
+// address, the pointer and the conditions, but well formed codes don't depend on the ones before
+// them, so each native code starts with the defaults.
+static bool CompileCode(const GeckoCode& code, PatchEngine::FramePatchRoutine* routine)
+{
+  using Condition = PatchEngine::FramePatchRoutine::Condition;
+  constexpr u32 BASE_ADDRESS = PatchEngine::FramePatchRoutine::DEFAULT_POINTER;
+
+  // Terminators can set the base address and the pointer to XXXX0000 and YYYY0000 with XXXXYYYY.
+  // Only the default base address is supported.
+  const auto keeps_base_address = [](u32 data) {
+    return (data >> 16) == 0 || (data >> 16) == BASE_ADDRESS >> 16;
+  };
+  const auto get_new_pointer = [](u32 data) -> std::optional<u32> {
+    if ((data & 0xFFFF) == 0)
+      return std::nullopt;
+    return (data & 0xFFFF) << 16;
+  };
+
+  PatchEngine::FramePatchRoutine compiled;
+  for (const GeckoCode::Code& line : code.codes)
+  {
+    const u32 code_type = line.address >> 24 & 0xFE;
+    const bool pointer_relative = (code_type & 0x10) != 0;
+    // Offset from the base address or the pointer
+    const u32 offset = line.address & 0x01FFFFFF;
+    const u32 address = pointer_relative ? offset : BASE_ADDRESS + offset;
+
+    switch (code_type & ~0x10)
+    {
+    case 0x00:
+      compiled.AddWrite(address, pointer_relative, 1, line.data & 0xFF, (line.data >> 16) + 1);
+      continue;
+    case 0x02:
+      compiled.AddWrite(address, pointer_relative, 2, line.data & 0xFFFF, (line.data >> 16) + 1);
+      continue;
+    case 0x04:
+      compiled.AddWrite(address, pointer_relative, 4, line.data);
+      continue;
+    case 0x20:
+    case 0x22:
+    case 0x24:
+    case 0x26:
+    case 0x28:
+    case 0x2A:
+    case 0x2C:
+    case 0x2E:
+    {
+      // The lowest address bit applies an endif first
+      if (line.address & 1)
+        compiled.AddEndIf(1);
+      const Condition condition = static_cast<Condition>((code_type & 0x06) >> 1);
+      if ((code_type & 0x08) == 0)
+      {
+        compiled.AddIf(condition, address & ~1u, pointer_relative, 4, line.data);
+      }
+      else
+      {
+        // 16-bit comparisons mask the value with the upper half of the data
+        compiled.AddIf(condition, address & ~1u, pointer_relative, 2, line.data & 0xFFFF,
+                       line.data >> 16);
+      }
+      continue;
+    }
+    default:
+      break;
+    }
+
+    switch (line.address)
+    {
+    case 0x48000000:
+      compiled.AddLoadPointer(line.data, false);
+      continue;
+    case 0x48010000:
+      compiled.AddLoadPointer(BASE_ADDRESS + line.data, false);
+      continue;
+    case 0x48100000:
+      compiled.AddLoadPointer(line.data, true);
+      continue;
+    case 0x4A000000:
+      compiled.AddSetPointer(line.data);
+      continue;
+    case 0x4A010000:
+      compiled.AddSetPointer(BASE_ADDRESS + line.data);
+      continue;
+    case 0xE0000000:
+      if (!keeps_base_address(line.data))
+        return false;
+      compiled.AddEndAll(get_new_pointer(line.data));
+      continue;
+    default:
+      break;
+    }
+
+    // Endif without else, the lowest byte is the number of conditions to close
+    if ((line.address & 0xFFFFFF00) == 0xE2000000 && keeps_base_address(line.data))
+    {
+      compiled.AddEndIf(line.address & 0xFF, get_new_pointer(line.data));
+      continue;
+    }
+
+    return false;
+  }
+
+  compiled.AddEndAll();
+  routine->Append(compiled);
+  return true;
+}
+
+// Requires s_active_codes_lock
+static void CompileActiveCodesLocked()
+{
+  s_native_codes.Clear();
+  s_handler_codes.clear();
+  for (const GeckoCode& code : s_active_codes)
+  {
+    if (!CompileCode(code, &s_native_codes))
+      s_handler_codes.push_back(&code);
+  }
+
+  INFO_LOG_FMT(ACTIONREPLAY, "GeckoCodes: {} of {} codes run natively",
+               s_active_codes.size() - s_handler_codes.size(), s_active_codes.size());
+}
+
 void SetActiveCodes(const std::vector<GeckoCode>& gcodes)
 {
   std::lock_guard lk(s_active_codes_lock);
@@ -77,15 +208,19 @@ void SetActiveCodes(const std::vector<GeckoCode>& gcodes)
                  [](const GeckoCode& code) { return code.enabled; });
   }
   s_active_codes.shrink_to_fit();
+  CompileActiveCodesLocked();
 
   s_code_handler_installed = Installation::Uninstalled;
 }
 
 void SetSyncedCodesAsActive()
 {
+  std::lock_guard lk(s_active_codes_lock);
+
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
+  CompileActiveCodesLocked();
 }
 
 void UpdateSyncedCodes(const std::vector<GeckoCode>& gcodes)
@@ -109,6 +244,7 @@ std::vector<GeckoCode> SetAndReturnActiveCodes(const std::vector<GeckoCode>& gco
                  [](const GeckoCode& code) { return code.enabled; });
   }
   s_active_codes.shrink_to_fit();
+  CompileActiveCodesLocked();
 
   s_code_handler_installed = Installation::Uninstalled;
 
@@ -171,9 +307,10 @@ static Installation InstallCodeHandlerLocked()
   const u32 end_address = codelist_end_address - CODE_SIZE;
   u32 next_address = start_address;
 
-  // NOTE: Only active codes are in the list
-  for (const GeckoCode& active_code : s_active_codes)
+  // NOTE: Only active codes that don't run natively are in the list
+  for (const GeckoCode* handler_code : s_handler_codes)
   {
+    const GeckoCode& active_code = *handler_code;
     // If the code is not going to fit in the space we have left then we have to skip it
     if (next_address + active_code.codes.size() * CODE_SIZE > end_address)
     {
@@ -228,22 +365,30 @@ void Shutdown()
 {
   std::lock_guard codes_lock(s_active_codes_lock);
   s_active_codes.clear();
+  s_native_codes.Clear();
+  s_handler_codes.clear();
   s_code_handler_installed = Installation::Uninstalled;
 }
 
 void RunCodeHandler()
 {
-  if (!Config::Get(Config::MAIN_ENABLE_CHEATS))
+  if (!Config::GetSnapshot().enable_cheats)
     return;
 
   // NOTE: Need to release the lock because of GUI deadlocks with PanicAlert in HostWrite_*
   {
     std::lock_guard codes_lock(s_active_codes_lock);
+
+    // The native codes only use the HostTry* functions, which don't raise panic alerts
+    s_native_codes.Run();
+    if (s_handler_codes.empty())
+      return;
+
     if (s_code_handler_installed != Installation::Installed)
     {
       // Don't spam retry if the install failed. The corrupt / missing disk file is not likely to be
       // fixed within 1 frame of the last error.
-      if (s_active_codes.empty() || s_code_handler_installed == Installation::Failed)
+      if (s_code_handler_installed == Installation::Failed)
         return;
       s_code_handler_installed = InstallCodeHandlerLocked();
 
@@ -0,0 +1,235 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Greenzone.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/Config/ConfigSnapshot.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/HW/CPU.h"
+#include "Core/Movie.h"
+#include "Core/NetPlayProto.h"
+#include "Core/State.h"
+
+namespace Greenzone
+{
+// A state along with the position and hash of the movie input it had consumed. The state is only
+// usable while the movie input up to that position still hashes the same.
+struct Entry
+{
+  u64 input_byte = 0;
+  u64 input_hash = 0;
+  u64 last_used = 0;
+  std::vector<u8> state;
+};
+
+// Keyed by movie frame
+static std::map<u64, Entry> s_entries;
+static size_t s_memory_usage = 0;
+static u64 s_use_counter = 0;
+
+// Set when input that the running emulation already consumed was edited, in which case reaching
+// a later frame requires loading a state instead of just running forward.
+static bool s_running_state_stale = false;
+
+static std::atomic<bool> s_seeking{false};
+static u64 s_seek_target = 0;
+static std::mutex s_mutex;
+
+static bool IsEntryUsable(const Entry& entry)
+{
+  return entry.input_byte <= Movie::GetInputSize() &&
+         Movie::GetInputHash(entry.input_byte) == entry.input_hash;
+}
+
+static void Erase(std::map<u64, Entry>::iterator it)
+{
+  s_memory_usage -= it->second.state.capacity();
+  s_entries.erase(it);
+}
+
+static void EvictLeastRecentlyUsed()
+{
+  const auto lru = std::min_element(s_entries.begin(), s_entries.end(), [](auto& a, auto& b) {
+    return a.second.last_used < b.second.last_used;
+  });
+  Erase(lru);
+}
+
+static void Capture(u64 frame)
+{
+  const u64 input_byte = Movie::GetCurrentInputByte();
+  const u64 input_hash = Movie::GetInputHash(input_byte);
+
+  auto [it, inserted] = s_entries.try_emplace(frame);
+  Entry& entry = it->second;
+  entry.last_used = ++s_use_counter;
+
+  // Replaying over frames that are already captured (e.g. after a seek) doesn't save again
+  if (!inserted && entry.input_byte == input_byte && entry.input_hash == input_hash)
+    return;
+
+  s_memory_usage -= entry.state.capacity();
+  if (!State::SaveToMemory(entry.state))
+  {
+    s_memory_usage += entry.state.capacity();
+    Erase(it);
+    return;
+  }
+  s_memory_usage += entry.state.capacity();
+  entry.input_byte = input_byte;
+  entry.input_hash = input_hash;
+
+  // The state that was just captured is the most recently used, so it is never evicted here
+  const size_t budget =
+      static_cast<size_t>(std::max(Config::Get(Config::MAIN_GREENZONE_MEMORY_MB), 0)) << 20;
+  while (s_memory_usage > budget && s_entries.size() > 1)
+    EvictLeastRecentlyUsed();
+}
+
+static void ClearLocked()
+{
+  s_entries.clear();
+  s_memory_usage = 0;
+  s_use_counter = 0;
+  s_running_state_stale = false;
+  s_seeking = false;
+}
+
+void Init()
+{
+  std::lock_guard lk(s_mutex);
+  ClearLocked();
+}
+
+void Shutdown()
+{
+  std::lock_guard lk(s_mutex);
+  ClearLocked();
+}
+
+void OnFrameEnd()
+{
+  if (!Config::GetSnapshot().greenzone_enabled || NetPlay::IsNetPlayRunning() ||
+      !Movie::IsMovieActive())
+  {
+    return;
+  }
+
+  std::lock_guard lk(s_mutex);
+
+  const u64 frame = Movie::GetCurrentFrame();
+  const u64 interval = static_cast<u64>(std::max(Config::GetSnapshot().greenzone_interval, 1));
+  if (frame % interval == 0)
+    Capture(frame);
+
+  if (s_seeking && frame >= s_seek_target)
+  {
+    s_seeking = false;
+    CPU::Break();
+    Core::CallOnStateChangedCallbacks(Core::GetState());
+  }
+}
+
+bool EditInput(u64 offset, const u8* data, size_t size)
+{
+  std::lock_guard lk(s_mutex);
+
+  if (!Movie::ReplaceInput(offset, data, size))
+    return false;
+
+  for (auto it = s_entries.begin(); it != s_entries.end();)
+  {
+    auto next = std::next(it);
+    if (it->second.input_byte > offset)
+      Erase(it);
+    it = next;
+  }
+
+  if (offset < Movie::GetCurrentInputByte())
+    s_running_state_stale = true;
+
+  return true;
+}
+
+bool SeekToFrame(u64 frame)
+{
+  if (!Core::IsRunningAndStarted() || !Movie::IsMovieActive())
+    return false;
+
+  bool success = false;
+  bool needs_to_run = false;
+
+  Core::RunOnCPUThread(
+      [&] {
+        std::lock_guard lk(s_mutex);
+
+        auto best = s_entries.end();
+        for (auto it = s_entries.upper_bound(frame); it != s_entries.begin();)
+        {
+          --it;
+          if (IsEntryUsable(it->second))
+          {
+            best = it;
+            break;
+          }
+        }
+
+        // Keep playing the edited input rather than recording over it
+        Movie::SetReadOnly(true);
+
+        // Running forward from the current frame beats loading a state from before it
+        const u64 current_frame = Movie::GetCurrentFrame();
+        const bool can_run_forward = frame >= current_frame && !s_running_state_stale;
+        if (!can_run_forward || (best != s_entries.end() && best->first > current_frame))
+        {
+          if (best == s_entries.end() || !State::LoadFromMemory(best->second.state))
+            return;
+
+          best->second.last_used = ++s_use_counter;
+          s_running_state_stale = false;
+        }
+
+        success = true;
+        needs_to_run = Movie::GetCurrentFrame() < frame;
+        s_seek_target = frame;
+        s_seeking = needs_to_run;
+      },
+      true);
+
+  if (needs_to_run && Core::GetState() == Core::State::Paused)
+    Core::SetState(Core::State::Running);
+
+  return success;
+}
+
+bool IsSeeking()
+{
+  return s_seeking;
+}
+
+void Clear()
+{
+  std::lock_guard lk(s_mutex);
+  ClearLocked();
+}
+
+size_t GetStateCount()
+{
+  std::lock_guard lk(s_mutex);
+  return s_entries.size();
+}
+
+size_t GetMemoryUsage()
+{
+  std::lock_guard lk(s_mutex);
+  return s_memory_usage;
+}
+}  // namespace Greenzone
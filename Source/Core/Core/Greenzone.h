@@ -0,0 +1,37 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// In-memory states captured at regular movie frames, so that after editing the input of a movie
+// only the frames since the closest earlier state have to be replayed.
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace Greenzone
+{
+void Init();
+void Shutdown();
+
+// Called at the end of every emulated frame on the CPU thread. Captures a state every
+// MAIN_GREENZONE_INTERVAL movie frames, and pauses once a seek has reached its target frame.
+void OnFrameEnd();
+
+// Overwrites movie input at the given input log offset, and drops the states that were captured
+// after that input was consumed. Must be called on the CPU thread, or while it is paused.
+bool EditInput(u64 offset, const u8* data, size_t size);
+
+// Loads the latest state at or before the given movie frame that still matches the movie input,
+// then plays the movie back (read-only, unthrottled) until that frame and pauses. Returns false if
+// there is no such state and the frame can't be reached by running forward either.
+bool SeekToFrame(u64 frame);
+bool IsSeeking();
+
+// Drops all captured states
+void Clear();
+
+size_t GetStateCount();
+size_t GetMemoryUsage();
+}  // namespace Greenzone
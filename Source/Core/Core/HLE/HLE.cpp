@@ -10,9 +10,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
 
+#include "Core/CPUTimeBreakdown.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
+#include "Core/HLE/HLE_Lib.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
 #include "Core/HW/Memmap.h"
@@ -26,39 +28,45 @@ namespace HLE
 static std::map<u32, u32> s_hooked_addresses;
 
 // clang-format off
-constexpr std::array<Hook, 23> os_patches{{
+constexpr std::array<Hook, 27> os_patches{{
     // Placeholder, os_patches[0] is the "non-existent function" index
-    {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
+    {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace,    HookFlag::Generic},
 
     // Name doesn't matter, installed in CBoot::BootUp()
-    {"HBReload",                     HLE_Misc::HBReload,                    HookType::Replace, HookFlag::Generic},
+    {"HBReload",                     HLE_Misc::HBReload,                    HookType::Replace,    HookFlag::Generic},
 
     // Debug/OS Support
-    {"OSPanic",                      HLE_OS::HLE_OSPanic,                   HookType::Replace, HookFlag::Debug},
+    {"OSPanic",                      HLE_OS::HLE_OSPanic,                   HookType::Replace,    HookFlag::Debug},
 
     // This needs to be put before vprintf (because vprintf is called indirectly by this)
-    {"JUTWarningConsole_f",          HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-
-    {"OSReport",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"DEBUGPrint",                   HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"WUD_DEBUGPrint",               HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"__DSP_debug_printf",           HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"vprintf",                      HLE_OS::HLE_GeneralDebugVPrint,        HookType::Start,   HookFlag::Debug},
-    {"printf",                       HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"vdprintf",                     HLE_OS::HLE_LogVDPrint,                HookType::Start,   HookFlag::Debug},
-    {"dprintf",                      HLE_OS::HLE_LogDPrint,                 HookType::Start,   HookFlag::Debug},
-    {"vfprintf",                     HLE_OS::HLE_LogVFPrint,                HookType::Start,   HookFlag::Debug},
-    {"fprintf",                      HLE_OS::HLE_LogFPrint,                 HookType::Start,   HookFlag::Debug},
-    {"nlPrintf",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"DWC_Printf",                   HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"RANK_Printf",                  HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug},
-    {"puts",                         HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug}, // gcc-optimized printf?
-    {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug}, // used for early init things (normally)
-    {"__write_console",              HLE_OS::HLE_write_console,             HookType::Start,   HookFlag::Debug}, // used by sysmenu (+more?)
-
-    {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
-    {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
-    {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Replace, HookFlag::Fixed} // apploader needs OSReport-like function
+    {"JUTWarningConsole_f",          HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+
+    {"OSReport",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"DEBUGPrint",                   HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"WUD_DEBUGPrint",               HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"__DSP_debug_printf",           HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"vprintf",                      HLE_OS::HLE_GeneralDebugVPrint,        HookType::Start,      HookFlag::Debug},
+    {"printf",                       HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"vdprintf",                     HLE_OS::HLE_LogVDPrint,                HookType::Start,      HookFlag::Debug},
+    {"dprintf",                      HLE_OS::HLE_LogDPrint,                 HookType::Start,      HookFlag::Debug},
+    {"vfprintf",                     HLE_OS::HLE_LogVFPrint,                HookType::Start,      HookFlag::Debug},
+    {"fprintf",                      HLE_OS::HLE_LogFPrint,                 HookType::Start,      HookFlag::Debug},
+    {"nlPrintf",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"DWC_Printf",                   HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"RANK_Printf",                  HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug},
+    {"puts",                         HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug}, // gcc-optimized printf?
+    {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,      HookFlag::Debug}, // used for early init things (normally)
+    {"__write_console",              HLE_OS::HLE_write_console,             HookType::Start,      HookFlag::Debug}, // used by sysmenu (+more?)
+
+    // Library functions
+    {"memcpy",                       HLE_Lib::HLE_memcpy,                   HookType::TryReplace, HookFlag::Library},
+    {"memset",                       HLE_Lib::HLE_memset,                   HookType::TryReplace, HookFlag::Library},
+    {"strlen",                       HLE_Lib::HLE_strlen,                   HookType::TryReplace, HookFlag::Library},
+    {"DCFlushRange",                 HLE_Lib::HLE_DCFlushRange,             HookType::Replace,    HookFlag::Library},
+
+    {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,      HookFlag::Fixed},
+    {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace,    HookFlag::Fixed},
+    {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Replace,    HookFlag::Fixed} // apploader needs OSReport-like function
 }};
 // clang-format on
 
@@ -152,6 +160,18 @@ void Execute(u32 current_pc, u32 hook_index)
   hook_index &= 0xFFFFF;
   if (hook_index > 0 && hook_index < os_patches.size())
   {
+    // Only used on the CPU thread, so the counters can be created lazily
+    static std::array<CPUTimeBreakdown::Counter*, os_patches.size()> s_time_counters{};
+    CPUTimeBreakdown::Counter*& time_counter = s_time_counters[hook_index];
+    if (!time_counter)
+    {
+      time_counter = CPUTimeBreakdown::GetCounter(CPUTimeBreakdown::Category::HLE,
+                                                  os_patches[hook_index].name);
+    }
+    CPUTimeBreakdown::Scope time_scope(time_counter);
+
+    if (os_patches[hook_index].type == HookType::TryReplace)
+      NPC = current_pc;
     os_patches[hook_index].function();
   }
   else
@@ -189,6 +209,8 @@ HookFlag GetHookFlagsByIndex(u32 index)
 
 bool IsEnabled(HookFlag flag)
 {
+  if (flag == HLE::HookFlag::Library)
+    return Config::Get(Config::MAIN_HLE_LIBRARY_FUNCTIONS);
   return flag != HLE::HookFlag::Debug || SConfig::GetInstance().bEnableDebugging ||
          PowerPC::GetMode() == PowerPC::CoreMode::Interpreter;
 }
@@ -13,9 +13,10 @@ using HookFunction = void (*)();
 
 enum class HookType
 {
-  Start,    // Hook the beginning of the function and execute the function afterwards
-  Replace,  // Replace the function with the HLE version
-  None,     // Do not hook the function
+  Start,       // Hook the beginning of the function and execute the function afterwards
+  Replace,     // Replace the function with the HLE version
+  TryReplace,  // Like Replace, but the function runs if the HLE version leaves NPC at its start
+  None,        // Do not hook the function
 };
 
 enum class HookFlag
@@ -23,6 +24,7 @@ enum class HookFlag
   Generic,  // Miscellaneous function
   Debug,    // Debug output function
   Fixed,    // An arbitrary hook mapped to a fixed address instead of a symbol
+  Library,  // Host implementation of a library function, see MAIN_HLE_LIBRARY_FUNCTIONS
 };
 
 struct Hook
@@ -70,7 +72,7 @@ bool ReplaceFunctionIfPossible(u32 address, FunctionObject fn)
     return false;
 
   const HookType type = GetHookTypeByIndex(hook_index);
-  if (type != HookType::Start && type != HookType::Replace)
+  if (type != HookType::Start && type != HookType::Replace && type != HookType::TryReplace)
     return false;
 
   const HookFlag flags = GetHookFlagsByIndex(hook_index);
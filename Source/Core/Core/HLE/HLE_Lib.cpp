@@ -0,0 +1,108 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HLE/HLE_Lib.h"
+
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace HLE_Lib
+{
+// strlen looks for the terminator in chunks of this size
+constexpr size_t STRLEN_CHUNK_SIZE = 0x1000;
+
+static u8* GetDirectPointer(u32 address, size_t size)
+{
+  size_t direct_size = size;
+  u8* pointer = PowerPC::HostGetDirectPointer(address, &direct_size);
+  return direct_size == size ? pointer : nullptr;
+}
+
+// void* memcpy(void* dest, const void* src, size_t n)
+void HLE_memcpy()
+{
+  const u32 dest = GPR(3);
+  const u32 src = GPR(4);
+  const u32 size = GPR(5);
+
+  if (size != 0)
+  {
+    u8* dest_pointer = GetDirectPointer(dest, size);
+    const u8* src_pointer = GetDirectPointer(src, size);
+    if (!dest_pointer || !src_pointer)
+      return;
+
+    // The direction the SDK copies overlapping buffers in depends on its version
+    if (dest_pointer < src_pointer + size && src_pointer < dest_pointer + size)
+      return;
+
+    std::memcpy(dest_pointer, src_pointer, size);
+  }
+
+  NPC = LR;
+}
+
+// void* memset(void* dest, int c, size_t n)
+void HLE_memset()
+{
+  const u32 dest = GPR(3);
+  const u32 size = GPR(5);
+
+  if (size != 0)
+  {
+    u8* dest_pointer = GetDirectPointer(dest, size);
+    if (!dest_pointer)
+      return;
+
+    std::memset(dest_pointer, static_cast<u8>(GPR(4)), size);
+  }
+
+  NPC = LR;
+}
+
+// size_t strlen(const char* str)
+void HLE_strlen()
+{
+  const u32 str = GPR(3);
+
+  u32 length = 0;
+  while (true)
+  {
+    size_t chunk_size = STRLEN_CHUNK_SIZE;
+    const u8* pointer = PowerPC::HostGetDirectPointer(str + length, &chunk_size);
+    if (!pointer)
+      return;
+
+    const void* terminator = std::memchr(pointer, 0, chunk_size);
+    if (terminator)
+    {
+      length += static_cast<u32>(static_cast<const u8*>(terminator) - pointer);
+      break;
+    }
+    length += static_cast<u32>(chunk_size);
+  }
+
+  GPR(3) = length;
+  NPC = LR;
+}
+
+// void DCFlushRange(void* start, u32 length)
+void HLE_DCFlushRange()
+{
+  const u32 start = GPR(3);
+  const u32 size = GPR(4);
+
+  // The same JIT cache invalidation as the dcbf loop of the original function
+  if (size != 0)
+  {
+    const u32 first_line = start & ~0x1f;
+    JitInterface::InvalidateICacheLines(first_line, (start + size - first_line + 0x1f) >> 5);
+  }
+
+  NPC = LR;
+}
+}  // namespace HLE_Lib
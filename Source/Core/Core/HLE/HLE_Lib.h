@@ -0,0 +1,15 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Host implementations of hot SDK library functions. They only run when the buffers they are
+// given can be accessed directly in host memory, and otherwise leave NPC at the start of the
+// function so that the emulated version runs instead (see HookType::TryReplace).
+namespace HLE_Lib
+{
+void HLE_memcpy();
+void HLE_memset();
+void HLE_strlen();
+void HLE_DCFlushRange();
+}  // namespace HLE_Lib
@@ -33,10 +33,12 @@
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
 
+#include "Core/HW/AudioInterface.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "VideoCommon/RenderBase.h"
 
 namespace DSP
 {
@@ -166,6 +168,19 @@ static void GenerateDSPInterrupt(u64 DSPIntType, s64 cyclesLate = 0);
 static CoreTiming::EventType* s_et_GenerateDSPInterrupt;
 static CoreTiming::EventType* s_et_CompleteARAM;
 
+// Sends DMA audio to the mixer, and to frame dumps that contain an audio stream.
+static void SendAudioSamples(const short* samples, unsigned int num_samples)
+{
+  AudioCommon::SendAIBuffer(samples, num_samples);
+
+  if (samples && g_renderer)
+  {
+    g_renderer->GetFrameDump().AddAudioSamples(samples, num_samples,
+                                               AudioInterface::GetAIDSampleRate(),
+                                               CoreTiming::GetTicks());
+  }
+}
+
 static void CompleteARAM(u64 userdata, s64 cyclesLate)
 {
   s_dspState.DMAState = 0;
@@ -392,7 +407,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
 
           // We make the samples ready as soon as possible
           void* address = Memory::GetPointer(s_audioDMA.SourceAddress);
-          AudioCommon::SendAIBuffer((short*)address, s_audioDMA.AudioDMAControl.NumBlocks * 8);
+          SendAudioSamples((short*)address, s_audioDMA.AudioDMAControl.NumBlocks * 8);
 
           // TODO: need hardware tests for the timing of this interrupt.
           // Sky Crawlers crashes at boot if this is scheduled less than 87 cycles in the future.
@@ -433,6 +448,9 @@ static void UpdateInterrupts()
 
 static void GenerateDSPInterrupt(u64 DSPIntType, s64 cyclesLate)
 {
+  if (DSPIntType & INT_DSP)
+    s_dsp_emulator->FinishPendingWork();
+
   // The INT_* enumeration members have values that reflect their bit positions in
   // DSP_CONTROL - we mask by (INT_DSP | INT_ARAM | INT_AID) just to ensure people
   // don't call this with bogus values.
@@ -489,14 +507,14 @@ void UpdateAudioDMA()
       {
         // We make the samples ready as soon as possible
         void* address = Memory::GetPointer(s_audioDMA.SourceAddress);
-        AudioCommon::SendAIBuffer((short*)address, s_audioDMA.AudioDMAControl.NumBlocks * 8);
+        SendAudioSamples((short*)address, s_audioDMA.AudioDMAControl.NumBlocks * 8);
       }
       GenerateDSPInterrupt(DSP::INT_AID);
     }
   }
   else
   {
-    AudioCommon::SendAIBuffer(&zero_samples[0], 8);
+    SendAudioSamples(&zero_samples[0], 8);
   }
 }
 
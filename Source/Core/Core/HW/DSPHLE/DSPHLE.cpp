@@ -44,10 +44,17 @@ void DSPHLE::Shutdown()
 
 void DSPHLE::DSP_Update(int cycles)
 {
+  FinishPendingWork();
   if (m_ucode != nullptr)
     m_ucode->Update();
 }
 
+void DSPHLE::FinishPendingWork()
+{
+  if (m_ucode != nullptr)
+    m_ucode->FinishPendingWork();
+}
+
 u32 DSPHLE::DSP_UpdateRate()
 {
   // AX HLE uses 3ms (Wii) or 5ms (GC) timing period
@@ -57,6 +64,7 @@ u32 DSPHLE::DSP_UpdateRate()
 
 void DSPHLE::SendMailToDSP(u32 mail)
 {
+  FinishPendingWork();
   if (m_ucode != nullptr)
   {
     DEBUG_LOG_FMT(DSP_MAIL, "CPU writes {:#010x}", mail);
@@ -66,6 +74,7 @@ void DSPHLE::SendMailToDSP(u32 mail)
 
 void DSPHLE::SetUCode(u32 crc)
 {
+  FinishPendingWork();
   m_mail_handler.Clear();
   m_ucode = UCodeFactory(crc, this, m_wii);
   m_ucode->Initialize();
@@ -76,6 +85,7 @@ void DSPHLE::SetUCode(u32 crc)
 // Even callers are deleted.
 void DSPHLE::SwapUCode(u32 crc)
 {
+  FinishPendingWork();
   m_mail_handler.Clear();
 
   if (m_last_ucode && UCodeInterface::GetCRC(m_last_ucode.get()) == crc)
@@ -93,6 +103,8 @@ void DSPHLE::SwapUCode(u32 crc)
 
 void DSPHLE::DoState(PointerWrap& p)
 {
+  FinishPendingWork();
+
   bool is_hle = true;
   p.Do(is_hle);
   if (!is_hle && p.GetMode() == PointerWrap::MODE_READ)
@@ -136,6 +148,7 @@ void DSPHLE::DoState(PointerWrap& p)
 // Mailbox functions
 u16 DSPHLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
 {
+  FinishPendingWork();
   if (cpu_mailbox)
   {
     return (m_dsp_state.cpu_mailbox >> 16) & 0xFFFF;
@@ -148,6 +161,7 @@ u16 DSPHLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
 
 u16 DSPHLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
 {
+  FinishPendingWork();
   if (cpu_mailbox)
   {
     return m_dsp_state.cpu_mailbox & 0xFFFF;
@@ -188,6 +202,7 @@ void DSPHLE::DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value)
 // Other DSP functions
 u16 DSPHLE::DSP_WriteControlRegister(u16 value)
 {
+  FinishPendingWork();
   DSP::UDSPControl temp(value);
 
   if (temp.DSPReset)
@@ -37,6 +37,7 @@ public:
   void DSP_Update(int cycles) override;
   void DSP_StopSoundStream() override;
   u32 DSP_UpdateRate() override;
+  void FinishPendingWork() override;
 
   CMailHandler& AccessMailHandler() { return m_mail_handler; }
   void SetUCode(u32 crc);
@@ -15,6 +15,8 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -34,6 +36,14 @@ AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc)
 
 AXUCode::~AXUCode()
 {
+  if (m_cmdlist_thread.joinable())
+  {
+    FinishPendingWork();
+    m_cmdlist_thread_exit.Set();
+    m_cmdlist_start_event.Set();
+    m_cmdlist_thread.join();
+  }
+
   m_mail_handler.Clear();
 }
 
@@ -678,8 +688,16 @@ void AXUCode::HandleMail(u32 mail)
   if (next_is_cmdlist)
   {
     CopyCmdList(mail, cmdlist_size);
-    HandleCommandList();
-    m_cmdlist_size = 0;
+    if (Config::GetSnapshot().dsp_hle_thread && CanProcessCommandListOnThread() &&
+        !Core::WantsDeterminism())
+    {
+      StartCommandListOnThread();
+    }
+    else
+    {
+      HandleCommandList();
+      m_cmdlist_size = 0;
+    }
     SignalWorkEnd();
   }
   else if (m_upload_setup_in_progress)
@@ -731,6 +749,41 @@ void AXUCode::CopyCmdList(u32 addr, u16 size)
   m_cmdlist_size = size;
 }
 
+void AXUCode::StartCommandListOnThread()
+{
+  if (!m_cmdlist_thread.joinable())
+    m_cmdlist_thread = std::thread(&AXUCode::CommandListThread, this);
+
+  m_cmdlist_pending = true;
+  m_cmdlist_start_event.Set();
+}
+
+void AXUCode::CommandListThread()
+{
+  Common::SetCurrentThreadName("AX HLE");
+  Common::ApplyThreadRole(Common::ThreadRole::DSP);
+
+  while (true)
+  {
+    m_cmdlist_start_event.Wait();
+    if (m_cmdlist_thread_exit.IsSet())
+      break;
+
+    HandleCommandList();
+    m_cmdlist_done_event.Set();
+  }
+}
+
+void AXUCode::FinishPendingWork()
+{
+  if (!m_cmdlist_pending)
+    return;
+
+  m_cmdlist_done_event.Wait();
+  m_cmdlist_pending = false;
+  m_cmdlist_size = 0;
+}
+
 void AXUCode::Update()
 {
   // Used for UCode switching.
@@ -13,9 +13,12 @@
 
 #include <array>
 #include <optional>
+#include <thread>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Swap.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
@@ -66,6 +69,7 @@ public:
   void Initialize() override;
   void HandleMail(u32 mail) override;
   void Update() override;
+  void FinishPendingWork() override;
   void DoState(PointerWrap& p) override;
 
 protected:
@@ -103,6 +107,13 @@ protected:
 
   u16 m_compressor_pos = 0;
 
+  std::thread m_cmdlist_thread;
+  Common::Event m_cmdlist_start_event;
+  Common::Event m_cmdlist_done_event;
+  Common::Flag m_cmdlist_thread_exit;
+  // Only accessed by the CPU thread
+  bool m_cmdlist_pending = false;
+
   bool LoadResamplingCoefficients(bool require_same_checksum, u32 desired_checksum);
 
   // Copy a command list from memory to our temp buffer
@@ -137,6 +148,13 @@ protected:
   virtual void HandleCommandList();
   void SignalWorkEnd();
 
+  // Command lists which don't send mails while they run can be processed on a worker thread. The
+  // emulated CPU only sees the results once it gets the end of work interrupt or reads a mail,
+  // which both wait for the worker, so the results are the same as processing them right away.
+  virtual bool CanProcessCommandListOnThread() const { return true; }
+  void StartCommandListOnThread();
+  void CommandListThread();
+
   void SetupProcessing(u32 init_addr);
   void DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16 vol_auxb);
   void ProcessPBList(u32 pb_addr);
@@ -0,0 +1,87 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+#include <algorithm>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE
+{
+void ApplyVolumeRampScalar(const s16* input, s16* output, u32 count, u16 volume,
+                           u16 volume_delta)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 sample = (input[i] * volume) >> 15;
+    output[i] = static_cast<s16>(std::clamp(sample, -32767, 32767));  // -32768 ?
+    volume += volume_delta;
+  }
+}
+
+void ApplyVolumeRamp(const s16* input, s16* output, u32 count, u16 volume, u16 volume_delta)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  // The volumes of eight consecutive samples. They wrap around like the scalar u16 does.
+  __m128i volumes = _mm_add_epi16(
+      _mm_set1_epi16(static_cast<s16>(volume)),
+      _mm_mullo_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7),
+                      _mm_set1_epi16(static_cast<s16>(volume_delta))));
+  const __m128i volumes_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+
+    // Signed by unsigned 16-bit products: the unsigned high half is off by the volume wherever the
+    // sample is negative.
+    const __m128i low = _mm_mullo_epi16(samples, volumes);
+    const __m128i high = _mm_sub_epi16(_mm_mulhi_epu16(samples, volumes),
+                                       _mm_and_si128(_mm_srai_epi16(samples, 15), volumes));
+    const __m128i products_lo = _mm_srai_epi32(_mm_unpacklo_epi16(low, high), 15);
+    const __m128i products_hi = _mm_srai_epi32(_mm_unpackhi_epi16(low, high), 15);
+
+    // The pack saturates to [-32768, 32767], only the lower bound needs fixing up.
+    const __m128i result = _mm_max_epi16(_mm_packs_epi32(products_lo, products_hi), min_sample);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+
+    volumes = _mm_add_epi16(volumes, volumes_step);
+  }
+#elif defined(_M_ARM_64)
+  static constexpr u16 LANE_INDICES[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  uint16x8_t volumes =
+      vmlaq_n_u16(vdupq_n_u16(volume), vld1q_u16(LANE_INDICES), static_cast<u16>(volume_delta));
+  const uint16x8_t volumes_step = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+  const int16x8_t min_sample = vdupq_n_s16(-32767);
+
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(input + i);
+    const int32x4_t products_lo =
+        vmulq_s32(vmovl_s16(vget_low_s16(samples)),
+                  vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes))));
+    const int32x4_t products_hi =
+        vmulq_s32(vmovl_s16(vget_high_s16(samples)),
+                  vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(volumes))));
+
+    // The narrowing shift saturates to [-32768, 32767], only the lower bound needs fixing up.
+    const int16x8_t result =
+        vcombine_s16(vqshrn_n_s32(products_lo, 15), vqshrn_n_s32(products_hi, 15));
+    vst1q_s16(output + i, vmaxq_s16(result, min_sample));
+
+    volumes = vaddq_u16(volumes, volumes_step);
+  }
+#endif
+
+  volume += static_cast<u16>(volume_delta * i);
+  ApplyVolumeRampScalar(input + i, output + i, count - i, volume, volume_delta);
+}
+}  // namespace DSP::HLE
@@ -0,0 +1,17 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE
+{
+// Scales count samples by a 1.15 fixed point volume which is incremented by volume_delta after
+// each sample, and clamps the results to [-32767, 32767]. input and output may be the same
+// buffer. The default version uses SSE2 or NEON where available, the scalar version is the
+// reference it must match bit for bit.
+void ApplyVolumeRamp(const s16* input, s16* output, u32 count, u16 volume, u16 volume_delta);
+void ApplyVolumeRampScalar(const s16* input, s16* output, u32 count, u16 volume,
+                           u16 volume_delta);
+}  // namespace DSP::HLE
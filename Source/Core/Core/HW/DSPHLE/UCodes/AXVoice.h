@@ -20,6 +20,7 @@
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
@@ -372,18 +373,14 @@ void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ra
   if (!ramp)
     volume_delta = 0;
 
+  s16 samples[MAX_SAMPLES_PER_FRAME];
+  ApplyVolumeRamp(input, samples, count, volume, volume_delta);
   for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+    out[i] += samples[i];
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
+  volume += static_cast<u16>(volume_delta * count);
+  if (count != 0)
+    *dpop = samples[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -409,12 +406,9 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    samples[i] = std::clamp(((s32)samples[i] * pb.vol_env.cur_volume) >> 15, -32767,
-                            32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  const u16 volume_delta = static_cast<u16>(pb.vol_env.cur_volume_delta);
+  ApplyVolumeRamp(samples, samples, count, pb.vol_env.cur_volume, volume_delta);
+  pb.vol_env.cur_volume += static_cast<u16>(volume_delta * count);
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
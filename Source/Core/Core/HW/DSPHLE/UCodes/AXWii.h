@@ -20,6 +20,9 @@ public:
   void DoState(PointerWrap& p) override;
 
 protected:
+  // OutputSamples sends a mail in the middle of the command list.
+  bool CanProcessCommandListOnThread() const override { return false; }
+
   // Additional AUX buffers
   int m_samples_auxC_left[32 * 3];
   int m_samples_auxC_right[32 * 3];
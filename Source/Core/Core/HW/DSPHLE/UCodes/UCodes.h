@@ -46,6 +46,9 @@ public:
   virtual void HandleMail(u32 mail) = 0;
   virtual void Update() = 0;
 
+  // Waits for the ucode's work running on another thread, if any.
+  virtual void FinishPendingWork() {}
+
   virtual void DoState(PointerWrap& p) { DoStateShared(p); }
   static u32 GetCRC(UCodeInterface* ucode) { return ucode ? ucode->m_crc : UCODE_NULL; }
 
@@ -0,0 +1,276 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/ZeldaMix.h"
+
+#include <algorithm>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE::ZeldaMix
+{
+#if defined(_M_X86_64)
+// The 32-bit products of signed samples by unsigned volumes, for the low and high four lanes.
+// The unsigned high half is off by the volume wherever the sample is negative.
+static void MultiplyByVolume(__m128i samples, __m128i volumes, __m128i* products_lo,
+                             __m128i* products_hi)
+{
+  const __m128i low = _mm_mullo_epi16(samples, volumes);
+  const __m128i high = _mm_sub_epi16(_mm_mulhi_epu16(samples, volumes),
+                                     _mm_and_si128(_mm_srai_epi16(samples, 15), volumes));
+  *products_lo = _mm_unpacklo_epi16(low, high);
+  *products_hi = _mm_unpackhi_epi16(low, high);
+}
+#elif defined(_M_ARM_64)
+static void MultiplyByVolume(int16x8_t samples, uint16x8_t volumes, int32x4_t* products_lo,
+                             int32x4_t* products_hi)
+{
+  *products_lo = vmulq_s32(vmovl_s16(vget_low_s16(samples)),
+                           vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes))));
+  *products_hi = vmulq_s32(vmovl_s16(vget_high_s16(samples)),
+                           vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(volumes))));
+}
+#endif
+
+s32 AddWithVolumeRampScalar(s16* dst, const s16* src, u32 count, s32 volume, s32 step)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    dst[i] += ((volume >> 16) * src[i]) >> 16;
+    volume += step;
+  }
+  return volume;
+}
+
+s32 AddWithVolumeRamp(s16* dst, const s16* src, u32 count, s32 volume, s32 step)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  // The volumes of eight consecutive samples, wrapping around like the scalar version in practice
+  const u32 vol = static_cast<u32>(volume);
+  const u32 st = static_cast<u32>(step);
+  __m128i volumes_lo = _mm_setr_epi32(vol, vol + st, vol + 2 * st, vol + 3 * st);
+  __m128i volumes_hi = _mm_add_epi32(volumes_lo, _mm_set1_epi32(4 * st));
+  const __m128i volumes_step = _mm_set1_epi32(8 * st);
+
+  for (; i + 8 <= count; i += 8)
+  {
+    // The integer parts fit in 16 bits, so the pack doesn't saturate
+    const __m128i volumes = _mm_packs_epi32(_mm_srai_epi32(volumes_lo, 16),
+                                            _mm_srai_epi32(volumes_hi, 16));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i mixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    mixed = _mm_add_epi16(mixed, _mm_mulhi_epi16(volumes, samples));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), mixed);
+
+    volumes_lo = _mm_add_epi32(volumes_lo, volumes_step);
+    volumes_hi = _mm_add_epi32(volumes_hi, volumes_step);
+  }
+#elif defined(_M_ARM_64)
+  static constexpr s32 LANE_INDICES[4] = {0, 1, 2, 3};
+  int32x4_t volumes_lo = vmlaq_n_s32(vdupq_n_s32(volume), vld1q_s32(LANE_INDICES), step);
+  int32x4_t volumes_hi = vaddq_s32(volumes_lo, vdupq_n_s32(4 * step));
+  const int32x4_t volumes_step = vdupq_n_s32(8 * step);
+
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x4_t volumes_lo_int = vshrn_n_s32(volumes_lo, 16);
+    const int16x4_t volumes_hi_int = vshrn_n_s32(volumes_hi, 16);
+    const int16x8_t samples = vld1q_s16(src + i);
+    const int16x8_t products =
+        vcombine_s16(vshrn_n_s32(vmull_s16(volumes_lo_int, vget_low_s16(samples)), 16),
+                     vshrn_n_s32(vmull_s16(volumes_hi_int, vget_high_s16(samples)), 16));
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), products));
+
+    volumes_lo = vaddq_s32(volumes_lo, volumes_step);
+    volumes_hi = vaddq_s32(volumes_hi, volumes_step);
+  }
+#endif
+
+  volume = static_cast<s32>(static_cast<u32>(volume) + static_cast<u32>(step) * i);
+  return AddWithVolumeRampScalar(dst + i, src + i, count - i, volume, step);
+}
+
+void AddWithVolumeScalar(s16* dst, const s16* src, u32 count, u16 volume)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 scaled = (static_cast<s32>(src[i]) * static_cast<s32>(volume)) >> 15;
+    dst[i] += std::clamp(scaled, -0x8000, 0x7FFF);
+  }
+}
+
+void AddWithVolume(s16* dst, const s16* src, u32 count, u16 volume)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  const __m128i volumes = _mm_set1_epi16(static_cast<s16>(volume));
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i products_lo, products_hi;
+    MultiplyByVolume(samples, volumes, &products_lo, &products_hi);
+
+    // The pack saturates to [-0x8000, 0x7FFF] like the clamp
+    const __m128i scaled =
+        _mm_packs_epi32(_mm_srai_epi32(products_lo, 15), _mm_srai_epi32(products_hi, 15));
+    __m128i mixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi16(mixed, scaled));
+  }
+#elif defined(_M_ARM_64)
+  const uint16x8_t volumes = vdupq_n_u16(volume);
+  for (; i + 8 <= count; i += 8)
+  {
+    int32x4_t products_lo, products_hi;
+    MultiplyByVolume(vld1q_s16(src + i), volumes, &products_lo, &products_hi);
+
+    // The narrowing shift saturates to [-0x8000, 0x7FFF] like the clamp
+    const int16x8_t scaled =
+        vcombine_s16(vqshrn_n_s32(products_lo, 15), vqshrn_n_s32(products_hi, 15));
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), scaled));
+  }
+#endif
+
+  AddWithVolumeScalar(dst + i, src + i, count - i, volume);
+}
+
+void ApplyVolumeScalar(s16* buffer, u32 count, u16 volume, u32 shift)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    s32 tmp = (u32)buffer[i] * (u32)volume;
+    tmp >>= shift;
+
+    buffer[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+void ApplyVolume(s16* buffer, u32 count, u16 volume, u32 shift)
+{
+  u32 i = 0;
+
+  // The products of s16 samples and u16 volumes always fit in an s32, so the u32 arithmetic of the
+  // scalar version is the same as a signed multiplication.
+#if defined(_M_X86_64)
+  const __m128i volumes = _mm_set1_epi16(static_cast<s16>(volume));
+  const __m128i shift_count = _mm_cvtsi32_si128(static_cast<int>(shift));
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+    __m128i products_lo, products_hi;
+    MultiplyByVolume(samples, volumes, &products_lo, &products_hi);
+
+    const __m128i result = _mm_packs_epi32(_mm_sra_epi32(products_lo, shift_count),
+                                           _mm_sra_epi32(products_hi, shift_count));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i), result);
+  }
+#elif defined(_M_ARM_64)
+  const uint16x8_t volumes = vdupq_n_u16(volume);
+  const int32x4_t shift_count = vdupq_n_s32(-static_cast<s32>(shift));
+  for (; i + 8 <= count; i += 8)
+  {
+    int32x4_t products_lo, products_hi;
+    MultiplyByVolume(vld1q_s16(buffer + i), volumes, &products_lo, &products_hi);
+
+    const int16x8_t result = vcombine_s16(vqmovn_s32(vshlq_s32(products_lo, shift_count)),
+                                          vqmovn_s32(vshlq_s32(products_hi, shift_count)));
+    vst1q_s16(buffer + i, result);
+  }
+#endif
+
+  ApplyVolumeScalar(buffer + i, count - i, volume, shift);
+}
+
+u32 ResampleScalar(const s16* src, s16* dst, u32 count, u32 pos, u32 ratio, const s16* coeffs)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    // We have 0x40 * 4 coeffs that need to be selected based on the
+    // most significant bits of the fractional part of the position. 12
+    // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
+    // consecutive coeffs.
+    const s16* filter = &coeffs[((pos & 0xFFF) >> 6) * 4];
+    const s16* input = &src[pos >> 12];
+
+    s64 dst_sample_unclamped = 0;
+    for (size_t j = 0; j < 4; ++j)
+      dst_sample_unclamped += (s64)2 * filter[j] * input[j];
+    dst_sample_unclamped >>= 16;
+
+    dst[i] = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+
+    pos += ratio;
+  }
+  return pos;
+}
+
+u32 Resample(const s16* src, s16* dst, u32 count, u32 pos, u32 ratio, const s16* coeffs)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  // Four output samples at a time. With only four taps, the filters are applied across the outputs
+  // rather than across the taps.
+  const __m128i low_mask = _mm_set1_epi32(0x7FFF);
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i windows[4];
+    __m128i filters[4];
+    for (u32 j = 0; j < 4; ++j)
+    {
+      windows[j] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (pos >> 12)));
+      filters[j] =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(coeffs + ((pos & 0xFFF) >> 6) * 4));
+      pos += ratio;
+    }
+
+    // Transpose so that each half of a vector holds one tap for the four outputs
+    const __m128i windows_01 = _mm_unpacklo_epi16(windows[0], windows[1]);
+    const __m128i windows_23 = _mm_unpacklo_epi16(windows[2], windows[3]);
+    const __m128i filters_01 = _mm_unpacklo_epi16(filters[0], filters[1]);
+    const __m128i filters_23 = _mm_unpacklo_epi16(filters[2], filters[3]);
+    const __m128i input_taps[2] = {_mm_unpacklo_epi32(windows_01, windows_23),
+                                   _mm_unpackhi_epi32(windows_01, windows_23)};
+    const __m128i filter_taps[2] = {_mm_unpacklo_epi32(filters_01, filters_23),
+                                    _mm_unpackhi_epi32(filters_01, filters_23)};
+
+    // The sum of the four products needs 34 bits. The result is that sum >> 15, so sum the parts
+    // above and below bit 15 of each product separately, which can't overflow.
+    __m128i high_sum = _mm_setzero_si128();
+    __m128i low_sum = _mm_setzero_si128();
+    for (u32 j = 0; j < 2; ++j)
+    {
+      const __m128i low = _mm_mullo_epi16(input_taps[j], filter_taps[j]);
+      const __m128i high = _mm_mulhi_epi16(input_taps[j], filter_taps[j]);
+      const __m128i products[2] = {_mm_unpacklo_epi16(low, high), _mm_unpackhi_epi16(low, high)};
+      for (const __m128i& product : products)
+      {
+        high_sum = _mm_add_epi32(high_sum, _mm_srai_epi32(product, 15));
+        low_sum = _mm_add_epi32(low_sum, _mm_and_si128(product, low_mask));
+      }
+    }
+    const __m128i result = _mm_add_epi32(high_sum, _mm_srli_epi32(low_sum, 15));
+
+    // The pack saturates to [-0x8000, 0x7FFF] like the clamp
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(result, result));
+  }
+#elif defined(_M_ARM_64)
+  for (; i < count; ++i)
+  {
+    const int32x4_t products =
+        vmull_s16(vld1_s16(src + (pos >> 12)), vld1_s16(coeffs + ((pos & 0xFFF) >> 6) * 4));
+    const s64 sum = vaddlvq_s32(products);
+    dst[i] = static_cast<s16>(std::clamp<s64>(sum >> 15, -0x8000, 0x7FFF));
+    pos += ratio;
+  }
+#endif
+
+  return ResampleScalar(src, dst + i, count - i, pos, ratio, coeffs);
+}
+}  // namespace DSP::HLE::ZeldaMix
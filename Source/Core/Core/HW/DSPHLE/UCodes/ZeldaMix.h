@@ -0,0 +1,30 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// The per-sample loops of the Zelda ucode renderer. The default versions use SSE2 or NEON where
+// available, the scalar versions are the reference they must match bit for bit.
+namespace DSP::HLE::ZeldaMix
+{
+// Adds src to dst, scaled by a 16.16 volume which is incremented by step after each sample.
+// Returns the volume after the last sample.
+s32 AddWithVolumeRamp(s16* dst, const s16* src, u32 count, s32 volume, s32 step);
+s32 AddWithVolumeRampScalar(s16* dst, const s16* src, u32 count, s32 volume, s32 step);
+
+// Adds src to dst, scaled by a 1.15 volume and clamped before the (wrapping) addition.
+void AddWithVolume(s16* dst, const s16* src, u32 count, u16 volume);
+void AddWithVolumeScalar(s16* dst, const s16* src, u32 count, u16 volume);
+
+// Scales the samples by a fixed point volume with 16 - shift integer bits, with clamping.
+void ApplyVolume(s16* buffer, u32 count, u16 volume, u32 shift);
+void ApplyVolumeScalar(s16* buffer, u32 count, u16 volume, u32 shift);
+
+// Resamples src into count samples with the 4-tap filter picked by the fractional position from
+// the 0x40 filters in coeffs. pos and ratio are in 20.12 format. Returns the position after the
+// last sample.
+u32 Resample(const s16* src, s16* dst, u32 count, u32 pos, u32 ratio, const s16* coeffs);
+u32 ResampleScalar(const s16* src, s16* dst, u32 count, u32 pos, u32 ratio, const s16* coeffs);
+}  // namespace DSP::HLE::ZeldaMix
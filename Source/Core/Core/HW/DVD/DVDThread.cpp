@@ -3,6 +3,9 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <atomic>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -20,6 +23,7 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -61,6 +65,22 @@ struct ReadRequest
 
 using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+// Data following the most recent sequential reads, which the DVD thread reads while it has no
+// requests to handle. Requests which it covers are answered without reading from the disc.
+// Only accessed by the DVD thread while it is running.
+struct ReadAheadBuffer
+{
+  DiscIO::Partition partition;
+  u64 offset = 0;
+  std::vector<u8> data;
+
+  DiscIO::Partition last_request_partition;
+  u64 last_request_end = std::numeric_limits<u64>::max();
+  bool pending = false;
+};
+
+constexpr u64 READ_AHEAD_SIZE = 0x100000;
+
 static void StartDVDThread();
 static void StopDVDThread();
 
@@ -72,6 +92,8 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
                               DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
 
 static void FinishRead(u64 id, s64 cycles_late);
+static bool ReadFromReadAhead(const ReadRequest& request, u8* out_ptr);
+static void ReadAhead();
 static CoreTiming::EventType* s_finish_read;
 
 static u64 s_next_id = 0;
@@ -84,9 +106,13 @@ static Common::Flag s_dvd_thread_exiting(false);  // Is set by CPU thread
 static Common::SPSCQueue<ReadRequest, false> s_request_queue;
 static Common::SPSCQueue<ReadResult, false> s_result_queue;
 static std::map<u64, ReadResult> s_result_map;
+static ReadAheadBuffer s_read_ahead;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Host time the CPU thread spent waiting for reads the DVD thread hadn't finished in time
+static std::atomic<u64> s_read_wait_time_us{0};
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -107,6 +133,8 @@ static void StartDVDThread()
 {
   ASSERT(!s_dvd_thread.joinable());
   s_dvd_thread_exiting.Clear();
+  // The disc may have changed while the DVD thread wasn't running
+  s_read_ahead = {};
   s_dvd_thread = std::thread(DVDThread);
 }
 
@@ -242,6 +270,11 @@ bool UpdateRunningGameMetadata(const DiscIO::Partition& partition, std::optional
   return true;
 }
 
+u64 GetReadWaitTimeUs()
+{
+  return s_read_wait_time_us.load(std::memory_order_relaxed);
+}
+
 void WaitUntilIdle()
 {
   ASSERT(Core::IsCPUThread());
@@ -317,8 +350,16 @@ static void FinishRead(u64 id, s64 cycles_late)
   {
     while (true)
     {
-      while (!s_result_queue.Pop(result))
-        s_result_queue_expanded.Wait();
+      if (!s_result_queue.Pop(result))
+      {
+        const u64 wait_start_us = Common::Timer::GetTimeUs();
+        do
+        {
+          s_result_queue_expanded.Wait();
+        } while (!s_result_queue.Pop(result));
+        s_read_wait_time_us.fetch_add(Common::Timer::GetTimeUs() - wait_start_us,
+                                      std::memory_order_relaxed);
+      }
 
       if (result.first.id == id)
         break;
@@ -367,19 +408,39 @@ static void DVDThread()
 
   while (true)
   {
-    s_request_queue_expanded.Wait();
+    if (!s_read_ahead.pending)
+      s_request_queue_expanded.Wait();
 
     if (s_dvd_thread_exiting.IsSet())
       return;
 
+    if (s_read_ahead.pending && s_request_queue.Empty())
+    {
+      ReadAhead();
+      continue;
+    }
+
     ReadRequest request;
     while (s_request_queue.Pop(request))
     {
+      TRACE_SCOPE("DVDThread::Read");
       FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
 
       std::vector<u8> buffer(request.length);
-      if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      if (!ReadFromReadAhead(request, buffer.data()) &&
+          !s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      {
         buffer.resize(0);
+      }
+
+      // Only sequential reads are worth reading ahead of
+      if (request.partition == s_read_ahead.last_request_partition &&
+          request.dvd_offset == s_read_ahead.last_request_end)
+      {
+        s_read_ahead.pending = true;
+      }
+      s_read_ahead.last_request_partition = request.partition;
+      s_read_ahead.last_request_end = request.dvd_offset + request.length;
 
       request.realtime_done_us = Common::Timer::GetTimeUs();
 
@@ -391,4 +452,52 @@ static void DVDThread()
     }
   }
 }
+
+static bool ReadFromReadAhead(const ReadRequest& request, u8* out_ptr)
+{
+  if (request.partition != s_read_ahead.partition || request.dvd_offset < s_read_ahead.offset ||
+      request.dvd_offset + request.length > s_read_ahead.offset + s_read_ahead.data.size())
+  {
+    return false;
+  }
+
+  std::memcpy(out_ptr, s_read_ahead.data.data() + (request.dvd_offset - s_read_ahead.offset),
+              request.length);
+  return true;
+}
+
+static void ReadAhead()
+{
+  TRACE_SCOPE("DVDThread::ReadAhead");
+  s_read_ahead.pending = false;
+
+  const DiscIO::Partition& partition = s_read_ahead.last_request_partition;
+  const u64 start = s_read_ahead.last_request_end;
+  const u64 buffer_end = s_read_ahead.offset + s_read_ahead.data.size();
+
+  if (partition == s_read_ahead.partition && start >= s_read_ahead.offset && start <= buffer_end)
+  {
+    if (buffer_end - start >= READ_AHEAD_SIZE / 2)
+      return;
+
+    // Keep the data which hasn't been requested yet
+    s_read_ahead.data.erase(s_read_ahead.data.begin(),
+                            s_read_ahead.data.begin() + (start - s_read_ahead.offset));
+  }
+  else
+  {
+    s_read_ahead.partition = partition;
+    s_read_ahead.data.clear();
+  }
+  s_read_ahead.offset = start;
+
+  const size_t old_size = s_read_ahead.data.size();
+  s_read_ahead.data.resize(READ_AHEAD_SIZE);
+  if (!s_disc->Read(start + old_size, READ_AHEAD_SIZE - old_size,
+                    s_read_ahead.data.data() + old_size, partition))
+  {
+    // Most likely the end of the disc. Reading ahead will be tried again after the next request.
+    s_read_ahead.data.resize(old_size);
+  }
+}
 }  // namespace DVDThread
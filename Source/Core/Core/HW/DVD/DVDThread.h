@@ -59,4 +59,8 @@ void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
 void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                             const DiscIO::Partition& partition, DVDInterface::ReplyType reply_type,
                             s64 ticks_until_completion);
+
+// Total host time the CPU thread waited for reads which weren't done when they were due. Can be
+// called from any thread.
+u64 GetReadWaitTimeUs();
 }  // namespace DVDThread
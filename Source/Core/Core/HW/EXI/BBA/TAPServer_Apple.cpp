@@ -1,8 +1,11 @@
 // Copyright 2020 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+
 #include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
@@ -55,22 +58,16 @@ bool CEXIETHERNET::TAPServerNetworkInterface::Activate()
 
 bool CEXIETHERNET::TAPServerNetworkInterface::SendFrame(const u8* frame, u32 size)
 {
-  {
-    const std::string s = ArrayToString(frame, size, 0x10);
-    INFO_LOG(SP1, "SendFrame %x\n%s\n", size, s.c_str());
-  }
+  DEBUG_LOG_FMT(SP1, "SendFrame {:x}\n{}", size, ArrayToString(frame, size, 0x10));
 
-  auto size16 = u16(size);
-  if (write(fd, &size16, 2) != 2)
-  {
-    ERROR_LOG(SP1, "SendFrame(): could not write size field\n");
-    return false;
-  }
-  int written_bytes = write(fd, frame, size);
-  if (u32(written_bytes) != size)
+  // Send the size field and the frame with a single syscall
+  u16 size16 = u16(size);
+  std::array<iovec, 2> iov{{{&size16, sizeof(size16)}, {const_cast<u8*>(frame), size}}};
+  const ssize_t written_bytes = writev(fd, iov.data(), static_cast<int>(iov.size()));
+  if (written_bytes != static_cast<ssize_t>(sizeof(size16) + size))
   {
-    ERROR_LOG(SP1, "SendFrame(): expected to write %d bytes, instead wrote %d", size,
-              written_bytes);
+    ERROR_LOG_FMT(SP1, "SendFrame(): expected to write {} bytes, instead wrote {}",
+                  sizeof(size16) + size, written_bytes);
     return false;
   }
   else
@@ -108,8 +105,8 @@ void CEXIETHERNET::TAPServerNetworkInterface::ReadThreadHandler()
       }
       else if (readEnabled.IsSet())
       {
-        std::string data_string = ArrayToString(m_eth_ref->mRecvBuffer.get(), read_bytes, 0x10);
-        INFO_LOG(SP1, "Read data: %s", data_string.c_str());
+        DEBUG_LOG_FMT(SP1, "Read data: {}",
+                      ArrayToString(m_eth_ref->mRecvBuffer.get(), read_bytes, 0x10));
         m_eth_ref->mRecvBufferLength = read_bytes;
         m_eth_ref->RecvHandlePacket();
       }
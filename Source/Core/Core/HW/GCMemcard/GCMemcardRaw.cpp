@@ -3,6 +3,7 @@
 
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <memory>
@@ -75,6 +76,7 @@ MemoryCard::MemoryCard(const std::string& filename, int card_index, u16 size_mbi
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
   m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  m_dirty_blocks.resize((m_memory_card_size + Memcard::BLOCK_SIZE - 1) / Memcard::BLOCK_SIZE);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
@@ -190,11 +192,29 @@ void MemoryCard::FlushThread()
       return;
     }
 
+    // Only the blocks written since the last flush are written back, unless the file doesn't
+    // hold a whole card yet (e.g. it was just created)
+    const bool full = file.GetSize() != m_memory_card_size;
+    const std::vector<bool> dirty_blocks = TakeDirtyBlocks(full);
+    for (size_t first = 0; first < dirty_blocks.size();)
     {
-      std::unique_lock l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      if (!dirty_blocks[first])
+      {
+        ++first;
+        continue;
+      }
+
+      size_t last = first + 1;
+      while (last < dirty_blocks.size() && dirty_blocks[last])
+        ++last;
+
+      const u32 offset = static_cast<u32>(first * Memcard::BLOCK_SIZE);
+      const u32 length =
+          std::min(static_cast<u32>(last * Memcard::BLOCK_SIZE), m_memory_card_size) - offset;
+      file.Seek(offset, SEEK_SET);
+      file.WriteBytes(&m_flush_buffer[offset], length);
+      first = last;
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
 
     if (do_exit)
       return;
@@ -205,8 +225,37 @@ void MemoryCard::FlushThread()
   }
 }
 
-void MemoryCard::MakeDirty()
+std::vector<bool> MemoryCard::TakeDirtyBlocks(bool full)
+{
+  std::unique_lock l(m_flush_mutex);
+
+  if (full)
+    std::fill(m_dirty_blocks.begin(), m_dirty_blocks.end(), true);
+
+  for (size_t i = 0; i < m_dirty_blocks.size(); ++i)
+  {
+    if (!m_dirty_blocks[i])
+      continue;
+
+    const size_t offset = i * Memcard::BLOCK_SIZE;
+    memcpy(&m_flush_buffer[offset], &m_memcard_data[offset],
+           std::min<size_t>(Memcard::BLOCK_SIZE, m_memory_card_size - offset));
+  }
+
+  std::vector<bool> dirty_blocks(m_dirty_blocks.size());
+  dirty_blocks.swap(m_dirty_blocks);
+  return dirty_blocks;
+}
+
+void MemoryCard::MakeDirty(u32 address, u32 length)
 {
+  if (length == 0)
+    return;
+
+  const u32 last_block = std::min<u32>((address + length - 1) / Memcard::BLOCK_SIZE,
+                                       static_cast<u32>(m_dirty_blocks.size() - 1));
+  for (u32 block = address / Memcard::BLOCK_SIZE; block <= last_block; ++block)
+    m_dirty_blocks[block] = true;
   m_dirty.Set();
 }
 
@@ -234,8 +283,8 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
   {
     std::unique_lock l(m_flush_mutex);
     memcpy(&m_memcard_data[dest_address], src_address, length);
+    MakeDirty(dest_address, length);
   }
-  MakeDirty();
   return length;
 }
 
@@ -250,8 +299,8 @@ void MemoryCard::ClearBlock(u32 address)
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[address], 0xFF, Memcard::BLOCK_SIZE);
+    MakeDirty(address, Memcard::BLOCK_SIZE);
   }
-  MakeDirty();
 }
 
 void MemoryCard::ClearAll()
@@ -259,8 +308,8 @@ void MemoryCard::ClearAll()
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    MakeDirty(0, m_memory_card_size);
   }
-  MakeDirty();
 }
 
 void MemoryCard::DoState(PointerWrap& p)
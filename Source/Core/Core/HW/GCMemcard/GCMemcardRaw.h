@@ -7,6 +7,8 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
+
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
@@ -22,7 +24,6 @@ public:
   ~MemoryCard();
   static void CheckPath(std::string& memcardPath, const std::string& gameRegion, bool isSlotA);
   void FlushThread();
-  void MakeDirty();
 
   s32 Read(u32 src_address, s32 length, u8* dest_address) override;
   s32 Write(u32 dest_address, s32 length, const u8* src_address) override;
@@ -31,11 +32,18 @@ public:
   void DoState(PointerWrap& p) override;
 
 private:
+  // Must be called with m_flush_mutex held
+  void MakeDirty(u32 address, u32 length);
+  // Copies the dirty blocks to the flush buffer and returns them, or all the blocks if full
+  std::vector<bool> TakeDirtyBlocks(bool full);
+
   std::string m_filename;
   std::unique_ptr<u8[]> m_memcard_data;
   std::unique_ptr<u8[]> m_flush_buffer;
   std::thread m_flush_thread;
   std::mutex m_flush_mutex;
+  // The blocks written since the last flush, protected by m_flush_mutex
+  std::vector<bool> m_dirty_blocks;
   Common::Event m_flush_trigger;
   Common::Flag m_dirty;
 };
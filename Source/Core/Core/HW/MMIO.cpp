@@ -3,7 +3,9 @@
 
 #include "Core/HW/MMIO.h"
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -408,6 +410,27 @@ void WriteHandler<T>::InitializeInvalid()
   ResetMethod(InvalidWrite<T>());
 }
 
+void Mapping::SetAccessCountingEnabled(bool enabled)
+{
+  m_count_accesses = enabled;
+  if (!enabled)
+    m_access_counts.clear();
+}
+
+std::vector<AccessCount> Mapping::GetAccessCounts() const
+{
+  std::vector<AccessCount> counts;
+  counts.reserve(m_access_counts.size());
+  for (const auto& [key, count] : m_access_counts)
+  {
+    counts.push_back(AccessCount{static_cast<u32>(key >> 8), static_cast<u32>(key >> 1 & 0x7f),
+                                 (key & 1) != 0, count});
+  }
+  std::sort(counts.begin(), counts.end(),
+            [](const AccessCount& a, const AccessCount& b) { return a.count > b.count; });
+  return counts;
+}
+
 // Define all the public specializations that are exported in MMIOHandlers.h.
 #define MaybeExtern
 MMIO_PUBLIC_SPECIALIZATIONS()
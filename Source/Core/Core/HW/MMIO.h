@@ -8,6 +8,8 @@
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
@@ -96,6 +98,15 @@ inline u16* HighPart(std::atomic<u32>* ptr)
 }
 }  // namespace Utils
 
+// Number of accesses of one kind to an MMIO register, see Mapping::SetAccessCountingEnabled.
+struct AccessCount
+{
+  u32 address;
+  u32 size;  // In bytes
+  bool write;
+  u64 count;
+};
+
 class Mapping
 {
 public:
@@ -131,15 +142,30 @@ public:
   template <typename Unit>
   Unit Read(u32 addr)
   {
+    if (m_count_accesses)
+      CountAccess(addr, sizeof(Unit), false);
     return GetHandlerForRead<Unit>(addr).Read(addr);
   }
 
   template <typename Unit>
   void Write(u32 addr, Unit val)
   {
+    if (m_count_accesses)
+      CountAccess(addr, sizeof(Unit), true);
     GetHandlerForWrite<Unit>(addr).Write(addr, val);
   }
 
+  // Access counting interface.
+  //
+  // Counts the accesses made through Read() and Write(), to find out which
+  // registers a game hammers. While counting is enabled, the JITs don't
+  // inline MMIO accesses into newly compiled code, so that every access goes
+  // through this interface.
+  void SetAccessCountingEnabled(bool enabled);
+  bool IsAccessCountingEnabled() const { return m_count_accesses; }
+  // Returns the counts gathered since counting was enabled, most accessed first.
+  std::vector<AccessCount> GetAccessCounts() const;
+
   // Handlers access interface.
   //
   // Use when you care more about how to access the MMIO register for an
@@ -158,6 +184,15 @@ public:
   }
 
 private:
+  void CountAccess(u32 addr, u32 size, bool write)
+  {
+    ++m_access_counts[u64(addr) << 8 | size << 1 | u32(write)];
+  }
+
+  bool m_count_accesses = false;
+  // (address << 8 | size << 1 | write) -> number of accesses
+  std::unordered_map<u64, u64> m_access_counts;
+
   // These arrays contain the handlers for each MMIO access type: read/write
   // to 8/16/32 bits. They are indexed using the UniqueID(addr) function
   // defined earlier, which maps an MMIO address to a unique ID by using the
@@ -12,6 +12,8 @@
 #include <array>
 #include <cstring>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -282,7 +284,7 @@ void Init()
     region.active = true;
     mem_size += region.size;
   }
-  g_arena.GrabSHMSegment(mem_size);
+  g_arena.GrabSHMSegment(mem_size, Config::Get(Config::MAIN_LARGE_PAGES));
 
   // Create an anonymous view of the physical memory
   for (const PhysicalMemoryRegion& region : s_physical_regions)
@@ -396,17 +398,188 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+static StateRAMBase* s_state_ram_base = nullptr;
+static u64 s_next_state_ram_base_id = 1;
+static bool s_state_load_changed_ram = false;
+static bool s_state_load_changed_untracked = false;
+static std::vector<PhysicalRange> s_state_load_changed_ranges;
+
+void CaptureStateRAMBase(StateRAMBase* base)
+{
+  base->id = s_next_state_ram_base_id++;
+  base->ram.assign(m_pRAM, m_pRAM + GetRamSize());
+  if (m_pEXRAM)
+    base->exram.assign(m_pEXRAM, m_pEXRAM + GetExRamSize());
+  else
+    base->exram.clear();
+}
+
+void SetStateRAMBase(StateRAMBase* base)
+{
+  s_state_ram_base = base;
+}
+
+bool DidStateLoadChangeRAM()
+{
+  return s_state_load_changed_ram;
+}
+
+const std::vector<PhysicalRange>* GetStateLoadChangedRanges()
+{
+  return s_state_load_changed_untracked ? nullptr : &s_state_load_changed_ranges;
+}
+
+// Physical address of the start of the given memory, or nullopt if it isn't MEM1 or MEM2
+static std::optional<u32> GetStatePhysicalAddress(const u8* ram)
+{
+  if (ram == m_pRAM)
+    return 0;
+  if (ram == m_pEXRAM)
+    return 0x10000000;
+  return std::nullopt;
+}
+
+// Copies the page from src unless the live memory already matches
+static void LoadStatePage(u8* dest, const u8* src, u32 size, std::optional<u32> physical_address)
+{
+  if (std::memcmp(dest, src, size) == 0)
+    return;
+
+  std::memcpy(dest, src, size);
+  s_state_load_changed_ram = true;
+
+  if (!physical_address)
+  {
+    s_state_load_changed_untracked = true;
+    return;
+  }
+
+  // Pages are mostly written in order, so neighbouring ones are merged
+  if (!s_state_load_changed_ranges.empty())
+  {
+    PhysicalRange& last = s_state_load_changed_ranges.back();
+    if (last.address + last.length == *physical_address)
+    {
+      last.length += size;
+      return;
+    }
+  }
+
+  s_state_load_changed_ranges.push_back({*physical_address, size});
+}
+
+// Like p.DoArray, but loading leaves the pages that didn't change untouched. ram can be a
+// page within MEM1/MEM2 when base points to the start of that memory.
+static void DoRAMArray(PointerWrap& p, u8* ram, u32 size, const u8* base = nullptr)
+{
+  if (p.GetMode() != PointerWrap::MODE_READ)
+  {
+    p.DoArray(ram, size);
+    return;
+  }
+
+  std::optional<u32> physical_address = GetStatePhysicalAddress(base ? base : ram);
+  if (physical_address)
+    *physical_address += static_cast<u32>(ram - (base ? base : ram));
+
+  const u8* src = *p.ptr;
+  for (u32 offset = 0; offset < size; offset += STATE_PAGE_SIZE)
+  {
+    const u32 length = std::min(STATE_PAGE_SIZE, size - offset);
+    LoadStatePage(ram + offset, src + offset, length,
+                  physical_address ? std::make_optional(*physical_address + offset) : std::nullopt);
+  }
+
+  *p.ptr += size;
+}
+
+// Stores the indices of the pages that differ from the base, followed by their contents.
+// Loading restores every other page from the base.
+static void DoRAMDelta(PointerWrap& p, u8* ram, u32 size, const std::vector<u8>& base,
+                       std::vector<u32>& dirty_pages)
+{
+  if (base.size() != size)
+  {
+    p.SetMode(PointerWrap::MODE_MEASURE);
+    return;
+  }
+
+  const u32 num_pages = size / STATE_PAGE_SIZE;
+
+  if (p.GetMode() == PointerWrap::MODE_MEASURE)
+  {
+    dirty_pages.clear();
+    for (u32 i = 0; i < num_pages; ++i)
+    {
+      const u32 offset = i * STATE_PAGE_SIZE;
+      if (std::memcmp(ram + offset, base.data() + offset, STATE_PAGE_SIZE) != 0)
+        dirty_pages.push_back(i);
+    }
+  }
+
+  p.Do(dirty_pages);
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    auto dirty = dirty_pages.begin();
+    for (u32 i = 0; i < num_pages; ++i)
+    {
+      if (dirty != dirty_pages.end() && *dirty == i)
+      {
+        ++dirty;
+        continue;
+      }
+
+      const u32 offset = i * STATE_PAGE_SIZE;
+      const std::optional<u32> physical_address = GetStatePhysicalAddress(ram);
+      LoadStatePage(ram + offset, base.data() + offset, STATE_PAGE_SIZE,
+                    physical_address ? std::make_optional(*physical_address + offset) :
+                                       std::nullopt);
+    }
+  }
+
+  for (u32 page : dirty_pages)
+  {
+    if (page >= num_pages)
+    {
+      p.SetMode(PointerWrap::MODE_MEASURE);
+      return;
+    }
+
+    DoRAMArray(p, ram + page * STATE_PAGE_SIZE, STATE_PAGE_SIZE, ram);
+  }
+}
+
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
-  p.DoArray(m_pRAM, GetRamSize());
-  p.DoArray(m_pL1Cache, GetL1CacheSize());
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    s_state_load_changed_ram = false;
+    s_state_load_changed_untracked = false;
+    s_state_load_changed_ranges.clear();
+  }
+  if (s_state_ram_base)
+    DoRAMDelta(p, m_pRAM, GetRamSize(), s_state_ram_base->ram, s_state_ram_base->dirty_ram_pages);
+  else
+    DoRAMArray(p, m_pRAM, GetRamSize());
+  DoRAMArray(p, m_pL1Cache, GetL1CacheSize());
   p.DoMarker("Memory RAM");
   if (m_pFakeVMEM)
-    p.DoArray(m_pFakeVMEM, GetFakeVMemSize());
+    DoRAMArray(p, m_pFakeVMEM, GetFakeVMemSize());
   p.DoMarker("Memory FakeVMEM");
   if (wii)
-    p.DoArray(m_pEXRAM, GetExRamSize());
+  {
+    if (s_state_ram_base)
+    {
+      DoRAMDelta(p, m_pEXRAM, GetExRamSize(), s_state_ram_base->exram,
+                 s_state_ram_base->dirty_exram_pages);
+    }
+    else
+    {
+      DoRAMArray(p, m_pEXRAM, GetExRamSize());
+    }
+  }
   p.DoMarker("Memory EXRAM");
 }
 
@@ -466,18 +639,20 @@ void Clear()
     memset(m_pEXRAM, 0, GetExRamSize());
 }
 
-static inline u8* GetPointerForRange(u32 address, size_t size)
+u8* GetPointerForRange(u32 address, size_t size)
 {
-  // Make sure we don't have a range spanning 2 separate banks
-  if (size >= GetExRamSizeReal())
-    return nullptr;
+  address &= 0x3FFFFFFF;
+  if (m_pRAM && address < GetRamSizeReal() && size <= GetRamSizeReal() - address)
+    return m_pRAM + address;
 
-  // Check that the beginning and end of the range are valid
-  u8* pointer = GetPointer(address);
-  if (!pointer || !GetPointer(address + u32(size) - 1))
-    return nullptr;
+  if (m_pEXRAM && (address >> 28) == 0x1)
+  {
+    const u32 offset = address & 0x0fffffff;
+    if (offset < GetExRamSizeReal() && size <= GetExRamSizeReal() - offset)
+      return m_pEXRAM + (address & GetExRamMask());
+  }
 
-  return pointer;
+  return nullptr;
 }
 
 void CopyFromEmu(void* data, u32 address, size_t size)
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
@@ -66,6 +67,39 @@ bool InitFastmemArena();
 void ShutdownFastmemArena();
 void DoState(PointerWrap& p);
 
+// Copy of MEM1/MEM2 that incremental savestates are relative to. While one is set with
+// SetStateRAMBase, DoState only stores the 4 KiB pages of MEM1/MEM2 that differ from it.
+// The pages are compared in MODE_MEASURE and the result is reused by the following MODE_WRITE.
+struct StateRAMBase
+{
+  // Changes with every capture, 0 while nothing has been captured
+  u64 id = 0;
+  std::vector<u8> ram;
+  std::vector<u8> exram;
+
+  std::vector<u32> dirty_ram_pages;
+  std::vector<u32> dirty_exram_pages;
+};
+
+constexpr u32 STATE_PAGE_SIZE = 0x1000;
+
+void CaptureStateRAMBase(StateRAMBase* base);
+void SetStateRAMBase(StateRAMBase* base);
+
+// Loading a state only writes the pages of emulated memory that differ from the live contents.
+// Returns whether the last load wrote any.
+bool DidStateLoadChangeRAM();
+
+struct PhysicalRange
+{
+  u32 address;
+  u32 length;
+};
+
+// The MEM1/MEM2 ranges the last state load wrote to, by physical address. Writes to the L1 cache
+// or fake VMEM have no such range, they make this return nullptr instead.
+const std::vector<PhysicalRange>* GetStateLoadChangedRanges();
+
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
 void Clear();
@@ -74,6 +108,9 @@ void Clear();
 // emulated hardware outside the CPU. Use "Device_" prefix.
 std::string GetString(u32 em_address, size_t size = 0);
 u8* GetPointer(u32 address);
+// Like GetPointer, but checks that the whole range is backed by MEM1 or MEM2 and returns nullptr
+// instead of raising a panic alert otherwise.
+u8* GetPointerForRange(u32 address, size_t size);
 void CopyFromEmu(void* data, u32 address, size_t size);
 void CopyToEmu(u32 address, const void* data, size_t size);
 void Memset(u32 address, u8 value, size_t size);
@@ -16,6 +16,8 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Timer.h"
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/MMIO.h"
@@ -102,6 +104,12 @@ struct SSIChannel
   std::unique_ptr<ISIDevice> device;
 
   bool has_recent_device_change = false;
+  // With late latching, the poll has happened but GetData waits for the game to read the input
+  bool latch_pending = false;
+
+  // Host time of the last GetData, until the game reads the sample (not saved)
+  u64 sample_time_us = 0;
+  bool sample_unread = false;
 };
 
 // SI Poll: Controls how often a device is polled
@@ -212,6 +220,9 @@ static USIStatusReg s_status_reg;
 static USIEXIClockCount s_exi_clock_count;
 static std::array<u8, 128> s_si_buffer;
 
+static std::atomic<u64> s_input_delay_total_us;
+static std::atomic<u64> s_input_delay_samples;
+
 static void SetNoResponse(u32 channel)
 {
   // raise the NO RESPONSE error
@@ -336,6 +347,7 @@ void DoState(PointerWrap& p)
     p.Do(s_channel[i].in_lo.hex);
     p.Do(s_channel[i].out.hex);
     p.Do(s_channel[i].has_recent_device_change);
+    p.Do(s_channel[i].latch_pending);
 
     std::unique_ptr<ISIDevice>& device = s_channel[i].device;
     SIDevices type = device->GetDeviceType();
@@ -400,6 +412,8 @@ void Init()
     s_channel[i].in_hi.hex = 0;
     s_channel[i].in_lo.hex = 0;
     s_channel[i].has_recent_device_change = false;
+    s_channel[i].latch_pending = false;
+    s_channel[i].sample_unread = false;
 
     if (Movie::IsMovieActive())
     {
@@ -451,6 +465,55 @@ void Shutdown()
   GBAConnectionWaiter_Shutdown();
 }
 
+// Returns whether the device has new data
+static bool SampleChannel(u32 channel)
+{
+  SSIChannel& c = s_channel[channel];
+  c.latch_pending = false;
+  c.sample_time_us = Common::Timer::GetTimeUs();
+  c.sample_unread = true;
+  return c.device->GetData(c.in_hi.hex, c.in_lo.hex);
+}
+
+// Takes the samples whose poll was deferred until the game reads an input buffer
+static void LatchPendingChannels()
+{
+  if (std::none_of(s_channel.begin(), s_channel.end(),
+                   [](const SSIChannel& c) { return c.latch_pending; }))
+  {
+    return;
+  }
+
+  NetPlay::SetSIPollBatching(true);
+
+  // Devices polled in the background already have their latest state from the input polling
+  // thread, this only updates the rest
+  g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
+  g_controller_interface.UpdateInput();
+
+  for (u32 i = 0; i < u32(MAX_SI_CHANNELS); ++i)
+  {
+    if (s_channel[i].latch_pending)
+      SampleChannel(i);
+  }
+
+  NetPlay::SetSIPollBatching(false);
+}
+
+static void OnInputRead(u32 channel)
+{
+  LatchPendingChannels();
+
+  SSIChannel& c = s_channel[channel];
+  if (!c.sample_unread)
+    return;
+
+  c.sample_unread = false;
+  s_input_delay_total_us.fetch_add(Common::Timer::GetTimeUs() - c.sample_time_us,
+                                   std::memory_order_relaxed);
+  s_input_delay_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
 void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
 {
   // Register SI buffer direct accesses.
@@ -499,6 +562,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
                    MMIO::DirectWrite<u32>(&s_channel[i].out.hex));
     mmio->Register(base | (SI_CHANNEL_0_IN_HI + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](u32) {
+                     OnInputRead(i);
                      s_status_reg.hex &= ~(1U << rdst_bit);
                      UpdateInterrupts();
                      return s_channel[i].in_hi.hex;
@@ -506,6 +570,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
                    MMIO::DirectWrite<u32>(&s_channel[i].in_hi.hex));
     mmio->Register(base | (SI_CHANNEL_0_IN_LO + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](u32) {
+                     OnInputRead(i);
                      s_status_reg.hex &= ~(1U << rdst_bit);
                      UpdateInterrupts();
                      return s_channel[i].in_lo.hex;
@@ -646,6 +711,7 @@ static void ChangeDeviceDeterministic(SIDevices device, int channel)
   s_channel[channel].out.hex = 0;
   s_channel[channel].in_hi.hex = 0;
   s_channel[channel].in_lo.hex = 0;
+  s_channel[channel].latch_pending = false;
 
   SetNoResponse(channel);
 
@@ -680,14 +746,33 @@ void UpdateDevices()
   g_controller_interface.UpdateInput();
 
   // Update channels and set the status bit if there's new data
-  s_status_reg.RDST0 =
-      !!s_channel[0].device->GetData(s_channel[0].in_hi.hex, s_channel[0].in_lo.hex);
-  s_status_reg.RDST1 =
-      !!s_channel[1].device->GetData(s_channel[1].in_hi.hex, s_channel[1].in_lo.hex);
-  s_status_reg.RDST2 =
-      !!s_channel[2].device->GetData(s_channel[2].in_hi.hex, s_channel[2].in_lo.hex);
-  s_status_reg.RDST3 =
-      !!s_channel[3].device->GetData(s_channel[3].in_hi.hex, s_channel[3].in_lo.hex);
+  const bool late_latch = Config::GetSnapshot().late_input_latch;
+  for (u32 i = 0; i < u32(MAX_SI_CHANNELS); ++i)
+  {
+    // A deferred sample the game never read is still taken, so that every poll gets exactly one
+    // sample. That keeps netplay and movies in sync whatever each side has set.
+    if (s_channel[i].latch_pending)
+      SampleChannel(i);
+
+    bool new_data;
+    if (late_latch && GetDeviceType(i) == SIDEVICE_GC_CONTROLLER)
+    {
+      // The GC controller always reports new data, the sample itself is taken once the game reads
+      // the input buffer
+      s_channel[i].latch_pending = true;
+      new_data = true;
+    }
+    else
+    {
+      new_data = SampleChannel(i);
+    }
+
+    const u32 rdst_bit = 8 * (3 - i) + 5;
+    if (new_data)
+      s_status_reg.hex |= 1U << rdst_bit;
+    else
+      s_status_reg.hex &= ~(1U << rdst_bit);
+  }
 
   UpdateInterrupts();
 
@@ -708,4 +793,10 @@ u32 GetPollXLines()
   return s_poll.X;
 }
 
+InputDelayStats GetInputDelayStats()
+{
+  return {s_input_delay_total_us.load(std::memory_order_relaxed),
+          s_input_delay_samples.load(std::memory_order_relaxed)};
+}
+
 }  // namespace SerialInterface
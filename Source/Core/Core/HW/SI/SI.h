@@ -45,4 +45,14 @@ SIDevices GetDeviceType(int channel);
 
 u32 GetPollXLines();
 
+struct InputDelayStats
+{
+  // Host time from sampling a device to the game reading the sample, summed over the samples read
+  u64 total_us = 0;
+  u64 samples = 0;
+};
+
+// Totals since Dolphin was started, can be called from any thread
+InputDelayStats GetInputDelayStats();
+
 }  // namespace SerialInterface
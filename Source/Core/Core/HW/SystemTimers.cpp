@@ -44,6 +44,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 
 #include "Core/HW/SystemTimers.h"
 
+#include <atomic>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
@@ -52,6 +53,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -70,7 +72,6 @@ namespace SystemTimers
 namespace
 {
 CoreTiming::EventType* et_Dec;
-CoreTiming::EventType* et_VI;
 CoreTiming::EventType* et_AudioDMA;
 CoreTiming::EventType* et_DSP;
 CoreTiming::EventType* et_IPC_HLE;
@@ -100,7 +101,7 @@ std::mutex s_emu_to_real_time_mutex;
 
 // How much time was spent sleeping since the emulator started. Note: this does not need to be reset
 // at initialization (or ever), since only the "derivative" of that value really matters.
-u64 s_time_spent_sleeping;
+std::atomic<u64> s_time_spent_sleeping{0};
 
 // DSP/CPU timeslicing.
 void DSPCallback(u64 userdata, s64 cyclesLate)
@@ -127,12 +128,6 @@ void IPC_HLE_UpdateCallback(u64 userdata, s64 cyclesLate)
   }
 }
 
-void VICallback(u64 userdata, s64 cyclesLate)
-{
-  VideoInterface::Update(CoreTiming::GetTicks() - cyclesLate);
-  CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerHalfLine() - cyclesLate, et_VI);
-}
-
 void DecrementerCallback(u64 userdata, s64 cyclesLate)
 {
   PowerPC::ppcState.spr[SPR_DEC] = 0xFFFFFFFF;
@@ -173,7 +168,10 @@ void ThrottleCallback(u64 last_time, s64 cyclesLate)
 
   s64 diff = last_time - time;
   const SConfig& config = SConfig::GetInstance();
-  bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled();
+  // Fast frame dumps take their timing from the emulated ticks, so nothing needs to be throttled.
+  const bool fast_frame_dumps = config.m_DumpFrames && Config::GetSnapshot().fast_frame_dumps;
+  bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled() &&
+                       !fast_frame_dumps;
   u32 next_event = GetTicksPerSecond() / 1000;
 
   {
@@ -271,6 +269,11 @@ double GetEstimatedEmulationPerformance()
   return delta_us == 0 ? DBL_MAX : emulated_us / delta_us;
 }
 
+u64 GetTimeSpentSleepingUs()
+{
+  return s_time_spent_sleeping.load(std::memory_order_relaxed);
+}
+
 // split from Init to break a circular dependency between VideoInterface::Init and
 // SystemTimers::Init
 void PreInit()
@@ -320,14 +323,12 @@ void Init()
   CoreTiming::SetFakeDecStartTicks(CoreTiming::GetTicks());
 
   et_Dec = CoreTiming::RegisterEvent("DecCallback", DecrementerCallback);
-  et_VI = CoreTiming::RegisterEvent("VICallback", VICallback);
   et_DSP = CoreTiming::RegisterEvent("DSPCallback", DSPCallback);
   et_AudioDMA = CoreTiming::RegisterEvent("AudioDMACallback", AudioDMACallback);
   et_IPC_HLE = CoreTiming::RegisterEvent("IPC_HLE_UpdateCallback", IPC_HLE_UpdateCallback);
   et_PatchEngine = CoreTiming::RegisterEvent("PatchEngine", PatchEngineCallback);
   et_Throttle = CoreTiming::RegisterEvent("Throttle", ThrottleCallback);
 
-  CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerHalfLine(), et_VI);
   CoreTiming::ScheduleEvent(0, et_DSP);
   CoreTiming::ScheduleEvent(s_audio_dma_period, et_AudioDMA);
   CoreTiming::ScheduleEvent(0, et_Throttle, Common::Timer::GetTimeUs());
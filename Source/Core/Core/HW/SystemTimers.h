@@ -70,6 +70,10 @@ s64 GetLocalTimeRTCOffset();
 // - 2.0: the emulator is running at 200% speed (or 100% speed but sleeping half of the time).
 double GetEstimatedEmulationPerformance();
 
+// Host time the CPU thread has spent sleeping in the frame limiter since Dolphin was started. Can
+// be called from any thread.
+u64 GetTimeSpentSleepingUs();
+
 }  // namespace SystemTimers
 
 inline namespace SystemTimersLiterals
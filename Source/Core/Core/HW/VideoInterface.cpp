@@ -13,6 +13,7 @@
 #include "Common/Config/Config.h"
 #include "Common/Logging/Log.h"
 
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Config/SYSCONFSettings.h"
@@ -69,17 +70,29 @@ static constexpr std::array<u32, 2> s_clock_freqs{{
     54000000,
 }};
 
-static u64 s_ticks_last_line_start;  // number of ticks when the current full scanline started
-static u32 s_half_line_count;        // number of halflines that have occurred for this full frame
+// Update only runs on the half-lines where something happens (field boundaries, SI polls, display
+// interrupts). The half-lines in between are counted when the next one of those is reached or
+// when the beam position is read, based on the time that has passed since s_half_line_count was
+// last advanced.
+static u64 s_ticks_last_half_line_start;  // number of ticks when s_half_line_count started
+static u32 s_half_line_count;  // number of halflines that have occurred for this full frame
 static u32 s_half_line_of_next_si_poll;  // halfline when next SI poll results should be available
 static constexpr u32 num_half_lines_for_si_poll = (7 * 2) + 1;  // this is how long an SI poll takes
 
+static CoreTiming::EventType* s_event_type_update;
+
 // below indexes are 0-based
 static u32 s_even_field_first_hl;  // index first halfline of the even field
 static u32 s_odd_field_first_hl;   // index first halfline of the odd field
 static u32 s_even_field_last_hl;   // index last halfline of the even field
 static u32 s_odd_field_last_hl;    // index last halfline of the odd field
 
+static u32 GetHalfLinesPerEvenField();
+static u32 GetHalfLinesPerOddField();
+static u32 GetCurrentHalfLine(u64* ticks_into_half_line);
+static void CatchUpHalfLines(u64 ticks);
+static void ScheduleNextUpdate();
+
 void DoState(PointerWrap& p)
 {
   p.DoPOD(m_VerticalTimingRegister);
@@ -104,7 +117,7 @@ void DoState(PointerWrap& p)
   p.Do(m_DTVStatus);
   p.Do(m_FBWidth);
   p.Do(m_BorderHBlank);
-  p.Do(s_ticks_last_line_start);
+  p.Do(s_ticks_last_half_line_start);
   p.Do(s_half_line_count);
   p.Do(s_half_line_of_next_si_poll);
 
@@ -187,15 +200,23 @@ void Preset(bool _bNTSC)
   m_FBWidth.Hex = 0;
   m_BorderHBlank.Hex = 0;
 
-  s_ticks_last_line_start = 0;
+  s_ticks_last_half_line_start = CoreTiming::GetTicks();
   s_half_line_count = 0;
   s_half_line_of_next_si_poll = num_half_lines_for_si_poll;  // first sampling starts at vsync
 
   UpdateParameters();
+  ScheduleNextUpdate();
+}
+
+static void UpdateCallback(u64 userdata, s64 cycles_late)
+{
+  Update(CoreTiming::GetTicks() - cycles_late);
+  ScheduleNextUpdate();
 }
 
 void Init()
 {
+  s_event_type_update = CoreTiming::RegisterEvent("VICallback", UpdateCallback);
   Preset(true);
 }
 
@@ -207,7 +228,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
     u16* ptr;
   };
 
-  std::array<MappedVar, 46> directly_mapped_vars{{
+  std::array<MappedVar, 42> directly_mapped_vars{{
       {VI_VERTICAL_TIMING, &m_VerticalTimingRegister.Hex},
       {VI_HORIZONTAL_TIMING_0_HI, &m_HTiming0.Hi},
       {VI_HORIZONTAL_TIMING_0_LO, &m_HTiming0.Lo},
@@ -225,10 +246,6 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
       {VI_FB_RIGHT_TOP_LO, &m_3DFBInfoTop.Lo},
       {VI_FB_LEFT_BOTTOM_LO, &m_XFBInfoBottom.Lo},
       {VI_FB_RIGHT_BOTTOM_LO, &m_3DFBInfoBottom.Lo},
-      {VI_PRERETRACE_LO, &m_InterruptRegister[0].Lo},
-      {VI_POSTRETRACE_LO, &m_InterruptRegister[1].Lo},
-      {VI_DISPLAY_INTERRUPT_2_LO, &m_InterruptRegister[2].Lo},
-      {VI_DISPLAY_INTERRUPT_3_LO, &m_InterruptRegister[3].Lo},
       {VI_DISPLAY_LATCH_0_HI, &m_LatchRegister[0].Hi},
       {VI_DISPLAY_LATCH_0_LO, &m_LatchRegister[0].Lo},
       {VI_DISPLAY_LATCH_1_HI, &m_LatchRegister[1].Hi},
@@ -279,8 +296,11 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
   {
     mmio->Register(base | mapped_var.addr, MMIO::DirectRead<u16>(mapped_var.ptr),
                    MMIO::ComplexWrite<u16>([mapped_var](u32, u16 val) {
+                     // Count the half-lines so far with the old timings
+                     CatchUpHalfLines(CoreTiming::GetTicks());
                      *mapped_var.ptr = val;
                      UpdateParameters();
+                     ScheduleNextUpdate();
                    }));
   }
 
@@ -313,7 +333,8 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
   // MMIOs with unimplemented writes that trigger warnings.
   mmio->Register(
       base | VI_VERTICAL_BEAM_POSITION,
-      MMIO::ComplexRead<u16>([](u32) { return 1 + (s_half_line_count) / 2; }),
+      MMIO::ComplexRead<u16>(
+          [](u32) { return static_cast<u16>(1 + GetCurrentHalfLine(nullptr) / 2); }),
       MMIO::ComplexWrite<u16>([](u32, u16 val) {
         WARN_LOG_FMT(
             VIDEOINTERFACE,
@@ -321,9 +342,11 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
       }));
   mmio->Register(
       base | VI_HORIZONTAL_BEAM_POSITION, MMIO::ComplexRead<u16>([](u32) {
-        u16 value = static_cast<u16>(1 + m_HTiming0.HLW *
-                                             (CoreTiming::GetTicks() - s_ticks_last_line_start) /
-                                             (GetTicksPerHalfLine()));
+        u64 ticks_into_line;
+        if (GetCurrentHalfLine(&ticks_into_line) & 1)
+          ticks_into_line += GetTicksPerHalfLine();
+        u16 value =
+            static_cast<u16>(1 + m_HTiming0.HLW * ticks_into_line / (GetTicksPerHalfLine()));
         return std::clamp<u16>(value, 1, m_HTiming0.HLW * 2);
       }),
       MMIO::ComplexWrite<u16>([](u32, u16 val) {
@@ -333,29 +356,54 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
             val);
       }));
 
+  // The horizontal position of a display interrupt decides which half-line it fires on.
+  static constexpr std::array<u32, 4> interrupt_lo_addrs{{
+      VI_PRERETRACE_LO,
+      VI_POSTRETRACE_LO,
+      VI_DISPLAY_INTERRUPT_2_LO,
+      VI_DISPLAY_INTERRUPT_3_LO,
+  }};
+  for (size_t i = 0; i < interrupt_lo_addrs.size(); i++)
+  {
+    mmio->Register(base | interrupt_lo_addrs[i], MMIO::DirectRead<u16>(&m_InterruptRegister[i].Lo),
+                   MMIO::ComplexWrite<u16>([i](u32, u16 val) {
+                     m_InterruptRegister[i].Lo = val;
+                     CatchUpHalfLines(CoreTiming::GetTicks());
+                     ScheduleNextUpdate();
+                   }));
+  }
+
   // The following MMIOs are interrupts related and update interrupt status
   // on writes.
   mmio->Register(base | VI_PRERETRACE_HI, MMIO::DirectRead<u16>(&m_InterruptRegister[0].Hi),
                  MMIO::ComplexWrite<u16>([](u32, u16 val) {
                    m_InterruptRegister[0].Hi = val;
                    UpdateInterrupts();
+                   CatchUpHalfLines(CoreTiming::GetTicks());
+                   ScheduleNextUpdate();
                  }));
   mmio->Register(base | VI_POSTRETRACE_HI, MMIO::DirectRead<u16>(&m_InterruptRegister[1].Hi),
                  MMIO::ComplexWrite<u16>([](u32, u16 val) {
                    m_InterruptRegister[1].Hi = val;
                    UpdateInterrupts();
+                   CatchUpHalfLines(CoreTiming::GetTicks());
+                   ScheduleNextUpdate();
                  }));
   mmio->Register(base | VI_DISPLAY_INTERRUPT_2_HI,
                  MMIO::DirectRead<u16>(&m_InterruptRegister[2].Hi),
                  MMIO::ComplexWrite<u16>([](u32, u16 val) {
                    m_InterruptRegister[2].Hi = val;
                    UpdateInterrupts();
+                   CatchUpHalfLines(CoreTiming::GetTicks());
+                   ScheduleNextUpdate();
                  }));
   mmio->Register(base | VI_DISPLAY_INTERRUPT_3_HI,
                  MMIO::DirectRead<u16>(&m_InterruptRegister[3].Hi),
                  MMIO::ComplexWrite<u16>([](u32, u16 val) {
                    m_InterruptRegister[3].Hi = val;
                    UpdateInterrupts();
+                   CatchUpHalfLines(CoreTiming::GetTicks());
+                   ScheduleNextUpdate();
                  }));
 
   // Unknown anti-aliasing related MMIO register: puts a warning on log and
@@ -734,6 +782,83 @@ u32 GetTicksPerField()
   return GetTicksPerEvenField();
 }
 
+static u32 GetHalfLinesPerFrame()
+{
+  return std::max(GetHalfLinesPerEvenField() + GetHalfLinesPerOddField(), 1u);
+}
+
+// Returns the half-line being scanned out right now, and optionally how far into it the beam is
+static u32 GetCurrentHalfLine(u64* ticks_into_half_line)
+{
+  const u64 ticks_per_half_line = std::max(GetTicksPerHalfLine(), 1u);
+  const u64 elapsed = CoreTiming::GetTicks() - s_ticks_last_half_line_start;
+  if (ticks_into_half_line)
+    *ticks_into_half_line = elapsed % ticks_per_half_line;
+  return static_cast<u32>((s_half_line_count + elapsed / ticks_per_half_line) %
+                          GetHalfLinesPerFrame());
+}
+
+// Advances s_half_line_count by the half-lines which have fully gone by at the given time
+static void CatchUpHalfLines(u64 ticks)
+{
+  if (ticks <= s_ticks_last_half_line_start)
+    return;
+
+  const u64 ticks_per_half_line = std::max(GetTicksPerHalfLine(), 1u);
+  const u64 elapsed = (ticks - s_ticks_last_half_line_start) / ticks_per_half_line;
+  s_half_line_count = static_cast<u32>((s_half_line_count + elapsed) % GetHalfLinesPerFrame());
+  s_ticks_last_half_line_start += elapsed * ticks_per_half_line;
+}
+
+// Returns how many half-lines after s_ticks_last_half_line_start Update next has work to do.
+// Update handles the half-line that has just ended, so work on s_half_line_count itself is one
+// half-line away.
+static u32 GetHalfLinesUntilNextUpdate()
+{
+  const u32 half_lines_per_frame = GetHalfLinesPerFrame();
+  const u32 current = s_half_line_count % half_lines_per_frame;
+  u32 result = half_lines_per_frame;
+
+  const auto consider = [&](u32 half_line) {
+    if (half_line < half_lines_per_frame)
+    {
+      result =
+          std::min(result, (half_line + half_lines_per_frame - current) % half_lines_per_frame + 1);
+    }
+  };
+
+  // Field boundaries
+  consider(0);
+  consider(GetHalfLinesPerEvenField());
+  // XFB scanout
+  consider(s_even_field_first_hl);
+  consider(s_odd_field_first_hl);
+  consider(s_even_field_last_hl);
+  consider(s_odd_field_last_hl);
+  consider(s_half_line_of_next_si_poll);
+
+  // Display interrupts are raised when the half-line before theirs ends
+  for (const UVIInterruptRegister& reg : m_InterruptRegister)
+  {
+    if (reg.VCT == 0)
+      continue;
+    const u32 target_halfline = 2 * (reg.VCT - 1) + ((reg.HCT > m_HTiming0.HLW) ? 1 : 0);
+    if (target_halfline < half_lines_per_frame)
+      consider((target_halfline + half_lines_per_frame - 1) % half_lines_per_frame);
+  }
+
+  return result;
+}
+
+static void ScheduleNextUpdate()
+{
+  const u64 next_update = s_ticks_last_half_line_start +
+                          static_cast<u64>(GetHalfLinesUntilNextUpdate()) * GetTicksPerHalfLine();
+  CoreTiming::RemoveEvent(s_event_type_update);
+  CoreTiming::ScheduleEvent(std::max<s64>(next_update - CoreTiming::GetTicks(), 0),
+                            s_event_type_update);
+}
+
 static void LogField(FieldType field, u32 xfb_address)
 {
   static constexpr std::array<const char*, 2> field_type_names{{"Odd", "Even"}};
@@ -823,7 +948,7 @@ static void BeginField(FieldType field, u64 ticks)
 {
   // Outputting the frame at the beginning of scanout reduces latency. This assumes the game isn't
   // going to change the VI registers while a frame is scanning out.
-  if (Config::Get(Config::GFX_HACK_EARLY_XFB_OUTPUT))
+  if (Config::GetSnapshot().early_xfb_output)
     OutputField(field, ticks);
 }
 
@@ -833,7 +958,7 @@ static void EndField(FieldType field, u64 ticks)
   // until the end so the last register values are used. This still isn't accurate, but it does
   // produce more acceptable results in some problematic cases.
   // Currently, this is only known to be necessary to eliminate flickering in WWE Crush Hour.
-  if (!Config::Get(Config::GFX_HACK_EARLY_XFB_OUTPUT))
+  if (!Config::GetSnapshot().early_xfb_output)
     OutputField(field, ticks);
 
   Core::VideoThrottle();
@@ -844,6 +969,10 @@ static void EndField(FieldType field, u64 ticks)
 // Run when: When a frame is scanned (progressive/interlace)
 void Update(u64 ticks)
 {
+  // Skip over the half-lines where nothing happened, up to the one which has just ended
+  if (ticks > GetTicksPerHalfLine())
+    CatchUpHalfLines(ticks - GetTicksPerHalfLine());
+
   // Movie's frame counter should be updated before actually rendering the frame,
   // in case frame counter display is enabled
 
@@ -884,6 +1013,7 @@ void Update(u64 ticks)
     Core::UpdateInputGate(!SConfig::GetInstance().m_BackgroundInput,
                           SConfig::GetInstance().bLockCursor);
     SerialInterface::UpdateDevices();
+    Core::OnInputPoll();
     s_half_line_of_next_si_poll += 2 * SerialInterface::GetPollXLines();
   }
 
@@ -903,15 +1033,11 @@ void Update(u64 ticks)
   // the beginning of a new full-line, update the timer
 
   s_half_line_count++;
-  if (s_half_line_count == GetHalfLinesPerEvenField() + GetHalfLinesPerOddField())
+  if (s_half_line_count >= GetHalfLinesPerEvenField() + GetHalfLinesPerOddField())
   {
     s_half_line_count = 0;
   }
-
-  if (!(s_half_line_count & 1))
-  {
-    s_ticks_last_line_start = CoreTiming::GetTicks();
-  }
+  s_ticks_last_half_line_start = ticks;
 
   // Check if we need to assert IR_INT. Note that the granularity of our current horizontal
   // position is limited to half-lines.
@@ -949,7 +1075,9 @@ void FakeVIUpdate(u32 xfb_address, u32 fb_width, u32 fb_stride, u32 fb_height)
   m_PictureConfiguration.WPL = fb_width / 16;
   m_PictureConfiguration.STD = (fb_stride / 2) / 16;
 
+  CatchUpHalfLines(CoreTiming::GetTicks());
   UpdateParameters();
+  ScheduleNextUpdate();
 
   u32 total_halflines = GetHalfLinesPerEvenField() + GetHalfLinesPerOddField();
 
@@ -52,23 +52,32 @@ int CameraLogic::BusWrite(u8 slave_addr, u8 addr, int count, const u8* data_in)
   return RawWrite(&m_reg_data, addr, count, data_in);
 }
 
-void CameraLogic::Update(const Common::Matrix44& transform, Common::Vec2 field_of_view)
+bool CameraLogic::IsTracking() const
 {
-  // IR data is read from offset 0x37 on real hardware.
-  auto& data = m_reg_data.camera_data;
-  data.fill(0xff);
-
   constexpr u8 OBJECT_TRACKING_ENABLE = 0x08;
 
   // If Address 0x30 is not 0x08 the camera will return 0xFFs.
   // The Wii seems to write 0x01 here before changing modes/sensitivities.
-  if (m_reg_data.enable_object_tracking != OBJECT_TRACKING_ENABLE)
-    return;
-
   // If the sensor bar is off the camera will see no LEDs and return 0xFFs.
-  if (!IOS::g_gpio_out[IOS::GPIO::SENSOR_BAR])
+  return m_is_enabled && m_reg_data.enable_object_tracking == OBJECT_TRACKING_ENABLE &&
+         IOS::g_gpio_out[IOS::GPIO::SENSOR_BAR];
+}
+
+void CameraLogic::UpdateUntracked()
+{
+  // IR data is read from offset 0x37 on real hardware.
+  m_reg_data.camera_data.fill(0xff);
+}
+
+void CameraLogic::Update(const Common::Matrix44& transform, Common::Vec2 field_of_view)
+{
+  UpdateUntracked();
+
+  if (!IsTracking())
     return;
 
+  auto& data = m_reg_data.camera_data;
+
   using Common::Matrix33;
   using Common::Matrix44;
   using Common::Vec3;
@@ -87,9 +96,16 @@ void CameraLogic::Update(const Common::Matrix44& transform, Common::Vec2 field_o
       Vec3{SENSOR_BAR_LED_SEPARATION / 2, 0, 0},
   };
 
-  const auto camera_view =
-      Matrix44::Perspective(field_of_view.y, field_of_view.x / field_of_view.y, 0.001f, 1000) *
-      Matrix44::FromMatrix33(Matrix33::RotateX(float(MathUtil::TAU / 4))) * transform;
+  if (field_of_view.x != m_projection_field_of_view.x ||
+      field_of_view.y != m_projection_field_of_view.y)
+  {
+    m_projection =
+        Matrix44::Perspective(field_of_view.y, field_of_view.x / field_of_view.y, 0.001f, 1000) *
+        Matrix44::FromMatrix33(Matrix33::RotateX(float(MathUtil::TAU / 4)));
+    m_projection_field_of_view = field_of_view;
+  }
+
+  const auto camera_view = m_projection * transform;
 
   struct CameraPoint
   {
@@ -111,7 +111,12 @@ public:
 
   void Reset();
   void DoState(PointerWrap& p);
+  // Whether Update() needs the transformation of the wiimote, which is the case when the camera
+  // responds on the bus, object tracking is enabled and the sensor bar is on.
+  bool IsTracking() const;
   void Update(const Common::Matrix44& transform, Common::Vec2 field_of_view);
+  // Reports that no objects are visible, without computing their positions
+  void UpdateUntracked();
   void SetEnabled(bool is_enabled);
 
   static constexpr u8 I2C_ADDR = 0x58;
@@ -157,6 +162,10 @@ private:
 
   Register m_reg_data;
 
+  // Perspective and orientation of the camera, which only change with the field of view
+  Common::Matrix44 m_projection;
+  Common::Vec2 m_projection_field_of_view{};
+
   // When disabled the camera does not respond on the bus.
   // Change is triggered by wiimote report 0x13.
   bool m_is_enabled;
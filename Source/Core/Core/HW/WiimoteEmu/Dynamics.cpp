@@ -7,7 +7,7 @@
 #include <cmath>
 
 #include "Common/MathUtil.h"
-#include "Core/Config/SYSCONFSettings.h"
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/HW/WiimoteEmu/WiimoteEmu.h"
 #include "InputCommon/ControllerEmu/ControlGroup/Buttons.h"
 #include "InputCommon/ControllerEmu/ControlGroup/Cursor.h"
@@ -242,7 +242,7 @@ void EmulatePoint(MotionState* state, ControllerEmu::Cursor* ir_group, float tim
 
   // When the sensor bar position is on bottom, apply the "offset" setting negatively.
   // This is kinda odd but it does seem to maintain consistent cursor behavior.
-  const bool sensor_bar_on_top = Config::Get(Config::SYSCONF_SENSOR_BAR_POSITION) != 0;
+  const bool sensor_bar_on_top = Config::GetSnapshot().sensor_bar_position != 0;
 
   const float height = ir_group->GetVerticalOffset() * (sensor_bar_on_top ? 1 : -1);
 
@@ -525,9 +525,17 @@ void Wiimote::SendDataReport()
     {
       // Note: Camera logic currently contains no changing state so we can just update it here.
       // If that changes this should be moved to Wiimote::Update();
-      m_camera_logic.Update(GetTotalTransformation(),
-                            Common::Vec2(m_fov_x_setting.GetValue(), m_fov_y_setting.GetValue()) /
-                                360 * float(MathUtil::TAU));
+      // The transformation of the wiimote is only computed when the camera can see the LEDs.
+      if (m_camera_logic.IsTracking())
+      {
+        m_camera_logic.Update(GetTotalTransformation(),
+                              Common::Vec2(m_fov_x_setting.GetValue(), m_fov_y_setting.GetValue()) /
+                                  360 * float(MathUtil::TAU));
+      }
+      else
+      {
+        m_camera_logic.UpdateUntracked();
+      }
 
       // The real wiimote reads camera data from the i2c bus starting at offset 0x37:
       const u8 camera_data_offset =
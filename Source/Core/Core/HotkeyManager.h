@@ -163,6 +163,9 @@ enum Hotkey
   HK_UNDO_SAVE_STATE,
   HK_SAVE_STATE_FILE,
   HK_LOAD_STATE_FILE,
+  HK_SAVE_STATE_MEMORY,
+  HK_LOAD_STATE_MEMORY,
+  HK_REWIND,
 
   HK_GBA_LOAD,
   HK_GBA_UNLOAD,
@@ -5,6 +5,8 @@
 #include <array>
 #include <cctype>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -70,7 +72,8 @@ static bool IsValidPartOfTitleID(const std::string& string)
                      [](const auto character) { return std::isxdigit(character) != 0; });
 }
 
-static std::vector<u64> GetTitlesInTitleOrImport(FS::FileSystem* fs, const std::string& titles_dir)
+static std::vector<u64> ScanTitlesInTitleOrImport(FS::FileSystem* fs,
+                                                  const std::string& titles_dir)
 {
   const auto entries = fs->ReadDirectory(PID_KERNEL, PID_KERNEL, titles_dir);
   if (!entries)
@@ -112,19 +115,8 @@ static std::vector<u64> GetTitlesInTitleOrImport(FS::FileSystem* fs, const std::
   return title_ids;
 }
 
-std::vector<u64> ESDevice::GetInstalledTitles() const
-{
-  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
-}
-
-std::vector<u64> ESDevice::GetTitleImports() const
-{
-  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/import");
-}
-
-std::vector<u64> ESDevice::GetTitlesWithTickets() const
+static std::vector<u64> ScanTitlesWithTickets(FS::FileSystem* fs)
 {
-  const auto fs = m_ios.GetFS();
   const auto entries = fs->ReadDirectory(PID_KERNEL, PID_KERNEL, "/ticket");
   if (!entries)
   {
@@ -164,6 +156,58 @@ std::vector<u64> ESDevice::GetTitlesWithTickets() const
   return title_ids;
 }
 
+// Scanning the title and ticket directories is slow on NANDs with many titles, and it would
+// otherwise be repeated on every IOS reload. The lists are kept until the directory tree of the
+// NAND changes.
+struct CachedTitleList
+{
+  u64 directory_tree_version;
+  std::vector<u64> title_ids;
+};
+
+static std::mutex s_title_list_cache_mutex;
+static std::map<std::string, CachedTitleList> s_title_list_cache;
+
+template <typename ScanFunction>
+static std::vector<u64> GetCachedTitleList(const std::string& directory, ScanFunction scan)
+{
+  // The version is read before scanning, so a change that happens during the scan makes the next
+  // call scan again.
+  const u64 version = FS::GetDirectoryTreeVersion();
+  {
+    std::lock_guard lk(s_title_list_cache_mutex);
+    const auto it = s_title_list_cache.find(directory);
+    if (it != s_title_list_cache.end() && it->second.directory_tree_version == version)
+      return it->second.title_ids;
+  }
+
+  std::vector<u64> title_ids = scan();
+
+  std::lock_guard lk(s_title_list_cache_mutex);
+  s_title_list_cache.insert_or_assign(directory, CachedTitleList{version, title_ids});
+  return title_ids;
+}
+
+std::vector<u64> ESDevice::GetInstalledTitles() const
+{
+  return GetCachedTitleList("/title", [this] {
+    return ScanTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
+  });
+}
+
+std::vector<u64> ESDevice::GetTitleImports() const
+{
+  return GetCachedTitleList("/import", [this] {
+    return ScanTitlesInTitleOrImport(m_ios.GetFS().get(), "/import");
+  });
+}
+
+std::vector<u64> ESDevice::GetTitlesWithTickets() const
+{
+  return GetCachedTitleList("/ticket",
+                            [this] { return ScanTitlesWithTickets(m_ios.GetFS().get()); });
+}
+
 std::vector<ES::Content>
 ESDevice::GetStoredContentsFromTMD(const ES::TMDReader& tmd,
                                    CheckContentHashes check_content_hashes) const
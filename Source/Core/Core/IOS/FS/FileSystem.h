@@ -271,6 +271,12 @@ enum class Location
 
 std::unique_ptr<FileSystem> MakeFileSystem(Location location = Location::Session);
 
+/// Returns a counter that is incremented whenever files or directories are created, deleted or
+/// renamed on any NAND, or when the NAND contents may have been replaced on the host.
+/// This allows caching directory listings across filesystem instances (e.g. IOS reloads).
+u64 GetDirectoryTreeVersion();
+void OnDirectoryTreeChanged();
+
 /// Convert a FS result code to an IOS error code.
 IOS::HLE::ReturnCode ConvertResult(ResultCode code);
 
@@ -3,6 +3,8 @@
 
 #include "Core/IOS/FS/FileSystem.h"
 
+#include <atomic>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Core/IOS/Device.h"
@@ -35,6 +37,18 @@ std::unique_ptr<FileSystem> MakeFileSystem(Location location)
   return std::make_unique<HostFileSystem>(nand_root);
 }
 
+static std::atomic<u64> s_directory_tree_version{0};
+
+u64 GetDirectoryTreeVersion()
+{
+  return s_directory_tree_version.load();
+}
+
+void OnDirectoryTreeChanged()
+{
+  s_directory_tree_version++;
+}
+
 IOS::HLE::ReturnCode ConvertResult(ResultCode code)
 {
   if (code == ResultCode::Success)
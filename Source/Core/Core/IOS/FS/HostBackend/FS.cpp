@@ -108,7 +108,10 @@ HostFileSystem::HostFileSystem(const std::string& root_path) : m_root_path{root_
   LoadFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  FlushFst();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
@@ -163,6 +166,8 @@ void HostFileSystem::LoadFst()
 
 void HostFileSystem::SaveFst()
 {
+  m_fst_dirty = false;
+
   std::vector<SerializedFstEntry> to_write;
   auto collect_entries = [&to_write](const auto& collect, const FstEntry& entry) -> void {
     SerializedFstEntry& serialized = to_write.emplace_back();
@@ -189,6 +194,17 @@ void HostFileSystem::SaveFst()
     PanicAlertFmt("IOS_FS: Failed to rename temporary FST file");
 }
 
+void HostFileSystem::MarkFstDirty()
+{
+  m_fst_dirty = true;
+}
+
+void HostFileSystem::FlushFst()
+{
+  if (m_fst_dirty)
+    SaveFst();
+}
+
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
 {
   if (path == "/")
@@ -236,6 +252,8 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
 
 void HostFileSystem::DoState(PointerWrap& p)
 {
+  FlushFst();
+
   // Temporarily close the file, to prevent any issues with the savestating of /tmp
   for (Handle& handle : m_handles)
     handle.host_file.reset();
@@ -351,6 +369,7 @@ ResultCode HostFileSystem::Format(Uid uid)
     return ResultCode::UnknownError;
   ResetFst();
   SaveFst();
+  OnDirectoryTreeChanged();
   // Reset and close all handles.
   m_handles = {};
   return ResultCode::Success;
@@ -393,7 +412,8 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
-  SaveFst();
+  MarkFstDirty();
+  OnDirectoryTreeChanged();
   return ResultCode::Success;
 }
 
@@ -452,7 +472,8 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
     parent->children.erase(it);
-  SaveFst();
+  MarkFstDirty();
+  OnDirectoryTreeChanged();
 
   return ResultCode::Success;
 }
@@ -524,6 +545,7 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   }
   new_entry->name = split_new_path.file_name;
   SaveFst();
+  OnDirectoryTreeChanged();
 
   return ResultCode::Success;
 }
@@ -639,7 +661,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   entry->data.uid = uid;
   entry->data.attribute = attr;
   entry->data.modes = modes;
-  SaveFst();
+  MarkFstDirty();
 
   return ResultCode::Success;
 }
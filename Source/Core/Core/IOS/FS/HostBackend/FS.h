@@ -95,6 +95,12 @@ private:
   void ResetFst();
   void LoadFst();
   void SaveFst();
+  /// Marks the FST as changed without writing it yet. Games often create, delete or change
+  /// the metadata of several files in a row, so the writes are batched: pending changes are
+  /// written when a file is closed, on renames, on savestates and when the FS is destroyed.
+  /// Entries that are lost if the emulator crashes in between fall back to default metadata.
+  void MarkFstDirty();
+  void FlushFst();
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
@@ -109,6 +115,7 @@ private:
   /// and we do not want FS to break if the user adds or removes files in their
   /// filesystem root manually.
   FstEntry m_root_entry{};
+  bool m_fst_dirty = false;
   std::string m_root_path;
   std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
@@ -109,6 +109,8 @@ ResultCode HostFileSystem::Close(Fd fd)
   // Let go of our pointer to the file, it will automatically close if we are the last handle
   // accessing it.
   *handle = Handle{};
+
+  FlushFst();
   return ResultCode::Success;
 }
 
@@ -822,10 +822,15 @@ void WiiSockMan::Update()
     const WiiSocket& sock = socket_iter->second;
     if (sock.IsValid())
     {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
+      // Only sockets with pending operations need to be checked; idle sockets (which are the
+      // majority when many connections are open) would just make select slower.
+      if (!sock.pending_sockops.empty())
+      {
+        FD_SET(sock.fd, &read_fds);
+        FD_SET(sock.fd, &write_fds);
+        FD_SET(sock.fd, &except_fds);
+        nfds = std::max(nfds, sock.fd + 1);
+      }
       ++socket_iter;
     }
     else
@@ -835,22 +840,25 @@ void WiiSockMan::Update()
     }
   }
 
-  const s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
-
-  if (ret >= 0)
+  if (nfds != 0)
   {
+    const s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
+
     for (auto& pair : WiiSockets)
     {
       WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
-    }
-  }
-  else
-  {
-    for (auto& elem : WiiSockets)
-    {
-      elem.second.Update(false, false, false);
+      if (sock.pending_sockops.empty())
+        continue;
+
+      if (ret >= 0)
+      {
+        sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
+                    FD_ISSET(sock.fd, &except_fds) != 0);
+      }
+      else
+      {
+        sock.Update(false, false, false);
+      }
     }
   }
   UpdatePollCommands();
@@ -7,9 +7,20 @@
 
 #include "Core/LUA/Lua.h"
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <list>
 #include <mbedtls/md5.h>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
+#include "Common/BitUtils.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/Hash.h"
@@ -17,11 +28,13 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Core/ConfigManager.h"
+#include "Core/CPUTimeBreakdown.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayProto.h"
 #include "Core/State.h"
@@ -39,12 +52,33 @@
 //#include "Core/HW/WII_IPC_HLE_Device_usb.h" //need find the version from latest dev
 #include "Core/PowerPC/PowerPC.h"
 #include "InputCommon/GCPadStatus.h"
-#include "VideoCommon/Statistics.h"
+#include "VideoCommon/ScriptOverlay.h"
 #include "VideoCommon/VideoConfig.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/PointerPath.h"
 
 
+//Reads from live RAM, or from the frame snapshot when called by an asynchronous script
+template <typename T>
+static T ReadFromView(u32 address)
+{
+	const u8* ptr = Lua::GetReadPointer(address, sizeof(T));
+
+	if (!ptr)
+		return 0;
+
+	T value;
+	std::memcpy(&value, ptr, sizeof(T));
+	return Common::FromBigEndian(value);
+}
+
+//Functions that change emulation state can only be used from synchronous scripts
+static int RejectInAsyncScript(lua_State* L, const char* function)
+{
+	return luaL_error(L, "%s can't be used by asynchronous scripts", function);
+}
+
 //Lua Functions (C)
 int ReadValue8(lua_State* L)
 {
@@ -60,16 +94,17 @@ int ReadValue8(lua_State* L)
 	{
 		u32 address = lua_tointeger(L, 1);
 
-		result = Memory::Read_U8(address);
+		result = ReadFromView<u8>(address);
 
 		lua_pushinteger(L, result); // return value
 		return 1;                   // number of return values
 	}
 	// if more than 1 argument, read multilelve pointer
 	
-	if (Lua::ExecuteMultilevelLoop(L) != 0)
+	const u32 pointer = Lua::ExecuteMultilevelLoop(L);
+	if (pointer != 0)
 	{
-		result = Memory::Read_U8(Lua::ExecuteMultilevelLoop(L));
+		result = ReadFromView<u8>(pointer);
 	}
 
 	lua_pushinteger(L, result);
@@ -89,15 +124,16 @@ int ReadValue16(lua_State* L)
 	{
 		u32 address = lua_tointeger(L, 1);
 
-		result = Memory::Read_U16(address);
+		result = ReadFromView<u16>(address);
 
 		lua_pushinteger(L, result); // return value
 		return 1;
 	}
 	// if more than 1 argument, read multilelve pointer
-	if (Lua::ExecuteMultilevelLoop(L) != 0)
+	const u32 pointer = Lua::ExecuteMultilevelLoop(L);
+	if (pointer != 0)
 	{
-		result = Memory::Read_U16(Lua::ExecuteMultilevelLoop(L));
+		result = ReadFromView<u16>(pointer);
 	}
 
 	lua_pushinteger(L, result);
@@ -117,16 +153,16 @@ int ReadValue32(lua_State* L)
 	{
 		u32 address = lua_tointeger(L, 1);
 
-		result = Memory::Read_U32(address);
+		result = ReadFromView<u32>(address);
 
 		lua_pushinteger(L, result); // return value
 		return 1;
 	}
 	// if more than 1 argument, read multilelve pointer
-	if (Lua::ExecuteMultilevelLoop(L) != 0)
+	const u32 pointer = Lua::ExecuteMultilevelLoop(L);
+	if (pointer != 0)
 	{
-		result = Memory::Read_U32(Lua::ExecuteMultilevelLoop(L));
-		// result = PowerPC::Read_U8(LastOffset);
+		result = ReadFromView<u32>(pointer);
 	}
 
 	lua_pushinteger(L, result); // return value
@@ -146,15 +182,16 @@ int ReadValueFloat(lua_State* L)
 	{
 		u32 address = lua_tointeger(L, 1);
 
-		result = PowerPC::HostRead_F32(address);
+		result = Common::BitCast<float>(ReadFromView<u32>(address));
 
 		lua_pushnumber(L, result); // return value
 		return 1;
 	}
 	// if more than 1 argument, read multilelve pointer
-	if (Lua::ExecuteMultilevelLoop(L) != 0)
+	const u32 pointer = Lua::ExecuteMultilevelLoop(L);
+	if (pointer != 0)
 	{
-		result = PowerPC::HostRead_F32(Lua::ExecuteMultilevelLoop(L));
+		result = Common::BitCast<float>(ReadFromView<u32>(pointer));
 	}
 
 	lua_pushnumber(L, result); // return value
@@ -171,15 +208,125 @@ int ReadValueString(lua_State* L)
 	u32 address = lua_tointeger(L, 1);
 	int count = lua_tointeger(L, 2);
 
-	std::string result = PowerPC::Read_String(address, count);
+	if (count <= 0)
+		return 0;
+
+	const u8* ptr = Lua::GetReadPointer(address, count);
+
+	if (!ptr)
+		return 0;
+
+	std::string result(reinterpret_cast<const char*>(ptr), count);
 
 	lua_pushstring(L, result.c_str()); // return value
 	return 1; // number of return values
 }
 
+// Bulk reads: one range check against MEM1/MEM2, then a single pass converting from big endian.
+// Arguments are (address, count[, stride]); the stride defaults to the element size.
+static const u8* GetArrayPointer(lua_State* L, size_t elementSize, lua_Integer* count, lua_Integer* stride)
+{
+	int argc = lua_gettop(L);
+
+	if (argc < 2)
+		return nullptr;
+
+	u32 address = lua_tointeger(L, 1);
+	*count = lua_tointeger(L, 2);
+	*stride = argc > 2 ? lua_tointeger(L, 3) : static_cast<lua_Integer>(elementSize);
+
+	if (*count <= 0 || *count > 0x1000000 || *stride < static_cast<lua_Integer>(elementSize) || *stride > 0x1000000)
+		return nullptr;
+
+	const size_t span = static_cast<size_t>(*count - 1) * static_cast<size_t>(*stride) + elementSize;
+	return Lua::GetReadPointer(address, span);
+}
+
+template <typename T>
+static int ReadIntegerArray(lua_State* L)
+{
+	lua_Integer count, stride;
+	const u8* ptr = GetArrayPointer(L, sizeof(T), &count, &stride);
+
+	if (!ptr)
+		return 0;
+
+	lua_createtable(L, static_cast<int>(count), 0);
+
+	for (lua_Integer i = 0; i < count; ++i, ptr += stride)
+	{
+		T value;
+		std::memcpy(&value, ptr, sizeof(T));
+		lua_pushinteger(L, Common::FromBigEndian(value));
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1; // table of values
+}
+
+int ReadArray8(lua_State* L)
+{
+	return ReadIntegerArray<u8>(L);
+}
+
+int ReadArray16(lua_State* L)
+{
+	return ReadIntegerArray<u16>(L);
+}
+
+int ReadArray32(lua_State* L)
+{
+	return ReadIntegerArray<u32>(L);
+}
+
+int ReadArrayFloat(lua_State* L)
+{
+	lua_Integer count, stride;
+	const u8* ptr = GetArrayPointer(L, sizeof(u32), &count, &stride);
+
+	if (!ptr)
+		return 0;
+
+	lua_createtable(L, static_cast<int>(count), 0);
+
+	for (lua_Integer i = 0; i < count; ++i, ptr += stride)
+	{
+		lua_pushnumber(L, Common::BitCast<float>(Common::swap32(ptr)));
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1; // table of values
+}
+
+// Returns len raw bytes starting at address as a Lua string
+int ReadBlock(lua_State* L)
+{
+	int argc = lua_gettop(L);
+
+	if (argc < 2)
+		return 0;
+
+	u32 address = lua_tointeger(L, 1);
+	lua_Integer length = lua_tointeger(L, 2);
+
+	if (length <= 0 || length > 0x8000000)
+		return 0;
+
+	const u8* ptr = Lua::GetReadPointer(address, static_cast<size_t>(length));
+
+	if (!ptr)
+		return 0;
+
+	lua_pushlstring(L, reinterpret_cast<const char*>(ptr), static_cast<size_t>(length));
+	return 1; // number of return values
+}
+
 //Write Stuff
 int WriteValue8(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "WriteValue8");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -192,12 +339,16 @@ int WriteValue8(lua_State* L)
 	u8 value = lua_tointeger(L, 2);
 
 	Memory::Write_U8(value, address);
+	Lua::InvalidatePointerCache();
 
 	return 0; // number of return values
 }
 
 int WriteValue16(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "WriteValue16");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -210,12 +361,16 @@ int WriteValue16(lua_State* L)
 	u16 value = lua_tointeger(L, 2);
 
 	Memory::Write_U16(value, address);
+	Lua::InvalidatePointerCache();
 
 	return 0; // number of return values
 }
 
 int WriteValue32(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "WriteValue32");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -228,12 +383,16 @@ int WriteValue32(lua_State* L)
 	u32 value = lua_tointeger(L, 2);
 
 	Memory::Write_U32(value, address);
+	Lua::InvalidatePointerCache();
 
 	return 0; // number of return values
 }
 
 int WriteValueFloat(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "WriteValueFloat");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -246,12 +405,16 @@ int WriteValueFloat(lua_State* L)
 	double value = lua_tonumber(L, 2);
 
 	PowerPC::HostWrite_F32((float)value, address);
+	Lua::InvalidatePointerCache();
 
 	return 0; // number of return values
 }
 
 int WriteValueString(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "WriteValueString");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -266,6 +429,7 @@ int WriteValueString(lua_State* L)
 	std::string string = StringFromFormat("%s", value);
 
 	PowerPC::Write_String(string, address);
+	Lua::InvalidatePointerCache();
 
 	return 0; // number of return values
 }
@@ -321,6 +485,9 @@ int GetScriptsDir(lua_State* L)
 
 int PressButton(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "PressButton");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -329,15 +496,19 @@ int PressButton(lua_State* L)
 	if (argc < 1)
 		return 0;
 
-	const char* button = lua_tostring(L, 1);
+	const u16 mask = Lua::GetButtonMask(L, 1);
+	const int port = Lua::GetPortArgument(L, 2);
 
-	Lua::iPressButton(button);
+	Lua::iPressButton(mask, port);
 
 	return 0; // number of return values
 }
 
 int ReleaseButton(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "ReleaseButton");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -346,15 +517,19 @@ int ReleaseButton(lua_State* L)
 	if (argc < 1)
 		return 0;
 
-	const char* button = lua_tostring(L, 1);
+	const u16 mask = Lua::GetButtonMask(L, 1);
+	const int port = Lua::GetPortArgument(L, 2);
 
-	Lua::iReleaseButton(button);
+	Lua::iReleaseButton(mask, port);
 
 	return 0; // number of return values
 }
 
 int SetMainStickX(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SetMainStickX");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -365,12 +540,15 @@ int SetMainStickX(lua_State* L)
 
 	int xPos = lua_tointeger(L, 1);
 
-	Lua::iSetMainStickX(xPos);
+	Lua::iSetMainStickX(xPos, Lua::GetPortArgument(L, 2));
 
 	return 0;
 }
 int SetMainStickY(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SetMainStickY");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -381,13 +559,16 @@ int SetMainStickY(lua_State* L)
 
 	int yPos = lua_tointeger(L, 1);
 
-	Lua::iSetMainStickY(yPos);
+	Lua::iSetMainStickY(yPos, Lua::GetPortArgument(L, 2));
 
 	return 0;
 }
 
 int SetCStickX(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SetCStickX");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -398,12 +579,15 @@ int SetCStickX(lua_State* L)
 
 	int xPos = lua_tointeger(L, 1);
 
-	Lua::iSetCStickX(xPos);
+	Lua::iSetCStickX(xPos, Lua::GetPortArgument(L, 2));
 
 	return 0;
 }
 int SetCStickY(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SetCStickY");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -414,13 +598,16 @@ int SetCStickY(lua_State* L)
 
 	int yPos = lua_tointeger(L, 1);
 
-	Lua::iSetCStickY(yPos);
+	Lua::iSetCStickY(yPos, Lua::GetPortArgument(L, 2));
 
 	return 0;
 }
 
 int SaveState(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SaveState");
+
 	int argc = lua_gettop(L);
 
 	if (argc < 2)
@@ -450,6 +637,9 @@ int SaveState(lua_State* L)
 
 int LoadState(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "LoadState");
+
 	if (Movie::IsPlayingInput())
 		return 0;
 	
@@ -480,11 +670,49 @@ int LoadState(lua_State* L)
 	return 0; // number of return values
 }
 
+//Memory slots are numbered 1 to State::NUM_MEMORY_SLOTS. Both functions run immediately and
+//return whether they succeeded, so no savestate callback is involved.
+int SaveStateToMemory(lua_State* L)
+{
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SaveStateToMemory");
+
+	const int slot = static_cast<int>(luaL_checkinteger(L, 1)) - 1;
+
+	lua_pushboolean(L, slot >= 0 && State::SaveToMemory(slot));
+
+	return 1;
+}
+
+int LoadStateFromMemory(lua_State* L)
+{
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "LoadStateFromMemory");
+
+	const int slot = static_cast<int>(luaL_checkinteger(L, 1)) - 1;
+
+	if (Movie::IsPlayingInput() || slot < 0)
+	{
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	const bool loaded = State::LoadFromMemory(slot);
+
+	//Pointers chased before the load no longer match the restored RAM
+	if (loaded)
+		Lua::InvalidatePointerCache();
+
+	lua_pushboolean(L, loaded);
+
+	return 1;
+}
+
 int GetFrameCount(lua_State* L)
 {
 	lua_gettop(L);
 
-	lua_pushinteger(L, Movie::GetCurrentFrame()); // return value
+	lua_pushinteger(L, Lua::IsAsyncContext() ? Lua::GetSnapshotFrame() : Movie::GetCurrentFrame()); // return value
 	return 1; // number of return values
 }
 
@@ -492,29 +720,111 @@ int GetInputFrameCount(lua_State* L)
 {
 	lua_gettop(L);
 
-	lua_pushinteger(L, Movie::GetCurrentInputCount() + 1); // return value
+	lua_pushinteger(L, (Lua::IsAsyncContext() ? Lua::GetSnapshotInputCount() : Movie::GetCurrentInputCount()) + 1); // return value
 	return 1; // number of return values
 }
 
+//The overlay is drawn to on the CPU thread and published at the end of RunScripts. Positions are in
+//pixels of the render window, colors are 0xAARRGGBB.
+static constexpr u32 DEFAULT_OVERLAY_COLOR = 0xFFFFFFFF;
+
+static u32 OptOverlayColor(lua_State* L, int arg)
+{
+	return static_cast<u32>(luaL_optinteger(L, arg, DEFAULT_OVERLAY_COLOR));
+}
+
 int SetScreenText(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SetScreenText");
+
 	int argc = lua_gettop(L);
 
 	if (argc < 1)
 		return 0;
 
-	const char *text = lua_tostring(L, 1);
+	size_t length = 0;
+	const char* text = lua_tolstring(L, 1, &length);
+
+	if (text)
+		ScriptOverlay::AddText(10.0f, 10.0f, DEFAULT_OVERLAY_COLOR, std::string_view(text, length));
+
+	return 0;
+}
+
+//DrawScreenText(x, y, text, [color])
+int DrawScreenText(lua_State* L)
+{
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "DrawScreenText");
+
+	const float x = static_cast<float>(luaL_checknumber(L, 1));
+	const float y = static_cast<float>(luaL_checknumber(L, 2));
+	size_t length = 0;
+	const char* text = luaL_checklstring(L, 3, &length);
+
+	ScriptOverlay::AddText(x, y, OptOverlayColor(L, 4), std::string_view(text, length));
+
+	return 0;
+}
+
+//DrawScreenLine(x1, y1, x2, y2, [color], [thickness])
+int DrawScreenLine(lua_State* L)
+{
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "DrawScreenLine");
+
+	ScriptOverlay::AddLine(static_cast<float>(luaL_checknumber(L, 1)),
+	                       static_cast<float>(luaL_checknumber(L, 2)),
+	                       static_cast<float>(luaL_checknumber(L, 3)),
+	                       static_cast<float>(luaL_checknumber(L, 4)), OptOverlayColor(L, 5),
+	                       static_cast<float>(luaL_optnumber(L, 6, 1.0)));
+
+	return 0;
+}
+
+//DrawScreenRect(x1, y1, x2, y2, [color], [thickness]) draws the outline,
+//FillScreenRect(x1, y1, x2, y2, [color]) the whole rectangle
+static int AddScreenRect(lua_State* L, const char* function, bool filled)
+{
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, function);
+
+	ScriptOverlay::AddRect(static_cast<float>(luaL_checknumber(L, 1)),
+	                       static_cast<float>(luaL_checknumber(L, 2)),
+	                       static_cast<float>(luaL_checknumber(L, 3)),
+	                       static_cast<float>(luaL_checknumber(L, 4)), OptOverlayColor(L, 5),
+	                       filled ? 0.0f : static_cast<float>(luaL_optnumber(L, 6, 1.0)), filled);
+
+	return 0;
+}
+
+int DrawScreenRect(lua_State* L)
+{
+	return AddScreenRect(L, "DrawScreenRect", false);
+}
+
+int FillScreenRect(lua_State* L)
+{
+	return AddScreenRect(L, "FillScreenRect", true);
+}
 
-	std::string screen_text = StringFromFormat("%s", text);
-	screen_text.append("\n");
+//What was drawn in the previous frames stays on screen until a frame draws something or calls this
+int ClearScreen(lua_State* L)
+{
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "ClearScreen");
 
-	Statistics::SetString(screen_text);
+	ScriptOverlay::ClearFrame();
 
 	return 0;
 }
 
 int PauseEmulation(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "PauseEmulation");
+
 	lua_gettop(L);
 
 	Core::SetState(Core::State::Paused);
@@ -522,8 +832,25 @@ int PauseEmulation(lua_State* L)
 	return 0;
 }
 
+//Pauses after the given number of frames (1 by default). Scripts run on the CPU thread, so this
+//returns right away instead of waiting for the frames to be emulated.
+int StepFrames(lua_State* L)
+{
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "StepFrames");
+
+	const lua_Integer frames = luaL_optinteger(L, 1, 1);
+
+	lua_pushboolean(L, frames > 0 && Core::StepFrames(static_cast<u32>(frames), false));
+
+	return 1;
+}
+
 int SetInfoDisplay(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SetInfoDisplay");
+
 	lua_gettop(L);	
 	SConfig::GetInstance().m_ShowRAMDisplay = !SConfig::GetInstance().m_ShowRAMDisplay;	
 	SConfig::GetInstance().SaveSettings();
@@ -532,6 +859,9 @@ int SetInfoDisplay(lua_State* L)
 
 int SetFrameAndAudioDump(lua_State* L)
 {
+	if (Lua::IsAsyncContext())
+		return RejectInAsyncScript(L, "SetFrameAndAudioDump");
+
 	lua_gettop(L);
 
 	bool enableDump = (lua_toboolean(L, 1) != 0);
@@ -567,6 +897,39 @@ int MsgBox(lua_State* L)
 	return 0; // number of return values
 }
 
+#ifdef USE_LUAJIT
+//Returns MEM1 and MEM2 (nil if absent) as light userdata, for use with ffi.cast. The memory is
+//big endian and must be treated as read-only; asynchronous scripts get their snapshot instead.
+int GetRAMPointers(lua_State* L)
+{
+	lua_gettop(L);
+
+	const u8* mem1 = Lua::GetReadPointer(0x80000000, 1);
+	const u8* mem2 = Lua::GetReadPointer(0x90000000, 1);
+
+	if (mem1)
+		lua_pushlightuserdata(L, const_cast<u8*>(mem1));
+	else
+		lua_pushnil(L);
+
+	if (mem2)
+		lua_pushlightuserdata(L, const_cast<u8*>(mem2));
+	else
+		lua_pushnil(L);
+
+	return 2; // number of return values
+}
+#endif
+
+int RunAsync(lua_State* L)
+{
+	lua_gettop(L);
+
+	Lua::iRunCurrentScriptAsync();
+
+	return 0; // number of return values
+}
+
 int CancelScript(lua_State* L)
 {
 	lua_gettop(L);
@@ -576,6 +939,67 @@ int CancelScript(lua_State* L)
 	return 0; // number of return values
 }
 
+//StartCoroutine(function) runs the function as a coroutine of the script, from the next script
+//update on. It may call the wait functions below, which are only available inside of coroutines.
+int StartCoroutine(lua_State* L)
+{
+	luaL_checktype(L, 1, LUA_TFUNCTION);
+
+	Lua::iStartCoroutine(L);
+
+	return 0; // number of return values
+}
+
+//WaitFrames([frames]) resumes the coroutine after the given number of script updates (1 by default)
+int WaitFrames(lua_State* L)
+{
+	const lua_Integer frames = luaL_optinteger(L, 1, 1);
+
+	return Lua::iWaitFrames(L, frames > 0 ? static_cast<u64>(frames) : 1);
+}
+
+//WaitUntilAddressChanges(address, [size]) resumes the coroutine at the first script update which
+//reads a different value, which it returns. The address can also be a pointer path given as a table
+//{base, offset1, offset2, ...}, which is followed through the pointer cache the scripts share.
+//The size is 1, 2 or 4 bytes (4 by default).
+int WaitUntilAddressChanges(lua_State* L)
+{
+	PointerPath path;
+
+	if (lua_istable(L, 1))
+	{
+#if LUA_VERSION_NUM >= 502
+		const lua_Integer count = static_cast<lua_Integer>(lua_rawlen(L, 1));
+#else
+		const lua_Integer count = static_cast<lua_Integer>(lua_objlen(L, 1));
+#endif
+		if (count < 1)
+			return luaL_argerror(L, 1, "empty pointer path");
+
+		for (lua_Integer i = 1; i <= count; ++i)
+		{
+			lua_rawgeti(L, 1, i);
+			const u32 value = static_cast<u32>(lua_tointeger(L, -1));
+			lua_pop(L, 1);
+
+			if (i == 1)
+				path.base = value;
+			else
+				path.offsets.push_back(value);
+		}
+	}
+	else
+	{
+		path.base = static_cast<u32>(luaL_checkinteger(L, 1));
+	}
+
+	const lua_Integer size = luaL_optinteger(L, 2, 4);
+	if (size != 1 && size != 2 && size != 4)
+		return luaL_argerror(L, 2, "size must be 1, 2 or 4");
+
+	return Lua::iWaitUntilAddressChanges(L, path, static_cast<u32>(size));
+}
+
 void HandleLuaErrors(lua_State* L, int status)
 {
 	if (status != 0)
@@ -594,13 +1018,80 @@ namespace Lua
 	static std::list<LuaScript> scriptList;
 	static int currScriptID;
 
-	static GCPadStatus PadLocal;
+	//Input changes requested by the scripts during the current poll cycle, applied to each port as
+	//it is polled
+	struct PadOverride
+	{
+		u16 pressed = 0;
+		u16 released = 0;
+		u8 sticks[4] = {};
+		u8 stickMask = 0; //Which entries of sticks are set
+	};
+
+	enum StickAxis
+	{
+		MAIN_STICK_X,
+		MAIN_STICK_Y,
+		C_STICK_X,
+		C_STICK_Y,
+	};
+
+	static std::array<PadOverride, 4> s_padOverrides;
+	static int s_lastPolledPort = -1;
+
+	//Counts the calls of RunScripts, which coroutines wait for
+	static u64 s_scriptUpdate = 0;
+	static LuaCoroutine* s_currentCoroutine = nullptr;
+
+	static PointerPathResolver s_pointerCache;
+	constexpr size_t POINTER_CACHE_MAX_NODES = 0x4000;
+
+	//Snapshot of the per-script timings for the GPU thread
+	static std::mutex s_timingsLock;
+	static std::vector<ScriptTiming> s_timings;
+	static std::vector<ScriptTiming> s_asyncTimings;
 
-	const int m_gc_pad_buttons_bitmask[12] = {
-		PAD_BUTTON_DOWN, PAD_BUTTON_UP, PAD_BUTTON_LEFT, PAD_BUTTON_RIGHT, PAD_BUTTON_A, PAD_BUTTON_B,
-		PAD_BUTTON_X, PAD_BUTTON_Y, PAD_TRIGGER_Z, PAD_TRIGGER_L, PAD_TRIGGER_R, PAD_BUTTON_START
+	//Asynchronous scripts only observe the game, so they run on their own thread against a copy of
+	//MEM1/MEM2 taken at the end of a frame. If they fall behind, frames are skipped rather than
+	//stalling the CPU thread.
+	struct FrameSnapshot
+	{
+		std::vector<u8> mem1;
+		std::vector<u8> mem2;
+		RAMView view;
+		u64 frame = 0;
+		u64 inputCount = 0;
+	};
+
+	static std::thread s_asyncThread;
+	static std::mutex s_asyncLock;
+	static std::condition_variable s_asyncWakeup;
+	static bool s_asyncBusy = false;              //The worker owns s_asyncScripts and the snapshot
+	static bool s_asyncQuit = false;
+	static std::list<LuaScript> s_asyncScripts;
+	static std::list<LuaScript> s_pendingAsyncScripts;
+	static std::vector<std::string> s_asyncTerminations;
+	static FrameSnapshot s_snapshot;
+	static PointerPathResolver s_asyncPointerCache(&s_snapshot.view);
+
+	static thread_local LuaScript* s_currentAsyncScript = nullptr;
+
+	static void StopAsyncThread();
+	static void RunScripts();
+
+	struct ButtonName
+	{
+		const char* name;
+		u16 mask;
 	};
 
+	static constexpr std::array<ButtonName, 12> s_buttonNames = {{
+		{"A", PAD_BUTTON_A}, {"B", PAD_BUTTON_B}, {"X", PAD_BUTTON_X}, {"Y", PAD_BUTTON_Y},
+		{"Z", PAD_TRIGGER_Z}, {"L", PAD_TRIGGER_L}, {"R", PAD_TRIGGER_R}, {"Start", PAD_BUTTON_START},
+		{"D-Up", PAD_BUTTON_UP}, {"D-Down", PAD_BUTTON_DOWN}, {"D-Left", PAD_BUTTON_LEFT},
+		{"D-Right", PAD_BUTTON_RIGHT},
+	}};
+
 	//LUA Savestate Stuff
 	StateEvent m_stateData;
 
@@ -610,132 +1101,106 @@ namespace Lua
 	bool lua_isStateDone = false;
 
 
-	//Dragonbane: Lua Wrapper Functions
-	void iPressButton(const char* button)
+	//Accepts either a mask from the Button table (e.g. Button.A | Button.B) or a button name
+	u16 GetButtonMask(lua_State* L, int index)
 	{
-		if (!strcmp(button, "A"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[4];
-			PadLocal.analogA = 0xFF;
-		}
-		else if (!strcmp(button, "B"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[5];
-			PadLocal.analogB = 0xFF;
-		}
-		else if (!strcmp(button, "X"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[6];
-		}
-		else if (!strcmp(button, "Y"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[7];
-		}
-		else if (!strcmp(button, "Z"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[8];
-		}
-		else if (!strcmp(button, "L"))
-		{
-			PadLocal.triggerLeft = 255;
-			PadLocal.button |= m_gc_pad_buttons_bitmask[9];
-		}
-		else if (!strcmp(button, "R"))
-		{
-			PadLocal.triggerRight = 255;
-			PadLocal.button |= m_gc_pad_buttons_bitmask[10];
-		}
-		else if (!strcmp(button, "Start"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[11];
-		}
-		else if (!strcmp(button, "D-Up"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[1];
-		}
-		else if (!strcmp(button, "D-Down"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[0];
-		}
-		else if (!strcmp(button, "D-Left"))
+		if (lua_type(L, index) == LUA_TNUMBER)
+			return static_cast<u16>(lua_tointeger(L, index));
+
+		const char* button = lua_tostring(L, index);
+
+		if (!button)
+			return 0;
+
+		for (const ButtonName& entry : s_buttonNames)
 		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[2];
+			if (!strcmp(button, entry.name))
+				return entry.mask;
 		}
-		else if (!strcmp(button, "D-Right"))
-		{
-			PadLocal.button |= m_gc_pad_buttons_bitmask[3];
-		}		
+
+		return 0;
 	}
-	void iReleaseButton(const char* button)
+
+	//Ports are numbered 1-4 on the Lua side and default to the first one
+	int GetPortArgument(lua_State* L, int index)
 	{
-		if (!strcmp(button, "A"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[4];
-			PadLocal.analogA = 0x00;
-		}
-		else if (!strcmp(button, "B"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[5];
-			PadLocal.analogB = 0x00;
-		}
-		else if (!strcmp(button, "X"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[6];
-		}
-		else if (!strcmp(button, "Y"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[7];
-		}
-		else if (!strcmp(button, "Z"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[8];
-		}
-		else if (!strcmp(button, "L"))
-		{
-			PadLocal.triggerLeft = 0;
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[9];
-		}
-		else if (!strcmp(button, "R"))
-		{
-			PadLocal.triggerRight = 0;
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[10];
-		}
-		else if (!strcmp(button, "Start"))
+		if (lua_gettop(L) < index)
+			return 0;
+
+		return std::clamp<int>(static_cast<int>(lua_tointeger(L, index)) - 1, 0, 3);
+	}
+
+	//Makes the button masks available as Button.A, Button.Start, ...
+	static void RegisterButtonTable(lua_State* luaState)
+	{
+		lua_createtable(luaState, 0, static_cast<int>(s_buttonNames.size()));
+
+		for (const ButtonName& entry : s_buttonNames)
 		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[11];
-		}
-		else if (!strcmp(button, "D-Up"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[1];
-		}
-		else if (!strcmp(button, "D-Down"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[0];
-		}
-		else if (!strcmp(button, "D-Left"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[2];
-		}
-		else if (!strcmp(button, "D-Right"))
-		{
-			PadLocal.button &= ~m_gc_pad_buttons_bitmask[3];
+			lua_pushinteger(luaState, entry.mask);
+			lua_setfield(luaState, -2, entry.name);
 		}
+
+		lua_setglobal(luaState, "Button");
 	}
 
-	u32 readPointer(u32 startAddress, u32 offset)
+	//Dragonbane: Lua Wrapper Functions
+	void iPressButton(u16 mask, int port)
 	{
-	    u32 pointer = Memory::Read_U32(startAddress) + offset;
-	    // check if pointer is not in the mem1 or mem2
-	    if (Lua::IsInMEMArea(pointer))
-	    {
-			if ((pointer > 0x80000000 && pointer < 0x81800000) || (pointer > 0x90000000 && pointer < 0x94000000))
-			{
-				pointer -= 0x80000000;
-			}
+		s_padOverrides[port].pressed |= mask;
+		s_padOverrides[port].released &= ~mask;
+	}
 
-			return pointer;
-	    }
-		else return 0;
+	void iReleaseButton(u16 mask, int port)
+	{
+		s_padOverrides[port].released |= mask;
+		s_padOverrides[port].pressed &= ~mask;
+	}
+
+	static void SetStick(int port, StickAxis axis, int value)
+	{
+		s_padOverrides[port].sticks[axis] = static_cast<u8>(value);
+		s_padOverrides[port].stickMask |= 1 << axis;
+	}
+
+	static void ApplyPadOverride(const PadOverride& pad, GCPadStatus* status)
+	{
+		status->button = (status->button | pad.pressed) & ~pad.released;
+
+		//Pressing or releasing the digital buttons also drives their analog values
+		if (pad.pressed & PAD_BUTTON_A)
+			status->analogA = 0xFF;
+		else if (pad.released & PAD_BUTTON_A)
+			status->analogA = 0x00;
+
+		if (pad.pressed & PAD_BUTTON_B)
+			status->analogB = 0xFF;
+		else if (pad.released & PAD_BUTTON_B)
+			status->analogB = 0x00;
+
+		if (pad.pressed & PAD_TRIGGER_L)
+			status->triggerLeft = 0xFF;
+		else if (pad.released & PAD_TRIGGER_L)
+			status->triggerLeft = 0x00;
+
+		if (pad.pressed & PAD_TRIGGER_R)
+			status->triggerRight = 0xFF;
+		else if (pad.released & PAD_TRIGGER_R)
+			status->triggerRight = 0x00;
+
+		if (pad.stickMask & (1 << MAIN_STICK_X))
+			status->stickX = pad.sticks[MAIN_STICK_X];
+		if (pad.stickMask & (1 << MAIN_STICK_Y))
+			status->stickY = pad.sticks[MAIN_STICK_Y];
+		if (pad.stickMask & (1 << C_STICK_X))
+			status->substickX = pad.sticks[C_STICK_X];
+		if (pad.stickMask & (1 << C_STICK_Y))
+			status->substickY = pad.sticks[C_STICK_Y];
+	}
+
+	u32 readPointer(u32 startAddress, u32 offset)
+	{
+		return PointerPathResolver::Follow(startAddress, offset).value_or(0);
 	}
 
 	u32 normalizePointer(u32 pointer)
@@ -747,43 +1212,68 @@ namespace Lua
 		return pointer;
 	}
 
+	bool IsAsyncContext()
+	{
+		return s_currentAsyncScript != nullptr;
+	}
+
+	const u8* GetReadPointer(u32 address, size_t size)
+	{
+		if (IsAsyncContext())
+			return s_snapshot.view.GetPointer(address, size);
+
+		return Memory::GetPointerForRange(address, size);
+	}
+
+	u64 GetSnapshotFrame()
+	{
+		return s_snapshot.frame;
+	}
+
+	u64 GetSnapshotInputCount()
+	{
+		return s_snapshot.inputCount;
+	}
+
 	u32 ExecuteMultilevelLoop(lua_State *L)
-    {
-	    int argc = lua_gettop(L);
-	    u32 mainPointer = lua_tointeger(L, 1);
-	    // we need to read the main pointer once, so we can use this one in the for loop
-	    u32 pointer = mainPointer;
+	{
+		int argc = lua_gettop(L);
 
-	    for (int i = 2; i <= argc; ++i)
-	    {
-		    // read offsets
-		    u32 offset = lua_tointeger(L, i);
-		    // dedicated function to read the offsets and pointer
-		    pointer = readPointer(pointer, offset);
-		    if ((pointer == 0) || (pointer == offset))
-		    {
-			    pointer = 0;
-			    break;			    
-		    }
-	    }
-		return pointer;	    
-    }
+		PointerPath path;
+		path.base = lua_tointeger(L, 1);
+		for (int i = 2; i <= argc; ++i)
+			path.offsets.push_back(lua_tointeger(L, i));
 
-	void iSetMainStickX(int xVal)
+		// Scripts tend to chase many chains off the same few root pointers every frame, so the
+		// hops are memoized until the next frame or until a script writes to memory
+		PointerPathResolver& cache = IsAsyncContext() ? s_asyncPointerCache : s_pointerCache;
+
+		if (cache.GetNodeCount() > POINTER_CACHE_MAX_NODES)
+			cache.Clear();
+
+		return cache.GetAddress(cache.Add(path)).value_or(0);
+	}
+
+	void InvalidatePointerCache()
 	{
-		PadLocal.stickX = xVal;
+		s_pointerCache.Invalidate();
 	}
-	void iSetMainStickY(int yVal)
+
+	void iSetMainStickX(int xVal, int port)
 	{
-		PadLocal.stickY = yVal;
+		SetStick(port, MAIN_STICK_X, xVal);
 	}
-	void iSetCStickX(int xVal)
+	void iSetMainStickY(int yVal, int port)
 	{
-		PadLocal.substickX = xVal;
+		SetStick(port, MAIN_STICK_Y, yVal);
 	}
-	void iSetCStickY(int yVal)
+	void iSetCStickX(int xVal, int port)
 	{
-		PadLocal.substickY = yVal;
+		SetStick(port, C_STICK_X, xVal);
+	}
+	void iSetCStickY(int yVal, int port)
+	{
+		SetStick(port, C_STICK_Y, yVal);
 	}
 	void iSaveState(bool toSlot, int slotID, std::string fileName)
 	{
@@ -845,8 +1335,126 @@ namespace Lua
 
 		Host_UpdateMainFrame();
 	}
+	void iRunCurrentScriptAsync()
+	{
+		int n = 0;
+
+		for (std::list<LuaScript>::iterator it = scriptList.begin(); it != scriptList.end(); ++it)
+		{
+			if (currScriptID == n)
+			{
+				it->runAsync = true;
+				break;
+			}
+
+			++n;
+		}
+	}
+
+	static LuaScript* GetCurrentScript()
+	{
+		int n = 0;
+
+		for (std::list<LuaScript>::iterator it = scriptList.begin(); it != scriptList.end(); ++it)
+		{
+			if (currScriptID == n)
+				return &*it;
+
+			++n;
+		}
+
+		return nullptr;
+	}
+
+	void iStartCoroutine(lua_State* L)
+	{
+		LuaScript* script = GetCurrentScript();
+
+		if (!script)
+			return;
+
+		lua_State* thread = lua_newthread(L);
+		lua_pushvalue(L, 1);
+		lua_xmove(L, thread, 1);
+
+		LuaCoroutine& coroutine = script->coroutines.emplace_back();
+		coroutine.thread = thread;
+		coroutine.threadRef = luaL_ref(L, LUA_REGISTRYINDEX);
+		coroutine.resumeUpdate = s_scriptUpdate + 1;
+	}
+
+	static int RejectOutsideOfCoroutine(lua_State* L, const char* function)
+	{
+		return luaL_error(L, "%s can only be used by coroutines started with StartCoroutine", function);
+	}
+
+	int iWaitFrames(lua_State* L, u64 frames)
+	{
+		if (!s_currentCoroutine || s_currentCoroutine->thread != L)
+			return RejectOutsideOfCoroutine(L, "WaitFrames");
+
+		s_currentCoroutine->resumeUpdate = s_scriptUpdate + frames;
+
+		return lua_yield(L, 0);
+	}
+
+	//Reads the value a coroutine waits on, false if the path doesn't lead into MEM1/MEM2
+	static bool ReadWatchedValue(const LuaCoroutine& coroutine, u32* value)
+	{
+		std::optional<u32> address = coroutine.path.base;
+
+		if (!coroutine.path.offsets.empty())
+		{
+			if (s_pointerCache.GetNodeCount() > POINTER_CACHE_MAX_NODES)
+				s_pointerCache.Clear();
+
+			address = s_pointerCache.GetAddress(s_pointerCache.Add(coroutine.path));
+		}
+
+		if (!address || !Memory::GetPointerForRange(*address, coroutine.size))
+			return false;
+
+		switch (coroutine.size)
+		{
+		case 1:
+			*value = ReadFromView<u8>(*address);
+			break;
+		case 2:
+			*value = ReadFromView<u16>(*address);
+			break;
+		default:
+			*value = ReadFromView<u32>(*address);
+			break;
+		}
+
+		return true;
+	}
+
+	int iWaitUntilAddressChanges(lua_State* L, const PointerPath& path, u32 size)
+	{
+		if (!s_currentCoroutine || s_currentCoroutine->thread != L)
+			return RejectOutsideOfCoroutine(L, "WaitUntilAddressChanges");
+
+		LuaCoroutine& coroutine = *s_currentCoroutine;
+		coroutine.waitsForChange = true;
+		coroutine.path = path;
+		coroutine.size = size;
+
+		//Changes are counted from the current value, a path which doesn't resolve yet changes once it
+		//does
+		coroutine.hasValue = ReadWatchedValue(coroutine, &coroutine.value);
+
+		return lua_yield(L, 0);
+	}
+
 	void iCancelCurrentScript()
 	{
+		if (s_currentAsyncScript)
+		{
+			s_currentAsyncScript->requestedTermination = true;
+			return;
+		}
+
 		int n = 0;
 
 		for (std::list<LuaScript>::iterator it = scriptList.begin(); it != scriptList.end(); ++it)
@@ -872,6 +1480,11 @@ namespace Lua
 		lua_register(luaState, "ReadValueFloat", ReadValueFloat);
 		lua_register(luaState, "ReadValueString", ReadValueString);
 		lua_register(luaState, "GetPointerNormal", GetPointerNormal);
+		lua_register(luaState, "ReadBlock", ReadBlock);
+		lua_register(luaState, "ReadArray8", ReadArray8);
+		lua_register(luaState, "ReadArray16", ReadArray16);
+		lua_register(luaState, "ReadArray32", ReadArray32);
+		lua_register(luaState, "ReadArrayFloat", ReadArrayFloat);
 
 		lua_register(luaState, "WriteValue8", WriteValue8);
 		lua_register(luaState, "WriteValue16", WriteValue16);
@@ -891,23 +1504,38 @@ namespace Lua
 
 		lua_register(luaState, "SaveState", SaveState);
 		lua_register(luaState, "LoadState", LoadState);
+		lua_register(luaState, "SaveStateToMemory", SaveStateToMemory);
+		lua_register(luaState, "LoadStateFromMemory", LoadStateFromMemory);
 
 		lua_register(luaState, "GetFrameCount", GetFrameCount);
 		lua_register(luaState, "GetInputFrameCount", GetInputFrameCount);
 		lua_register(luaState, "MsgBox", MsgBox);
 		
 		lua_register(luaState, "SetScreenText", SetScreenText);
+		lua_register(luaState, "DrawScreenText", DrawScreenText);
+		lua_register(luaState, "DrawScreenLine", DrawScreenLine);
+		lua_register(luaState, "DrawScreenRect", DrawScreenRect);
+		lua_register(luaState, "FillScreenRect", FillScreenRect);
+		lua_register(luaState, "ClearScreen", ClearScreen);
 		lua_register(luaState, "PauseEmulation", PauseEmulation);
+		lua_register(luaState, "StepFrames", StepFrames);
 		lua_register(luaState, "SetInfoDisplay", SetInfoDisplay);
 
 		// added by luckytyphlosion
 		lua_register(luaState, "SetFrameAndAudioDump", SetFrameAndAudioDump);
+
+		lua_register(luaState, "RunAsync", RunAsync);
+
+#ifdef USE_LUAJIT
+		lua_register(luaState, "GetRAMPointers", GetRAMPointers);
+#endif
 	}
 
 	void Init()
 	{
 		//For Pad manipulation
-		memset(&PadLocal, 0, sizeof(PadLocal));
+		s_padOverrides = {};
+		s_lastPolledPort = -1;
 
 		//Auto launch Scripts that start with _
 
@@ -941,6 +1569,13 @@ namespace Lua
 		}
 
 		scriptList.clear();
+
+		StopAsyncThread();
+		ScriptOverlay::Clear();
+
+		std::lock_guard lk(s_timingsLock);
+		s_timings.clear();
+		s_asyncTimings.clear();
 	}
 
 	bool IsInMEMArea(u32 pointer)
@@ -975,6 +1610,11 @@ namespace Lua
 
 	void TerminateScript(std::string fileName)
 	{
+		{
+			std::lock_guard lk(s_asyncLock);
+			s_asyncTerminations.push_back(fileName);
+		}
+
 		for (std::list<LuaScript>::iterator it = scriptList.begin(); it != scriptList.end(); ++it) //could this crash when an entry is deleted by the CPU thread during this?
 		{
 			if (it->fileName == fileName)
@@ -987,6 +1627,19 @@ namespace Lua
 
 	bool IsScriptRunning(std::string fileName)
 	{
+		{
+			std::lock_guard lk(s_asyncLock);
+
+			for (const std::list<LuaScript>* list : {&s_asyncScripts, &s_pendingAsyncScripts})
+			{
+				for (const LuaScript& script : *list)
+				{
+					if (script.fileName == fileName)
+						return true;
+				}
+			}
+		}
+
 		for (std::list<LuaScript>::iterator it = scriptList.begin(); it != scriptList.end(); ++it)
 		{
 			if (it->fileName == fileName)
@@ -999,14 +1652,325 @@ namespace Lua
 	}
 
 
-	//Called every input frame (60 times per second in TP)
-	void UpdateScripts(GCPadStatus* PadStatus)
+	//Returns a registry reference to the global function name, or LUA_NOREF if it isn't defined
+	static int GetCallbackRef(lua_State* L, const char* name)
+	{
+		lua_getglobal(L, name);
+
+		if (!lua_isfunction(L, -1))
+		{
+			lua_pop(L, 1);
+			return LUA_NOREF;
+		}
+
+		return luaL_ref(L, LUA_REGISTRYINDEX);
+	}
+
+	static int CallCallback(lua_State* L, int ref)
+	{
+		if (ref == LUA_NOREF)
+			return 0;
+
+		lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+		return lua_pcall(L, 0, 0, 0);
+	}
+
+	//Calls a per-frame hook and accounts the time spent to the script
+	static int TimedCallback(LuaScript* script, int ref)
+	{
+		const u64 start = Common::Timer::GetTimeUs();
+		const int status = CallCallback(script->luaState, ref);
+		script->frameTimeUs += Common::Timer::GetTimeUs() - start;
+		return status;
+	}
+
+	//Resumes the coroutines of the script whose wait is over. Returns the status of the first one
+	//which failed, after reporting its error.
+	static int ResumeCoroutines(LuaScript* script)
+	{
+		const u64 start = Common::Timer::GetTimeUs();
+		int status = 0;
+
+		std::list<LuaCoroutine>::iterator it = script->coroutines.begin();
+		while (it != script->coroutines.end())
+		{
+			LuaCoroutine& coroutine = *it;
+			int numArgs = 0;
+
+			if (coroutine.waitsForChange)
+			{
+				u32 value;
+				if (!ReadWatchedValue(coroutine, &value) || (coroutine.hasValue && value == coroutine.value))
+				{
+					++it;
+					continue;
+				}
+
+				//Returned by WaitUntilAddressChanges
+				lua_pushinteger(coroutine.thread, value);
+				numArgs = 1;
+			}
+			else if (coroutine.resumeUpdate > s_scriptUpdate)
+			{
+				++it;
+				continue;
+			}
+
+			//A plain coroutine.yield() waits for the next update
+			coroutine.waitsForChange = false;
+			coroutine.resumeUpdate = s_scriptUpdate + 1;
+
+			s_currentCoroutine = &coroutine;
+#if LUA_VERSION_NUM >= 502
+			const int result = lua_resume(coroutine.thread, script->luaState, numArgs);
+#else
+			const int result = lua_resume(coroutine.thread, numArgs);
+#endif
+			s_currentCoroutine = nullptr;
+
+			if (result == LUA_YIELD)
+			{
+				lua_settop(coroutine.thread, 0);
+				++it;
+				continue;
+			}
+
+			if (result != 0)
+			{
+				HandleLuaErrors(coroutine.thread, result);
+				status = result;
+			}
+
+			luaL_unref(script->luaState, LUA_REGISTRYINDEX, coroutine.threadRef);
+			it = script->coroutines.erase(it);
+
+			if (status != 0)
+				break;
+		}
+
+		script->frameTimeUs += Common::Timer::GetTimeUs() - start;
+		return status;
+	}
+
+	static void PublishScriptTimings()
+	{
+		std::lock_guard lk(s_timingsLock);
+		s_timings.clear();
+
+		for (LuaScript& script : scriptList)
+		{
+			if (!script.hasStarted)
+				continue;
+
+			script.totalTimeUs += script.frameTimeUs;
+			++script.frameCount;
+
+			ScriptTiming& timing = s_timings.emplace_back();
+			timing.fileName = script.fileName;
+			timing.lastFrameUs = script.frameTimeUs;
+			timing.totalUs = script.totalTimeUs;
+			timing.frames = script.frameCount;
+
+			script.frameTimeUs = 0;
+		}
+	}
+
+	std::vector<ScriptTiming> GetScriptTimings()
+	{
+		std::lock_guard lk(s_timingsLock);
+		std::vector<ScriptTiming> timings = s_timings;
+		timings.insert(timings.end(), s_asyncTimings.begin(), s_asyncTimings.end());
+		return timings;
+	}
+
+	//Runs one snapshot frame of every asynchronous script. Only called by the worker while it owns
+	//s_asyncScripts.
+	static void RunAsyncFrame(std::vector<std::string>* terminations)
+	{
+		s_asyncPointerCache.Invalidate();
+
+		std::vector<ScriptTiming> timings;
+
+		std::list<LuaScript>::iterator it = s_asyncScripts.begin();
+
+		while (it != s_asyncScripts.end())
+		{
+			s_currentAsyncScript = &*it;
+
+			if (std::find(terminations->begin(), terminations->end(), it->fileName) != terminations->end())
+				it->requestedTermination = true;
+
+			int status = 0;
+
+			if (!it->requestedTermination)
+			{
+				status = TimedCallback(&*it, it->onScriptUpdateRef);
+
+				if (status != 0)
+					HandleLuaErrors(it->luaState, status);
+			}
+
+			if (status == 0 && it->requestedTermination)
+			{
+				status = CallCallback(it->luaState, it->onScriptCancelRef);
+
+				if (status != 0)
+					HandleLuaErrors(it->luaState, status);
+
+				status = -1;
+			}
+
+			s_currentAsyncScript = nullptr;
+
+			if (status != 0)
+			{
+				lua_close(it->luaState);
+				it = s_asyncScripts.erase(it);
+				continue;
+			}
+
+			it->totalTimeUs += it->frameTimeUs;
+			++it->frameCount;
+
+			ScriptTiming& timing = timings.emplace_back();
+			timing.fileName = it->fileName + " (async)";
+			timing.lastFrameUs = it->frameTimeUs;
+			timing.totalUs = it->totalTimeUs;
+			timing.frames = it->frameCount;
+
+			it->frameTimeUs = 0;
+			++it;
+		}
+
+		std::lock_guard lk(s_timingsLock);
+		s_asyncTimings = std::move(timings);
+	}
+
+	static void AsyncThreadFunc()
+	{
+		Common::SetCurrentThreadName("Lua Scripts");
+
+		std::unique_lock lk(s_asyncLock);
+
+		while (true)
+		{
+			s_asyncWakeup.wait(lk, [] { return s_asyncBusy || s_asyncQuit; });
+
+			if (s_asyncQuit)
+				break;
+
+			std::vector<std::string> terminations = std::move(s_asyncTerminations);
+			s_asyncTerminations.clear();
+
+			lk.unlock();
+			RunAsyncFrame(&terminations);
+			lk.lock();
+
+			s_asyncBusy = false;
+		}
+	}
+
+	static void CopyToSnapshot(std::vector<u8>* buffer, const u8* source, size_t size)
+	{
+		if (!source)
+		{
+			buffer->clear();
+			return;
+		}
+
+		buffer->resize(size);
+		std::memcpy(buffer->data(), source, size);
+	}
+
+	//Hands the finished frame to the worker, unless it is still busy with an earlier one
+	static void PublishAsyncFrame()
+	{
+		std::unique_lock lk(s_asyncLock);
+
+		if (s_asyncBusy)
+			return;
+
+		s_asyncScripts.splice(s_asyncScripts.end(), s_pendingAsyncScripts);
+
+		if (s_asyncScripts.empty())
+			return;
+
+		const RAMView live = RAMView::Live();
+		CopyToSnapshot(&s_snapshot.mem1, live.mem1, live.mem1_size);
+		CopyToSnapshot(&s_snapshot.mem2, live.mem2, live.mem2_size);
+		s_snapshot.view.mem1 = s_snapshot.mem1.empty() ? nullptr : s_snapshot.mem1.data();
+		s_snapshot.view.mem1_size = s_snapshot.mem1.size();
+		s_snapshot.view.mem2 = s_snapshot.mem2.empty() ? nullptr : s_snapshot.mem2.data();
+		s_snapshot.view.mem2_size = s_snapshot.mem2.size();
+		s_snapshot.frame = Movie::GetCurrentFrame();
+		s_snapshot.inputCount = Movie::GetCurrentInputCount();
+
+		if (!s_asyncThread.joinable())
+		{
+			s_asyncQuit = false;
+			s_asyncThread = std::thread(AsyncThreadFunc);
+		}
+
+		s_asyncBusy = true;
+		lk.unlock();
+		s_asyncWakeup.notify_one();
+	}
+
+	static void StopAsyncThread()
+	{
+		{
+			std::lock_guard lk(s_asyncLock);
+			s_asyncQuit = true;
+		}
+
+		s_asyncWakeup.notify_one();
+
+		if (s_asyncThread.joinable())
+			s_asyncThread.join();
+
+		for (std::list<LuaScript>* list : {&s_asyncScripts, &s_pendingAsyncScripts})
+		{
+			for (LuaScript& script : *list)
+				lua_close(script.luaState);
+
+			list->clear();
+		}
+
+		s_asyncTerminations.clear();
+		s_asyncBusy = false;
+		s_snapshot = {};
+		s_asyncPointerCache.Clear();
+	}
+
+	//Called for every GC controller poll. The scripts run once per poll cycle, when the first port
+	//of a new cycle is polled, and their input changes are applied to every port of that cycle.
+	void UpdateScripts(GCPadStatus* PadStatus, int controllerID)
 	{
-		if (!Core::IsRunningAndStarted())
+		if (!Core::IsRunningAndStarted() || controllerID < 0 || controllerID >= 4)
 			return;
 
-		//Update Local Pad
-		PadLocal = *PadStatus;
+		const bool newCycle = controllerID <= s_lastPolledPort || s_lastPolledPort < 0;
+		s_lastPolledPort = controllerID;
+
+		if (newCycle)
+		{
+			static CPUTimeBreakdown::Counter* const timeCounter =
+				CPUTimeBreakdown::GetCounter(CPUTimeBreakdown::Category::Lua, "Scripts");
+			CPUTimeBreakdown::Scope timeScope(timeCounter);
+			RunScripts();
+		}
+
+		ApplyPadOverride(s_padOverrides[controllerID], PadStatus);
+	}
+
+	//Called every input frame (60 times per second in TP)
+	static void RunScripts()
+	{
+		s_padOverrides = {};
+		++s_scriptUpdate;
+
+		//The game ran since the last update, so any cached pointer hops are stale
+		InvalidatePointerCache();
 
 		//Iterate through all the loaded LUA Scripts
 		int n = 0;
@@ -1027,9 +1991,13 @@ namespace Lua
 
 				//Register C Functions
 				RegisterGeneralLuaFunctions(it->luaState);
+				RegisterButtonTable(it->luaState);
 
 				//Unique to normal Scripts
 				lua_register(it->luaState, "CancelScript", CancelScript);
+				lua_register(it->luaState, "StartCoroutine", StartCoroutine);
+				lua_register(it->luaState, "WaitFrames", WaitFrames);
+				lua_register(it->luaState, "WaitUntilAddressChanges", WaitUntilAddressChanges);
 
 				std::string file = SYSDATA_DIR "/Scripts/" + it->fileName;
 
@@ -1038,9 +2006,16 @@ namespace Lua
 				if (status == 0)
 				{
 					//Execute Start function
-					lua_getglobal(it->luaState, "onScriptStart");
+					status = CallCallback(it->luaState, GetCallbackRef(it->luaState, "onScriptStart"));
+				}
 
-					status = lua_pcall(it->luaState, 0, LUA_MULTRET, 0);
+				if (status == 0)
+				{
+					//Resolve the per-frame hooks once instead of looking them up by name every frame
+					it->onScriptUpdateRef = GetCallbackRef(it->luaState, "onScriptUpdate");
+					it->onScriptCancelRef = GetCallbackRef(it->luaState, "onScriptCancel");
+					it->onStateSavedRef = GetCallbackRef(it->luaState, "onStateSaved");
+					it->onStateLoadedRef = GetCallbackRef(it->luaState, "onStateLoaded");
 				}
 
 				if (status != 0)
@@ -1051,6 +2026,16 @@ namespace Lua
 					it = scriptList.erase(it);
 					--n;
 				}
+				else if (it->runAsync)
+				{
+					//From now on the script belongs to the scripting thread
+					it->hasStarted = true;
+
+					std::lock_guard lk(s_asyncLock);
+					s_pendingAsyncScripts.splice(s_pendingAsyncScripts.end(), scriptList, it++);
+					status = -1;
+					--n;
+				}
 				else
 				{
 					it->hasStarted = true;
@@ -1058,9 +2043,7 @@ namespace Lua
 			}
 			else if (it->requestedTermination) //Cancel Script and delete the entry from the list
 			{
-				lua_getglobal(it->luaState, "onScriptCancel");
-
-				status = lua_pcall(it->luaState, 0, LUA_MULTRET, 0);
+				status = CallCallback(it->luaState, it->onScriptCancelRef);
 
 				if (status != 0)
 				{
@@ -1083,9 +2066,7 @@ namespace Lua
 						//Saved State Callback
 						it->wantsSavestateCallback = false;
 
-						lua_getglobal(it->luaState, "onStateSaved");
-
-						status = lua_pcall(it->luaState, 0, LUA_MULTRET, 0);
+						status = TimedCallback(&*it, it->onStateSavedRef);
 
 						if (status != 0)
 						{
@@ -1105,9 +2086,7 @@ namespace Lua
 						//Loaded State Callback
 						it->wantsSavestateCallback = false;
 
-						lua_getglobal(it->luaState, "onStateLoaded");
-
-						status = lua_pcall(it->luaState, 0, LUA_MULTRET, 0);
+						status = TimedCallback(&*it, it->onStateLoadedRef);
 
 						if (status != 0)
 						{
@@ -1125,11 +2104,9 @@ namespace Lua
 				}
 
 				//Call normal Update function
-				if (status == 0)
+				if (status == 0 && it->onScriptUpdateRef != LUA_NOREF)
 				{
-					lua_getglobal(it->luaState, "onScriptUpdate");
-
-					status = lua_pcall(it->luaState, 0, LUA_MULTRET, 0);
+					status = TimedCallback(&*it, it->onScriptUpdateRef);
 
 					if (status != 0)
 					{
@@ -1140,6 +2117,20 @@ namespace Lua
 						--n;
 					}
 				}
+
+				//Resume the coroutines whose wait is over
+				if (status == 0 && !it->coroutines.empty())
+				{
+					status = ResumeCoroutines(&*it);
+
+					if (status != 0)
+					{
+						lua_close(it->luaState);
+
+						it = scriptList.erase(it);
+						--n;
+					}
+				}
 			}
 
 			if (status == 0) //Next item in the list if no deletion took place
@@ -1148,8 +2139,9 @@ namespace Lua
 			++n;
 		}
 
-		//Send changed Pad back
-		*PadStatus = PadLocal;
+		PublishScriptTimings();
+		PublishAsyncFrame();
+		ScriptOverlay::EndFrame();
 	}
 
 }
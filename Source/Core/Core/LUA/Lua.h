@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <list>
 #include <string>
+#include <vector>
 #include "Common/CommonTypes.h"
+#include "Core/PointerPath.h"
 //#include "DolphinWX/Main.h"
 
 #include <lua.hpp>
@@ -21,6 +24,11 @@ int ReadValue16(lua_State *L);
 int ReadValue32(lua_State *L);
 int ReadValueFloat(lua_State *L);
 int ReadValueString(lua_State *L);
+int ReadBlock(lua_State *L);
+int ReadArray8(lua_State *L);
+int ReadArray16(lua_State *L);
+int ReadArray32(lua_State *L);
+int ReadArrayFloat(lua_State *L);
 int WriteValue8(lua_State *L);
 int WriteValue16(lua_State *L);
 int WriteValue32(lua_State *L);
@@ -36,13 +44,28 @@ int SetCStickX(lua_State *L);
 int SetCStickY(lua_State *L);
 int SaveState(lua_State *L);
 int LoadState(lua_State *L);
+int SaveStateToMemory(lua_State *L);
+int LoadStateFromMemory(lua_State *L);
 int GetFrameCount(lua_State *L);
 int GetInputFrameCount(lua_State *L);
 int SetScreenText(lua_State *L);
+int DrawScreenText(lua_State *L);
+int DrawScreenLine(lua_State *L);
+int DrawScreenRect(lua_State *L);
+int FillScreenRect(lua_State *L);
+int ClearScreen(lua_State *L);
 int PauseEmulation(lua_State *L);
+int StepFrames(lua_State *L);
 int SetInfoDisplay(lua_State *L);
 int MsgBox(lua_State *L);
+int RunAsync(lua_State *L);
+#ifdef USE_LUAJIT
+int GetRAMPointers(lua_State *L);
+#endif
 int CancelScript(lua_State *L);
+int StartCoroutine(lua_State *L);
+int WaitFrames(lua_State *L);
+int WaitUntilAddressChanges(lua_State *L);
 void HandleLuaErrors(lua_State *L, int status);
 struct GCPadStatus;
 
@@ -56,6 +79,24 @@ namespace Lua
 		std::string fileName = "";
 	};
 
+	//A function started with StartCoroutine. It's only resumed once the wait it yielded with is
+	//over, so waiting costs no calls into Lua.
+	struct LuaCoroutine
+	{
+		lua_State* thread;
+		int threadRef;
+
+		//Number of the first script update it's resumed in
+		u64 resumeUpdate = 0;
+
+		//Set while waiting for the value at the end of the path to change
+		bool waitsForChange = false;
+		PointerPath path;
+		u32 size = 0;
+		bool hasValue = false;
+		u32 value = 0;
+	};
+
 	struct LuaScript
 	{
 		std::string fileName;
@@ -63,6 +104,28 @@ namespace Lua
 		bool hasStarted;
 		bool requestedTermination;
 		bool wantsSavestateCallback;
+		bool runAsync = false;
+
+		//Registry references to the script's hooks, LUA_NOREF if not defined
+		int onScriptUpdateRef = LUA_NOREF;
+		int onScriptCancelRef = LUA_NOREF;
+		int onStateSavedRef = LUA_NOREF;
+		int onStateLoadedRef = LUA_NOREF;
+
+		std::list<LuaCoroutine> coroutines;
+
+		//Time spent in hooks during the current frame, and in total
+		u64 frameTimeUs = 0;
+		u64 totalTimeUs = 0;
+		u64 frameCount = 0;
+	};
+
+	struct ScriptTiming
+	{
+		std::string fileName;
+		u64 lastFrameUs;
+		u64 totalUs;
+		u64 frames;
 	};
 
 	//Dragonbane: LUA Savestate support
@@ -77,19 +140,34 @@ namespace Lua
 	void LoadScript(std::string fileName);
 	void TerminateScript(std::string fileName);
 	bool IsScriptRunning(std::string fileName);
-	void UpdateScripts(GCPadStatus* PadStatus);
+	void UpdateScripts(GCPadStatus* PadStatus, int controllerID);
+	std::vector<ScriptTiming> GetScriptTimings();
+
+	//Scripts that call RunAsync() while starting run on a separate thread, against a snapshot of
+	//MEM1/MEM2 taken at the end of each frame. They can read memory but not change emulation state.
+	bool IsAsyncContext();
+	const u8* GetReadPointer(u32 address, size_t size);
+	u64 GetSnapshotFrame();
+	u64 GetSnapshotInputCount();
     u32 readPointer(u32 startAddress, u32 offset);
 	u32 normalizePointer(u32 pointer);
     u32 ExecuteMultilevelLoop(lua_State *L);
+	void InvalidatePointerCache();
     bool IsInMEMArea(u32 pointer);
 
-	void iPressButton(const char* button);
-	void iReleaseButton(const char* button);
-	void iSetMainStickX(int xVal);
-	void iSetMainStickY(int yVal);
-	void iSetCStickX(int xVal);
-	void iSetCStickY(int yVal);
+	u16 GetButtonMask(lua_State* L, int index);
+	int GetPortArgument(lua_State* L, int index);
+	void iPressButton(u16 mask, int port);
+	void iReleaseButton(u16 mask, int port);
+	void iSetMainStickX(int xVal, int port);
+	void iSetMainStickY(int yVal, int port);
+	void iSetCStickX(int xVal, int port);
+	void iSetCStickY(int yVal, int port);
 	void iSaveState(bool toSlot, int slotID, std::string fileName);
 	void iLoadState(bool fromSlot, int slotID, std::string fileName);
+	void iRunCurrentScriptAsync();
 	void iCancelCurrentScript();
+	void iStartCoroutine(lua_State* L);
+	int iWaitFrames(lua_State* L, u64 frames);
+	int iWaitUntilAddressChanges(lua_State* L, const PointerPath& path, u32 size);
 } // namespace Lua
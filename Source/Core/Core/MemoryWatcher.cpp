@@ -1,20 +1,29 @@
 // Copyright 2015 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <unistd.h>
 
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/MemoryWatcher.h"
-#include "Core/PowerPC/MMU.h"
 
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
+  m_binary = Config::Get(Config::MAIN_MEMORYWATCHER_BINARY);
+  m_poll_point = Config::Get(Config::MAIN_MEMORYWATCHER_POLL_ON_INPUT) ? PollPoint::InputPoll :
+                                                                         PollPoint::FrameEnd;
+  m_interval = static_cast<u32>(std::max(Config::Get(Config::MAIN_MEMORYWATCHER_INTERVAL), 1));
+  m_polls_until_read = 1;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
   if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
@@ -42,19 +51,27 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
-
   std::istringstream offsets(line);
   offsets >> std::hex;
+
+  PointerPath path;
+  if (!(offsets >> path.base))
+    return;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    path.offsets.push_back(offset);
+
+  const auto existing = std::find_if(m_watches.begin(), m_watches.end(),
+                                     [&](const Watch& watch) { return watch.address == line; });
+  if (existing != m_watches.end())
+    return;
+
+  m_watches.push_back(Watch{line, m_resolver.Add(path), 0});
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -66,16 +83,29 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+void MemoryWatcher::ReadValues()
 {
-  u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  // All watches are resolved in one pass, sharing the reads of common root pointers
+  m_resolver.Invalidate();
+  m_resolver.Resolve();
+
+  m_changed.clear();
+  for (size_t i = 0; i < m_watches.size(); ++i)
   {
-    value = PowerPC::HostRead_U32(value + offset);
-    if (!PowerPC::HostIsRAMAddress(value))
-      break;
+    Watch& watch = m_watches[i];
+
+    u32 new_value = 0;
+    if (const std::optional<u32> resolved = m_resolver.GetAddress(watch.path))
+    {
+      if (const u8* ptr = Memory::GetPointerForRange(*resolved, sizeof(u32)))
+        new_value = Common::swap32(ptr);
+    }
+    if (new_value != watch.value)
+    {
+      watch.value = new_value;
+      m_changed.push_back(i);
+    }
   }
-  return value;
 }
 
 std::string MemoryWatcher::ComposeMessages()
@@ -83,28 +113,48 @@ std::string MemoryWatcher::ComposeMessages()
   std::ostringstream message_stream;
   message_stream << std::hex;
 
-  for (auto& entry : m_values)
-  {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
-    {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
-    }
-  }
+  for (const size_t index : m_changed)
+    message_stream << m_watches[index].address << '\n' << m_watches[index].value << '\n';
 
   return message_stream.str();
 }
 
-void MemoryWatcher::Step()
+std::vector<u32> MemoryWatcher::ComposeBinaryMessage()
 {
-  if (!m_running)
+  std::vector<u32> message;
+  message.reserve(1 + m_changed.size() * 2);
+  message.push_back(m_poll_count);
+  for (const size_t index : m_changed)
+  {
+    message.push_back(static_cast<u32>(index));
+    message.push_back(m_watches[index].value);
+  }
+  return message;
+}
+
+void MemoryWatcher::Step(PollPoint point)
+{
+  if (!m_running || point != m_poll_point)
     return;
 
+  ++m_poll_count;
+  if (--m_polls_until_read != 0)
+    return;
+  m_polls_until_read = m_interval;
+
+  ReadValues();
+
+  if (m_binary)
+  {
+    if (m_changed.empty())
+      return;
+
+    const std::vector<u32> message = ComposeBinaryMessage();
+    sendto(m_fd, message.data(), message.size() * sizeof(u32), 0,
+           reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
+    return;
+  }
+
   std::string message = ComposeMessages();
   sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
@@ -3,11 +3,14 @@
 
 #pragma once
 
-#include <map>
+#include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+#include "Core/PointerPath.h"
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
@@ -16,28 +19,53 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// In binary mode (MemoryWatcher.Binary), all changes of one poll are sent as a single datagram
+// instead, and nothing is sent for polls without changes. The datagram starts with the number of
+// the poll, followed by an (ID, value) pair per changed address, where the ID is the index of the
+// address in the input file. All fields are u32 in host byte order.
 class MemoryWatcher final
 {
 public:
+  enum class PollPoint
+  {
+    FrameEnd,
+    InputPoll,
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
-  void Step();
+  void Step(PollPoint point);
 
 private:
+  struct Watch
+  {
+    // Address as stored in the file
+    std::string address;
+    PointerPathResolver::PathID path;
+    u32 value;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
+  void ReadValues();
   std::string ComposeMessages();
+  std::vector<u32> ComposeBinaryMessage();
 
   bool m_running = false;
+  bool m_binary = false;
+  PollPoint m_poll_point = PollPoint::FrameEnd;
+  u32 m_interval = 1;
+  u32 m_polls_until_read = 1;
+  u32 m_poll_count = 0;
 
   int m_fd;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::vector<Watch> m_watches;
+  // Indices into m_watches of the watches whose value changed in the last read
+  std::vector<size_t> m_changed;
+  PointerPathResolver m_resolver;
 };
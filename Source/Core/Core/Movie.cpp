@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstring>
 #include <iomanip>
@@ -12,6 +13,7 @@
 #include <mbedtls/config.h>
 #include <mbedtls/md.h>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <thread>
 #include <utility>
@@ -19,6 +21,7 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -27,6 +30,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
@@ -63,9 +67,15 @@
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
 #include "Core/NetPlayProto.h"
+#include "Core/PointerPath.h"
 #include "Core/State.h"
+#include "Core/StateHasher.h"
 #include "Core/WiiUtils.h"
 
+#ifdef USE_REMOTECONTROL_SOCKET
+#include "Core/RemoteControlSocket.h"
+#endif
+
 #include "DiscIO/Enums.h"
 
 #include "InputCommon/GCPadStatus.h"
@@ -91,6 +101,15 @@ static ControllerState s_padState;
 static DTMHeader tmpHeader;
 static std::vector<u8> s_temp_input;
 static u64 s_currentByte = 0;
+
+// The input log is hashed in chained chunks: s_input_hash_checkpoints[i] is the hash of the first
+// i * INPUT_HASH_CHUNK_SIZE bytes, so the hash of any prefix only needs its last partial chunk.
+// Savestates carry the checkpoints up to their position followed by the hash of the whole prefix,
+// which lets a read-only reload verify the movie with one comparison, and locate a mismatch by
+// comparing only the first chunk whose checkpoint differs.
+constexpr size_t INPUT_HASH_CHUNK_SIZE = 0x10000;
+static std::vector<u64> s_input_hash_checkpoints{0};
+static std::vector<u64> s_state_input_hashes;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
 static u64 s_totalLagCount = 0;                               // just stats
@@ -112,9 +131,70 @@ static u32 s_DSPcoefHash = 0;
 static bool s_bRecordingFromSaveState = false;
 static bool s_bPolled = false;
 
-// s_InputDisplay is used by both CPU and GPU (is mutable).
-static std::mutex s_input_display_lock;
-static std::string s_InputDisplay[8];
+// Hashes of the emulated state, one per interval of s_state_hash_interval frames, which are stored
+// after the input log. A hash of 0 means that the interval wasn't hashed, e.g. because a state was
+// loaded in the middle of it.
+static u16 s_state_hash_interval = 0;
+static std::vector<u64> s_state_hashes;
+static std::optional<StateHasher> s_state_hasher;
+static bool s_desync_reported = false;
+
+// The last input of a controller, written by the CPU thread at every poll and only formatted by
+// the GPU thread when the input display is shown. The sequence counter works as a seqlock: it is
+// odd while the input is being written, and a reader that sees it change copies the input again.
+// A sequence of 0 means that there is no input yet.
+template <typename T>
+class InputDisplaySlot
+{
+public:
+  void Write(const T& input)
+  {
+    const u32 sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&m_input, &input, sizeof(T));
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  bool Read(T* input) const
+  {
+    while (true)
+    {
+      const u32 sequence = m_sequence.load(std::memory_order_acquire);
+      if (sequence == 0)
+        return false;
+      if (sequence & 1)
+        continue;
+
+      std::memcpy(input, &m_input, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (m_sequence.load(std::memory_order_relaxed) == sequence)
+        return true;
+    }
+  }
+
+  void Clear() { m_sequence.store(0, std::memory_order_release); }
+
+private:
+  std::atomic<u32> m_sequence{0};
+  T m_input{};
+};
+
+// A Wii Remote data report, along with what's needed to decrypt its extension data
+struct WiimoteDisplayInput
+{
+  InputReportID mode;
+  std::array<u8, 32> data;
+  u8 size;
+  int ext;
+  EncryptionKey key;
+};
+
+static std::array<InputDisplaySlot<ControllerState>, 4> s_pad_display;
+static std::array<InputDisplaySlot<WiimoteDisplayInput>, 4> s_wiimote_display;
 
 static GCManipFunction s_gc_manip_func;
 static WiiManipFunction s_wii_manip_func;
@@ -122,11 +202,144 @@ static WiiManipFunction s_wii_manip_func;
 static std::string s_current_file_name;
 
 static void GetSettings();
+static std::string GetInputDisplayString(const ControllerState& padState, int controllerID);
+static std::string GetWiiInputDisplayString(int remoteID, const WiimoteDisplayInput& input);
+
+// Drops the hash checkpoints covering bytes at or after from_byte
+static void InvalidateInputHashes(u64 from_byte)
+{
+  const size_t valid_checkpoints = static_cast<size_t>(from_byte / INPUT_HASH_CHUNK_SIZE) + 1;
+  if (s_input_hash_checkpoints.size() > valid_checkpoints)
+    s_input_hash_checkpoints.resize(valid_checkpoints);
+}
+
+static u64 GetInputPrefixHash(u64 length)
+{
+  const size_t chunk = static_cast<size_t>(length / INPUT_HASH_CHUNK_SIZE);
+  while (s_input_hash_checkpoints.size() <= chunk)
+  {
+    const size_t offset = (s_input_hash_checkpoints.size() - 1) * INPUT_HASH_CHUNK_SIZE;
+    s_input_hash_checkpoints.push_back(
+        XXH64(&s_temp_input[offset], INPUT_HASH_CHUNK_SIZE, s_input_hash_checkpoints.back()));
+  }
+
+  const size_t offset = chunk * INPUT_HASH_CHUNK_SIZE;
+  return XXH64(s_temp_input.data() + offset, static_cast<size_t>(length) - offset,
+               s_input_hash_checkpoints[chunk]);
+}
+
+// Fills out with the checkpoints covering the first length bytes, followed by their prefix hash
+static void GetInputHashes(u64 length, std::vector<u64>* out)
+{
+  const u64 prefix_hash = GetInputPrefixHash(length);
+  const size_t chunk = static_cast<size_t>(length / INPUT_HASH_CHUNK_SIZE);
+  out->assign(s_input_hash_checkpoints.begin(), s_input_hash_checkpoints.begin() + chunk + 1);
+  out->push_back(prefix_hash);
+}
+
+// Returns whether the input up to s_currentByte matches the hashes saved in the loaded state
+static bool DoesInputMatchStateHashes()
+{
+  const size_t chunk = static_cast<size_t>(s_currentByte / INPUT_HASH_CHUNK_SIZE);
+  return s_state_input_hashes.size() == chunk + 2 &&
+         GetInputPrefixHash(s_currentByte) == s_state_input_hashes.back();
+}
+
+// Returns the offset of the first input chunk whose checkpoint differs from the loaded state's,
+// which is where a byte comparison against the state's movie has to start
+static u64 GetFirstMismatchingInputChunk()
+{
+  const size_t chunk = static_cast<size_t>(s_currentByte / INPUT_HASH_CHUNK_SIZE);
+  if (s_state_input_hashes.size() != chunk + 2)
+    return 0;
+
+  GetInputPrefixHash(s_currentByte);
+  for (size_t i = 1; i <= chunk; i++)
+  {
+    if (s_input_hash_checkpoints[i] != s_state_input_hashes[i])
+      return static_cast<u64>(i - 1) * INPUT_HASH_CHUNK_SIZE;
+  }
+  return static_cast<u64>(chunk) * INPUT_HASH_CHUNK_SIZE;
+}
+
+// Overwrites the input log from s_currentByte onwards, discarding anything after it
+static void WriteInput(const void* data, size_t size)
+{
+  InvalidateInputHashes(s_currentByte);
+  s_temp_input.resize(static_cast<size_t>(s_currentByte));
+  const u8* bytes = static_cast<const u8*>(data);
+  s_temp_input.insert(s_temp_input.end(), bytes, bytes + size);
+  s_currentByte += size;
+}
+
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
   return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
 }
 
+// Size of the state hashes at the end of a movie file
+static u64 GetStateHashesSize(const DTMHeader& header, u64 file_size)
+{
+  const u64 size = u64{header.stateHashCount} * sizeof(u64);
+  return size <= file_size - sizeof(DTMHeader) ? size : 0;
+}
+
+// Reads the input log and the state hashes of a movie file
+static void ReadMovieData(const File::MappedFile& file, const DTMHeader& header)
+{
+  if (!file.IsOpen() || file.GetSize() < sizeof(DTMHeader))
+  {
+    s_temp_input.clear();
+    s_state_hashes.clear();
+    return;
+  }
+
+  const u64 hashes_size = GetStateHashesSize(header, file.GetSize());
+  const u8* input = file.GetData() + sizeof(DTMHeader);
+  const u8* hashes = file.GetData() + file.GetSize() - hashes_size;
+  s_temp_input.assign(input, hashes);
+  s_state_hashes.resize(hashes_size / sizeof(u64));
+  std::memcpy(s_state_hashes.data(), hashes, hashes_size);
+}
+
+// Hashes the state at the end of every movie frame. While recording the hashes are stored, during
+// playback they are compared to the recorded ones, and the first mismatch is reported.
+static void UpdateStateHash()
+{
+  if (s_state_hash_interval == 0 || !IsMovieActive())
+    return;
+
+  if (!s_state_hasher || s_state_hasher->GetInterval() != s_state_hash_interval)
+    s_state_hasher.emplace(s_state_hash_interval);
+
+  const u64 frame = s_currentFrame - 1;
+  const std::optional<u64> hash = s_state_hasher->OnFrame(frame);
+  if (!hash)
+    return;
+
+  const size_t index = static_cast<size_t>(frame / s_state_hash_interval);
+  if (IsRecordingInput())
+  {
+    // Like the input, the hashes after the current frame are replaced
+    s_state_hashes.resize(index);
+    s_state_hashes.push_back(*hash);
+    return;
+  }
+
+  if (s_desync_reported || index >= s_state_hashes.size() || s_state_hashes[index] == 0 ||
+      s_state_hashes[index] == *hash)
+  {
+    return;
+  }
+
+  s_desync_reported = true;
+  const u64 first_frame = static_cast<u64>(index) * s_state_hash_interval;
+  const std::string message =
+      fmt::format("Movie desynced between frames {} and {}", first_frame, frame);
+  ERROR_LOG_FMT(CORE, "{}", message);
+  Core::DisplayMessage(message, 10000);
+}
+
 static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
 {
   std::array<u8, 20> revision_bytes{};
@@ -176,299 +389,321 @@ std::string GetInputDisplay()
   }
 
   std::string input_display;
+  for (int i = 0; i < 4; ++i)
   {
-    std::lock_guard guard(s_input_display_lock);
-    for (int i = 0; i < 4; ++i)
-    {
-      if (IsUsingPad(i))
-        input_display += s_InputDisplay[i] + '\n';
-    }
-    for (int i = 0; i < 4; ++i)
+    if (!IsUsingPad(i))
+      continue;
+
+    ControllerState pad_state;
+    if (s_pad_display[i].Read(&pad_state))
+      input_display += GetInputDisplayString(pad_state, i);
+    input_display += '\n';
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    if (!IsUsingWiimote(i))
+      continue;
+
+    WiimoteDisplayInput wiimote_input;
+    if (s_wiimote_display[i].Read(&wiimote_input))
+      input_display += GetWiiInputDisplayString(i, wiimote_input);
+    input_display += '\n';
+  }
+  return input_display;
+}
+
+namespace
+{
+// Extra formatting applied to 2 byte values, selected with ">> Hint" in the InfoDisplay INI.
+enum class RAMDisplayHint
+{
+  None,
+  Degrees,
+  Seconds,
+  Minutes,
+  Other,
+};
+
+// One "%Tn" argument of a display line, fully parsed. Evaluating it only needs memory reads.
+struct RAMDisplayOp
+{
+  std::string prefix;  // literal text preceding the argument
+  char type = 0;       // printf conversion letter
+  int num_bytes = 0;
+  PointerPath path;  // no offsets for a direct read
+  PointerPathResolver::PathID path_id = 0;
+  RAMDisplayHint hint = RAMDisplayHint::None;
+};
+
+struct RAMDisplayLine
+{
+  std::vector<RAMDisplayOp> ops;
+};
+
+struct RAMDisplayProgram
+{
+  std::string game_id;
+  std::string path;
+  s64 mtime = 0;
+  bool exists = false;
+  std::vector<RAMDisplayLine> lines;
+  PointerPathResolver resolver;
+};
+}  // namespace
+
+// Only touched from the GPU thread.
+static RAMDisplayProgram s_ram_display_program;
+static std::string s_ram_display_text;
+static u32 s_ram_display_last_check_ms = 0;
+
+// How often the INI is stat'ed to pick up edits while a game is running.
+constexpr u32 RAM_DISPLAY_RECHECK_MS = 1000;
+
+static u32 ParseHex(const std::string& str)
+{
+  return static_cast<u32>(strtol(str.c_str(), nullptr, 16));
+}
+
+static RAMDisplayHint ParseRAMDisplayHint(const std::string& hint)
+{
+  if (hint == "Degrees")
+    return RAMDisplayHint::Degrees;
+  if (hint == "seconds")
+    return RAMDisplayHint::Seconds;
+  if (hint == "minutes")
+    return RAMDisplayHint::Minutes;
+  return RAMDisplayHint::Other;
+}
+
+// Parses "ArgN = address [+ offset ...] [>> Hint];" into op.
+static void ParseRAMDisplayArgument(const std::string& arg, RAMDisplayOp* op)
+{
+  const std::string::size_type hint_pos = arg.find(">>");
+  if (hint_pos != std::string::npos)
+    op->hint = ParseRAMDisplayHint(arg.substr(std::min(hint_pos + 3, arg.size())));
+
+  const std::string body = hint_pos != std::string::npos ? arg.substr(0, hint_pos) : arg;
+
+  std::string::size_type plus_pos = body.find('+');
+  op->path.base = ParseHex(body.substr(0, plus_pos));
+  while (plus_pos != std::string::npos)
+  {
+    op->path.offsets.push_back(ParseHex(body.substr(plus_pos + 1)));
+    plus_pos = body.find('+', plus_pos + 1);
+  }
+}
+
+static std::vector<RAMDisplayLine> CompileRAMDisplay(const std::string& ini,
+                                                     PointerPathResolver* resolver)
+{
+  std::vector<RAMDisplayLine> lines;
+
+  std::string::size_type cursor = 0;
+  for (int line_index = 1;; ++line_index)
+  {
+    const std::string::size_type line_pos = ini.find(fmt::format("Line{}", line_index), cursor);
+    if (line_pos == std::string::npos)
+      break;
+
+    const std::string::size_type open_quote = ini.find('"', line_pos);
+    if (open_quote == std::string::npos)
+      break;
+    cursor = open_quote + 1;
+
+    const std::string line = ini.substr(cursor, ini.find('"', cursor) - cursor);
+    const std::string block = ini.substr(cursor, ini.find("End Line", cursor) - cursor);
+
+    RAMDisplayLine& compiled = lines.emplace_back();
+
+    std::string::size_type text_pos = 0;
+    std::string::size_type percent_pos = line.find('%');
+    for (int arg_index = 1; percent_pos != std::string::npos; ++arg_index)
     {
-      if (IsUsingWiimote(i))
-        input_display += s_InputDisplay[i + 4] + '\n';
+      // Each argument is written as "%Tn" followed by one separator character, where T is the
+      // printf conversion and n the size of the value in bytes.
+      RAMDisplayOp op;
+      op.prefix = line.substr(text_pos, percent_pos - text_pos);
+      const std::string spec = line.substr(percent_pos + 1, 3);
+      op.type = spec.empty() ? 0 : spec[0];
+      op.num_bytes = spec.size() > 1 ? spec[1] - '0' : 0;
+      text_pos = std::min(percent_pos + 4, line.size());
+
+      const std::string::size_type arg_pos = block.find(fmt::format("Arg{}", arg_index));
+      if (arg_pos == std::string::npos)
+        break;
+      const std::string::size_type value_pos = block.find('=', arg_pos) + 1;
+      ParseRAMDisplayArgument(block.substr(value_pos, block.find(';', value_pos) - value_pos), &op);
+      if (!op.path.offsets.empty())
+        op.path_id = resolver->Add(op.path);
+
+      compiled.ops.push_back(std::move(op));
+      percent_pos = line.find('%', text_pos);
     }
   }
-  return input_display;
+
+  return lines;
+}
+
+// Recompiles the program if the game changed or the INI was modified on disk.
+static void UpdateRAMDisplayProgram()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  const bool game_changed = game_id != s_ram_display_program.game_id;
+  const u32 now = Common::Timer::GetTimeMs();
+  if (!game_changed && now - s_ram_display_last_check_ms < RAM_DISPLAY_RECHECK_MS)
+    return;
+  s_ram_display_last_check_ms = now;
+
+  if (game_changed)
+  {
+    s_ram_display_program.game_id = game_id;
+    s_ram_display_program.path = File::GetSysDirectory() + "/InfoDisplay/" + game_id + ".ini";
+  }
+
+  const File::FileInfo info(s_ram_display_program.path);
+  const s64 mtime = info.GetModificationTime();
+  if (!game_changed && info.Exists() == s_ram_display_program.exists &&
+      mtime == s_ram_display_program.mtime)
+  {
+    return;
+  }
+
+  s_ram_display_program.exists = info.Exists();
+  s_ram_display_program.mtime = mtime;
+  s_ram_display_program.lines.clear();
+  s_ram_display_program.resolver.Clear();
+
+  std::string ini;
+  if (s_ram_display_program.exists && File::ReadFileToString(s_ram_display_program.path, ini))
+  {
+    s_ram_display_program.lines = CompileRAMDisplay(ini, &s_ram_display_program.resolver);
+  }
+}
+
+template <typename... Args>
+static void AppendFormatted(std::string* out, const char* format, Args... args)
+{
+  char buffer[128];
+  const int length = snprintf(buffer, sizeof(buffer), format, args...);
+  if (length > 0)
+    out->append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+}
+
+static void AppendTwoByteValue(std::string* out, const char* format, char type, u16 value,
+                               RAMDisplayHint hint)
+{
+  switch (hint)
+  {
+  case RAMDisplayHint::Degrees:
+  {
+    int degrees = static_cast<int>(value / 182.04 + 0.5);
+    if (degrees >= 360)
+      degrees -= 360;
+    const std::string fmt_str = fmt::format("%{} (%i DEG)", type);
+    AppendFormatted(out, fmt_str.c_str(), value, degrees);
+    break;
+  }
+  case RAMDisplayHint::Seconds:
+  {
+    // ToD
+    const int time = value;
+    const int seconds = (time / 60) % 60;
+    const int fraction = static_cast<int>((static_cast<float>(time) / 60 - seconds) * 999);
+    const std::string fmt_str = fmt::format("%{}.%02i", type);
+    AppendFormatted(out, fmt_str.c_str(), seconds, fraction);
+    break;
+  }
+  case RAMDisplayHint::Minutes:
+  {
+    // ToD
+    const int time = value;
+    const int hours = time / (60 * 60 * 60);
+    const int minutes = (time / (60 * 60)) % 60;
+    const std::string fmt_str = fmt::format("%{}:%02i", type);
+    AppendFormatted(out, fmt_str.c_str(), hours, minutes);
+    break;
+  }
+  default:
+    AppendFormatted(out, format, value);
+    break;
+  }
 }
 
-	std::string GetRAMDisplay()
-	{
-	    std::string RAMDisplay = "";
+static void AppendRAMDisplayValue(std::string* out, const RAMDisplayOp& op, u32 address)
+{
+  constexpr auto space = PowerPC::RequestedAddressSpace::Virtual;
+  const char format[] = {'%', op.type, '\0'};
+  const size_t start = out->size();
 
-		// Dragonbane
-	    std::string gameID = SConfig::GetInstance().GetGameID();
-	    std::string iniContent;
+  if (op.type == 's')
+  {
+    const std::string value = PowerPC::Read_String(address, op.num_bytes);
+    out->append(value.c_str());
+  }
+  else if (op.type == 'f')
+  {
+    const auto result = PowerPC::HostTryReadF32(address + 0x80000000, space);
+    AppendFormatted(out, format, result ? result.value : 0.0f);
+  }
+  else if (op.type != 0 && std::strchr("diouxXc", op.type) != nullptr)
+  {
+    if (op.num_bytes == 4)
+    {
+      const auto result = PowerPC::HostTryReadU32(address + 0x80000000, space);
+      AppendFormatted(out, format, result ? result.value : 0);
+    }
+    else if (op.num_bytes == 2)
+    {
+      const auto result = PowerPC::HostTryReadU16(address + 0x80000000, space);
+      AppendTwoByteValue(out, format, op.type, result ? result.value : 0, op.hint);
+    }
+    else if (op.num_bytes == 1)
+    {
+      const auto result = PowerPC::HostTryReadU8(address + 0x80000000, space);
+      AppendFormatted(out, format, result ? result.value : 0);
+    }
+  }
 
-	    bool success =
-	        File::ReadFileToString(File::GetSysDirectory() +  "/InfoDisplay/" + gameID + ".ini", iniContent);
+  const size_t length = out->size() - start;
+  if (length == 0)
+    out->append("N/A");
+  else if (length < 2 && op.hint == RAMDisplayHint::None && (op.type == 'X' || op.type == 'x'))
+    out->insert(start, 1, '0');
+}
 
-	    if (success)
-	    {
-		    int lineCounter = 0;
-		    bool inProgress = true;
-		    RAMDisplay.append("\n");
+// NOTE: GPU Thread
+const std::string& GetRAMDisplay()
+{
+  // Dragonbane
+  UpdateRAMDisplayProgram();
 
-		    while (inProgress)
-		    {
-			    lineCounter++;
+  s_ram_display_text.clear();
+  if (!s_ram_display_program.exists)
+    return s_ram_display_text;
 
-			    std::string lineName = StringFromFormat("Line%i", lineCounter);
+  PointerPathResolver& resolver = s_ram_display_program.resolver;
+  resolver.Invalidate();
+  resolver.Resolve();
 
-			    std::string::size_type loc = iniContent.find(lineName, 0);
-			    if (loc == std::string::npos)
-			    {
-				    inProgress = false;
-				    break;
-			    }
+  s_ram_display_text.push_back('\n');
+  for (const RAMDisplayLine& line : s_ram_display_program.lines)
+  {
+    for (const RAMDisplayOp& op : line.ops)
+    {
+      s_ram_display_text.append(op.prefix);
 
-			    iniContent = iniContent.substr(loc);
-			    iniContent = iniContent.substr(iniContent.find("\"", 0) + 1);
+      const std::optional<u32> address =
+          op.path.offsets.empty() ? op.path.base : resolver.GetAddress(op.path_id);
+      if (address)
+        AppendRAMDisplayValue(&s_ram_display_text, op, *address);
+      else
+        s_ram_display_text.append("N/A");
+    }
+    s_ram_display_text.push_back('\n');
+  }
 
-			    std::string line = iniContent.substr(0, iniContent.find("\"", 0));
-			    std::string blockContent = iniContent.substr(0, iniContent.find("End Line", 0));
-
-			    std::string::size_type locNext = line.find("%", 0);
-			    std::string subLine = line;
-			    int argCounter = 0;
-
-			    while (locNext != std::string::npos)
-			    {
-				    argCounter++;
-
-				    std::string currSectionOutput = subLine.substr(0, locNext);
-				    subLine = subLine.substr(locNext + 1);
-				    std::string currIdenti = subLine.substr(0, 3);
-
-				    int numBytes = atoi(currIdenti.substr(1, 1).c_str());
-				    std::string identifier = "%" + currIdenti.substr(0, 1);
-				    u32 readAddress;
-
-				    subLine = subLine.substr(3);
-
-				    std::string nextArgName = StringFromFormat("Arg%i", argCounter);
-
-				    std::string::size_type locNextArg = blockContent.find(nextArgName, 0);
-
-				    if (locNextArg == std::string::npos)
-					    break;
-
-				    std::string argString = blockContent.substr(locNextArg);
-				    argString = argString.substr(argString.find("=", 0) + 1);
-				    argString = argString.substr(0, argString.find(";", 0));
-
-				    std::string::size_type locPlus = argString.find("+", 0);
-				    std::string::size_type locHint = argString.find(">>", 0);
-
-				    std::string currHint;
-
-				    if (locHint != std::string::npos)
-					    currHint = argString.substr(locHint + 3);
-
-				    if (locPlus == std::string::npos)
-				    {
-					    std::string arguString;
-
-					    if (locHint != std::string::npos)
-					    {
-						    arguString = argString.substr(0, locHint - 1);
-					    }
-					    else
-					    {
-						    arguString = argString;
-					    }
-
-					    readAddress = strtol(arguString.c_str(), nullptr, 16);
-				    }
-				    else
-				    {
-					    u32 pointerAddress;
-					    u32 offset = 0;
-
-					    pointerAddress = strtol(argString.substr(0, locPlus - 1).c_str(), nullptr, 16);
-
-						std::string arguString = argString.substr(locPlus + 2);
-
-						if (locHint != std::string::npos)
-						{
-							locHint = arguString.find(">>", 0);
-
-							arguString = arguString.substr(0, locHint - 1);
-						}
-						
-						while (locPlus != std::string::npos)
-						{
-							offset = strtol(arguString.c_str(), nullptr, 16);
-							pointerAddress = Lua::readPointer(pointerAddress, offset);
-							locPlus = argString.find("+", locPlus + 1);
-							arguString = argString.substr(locPlus + 2);
-						}			    
-						
-						readAddress = pointerAddress;
-
-						if ((readAddress == 0) || (readAddress == offset))
-						{
-							RAMDisplay.append(currSectionOutput + "N/A");
-							locNext = subLine.find("%", 0);
-							continue;
-						}
-				    }
-									   					 				  
-
-
-				    std::string finalOutput;
-
-				    if (identifier.compare("%s") == 0)
-				    {
-                                            std::string outputString = PowerPC::Read_String(readAddress, numBytes);
-                                            /*
-					    std::string outputString = "";
-                                            
-                                            PowerPC::TryReadResult<std::string> result = HostTryReadString(readAddress + 0x80000000, numBytes, PowerPC::RequestedAddressSpace::Virtual);
-                                            if (result)
-                                                outputString = result.value;
-                                                */
-
-					    finalOutput = StringFromFormat(identifier.c_str(), outputString.c_str());
-				    }
-				    else if (identifier.compare("%f") == 0)
-				    {
-					    float outputFloat = 0;
-
-                                            PowerPC::TryReadResult<float> result = HostTryReadF32(readAddress + 0x80000000, PowerPC::RequestedAddressSpace::Virtual);
-                                            if (result)
-                                                outputFloat = result.value;
-
-					    finalOutput = StringFromFormat(identifier.c_str(), outputFloat);
-				    }
-				    else if (numBytes == 4)
-				    {
-					    u32 output4Bytes = 0;
-
-                                            PowerPC::TryReadResult<u32> result = HostTryReadU32(readAddress + 0x80000000, PowerPC::RequestedAddressSpace::Virtual);
-                                            if (result)
-                                                output4Bytes = result.value;
-
-					    finalOutput = StringFromFormat(identifier.c_str(), output4Bytes);
-				    }
-				    else if (numBytes == 2)
-				    {
-					    u16 output2Bytes = 0;
-
-                                            PowerPC::TryReadResult<u16> result = HostTryReadU16(readAddress + 0x80000000, PowerPC::RequestedAddressSpace::Virtual);
-                                            if (result)
-                                                output2Bytes = result.value;
-
-					    // Special Formatting for 2 Byte
-					    if (currHint.compare("Degrees") == 0)
-					    {
-						    double degrees = output2Bytes;
-						    degrees = (degrees / 182.04) + 0.5;
-
-						    int finalDegrees = (int)degrees;
-
-						    if (finalDegrees >= 360)
-							    finalDegrees = finalDegrees - 360;
-
-						    std::string newIdentifier = identifier;
-						    newIdentifier.append(" (%i DEG)");
-
-						    finalOutput = StringFromFormat(newIdentifier.c_str(), output2Bytes, finalDegrees);
-					    }
-					    else if (currHint.compare("seconds") == 0)
-					    {
-						    // ToD
-						    int time = output2Bytes;
-						    int seconds = (time / 60) % 60;
-
-						    float miliseconds = (float)time / 60;
-						    miliseconds = (miliseconds - seconds) * 999;
-
-						    int finalMinutes = (int)miliseconds;
-
-						    std::stringstream ss;
-
-						    ss << finalMinutes;
-						    std::string minutesString = ss.str();
-
-						    if (finalMinutes < 10)
-							    minutesString = "0" + minutesString;
-
-						    std::string newIdentifier = identifier;
-						    newIdentifier.append(".%s");
-
-						    finalOutput = StringFromFormat(newIdentifier.c_str(), seconds, minutesString.c_str());
-					    }
-					    else if (currHint.compare("minutes") == 0)
-					    {
-						    // ToD
-						    int time = output2Bytes;
-						    int hours = (time / (60 * 60 * 60));
-						    int minutes = (time / (60 * 60)) % 60;
-
-						    int finalMinutes = (int)minutes;
-
-						    std::stringstream ss;
-
-						    ss << finalMinutes;
-						    std::string minutesString = ss.str();
-
-						    if (finalMinutes < 10)
-							    minutesString = "0" + minutesString;
-
-						    std::string newIdentifier = identifier;
-						    newIdentifier.append(":%s");
-
-						    finalOutput = StringFromFormat(newIdentifier.c_str(), hours, minutesString.c_str());
-					    }
-					    else
-					    {
-						    finalOutput = StringFromFormat(identifier.c_str(), output2Bytes);
-					    }
-				    }
-				    else if (numBytes == 1)
-				    {
-					    u8 output1Byte = 0;
-
-                                            PowerPC::TryReadResult<u8> result = HostTryReadU8(readAddress + 0x80000000, PowerPC::RequestedAddressSpace::Virtual);
-                                            if (result)
-                                                output1Byte = result.value;
-
-					    finalOutput = StringFromFormat(identifier.c_str(), output1Byte);
-				    }
-
-				    if (finalOutput.length() == 0)
-				    {
-					    finalOutput = "N/A";
-				    }
-				    else
-				    {
-					    if (locHint == std::string::npos)
-					    {
-						    if (identifier.compare("%X") == 0 || identifier.compare("%x") == 0)
-						    {
-							    if (finalOutput.length() < 2)
-							    {
-								    finalOutput = "0" + finalOutput;
-							    }
-						    }
-					    }
-				    }
-
-				    std::string completeOutput =
-				        StringFromFormat("%s%s", currSectionOutput.c_str(), finalOutput.c_str());
-
-				    RAMDisplay.append(completeOutput);
-
-				    locNext = subLine.find("%", 0);
-			    }
-
-			    RAMDisplay.append("\n");
-		    }
-	    }
-
-		return RAMDisplay;
-	}
+  return s_ram_display_text;
+}
 
 // NOTE: GPU Thread
 std::string GetRTCDisplay()
@@ -489,6 +724,8 @@ void FrameUpdate()
   if (!s_bPolled)
     s_currentLagCount++;
 
+  UpdateStateHash();
+
   if (IsRecordingInput())
   {
     s_totalFrames = s_currentFrame;
@@ -536,8 +773,10 @@ void Init(const BootParameters& boot)
 
   memset(&s_padState, 0, sizeof(s_padState));
 
-  for (auto& disp : s_InputDisplay)
-    disp.clear();
+  for (auto& slot : s_pad_display)
+    slot.Clear();
+  for (auto& slot : s_wiimote_display)
+    slot.Clear();
 
   if (!IsMovieActive())
   {
@@ -632,6 +871,42 @@ u64 GetCurrentInputCount()
   return s_currentInputCount;
 }
 
+u64 GetCurrentInputByte()
+{
+  return s_currentByte;
+}
+
+u64 GetInputSize()
+{
+  return s_temp_input.size();
+}
+
+u64 GetInputHash(u64 length)
+{
+  return GetInputPrefixHash(std::min<u64>(length, s_temp_input.size()));
+}
+
+bool ReadInput(u64 offset, u8* data, size_t size)
+{
+  if (offset > s_temp_input.size() || size > s_temp_input.size() - offset)
+    return false;
+
+  std::copy_n(s_temp_input.begin() + offset, size, data);
+  return true;
+}
+
+bool ReplaceInput(u64 offset, const u8* data, size_t size)
+{
+  if (offset > s_temp_input.size() || size > s_temp_input.size() - offset)
+    return false;
+
+  InvalidateInputHashes(offset);
+  std::copy_n(data, size, s_temp_input.begin() + offset);
+  // The state hashes can't tell which frames the edited input affects
+  s_state_hashes.clear();
+  return true;
+}
+
 u64 GetTotalInputCount()
 {
   return s_totalInputCount;
@@ -848,6 +1123,11 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
     s_playMode = MODE_RECORDING;
     s_author = SConfig::GetInstance().m_strMovieAuthor;
     s_temp_input.clear();
+    InvalidateInputHashes(0);
+    s_state_hash_interval = static_cast<u16>(
+        std::clamp(Config::Get(Config::MAIN_MOVIE_STATE_HASH_INTERVAL), 0, 0xFFFF));
+    s_state_hashes.clear();
+    s_state_hasher.reset();
 
     s_currentByte = 0;
 
@@ -898,8 +1178,8 @@ static std::string Analog1DToString(u32 v, const std::string& prefix, u32 range
   return fmt::format("{}:{}", prefix, v);
 }
 
-// NOTE: CPU Thread
-static void SetInputDisplayString(ControllerState padState, int controllerID)
+// NOTE: GPU Thread
+static std::string GetInputDisplayString(const ControllerState& padState, int controllerID)
 {
   std::string display_str = fmt::format("P{}:", controllerID + 1);
 
@@ -939,15 +1219,16 @@ static void SetInputDisplayString(ControllerState padState, int controllerID)
     display_str += " DISCONNECTED";
   }
 
-  std::lock_guard guard(s_input_display_lock);
-  s_InputDisplay[controllerID] = std::move(display_str);
+  return display_str;
 }
 
-// NOTE: CPU Thread
-static void SetWiiInputDisplayString(int remoteID, const DataReportBuilder& rpt, int ext,
-                                     const EncryptionKey& key)
+// NOTE: GPU Thread
+static std::string GetWiiInputDisplayString(int remoteID, const WiimoteDisplayInput& input)
 {
-  int controllerID = remoteID + 4;
+  DataReportBuilder rpt(input.mode);
+  std::memcpy(rpt.GetDataPtr(), input.data.data(), input.size);
+  const int ext = input.ext;
+  const EncryptionKey& key = input.key;
 
   std::string display_str = fmt::format("R{}:", remoteID + 1);
 
@@ -1070,8 +1351,7 @@ static void SetWiiInputDisplayString(int remoteID, const DataReportBuilder& rpt,
     display_str += Analog2DToString(right_stick.x, right_stick.y, " R-ANA", 31);
   }
 
-  std::lock_guard guard(s_input_display_lock);
-  s_InputDisplay[controllerID] = std::move(display_str);
+  return display_str;
 }
 
 // NOTE: CPU Thread
@@ -1109,7 +1389,7 @@ void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID)
   s_padState.reset = s_bReset;
   s_bReset = false;
 
-  SetInputDisplayString(s_padState, controllerID);
+  s_pad_display[controllerID].Write(s_padState);
 }
 
 // NOTE: CPU Thread
@@ -1120,16 +1400,21 @@ void RecordInput(const GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
-  s_temp_input.resize(s_currentByte + sizeof(ControllerState));
-  memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
-  s_currentByte += sizeof(ControllerState);
+  WriteInput(&s_padState, sizeof(ControllerState));
 }
 
 // NOTE: CPU Thread
 void CheckWiimoteStatus(int wiimote, const DataReportBuilder& rpt, int ext,
                         const EncryptionKey& key)
 {
-  SetWiiInputDisplayString(wiimote, rpt, ext, key);
+  WiimoteDisplayInput display_input;
+  display_input.mode = rpt.GetMode();
+  display_input.size =
+      static_cast<u8>(std::min<size_t>(rpt.GetDataSize(), display_input.data.size()));
+  std::memcpy(display_input.data.data(), rpt.GetDataPtr(), display_input.size);
+  display_input.ext = ext;
+  display_input.key = key;
+  s_wiimote_display[wiimote].Write(display_input);
 
   if (IsRecordingInput())
     RecordWiimote(wiimote, rpt.GetDataPtr(), rpt.GetDataSize());
@@ -1141,10 +1426,8 @@ void RecordWiimote(int wiimote, const u8* data, u8 size)
     return;
 
   InputUpdate();
-  s_temp_input.resize(s_currentByte + size + 1);
-  s_temp_input[s_currentByte++] = size;
-  memcpy(&s_temp_input[s_currentByte], data, size);
-  s_currentByte += size;
+  WriteInput(&size, sizeof(size));
+  WriteInput(data, size);
 }
 
 // NOTE: EmuThread / Host Thread
@@ -1185,6 +1468,7 @@ void ReadHeader()
   s_MD5 = tmpHeader.md5;
   s_DSPiromHash = tmpHeader.DSPiromHash;
   s_DSPcoefHash = tmpHeader.DSPcoefHash;
+  s_state_hash_interval = tmpHeader.stateHashInterval;
 }
 
 // NOTE: Host Thread
@@ -1219,11 +1503,16 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
 
   Core::UpdateWantDeterminism();
 
-  s_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
-  s_currentByte = 0;
   recording_file.Close();
 
+  const File::MappedFile mapped_recording(movie_path);
+  if (!mapped_recording.IsOpen() || mapped_recording.GetSize() < sizeof(DTMHeader))
+    return false;
+  ReadMovieData(mapped_recording, tmpHeader);
+  InvalidateInputHashes(0);
+  s_currentByte = 0;
+  s_desync_reported = false;
+
   // Load savestate (and skip to frame data)
   if (tmpHeader.bFromSaveState && savestate_path)
   {
@@ -1247,7 +1536,23 @@ void DoState(PointerWrap& p)
   p.Do(s_currentInputCount);
   p.Do(s_bPolled);
   p.Do(s_tickCountAtLastInput);
+
+  if (p.GetMode() == PointerWrap::MODE_WRITE || p.GetMode() == PointerWrap::MODE_MEASURE)
+  {
+    s_state_input_hashes.clear();
+    if (IsMovieActive() && s_currentByte <= s_temp_input.size())
+      GetInputHashes(s_currentByte, &s_state_input_hashes);
+  }
+  p.Do(s_state_input_hashes);
   // other variables (such as s_totalBytes and s_totalFrames) are set in LoadInput
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    // The interval in progress was partly hashed before the load
+    if (s_state_hasher)
+      s_state_hasher->Reset();
+    s_desync_reported = false;
+  }
 }
 
 // NOTE: Host Thread
@@ -1282,7 +1587,8 @@ void LoadInput(const std::string& movie_path)
   if (SConfig::GetInstance().bWii)
     ChangeWiiPads(true);
 
-  u64 totalSavedBytes = t_record.GetSize() - 256;
+  u64 totalSavedBytes =
+      t_record.GetSize() - 256 - GetStateHashesSize(tmpHeader, t_record.GetSize());
 
   bool afterEnd = false;
   // This can only happen if the user manually deletes data from the dtm.
@@ -1302,8 +1608,9 @@ void LoadInput(const std::string& movie_path)
     s_totalInputCount = tmpHeader.inputCount;
     s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
-    s_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(s_temp_input.data(), s_temp_input.size());
+    t_record.Close();
+    ReadMovieData(File::MappedFile(movie_path), tmpHeader);
+    InvalidateInputHashes(0);
   }
   else if (s_currentByte > 0)
   {
@@ -1319,17 +1626,27 @@ void LoadInput(const std::string& movie_path)
           "this state with read-only mode off.",
           s_currentByte + 256, s_temp_input.size() + 256, s_currentInputCount, s_totalInputCount);
     }
-    else if (s_currentByte > 0 && !s_temp_input.empty())
+    else if (s_currentByte > 0 && !s_temp_input.empty() && !DoesInputMatchStateHashes())
     {
-      // verify identical from movie start to the save's current frame
-      std::vector<u8> movInput(s_currentByte);
-      t_record.ReadArray(movInput.data(), movInput.size());
-
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.begin());
-
-      if (result.first != movInput.end())
+      // verify identical from movie start to the save's current frame, starting at the first
+      // chunk whose hash differs
+      t_record.Close();
+      const File::MappedFile mapped_record(movie_path);
+      const bool mapped = mapped_record.GetSize() >= sizeof(DTMHeader) + s_currentByte;
+      const u64 compare_start = GetFirstMismatchingInputChunk();
+      const u8* movInput = mapped ? mapped_record.GetData() + sizeof(DTMHeader) : nullptr;
+      const u8* movInputEnd = mapped ? movInput + s_currentByte : nullptr;
+
+      const auto result = std::mismatch(mapped ? movInput + compare_start : nullptr, movInputEnd,
+                                        s_temp_input.begin() + compare_start);
+
+      if (!mapped)
+      {
+        PanicAlertFmtT("Failed to read {0}", movie_path);
+      }
+      else if (result.first != movInputEnd)
       {
-        const ptrdiff_t mismatch_index = std::distance(movInput.begin(), result.first);
+        const ptrdiff_t mismatch_index = std::distance(movInput, result.first);
 
         // this is a "you did something wrong" alert for the user's benefit.
         // we'll try to say what's going on in excruciating detail, otherwise the user might not
@@ -1344,7 +1661,8 @@ void LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), s_temp_input.begin());
+          std::copy(movInput + compare_start, movInputEnd, s_temp_input.begin() + compare_start);
+          InvalidateInputHashes(compare_start);
         }
         else
         {
@@ -1416,6 +1734,40 @@ void LoadInput(const std::string& movie_path)
   }
 }
 
+// NOTE: CPU Thread
+// Does the part of LoadInput that still applies when a state was loaded from memory (rewind,
+// memory slots). The input log stays in memory, so there is no movie file to read back.
+void OnMemoryStateLoaded()
+{
+  if (!IsMovieActive())
+    return;
+
+  if (s_bReadOnly)
+  {
+    if (s_currentByte > s_temp_input.size())
+    {
+      EndPlayInput(false);
+    }
+    else if (s_playMode != MODE_PLAYING)
+    {
+      s_playMode = MODE_PLAYING;
+      Core::UpdateWantDeterminism();
+      Core::DisplayMessage("Switched to playback", 2000);
+    }
+  }
+  else
+  {
+    // Recording continues from the loaded input, RecordInput drops everything after it
+    s_rerecords++;
+    if (s_playMode != MODE_RECORDING)
+    {
+      s_playMode = MODE_RECORDING;
+      Core::UpdateWantDeterminism();
+      Core::DisplayMessage("Switched to recording", 2000);
+    }
+  }
+}
+
 // NOTE: CPU Thread
 static void CheckInputEnd()
 {
@@ -1509,7 +1861,7 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
   if (s_padState.reset)
     ProcessorInterface::ResetButton_Tap();
 
-  SetInputDisplayString(s_padState, controllerID);
+  s_pad_display[controllerID].Write(s_padState);
   CheckInputEnd();
 }
 
@@ -1647,13 +1999,22 @@ void SaveRecording(const std::string& filename)
   header.DSPcoefHash = s_DSPcoefHash;
   header.tickCount = s_totalTickCount;
 
+  // Hashes of intervals which end after the last recorded frame were left over by re-recording
+  const size_t state_hash_count =
+      s_state_hash_interval == 0 ?
+          0 :
+          std::min<size_t>(s_state_hashes.size(), s_totalFrames / s_state_hash_interval);
+  header.stateHashInterval = s_state_hash_interval;
+  header.stateHashCount = static_cast<u32>(state_hash_count);
+
   // TODO
   header.uniqueID = 0;
   // header.audioEmulator;
 
   save_record.WriteArray(&header, 1);
 
-  bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size());
+  bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size()) &&
+                 save_record.WriteArray(s_state_hashes.data(), state_hash_count);
 
   if (success && s_bRecordingFromSaveState)
   {
@@ -1683,7 +2044,11 @@ void CallGCInputManip(GCPadStatus* PadStatus, int controllerID)
   if (s_gc_manip_func)
     s_gc_manip_func(PadStatus, controllerID);
 
-  
+#ifdef USE_REMOTECONTROL_SOCKET
+  RemoteControlSocket::ApplyPadOverride(PadStatus, controllerID);
+#endif
+
+  Lua::UpdateScripts(PadStatus, controllerID);
 }
 // NOTE: CPU Thread
 void CallWiiInputManip(DataReportBuilder& rpt, int controllerID, int ext, const EncryptionKey& key)
@@ -1821,5 +2186,8 @@ void Shutdown()
 {
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
   s_temp_input.clear();
+  InvalidateInputHashes(0);
+  s_state_hashes.clear();
+  s_state_hasher.reset();
 }
 }  // namespace Movie
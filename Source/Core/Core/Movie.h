@@ -126,13 +126,15 @@ struct DTMHeader
   bool bFollowBranch;
   bool bUseFMA;
   u8 GBAControllers;                // GBA Controllers plugged in (the bits are ports 1-4)
-  std::array<u8, 7> reserved;       // Padding for any new config options
+  u16 stateHashInterval;            // Frames per state hash, 0 if the movie has none
+  std::array<u8, 5> reserved;       // Padding for any new config options
   std::array<char, 40> discChange;  // Name of iso file to switch to, for two disc games.
   std::array<u8, 20> revision;      // Git hash
   u32 DSPiromHash;
   u32 DSPcoefHash;
-  u64 tickCount;                 // Number of ticks in the recording
-  std::array<u8, 11> reserved2;  // Make heading 256 bytes, just because we can
+  u64 tickCount;                // Number of ticks in the recording
+  u32 stateHashCount;           // Number of u64 state hashes stored after the input
+  std::array<u8, 7> reserved2;  // Make heading 256 bytes, just because we can
 };
 static_assert(sizeof(DTMHeader) == 256, "DTMHeader should be 256 bytes");
 
@@ -160,6 +162,17 @@ u64 GetTotalInputCount();
 u64 GetCurrentLagCount();
 u64 GetTotalLagCount();
 
+// Position in the input log and the hash of the log up to a given length. A state saved at some
+// position stays consistent with the movie for as long as the hash up to there is unchanged.
+u64 GetCurrentInputByte();
+u64 GetInputSize();
+u64 GetInputHash(u64 length);
+
+// Reads or overwrites bytes of the input log in place, without changing its length. Must be called
+// on the CPU thread, or while it is paused.
+bool ReadInput(u64 offset, u8* data, size_t size);
+bool ReplaceInput(u64 offset, const u8* data, size_t size);
+
 void SetClearSave(bool enabled);
 void SignalDiscChange(const std::string& new_path);
 void SetReset(bool reset);
@@ -186,6 +199,7 @@ void RecordWiimote(int wiimote, const u8* data, u8 size);
 
 bool PlayInput(const std::string& movie_path, std::optional<std::string>* savestate_path);
 void LoadInput(const std::string& movie_path);
+void OnMemoryStateLoaded();
 void ReadHeader();
 void PlayController(GCPadStatus* PadStatus, int controllerID);
 bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
@@ -199,7 +213,7 @@ void CheckWiimoteStatus(int wiimote, const WiimoteCommon::DataReportBuilder& rpt
                         const WiimoteEmu::EncryptionKey& key);
 
 std::string GetInputDisplay();
-std::string GetRAMDisplay();
+const std::string& GetRAMDisplay();
 std::string GetRTCDisplay();
 
 // Done this way to avoid mixing of core and gui code
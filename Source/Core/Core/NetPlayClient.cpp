@@ -37,6 +37,7 @@
 #include "Core/Config/NetplaySettings.h"
 #include "Core/Config/SessionSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #ifdef HAS_LIBMGBA
@@ -59,7 +60,9 @@
 #include "Core/IOS/Uids.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateHasher.h"
 #include "Core/SyncIdentifier.h"
 
 #include "InputCommon/ControllerEmu/ControlGroup/Attachments.h"
@@ -1591,6 +1594,12 @@ bool NetPlayClient::StartGame(const std::string& path)
   }
 
   m_timebase_frame = 0;
+  m_state_hasher.Reset();
+  m_state_hash = 0;
+  m_rollback.reset();
+  m_rollback_checked = false;
+  m_rollback_catching_up = false;
+  m_pending_timebases.clear();
   m_current_golfer = 1;
   m_wait_on_input = false;
 
@@ -1854,6 +1863,17 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  // The first poll of a game also runs after its game INI has been loaded
+  if (!m_rollback_checked)
+  {
+    m_rollback_checked = true;
+    if (IsRollbackAllowed())
+    {
+      INFO_LOG_FMT(NETPLAY, "Predicting late inputs and rolling back mispredictions");
+      m_rollback = std::make_unique<PadRollback>();
+    }
+  }
+
   if (IsFirstInGamePad(pad_nb) && batching)
   {
     sf::Packet packet;
@@ -1915,19 +1935,38 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
   }
 
-  // Now, we either use the data pushed earlier, or wait for the
-  // other clients to send it to us
-  while (m_pad_buffer[pad_nb].Size() == 0)
+  if (m_rollback)
   {
-    if (!m_is_running.IsSet())
+    // Late inputs are predicted as long as the rollback allows it
+    const auto source = [this](int pad, GCPadStatus* status) {
+      return m_pad_buffer[pad].Pop(*status);
+    };
+    while (!m_rollback->GetInput(pad_nb, source, pad_status))
     {
-      return false;
-    }
+      if (!m_is_running.IsSet())
+      {
+        return false;
+      }
 
-    m_gc_pad_event.Wait();
+      m_gc_pad_event.Wait();
+    }
   }
+  else
+  {
+    // Now, we either use the data pushed earlier, or wait for the
+    // other clients to send it to us
+    while (m_pad_buffer[pad_nb].Size() == 0)
+    {
+      if (!m_is_running.IsSet())
+      {
+        return false;
+      }
 
-  m_pad_buffer[pad_nb].Pop(*pad_status);
+      m_gc_pad_event.Wait();
+    }
+
+    m_pad_buffer[pad_nb].Pop(*pad_status);
+  }
 
   if (Movie::IsRecordingInput())
   {
@@ -2029,6 +2068,10 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
   bool data_added = false;
   GCPadStatus pad_status;
 
+  // The frames after a rollback reuse the inputs which were sent the first time
+  if (m_rollback && m_rollback->IsReplaying(ingame_pad))
+    return false;
+
   if (m_gba_config[ingame_pad].enabled)
   {
     pad_status = Pad::GetGBAStatus(local_pad);
@@ -2316,19 +2359,100 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
-  if (netplay_client->m_timebase_frame % 60 == 0)
+  if (netplay_client->m_timebase_frame % TIMEBASE_INTERVAL == 0)
+  {
+    const u64 rollback_frame =
+        netplay_client->m_rollback ? netplay_client->m_rollback->GetFrame() : 0;
+    netplay_client->m_pending_timebases.push_back({rollback_frame,
+                                                   SystemTimers::GetFakeTimeBase(),
+                                                   netplay_client->m_timebase_frame,
+                                                   netplay_client->m_state_hash});
+    netplay_client->SendPendingTimeBases();
+  }
+
+  // The hash of the RAM and the registers lets the server notice desyncs which don't affect the
+  // time base (yet)
+  const std::optional<u64> state_hash =
+      netplay_client->m_state_hasher.OnFrame(netplay_client->m_timebase_frame);
+  if (state_hash)
+    netplay_client->m_state_hash = *state_hash;
+
+  netplay_client->m_timebase_frame++;
+}
+
+void NetPlayClient::SendPendingTimeBases()
+{
+  // A frame which used a predicted input may still be emulated again with different results
+  const u64 first_predicted_frame = m_rollback ? m_rollback->GetFirstPredictedFrame() : 0;
+  while (!m_pending_timebases.empty() &&
+         (!m_rollback || m_pending_timebases.front().rollback_frame < first_predicted_frame))
   {
-    const sf::Uint64 timebase = SystemTimers::GetFakeTimeBase();
+    const PendingTimeBase& pending = m_pending_timebases.front();
 
     sf::Packet packet;
     packet << static_cast<MessageId>(NP_MSG_TIMEBASE);
-    packet << timebase;
-    packet << netplay_client->m_timebase_frame;
+    packet << static_cast<sf::Uint64>(pending.timebase);
+    packet << pending.timebase_frame;
+    packet << static_cast<sf::Uint64>(pending.state_hash);
+    SendAsync(std::move(packet));
 
-    netplay_client->SendAsync(std::move(packet));
+    m_pending_timebases.pop_front();
   }
+}
 
-  netplay_client->m_timebase_frame++;
+// called from ---CPU--- thread
+void NetPlayClient::OnFrameEnd()
+{
+  std::lock_guard lk(crit_netplay_client);
+
+  if (!netplay_client || !netplay_client->m_rollback)
+    return;
+
+  NetPlayClient& client = *netplay_client;
+  const auto source = [&client](int pad, GCPadStatus* status) {
+    return client.m_pad_buffer[pad].Pop(*status);
+  };
+  const std::optional<PadRollback::ClientState> restored = client.m_rollback->OnFrameEnd(
+      {client.m_timebase_frame, client.m_state_hasher, client.m_state_hash}, source);
+  if (restored)
+  {
+    client.m_timebase_frame = restored->timebase_frame;
+    client.m_state_hasher = restored->state_hasher;
+    client.m_state_hash = restored->state_hash;
+
+    const u64 frame = client.m_rollback->GetFrame();
+    while (!client.m_pending_timebases.empty() &&
+           client.m_pending_timebases.back().rollback_frame >= frame)
+    {
+      client.m_pending_timebases.pop_back();
+    }
+  }
+
+  client.SendPendingTimeBases();
+
+  // The frames which are emulated again run unthrottled to catch up with the other players
+  const bool catching_up = client.m_rollback->IsCatchingUp();
+  if (catching_up != client.m_rollback_catching_up)
+  {
+    client.m_rollback_catching_up = catching_up;
+    Core::SetIsThrottlerTempDisabled(catching_up);
+  }
+}
+
+bool NetPlayClient::IsRollbackAllowed() const
+{
+  // Rolling back the state of a GBA, Wii Remotes or a movie isn't supported, and with host input
+  // authority the inputs aren't late to begin with
+  if (!Config::Get(Config::NETPLAY_ROLLBACK))
+    return false;
+  if (!Config::Get(Config::MAIN_NETPLAY_ROLLBACK_SUPPORTED))
+    return false;
+  if (SConfig::GetInstance().bWii || Movie::IsMovieActive())
+    return false;
+  if (m_host_input_authority || m_net_settings.m_GolfMode)
+    return false;
+  return std::none_of(m_gba_config.begin(), m_gba_config.end(),
+                      [](const auto& config) { return config.enabled; });
 }
 
 bool NetPlayClient::DoAllPlayersHaveGame()
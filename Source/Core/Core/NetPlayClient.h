@@ -6,6 +6,7 @@
 #include <SFML/Network/Packet.hpp>
 #include <array>
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -20,6 +21,7 @@
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
+#include "Core/StateHasher.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
@@ -30,6 +32,8 @@ class GameFile;
 
 namespace NetPlay
 {
+class PadRollback;
+
 class NetPlayUI
 {
 public:
@@ -139,6 +143,7 @@ public:
   bool IsLocalPlayer(PlayerId pid) const;
 
   static void SendTimeBase();
+  static void OnFrameEnd();
   bool DoAllPlayersHaveGame();
 
   const PadMappingArray& GetPadMapping() const;
@@ -227,6 +232,8 @@ private:
   void SyncCodeResponse(bool success);
 
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  bool IsRollbackAllowed() const;
+  void SendPendingTimeBases();
   void SendPadHostPoll(PadIndex pad_num);
 
   void UpdateDevices();
@@ -269,6 +276,24 @@ private:
 
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
+  // Sent along with the time base, which is sent at the first frame after each hash interval
+  StateHasher m_state_hasher{TIMEBASE_INTERVAL};
+  u64 m_state_hash = 0;
+
+  struct PendingTimeBase
+  {
+    u64 rollback_frame;
+    u64 timebase;
+    u32 timebase_frame;
+    u64 state_hash;
+  };
+
+  // Created at the first poll of a game which allows rollback. The time bases of the frames
+  // which may still be rolled back are held back until their inputs are confirmed.
+  std::unique_ptr<PadRollback> m_rollback;
+  bool m_rollback_checked = false;
+  bool m_rollback_catching_up = false;
+  std::deque<PendingTimeBase> m_pending_timebases;
 };
 
 void NetPlay_Enable(NetPlayClient* const np);
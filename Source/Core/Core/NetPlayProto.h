@@ -212,6 +212,8 @@ enum
 
 constexpr u32 MAX_NAME_LENGTH = 30;
 constexpr size_t CHUNKED_DATA_UNIT_SIZE = 16384;
+// Frames between two NP_MSG_TIMEBASE, which carry the time base and a state hash of the client
+constexpr u32 TIMEBASE_INTERVAL = 60;
 
 enum : u8
 {
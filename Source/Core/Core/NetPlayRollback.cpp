@@ -0,0 +1,239 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Core/State.h"
+
+namespace NetPlay
+{
+// Frames between two captures of a RAM copy. The snapshots saved against the older copy must
+// already be too old to be rolled back to when it gets recaptured.
+constexpr u64 BASE_INTERVAL = 60;
+static_assert(BASE_INTERVAL > PadRollback::MAX_PREDICTED_FRAMES + 1);
+
+constexpr size_t MAX_FREE_BUFFERS = PadRollback::MAX_PREDICTED_FRAMES + 2;
+
+static bool IsSameInput(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.isConnected == b.isConnected;
+}
+
+PadRollback::PadRollback() = default;
+PadRollback::~PadRollback() = default;
+
+bool PadRollback::IsReplaying(int pad) const
+{
+  return m_pads[pad].next_poll < m_pads[pad].confirmed_polls;
+}
+
+bool PadRollback::GetInput(int pad, const InputSource& source, GCPadStatus* status)
+{
+  Pad& p = m_pads[pad];
+  const u64 poll = p.next_poll;
+  if (poll < p.confirmed_polls)
+  {
+    *status = p.inputs[poll - p.first_poll];
+    p.next_poll++;
+    return true;
+  }
+
+  // The inputs which arrive first belong to the polls which used predictions
+  std::array<std::optional<u64>, 4> mispredicted;
+  ConfirmInputs(source, &mispredicted);
+  for (size_t i = 0; i < m_mispredicted.size(); ++i)
+  {
+    if (mispredicted[i] && (!m_mispredicted[i] || *mispredicted[i] < *m_mispredicted[i]))
+      m_mispredicted[i] = mispredicted[i];
+  }
+
+  GCPadStatus input;
+  if (poll == p.confirmed_polls && source(pad, &input))
+  {
+    p.confirmed_polls++;
+    p.last_confirmed = input;
+  }
+  else if (!m_snapshots.empty() && m_snapshots.back().frame == m_frame &&
+           m_frame - GetFirstPredictedFrame() < MAX_PREDICTED_FRAMES)
+  {
+    input = p.last_confirmed;
+  }
+  else
+  {
+    return false;
+  }
+
+  // Polls past the end are new, the others replace the prediction made before a rollback
+  const size_t index = static_cast<size_t>(poll - p.first_poll);
+  if (index < p.inputs.size())
+    p.inputs[index] = input;
+  else
+    p.inputs.push_back(input);
+  p.next_poll++;
+  *status = input;
+  return true;
+}
+
+bool PadRollback::ConfirmInputs(const InputSource& source,
+                                std::array<std::optional<u64>, 4>* mispredicted)
+{
+  bool any_mispredicted = false;
+  for (int pad = 0; pad < static_cast<int>(m_pads.size()); ++pad)
+  {
+    Pad& p = m_pads[pad];
+    GCPadStatus input;
+    while (p.confirmed_polls < p.next_poll && source(pad, &input))
+    {
+      GCPadStatus& predicted = p.inputs[p.confirmed_polls - p.first_poll];
+      if (!IsSameInput(predicted, input) && !(*mispredicted)[pad])
+      {
+        (*mispredicted)[pad] = p.confirmed_polls;
+        any_mispredicted = true;
+      }
+      predicted = input;
+      p.last_confirmed = input;
+      p.confirmed_polls++;
+    }
+  }
+  return any_mispredicted;
+}
+
+std::optional<size_t> PadRollback::FindSnapshotOfPoll(int pad, u64 poll) const
+{
+  for (size_t i = m_snapshots.size(); i-- > 0;)
+  {
+    if (m_snapshots[i].next_polls[pad] <= poll)
+      return i;
+  }
+  return std::nullopt;
+}
+
+u64 PadRollback::GetFirstPredictedFrame() const
+{
+  u64 frame = m_frame;
+  for (int pad = 0; pad < static_cast<int>(m_pads.size()); ++pad)
+  {
+    const Pad& p = m_pads[pad];
+    if (p.confirmed_polls >= p.next_poll)
+      continue;
+
+    const std::optional<size_t> snapshot = FindSnapshotOfPoll(pad, p.confirmed_polls);
+    frame = std::min(frame, snapshot ? m_snapshots[*snapshot].frame : 0);
+  }
+  return frame;
+}
+
+std::optional<PadRollback::ClientState> PadRollback::OnFrameEnd(const ClientState& client,
+                                                                const InputSource& source)
+{
+  m_frame++;
+
+  std::array<std::optional<u64>, 4> mispredicted = m_mispredicted;
+  m_mispredicted = {};
+  const bool any_mispredicted =
+      ConfirmInputs(source, &mispredicted) ||
+      std::any_of(mispredicted.begin(), mispredicted.end(), [](const auto& poll) { return poll; });
+
+  if (any_mispredicted)
+  {
+    // Go back to the earliest frame which used a wrong prediction
+    std::optional<size_t> index;
+    for (int pad = 0; pad < static_cast<int>(m_pads.size()); ++pad)
+    {
+      if (!mispredicted[pad])
+        continue;
+      const std::optional<size_t> snapshot = FindSnapshotOfPoll(pad, *mispredicted[pad]);
+      if (snapshot && (!index || *snapshot < *index))
+        index = snapshot;
+    }
+
+    if (index && State::LoadDeltaFromBuffer(m_bases[m_snapshots[*index].base_index],
+                                            m_snapshots[*index].state))
+    {
+      const Snapshot& snapshot = m_snapshots[*index];
+      m_catch_up_frame = std::max(m_catch_up_frame, m_frame);
+      m_frame = snapshot.frame;
+      for (size_t pad = 0; pad < m_pads.size(); ++pad)
+        m_pads[pad].next_poll = snapshot.next_polls[pad];
+      const ClientState restored = snapshot.client;
+
+      while (m_snapshots.size() > *index + 1)
+      {
+        if (m_free_buffers.size() < MAX_FREE_BUFFERS)
+          m_free_buffers.push_back(std::move(m_snapshots.back().state));
+        m_snapshots.pop_back();
+      }
+      return restored;
+    }
+
+    ERROR_LOG_FMT(NETPLAY, "Failed to roll back to a mispredicted input at frame {}", m_frame);
+  }
+
+  SaveSnapshot(client);
+  DropOldSnapshots();
+  return std::nullopt;
+}
+
+void PadRollback::SaveSnapshot(const ClientState& client)
+{
+  if (m_snapshots.empty() || ++m_frames_since_base >= BASE_INTERVAL)
+  {
+    if (!m_snapshots.empty())
+      m_current_base ^= 1;
+
+    // Nothing can be rolled back this far anymore
+    while (!m_snapshots.empty() && m_snapshots.front().base_index == m_current_base)
+      m_snapshots.pop_front();
+
+    State::CaptureDeltaBase(m_bases[m_current_base]);
+    m_frames_since_base = 0;
+  }
+
+  std::vector<u8> buffer;
+  if (!m_free_buffers.empty())
+  {
+    buffer = std::move(m_free_buffers.back());
+    m_free_buffers.pop_back();
+  }
+  if (!State::SaveDeltaToBuffer(m_bases[m_current_base], buffer))
+    return;
+
+  std::array<u64, 4> next_polls;
+  for (size_t pad = 0; pad < m_pads.size(); ++pad)
+    next_polls[pad] = m_pads[pad].next_poll;
+  m_snapshots.push_back({m_frame, next_polls, client, m_current_base, std::move(buffer)});
+}
+
+void PadRollback::DropOldSnapshots()
+{
+  const u64 first_predicted_frame = GetFirstPredictedFrame();
+  while (m_snapshots.size() > 1 && m_snapshots[1].frame <= first_predicted_frame)
+  {
+    if (m_free_buffers.size() < MAX_FREE_BUFFERS)
+      m_free_buffers.push_back(std::move(m_snapshots.front().state));
+    m_snapshots.pop_front();
+  }
+
+  // The inputs before the oldest snapshot can't be replayed anymore
+  for (size_t pad = 0; pad < m_pads.size(); ++pad)
+  {
+    Pad& p = m_pads[pad];
+    const u64 first_needed = std::min(m_snapshots.empty() ? p.next_poll :
+                                                            m_snapshots.front().next_polls[pad],
+                                      p.confirmed_polls);
+    while (p.first_poll < first_needed)
+    {
+      p.inputs.pop_front();
+      p.first_poll++;
+    }
+  }
+}
+}  // namespace NetPlay
@@ -0,0 +1,107 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/Memmap.h"
+#include "Core/StateHasher.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Rollback mode of netplay for GameCube controllers. Instead of waiting for the input of the other
+// players, a late input is predicted to be the same as the last one which arrived. A delta state is
+// saved at the end of every frame, and once the real input arrives and differs from the
+// prediction, the state of the frame it was polled in is loaded, and the frames since then are
+// emulated again with the real input. The game keeps running for up to MAX_PREDICTED_FRAMES frames
+// before waiting for late input like without rollback.
+//
+// Every poll of a pad consumes its next input in the order they were sent, so after a rollback the
+// same inputs are used at the same places on all clients, which keeps them in sync. Everything
+// runs on the CPU thread.
+class PadRollback
+{
+public:
+  static constexpr u64 MAX_PREDICTED_FRAMES = 8;
+
+  // The parts of the client which depend on the emulated frames, rolled back with the state
+  struct ClientState
+  {
+    u32 timebase_frame = 0;
+    StateHasher state_hasher{1};
+    u64 state_hash = 0;
+  };
+
+  // Pops the next input of a pad which arrived from the server. Returns false if there is none.
+  using InputSource = std::function<bool(int pad, GCPadStatus* status)>;
+
+  PadRollback();
+  ~PadRollback();
+
+  // Returns whether the next poll of the pad repeats a confirmed input after a rollback, in which
+  // case the local controllers must not be polled again.
+  bool IsReplaying(int pad) const;
+
+  // Gets the input of the next poll of the pad. Returns false if the input hasn't arrived and
+  // can't be predicted anymore, after which the caller waits for input and calls it again.
+  bool GetInput(int pad, const InputSource& source, GCPadStatus* status);
+
+  // Called at the end of every emulated frame. Confirms the inputs which arrived, and rolls back if
+  // one of them differs from its prediction, in which case the returned client state replaces the
+  // current one.
+  std::optional<ClientState> OnFrameEnd(const ClientState& client, const InputSource& source);
+
+  // Frames emulated since the start, which go back on a rollback
+  u64 GetFrame() const { return m_frame; }
+  // The first frame which used a predicted input, or the current frame if there is none. The
+  // frames before it won't be rolled back anymore.
+  u64 GetFirstPredictedFrame() const;
+  // Whether the frames before a rollback are being emulated again
+  bool IsCatchingUp() const { return m_frame < m_catch_up_frame; }
+
+private:
+  struct Pad
+  {
+    // The inputs of the polls from first_poll on, confirmed ones followed by predicted ones
+    std::deque<GCPadStatus> inputs;
+    u64 first_poll = 0;
+    u64 next_poll = 0;
+    u64 confirmed_polls = 0;
+    GCPadStatus last_confirmed{};
+  };
+
+  struct Snapshot
+  {
+    // The state at the start of this frame
+    u64 frame;
+    std::array<u64, 4> next_polls;
+    ClientState client;
+    size_t base_index;
+    std::vector<u8> state;
+  };
+
+  std::optional<size_t> FindSnapshotOfPoll(int pad, u64 poll) const;
+  bool ConfirmInputs(const InputSource& source, std::array<std::optional<u64>, 4>* mispredicted);
+  void SaveSnapshot(const ClientState& client);
+  void DropOldSnapshots();
+
+  std::array<Pad, 4> m_pads;
+  // The first poll of each pad whose prediction turned out wrong before the end of the frame
+  std::array<std::optional<u64>, 4> m_mispredicted;
+  std::deque<Snapshot> m_snapshots;
+  // The delta states are saved against one of two RAM copies, which take turns being recaptured
+  std::array<Memory::StateRAMBase, 2> m_bases;
+  size_t m_current_base = 0;
+  u64 m_frames_since_base = 0;
+  std::vector<std::vector<u8>> m_free_buffers;
+  u64 m_frame = 0;
+  u64 m_catch_up_frame = 0;
+};
+}  // namespace NetPlay
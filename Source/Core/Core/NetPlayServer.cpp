@@ -1021,24 +1021,25 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     u64 timebase = Common::PacketReadU64(packet);
     u32 frame;
     packet >> frame;
+    const u64 state_hash = Common::PacketReadU64(packet);
 
     if (m_desync_detected)
       break;
 
-    std::vector<std::pair<PlayerId, u64>>& timebases = m_timebase_by_frame[frame];
-    timebases.emplace_back(player.pid, timebase);
+    std::vector<std::pair<PlayerId, std::pair<u64, u64>>>& timebases = m_timebase_by_frame[frame];
+    timebases.emplace_back(player.pid, std::make_pair(timebase, state_hash));
     if (timebases.size() >= m_players.size())
     {
       // we have all records for this frame
 
-      if (!std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> pair) {
+      if (!std::all_of(timebases.begin(), timebases.end(), [&](const auto& pair) {
             return pair.second == timebases[0].second;
           }))
       {
         int pid_to_blame = 0;
-        for (auto pair : timebases)
+        for (const auto& pair : timebases)
         {
-          if (std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> other) {
+          if (std::all_of(timebases.begin(), timebases.end(), [&](const auto& other) {
                 return other.first == pair.first || other.second != pair.second;
               }))
           {
@@ -2011,13 +2012,20 @@ u64 NetPlayServer::GetInitialNetPlayRTC() const
 void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_pid,
                                   const u8 channel_id)
 {
+  // All clients share one ENet packet, like enet_host_broadcast does. ENet frees it once it has
+  // been sent to every peer, which avoids copying pad data once per spectator.
+  ENetPacket* epac =
+      enet_packet_create(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
   for (auto& p : m_players)
   {
     if (p.second.pid && p.second.pid != skip_pid)
     {
-      Send(p.second.socket, packet, channel_id);
+      enet_peer_send(p.second.socket, channel_id, epac);
     }
   }
+
+  if (epac->referenceCount == 0)
+    enet_packet_destroy(epac);
 }
 
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 channel_id)
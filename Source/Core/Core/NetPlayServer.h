@@ -170,7 +170,9 @@ private:
 
   std::map<PlayerId, Client> m_players;
 
-  std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
+  // The time base and the state hash of each player, by frame
+  std::unordered_map<u32, std::vector<std::pair<PlayerId, std::pair<u64, u64>>>>
+      m_timebase_by_frame;
   bool m_desync_detected;
 
   struct
@@ -22,9 +22,11 @@
 #include "Common/StringUtil.h"
 
 #include "Core/ActionReplay.h"
+#include "Core/CPUTimeBreakdown.h"
 #include "Core/CheatCodes.h"
 #include "Core/Config/SessionSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/FramePatchRoutine.h"
 #include "Core/GeckoCode.h"
 #include "Core/GeckoCodeConfig.h"
 #include "Core/PowerPC/MMU.h"
@@ -39,6 +41,7 @@ constexpr std::array<const char*, 3> s_patch_type_strings{{
 }};
 
 static std::vector<Patch> s_on_frame;
+static FramePatchRoutine s_on_frame_routine;
 static std::map<u32, int> s_speed_hacks;
 
 const char* PatchTypeAsString(PatchType type)
@@ -200,6 +203,47 @@ int GetSpeedhackCycles(const u32 addr)
   return iter->second;
 }
 
+static void CompilePatches(const std::vector<Patch>& patches, FramePatchRoutine* routine)
+{
+  routine->Clear();
+  for (const Patch& patch : patches)
+  {
+    if (!patch.enabled)
+      continue;
+
+    for (const PatchEntry& entry : patch.entries)
+    {
+      u32 size;
+      switch (entry.type)
+      {
+      case PatchType::Patch8Bit:
+        size = 1;
+        break;
+      case PatchType::Patch16Bit:
+        size = 2;
+        break;
+      case PatchType::Patch32Bit:
+        size = 4;
+        break;
+      default:
+        // unknown patchtype
+        continue;
+      }
+
+      // Truncate the value and the comparand to the patch size
+      const u32 mask = size == 4 ? 0xFFFFFFFF : (1u << (size * 8)) - 1;
+      if (entry.conditional)
+      {
+        routine->AddIf(FramePatchRoutine::Condition::Equal, entry.address, false, size,
+                       entry.comparand & mask);
+      }
+      routine->AddWrite(entry.address, false, size, entry.value & mask);
+      if (entry.conditional)
+        routine->AddEndIf(1);
+    }
+  }
+}
+
 void LoadPatches()
 {
   IniFile merged = SConfig::GetInstance().LoadGameIni();
@@ -207,6 +251,7 @@ void LoadPatches()
   IniFile localIni = SConfig::GetInstance().LoadLocalGameIni();
 
   LoadPatchSection("OnFrame", &s_on_frame, globalIni, localIni);
+  CompilePatches(s_on_frame, &s_on_frame_routine);
 
   // Check if I'm syncing Codes
   if (Config::Get(Config::SESSION_CODE_SYNC_OVERRIDE))
@@ -223,40 +268,6 @@ void LoadPatches()
   LoadSpeedhacks("Speedhacks", merged);
 }
 
-static void ApplyPatches(const std::vector<Patch>& patches)
-{
-  for (const Patch& patch : patches)
-  {
-    if (patch.enabled)
-    {
-      for (const PatchEntry& entry : patch.entries)
-      {
-        u32 addr = entry.address;
-        u32 value = entry.value;
-        u32 comparand = entry.comparand;
-        switch (entry.type)
-        {
-        case PatchType::Patch8Bit:
-          if (!entry.conditional || PowerPC::HostRead_U8(addr) == static_cast<u8>(comparand))
-            PowerPC::HostWrite_U8(static_cast<u8>(value), addr);
-          break;
-        case PatchType::Patch16Bit:
-          if (!entry.conditional || PowerPC::HostRead_U16(addr) == static_cast<u16>(comparand))
-            PowerPC::HostWrite_U16(static_cast<u16>(value), addr);
-          break;
-        case PatchType::Patch32Bit:
-          if (!entry.conditional || PowerPC::HostRead_U32(addr) == comparand)
-            PowerPC::HostWrite_U32(value, addr);
-          break;
-        default:
-          // unknown patchtype
-          break;
-        }
-      }
-    }
-  }
-}
-
 // Requires MSR.DR, MSR.IR
 // There's no perfect way to do this, it's just a heuristic.
 // We require at least 2 stack frames, if the stack is shallower than that then it won't work.
@@ -296,7 +307,11 @@ bool ApplyFramePatches()
     return false;
   }
 
-  ApplyPatches(s_on_frame);
+  static CPUTimeBreakdown::Counter* const time_counter =
+      CPUTimeBreakdown::GetCounter(CPUTimeBreakdown::Category::Patches, "Frame patches");
+  CPUTimeBreakdown::Scope time_scope(time_counter);
+
+  s_on_frame_routine.Run();
 
   // Run the Gecko code handler
   Gecko::RunCodeHandler();
@@ -308,6 +323,7 @@ bool ApplyFramePatches()
 void Shutdown()
 {
   s_on_frame.clear();
+  s_on_frame_routine.Clear();
   s_speed_hacks.clear();
   ActionReplay::ApplyCodes({});
   Gecko::Shutdown();
@@ -0,0 +1,155 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PointerPath.h"
+
+#include <cstring>
+
+#include "Common/Swap.h"
+#include "Core/HW/Memmap.h"
+
+// Same ranges the Lua bindings have always accepted, for both virtual and physical addresses.
+static bool IsInMEMArea(u32 pointer)
+{
+  return (pointer > 0x80000000 && pointer < 0x81800000) ||
+         (pointer > 0x90000000 && pointer < 0x94000000) || (pointer > 0x0 && pointer < 0x1800000) ||
+         (pointer > 0x10000000 && pointer < 0x14000000);
+}
+
+static u32 NormalizePointer(u32 pointer)
+{
+  if ((pointer > 0x80000000 && pointer < 0x81800000) ||
+      (pointer > 0x90000000 && pointer < 0x94000000))
+  {
+    pointer -= 0x80000000;
+  }
+  return pointer;
+}
+
+const u8* RAMView::GetPointer(u32 address, size_t size) const
+{
+  address &= 0x3FFFFFFF;
+  if (mem1 && address < mem1_size && size <= mem1_size - address)
+    return mem1 + address;
+
+  if (mem2 && (address >> 28) == 0x1)
+  {
+    const u32 offset = address & 0x0FFFFFFF;
+    if (offset < mem2_size && size <= mem2_size - offset)
+      return mem2 + offset;
+  }
+
+  return nullptr;
+}
+
+RAMView RAMView::Live()
+{
+  RAMView view;
+  view.mem1 = Memory::m_pRAM;
+  view.mem1_size = Memory::m_pRAM ? Memory::GetRamSizeReal() : 0;
+  view.mem2 = Memory::m_pEXRAM;
+  view.mem2_size = Memory::m_pEXRAM ? Memory::GetExRamSizeReal() : 0;
+  return view;
+}
+
+std::optional<u32> PointerPathResolver::Follow(u32 address, u32 offset, const RAMView& view)
+{
+  const u8* ptr = view.GetPointer(address, sizeof(u32));
+  if (!ptr)
+    return std::nullopt;
+
+  u32 value;
+  std::memcpy(&value, ptr, sizeof(u32));
+  value = Common::swap32(value);
+  if (value == 0)
+    return std::nullopt;
+
+  const u32 pointer = value + offset;
+  if (!IsInMEMArea(pointer))
+    return std::nullopt;
+
+  return NormalizePointer(pointer);
+}
+
+std::optional<u32> PointerPathResolver::Follow(u32 address, u32 offset)
+{
+  return Follow(address, offset, RAMView::Live());
+}
+
+std::optional<u32> PointerPathResolver::ResolveOnce(const PointerPath& path, const RAMView& view)
+{
+  std::optional<u32> address = path.base;
+  for (const u32 offset : path.offsets)
+  {
+    address = Follow(*address, offset, view);
+    if (!address)
+      break;
+  }
+  return address;
+}
+
+std::optional<u32> PointerPathResolver::ResolveOnce(const PointerPath& path)
+{
+  return ResolveOnce(path, RAMView::Live());
+}
+
+u32 PointerPathResolver::GetNode(u32 parent, u32 value)
+{
+  const auto [it, inserted] =
+      m_node_lookup.emplace(std::make_pair(parent, value), static_cast<u32>(m_nodes.size()));
+  if (inserted)
+    m_nodes.push_back({parent, value, std::nullopt});
+  return it->second;
+}
+
+PointerPathResolver::PathID PointerPathResolver::Add(const PointerPath& path)
+{
+  u32 node = GetNode(NO_PARENT, path.base);
+  for (const u32 offset : path.offsets)
+    node = GetNode(node, offset);
+  return node;
+}
+
+void PointerPathResolver::Clear()
+{
+  m_nodes.clear();
+  m_node_lookup.clear();
+  m_resolved_count = 0;
+}
+
+void PointerPathResolver::ResolveUpTo(u32 index)
+{
+  const RAMView view = m_view ? *m_view : RAMView::Live();
+
+  // Parents are always created before their children, so walking the nodes in order guarantees
+  // every hop reads from an already resolved address.
+  for (; m_resolved_count <= index; ++m_resolved_count)
+  {
+    Node& node = m_nodes[m_resolved_count];
+    if (node.parent == NO_PARENT)
+    {
+      node.address = node.value;
+      continue;
+    }
+
+    const std::optional<u32>& parent_address = m_nodes[node.parent].address;
+    node.address = parent_address ? Follow(*parent_address, node.value, view) : std::nullopt;
+  }
+}
+
+void PointerPathResolver::Resolve()
+{
+  if (!m_nodes.empty())
+    ResolveUpTo(static_cast<u32>(m_nodes.size() - 1));
+}
+
+std::optional<u32> PointerPathResolver::GetAddress(PathID id)
+{
+  if (id >= m_nodes.size())
+    return std::nullopt;
+
+  if (id >= m_resolved_count)
+    ResolveUpTo(id);
+
+  return m_nodes[id].address;
+}
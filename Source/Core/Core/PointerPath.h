@@ -0,0 +1,98 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A pointer chain into emulated RAM: read the pointer stored at base, add the first offset, read
+// the pointer stored there, add the next offset, and so on. The result is the physical address of
+// the last hop. A hop fails if the pointer read is null or the resulting address lies outside of
+// MEM1/MEM2.
+//
+// Pointers are read directly from the host mapping of MEM1/MEM2 using the default BAT layout
+// (0x8/0xC for MEM1, 0x9/0xD for MEM2), which is what game data structures use in practice.
+struct PointerPath
+{
+  u32 base = 0;
+  std::vector<u32> offsets;
+};
+
+// The memory pointer paths are resolved against: either the live host mapping of MEM1/MEM2 or a
+// copy of it taken at some point.
+struct RAMView
+{
+  const u8* mem1 = nullptr;
+  size_t mem1_size = 0;
+  const u8* mem2 = nullptr;
+  size_t mem2_size = 0;
+
+  // Returns a pointer to size bytes at the given physical or virtual address, or nullptr if the
+  // range isn't entirely inside MEM1 or MEM2.
+  const u8* GetPointer(u32 address, size_t size) const;
+
+  static RAMView Live();
+};
+
+// Resolves many pointer paths against the same RAM contents. Paths sharing a prefix (typically a
+// handful of root pointers with hundreds of chains hanging off them) share the intermediate hops,
+// so each distinct hop costs a single read per resolution.
+class PointerPathResolver final
+{
+public:
+  using PathID = u32;
+
+  PointerPathResolver() = default;
+  explicit PointerPathResolver(const RAMView* view) : m_view(view) {}
+
+  // Registers a path and returns a handle for it. Adding a path that was already added returns
+  // the existing handle.
+  PathID Add(const PointerPath& path);
+  void Clear();
+
+  // Marks all cached hops as stale, e.g. because emulated RAM may have changed.
+  void Invalidate() { m_resolved_count = 0; }
+
+  // Resolves all registered paths in a single pass.
+  void Resolve();
+
+  // Returns the physical address the path points to, if every hop succeeded. Resolves the path
+  // (and any stale hops it depends on) on demand.
+  std::optional<u32> GetAddress(PathID id);
+
+  // Number of distinct hops, including roots.
+  size_t GetNodeCount() const { return m_nodes.size(); }
+
+  // One-off resolution without any caching.
+  static std::optional<u32> ResolveOnce(const PointerPath& path, const RAMView& view);
+  static std::optional<u32> ResolveOnce(const PointerPath& path);
+
+  // Does one hop: reads the pointer at address and adds offset.
+  static std::optional<u32> Follow(u32 address, u32 offset, const RAMView& view);
+  static std::optional<u32> Follow(u32 address, u32 offset);
+
+private:
+  static constexpr u32 NO_PARENT = 0xFFFFFFFF;
+
+  struct Node
+  {
+    u32 parent;
+    u32 value;  // base address for roots, offset otherwise
+    std::optional<u32> address;
+  };
+
+  u32 GetNode(u32 parent, u32 value);
+  void ResolveUpTo(u32 index);
+
+  // nullptr means the live RAM
+  const RAMView* m_view = nullptr;
+
+  std::vector<Node> m_nodes;
+  std::map<std::pair<u32, u32>, u32> m_node_lookup;
+  u32 m_resolved_count = 0;
+};
@@ -4,18 +4,97 @@
 #include "Core/PowerPC/BreakPoints.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/CommonTypes.h"
 #include "Common/DebugInterface.h"
 #include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 
+using Comparison = TBreakPointCondition::Comparison;
+
+// The longer operators come first, so that "<=" isn't parsed as "<"
+constexpr std::array<std::pair<std::string_view, Comparison>, 6> COMPARISON_OPERATORS{{
+    {"==", Comparison::Equal},
+    {"!=", Comparison::NotEqual},
+    {"<=", Comparison::LessEqual},
+    {">=", Comparison::GreaterEqual},
+    {"<", Comparison::Less},
+    {">", Comparison::Greater},
+}};
+
+std::optional<TBreakPointCondition> TBreakPointCondition::Parse(std::string_view text)
+{
+  if (text.empty() || (text[0] != 'r' && text[0] != 'R'))
+    return std::nullopt;
+
+  const size_t operator_position = text.find_first_of("=!<>");
+  if (operator_position == std::string_view::npos || operator_position == 1)
+    return std::nullopt;
+
+  TBreakPointCondition condition;
+  if (!TryParse(std::string(text.substr(1, operator_position - 1)), &condition.gpr, 10) ||
+      condition.gpr >= 32)
+  {
+    return std::nullopt;
+  }
+
+  const std::string_view rest = text.substr(operator_position);
+  for (const auto& [name, comparison] : COMPARISON_OPERATORS)
+  {
+    if (rest.substr(0, name.size()) != name)
+      continue;
+
+    const std::string value(rest.substr(name.size()));
+    if (value.empty() || !TryParse(value, &condition.value, 16))
+      return std::nullopt;
+    condition.comparison = comparison;
+    return condition;
+  }
+
+  return std::nullopt;
+}
+
+std::string TBreakPointCondition::ToString() const
+{
+  const auto iter =
+      std::find_if(COMPARISON_OPERATORS.begin(), COMPARISON_OPERATORS.end(),
+                   [this](const auto& comparison_operator) {
+                     return comparison_operator.second == comparison;
+                   });
+  return fmt::format("r{}{}{:x}", gpr, iter->first, value);
+}
+
+bool TBreakPointCondition::IsMet(u32 gpr_value) const
+{
+  switch (comparison)
+  {
+  case Comparison::Equal:
+    return gpr_value == value;
+  case Comparison::NotEqual:
+    return gpr_value != value;
+  case Comparison::Less:
+    return gpr_value < value;
+  case Comparison::LessEqual:
+    return gpr_value <= value;
+  case Comparison::Greater:
+    return gpr_value > value;
+  case Comparison::GreaterEqual:
+    return gpr_value >= value;
+  }
+  return false;
+}
+
 bool BreakPoints::IsAddressBreakPoint(u32 address) const
 {
   return std::any_of(m_breakpoints.begin(), m_breakpoints.end(),
@@ -48,6 +127,13 @@ bool BreakPoints::IsBreakPointLogOnHit(u32 address) const
                      [address](const auto& bp) { return bp.address == address && bp.log_on_hit; });
 }
 
+const TBreakPoint* BreakPoints::GetBreakPoint(u32 address) const
+{
+  const auto iter = std::find_if(m_breakpoints.begin(), m_breakpoints.end(),
+                                 [address](const auto& bp) { return bp.address == address; });
+  return iter != m_breakpoints.end() ? &*iter : nullptr;
+}
+
 BreakPoints::TBreakPointsStr BreakPoints::GetStrings() const
 {
   TBreakPointsStr bp_strings;
@@ -60,6 +146,8 @@ BreakPoints::TBreakPointsStr BreakPoints::GetStrings() const
 
       ss << std::hex << bp.address << " " << (bp.is_enabled ? "n" : "")
          << (bp.log_on_hit ? "l" : "") << (bp.break_on_hit ? "b" : "");
+      if (bp.condition)
+        ss << " " << bp.condition->ToString();
       bp_strings.push_back(ss.str());
     }
   }
@@ -82,6 +170,9 @@ void BreakPoints::AddFromStrings(const TBreakPointsStr& bp_strings)
     bp.log_on_hit = flags.find('l') != flags.npos;
     bp.break_on_hit = flags.find('b') != flags.npos;
     bp.is_temporary = false;
+    std::string condition;
+    if (iss >> condition)
+      bp.condition = TBreakPointCondition::Parse(condition);
     Add(bp);
   }
 }
@@ -101,7 +192,8 @@ void BreakPoints::Add(u32 address, bool temp)
   BreakPoints::Add(address, temp, true, false);
 }
 
-void BreakPoints::Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit)
+void BreakPoints::Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit,
+                      std::optional<TBreakPointCondition> condition)
 {
   // Only add new addresses
   if (IsAddressBreakPoint(address))
@@ -113,6 +205,7 @@ void BreakPoints::Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit
   bp.break_on_hit = break_on_hit;
   bp.log_on_hit = log_on_hit;
   bp.address = address;
+  bp.condition = std::move(condition);
 
   m_breakpoints.push_back(bp);
 
@@ -214,13 +307,11 @@ void MemChecks::Add(const TMemCheck& memory_check)
   if (GetMemCheck(memory_check.start_address) != nullptr)
     return;
 
-  bool had_any = HasAny();
   Core::RunAsCPUThread([&] {
     m_mem_checks.push_back(memory_check);
-    // If this is the first one, clear the JIT cache so it can switch to
-    // watchpoint-compatible code.
-    if (!had_any)
-      JitInterface::ClearCache();
+    // Clear the JIT cache so that accesses to the newly watched pages aren't inlined anymore, and
+    // the JIT can switch to watchpoint-compatible code if this check breaks.
+    JitInterface::ClearCache();
     PowerPC::DBATUpdated();
   });
 }
@@ -248,8 +339,7 @@ void MemChecks::Remove(u32 address)
 
   Core::RunAsCPUThread([&] {
     m_mem_checks.erase(iter);
-    if (!HasAny())
-      JitInterface::ClearCache();
+    JitInterface::ClearCache();
     PowerPC::DBATUpdated();
   });
 }
@@ -277,6 +367,12 @@ TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
   return &*iter;
 }
 
+bool MemChecks::HasAnyBreakOnHit() const
+{
+  return std::any_of(m_mem_checks.cbegin(), m_mem_checks.cend(),
+                     [](const auto& mc) { return mc.break_on_hit; });
+}
+
 bool MemChecks::OverlapsMemcheck(u32 address, u32 length) const
 {
   if (!HasAny())
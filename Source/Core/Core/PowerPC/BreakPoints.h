@@ -4,7 +4,9 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -14,6 +16,29 @@ namespace Common
 class DebugInterface;
 }
 
+// A comparison of a GPR with a constant which has to be true for a code breakpoint to be hit,
+// written like "r3==80001234" with a hexadecimal value. The comparisons are unsigned.
+struct TBreakPointCondition
+{
+  enum class Comparison
+  {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+  };
+
+  u32 gpr = 0;
+  Comparison comparison = Comparison::Equal;
+  u32 value = 0;
+
+  static std::optional<TBreakPointCondition> Parse(std::string_view text);
+  std::string ToString() const;
+  bool IsMet(u32 gpr_value) const;
+};
+
 struct TBreakPoint
 {
   u32 address = 0;
@@ -21,6 +46,8 @@ struct TBreakPoint
   bool is_temporary = false;
   bool log_on_hit = false;
   bool break_on_hit = false;
+  // The JITs check this in the compiled block, so that the rest of the block runs at full speed
+  std::optional<TBreakPointCondition> condition;
 };
 
 struct TMemCheck
@@ -61,9 +88,11 @@ public:
   bool IsTempBreakPoint(u32 address) const;
   bool IsBreakPointBreakOnHit(u32 address) const;
   bool IsBreakPointLogOnHit(u32 address) const;
+  const TBreakPoint* GetBreakPoint(u32 address) const;
 
   // Add BreakPoint
-  void Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit);
+  void Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit,
+           std::optional<TBreakPointCondition> condition = std::nullopt);
   void Add(u32 address, bool temp = false);
   void Add(const TBreakPoint& bp);
 
@@ -101,6 +130,9 @@ public:
 
   void Clear();
   bool HasAny() const { return !m_mem_checks.empty(); }
+  // Whether a hit can pause the emulation, which needs exception checks after every load and store
+  // in the JITs. Checks which only log don't.
+  bool HasAnyBreakOnHit() const;
 
 private:
   TMemChecks m_mem_checks;
@@ -19,7 +19,9 @@ struct CachedInterpreter::Instruction
   using CommonCallback = void (*)(UGeckoInstruction);
   using ConditionalCallback = bool (*)(u32);
 
-  Instruction() {}
+  // The end of a block is a conditional handler that always leaves the block, which keeps the
+  // dispatch loop down to a single branch on the type of each instruction.
+  Instruction() : conditional_callback(AbortBlock), type(Type::Conditional) {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
       : common_callback(c), data(i.hex), type(Type::Common)
   {
@@ -32,11 +34,12 @@ struct CachedInterpreter::Instruction
 
   enum class Type
   {
-    Abort,
     Common,
     Conditional,
   };
 
+  static bool AbortBlock(u32) { return true; }
+
   union
   {
     const CommonCallback common_callback;
@@ -44,7 +47,7 @@ struct CachedInterpreter::Instruction
   };
 
   u32 data = 0;
-  Type type = Type::Abort;
+  Type type;
 };
 
 CachedInterpreter::CachedInterpreter() = default;
@@ -80,29 +83,18 @@ void CachedInterpreter::ExecuteOneBlock()
   const u8* normal_entry = m_block_cache.Dispatch();
   if (!normal_entry)
   {
-    Jit(PC);
+    JitTrampoline(*this, PC);
     return;
   }
 
   const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
 
-  for (; code->type != Instruction::Type::Abort; ++code)
+  for (;; ++code)
   {
-    switch (code->type)
-    {
-    case Instruction::Type::Common:
+    if (code->type == Instruction::Type::Common)
       code->common_callback(UGeckoInstruction(code->data));
-      break;
-
-    case Instruction::Type::Conditional:
-      if (code->conditional_callback(code->data))
-        return;
-      break;
-
-    default:
-      ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}", code->type);
-      break;
-    }
+    else if (code->conditional_callback(code->data))
+      return;
   }
 }
 
@@ -136,6 +128,17 @@ static void EndBlock(UGeckoInstruction data)
   PowerPC::UpdatePerformanceMonitor(data.hex, 0, 0);
 }
 
+// Ends a block and updates the performance monitor with a single call. The data holds the
+// downcount amount, the number of load/store instructions and the number of floating point
+// instructions of the block, packed by EmitEndBlock.
+static void EndBlockWithCounts(UGeckoInstruction data)
+{
+  const u32 downcount = data.hex & 0xffff;
+  PC = NPC;
+  PowerPC::ppcState.downcount -= downcount;
+  PowerPC::UpdatePerformanceMonitor(downcount, (data.hex >> 16) & 0xff, data.hex >> 24);
+}
+
 static void UpdateNumLoadStoreInstructions(UGeckoInstruction data)
 {
   PowerPC::UpdatePerformanceMonitor(0, data.hex, 0);
@@ -191,6 +194,17 @@ static bool CheckBreakpoint(u32 data)
   return false;
 }
 
+static bool CheckHLEReplaced(u32 data)
+{
+  // The HLE function leaves NPC at the start of the function when the original code should run
+  if (NPC == PC)
+    return false;
+
+  PC = NPC;
+  PowerPC::ppcState.downcount -= data;
+  return true;
+}
+
 static bool CheckIdle(u32 idle_pc)
 {
   if (PowerPC::ppcState.npc == idle_pc)
@@ -200,12 +214,33 @@ static bool CheckIdle(u32 idle_pc)
   return false;
 }
 
+void CachedInterpreter::EmitEndBlock()
+{
+  if (js.downcountAmount <= 0xffff && js.numLoadStoreInst <= 0xff &&
+      js.numFloatingPointInst <= 0xff)
+  {
+    m_code.emplace_back(EndBlockWithCounts, js.downcountAmount | js.numLoadStoreInst << 16 |
+                                                js.numFloatingPointInst << 24);
+    return;
+  }
+
+  m_code.emplace_back(EndBlock, js.downcountAmount);
+  m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
+  m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
     m_code.emplace_back(WritePC, address);
     m_code.emplace_back(Interpreter::HLEFunction, hook_index);
 
+    if (type == HLE::HookType::TryReplace)
+    {
+      m_code.emplace_back(CheckHLEReplaced, js.downcountAmount);
+      return false;
+    }
+
     if (type != HLE::HookType::Replace)
       return false;
 
@@ -290,19 +325,13 @@ void CachedInterpreter::Jit(u32 address)
       if (idle_loop)
         m_code.emplace_back(CheckIdle, js.blockStart);
       if (endblock)
-      {
-        m_code.emplace_back(EndBlock, js.downcountAmount);
-        m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-        m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
-      }
+        EmitEndBlock();
     }
   }
   if (code_block.m_broken)
   {
     m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+    EmitEndBlock();
   }
   m_code.emplace_back();
 
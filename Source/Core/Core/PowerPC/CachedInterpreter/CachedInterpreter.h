@@ -36,6 +36,7 @@ private:
 
   u8* GetCodePtr();
   void ExecuteOneBlock();
+  void EmitEndBlock();
 
   bool HandleFunctionHooking(u32 address);
 
@@ -0,0 +1,247 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/InstructionTrace.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCTables.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace InstructionTrace
+{
+constexpr u32 MAGIC = 0x43525444;  // "DTRC"
+constexpr u32 VERSION = 1;
+// The ring buffer drops whole chunks of this size
+constexpr size_t CHUNK_SIZE = 1024 * 1024;
+// Upper bound of one entry: flags, PC, EA, two counts and all registers
+constexpr size_t MAX_ENTRY_SIZE = 1 + 4 + 4 + 2 + 32 * 5 + 32 * 17;
+
+constexpr u8 FLAG_PC = 1 << 0;
+constexpr u8 FLAG_EFFECTIVE_ADDRESS = 1 << 1;
+constexpr u8 FLAG_FPRS = 1 << 2;
+constexpr u32 GPR_COUNT_SHIFT = 4;
+constexpr u32 GPR_COUNT_EXTENDED = 15;
+
+struct Chunk
+{
+  u64 first_entry = 0;
+  u32 num_entries = 0;
+  std::vector<u8> data;
+};
+
+struct PendingEntry
+{
+  u32 pc;
+  std::optional<u32> effective_address;
+  u64 register_mask;
+};
+
+static std::mutex s_mutex;
+static File::IOFile s_file;
+static bool s_recording;
+static size_t s_max_chunks;
+static std::deque<Chunk> s_chunks;
+static u64 s_next_entry;
+static u32 s_last_pc;
+// The entry of the instruction which is running, completed by the next RecordInstruction call
+static std::optional<PendingEntry> s_pending;
+// The register values as of the last recorded writes
+static std::array<u32, 32> s_gprs;
+static std::array<std::pair<u64, u64>, 32> s_fprs;
+
+template <typename T>
+static u8* Write(u8* out, T value)
+{
+  std::memcpy(out, &value, sizeof(T));
+  return out + sizeof(T);
+}
+
+static std::optional<u32> GetEffectiveAddress(UGeckoInstruction inst)
+{
+  const GekkoOPInfo* info = PPCTables::GetOpInfo(inst);
+  if (!info || !(info->flags & FL_LOADSTORE))
+    return std::nullopt;
+
+  // The instructions haven't run yet, so the update forms still have their old base register
+  const u32 base = inst.RA ? PowerPC::ppcState.gpr[inst.RA] : 0;
+  switch (inst.OPCD)
+  {
+  case 4:
+    return base + PowerPC::ppcState.gpr[inst.RB];
+  case 31:
+    // lswi and stswi have the number of bytes in place of RB
+    if (inst.SUBOP10 == 597 || inst.SUBOP10 == 725)
+      return base;
+    return base + PowerPC::ppcState.gpr[inst.RB];
+  case 56:
+  case 57:
+  case 60:
+  case 61:
+    return base + inst.SIMM_12;
+  default:
+    return base + inst.SIMM_16;
+  }
+}
+
+static Chunk& GetChunkForEntry()
+{
+  if (!s_chunks.empty() && s_chunks.back().data.size() + MAX_ENTRY_SIZE <= CHUNK_SIZE)
+    return s_chunks.back();
+
+  // Reuse the memory of the oldest chunk once the ring buffer is full
+  std::vector<u8> data;
+  if (s_chunks.size() >= s_max_chunks)
+  {
+    data = std::move(s_chunks.front().data);
+    s_chunks.pop_front();
+  }
+  data.clear();
+  data.reserve(CHUNK_SIZE);
+
+  Chunk& chunk = s_chunks.emplace_back();
+  chunk.first_entry = s_next_entry;
+  chunk.data = std::move(data);
+  return chunk;
+}
+
+static void WritePendingEntry()
+{
+  const PendingEntry& entry = *s_pending;
+
+  std::array<u8, 32> gprs;
+  size_t num_gprs = 0;
+  for (const int i : BitSet32(static_cast<u32>(entry.register_mask)))
+  {
+    if (PowerPC::ppcState.gpr[i] != s_gprs[i])
+      gprs[num_gprs++] = static_cast<u8>(i);
+  }
+
+  std::array<u8, 32> fprs;
+  size_t num_fprs = 0;
+  for (const int i : BitSet32(static_cast<u32>(entry.register_mask >> 32)))
+  {
+    const std::pair<u64, u64> value{PowerPC::ppcState.ps[i].PS0AsU64(),
+                                    PowerPC::ppcState.ps[i].PS1AsU64()};
+    if (value != s_fprs[i])
+      fprs[num_fprs++] = static_cast<u8>(i);
+  }
+
+  Chunk& chunk = GetChunkForEntry();
+  const bool write_pc = chunk.num_entries == 0 || entry.pc != s_last_pc + 4;
+  u8 flags = std::min<u32>(static_cast<u32>(num_gprs), GPR_COUNT_EXTENDED) << GPR_COUNT_SHIFT;
+  if (write_pc)
+    flags |= FLAG_PC;
+  if (entry.effective_address)
+    flags |= FLAG_EFFECTIVE_ADDRESS;
+  if (num_fprs != 0)
+    flags |= FLAG_FPRS;
+
+  std::array<u8, MAX_ENTRY_SIZE> buffer;
+  u8* out = Write(buffer.data(), flags);
+  if (write_pc)
+    out = Write(out, entry.pc);
+  if (entry.effective_address)
+    out = Write(out, *entry.effective_address);
+  if (num_gprs >= GPR_COUNT_EXTENDED)
+    out = Write(out, static_cast<u8>(num_gprs));
+  if (num_fprs != 0)
+    out = Write(out, static_cast<u8>(num_fprs));
+
+  for (size_t i = 0; i < num_gprs; ++i)
+  {
+    const u8 reg = gprs[i];
+    s_gprs[reg] = PowerPC::ppcState.gpr[reg];
+    out = Write(out, reg);
+    out = Write(out, s_gprs[reg]);
+  }
+  for (size_t i = 0; i < num_fprs; ++i)
+  {
+    const u8 reg = fprs[i];
+    s_fprs[reg] = {PowerPC::ppcState.ps[reg].PS0AsU64(), PowerPC::ppcState.ps[reg].PS1AsU64()};
+    out = Write(out, reg);
+    out = Write(out, s_fprs[reg].first);
+    out = Write(out, s_fprs[reg].second);
+  }
+
+  chunk.data.insert(chunk.data.end(), buffer.data(), out);
+  chunk.num_entries++;
+  s_next_entry++;
+  s_last_pc = entry.pc;
+}
+
+bool Start(const std::string& filename, u64 max_bytes)
+{
+  std::lock_guard lock(s_mutex);
+  if (!s_file.Open(filename, "wb"))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open instruction trace file {}", filename);
+    return false;
+  }
+
+  s_max_chunks = std::max<u64>(max_bytes / CHUNK_SIZE, 1);
+  s_chunks.clear();
+  s_next_entry = 0;
+  s_last_pc = 0;
+  s_pending.reset();
+  s_gprs = {};
+  s_fprs = {};
+  s_recording = true;
+
+  // Recompile everything so that all blocks record their instructions
+  JitInterface::ClearCache();
+  return true;
+}
+
+void Stop()
+{
+  std::lock_guard lock(s_mutex);
+  if (!s_recording)
+    return;
+
+  if (s_pending)
+    WritePendingEntry();
+  s_pending.reset();
+  s_recording = false;
+  JitInterface::ClearCache();
+
+  bool success = s_file.WriteArray(&MAGIC, 1) && s_file.WriteArray(&VERSION, 1);
+  for (const Chunk& chunk : s_chunks)
+  {
+    const u32 size = static_cast<u32>(chunk.data.size());
+    success = success && s_file.WriteArray(&chunk.first_entry, 1) &&
+              s_file.WriteArray(&chunk.num_entries, 1) && s_file.WriteArray(&size, 1) &&
+              s_file.WriteBytes(chunk.data.data(), chunk.data.size());
+  }
+  if (!success)
+    ERROR_LOG_FMT(POWERPC, "Failed to write the instruction trace");
+  s_file.Close();
+  s_chunks.clear();
+}
+
+bool IsRecording()
+{
+  return s_recording;
+}
+
+void RecordInstruction(u32 address, u32 instruction, u64 register_mask)
+{
+  if (s_pending)
+    WritePendingEntry();
+  s_pending = PendingEntry{address, GetEffectiveAddress(UGeckoInstruction{instruction}),
+                           register_mask};
+}
+}  // namespace InstructionTrace
@@ -0,0 +1,47 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Records the executed guest instructions, the GPRs and FPRs they change and the effective
+// addresses of their memory accesses into a ring buffer in memory, which is written to a file when
+// the recording stops. Tools/trace-diff.py finds the first divergence between two traces, e.g. of a
+// movie played back before and after a desync.
+//
+// The file starts with the u32 magic "DTRC" and a u32 version, followed by the chunks of the ring
+// buffer from oldest to newest: u64 number of the first entry, u32 number of entries, u32 size in
+// bytes and the entries. Every entry starts with a flags byte:
+//   bit 0:      a u32 PC follows. Otherwise the PC is the one of the previous entry plus 4.
+//               The first entry of a chunk always has a PC.
+//   bit 1:      a u32 effective address follows.
+//   bit 2:      the entry has FPR writes.
+//   bits 4-7:   number of GPR writes. 15 means that a u8 number of GPR writes follows.
+// Then come the u8 number of GPR writes if it didn't fit into the flags, the u8 number of FPR
+// writes if there are any, the GPR writes as (u8 register, u32 value) and the FPR writes as
+// (u8 register, u64 ps0, u64 ps1). A write is only recorded if it changed the register.
+// All fields are little endian and unpadded.
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace InstructionTrace
+{
+// Starts recording into a ring buffer which keeps the newest max_bytes of the trace. Both Start and
+// Stop must be called while the CPU isn't running. Returns false if the file can't be created.
+bool Start(const std::string& filename, u64 max_bytes);
+// Writes the ring buffer to the file. This also happens when emulation stops.
+void Stop();
+bool IsRecording();
+
+// Called on the CPU thread before the instruction at address runs. The masks select the registers
+// the instruction may write, which are compared against their previous values once it finished.
+void RecordInstruction(u32 address, u32 instruction, u64 register_mask);
+
+// Masks of RecordInstruction
+constexpr u64 GetRegisterMask(u32 gpr_mask, u32 fpr_mask)
+{
+  return gpr_mask | (u64{fpr_mask} << 32);
+}
+constexpr u64 ALL_REGISTERS = GetRegisterMask(0xFFFFFFFF, 0xFFFFFFFF);
+}  // namespace InstructionTrace
@@ -20,6 +20,7 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/Host.h"
+#include "Core/PowerPC/InstructionTrace.h"
 #include "Core/PowerPC/Interpreter/ExceptionUtils.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCTables.h"
@@ -140,6 +141,8 @@ bool Interpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [](u32 hook_index, HLE::HookType type) {
     HLEFunction(hook_index);
+    if (type == HLE::HookType::TryReplace)
+      return NPC != PC;
     return type != HLE::HookType::Start;
   });
 }
@@ -176,6 +179,9 @@ int Interpreter::SingleStepInner()
     Trace(m_prev_inst);
   }
 
+  if (InstructionTrace::IsRecording())
+    InstructionTrace::RecordInstruction(PC, m_prev_inst.hex, InstructionTrace::ALL_REGISTERS);
+
   if (m_prev_inst.hex != 0)
   {
     if (IsInvalidPairedSingleExecution(m_prev_inst))
@@ -223,6 +229,18 @@ int Interpreter::SingleStepInner()
   return opinfo->numCycles;
 }
 
+int Interpreter::RunBlock()
+{
+  m_end_block = false;
+
+  int cycles = 0;
+  while (!m_end_block)
+  {
+    cycles += SingleStepInner();
+  }
+  return cycles;
+}
+
 void Interpreter::SingleStep()
 {
   // Declare start of new slice
@@ -321,16 +339,7 @@ void Interpreter::Run()
     {
       // "fast" version of inner loop. well, it's not so fast.
       while (PowerPC::ppcState.downcount > 0)
-      {
-        m_end_block = false;
-
-        int cycles = 0;
-        while (!m_end_block)
-        {
-          cycles += SingleStepInner();
-        }
-        PowerPC::ppcState.downcount -= cycles;
-      }
+        PowerPC::ppcState.downcount -= RunBlock();
     }
   }
 }
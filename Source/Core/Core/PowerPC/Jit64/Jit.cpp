@@ -3,7 +3,9 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
 #include <map>
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -24,6 +26,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -33,6 +36,7 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/MachineContext.h"
 #include "Core/PatchEngine.h"
+#include "Core/PowerPC/InstructionTrace.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/RegCache/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/FarCodeCache.h"
@@ -154,6 +158,28 @@ enum
   GUARD_OFFSET = STACK_SIZE - SAFE_STACK_SIZE - GUARD_SIZE,
 };
 
+// The condition code for which the comparison of a breakpoint condition's GPR with its value is
+// false
+static CCFlags GetNegatedConditionCode(TBreakPointCondition::Comparison comparison)
+{
+  switch (comparison)
+  {
+  case TBreakPointCondition::Comparison::Equal:
+    return CC_NE;
+  case TBreakPointCondition::Comparison::NotEqual:
+    return CC_E;
+  case TBreakPointCondition::Comparison::Less:
+    return CC_AE;
+  case TBreakPointCondition::Comparison::LessEqual:
+    return CC_A;
+  case TBreakPointCondition::Comparison::Greater:
+    return CC_BE;
+  case TBreakPointCondition::Comparison::GreaterEqual:
+    return CC_B;
+  }
+  return CC_NE;
+}
+
 Jit64::Jit64() : QuantizedMemoryRoutines(*this)
 {
 }
@@ -272,6 +298,7 @@ bool Jit64::BackPatch(u32 emAddress, SContext* ctx)
   js.generatingTrampoline = true;
   js.trampolineExceptionHandler = exceptionHandler;
   js.compilerPC = info.pc;
+  js.fastmemFaultCounts[info.pc]++;
 
   // Generate the trampoline.
   const u8* trampoline = trampolines.GenerateTrampoline(info);
@@ -335,6 +362,12 @@ void Jit64::Init()
   jo.fastmem_arena = SConfig::GetInstance().bFastmem && Memory::InitFastmemArena();
   jo.optimizeGatherPipe = true;
   jo.accurateSinglePrecision = true;
+  // The debugger manages the analyzer options itself, and stepping expects stable blocks.
+  jo.tiering = Config::Get(Config::MAIN_JIT_TIERING) && !SConfig::GetInstance().bEnableDebugging;
+  jo.tier_up_threshold = std::max(Config::Get(Config::MAIN_JIT_TIER_UP_THRESHOLD), 1u);
+  jo.interpretColdBlocks = Config::Get(Config::MAIN_JIT_INTERPRET_COLD_BLOCKS) &&
+                           !SConfig::GetInstance().bEnableDebugging;
+  jo.evictColdBlocks = Config::Get(Config::MAIN_JIT_EVICT_COLD_BLOCKS);
   UpdateMemoryOptions();
   js.fastmemLoadStore = nullptr;
   js.compilerPC = 0;
@@ -346,7 +379,8 @@ void Jit64::Init()
   const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
   const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
-  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size,
+                 Config::Get(Config::MAIN_LARGE_PAGES));
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
@@ -393,6 +427,12 @@ void Jit64::ClearCache()
   ResetFreeMemoryRanges();
 }
 
+JitBase::CodeSpaceUsage Jit64::GetCodeSpaceUsage() const
+{
+  // Freed blocks are reused, so the space in use is the code of the blocks in the cache
+  return {blocks.GetBlockCodeBytes(), region_size + m_far_code.GetRegionSize()};
+}
+
 void Jit64::ResetFreeMemoryRanges()
 {
   // Set the entire near and far code regions as unused.
@@ -416,8 +456,25 @@ void Jit64::Shutdown()
 
 void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
 {
-  gpr.Flush();
-  fpr.Flush();
+  // Instructions which leave the block need everything in PPCSTATE, and the register usage of the
+  // ones marked evil isn't described exactly.
+  const bool flush_all =
+      (js.op->opinfo->flags & (FL_ENDBLOCK | FL_EVIL)) != 0 || js.op->canEndBlock;
+  if (flush_all)
+  {
+    gpr.Flush();
+    fpr.Flush();
+  }
+  else
+  {
+    // The interpreter only needs its inputs written back and its outputs out of the cache.
+    // Registers which no later instruction reads are flushed as well, the others stay resident
+    // and only the ones in caller-saved host registers are saved around the call.
+    gpr.Flush(js.op->regsOut | ~js.op->gprLive);
+    fpr.Flush(js.op->GetFregsOut() | ~js.op->fprInUse);
+    gpr.Flush(js.op->regsIn, RegCache::FlushMode::MaintainState);
+    fpr.Flush(js.op->fregsIn, RegCache::FlushMode::MaintainState);
+  }
 
   if (js.op->opinfo->flags & FL_ENDBLOCK)
   {
@@ -425,10 +482,17 @@ void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
     MOV(32, PPCSTATE(npc), Imm32(js.compilerPC + 4));
   }
 
+  if (GekkoOPInfo* info = PPCTables::GetOpInfo(inst))
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(&info->fallbackCount));
+    ADD(64, MatR(RSCRATCH), Imm8(1));
+  }
+
   Interpreter::Instruction instr = PPCTables::GetInterpreterOp(inst);
-  ABI_PushRegistersAndAdjustStack({}, 0);
+  const BitSet32 registers_in_use = flush_all ? BitSet32{} : CallerSavedRegistersInUse();
+  ABI_PushRegistersAndAdjustStack(registers_in_use, 0);
   ABI_CallFunctionC(instr, inst.hex);
-  ABI_PopRegistersAndAdjustStack({}, 0);
+  ABI_PopRegistersAndAdjustStack(registers_in_use, 0);
 
   // If the instruction wrote to any registers which were marked as discarded,
   // we must mark them as no longer discarded
@@ -744,6 +808,9 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  if (!m_cleanup_after_stackfault && InterpretColdBlock(em_address))
+    return;
+
   Jit(em_address, true);
 }
 
@@ -764,6 +831,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     if (!SConfig::GetInstance().bJITNoBlockCache)
     {
       WARN_LOG_FMT(POWERPC, "flushing trampoline code cache, please report if this happens a lot");
+      CountCacheFullClear();
     }
     ClearCache();
   }
@@ -803,6 +871,26 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  // Blocks which have not run often yet are compiled without branch following, conditional
+  // continue and instruction merging. That keeps them short and cheap to analyze, which reduces
+  // stutter when a lot of new code runs at once. DoJit inserts a counter into these blocks that
+  // recompiles them with all optimizations once they turn out to be hot.
+  if (jo.tiering)
+  {
+    if (IsBaselineTierBlock(em_address))
+    {
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+    }
+    else
+    {
+      EnableOptimization();
+    }
+  }
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
@@ -818,6 +906,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
+  JitBlock* failed_block = nullptr;
   if (SetEmitterStateToFreeCodeRegion())
   {
     u8* near_start = GetWritableCodePtr();
@@ -846,13 +935,28 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+    failed_block = b;
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
+    // Make room by evicting cold blocks if enabled. Every retry evicts more blocks, so the whole
+    // cache only gets cleared once there is nothing left to evict.
+    if (jo.evictColdBlocks)
+    {
+      if (failed_block)
+        blocks.EraseFailedBlock(*failed_block);
+      if (blocks.EvictColdBlocks() != 0)
+      {
+        Jit(em_address, true);
+        return;
+      }
+    }
+
     // Clear the entire JIT cache and retry.
     WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
+    CountCacheFullClear();
     ClearCache();
     Jit(em_address, false);
     return;
@@ -921,6 +1025,26 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+
+  if (IsBaselineTierBlock(js.blockStart))
+  {
+    // Count down the remaining runs of the block and have it recompiled once it reaches zero.
+    b->tier_up_counter = jo.tier_up_threshold;
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tier_up_counter));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch hot = J_CC(CC_Z, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+  }
+
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -1086,6 +1210,15 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         gpr.Flush();
         fpr.Flush();
 
+        // Only leave the compiled code when the condition is met
+        std::optional<FixupBranch> condition_not_met;
+        const TBreakPoint* bp = breakpoints.GetBreakPoint(op.address);
+        if (bp->condition)
+        {
+          CMP(32, PPCSTATE(gpr[bp->condition->gpr]), Imm32(bp->condition->value));
+          condition_not_met = J_CC(GetNegatedConditionCode(bp->condition->comparison), true);
+        }
+
         MOV(32, PPCSTATE(pc), Imm32(op.address));
         ABI_PushRegistersAndAdjustStack({}, 0);
         ABI_CallFunction(PowerPC::CheckBreakPoints);
@@ -1096,6 +1229,25 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
         WriteExit(op.address);
         SetJumpTarget(noBreakpoint);
+        if (condition_not_met)
+          SetJumpTarget(*condition_not_met);
+      }
+
+      if (InstructionTrace::IsRecording())
+      {
+        // The recorder reads the registers from ppcState, both the inputs of this instruction and
+        // the outputs of the previous one
+        gpr.Flush();
+        fpr.Flush();
+
+        const u32 fpr_mask = op.fregOut >= 0 ? 1u << op.fregOut : 0;
+        ABI_PushRegistersAndAdjustStack({}, 0);
+        MOV(32, R(ABI_PARAM1), Imm32(op.address));
+        MOV(32, R(ABI_PARAM2), Imm32(op.inst.hex));
+        MOV(64, R(ABI_PARAM3),
+            Imm64(InstructionTrace::GetRegisterMask(op.regsOut.m_val, fpr_mask)));
+        ABI_CallFunction(InstructionTrace::RecordInstruction);
+        ABI_PopRegistersAndAdjustStack({}, 0);
       }
 
       if (SConfig::GetInstance().bJITRegisterCacheOff)
@@ -1242,6 +1394,11 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
 }
 
+bool Jit64::IsBaselineTierBlock(u32 em_address) const
+{
+  return jo.tiering && js.hotBlockAddresses.find(em_address) == js.hotBlockAddresses.end();
+}
+
 void Jit64::IntializeSpeculativeConstants()
 {
   // If the block depends on an input register which looks like a gather pipe or MMIO related
@@ -1282,6 +1439,20 @@ bool Jit64::HandleFunctionHooking(u32 address)
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
     HLEFunction(hook_index);
 
+    if (type == HLE::HookType::TryReplace)
+    {
+      // Leave the block unless the HLE function left it to the original code
+      CMP(32, PPCSTATE(npc), Imm32(address));
+      FixupBranch fall_back = J_CC(CC_E, true);
+      const u32 downcount_amount = js.downcountAmount;
+      MOV(32, R(RSCRATCH), PPCSTATE(npc));
+      js.downcountAmount += js.st.numCycles;
+      WriteExitDestInRSCRATCH();
+      js.downcountAmount = downcount_amount;
+      SetJumpTarget(fall_back);
+      return false;
+    }
+
     if (type != HLE::HookType::Replace)
       return false;
 
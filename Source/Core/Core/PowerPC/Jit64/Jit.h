@@ -67,12 +67,14 @@ public:
   BitSet32 CallerSavedRegistersInUse() const;
   BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
 
+  bool IsBaselineTierBlock(u32 em_address) const;
   void IntializeSpeculativeConstants();
 
   JitBlockCache* GetBlockCache() override { return &blocks; }
   void Trace();
 
   void ClearCache() override;
+  CodeSpaceUsage GetCodeSpaceUsage() const override;
 
   const CommonAsmRoutines* GetAsmRoutines() override { return &asm_routines; }
   const char* GetName() const override { return "JIT64"; }
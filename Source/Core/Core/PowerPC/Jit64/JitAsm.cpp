@@ -189,9 +189,19 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
+  // The block may have been interpreted instead of compiled, which uses up downcount.
+  FixupBranch interpreted_timing;
+  if (m_jit.jo.interpretColdBlocks)
+  {
+    CMP(32, PPCSTATE(downcount), Imm8(0));
+    interpreted_timing = J_CC(CC_LE, true);
+  }
+
   JMP(dispatcher_no_check, true);
 
   SetJumpTarget(bail);
+  if (m_jit.jo.interpretColdBlocks)
+    SetJumpTarget(interpreted_timing);
   do_timing = GetCodePtr();
 
   // make sure npc contains the next pc (needed for exception checking in CoreTiming::Advance)
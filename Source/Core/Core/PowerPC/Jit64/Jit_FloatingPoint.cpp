@@ -423,10 +423,14 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
     {
       if (round_input)
         Force25BitPrecision(result_xmm, Rc, scratch_xmm);
-      else
+      else if (use_fma)
         MOVAPD(result_xmm, Rc);
     }
 
+    // Without input rounding or a ps_madds shuffle, the separate multiply can read Rc directly
+    // with a three-operand AVX encoding instead of copying it into result_xmm first.
+    const bool multiply_from_rc = !use_fma && !round_input && !madds0 && !madds1;
+
     if (use_fma)
     {
       if (subtract)
@@ -448,7 +452,10 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
     {
       if (packed)
       {
-        MULPD(result_xmm, Ra);
+        if (multiply_from_rc)
+          avx_op(&XEmitter::VMULPD, &XEmitter::MULPD, result_xmm, Rc, Ra, true, true);
+        else
+          MULPD(result_xmm, Ra);
         if (subtract)
           SUBPD(result_xmm, Rb);
         else
@@ -456,7 +463,10 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
       }
       else
       {
-        MULSD(result_xmm, Ra);
+        if (multiply_from_rc)
+          avx_op(&XEmitter::VMULSD, &XEmitter::MULSD, result_xmm, Rc, Ra, true, true);
+        else
+          MULSD(result_xmm, Ra);
         if (subtract)
           SUBSD(result_xmm, Rb);
         else
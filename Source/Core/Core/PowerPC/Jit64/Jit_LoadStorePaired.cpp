@@ -33,14 +33,17 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   int s = inst.FS;
   int i = indexed ? inst.Ix : inst.I;
   int w = indexed ? inst.Wx : inst.W;
-  FALLBACK_IF(!a);
+  // rA = 0 uses an address of 0 + offset, which is only valid without update
+  FALLBACK_IF(!a && update);
 
   auto it = js.constantGqr.find(i);
   bool gqrIsConstant = it != js.constantGqr.end();
   u32 gqrValue = gqrIsConstant ? it->second & 0xffff : 0;
 
   RCX64Reg scratch_guard = gpr.Scratch(RSCRATCH_EXTRA);
-  RCOpArg Ra = update ? gpr.Bind(a, RCMode::ReadWrite) : gpr.Use(a, RCMode::Read);
+  RCOpArg Ra = !a     ? RCOpArg::Imm32(0) :
+               update ? gpr.Bind(a, RCMode::ReadWrite) :
+                        gpr.Use(a, RCMode::Read);
   RCOpArg Rb = indexed ? gpr.Use(b, RCMode::Read) : RCOpArg::Imm32((u32)offset);
   RCOpArg Rs = fpr.Use(s, RCMode::Read);
   RegCache::Realize(scratch_guard, Ra, Rb, Rs);
@@ -124,14 +127,15 @@ void Jit64::psq_lXX(UGeckoInstruction inst)
   int s = inst.FS;
   int i = indexed ? inst.Ix : inst.I;
   int w = indexed ? inst.Wx : inst.W;
-  FALLBACK_IF(!a);
+  // rA = 0 uses an address of 0 + offset, which is only valid without update
+  FALLBACK_IF(!a && update);
 
   auto it = js.constantGqr.find(i);
   bool gqrIsConstant = it != js.constantGqr.end();
   u32 gqrValue = gqrIsConstant ? it->second >> 16 : 0;
 
   RCX64Reg scratch_guard = gpr.Scratch(RSCRATCH_EXTRA);
-  RCX64Reg Ra = gpr.Bind(a, update ? RCMode::ReadWrite : RCMode::Read);
+  RCOpArg Ra = !a ? RCOpArg::Imm32(0) : gpr.Bind(a, update ? RCMode::ReadWrite : RCMode::Read);
   RCOpArg Rb = indexed ? gpr.Use(b, RCMode::Read) : RCOpArg::Imm32((u32)offset);
   RCX64Reg Rs = fpr.Bind(s, RCMode::Write);
   RegCache::Realize(scratch_guard, Ra, Rb, Rs);
@@ -57,7 +57,9 @@ void GPRRegCache::SetImmediate32(preg_t preg, u32 imm_value, bool dirty)
 
 BitSet32 GPRRegCache::GetRegUtilization() const
 {
-  return m_jit.js.op->gprInUse;
+  // Registers which are overwritten before they are read again don't need to stay in a host
+  // register
+  return m_jit.js.op->gprLive;
 }
 
 BitSet32 GPRRegCache::CountRegsIn(preg_t preg, u32 lookahead) const
@@ -403,7 +403,7 @@ void RegCache::Discard(BitSet32 pregs)
   }
 }
 
-void RegCache::Flush(BitSet32 pregs)
+void RegCache::Flush(BitSet32 pregs, FlushMode mode)
 {
   ASSERT_MSG(
       DYNA_REC,
@@ -425,11 +425,12 @@ void RegCache::Flush(BitSet32 pregs)
       // We can have a cached value without a host register through speculative constants.
       // It must be cleared when flushing, otherwise it may be out of sync with PPCSTATE,
       // if PPCSTATE is modified externally (e.g. fallback to interpreter).
-      m_regs[i].SetFlushed();
+      if (mode == FlushMode::Full)
+        m_regs[i].SetFlushed();
       break;
     case PPCCachedReg::LocationType::Bound:
     case PPCCachedReg::LocationType::Immediate:
-      StoreFromRegister(i);
+      StoreFromRegister(i, mode);
       break;
     }
   }
@@ -169,7 +169,8 @@ public:
 
   RCForkGuard Fork();
   void Discard(BitSet32 pregs);
-  void Flush(BitSet32 pregs = BitSet32::AllTrue(32));
+  // With FlushMode::MaintainState, the registers are written back but stay where they are
+  void Flush(BitSet32 pregs = BitSet32::AllTrue(32), FlushMode mode = FlushMode::Full);
   void Reset(BitSet32 pregs);
   void Revert();
   void Commit();
@@ -12,6 +12,7 @@
 #include "Common/PerformanceCounter.h"
 #include "Common/StringUtil.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -44,7 +45,7 @@ JitArm64::~JitArm64() = default;
 void JitArm64::Init()
 {
   const size_t child_code_size = SConfig::GetInstance().bMMU ? FARCODE_SIZE_MMU : FARCODE_SIZE;
-  AllocCodeSpace(CODE_SIZE + child_code_size);
+  AllocCodeSpace(CODE_SIZE + child_code_size, Config::Get(Config::MAIN_LARGE_PAGES));
   AddChildCodeSpace(&farcode, child_code_size);
 
   jo.fastmem_arena = SConfig::GetInstance().bFastmem && Memory::InitFastmemArena();
@@ -134,6 +135,13 @@ void JitArm64::ClearCache()
   GenerateAsm();
 }
 
+JitBase::CodeSpaceUsage JitArm64::GetCodeSpaceUsage() const
+{
+  // Code is only ever appended until the cache gets cleared, so freed blocks still count as used
+  const size_t size = region_size + farcode.GetRegionSize();
+  return {size - GetSpaceLeft() - farcode.GetSpaceLeft(), size};
+}
+
 void JitArm64::Shutdown()
 {
   Memory::ShutdownFastmemArena();
@@ -159,6 +167,19 @@ void JitArm64::FallBackToInterpreter(UGeckoInstruction inst)
     gpr.Unlock(WA);
   }
 
+  if (GekkoOPInfo* info = PPCTables::GetOpInfo(inst))
+  {
+    ARM64Reg WA = gpr.GetReg();
+    ARM64Reg WB = gpr.GetReg();
+    ARM64Reg XA = EncodeRegTo64(WA);
+    ARM64Reg XB = EncodeRegTo64(WB);
+    MOVP2R(XA, &info->fallbackCount);
+    LDR(IndexType::Unsigned, XB, XA, 0);
+    ADD(XB, XB, 1);
+    STR(IndexType::Unsigned, XB, XA, 0);
+    gpr.Unlock(WA, WB);
+  }
+
   Interpreter::Instruction instr = PPCTables::GetInterpreterOp(inst);
   MOVP2R(ARM64Reg::X8, instr);
   MOVI2R(ARM64Reg::W0, inst.hex);
@@ -500,6 +521,23 @@ bool JitArm64::HandleFunctionHooking(u32 address)
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
     HLEFunction(hook_index);
 
+    if (type == HLE::HookType::TryReplace)
+    {
+      // Leave the block unless the HLE function left it to the original code
+      LDR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(npc));
+      ARM64Reg WA = gpr.GetReg();
+      MOVI2R(WA, address);
+      CMP(DISPATCHER_PC, WA);
+      gpr.Unlock(WA);
+      FixupBranch fall_back = B(CC_EQ);
+      const u32 downcount_amount = js.downcountAmount;
+      js.downcountAmount += js.st.numCycles;
+      WriteExit(DISPATCHER_PC);
+      js.downcountAmount = downcount_amount;
+      SetJumpTarget(fall_back);
+      return false;
+    }
+
     if (type != HLE::HookType::Replace)
       return false;
 
@@ -582,6 +620,8 @@ void JitArm64::Jit(u32)
 
   if (IsAlmostFull() || farcode.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
   {
+    if (!SConfig::GetInstance().bJITNoBlockCache)
+      CountCacheFullClear();
     ClearCache();
   }
   const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
@@ -34,6 +34,7 @@ public:
   bool HandleFastmemFault(uintptr_t access_address, SContext* ctx);
 
   void ClearCache() override;
+  CodeSpaceUsage GetCodeSpaceUsage() const override;
 
   CommonAsmRoutinesBase* GetAsmRoutines() override { return this; }
   void Run() override;
@@ -197,6 +198,8 @@ protected:
   {
     const u8* fastmem_code;
     const u8* slowmem_code;
+    // The address of the guest instruction the access belongs to.
+    u32 guest_address;
   };
 
   void CompileInstruction(PPCAnalyst::CodeOp& op);
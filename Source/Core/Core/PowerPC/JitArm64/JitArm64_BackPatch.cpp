@@ -53,6 +53,15 @@ void JitArm64::DoBacktrace(uintptr_t access_address, SContext* ctx)
 void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, ARM64Reg RS,
                                     ARM64Reg addr, BitSet32 gprs_to_push, BitSet32 fprs_to_push)
 {
+  // An instruction which took a fastmem fault before most likely accesses MMIO, so go straight to
+  // slowmem instead of taking the fault again after every recompile.
+  if (fastmem && do_farcode &&
+      js.fastmemFaultCounts.find(js.compilerPC) != js.fastmemFaultCounts.end())
+  {
+    fastmem = false;
+    do_farcode = false;
+  }
+
   bool in_far_code = false;
   const u8* fastmem_start = GetCodePtr();
 
@@ -145,12 +154,14 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
         m_handler_to_loc[handler] = handler_loc;
         fastmem_area->fastmem_code = fastmem_start;
         fastmem_area->slowmem_code = handler_loc;
+        fastmem_area->guest_address = js.compilerPC;
       }
       else
       {
         const u8* handler_loc = handler_loc_iter->second;
         fastmem_area->fastmem_code = fastmem_start;
         fastmem_area->slowmem_code = handler_loc;
+        fastmem_area->guest_address = js.compilerPC;
         return;
       }
     }
@@ -275,6 +286,7 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
   while (emitter.GetCodePtr() < fastmem_area_end)
     emitter.NOP();
 
+  js.fastmemFaultCounts[slow_handler_iter->second.guest_address]++;
   m_fault_to_handler.erase(slow_handler_iter);
 
   emitter.FlushIcache();
@@ -457,10 +457,23 @@ void JitArm64::lmw(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITLoadStoreOff);
-  FALLBACK_IF(!jo.fastmem || jo.memcheck);
+  FALLBACK_IF(jo.memcheck);
 
   u32 a = inst.RA;
 
+  if (!jo.fastmem)
+  {
+    // Without fastmem, each word goes through the regular load routine. rA being overwritten
+    // partway through (an invalid form) is left to the interpreter.
+    FALLBACK_IF(a && a >= inst.RD);
+    for (u32 i = inst.RD; i < 32; i++)
+    {
+      SafeLoadToReg(i, a ? a : -1, -1, BackPatchInfo::FLAG_LOAD | BackPatchInfo::FLAG_SIZE_32,
+                    inst.SIMM_16 + 4 * (i - inst.RD), false);
+    }
+    return;
+  }
+
   ARM64Reg WA = gpr.GetReg();
   ARM64Reg XA = EncodeRegTo64(WA);
   if (a)
@@ -520,10 +533,20 @@ void JitArm64::stmw(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITLoadStoreOff);
-  FALLBACK_IF(!jo.fastmem || jo.memcheck);
+  FALLBACK_IF(jo.memcheck);
 
   u32 a = inst.RA;
 
+  if (!jo.fastmem)
+  {
+    for (u32 i = inst.RD; i < 32; i++)
+    {
+      SafeStoreFromReg(a ? a : -1, i, -1, BackPatchInfo::FLAG_STORE | BackPatchInfo::FLAG_SIZE_32,
+                       inst.SIMM_16 + 4 * (i - inst.RD));
+    }
+    return;
+  }
+
   ARM64Reg WA = gpr.GetReg();
   ARM64Reg XA = EncodeRegTo64(WA);
   ARM64Reg WB = gpr.GetReg();
@@ -3,9 +3,14 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <atomic>
+
 #include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -14,9 +19,51 @@ const u8* JitBase::Dispatch(JitBase& jit)
   return jit.GetBlockCache()->Dispatch();
 }
 
+static std::atomic<u64> s_compile_calls{0};
+static std::atomic<u64> s_compile_time_us{0};
+static std::atomic<u64> s_blocks_compiled{0};
+static std::atomic<u64> s_cache_full_clears{0};
+static std::atomic<u64> s_blocks_evicted{0};
+static std::atomic<u64> s_code_space_used{0};
+static std::atomic<u64> s_code_space_size{0};
+
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  TRACE_SCOPE("Jit");
+  const u64 start_us = Common::Timer::GetTimeUs();
   jit.Jit(em_address);
+  s_compile_time_us.fetch_add(Common::Timer::GetTimeUs() - start_us, std::memory_order_relaxed);
+  s_compile_calls.fetch_add(1, std::memory_order_relaxed);
+
+  const JitBase::CodeSpaceUsage usage = jit.GetCodeSpaceUsage();
+  s_code_space_used.store(usage.used, std::memory_order_relaxed);
+  s_code_space_size.store(usage.size, std::memory_order_relaxed);
+}
+
+JitInterface::CompileStats JitBase::GetCompileStats()
+{
+  return {s_compile_calls.load(std::memory_order_relaxed),
+          s_compile_time_us.load(std::memory_order_relaxed),
+          s_blocks_compiled.load(std::memory_order_relaxed),
+          s_cache_full_clears.load(std::memory_order_relaxed),
+          s_blocks_evicted.load(std::memory_order_relaxed),
+          s_code_space_used.load(std::memory_order_relaxed),
+          s_code_space_size.load(std::memory_order_relaxed)};
+}
+
+void JitBase::CountCompiledBlock()
+{
+  s_blocks_compiled.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JitBase::CountCacheFullClear()
+{
+  s_cache_full_clears.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JitBase::CountEvictedBlocks(u64 count)
+{
+  s_blocks_evicted.fetch_add(count, std::memory_order_relaxed);
 }
 
 JitBase::JitBase() : m_code_buffer(code_buffer_size)
@@ -41,9 +88,25 @@ bool JitBase::CanMergeNextInstructions(int count) const
   return true;
 }
 
+bool JitBase::InterpretColdBlock(u32 em_address)
+{
+  if (!jo.interpretColdBlocks)
+    return false;
+
+  const auto result = js.coldBlockMisses.emplace(em_address, 0);
+  if (++result.first->second > COLD_BLOCK_INTERPRET_MISSES)
+  {
+    js.coldBlockMisses.erase(result.first);
+    return false;
+  }
+
+  PowerPC::ppcState.downcount -= Interpreter::getInstance()->RunBlock();
+  return true;
+}
+
 void JitBase::UpdateMemoryOptions()
 {
   bool any_watchpoints = PowerPC::memchecks.HasAny();
   jo.fastmem = SConfig::GetInstance().bFastmem && jo.fastmem_arena && (MSR.DR || !any_watchpoints);
-  jo.memcheck = SConfig::GetInstance().bMMU || any_watchpoints;
+  jo.memcheck = SConfig::GetInstance().bMMU || PowerPC::memchecks.HasAnyBreakOnHit();
 }
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "Common/BitSet.h"
@@ -15,6 +16,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 //#define JIT_LOG_GENERATED_CODE  // Enables logging of generated code
@@ -64,6 +66,17 @@ protected:
     bool fastmem_arena;
     bool memcheck;
     bool profile_blocks;
+    // Compile blocks with a cheap analysis first and recompile them with all optimizations
+    // once they have run tier_up_threshold times.
+    bool tiering;
+    u32 tier_up_threshold;
+    // Run blocks through the interpreter on their first few misses instead of compiling them
+    // right away, so code which only runs once never pays for compilation. The interpreter's
+    // timing differs from the JIT's, so this is not deterministic against normal JIT runs.
+    bool interpretColdBlocks;
+    // Destroy the coldest blocks when the code space runs out and only clear the whole cache if
+    // that doesn't free enough space. Only for backends which can reuse freed code space.
+    bool evictColdBlocks;
   };
   struct JitState
   {
@@ -105,13 +118,25 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    std::unordered_set<u32> hotBlockAddresses;
+    // Misses of blocks not compiled yet because of JitOptions::interpretColdBlocks.
+    std::unordered_map<u32, u32> coldBlockMisses;
+    // Number of fastmem faults taken by the instruction at each address. These instructions most
+    // likely access MMIO, so backends may skip fastmem for them when recompiling.
+    std::unordered_map<u32, u32> fastmemFaultCounts;
   };
 
   PPCAnalyst::CodeBlock code_block;
   PPCAnalyst::CodeBuffer m_code_buffer;
   PPCAnalyst::PPCAnalyzer analyzer;
 
+  // Number of misses a block is interpreted for before it gets compiled.
+  static constexpr u32 COLD_BLOCK_INTERPRET_MISSES = 4;
+
   bool CanMergeNextInstructions(int count) const;
+  // Interprets the block at em_address instead of compiling it, if it has not missed often
+  // enough yet. Returns whether the block was interpreted.
+  bool InterpretColdBlock(u32 em_address);
 
   void UpdateMemoryOptions();
 
@@ -124,6 +149,20 @@ public:
 
   virtual void Jit(u32 em_address) = 0;
 
+  // Totals of the calls to Jit() made through JitTrampoline and of the code cache telemetry below
+  static JitInterface::CompileStats GetCompileStats();
+  static void CountCompiledBlock();
+  static void CountCacheFullClear();
+  static void CountEvictedBlocks(u64 count);
+
+  struct CodeSpaceUsage
+  {
+    size_t used = 0;
+    size_t size = 0;
+  };
+  // Bytes of near and far code space in use and in total
+  virtual CodeSpaceUsage GetCodeSpaceUsage() const { return {}; }
+
   virtual const CommonAsmRoutinesBase* GetAsmRoutines() = 0;
 
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
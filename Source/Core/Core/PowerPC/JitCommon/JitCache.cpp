@@ -12,9 +12,11 @@
 #include <array>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
@@ -33,8 +35,23 @@ using namespace Gen;
 
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  const u64 end = u64(address) + length;
+  return std::any_of(physical_ranges.begin(), physical_ranges.end(),
+                     [&](const PhysicalRange& range) {
+                       return range.begin < end && address < range.end;
+                     });
+}
+
+// Removes value from a short vector without keeping the order
+template <typename T>
+static void EraseUnordered(std::vector<T>& vector, const T& value)
+{
+  const auto it = std::find(vector.begin(), vector.end(), value);
+  if (it == vector.end())
+    return;
+
+  *it = vector.back();
+  vector.pop_back();
 }
 
 JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
@@ -64,6 +81,9 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
+  m_jit.js.coldBlockMisses.clear();
+  m_jit.js.fastmemFaultCounts.clear();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -71,6 +91,7 @@ void JitBaseBlockCache::Clear()
   block_map.clear();
   links_to.clear();
   block_range_map.clear();
+  m_block_code_bytes = 0;
 
   valid_block.ClearAll();
 
@@ -113,20 +134,30 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   fast_block_map[index] = &block;
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.compile_sequence = m_next_compile_sequence++;
+  m_block_code_bytes += (block.near_end - block.near_begin) + (block.far_end - block.far_begin);
+  JitBase::CountCompiledBlock();
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  // The addresses are sorted, so consecutive instructions can be merged into ranges directly
+  block.physical_ranges.clear();
   for (u32 addr : physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+    if (!block.physical_ranges.empty() && block.physical_ranges.back().end == addr)
+      block.physical_ranges.back().end = addr + 4;
+    else
+      block.physical_ranges.push_back({addr, addr + 4});
   }
 
+  ForEachRangeBucket(block, [&](u32 bucket) { block_range_map[bucket].push_back(&block); });
+
   if (block_link)
   {
     for (const auto& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      std::vector<JitBlock*>& sources = links_to[e.exitAddress];
+      if (std::find(sources.begin(), sources.end(), &block) == sources.end())
+        sources.push_back(&block);
     }
 
     LinkBlock(block);
@@ -260,60 +291,177 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
       {
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
+        m_jit.js.fastmemFaultCounts.erase(i);
       }
     }
   }
 }
 
+void JitBaseBlockCache::InvalidatePhysicalRange(u32 physical_address, u32 length)
+{
+  const u32 first_line = physical_address / 32;
+  const u32 last_line = (physical_address + length + 0x1f) / 32;
+  for (u32 i = first_line; i < last_line; ++i)
+    valid_block.Clear(i);
+
+  ErasePhysicalRange(physical_address, length);
+
+  // These are keyed by effective address, so there is no telling which entries belonged to the
+  // replaced code. They are rebuilt as the exceptions happen again.
+  m_jit.js.fifoWriteAddresses.clear();
+  m_jit.js.pairedQuantizeAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
+}
+
+template <typename F>
+void JitBaseBlockCache::ForEachRangeBucket(const JitBlock& block, F f)
+{
+  // The ranges are sorted, so a bucket shared by two ranges can only repeat the last one
+  bool any = false;
+  u32 last_bucket = 0;
+  for (const JitBlock::PhysicalRange& range : block.physical_ranges)
+  {
+    const u32 first = range.begin / BLOCK_RANGE_MAP_ELEMENTS;
+    const u32 last = (range.end - 1) / BLOCK_RANGE_MAP_ELEMENTS;
+    for (u32 bucket = any && first == last_bucket ? first + 1 : first; bucket <= last; ++bucket)
+      f(bucket);
+    any = true;
+    last_bucket = last;
+  }
+}
+
+void JitBaseBlockCache::RemoveFromRangeMap(const JitBlock& block, u32 skip_bucket)
+{
+  ForEachRangeBucket(block, [&](u32 bucket) {
+    if (bucket == skip_bucket)
+      return;
+
+    const auto it = block_range_map.find(bucket);
+    if (it == block_range_map.end())
+      return;
+
+    EraseUnordered(it->second, const_cast<JitBlock*>(&block));
+    if (it->second.empty())
+      block_range_map.erase(it);
+  });
+}
+
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  if (length == 0)
+    return;
+
+  // Collect the macro blocks which overlap the given range. Large ranges are matched against the
+  // existing buckets instead of looking up every bucket they span.
+  const u32 first_bucket = address / BLOCK_RANGE_MAP_ELEMENTS;
+  const u32 last_bucket = static_cast<u32>((u64(address) + length - 1) / BLOCK_RANGE_MAP_ELEMENTS);
+  std::vector<u32> buckets;
+  if (last_bucket - first_bucket < block_range_map.size())
+  {
+    for (u64 bucket = first_bucket; bucket <= last_bucket; ++bucket)
+      buckets.push_back(static_cast<u32>(bucket));
+  }
+  else
   {
+    for (const auto& entry : block_range_map)
+    {
+      if (entry.first >= first_bucket && entry.first <= last_bucket)
+        buckets.push_back(entry.first);
+    }
+  }
+
+  for (u32 bucket : buckets)
+  {
+    const auto bucket_iter = block_range_map.find(bucket);
+    if (bucket_iter == block_range_map.end())
+      continue;
+
     // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    std::vector<JitBlock*>& blocks = bucket_iter->second;
+    for (size_t i = 0; i < blocks.size();)
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
-      else
+      JitBlock* block = blocks[i];
+      if (!block->OverlapsPhysicalRange(address, length))
       {
-        iter++;
+        ++i;
+        continue;
       }
+
+      // If the block overlaps, also remove it from the other macro blocks it occupies.
+      blocks[i] = blocks.back();
+      blocks.pop_back();
+      RemoveFromRangeMap(*block, bucket);
+
+      // And remove the block.
+      DestroyBlock(*block);
+      EraseFromBlockMap(*block);
     }
 
     // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    if (blocks.empty())
+      block_range_map.erase(bucket_iter);
+  }
+}
+
+void JitBaseBlockCache::EraseFromBlockMap(const JitBlock& block)
+{
+  auto block_map_iter = block_map.equal_range(block.physicalAddress);
+  while (block_map_iter.first != block_map_iter.second)
+  {
+    if (&block_map_iter.first->second == &block)
+    {
+      block_map.erase(block_map_iter.first);
+      return;
+    }
+    block_map_iter.first++;
   }
 }
 
+size_t JitBaseBlockCache::EvictColdBlocks()
+{
+  std::vector<JitBlock*> blocks;
+  blocks.reserve(block_map.size());
+  for (auto& e : block_map)
+    blocks.push_back(&e.second);
+
+  const size_t count = (blocks.size() + 3) / 4;
+  if (count == 0)
+    return 0;
+
+  if (m_jit.jo.profile_blocks)
+  {
+    std::nth_element(blocks.begin(), blocks.begin() + (count - 1), blocks.end(),
+                     [](const JitBlock* a, const JitBlock* b) {
+                       return a->profile_data.runCount < b->profile_data.runCount;
+                     });
+  }
+  else
+  {
+    std::nth_element(blocks.begin(), blocks.begin() + (count - 1), blocks.end(),
+                     [](const JitBlock* a, const JitBlock* b) {
+                       return a->compile_sequence < b->compile_sequence;
+                     });
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    JitBlock& block = *blocks[i];
+    RemoveFromRangeMap(block, std::numeric_limits<u32>::max());
+    DestroyBlock(block);
+    EraseFromBlockMap(block);
+  }
+
+  JitBase::CountEvictedBlocks(count);
+  return count;
+}
+
+void JitBaseBlockCache::EraseFailedBlock(JitBlock& block)
+{
+  // The block was never finalized, so it isn't linked or in any map besides block_map
+  EraseFromBlockMap(block);
+}
+
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
   return valid_block.m_valid_block.get();
@@ -389,6 +537,8 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
 
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 {
+  m_block_code_bytes -= (block.near_end - block.near_begin) + (block.far_end - block.far_begin);
+
   if (fast_block_map[block.fast_block_map_index] == &block)
     fast_block_map[block.fast_block_map_index] = nullptr;
 
@@ -400,7 +550,7 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
     auto it = links_to.find(e.exitAddress);
     if (it == links_to.end())
       continue;
-    it->second.erase(&block);
+    EraseUnordered(it->second, &block);
     if (it->second.empty())
       links_to.erase(it);
   }
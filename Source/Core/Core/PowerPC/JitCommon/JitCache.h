@@ -12,7 +12,6 @@
 #include <set>
 #include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -78,8 +77,14 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The physical memory occupied by the instructions of this block, as sorted and disjoint
+  // [begin, end) ranges. Blocks are mostly contiguous, so this is usually a single range.
+  struct PhysicalRange
+  {
+    u32 begin;
+    u32 end;
+  };
+  std::vector<PhysicalRange> physical_ranges;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -90,6 +95,13 @@ struct JitBlock : public JitBlockData
     u64 ticStart;
     u64 ticStop;
   } profile_data = {};
+
+  // Remaining runs of a baseline tier block before it gets recompiled; see JitOptions::tiering.
+  u32 tier_up_counter = 0;
+
+  // Position of the block in the order blocks were compiled in, so the oldest blocks can be
+  // evicted first.
+  u64 compile_sequence = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -124,6 +136,12 @@ public:
   bool Test(u32 bit) const { return (m_valid_block[bit / 32] & (1u << (bit % 32))) != 0; }
 };
 
+// Blocks only live for the current session and are never written to disk. The emitted code
+// refers to host addresses (ppcState, the common asm routines, far code, C++ helpers) that change
+// between runs, and compiling a block also depends on more than the guest code and MSR bits
+// (e.g. the constant GQR assumptions and the config-driven analyzer options). A persisted block
+// could therefore be neither relocated nor validated cheaply at dispatch, and a block compiled
+// under different assumptions would change the downcount accounting that movies rely on.
 class JitBaseBlockCache
 {
 public:
@@ -163,6 +181,19 @@ public:
   void InvalidateICache(u32 address, u32 length, bool forced);
   void InvalidateICacheLine(u32 address);
   void ErasePhysicalRange(u32 address, u32 length);
+  // Destroys the blocks overlapping a physical range whose code was replaced without the guest
+  // invalidating it, such as by a savestate load.
+  void InvalidatePhysicalRange(u32 physical_address, u32 length);
+
+  // Destroys the coldest quarter of the blocks, so their code space can be reused instead of
+  // clearing the whole cache. Blocks are ordered by run count while block profiling is enabled and
+  // by age otherwise. Returns the number of destroyed blocks.
+  size_t EvictColdBlocks();
+  // Removes a block returned by AllocateBlock whose code generation failed
+  void EraseFailedBlock(JitBlock& block);
+
+  // Bytes of near and far code of the blocks in the cache
+  size_t GetBlockCodeBytes() const { return m_block_code_bytes; }
 
   u32* GetBlockBitSet() const;
 
@@ -185,19 +216,27 @@ private:
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address);
 
+  // Calls f with the index of every block_range_map bucket the block overlaps, once each
+  template <typename F>
+  static void ForEachRangeBucket(const JitBlock& block, F f);
+  // Removes the block from all its block_range_map buckets except skip_bucket
+  void RemoveFromRangeMap(const JitBlock& block, u32 skip_bucket);
+  // Removes the block from block_map, which destroys it
+  void EraseFromBlockMap(const JitBlock& block);
+
   // links_to hold all exit points of all valid blocks in a reverse way.
-  // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  // It is used to query all blocks which links to an address. The lists are short and
+  // duplicate-free, so they are kept as vectors.
+  std::unordered_map<u32, std::vector<JitBlock*>> links_to;  // destination_PC -> blocks
 
   // Map indexed by the physical address of the entry point.
   // This is used to query the block based on the current PC in a slow way.
   std::multimap<u32, JitBlock> block_map;  // start_addr -> block
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
+  // Blocks overlapping each macro block of 0x100 bytes, indexed by physical address / 0x100.
+  // This is used for invalidation of memory regions. Empty buckets are removed.
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  std::unordered_map<u32, std::vector<JitBlock*>> block_range_map;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
@@ -206,4 +245,7 @@ private:
   // This array is indexed with the masked PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
   std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map;  // start_addr & mask -> number
+
+  u64 m_next_compile_sequence = 0;
+  size_t m_block_code_bytes = 0;
 };
@@ -23,11 +23,14 @@
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
+#include "Core/HW/MMIO.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
 
@@ -42,15 +45,21 @@
 namespace JitInterface
 {
 static JitBase* g_jit = nullptr;
+static bool s_clear_cache_on_state_load = true;
 void SetJit(JitBase* jit)
 {
   g_jit = jit;
 }
 void DoState(PointerWrap& p)
 {
-  if (g_jit && p.GetMode() == PointerWrap::MODE_READ)
+  if (g_jit && p.GetMode() == PointerWrap::MODE_READ && s_clear_cache_on_state_load)
     g_jit->ClearCache();
 }
+
+void SetClearCacheOnStateLoad(bool clear)
+{
+  s_clear_cache_on_state_load = clear;
+}
 CPUCoreBase* InitJitCore(PowerPC::CPUCore core)
 {
   switch (core)
@@ -75,6 +84,7 @@ CPUCoreBase* InitJitCore(PowerPC::CPUCore core)
     g_jit = nullptr;
     return nullptr;
   }
+  PPCTables::ResetInterpreterFallbackCounts();
   g_jit->Init();
   return g_jit;
 }
@@ -90,6 +100,7 @@ void SetProfilingState(ProfilingState state)
     return;
 
   g_jit->jo.profile_blocks = state == ProfilingState::Enabled;
+  Memory::mmio_mapping->SetAccessCountingEnabled(state == ProfilingState::Enabled);
 }
 
 void WriteProfileResults(const std::string& filename)
@@ -117,6 +128,36 @@ void WriteProfileResults(const std::string& filename)
                                   static_cast<double>(prof_stats.countsPerSec),
                               stat.block_size));
   }
+
+  if (!prof_stats.fastmem_faults.empty())
+  {
+    f.WriteString("\nfaultAddr\tfuncName\tfastmemFaults\n");
+    for (const auto& [address, faults] : prof_stats.fastmem_faults)
+    {
+      f.WriteString(fmt::format("{0:08x}\t{1}\t{2}\n", address,
+                                g_symbolDB.GetDescription(address), faults));
+    }
+  }
+
+  const auto fallback_counts = PPCTables::GetInterpreterFallbackCounts();
+  if (!fallback_counts.empty())
+  {
+    f.WriteString("\ninstruction\tinterpreterFallbacks\n");
+    for (const auto& [name, count] : fallback_counts)
+      f.WriteString(fmt::format("{0}\t{1}\n", name, count));
+  }
+
+  std::vector<MMIO::AccessCount> mmio_counts;
+  Core::RunAsCPUThread([&mmio_counts] { mmio_counts = Memory::mmio_mapping->GetAccessCounts(); });
+  if (mmio_counts.empty())
+    return;
+
+  f.WriteString("\nmmioAddr\tsize\taccess\tcount\n");
+  for (const MMIO::AccessCount& count : mmio_counts)
+  {
+    f.WriteString(fmt::format("{0:08x}\t{1}\t{2}\t{3}\n", count.address, count.size,
+                              count.write ? "write" : "read", count.count));
+  }
 }
 
 void GetProfileResults(Profiler::ProfileStats* prof_stats)
@@ -128,6 +169,7 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
   prof_stats->cost_sum = 0;
   prof_stats->timecost_sum = 0;
   prof_stats->block_stats.clear();
+  prof_stats->fastmem_faults.clear();
 
   Core::RunAsCPUThread([&prof_stats] {
     QueryPerformanceFrequency((LARGE_INTEGER*)&prof_stats->countsPerSec);
@@ -144,6 +186,8 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
     });
 
     sort(prof_stats->block_stats.begin(), prof_stats->block_stats.end());
+    prof_stats->fastmem_faults.insert(g_jit->js.fastmemFaultCounts.begin(),
+                                      g_jit->js.fastmemFaultCounts.end());
   });
 }
 
@@ -186,6 +230,11 @@ int GetHostCode(u32* address, const u8** code, u32* code_size)
   return 0;
 }
 
+CompileStats GetCompileStats()
+{
+  return JitBase::GetCompileStats();
+}
+
 bool HandleFault(uintptr_t access_address, SContext* ctx)
 {
   // Prevent nullptr dereference on a crash with no JIT present
@@ -224,6 +273,12 @@ void InvalidateICache(u32 address, u32 size, bool forced)
     g_jit->GetBlockCache()->InvalidateICache(address, size, forced);
 }
 
+void InvalidatePhysicalRange(u32 physical_address, u32 length)
+{
+  if (g_jit)
+    g_jit->GetBlockCache()->InvalidatePhysicalRange(physical_address, length);
+}
+
 void InvalidateICacheLine(u32 address)
 {
   if (g_jit)
@@ -264,6 +319,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &g_jit->js.hotBlockAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -28,11 +28,16 @@ enum class ExceptionType
 {
   FIFOWrite,
   PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  HotBlock
 };
 
 void DoState(PointerWrap& p);
 
+// Loading a state clears the JIT cache unless this is disabled, in which case the caller decides
+// whether the loaded state requires it.
+void SetClearCacheOnStateLoad(bool clear);
+
 CPUCoreBase* InitJitCore(PowerPC::CPUCore core);
 CPUCoreBase* GetCore();
 
@@ -48,6 +53,24 @@ void WriteProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
 
+struct CompileStats
+{
+  // Entries into the JIT, including cold blocks that were interpreted instead of compiled
+  u64 calls = 0;
+  u64 time_us = 0;
+  u64 blocks_compiled = 0;
+  // Clears of the whole cache because the code space or the trampolines ran out
+  u64 cache_full_clears = 0;
+  // Blocks destroyed to make room with Core.JITEvictColdBlocks
+  u64 blocks_evicted = 0;
+  // Bytes of code space in use and in total, as of the last compile
+  u64 code_space_used = 0;
+  u64 code_space_size = 0;
+};
+
+// Totals since Dolphin was started, can be called from any thread
+CompileStats GetCompileStats();
+
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
 bool HandleStackFault();
@@ -64,6 +87,7 @@ void ClearSafe();
 void InvalidateICache(u32 address, u32 size, bool forced);
 void InvalidateICacheLine(u32 address);
 void InvalidateICacheLines(u32 address, u32 count);
+void InvalidatePhysicalRange(u32 physical_address, u32 length);
 
 void CompileExceptionCheck(ExceptionType type);
 
@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/MMU.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
@@ -10,9 +12,13 @@
 
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
+#include "Common/Swap.h"
 
+#include "Core/CPUTimeBreakdown.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
 #include "Core/HW/GPFifo.h"
@@ -170,6 +176,7 @@ static void EFB_Write(u32 data, u32 addr)
 
 BatTable ibat_table;
 BatTable dbat_table;
+static u32 s_dbat_generation = 0;
 
 static void GenerateDSIException(u32 effective_address, bool write);
 
@@ -252,6 +259,7 @@ static T ReadFromHardware(u32 em_address)
 
   if (flag == XCheckTLBFlag::Read && (em_address & 0xF8000000) == 0x08000000)
   {
+    CPUTimeBreakdown::Scope time_scope(CPUTimeBreakdown::GetMMIOCounter(em_address));
     if (em_address < 0x0c000000)
       return EFB_Read(em_address);
     else
@@ -326,6 +334,7 @@ static void WriteToHardware(u32 em_address, const u32 data, const u32 size)
 
   if (flag == XCheckTLBFlag::Write && (em_address & 0xF8000000) == 0x08000000)
   {
+    CPUTimeBreakdown::Scope time_scope(CPUTimeBreakdown::GetMMIOCounter(em_address));
     if (em_address < 0x0c000000)
     {
       EFB_Write(data, em_address);
@@ -898,18 +907,138 @@ TryReadResult<std::string> HostTryReadString(u32 address, size_t size, Requested
   return TryReadResult<std::string>(c.translated, std::move(s));
 }
 
-bool IsOptimizableRAMAddress(const u32 address)
+// Returns the host memory backing a physical address, and how many bytes from there on are
+// backed contiguously, or nullptr if the address isn't RAM.
+static u8* GetHostPointerForRange(u32 address, size_t* contiguous_size)
+{
+  const u32 segment = address >> 28;
+  const u32 offset = address & 0x0FFFFFFF;
+  if (Memory::m_pRAM && segment == 0x0 && offset < Memory::GetRamSizeReal())
+  {
+    *contiguous_size = Memory::GetRamSizeReal() - offset;
+    return &Memory::m_pRAM[offset];
+  }
+  if (Memory::m_pEXRAM && segment == 0x1 && offset < Memory::GetExRamSizeReal())
+  {
+    *contiguous_size = Memory::GetExRamSizeReal() - offset;
+    return &Memory::m_pEXRAM[offset];
+  }
+  if (Memory::m_pFakeVMEM && (address & 0xFE000000) == 0x7E000000)
+  {
+    const u32 fake_vmem_offset = address & Memory::GetFakeVMemMask();
+    *contiguous_size = Memory::GetFakeVMemMask() + 1 - fake_vmem_offset;
+    return &Memory::m_pFakeVMEM[fake_vmem_offset];
+  }
+  if (Memory::m_pL1Cache && segment == 0xE && address < 0xE0000000 + Memory::GetL1CacheSize())
+  {
+    *contiguous_size = Memory::GetL1CacheSize() - offset;
+    return &Memory::m_pL1Cache[offset];
+  }
+  return nullptr;
+}
+
+bool HostTryReadRange(u32 address, void* dest, size_t size, RequestedAddressSpace space)
+{
+  bool translate;
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    translate = MSR.DR;
+    break;
+  case RequestedAddressSpace::Physical:
+    translate = false;
+    break;
+  case RequestedAddressSpace::Virtual:
+    if (!MSR.DR)
+      return false;
+    translate = true;
+    break;
+  default:
+    assert(0);
+    return false;
+  }
+
+  u8* out = static_cast<u8*>(dest);
+  while (size != 0)
+  {
+    // Translate once per page, then copy as much as the page and the backing memory allow
+    u32 physical_address = address;
+    size_t chunk_size = size;
+    if (translate)
+    {
+      const auto translated = TranslateAddress<XCheckTLBFlag::NoException>(address);
+      if (!translated.Success())
+        return false;
+      physical_address = translated.address;
+      chunk_size = std::min<size_t>(chunk_size, HW_PAGE_SIZE - (address & (HW_PAGE_SIZE - 1)));
+    }
+
+    size_t contiguous_size;
+    const u8* src = GetHostPointerForRange(physical_address, &contiguous_size);
+    if (!src)
+      return false;
+    chunk_size = std::min(chunk_size, contiguous_size);
+
+    std::memcpy(out, src, chunk_size);
+    out += chunk_size;
+    address += static_cast<u32>(chunk_size);
+    size -= chunk_size;
+  }
+  return true;
+}
+
+#ifdef _M_X86
+FUNCTION_TARGET_SSSE3
+static size_t SwapRangeSSSE3(u8* data, size_t size, size_t value_size)
+{
+  const __m128i mask = value_size == sizeof(u16) ?
+                           _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1) :
+                           _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16)
+  {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_shuffle_epi8(value, mask));
+  }
+  return i;
+}
+#endif
+
+template <typename T>
+static bool HostTryReadRangeSwapped(u32 address, T* dest, size_t count, RequestedAddressSpace space)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (!HostTryReadRange(address, dest, count * sizeof(T), space))
     return false;
 
+  size_t i = 0;
+#ifdef _M_X86
+  if (cpu_info.bSSSE3)
+    i = SwapRangeSSSE3(reinterpret_cast<u8*>(dest), count * sizeof(T), sizeof(T)) / sizeof(T);
+#endif
+  for (; i < count; ++i)
+    dest[i] = Common::FromBigEndian(dest[i]);
+  return true;
+}
+
+bool HostTryReadRangeU16(u32 address, u16* dest, size_t count, RequestedAddressSpace space)
+{
+  return HostTryReadRangeSwapped(address, dest, count, space);
+}
+
+bool HostTryReadRangeU32(u32 address, u32* dest, size_t count, RequestedAddressSpace space)
+{
+  return HostTryReadRangeSwapped(address, dest, count, space);
+}
+
+bool IsOptimizableRAMAddress(const u32 address)
+{
   if (!MSR.DR)
     return false;
 
   // TODO: This API needs to take an access size
   //
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. This is cleared for the pages with memchecks.
   u32 bat_result = dbat_table[address >> BAT_INDEX_SHIFT];
   return (bat_result & BAT_PHYSICAL_BIT) != 0;
 }
@@ -947,6 +1076,43 @@ static bool IsRAMAddress(u32 address, bool translate)
   return false;
 }
 
+u8* HostGetDirectPointer(u32 address, size_t* size)
+{
+  if (memchecks.HasAny())
+    return nullptr;
+
+  u32 physical_address = address;
+  if (MSR.DR)
+  {
+    u32 page = address >> BAT_INDEX_SHIFT;
+    if ((dbat_table[page] & BAT_PHYSICAL_BIT) == 0)
+      return nullptr;
+    physical_address = (dbat_table[page] & BAT_RESULT_MASK) | (address & (BAT_PAGE_SIZE - 1));
+
+    // The following BAT pages only count if they map to the following physical pages
+    size_t mapped_size = BAT_PAGE_SIZE - (address & (BAT_PAGE_SIZE - 1));
+    while (mapped_size < *size && page + 1 < dbat_table.size())
+    {
+      const u32 next = dbat_table[page + 1];
+      if ((next & BAT_PHYSICAL_BIT) == 0 ||
+          (next & BAT_RESULT_MASK) != (dbat_table[page] & BAT_RESULT_MASK) + BAT_PAGE_SIZE)
+      {
+        break;
+      }
+      ++page;
+      mapped_size += BAT_PAGE_SIZE;
+    }
+    *size = std::min(*size, mapped_size);
+  }
+
+  size_t contiguous_size;
+  u8* pointer = GetHostPointerForRange(physical_address, &contiguous_size);
+  if (!pointer)
+    return nullptr;
+  *size = std::min(*size, contiguous_size);
+  return pointer;
+}
+
 bool HostIsRAMAddress(u32 address, RequestedAddressSpace space)
 {
   switch (space)
@@ -1089,7 +1255,11 @@ void ClearCacheLine(u32 address)
 
 u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.OverlapsMemcheck(address, BAT_PAGE_SIZE))
+    return 0;
+
+  // Inlined accesses wouldn't get counted
+  if (Memory::mmio_mapping->IsAccessCountingEnabled())
     return 0;
 
   if (!MSR.DR)
@@ -1112,7 +1282,7 @@ u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 
 bool IsOptimizableGatherPipeWrite(u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.OverlapsMemcheck(address, BAT_PAGE_SIZE))
     return false;
 
   if (!MSR.DR)
@@ -1223,6 +1393,37 @@ void SDRUpdated()
 
   ppcState.pagetable_base = htaborg << 16;
   ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+  ClearTranslationCache();
+}
+
+// The emulated TLB only has 128 entries, so games that map a lot of memory through the page table
+// keep missing it and walking the hashed page table. This direct-mapped cache remembers many more
+// page translations behind it. Like the TLB, it is indexed by the page index of the effective
+// address, so tlbie invalidates every entry it affects. The tag includes the whole segment register
+// so that entries stay correct when segment registers change.
+constexpr u32 TRANSLATION_CACHE_SIZE = 0x1000;
+
+struct TranslationCacheEntry
+{
+  static constexpr u32 INVALID_TAG = 0xffffffff;
+
+  u32 tag = INVALID_TAG;
+  u32 sr = 0;
+  u32 pte = 0;
+};
+
+static std::array<std::array<TranslationCacheEntry, TRANSLATION_CACHE_SIZE>, NUM_TLBS>
+    s_translation_cache;
+
+static TranslationCacheEntry& GetTranslationCacheEntry(const XCheckTLBFlag flag, const u32 address)
+{
+  const u32 index = (address >> HW_PAGE_INDEX_SHIFT) & (TRANSLATION_CACHE_SIZE - 1);
+  return s_translation_cache[IsOpcodeFlag(flag)][index];
+}
+
+void ClearTranslationCache()
+{
+  s_translation_cache = {};
 }
 
 enum class TLBLookupResult
@@ -1307,6 +1508,9 @@ void InvalidateTLBEntry(u32 address)
 
   ppcState.tlb[0][entry_index].Invalidate();
   ppcState.tlb[1][entry_index].Invalidate();
+
+  GetTranslationCacheEntry(XCheckTLBFlag::Read, address) = {};
+  GetTranslationCacheEntry(XCheckTLBFlag::Opcode, address) = {};
 }
 
 union EffectiveAddress
@@ -1350,7 +1554,23 @@ static TranslateAddressResult TranslatePageAddress(const EffectiveAddress addres
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
   }
 
-  const u32 offset = address.offset;          // 12 bit
+  const u32 offset = address.offset;  // 12 bit
+  const u32 tag = address.Hex >> HW_PAGE_INDEX_SHIFT;
+
+  TranslationCacheEntry& cache_entry = GetTranslationCacheEntry(flag, address.Hex);
+  if (res == TLBLookupResult::NotFound && cache_entry.tag == tag && cache_entry.sr == sr.Hex)
+  {
+    // A write to a page that hasn't been changed yet still has to set the C bit in the page table
+    const UPTE_Hi pte2(cache_entry.pte);
+    if (flag != XCheckTLBFlag::Write || pte2.C != 0)
+    {
+      UpdateTLBEntry(flag, pte2, address.Hex);
+      *wi = (pte2.WIMG & 0b1100) != 0;
+      return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
+                                    (pte2.RPN << 12) | offset};
+    }
+  }
+
   const u32 page_index = address.page_index;  // 16 bit
   const u32 VSID = sr.VSID;                   // 24 bit
   const u32 api = address.API;                //  6 bit (part of page_index)
@@ -1404,6 +1624,7 @@ static TranslateAddressResult TranslatePageAddress(const EffectiveAddress addres
         if (!IsNoExceptionFlag(flag))
         {
           Memory::Write_U32(pte2.Hex, pteg_addr + 4);
+          cache_entry = TranslationCacheEntry{tag, sr.Hex, pte2.Hex};
         }
 
         // We already updated the TLB entry if this was caused by a C bit.
@@ -1547,10 +1768,17 @@ void DBATUpdated()
   Memory::UpdateLogicalMemory(dbat_table);
 #endif
 
+  s_dbat_generation++;
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   JitInterface::ClearSafe();
 }
 
+u32 GetDBATGeneration()
+{
+  return s_dbat_generation;
+}
+
 void IBATUpdated()
 {
   ibat_table = {};
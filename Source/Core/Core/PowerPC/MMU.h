@@ -87,6 +87,18 @@ TryReadResult<std::string>
 HostTryReadString(u32 address, size_t size = 0,
                   RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+// Copies size bytes of emulated memory starting at the given address into dest. Unlike reading
+// value by value, this translates each page only once and copies directly from host memory.
+// Returns false if any part of the range isn't backed by RAM, in which case dest may have been
+// partially written.
+bool HostTryReadRange(u32 address, void* dest, size_t size,
+                      RequestedAddressSpace space = RequestedAddressSpace::Effective);
+// Like HostTryReadRange, but reads count big endian values and converts them to host endianness.
+bool HostTryReadRangeU16(u32 address, u16* dest, size_t count,
+                         RequestedAddressSpace space = RequestedAddressSpace::Effective);
+bool HostTryReadRangeU32(u32 address, u32* dest, size_t count,
+                         RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
 // Writes a value to emulated memory using the currently active MMU settings.
 // If the write fails (eg. address does not correspond to a mapped address in the current address
 // space), a PanicAlert will be shown to the user.
@@ -136,6 +148,11 @@ bool HostIsRAMAddress(u32 address, RequestedAddressSpace space = RequestedAddres
 bool HostIsInstructionRAMAddress(u32 address,
                                  RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+// Returns a host pointer to the memory at the given effective address if the CPU would access it
+// as RAM through the DBATs (or with translation off) and no memchecks are set, or nullptr
+// otherwise. *size is clamped to the number of bytes that can be accessed through the pointer.
+u8* HostGetDirectPointer(u32 address, size_t* size);
+
 // Routines for the CPU core to access memory.
 
 // Used by interpreter to read instructions, uses iCache
@@ -181,8 +198,12 @@ void ClearCacheLine(u32 address);  // Zeroes 32 bytes; address should be 32-byte
 // TLB functions
 void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
+// Drops the host-side cache of page table translations behind the TLB
+void ClearTranslationCache();
 void DBATUpdated();
 void IBATUpdated();
+// Changes on every DBATUpdated call, so that the results of HostGetDirectPointer can be cached
+u32 GetDBATGeneration();
 
 // Result changes based on the BAT registers and MSR.DR.  Returns whether
 // it's safe to optimize a read or write to this address to an unguarded
@@ -7,6 +7,7 @@
 #include <map>
 #include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fmt/format.h>
@@ -40,8 +41,25 @@ namespace PPCAnalyst
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
+// Calls to straight-line leaf functions up to this size (in bytes) are inlined together with their
+// return without counting against BRANCH_FOLLOWING_THRESHOLD.
+constexpr u32 LEAF_INLINING_MAX_SIZE = 0x40;
+
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
+// The bl scan of FindFunctions doesn't get much faster beyond this many threads
+constexpr size_t MAX_FUNCTION_SCAN_THREADS = 8;
+
+static bool IsInlinableLeaf(u32 address)
+{
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (!symbol || symbol->address != address || symbol->size > LEAF_INLINING_MAX_SIZE)
+    return false;
+
+  constexpr u32 flags = Common::FFLAG_LEAF | Common::FFLAG_STRAIGHT;
+  return (symbol->flags & flags) == flags;
+}
+
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
 {
   switch (instr.OPCD)
@@ -250,39 +268,81 @@ static bool CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b)
   return true;
 }
 
+// Returns the addresses of all functions that a bl in the given words calls, in the order of the
+// calls. The words are the instructions starting at start_addr, 0 where they couldn't be read.
+static std::vector<u32> FindBranchTargets(u32 start_addr, const u32* words, size_t count)
+{
+  std::vector<u32> targets;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const UGeckoInstruction instr = words[i];
+    if (instr.OPCD == 18 && instr.LK && PPCTables::IsValidInstruction(instr))
+    {
+      const u32 addr = start_addr + static_cast<u32>(i * sizeof(u32));
+      u32 target = SignExt26(instr.LI << 2);
+      if (!instr.AA)
+        target += addr;
+      targets.push_back(target);
+    }
+  }
+  return targets;
+}
+
 // Most functions that are relevant to analyze should be
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
 // get called.
 static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, Common::SymbolDB* func_db)
 {
-  for (u32 addr = startAddr; addr < endAddr; addr += 4)
+  if (endAddr <= startAddr)
+    return;
+
+  // Copy the code out of emulated memory a page at a time, which is much faster than reading it
+  // instruction by instruction, so that the scan itself can be split across threads
+  const size_t count = (endAddr - startAddr + 3) / sizeof(u32);
+  std::vector<u32> words(count);
+  for (size_t i = 0; i < count;)
   {
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
-    const UGeckoInstruction instr = read_result.hex;
-
-    if (read_result.valid && PPCTables::IsValidInstruction(instr))
+    const u32 addr = startAddr + static_cast<u32>(i * sizeof(u32));
+    const size_t page_count = std::min<size_t>(
+        count - i, (PowerPC::HW_PAGE_SIZE - (addr & (PowerPC::HW_PAGE_SIZE - 1))) / sizeof(u32));
+    if (!PowerPC::HostTryReadRangeU32(addr, &words[i], page_count))
     {
-      switch (instr.OPCD)
-      {
-      case 18:  // branch instruction
+      for (size_t j = 0; j < page_count; ++j)
       {
-        if (instr.LK)  // bl
-        {
-          u32 target = SignExt26(instr.LI << 2);
-          if (!instr.AA)
-            target += addr;
-          if (PowerPC::HostIsRAMAddress(target))
-          {
-            func_db->AddFunction(target);
-          }
-        }
-      }
-      break;
-      default:
-        break;
+        const PowerPC::TryReadInstResult read_result =
+            PowerPC::TryReadInstruction(addr + static_cast<u32>(j * sizeof(u32)));
+        words[i + j] = read_result.valid ? read_result.hex : 0;
       }
     }
+    i += page_count;
+  }
+
+  const size_t thread_count =
+      std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_FUNCTION_SCAN_THREADS);
+  const size_t words_per_thread = (count + thread_count - 1) / thread_count;
+  std::vector<std::vector<u32>> targets(thread_count);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count && i * words_per_thread < count; ++i)
+  {
+    threads.emplace_back([&, i] {
+      const size_t first = i * words_per_thread;
+      targets[i] = FindBranchTargets(startAddr + static_cast<u32>(first * sizeof(u32)),
+                                     &words[first], std::min(words_per_thread, count - first));
+    });
+  }
+  targets[0] = FindBranchTargets(startAddr, words.data(), std::min(words_per_thread, count));
+  for (std::thread& thread : threads)
+    thread.join();
+
+  // Adding the functions analyzes them, which reads emulated memory and has to stay on this thread
+  for (const std::vector<u32>& thread_targets : targets)
+  {
+    for (const u32 target : thread_targets)
+    {
+      if (PowerPC::HostIsRAMAddress(target))
+        func_db->AddFunction(target);
+    }
   }
 }
 
@@ -677,30 +737,118 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
   }
 }
 
+namespace
+{
+// Tracks which registers and CR fields a candidate busy wait loop depends on. Skipping the loop is
+// only safe if every value it reads either comes from memory or was computed earlier in the same
+// iteration. Then each iteration behaves the same until an event or an interrupt changes memory.
+class BusyWaitTracker
+{
+public:
+  void ReadGPRs(BitSet32 regs) { m_gpr_write_disallowed |= regs & ~m_gpr_written; }
+  bool WriteGPRs(BitSet32 regs) { return Write(regs, m_gpr_written, m_gpr_write_disallowed); }
+
+  void ReadCRFields(BitSet8 fields) { m_cr_write_disallowed |= fields & ~m_cr_written; }
+  bool WriteCRFields(BitSet8 fields) { return Write(fields, m_cr_written, m_cr_write_disallowed); }
+
+private:
+  template <typename T>
+  static bool Write(T regs, T& written, T write_disallowed)
+  {
+    if (regs & write_disallowed)
+      return false;
+    written |= regs;
+    return true;
+  }
+
+  BitSet32 m_gpr_written;
+  BitSet32 m_gpr_write_disallowed;
+  BitSet8 m_cr_written;
+  BitSet8 m_cr_write_disallowed;
+};
+
+BitSet8 GetCRFieldsOut(const CodeOp& op)
+{
+  BitSet8 fields;
+  if (op.outputCR0)
+    fields[0] = true;
+  if (op.outputCR1)
+    fields[1] = true;
+  if (op.opinfo->flags & FL_SET_CRn)
+    fields[op.inst.CRFD] = true;
+  return fields;
+}
+
+// Memory barriers have no effect in emulation
+bool IsMemoryBarrier(UGeckoInstruction inst)
+{
+  return (inst.OPCD == 31 && (inst.SUBOP10 == 598 || inst.SUBOP10 == 854)) ||  // sync, eieio
+         (inst.OPCD == 19 && inst.SUBOP10 == 150);                            // isync
+}
+
+bool IsCRInstruction(UGeckoInstruction inst)
+{
+  return inst.OPCD == 19 && (inst.SUBOP10 == 0 || (inst.SUBOP10 & 0x1f) == 1);  // mcrf, crXXX
+}
+
+// Applies a CR logical instruction or mcrf to the tracker, and returns whether the loop can
+// still be a busy wait loop.
+bool TrackCRInstruction(BusyWaitTracker& tracker, UGeckoInstruction inst)
+{
+  BitSet8 in;
+  BitSet8 out;
+  if (inst.SUBOP10 == 0)
+  {
+    in[inst.CRFS] = true;
+    out[inst.CRFD] = true;
+  }
+  else
+  {
+    // The other bits of the destination field are kept, so it's read as well
+    in[inst.CRBA / 4] = true;
+    in[inst.CRBB / 4] = true;
+    in[inst.CRBD / 4] = true;
+    out[inst.CRBD / 4] = true;
+  }
+  tracker.ReadCRFields(in);
+  return tracker.WriteCRFields(out);
+}
+}  // namespace
+
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions)
 {
   // Very basic algorithm to detect busy wait loops:
   //   * It loops to itself and does not contain any other branches.
   //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
+  //   * It only reads from registers and CR fields it wrote to earlier in the loop, or it
+  //     does not write to these registers and CR fields.
+  //   * Besides loads and integer instructions, only memory barriers and CR logical
+  //     instructions are allowed, as these are common in code polling volatile flags.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
+  // Inlined calls of short leaf functions (see LEAF_INLINING_MAX_SIZE) are analyzed like the
+  // rest of the loop, which covers the common bl/cmp/bne loops around DSP and other register
+  // accessors.
+  BusyWaitTracker tracker;
   for (size_t i = 0; i <= instructions; ++i)
   {
-    if (code[i].opinfo->type == OpType::Branch)
+    const CodeOp& op = code[i];
+    if (op.opinfo->type == OpType::Branch)
     {
-      if (code[i].branchUsesCtr)
+      if (op.branchUsesCtr)
         return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
+      if (op.branchTo == block->m_address && i == instructions)
         return true;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+    else if (IsMemoryBarrier(op.inst))
+    {
+      continue;
+    }
+    else if (IsCRInstruction(op.inst))
+    {
+      if (!TrackCRInstruction(tracker, op.inst))
+        return false;
+    }
+    else if (op.opinfo->type != OpType::Integer && op.opinfo->type != OpType::Load)
     {
       // In the future, some subsets of other instruction types might get
       // supported. Right now, only try loops that have this very
@@ -709,22 +857,9 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
     }
     else
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
-      {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
-          return false;
-        written_regs[reg] = true;
-      }
+      tracker.ReadGPRs(op.regsIn);
+      if (!tracker.WriteGPRs(op.regsOut) || !tracker.WriteCRFields(GetCRFieldsOut(op)))
+        return false;
     }
   }
   return false;
@@ -756,6 +891,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
 
   bool found_exit = false;
   bool found_call = false;
+  bool found_leaf_call = false;
   size_t caller = 0;
   u32 numFollows = 0;
   u32 num_inst = 0;
@@ -787,6 +923,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     SetInstructionStats(block, &code[i], opinfo, static_cast<u32>(i));
 
     bool follow = false;
+    // Following this branch doesn't count against BRANCH_FOLLOWING_THRESHOLD
+    bool free_follow = false;
 
     bool conditional_continue = false;
 
@@ -804,6 +942,11 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
         {
           found_call = true;
           caller = i;
+
+          // Short leaf functions return right away, so the call and its return are inlined
+          // together as a trace through the function.
+          found_leaf_call = IsInlinableLeaf(code[i].branchTo);
+          free_follow = found_leaf_call;
         }
       }
       else if (inst.OPCD == 16 && (inst.BO & BO_DONT_DECREMENT_FLAG) &&
@@ -814,6 +957,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
         if (inst.LK)
         {
           found_call = true;
+          found_leaf_call = false;
           caller = i;
         }
       }
@@ -821,7 +965,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
       {
         code[i].branchTo = code[caller].address + 4;
         if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) &&
-            numFollows < BRANCH_FOLLOWING_THRESHOLD)
+            (found_leaf_call || numFollows < BRANCH_FOLLOWING_THRESHOLD))
         {
           // bclrx with unconditional branch = return
           // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -830,7 +974,9 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
           // the LR value on the stack as there are no spare registers. So we'd need
           // to check all store instruction to not alias with the stack.
           follow = true;
+          free_follow = found_leaf_call;
           found_call = false;
+          found_leaf_call = false;
           code[i].skip = true;
 
           // Skip the RET, so also don't generate the stack entry for the BLR optimization.
@@ -881,10 +1027,11 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (follow && (free_follow || numFollows < BRANCH_FOLLOWING_THRESHOLD))
     {
       // Follow the unconditional branch.
-      numFollows++;
+      if (!free_follow)
+        numFollows++;
       address = code[i].branchTo;
     }
     else
@@ -919,7 +1066,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   // Scan for flag dependencies; assume the next block (or any branch that can leave the block)
   // wants flags, to be safe.
   bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = true;
-  BitSet32 fprInUse, gprInUse, gprDiscardable, fprDiscardable, fprInXmm;
+  BitSet32 fprInUse, gprInUse, gprLive, gprDiscardable, fprDiscardable, fprInXmm;
   for (int i = block->m_num_instructions - 1; i >= 0; i--)
   {
     CodeOp& op = code[i];
@@ -941,11 +1088,13 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     wantsFPRF &= !op.outputFPRF || opWantsFPRF;
     wantsCA &= !op.outputCA || opWantsCA;
     op.gprInUse = gprInUse;
+    op.gprLive = gprLive;
     op.fprInUse = fprInUse;
     op.gprDiscardable = gprDiscardable;
     op.fprDiscardable = fprDiscardable;
     op.fprInXmm = fprInXmm;
     gprInUse |= op.regsIn;
+    gprLive = (gprLive & ~op.regsOut) | op.regsIn;
     fprInUse |= op.fregsIn;
     if (op.canEndBlock || op.canCauseException)
     {
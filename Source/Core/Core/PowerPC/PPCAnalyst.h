@@ -50,6 +50,9 @@ struct CodeOp  // 16B
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
   BitSet32 gprInUse;
+  // which GPRs hold a value a later instruction in this block reads, i.e. that isn't overwritten
+  // first
+  BitSet32 gprLive;
   // which registers have values which are known to be unused after this instruction
   BitSet32 gprDiscardable;
   BitSet32 fprDiscardable;
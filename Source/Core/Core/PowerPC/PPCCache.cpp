@@ -98,6 +98,7 @@ void InstructionCache::Reset()
   lookup_table.fill(0xFF);
   lookup_table_ex.fill(0xFF);
   lookup_table_vmem.fill(0xFF);
+  last_line = ICACHE_NO_LINE;
   JitInterface::ClearSafe();
 }
 
@@ -128,6 +129,7 @@ void InstructionCache::Invalidate(u32 addr)
     }
   }
   valid[set] = 0;
+  last_line = ICACHE_NO_LINE;
   JitInterface::InvalidateICacheLine(addr);
 }
 
@@ -136,6 +138,10 @@ u32 InstructionCache::ReadInstruction(u32 addr)
   if (!HID0.ICE || SConfig::GetInstance().bDisableICache)  // instruction cache is disabled
     return Memory::Read_U32(addr);
   u32 set = (addr >> 5) & 0x7f;
+
+  if ((addr & ~0x1f) == last_line)
+    return Common::swap32(data[set][last_way][(addr >> 2) & 7]);
+
   u32 tag = addr >> 12;
 
   u32 t;
@@ -184,6 +190,8 @@ u32 InstructionCache::ReadInstruction(u32 addr)
   }
   // update plru
   plru[set] = (plru[set] & ~s_plru_mask[t]) | s_plru_value[t];
+  last_line = addr & ~0x1f;
+  last_way = t;
   const u32 res = Common::swap32(data[set][t][(addr >> 2) & 7]);
   const u32 inmem = Memory::Read_U32(addr);
   if (res != inmem)
@@ -205,5 +213,8 @@ void InstructionCache::DoState(PointerWrap& p)
   p.DoArray(lookup_table);
   p.DoArray(lookup_table_ex);
   p.DoArray(lookup_table_vmem);
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    last_line = ICACHE_NO_LINE;
 }
 }  // namespace PowerPC
@@ -19,6 +19,9 @@ constexpr u32 ICACHE_BLOCK_SIZE = 8;
 constexpr u32 ICACHE_EXRAM_BIT = 0x10000000;
 constexpr u32 ICACHE_VMEM_BIT = 0x20000000;
 
+// Never matches a line address, since those are 32 byte aligned
+constexpr u32 ICACHE_NO_LINE = 0xFFFFFFFF;
+
 struct InstructionCache
 {
   std::array<std::array<std::array<u32, ICACHE_BLOCK_SIZE>, ICACHE_WAYS>, ICACHE_SETS> data;
@@ -30,6 +33,12 @@ struct InstructionCache
   std::array<u8, 1 << 21> lookup_table_ex;
   std::array<u8, 1 << 20> lookup_table_vmem;
 
+  // The line and way of the previous fetch. Sequential fetches mostly stay in the same line, which
+  // is then still resident and already the most recently used way of its set, so they can skip
+  // the lookup. Not saved in savestates.
+  u32 last_line = ICACHE_NO_LINE;
+  u32 last_way = 0;
+
   InstructionCache();
   u32 ReadInstruction(u32 addr);
   void Invalidate(u32 addr);
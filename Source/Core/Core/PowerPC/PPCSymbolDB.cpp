@@ -4,9 +4,8 @@
 #include "Core/PowerPC/PPCSymbolDB.h"
 
 #include <algorithm>
-#include <cstring>
+#include <charconv>
 #include <map>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -15,6 +14,7 @@
 #include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -46,6 +46,7 @@ Common::Symbol* PPCSymbolDB::AddFunction(u32 start_addr)
   Common::Symbol* ptr = &m_functions[start_addr];
   ptr->type = Common::Symbol::Type::Function;
   m_checksum_to_function[ptr->hash].insert(ptr);
+  m_symbols_by_address_dirty = true;
   return ptr;
 }
 
@@ -86,24 +87,25 @@ void PPCSymbolDB::AddKnownSymbol(u32 startAddr, u32 size, const std::string& nam
       tf.size = size;
     }
     m_functions[startAddr] = tf;
+    m_symbols_by_address_dirty = true;
   }
 }
 
 Common::Symbol* PPCSymbolDB::GetSymbolFromAddr(u32 addr)
 {
-  auto it = m_functions.lower_bound(addr);
-  if (it == m_functions.end())
+  // The last symbol starting at or before the address
+  const auto& symbols = GetSymbolsByAddress();
+  auto it = std::upper_bound(symbols.begin(), symbols.end(), addr,
+                             [](u32 value, const auto& entry) { return value < entry.first; });
+  if (it == symbols.begin())
     return nullptr;
+  --it;
 
-  // If the address is exactly the start address of a symbol, we're done.
-  if (it->second.address == addr)
-    return &it->second;
-
-  // Otherwise, check whether the address is within the bounds of a symbol.
-  if (it != m_functions.begin())
-    --it;
-  if (addr >= it->second.address && addr < it->second.address + it->second.size)
-    return &it->second;
+  // If the address is exactly the start address of a symbol, we're done. Otherwise, check
+  // whether the address is within the bounds of the symbol.
+  Common::Symbol* symbol = it->second;
+  if (it->first == addr || addr < it->first + symbol->size)
+    return symbol;
 
   return nullptr;
 }
@@ -197,6 +199,33 @@ void PPCSymbolDB::LogFunctionCall(u32 addr)
   f.num_calls++;
 }
 
+// Splits off the next whitespace separated word of the line, like the %s of scanf.
+static std::string_view NextWord(std::string_view* line)
+{
+  const size_t start = line->find_first_not_of(" \t");
+  if (start == std::string_view::npos)
+  {
+    *line = {};
+    return {};
+  }
+
+  const size_t end = std::min(line->find_first_of(" \t", start), line->size());
+  const std::string_view word = line->substr(start, end - start);
+  line->remove_prefix(end);
+  return word;
+}
+
+static bool IsHexWord(std::string_view word)
+{
+  return !word.empty() && word.find_first_not_of("0123456789abcdefABCDEF") == std::string::npos;
+}
+
+static bool NextHexWord(std::string_view* line, u32* value)
+{
+  const std::string_view word = NextWord(line);
+  return std::from_chars(word.data(), word.data() + word.size(), *value, 16).ec == std::errc{};
+}
+
 // The use case for handling bad map files is when you have a game with a map file on the disc,
 // but you can't tell whether that map file is for the particular release version used in that game,
 // or when you know that the map file is not for that build, but perhaps half the functions in the
@@ -224,8 +253,8 @@ void PPCSymbolDB::LogFunctionCall(u32 addr)
 // bad=true means carefully load map files that might not be from exactly the right version
 bool PPCSymbolDB::LoadMap(const std::string& filename, bool bad)
 {
-  File::IOFile f(filename, "r");
-  if (!f)
+  std::string contents;
+  if (!File::ReadFileToString(filename, contents))
     return false;
 
   // Two columns are used by Super Smash Bros. Brawl Korean map file
@@ -235,25 +264,28 @@ bool PPCSymbolDB::LoadMap(const std::string& filename, bool bad)
   int good_count = 0;
   int bad_count = 0;
 
-  char line[512];
+  std::string_view remaining = contents;
   std::string section_name;
-  while (fgets(line, 512, f.GetHandle()))
+  while (!remaining.empty())
   {
-    size_t length = strlen(line);
-    if (length < 4)
+    const size_t line_end = remaining.find('\n');
+    std::string_view line = remaining.substr(0, line_end);
+    remaining.remove_prefix(line_end == std::string_view::npos ? remaining.size() : line_end + 1);
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+    if (line.size() < 3)
       continue;
 
-    char temp[256]{};
-    sscanf(line, "%255s", temp);
+    std::string_view words = line;
+    const std::string_view first_word = NextWord(&words);
 
-    if (strcmp(temp, "UNUSED") == 0)
+    if (first_word == "UNUSED")
       continue;
 
     // Support CodeWarrior and Dolphin map
-    if (StringEndsWith(line, " section layout\n") || strcmp(temp, ".text") == 0 ||
-        strcmp(temp, ".init") == 0)
+    if (StringEndsWith(line, " section layout") || first_word == ".text" || first_word == ".init")
     {
-      section_name = temp;
+      section_name = first_word;
       continue;
     }
 
@@ -265,12 +297,11 @@ bool PPCSymbolDB::LoadMap(const std::string& filename, bool bad)
     //   Starting        Virtual
     //   address  Size   address
     //   -----------------------
-    if (strcmp(temp, "Starting") == 0)
-      continue;
-    if (strcmp(temp, "address") == 0)
-      continue;
-    if (strcmp(temp, "-----------------------") == 0)
+    if (first_word == "Starting" || first_word == "address" ||
+        first_word == "-----------------------")
+    {
       continue;
+    }
 
     // Skip link map.
     //
@@ -282,7 +313,7 @@ bool PPCSymbolDB::LoadMap(const std::string& filename, bool bad)
     //    3] _stack_addr found as linker generated symbol
     // ...
     //           10] EXILock(func, global) found in exi.a EXIBios.c
-    if (StringEndsWith(temp, "]"))
+    if (StringEndsWith(first_word, "]"))
       continue;
 
     // TODO - Handle/Write a parser for:
@@ -295,17 +326,9 @@ bool PPCSymbolDB::LoadMap(const std::string& filename, bool bad)
     // Column detection heuristic
     if (column_count == 0)
     {
-      constexpr auto is_hex_str = [](const std::string& s) {
-        return !s.empty() && s.find_first_not_of("0123456789abcdefABCDEF") == std::string::npos;
-      };
-      const std::string stripped_line(StripSpaces(line));
-      std::istringstream iss(stripped_line);
-      iss.imbue(std::locale::classic());
-      std::string word;
-
       // Two columns format:
       // 80004000 zz_80004000_
-      if (!(iss >> word) || word.length() != 8 || !is_hex_str(word))
+      if (first_word.length() != 8 || !IsHexWord(first_word))
         continue;
       column_count = 2;
 
@@ -313,80 +336,51 @@ bool PPCSymbolDB::LoadMap(const std::string& filename, bool bad)
       //  Starting        Virtual
       //  address  Size   address
       //  -----------------------
-      if (iss && iss >> word && is_hex_str(word) && iss >> word && is_hex_str(word))
+      std::string_view columns = words;
+      if (IsHexWord(NextWord(&columns)) && IsHexWord(NextWord(&columns)))
+      {
         column_count = 3;
-      else
-        iss.str("");
-
-      // Four columns format:
-      //  Starting        Virtual  File
-      //  address  Size   address  offset
-      //  ---------------------------------
-      if (iss && iss >> word && word.length() == 8 && is_hex_str(word))
-        column_count = 4;
+
+        // Four columns format:
+        //  Starting        Virtual  File
+        //  address  Size   address  offset
+        //  ---------------------------------
+        const std::string_view fourth_column = NextWord(&columns);
+        if (fourth_column.length() == 8 && IsHexWord(fourth_column))
+          column_count = 4;
+      }
     }
 
-    u32 address, vaddress, size, offset, alignment;
-    char name[512], container[512];
+    // Some entries in the table have a function name followed by " (entry of " followed by a
+    // container name, followed by ")" instead of an alignment
+    bool entry_of_container = false;
+    u32 address, vaddress, size, offset;
+    words = line;
     if (column_count == 4)
     {
       // sometimes there is no alignment value, and sometimes it is because it is an entry of
       // something else
-      if (length > 37 && line[37] == ' ')
+      entry_of_container = line.size() > 37 && line[37] == ' ';
+      if (!NextHexWord(&words, &address) || !NextHexWord(&words, &size) ||
+          !NextHexWord(&words, &vaddress) || !NextHexWord(&words, &offset))
       {
-        alignment = 0;
-        sscanf(line, "%08x %08x %08x %08x %511s", &address, &size, &vaddress, &offset, name);
-        char* s = strstr(line, "(entry of ");
-        if (s)
-        {
-          sscanf(s + 10, "%511s", container);
-          char* s2 = (strchr(container, ')'));
-          if (s2 && container[0] != '.')
-          {
-            s2[0] = '\0';
-            strcat(container, "::");
-            strcat(container, name);
-            strcpy(name, container);
-          }
-        }
-      }
-      else
-      {
-        sscanf(line, "%08x %08x %08x %08x %i %511s", &address, &size, &vaddress, &offset,
-               &alignment, name);
+        continue;
       }
     }
     else if (column_count == 3)
     {
-      // some entries in the table have a function name followed by " (entry of " followed by a
-      // container name, followed by ")"
-      // instead of a space followed by a number followed by a space followed by a name
-      if (length > 27 && line[27] != ' ' && strstr(line, "(entry of "))
-      {
-        alignment = 0;
-        sscanf(line, "%08x %08x %08x %511s", &address, &size, &vaddress, name);
-        char* s = strstr(line, "(entry of ");
-        if (s)
-        {
-          sscanf(s + 10, "%511s", container);
-          char* s2 = (strchr(container, ')'));
-          if (s2 && container[0] != '.')
-          {
-            s2[0] = '\0';
-            strcat(container, "::");
-            strcat(container, name);
-            strcpy(name, container);
-          }
-        }
-      }
-      else
+      entry_of_container = line.size() > 27 && line[27] != ' ' &&
+                           line.find("(entry of ") != std::string_view::npos;
+      if (!NextHexWord(&words, &address) || !NextHexWord(&words, &size) ||
+          !NextHexWord(&words, &vaddress))
       {
-        sscanf(line, "%08x %08x %08x %i %511s", &address, &size, &vaddress, &alignment, name);
+        continue;
       }
     }
     else if (column_count == 2)
     {
-      sscanf(line, "%08x %511s", &address, name);
+      if (!NextHexWord(&words, &address))
+        continue;
       vaddress = address;
       size = 0;
     }
@@ -394,42 +388,55 @@ bool PPCSymbolDB::LoadMap(const std::string& filename, bool bad)
     {
       break;
     }
-    const char* namepos = strstr(line, name);
-    if (namepos != nullptr)  // would be odd if not :P
-      strcpy(name, namepos);
-    name[strlen(name) - 1] = 0;
-    if (name[strlen(name) - 1] == '\r')
-      name[strlen(name) - 1] = 0;
-
-    // Check if this is a valid entry.
-    if (strlen(name) > 0)
+
+    // Skip the alignment
+    if (column_count > 2 && !entry_of_container)
+      NextWord(&words);
+
+    // The name is the rest of the line
+    std::string_view name_word = NextWord(&words);
+    if (name_word.empty())
+      continue;
+    std::string name(line.substr(name_word.data() - line.data()));
+
+    if (entry_of_container)
     {
-      // Can't compute the checksum if not in RAM
-      bool good = !bad && PowerPC::HostIsInstructionRAMAddress(vaddress) &&
-                  PowerPC::HostIsInstructionRAMAddress(vaddress + size - 4);
-      if (!good)
+      const size_t entry_of = line.find("(entry of ");
+      if (entry_of != std::string_view::npos)
       {
-        // check for BLR before function
-        PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(vaddress - 4);
-        if (read_result.valid && read_result.hex == 0x4e800020)
-        {
-          // check for BLR at end of function
-          read_result = PowerPC::TryReadInstruction(vaddress + size - 4);
-          good = read_result.valid && read_result.hex == 0x4e800020;
-        }
+        std::string_view container_words = line.substr(entry_of + 10);
+        const std::string_view container = NextWord(&container_words);
+        const size_t container_end = container.find(')');
+        if (container_end != std::string_view::npos && container[0] != '.')
+          name = fmt::format("{}::{}", container.substr(0, container_end), name_word);
       }
-      if (good)
+    }
+
+    // Can't compute the checksum if not in RAM
+    bool good = !bad && PowerPC::HostIsInstructionRAMAddress(vaddress) &&
+                PowerPC::HostIsInstructionRAMAddress(vaddress + size - 4);
+    if (!good)
+    {
+      // check for BLR before function
+      PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(vaddress - 4);
+      if (read_result.valid && read_result.hex == 0x4e800020)
       {
-        ++good_count;
-        if (section_name == ".text" || section_name == ".init")
-          AddKnownSymbol(vaddress, size, name, Common::Symbol::Type::Function);
-        else
-          AddKnownSymbol(vaddress, size, name, Common::Symbol::Type::Data);
+        // check for BLR at end of function
+        read_result = PowerPC::TryReadInstruction(vaddress + size - 4);
+        good = read_result.valid && read_result.hex == 0x4e800020;
       }
+    }
+    if (good)
+    {
+      ++good_count;
+      if (section_name == ".text" || section_name == ".init")
+        AddKnownSymbol(vaddress, size, name, Common::Symbol::Type::Function);
       else
-      {
-        ++bad_count;
-      }
+        AddKnownSymbol(vaddress, size, name, Common::Symbol::Type::Data);
+    }
+    else
+    {
+      ++bad_count;
     }
   }
 
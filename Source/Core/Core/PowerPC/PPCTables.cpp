@@ -160,6 +160,26 @@ void PrintInstructionRunCounts()
   }
 }
 
+std::vector<std::pair<const char*, u64>> GetInterpreterFallbackCounts()
+{
+  std::vector<std::pair<const char*, u64>> counts;
+  for (size_t i = 0; i < m_numInstructions; ++i)
+  {
+    const GekkoOPInfo* pInst = m_allInstructions[i];
+    if (pInst->fallbackCount != 0)
+      counts.emplace_back(pInst->opname, pInst->fallbackCount);
+  }
+  std::sort(counts.begin(), counts.end(),
+            [](const auto& a, const auto& b) { return a.second > b.second; });
+  return counts;
+}
+
+void ResetInterpreterFallbackCounts()
+{
+  for (size_t i = 0; i < m_numInstructions; ++i)
+    m_allInstructions[i]->fallbackCount = 0;
+}
+
 void LogCompiledInstructions()
 {
   static unsigned int time = 0;
@@ -5,6 +5,8 @@
 
 #include <array>
 #include <cstddef>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/PowerPC/Gekko.h"
@@ -100,6 +102,8 @@ struct GekkoOPInfo
   u64 runCount;
   int compileCount;
   u32 lastUse;
+  // How often the JIT had the interpreter run the instruction, counted by the JIT code
+  u64 fallbackCount;
 };
 extern std::array<GekkoOPInfo*, 64> m_infoTable;
 extern std::array<GekkoOPInfo*, 1024> m_infoTable4;
@@ -121,6 +125,9 @@ bool UsesFPU(UGeckoInstruction inst);
 
 void CountInstruction(UGeckoInstruction inst);
 void PrintInstructionRunCounts();
+// The instructions which fell back to the interpreter at least once, most frequent first
+std::vector<std::pair<const char*, u64>> GetInterpreterFallbackCounts();
+void ResetInterpreterFallbackCounts();
 void LogCompiledInstructions();
 const char* GetInstructionName(UGeckoInstruction inst);
 }  // namespace PPCTables
@@ -133,6 +133,7 @@ void DoState(PointerWrap& p)
   if (p.GetMode() == PointerWrap::MODE_READ)
   {
     RoundingModeUpdated();
+    ClearTranslationCache();
     IBATUpdated();
     DBATUpdated();
   }
@@ -272,6 +273,7 @@ void Reset()
   ppcState.pagetable_base = 0;
   ppcState.pagetable_hashmask = 0;
   ppcState.tlb = {};
+  ClearTranslationCache();
 
   ResetRegisters();
   ppcState.iCache.Reset();
@@ -607,12 +609,16 @@ void CheckExternalExceptions()
 
 void CheckBreakPoints()
 {
-  if (!PowerPC::breakpoints.IsBreakPointEnable(PC))
+  const TBreakPoint* bp = PowerPC::breakpoints.GetBreakPoint(PC);
+  if (!bp || !bp->is_enabled)
     return;
 
-  if (PowerPC::breakpoints.IsBreakPointBreakOnHit(PC))
+  if (bp->condition && !bp->condition->IsMet(GPR(bp->condition->gpr)))
+    return;
+
+  if (bp->break_on_hit)
     CPU::Break();
-  if (PowerPC::breakpoints.IsBreakPointLogOnHit(PC))
+  if (bp->log_on_hit)
   {
     NOTICE_LOG_FMT(MEMMAP,
                    "BP {:08x} {}({:08x} {:08x} {:08x} {:08x} {:08x} {:08x} {:08x} {:08x} {:08x} "
@@ -620,7 +626,7 @@ void CheckBreakPoints()
                    PC, g_symbolDB.GetDescription(PC), GPR(3), GPR(4), GPR(5), GPR(6), GPR(7),
                    GPR(8), GPR(9), GPR(10), GPR(11), GPR(12), LR);
   }
-  if (PowerPC::breakpoints.IsTempBreakPoint(PC))
+  if (bp->is_temporary)
     PowerPC::breakpoints.Remove(PC);
 }
 
@@ -0,0 +1,191 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/ProfileTrace.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/Profiler.h"
+
+namespace ProfileTrace
+{
+// Functions beyond the most expensive ones of a sample are summed up as "other"
+constexpr size_t MAX_FUNCTIONS_PER_SAMPLE = 32;
+
+static std::mutex s_mutex;
+static File::IOFile s_file;
+static u32 s_interval_frames;
+static u32 s_frames_until_sample;
+static bool s_profiling_enabled;
+static bool s_first_event;
+static u64 s_start_time_us;
+// Host ticks spent in each block as of the previous sample, by block start address
+static std::unordered_map<u32, u64> s_previous_ticks;
+
+static std::string EscapeJSON(std::string_view str)
+{
+  std::string result;
+  result.reserve(str.size());
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      result += '\\';
+      result += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      result += fmt::format("\\u{:04x}", c);
+    }
+    else
+    {
+      result += c;
+    }
+  }
+  return result;
+}
+
+static std::string GetFunctionName(u32 address)
+{
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (!symbol)
+    return fmt::format("{:08x}", address);
+  return symbol->name;
+}
+
+static void WriteSample()
+{
+  Profiler::ProfileStats stats;
+  JitInterface::GetProfileResults(&stats);
+  if (stats.countsPerSec == 0)
+    return;
+
+  // Blocks for the same address with different MSR bits are counted together
+  std::unordered_map<u32, u64> ticks;
+  for (const Profiler::BlockStat& stat : stats.block_stats)
+    ticks[stat.addr] += stat.tick_counter;
+
+  std::unordered_map<std::string, u64> function_ticks;
+  for (const auto& [address, block_ticks] : ticks)
+  {
+    // The counters start over when a block gets recompiled
+    const auto previous = s_previous_ticks.find(address);
+    u64 delta = block_ticks;
+    if (previous != s_previous_ticks.end() && previous->second <= block_ticks)
+      delta -= previous->second;
+    if (delta != 0)
+      function_ticks[GetFunctionName(address)] += delta;
+  }
+  s_previous_ticks = std::move(ticks);
+
+  std::vector<std::pair<std::string, u64>> functions(function_ticks.begin(), function_ticks.end());
+  std::sort(functions.begin(), functions.end(),
+            [](const auto& a, const auto& b) { return a.second > b.second; });
+
+  u64 other_ticks = 0;
+  for (size_t i = MAX_FUNCTIONS_PER_SAMPLE; i < functions.size(); ++i)
+    other_ticks += functions[i].second;
+  if (functions.size() > MAX_FUNCTIONS_PER_SAMPLE)
+    functions.resize(MAX_FUNCTIONS_PER_SAMPLE);
+  if (other_ticks != 0)
+    functions.emplace_back("other", other_ticks);
+
+  const double ms_per_tick = 1000.0 / static_cast<double>(stats.countsPerSec);
+  std::string args;
+  for (const auto& [name, function_time] : functions)
+  {
+    if (!args.empty())
+      args += ',';
+    args += fmt::format("\"{}\":{:.3f}", EscapeJSON(name), function_time * ms_per_tick);
+  }
+
+  // A counter event per sample, which trace viewers show as a stacked graph of the milliseconds
+  // spent in each function since the previous sample
+  const u64 timestamp = Common::Timer::GetTimeUs() - s_start_time_us;
+  s_file.WriteString(fmt::format(
+      "{}{{\"name\":\"Guest functions (ms)\",\"ph\":\"C\",\"ts\":{},\"pid\":1,\"tid\":1,"
+      "\"args\":{{{}}}}}",
+      s_first_event ? "" : ",\n", timestamp, args));
+  s_file.Flush();
+  s_first_event = false;
+}
+
+bool Start(const std::string& filename, u32 interval_frames)
+{
+  std::lock_guard lock(s_mutex);
+  if (s_file.IsOpen())
+    s_file.WriteString("\n]\n");
+
+  if (!s_file.Open(filename, "w"))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open profile trace file {}", filename);
+    return false;
+  }
+
+  s_file.WriteString("[\n");
+  s_interval_frames = std::max(interval_frames, 1u);
+  s_frames_until_sample = s_interval_frames;
+  s_profiling_enabled = false;
+  s_first_event = true;
+  s_start_time_us = Common::Timer::GetTimeUs();
+  s_previous_ticks.clear();
+  return true;
+}
+
+void Stop()
+{
+  std::lock_guard lock(s_mutex);
+  if (!s_file.IsOpen())
+    return;
+
+  s_file.WriteString("\n]\n");
+  s_file.Close();
+  s_previous_ticks.clear();
+
+  // The blocks keep their profiling code until they get recompiled, which is harmless
+  if (s_profiling_enabled)
+    JitInterface::SetProfilingState(JitInterface::ProfilingState::Disabled);
+  s_profiling_enabled = false;
+}
+
+bool IsActive()
+{
+  std::lock_guard lock(s_mutex);
+  return s_file.IsOpen();
+}
+
+void OnFrameEnd()
+{
+  std::lock_guard lock(s_mutex);
+  if (!s_file.IsOpen())
+    return;
+
+  if (!s_profiling_enabled)
+  {
+    // Recompile everything so that all blocks contain the profiling code
+    JitInterface::ClearCache();
+    JitInterface::SetProfilingState(JitInterface::ProfilingState::Enabled);
+    s_profiling_enabled = true;
+    return;
+  }
+
+  if (--s_frames_until_sample != 0)
+    return;
+
+  s_frames_until_sample = s_interval_frames;
+  WriteSample();
+}
+}  // namespace ProfileTrace
@@ -0,0 +1,24 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Samples the JIT block profile at a regular frame interval and writes the host time spent in each
+// guest function as a Chrome trace event file, which chrome://tracing and Perfetto can open.
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace ProfileTrace
+{
+// Starts writing a trace to the given file with one sample every interval_frames frames. Block
+// profiling gets enabled at the next frame. Returns false if the file can't be created.
+bool Start(const std::string& filename, u32 interval_frames);
+// Finishes the trace file. This also happens when emulation stops.
+void Stop();
+bool IsActive();
+
+// Called at the end of every emulated frame on the CPU thread.
+void OnFrameEnd();
+}  // namespace ProfileTrace
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -31,6 +32,8 @@ struct ProfileStats
   u64 cost_sum;
   u64 timecost_sum;
   u64 countsPerSec;
+  // Guest instruction address -> number of fastmem faults it took
+  std::map<u32, u32> fastmem_faults;
 };
 
 }  // namespace Profiler
@@ -9,7 +9,9 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -101,15 +103,11 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(u32 address, u32 size, const MEGASignature& sig)
+bool Compare(const std::vector<u32>& code, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
-    return false;
-
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 &&
-        PowerPC::HostRead_U32(static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
   }
   return true;
@@ -158,15 +156,33 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
 
 void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
 {
+  // Only signatures of the same size as a function can match it
+  std::unordered_map<size_t, std::vector<const MEGASignature*>> signatures_by_size;
+  for (const auto& sig : m_signatures)
+    signatures_by_size[sig.code.size() * sizeof(u32)].push_back(&sig);
+
+  std::vector<u32> code;
   for (auto& it : symbol_db->AccessSymbols())
   {
     auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    const auto signatures = signatures_by_size.find(symbol.size);
+    if (signatures == signatures_by_size.end())
+      continue;
+
+    // Read the function once instead of once per signature
+    code.resize(symbol.size / sizeof(u32));
+    if (!PowerPC::HostTryReadRangeU32(symbol.address, code.data(), code.size()))
+    {
+      for (size_t i = 0; i < code.size(); ++i)
+        code[i] = PowerPC::HostRead_U32(static_cast<u32>(symbol.address + i * sizeof(u32)));
+    }
+
+    for (const MEGASignature* sig : signatures->second)
     {
-      if (Compare(symbol.address, symbol.size, sig))
+      if (Compare(code, *sig))
       {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
+        symbol.name = sig->name;
+        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig->name, symbol.address,
                      symbol.size);
         break;
       }
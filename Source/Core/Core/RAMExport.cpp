@@ -0,0 +1,146 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/RAMExport.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <string>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/HW/Memmap.h"
+#include "Core/Movie.h"
+
+namespace RAMExport
+{
+#ifndef _WIN32
+constexpr size_t PAGE_ALIGNMENT = 0x1000;
+
+static std::string s_name;
+static Header* s_header = nullptr;
+static size_t s_size = 0;
+static u32 s_frames_until_copy = 0;
+
+static bool Create()
+{
+  const u32 mem1_size = Memory::GetRamSizeReal();
+  const u32 mem2_size = Memory::m_pEXRAM ? Memory::GetExRamSizeReal() : 0;
+  const u32 mem1_offset = static_cast<u32>(Common::AlignUp(sizeof(Header), PAGE_ALIGNMENT));
+  const u32 mem2_offset = mem2_size != 0 ? mem1_offset + mem1_size : 0;
+  const size_t size = size_t(mem1_offset) + mem1_size + mem2_size;
+
+  const std::string name = "/dolphin-emu-ram." + std::to_string(getpid());
+  shm_unlink(name.c_str());
+  const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1)
+  {
+    ERROR_LOG_FMT(CORE, "RAM export: shm_open failed: {}", strerror(errno));
+    return false;
+  }
+
+  if (ftruncate(fd, size) < 0)
+  {
+    ERROR_LOG_FMT(CORE, "RAM export: failed to allocate {} bytes: {}", size, strerror(errno));
+    close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  void* const pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (pointer == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(CORE, "RAM export: mmap failed: {}", strerror(errno));
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  s_name = name;
+  s_size = size;
+  s_header = new (pointer) Header{};
+  s_header->mem1_offset = mem1_offset;
+  s_header->mem1_size = mem1_size;
+  s_header->mem2_offset = mem2_offset;
+  s_header->mem2_size = mem2_size;
+  s_header->version = HEADER_VERSION;
+  // Readers may check the magic to know that the rest of the header is valid
+  std::atomic_thread_fence(std::memory_order_release);
+  s_header->magic = HEADER_MAGIC;
+
+  NOTICE_LOG_FMT(CORE, "RAM export: publishing emulated RAM in shared memory segment {}", name);
+  return true;
+}
+
+static void Copy()
+{
+  u8* const base = reinterpret_cast<u8*>(s_header);
+  const u32 sequence = s_header->sequence.load(std::memory_order_relaxed);
+
+  s_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::memcpy(base + s_header->mem1_offset, Memory::m_pRAM, s_header->mem1_size);
+  if (s_header->mem2_size != 0)
+    std::memcpy(base + s_header->mem2_offset, Memory::m_pEXRAM, s_header->mem2_size);
+  s_header->frame = Movie::GetCurrentFrame();
+
+  s_header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void OnFrameEnd()
+{
+  if (!Config::Get(Config::MAIN_RAM_EXPORT_ENABLED) || !Memory::m_pRAM)
+    return;
+
+  if (!s_header)
+  {
+    if (!Create())
+    {
+      // Don't retry every frame
+      Config::SetCurrent(Config::MAIN_RAM_EXPORT_ENABLED, false);
+      return;
+    }
+    s_frames_until_copy = 1;
+  }
+
+  if (--s_frames_until_copy != 0)
+    return;
+
+  const int interval = Config::Get(Config::MAIN_RAM_EXPORT_INTERVAL);
+  s_frames_until_copy = static_cast<u32>(std::max(interval, 1));
+  Copy();
+}
+
+void Shutdown()
+{
+  if (!s_header)
+    return;
+
+  munmap(s_header, s_size);
+  shm_unlink(s_name.c_str());
+  s_header = nullptr;
+  s_size = 0;
+  s_name.clear();
+}
+#else
+void OnFrameEnd()
+{
+}
+
+void Shutdown()
+{
+}
+#endif
+}  // namespace RAMExport
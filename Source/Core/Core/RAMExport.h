@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Publishes a copy of MEM1 and MEM2 at the end of emulated frames in a named shared memory
+// segment, so that external tools can read emulated RAM without scraping the Dolphin process.
+//
+// The segment is called "/dolphin-emu-ram.<pid>" (see shm_open, or /dev/shm on Linux). It starts
+// with a Header, followed by MEM1 and MEM2 at the offsets given in the header. The header's
+// sequence counter works as a seqlock: it is odd while a frame is being copied, and readers that
+// want a consistent snapshot should copy what they need and retry if the counter was odd or has
+// changed in the meantime.
+
+#pragma once
+
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+namespace RAMExport
+{
+constexpr u32 HEADER_MAGIC = 0x4d415244;  // "DRAM"
+constexpr u32 HEADER_VERSION = 1;
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  std::atomic<u32> sequence;
+  u32 reserved;
+  // Movie frame the RAM copy was taken at
+  u64 frame;
+  u32 mem1_offset;
+  u32 mem1_size;
+  // Both zero for GameCube games
+  u32 mem2_offset;
+  u32 mem2_size;
+};
+
+// Called at the end of every emulated frame on the CPU thread. Creates the segment on first use
+// and copies RAM into it every MAIN_RAM_EXPORT_INTERVAL frames while MAIN_RAM_EXPORT_ENABLED is
+// set.
+void OnFrameEnd();
+
+// Removes the segment. Readers that still have it mapped keep their mapping.
+void Shutdown();
+}  // namespace RAMExport
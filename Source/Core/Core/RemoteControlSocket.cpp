@@ -0,0 +1,268 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/RemoteControlSocket.h"
+
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/State.h"
+#include "InputCommon/GCPadStatus.h"
+
+// Indexed by port, the ports without a value use their configured inputs
+static std::mutex s_pad_overrides_mutex;
+static std::array<std::optional<GCPadStatus>, 4> s_pad_overrides;
+
+namespace
+{
+// Reads the unpadded fields of a request
+class RequestReader
+{
+public:
+  RequestReader(const u8* data, size_t size) : m_data(data), m_end(data + size) {}
+
+  template <typename T>
+  bool Read(T* value)
+  {
+    if (static_cast<size_t>(m_end - m_data) < sizeof(T))
+      return false;
+    std::memcpy(value, m_data, sizeof(T));
+    m_data += sizeof(T);
+    return true;
+  }
+
+  const u8* ReadBytes(size_t size)
+  {
+    if (static_cast<size_t>(m_end - m_data) < size)
+      return nullptr;
+    const u8* bytes = m_data;
+    m_data += size;
+    return bytes;
+  }
+
+private:
+  const u8* m_data;
+  const u8* m_end;
+};
+
+template <typename T>
+void Append(std::vector<u8>* reply, const T& value)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(&value);
+  reply->insert(reply->end(), bytes, bytes + sizeof(T));
+}
+}  // namespace
+
+RemoteControlSocket::RemoteControlSocket()
+{
+  const std::string path = File::GetUserPath(F_REMOTECONTROLSOCKET_IDX);
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+  m_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (m_fd < 0)
+    return;
+
+  // A socket file left behind by a previous run would make bind fail
+  unlink(addr.sun_path);
+  if (bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+  {
+    close(m_fd);
+    m_fd = -1;
+    return;
+  }
+
+  m_running.Set();
+  m_thread = std::thread(&RemoteControlSocket::ThreadFunc, this);
+}
+
+RemoteControlSocket::~RemoteControlSocket()
+{
+  if (m_fd < 0)
+    return;
+
+  m_running.Clear();
+  m_thread.join();
+  close(m_fd);
+  unlink(File::GetUserPath(F_REMOTECONTROLSOCKET_IDX).c_str());
+
+  std::lock_guard lock(s_pad_overrides_mutex);
+  s_pad_overrides = {};
+}
+
+void RemoteControlSocket::ApplyPadOverride(GCPadStatus* pad_status, int port)
+{
+  std::lock_guard lock(s_pad_overrides_mutex);
+  const std::optional<GCPadStatus>& pad_override = s_pad_overrides[port];
+  if (!pad_override)
+    return;
+
+  const bool is_connected = pad_status->isConnected;
+  *pad_status = *pad_override;
+  pad_status->isConnected = is_connected;
+}
+
+void RemoteControlSocket::ThreadFunc()
+{
+  Common::SetCurrentThreadName("RemoteControlSocket");
+
+  std::vector<u8> buffer(MAX_DATAGRAM_SIZE);
+  std::vector<u8> reply;
+  while (m_running.IsSet())
+  {
+    // Wake up regularly to notice shutdown
+    pollfd pfd{m_fd, POLLIN, 0};
+    if (poll(&pfd, 1, 100) <= 0)
+      continue;
+
+    sockaddr_un sender{};
+    socklen_t sender_length = sizeof(sender);
+    const ssize_t size = recvfrom(m_fd, buffer.data(), buffer.size(), 0,
+                                  reinterpret_cast<sockaddr*>(&sender), &sender_length);
+    if (size < static_cast<ssize_t>(sizeof(u32)))
+      continue;
+
+    Command command;
+    std::memcpy(&command, buffer.data(), sizeof(command));
+
+    reply.clear();
+    Append(&reply, command);
+    Append(&reply, u32(0));
+    if (!HandleRequest(command, buffer.data() + sizeof(u32), size - sizeof(u32), &reply))
+    {
+      // Failed requests return no results
+      reply.resize(sizeof(u32));
+      Append(&reply, u32(1));
+    }
+
+    if (sender_length > sizeof(sa_family_t))
+    {
+      sendto(m_fd, reply.data(), reply.size(), 0, reinterpret_cast<sockaddr*>(&sender),
+             sender_length);
+    }
+  }
+}
+
+bool RemoteControlSocket::HandleRequest(Command command, const u8* data, size_t size,
+                                        std::vector<u8>* reply)
+{
+  RequestReader reader(data, size);
+  switch (command)
+  {
+  case Command::Step:
+  {
+    u32 frames;
+    if (!reader.Read(&frames) || !Core::StepFrames(frames, true))
+      return false;
+    Append(reply, Movie::GetCurrentFrame());
+    return true;
+  }
+
+  case Command::ReadMemory:
+  case Command::WriteMemory:
+  {
+    u32 count;
+    if (!reader.Read(&count) || !Core::IsRunningAndStarted())
+      return false;
+
+    bool success = true;
+    Core::RunAsCPUThread([&] {
+      for (u32 i = 0; i < count && success; i++)
+      {
+        u32 address, range_size;
+        if (!reader.Read(&address) || !reader.Read(&range_size))
+        {
+          success = false;
+          break;
+        }
+
+        u8* memory = Memory::GetPointerForRange(address, range_size);
+        if (command == Command::ReadMemory)
+        {
+          success = memory && reply->size() + range_size <= MAX_DATAGRAM_SIZE;
+          if (success)
+            reply->insert(reply->end(), memory, memory + range_size);
+        }
+        else
+        {
+          const u8* bytes = reader.ReadBytes(range_size);
+          success = memory && bytes;
+          if (success)
+          {
+            std::memcpy(memory, bytes, range_size);
+            JitInterface::InvalidateICache(address, range_size, true);
+          }
+        }
+      }
+    });
+    return success;
+  }
+
+  case Command::SetPads:
+  {
+    u32 count;
+    if (!reader.Read(&count))
+      return false;
+
+    std::array<std::optional<GCPadStatus>, 4> pads;
+    {
+      std::lock_guard lock(s_pad_overrides_mutex);
+      pads = s_pad_overrides;
+    }
+    for (u32 i = 0; i < count; i++)
+    {
+      u32 port;
+      GCPadStatus pad{};
+      if (!reader.Read(&port) || port >= pads.size() || !reader.Read(&pad.button) ||
+          !reader.Read(&pad.stickX) || !reader.Read(&pad.stickY) ||
+          !reader.Read(&pad.substickX) || !reader.Read(&pad.substickY) ||
+          !reader.Read(&pad.triggerLeft) || !reader.Read(&pad.triggerRight))
+      {
+        return false;
+      }
+      // Like the Lua pad functions, the digital A and B buttons also drive their analog values
+      pad.analogA = (pad.button & PAD_BUTTON_A) ? 0xFF : 0x00;
+      pad.analogB = (pad.button & PAD_BUTTON_B) ? 0xFF : 0x00;
+      pads[port] = pad;
+    }
+
+    std::lock_guard lock(s_pad_overrides_mutex);
+    s_pad_overrides = pads;
+    return true;
+  }
+
+  case Command::ClearPads:
+  {
+    std::lock_guard lock(s_pad_overrides_mutex);
+    s_pad_overrides = {};
+    return true;
+  }
+
+  case Command::SaveState:
+  case Command::LoadState:
+  {
+    u32 slot;
+    if (!reader.Read(&slot))
+      return false;
+    return command == Command::SaveState ? State::SaveToMemory(slot) :
+                                           State::LoadFromMemory(slot);
+  }
+  }
+
+  return false;
+}
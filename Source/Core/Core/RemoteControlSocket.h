@@ -0,0 +1,66 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+
+struct GCPadStatus;
+
+// RemoteControlSocket lets external programs (e.g. reinforcement learning agents) drive the
+// emulation through a unix domain datagram socket in the MemoryWatcher directory, with a binary
+// protocol that costs one datagram round trip per request.
+//
+// Every datagram is one request, starting with a u32 command followed by its arguments. All fields
+// are in host byte order and unpadded. If the sender bound its socket to an address, the reply is
+// sent back to it: the u32 command, a u32 status (0 on success) and the results of the command.
+// Requests and replies are limited to MAX_DATAGRAM_SIZE bytes.
+//
+// Step:        u32 frames. Runs that many frames, then pauses. Replies with the u64 movie frame.
+// ReadMemory:  u32 count, then count (u32 address, u32 size) ranges. Replies with their bytes.
+// WriteMemory: u32 count, then count (u32 address, u32 size, size bytes) ranges.
+// SetPads:     u32 count, then count (u32 port, u16 buttons, u8 stick x, u8 stick y,
+//              u8 C-stick x, u8 C-stick y, u8 L, u8 R) entries. The GameCube controller of each
+//              port reports this state until it is changed or ClearPads is sent.
+// ClearPads:   Gives the GameCube controllers back to their configured inputs.
+// SaveState:   u32 slot. Saves an in-memory state, see State::SaveToMemory.
+// LoadState:   u32 slot. Loads an in-memory state.
+//
+// Addresses are physical or effective addresses of MEM1 and MEM2, like for MemoryWatcher. Memory
+// requests, pads and states are handled while the CPU thread is paused, so they can be sent while
+// the emulation runs, but are cheapest right after a step.
+class RemoteControlSocket final
+{
+public:
+  enum class Command : u32
+  {
+    Step = 0,
+    ReadMemory = 1,
+    WriteMemory = 2,
+    SetPads = 3,
+    ClearPads = 4,
+    SaveState = 5,
+    LoadState = 6,
+  };
+
+  static constexpr size_t MAX_DATAGRAM_SIZE = 65536;
+
+  RemoteControlSocket();
+  ~RemoteControlSocket();
+
+  // Replaces the state of a GameCube controller set through SetPads. Called on the CPU thread when
+  // the controller is polled.
+  static void ApplyPadOverride(GCPadStatus* pad_status, int port);
+
+private:
+  void ThreadFunc();
+  bool HandleRequest(Command command, const u8* data, size_t size, std::vector<u8>* reply);
+
+  int m_fd = -1;
+  Common::Flag m_running;
+  std::thread m_thread;
+};
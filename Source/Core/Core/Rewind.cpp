@@ -0,0 +1,187 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Rewind.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/Config/ConfigSnapshot.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/HW/Memmap.h"
+#include "Core/NetPlayProto.h"
+#include "Core/State.h"
+
+namespace Rewind
+{
+// A RAM copy and the delta states saved against it, oldest first. A new keyframe is started
+// after MAIN_REWIND_KEYFRAME_INTERVAL states, which keeps the dirty page count of each delta
+// from growing without bound.
+struct Keyframe
+{
+  Memory::StateRAMBase base;
+  std::deque<std::vector<u8>> states;
+};
+
+// Buffers of evicted or rewound states are kept for reuse, so once the ring is full capturing
+// doesn't allocate anymore.
+constexpr size_t MAX_FREE_BUFFERS = 16;
+
+static std::deque<Keyframe> s_keyframes;
+static std::vector<std::vector<u8>> s_free_buffers;
+static size_t s_memory_usage = 0;
+static size_t s_state_count = 0;
+static u32 s_frames_since_capture = 0;
+static std::atomic<bool> s_rewinding{false};
+static std::mutex s_mutex;
+
+static size_t GetKeyframeBaseSize(const Keyframe& keyframe)
+{
+  return keyframe.base.ram.capacity() + keyframe.base.exram.capacity();
+}
+
+static void RecycleBuffer(std::vector<u8>&& buffer)
+{
+  s_memory_usage -= buffer.capacity();
+  if (s_free_buffers.size() < MAX_FREE_BUFFERS)
+    s_free_buffers.push_back(std::move(buffer));
+}
+
+static void DropOldestKeyframe()
+{
+  Keyframe& keyframe = s_keyframes.front();
+  for (std::vector<u8>& state : keyframe.states)
+    RecycleBuffer(std::move(state));
+
+  s_state_count -= keyframe.states.size();
+  s_memory_usage -= GetKeyframeBaseSize(keyframe);
+  s_keyframes.pop_front();
+}
+
+static void Clear()
+{
+  s_keyframes.clear();
+  s_free_buffers.clear();
+  s_memory_usage = 0;
+  s_state_count = 0;
+  s_frames_since_capture = 0;
+}
+
+static void Capture()
+{
+  const size_t states_per_keyframe =
+      std::max(Config::Get(Config::MAIN_REWIND_KEYFRAME_INTERVAL), 1);
+
+  if (s_keyframes.empty() || s_keyframes.back().states.size() >= states_per_keyframe)
+  {
+    Keyframe& keyframe = s_keyframes.emplace_back();
+    State::CaptureDeltaBase(keyframe.base);
+    s_memory_usage += GetKeyframeBaseSize(keyframe);
+  }
+
+  std::vector<u8> buffer;
+  if (!s_free_buffers.empty())
+  {
+    buffer = std::move(s_free_buffers.back());
+    s_free_buffers.pop_back();
+  }
+
+  Keyframe& keyframe = s_keyframes.back();
+  if (!State::SaveDeltaToBuffer(keyframe.base, buffer))
+    return;
+
+  s_memory_usage += buffer.capacity();
+  keyframe.states.push_back(std::move(buffer));
+  ++s_state_count;
+
+  // Evict whole keyframes, but never the one that was just written to
+  const size_t budget = static_cast<size_t>(std::max(Config::Get(Config::MAIN_REWIND_MEMORY_MB), 0))
+                        << 20;
+  while (s_memory_usage > budget && s_keyframes.size() > 1)
+    DropOldestKeyframe();
+}
+
+static void StepBack()
+{
+  while (!s_keyframes.empty() && s_keyframes.back().states.empty())
+  {
+    s_memory_usage -= GetKeyframeBaseSize(s_keyframes.back());
+    s_keyframes.pop_back();
+  }
+
+  if (s_keyframes.empty())
+    return;
+
+  Keyframe& keyframe = s_keyframes.back();
+  std::vector<u8> buffer = std::move(keyframe.states.back());
+  keyframe.states.pop_back();
+  --s_state_count;
+
+  State::LoadDeltaFromBuffer(keyframe.base, buffer);
+  RecycleBuffer(std::move(buffer));
+}
+
+void Init()
+{
+  std::lock_guard lk(s_mutex);
+  Clear();
+  s_rewinding = false;
+}
+
+void Shutdown()
+{
+  std::lock_guard lk(s_mutex);
+  Clear();
+  s_rewinding = false;
+}
+
+void OnFrameEnd()
+{
+  if (!Config::GetSnapshot().rewind_enabled || NetPlay::IsNetPlayRunning())
+    return;
+
+  std::lock_guard lk(s_mutex);
+
+  if (s_rewinding)
+  {
+    StepBack();
+    s_frames_since_capture = 0;
+    return;
+  }
+
+  if (++s_frames_since_capture <
+      static_cast<u32>(std::max(Config::GetSnapshot().rewind_interval, 1)))
+  {
+    return;
+  }
+
+  s_frames_since_capture = 0;
+  Capture();
+}
+
+void SetRewinding(bool rewinding)
+{
+  s_rewinding = rewinding;
+}
+
+bool IsRewinding()
+{
+  return s_rewinding;
+}
+
+size_t GetStateCount()
+{
+  std::lock_guard lk(s_mutex);
+  return s_state_count;
+}
+
+size_t GetMemoryUsage()
+{
+  std::lock_guard lk(s_mutex);
+  return s_memory_usage;
+}
+}  // namespace Rewind
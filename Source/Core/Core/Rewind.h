@@ -0,0 +1,26 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Rewinding through recently captured in-memory delta savestates.
+
+#pragma once
+
+#include <cstddef>
+
+namespace Rewind
+{
+void Init();
+void Shutdown();
+
+// Called at the end of every emulated frame on the CPU thread. Captures a state every
+// MAIN_REWIND_INTERVAL frames, or steps back one state while rewinding.
+void OnFrameEnd();
+
+// Rewinding lasts for as long as this is set (e.g. while the rewind hotkey is held)
+void SetRewinding(bool rewinding);
+bool IsRewinding();
+
+// Number of captured states and the memory they use, including the keyframe RAM copies
+size_t GetStateCount();
+size_t GetMemoryUsage();
+}  // namespace Rewind
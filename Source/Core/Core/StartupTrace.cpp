@@ -0,0 +1,107 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StartupTrace.h"
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
+
+namespace StartupTrace
+{
+struct Event
+{
+  const char* name;
+  u32 thread;
+  u64 start_us;
+  u64 duration_us;
+};
+
+static std::mutex s_mutex;
+static std::string s_output_file;
+static std::vector<Event> s_events;
+static u64 s_begin_us;
+static std::atomic<bool> s_active{false};
+static std::atomic<u32> s_thread_count{0};
+
+// Small numbers are easier to read in trace viewers than native thread IDs
+static u32 GetThreadIndex()
+{
+  thread_local const u32 index = ++s_thread_count;
+  return index;
+}
+
+void SetOutputFile(std::string filename)
+{
+  std::lock_guard lock(s_mutex);
+  s_output_file = std::move(filename);
+}
+
+void Begin()
+{
+  std::lock_guard lock(s_mutex);
+  s_events.clear();
+  s_begin_us = Common::Timer::GetTimeUs();
+  s_active.store(true);
+}
+
+Span::Span(const char* name) : m_name(name), m_start_us(Common::Timer::GetTimeUs()) {}
+
+Span::~Span()
+{
+  if (!s_active.load())
+    return;
+
+  const u64 end_us = Common::Timer::GetTimeUs();
+  std::lock_guard lock(s_mutex);
+  if (m_start_us >= s_begin_us)
+  {
+    s_events.push_back({m_name, GetThreadIndex(), m_start_us - s_begin_us, end_us - m_start_us});
+  }
+}
+
+static void WriteTrace(const std::string& filename, u64 first_frame_us)
+{
+  File::IOFile file(filename, "w");
+  if (!file)
+  {
+    ERROR_LOG_FMT(BOOT, "Failed to open startup trace file {}", filename);
+    return;
+  }
+
+  file.WriteString("[\n");
+  for (const Event& event : s_events)
+  {
+    file.WriteString(fmt::format(
+        "{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":1,\"tid\":{}}},\n",
+        event.name, event.start_us, event.duration_us, event.thread));
+  }
+  file.WriteString(fmt::format(
+      "{{\"name\":\"First frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":{},\"pid\":1,\"tid\":{}}}\n]\n",
+      first_frame_us, GetThreadIndex()));
+}
+
+void OnFramePresented()
+{
+  if (!s_active.exchange(false))
+    return;
+
+  std::lock_guard lock(s_mutex);
+  const u64 first_frame_us = Common::Timer::GetTimeUs() - s_begin_us;
+  NOTICE_LOG_FMT(BOOT, "Presented the first frame {} ms after starting up",
+                 first_frame_us / 1000);
+  for (const Event& event : s_events)
+    INFO_LOG_FMT(BOOT, "Startup stage {}: {} ms", event.name, event.duration_us / 1000);
+
+  if (!s_output_file.empty())
+    WriteTrace(s_output_file, first_frame_us);
+  s_events.clear();
+}
+}  // namespace StartupTrace
@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures the stages of starting emulation, from the emu thread starting up to the first frame
+// being presented. The time to the first frame is always logged, and the stages can be written
+// as a Chrome trace event file, which chrome://tracing and Perfetto can open.
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace StartupTrace
+{
+// Sets the file that the trace of the next startup is written to. Empty disables the file.
+void SetOutputFile(std::string filename);
+
+// Called by the emu thread before anything is initialized
+void Begin();
+
+// Records the time between its construction and destruction as a stage of the startup. Spans can
+// be used from any thread and nest. Nothing is recorded once the first frame has been presented.
+class Span
+{
+public:
+  explicit Span(const char* name);
+  ~Span();
+
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start_us;
+};
+
+// Called whenever a frame has been presented. The first one ends the startup.
+void OnFramePresented();
+}  // namespace StartupTrace
@@ -3,6 +3,10 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
@@ -12,18 +16,24 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
+#include "Common/Image.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
 #include "Common/Version.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -34,10 +44,12 @@
 #include "Core/Host.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 
 namespace State
@@ -52,12 +64,13 @@ static const u32 IN_LEN = 128 * 1024u;
 
 static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
-static unsigned char __LZO_MMODEL out[OUT_LEN];
-
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+// Compressed states are now written as independent zstd chunks, which are compressed and
+// decompressed in parallel. The magic takes the place of the first LZO chunk length and is
+// larger than any such length can be, so LZO states are still recognized.
+constexpr u32 ZSTD_STATE_MAGIC = 0x5453445A;  // "ZDST"
+constexpr u32 ZSTD_STATE_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr int ZSTD_STATE_LEVEL = 3;
+static_assert(ZSTD_STATE_MAGIC > OUT_LEN, "The zstd magic must not be a valid LZO chunk length");
 
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
@@ -68,12 +81,22 @@ static bool s_load_or_save_in_progress;
 
 static std::mutex g_cs_undo_load_buffer;
 static std::mutex g_cs_current_buffer;
+
+// In-memory slots. The buffers are only ever grown, so after the first save into a slot the
+// following ones reuse its allocation.
+static std::array<std::vector<u8>, NUM_MEMORY_SLOTS> s_memory_slots;
+static std::mutex s_memory_slots_mutex;
+
+// RAM copy used by the delta state functions that don't take a base
+static Memory::StateRAMBase s_delta_base;
+static std::mutex s_delta_base_mutex;
+
 static Common::Event g_compressAndDumpStateSyncEvent;
 
 static std::thread g_save_thread;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 136;  // Last changed in PR 10058
+constexpr u32 STATE_VERSION = 140;  // Last changed when SI late input latching was added
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -214,6 +237,69 @@ static void DoState(PointerWrap& p)
   p.DoMarker("Gecko");
 }
 
+// The parts of the CPU state besides emulated memory that compiled JIT blocks depend on
+struct JitDependencies
+{
+  u32 msr;
+  u32 sr[16];
+  u32 bats[32];
+  u32 pagetable_base;
+  u32 pagetable_hashmask;
+  decltype(PowerPC::InstructionCache::data) icache_data;
+  decltype(PowerPC::InstructionCache::tags) icache_tags;
+  decltype(PowerPC::InstructionCache::valid) icache_valid;
+};
+
+static void CaptureJitDependencies(JitDependencies* dependencies)
+{
+  const PowerPC::PowerPCState& state = PowerPC::ppcState;
+  dependencies->msr = state.msr.Hex;
+  std::copy(std::begin(state.sr), std::end(state.sr), dependencies->sr);
+  std::copy(&state.spr[SPR_IBAT0U], &state.spr[SPR_DBAT3L + 1], dependencies->bats);
+  std::copy(&state.spr[SPR_IBAT4U], &state.spr[SPR_DBAT7L + 1], dependencies->bats + 16);
+  dependencies->pagetable_base = state.pagetable_base;
+  dependencies->pagetable_hashmask = state.pagetable_hashmask;
+  dependencies->icache_data = state.iCache.data;
+  dependencies->icache_tags = state.iCache.tags;
+  dependencies->icache_valid = state.iCache.valid;
+}
+
+// Loads a state without throwing away the whole JIT cache. Memory only rewrites the RAM pages
+// that differ, and only the blocks compiled from those pages are destroyed, so reloading a
+// state (especially the same one over and over) doesn't recompile all of the code.
+// The cache is still cleared in full when the address translation or the instruction cache
+// changed, since blocks may then map to different code. Must run on the CPU thread.
+static void DoStateKeepingJitCache(PointerWrap& p)
+{
+  // These are too large for the stack
+  static JitDependencies s_before;
+  static JitDependencies s_after;
+
+  CaptureJitDependencies(&s_before);
+
+  JitInterface::SetClearCacheOnStateLoad(false);
+  DoState(p);
+  JitInterface::SetClearCacheOnStateLoad(true);
+
+  // A failed load may have been applied partially, so always start over then
+  if (p.GetMode() != PointerWrap::MODE_READ)
+  {
+    JitInterface::ClearCache();
+    return;
+  }
+
+  CaptureJitDependencies(&s_after);
+  const std::vector<Memory::PhysicalRange>* changed_ranges = Memory::GetStateLoadChangedRanges();
+  if (!changed_ranges || std::memcmp(&s_before, &s_after, sizeof(JitDependencies)) != 0)
+  {
+    JitInterface::ClearCache();
+    return;
+  }
+
+  for (const Memory::PhysicalRange& range : *changed_ranges)
+    JitInterface::InvalidatePhysicalRange(range.address, range.length);
+}
+
 void LoadFromBuffer(std::vector<u8>& buffer)
 {
   if (NetPlay::IsNetPlayRunning())
@@ -226,27 +312,278 @@ void LoadFromBuffer(std::vector<u8>& buffer)
       [&] {
         u8* ptr = &buffer[0];
         PointerWrap p(&ptr, PointerWrap::MODE_READ);
-        DoState(p);
+        DoStateKeepingJitCache(p);
       },
       true);
 }
 
+// The sizes of the last full and delta states. States rarely change much in size between saves,
+// so the buffer is sized from the previous one and written right away instead of measuring the
+// state first, which would run every DoState function (and sync with the GPU thread) twice.
+static size_t s_full_state_size_hint = 0;
+static size_t s_delta_state_size_hint = 0;
+
+// Writes the state to the buffer and resizes the buffer to the size of the state. Only measures
+// the state before the first save, or when it outgrew the hint, in which case the write pass
+// that ran out of space measured it. Returns false if the state couldn't be written.
+// Must run on the CPU thread.
+template <typename DoStateFunction>
+static bool WriteState(std::vector<u8>& buffer, size_t* size_hint, DoStateFunction do_state)
+{
+  // Leaves a little room for the state to grow, e.g. by new texture cache entries
+  size_t size = *size_hint + *size_hint / 32;
+  if (*size_hint == 0)
+  {
+    u8* ptr = nullptr;
+    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+    do_state(p);
+    size = reinterpret_cast<size_t>(ptr);
+  }
+
+  while (true)
+  {
+    buffer.resize(size);
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+    p.SetWriteLimit(buffer.data() + buffer.size());
+    do_state(p);
+
+    const size_t state_size = static_cast<size_t>(ptr - buffer.data());
+    if (p.GetMode() == PointerWrap::MODE_WRITE)
+    {
+      buffer.resize(state_size);
+      *size_hint = state_size;
+      return true;
+    }
+
+    // Anything but running out of space means that a DoState function aborted the save
+    if (!p.HasOverflowed())
+    {
+      buffer.clear();
+      return false;
+    }
+    size = state_size;
+  }
+}
+
 void SaveToBuffer(std::vector<u8>& buffer)
 {
+  Core::RunOnCPUThread(
+      [&] { WriteState(buffer, &s_full_state_size_hint, [](PointerWrap& p) { DoState(p); }); },
+      true);
+}
+
+// Serializes the state into the buffer. Must run on the CPU thread.
+// delta_base_id is written in front of the state and is 0 for full states.
+static bool SerializeState(std::vector<u8>& buffer, u64 delta_base_id)
+{
+  size_t* size_hint = delta_base_id == 0 ? &s_full_state_size_hint : &s_delta_state_size_hint;
+  return WriteState(buffer, size_hint, [delta_base_id](PointerWrap& p) mutable {
+    p.Do(delta_base_id);
+    DoState(p);
+  });
+}
+
+// Counterpart of SerializeState. Must run on the CPU thread.
+static bool DeserializeState(std::vector<u8>& buffer, u64 delta_base_id)
+{
+  if (buffer.empty())
+    return false;
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, PointerWrap::MODE_READ);
+  u64 state_base_id = 0;
+  p.Do(state_base_id);
+  if (state_base_id != delta_base_id)
+    return false;
+
+  DoStateKeepingJitCache(p);
+  return p.GetMode() == PointerWrap::MODE_READ;
+}
+
+bool SaveToMemory(u32 slot)
+{
+  if (slot >= NUM_MEMORY_SLOTS || !Core::IsRunning())
+    return false;
+
+  bool success = false;
+
+  Core::RunOnCPUThread(
+      [&] {
+        std::lock_guard lk(s_memory_slots_mutex);
+        success = SerializeState(s_memory_slots[slot], 0);
+      },
+      true);
+
+  return success;
+}
+
+bool LoadFromMemory(u32 slot)
+{
+  if (slot >= NUM_MEMORY_SLOTS || !Core::IsRunning())
+    return false;
+
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
+    return false;
+  }
+
+  bool success = false;
+
+  Core::RunOnCPUThread(
+      [&] {
+        std::lock_guard lk(s_memory_slots_mutex);
+        success = DeserializeState(s_memory_slots[slot], 0);
+      },
+      true);
+
+  if (success)
+  {
+    Movie::OnMemoryStateLoaded();
+    if (s_on_after_load_callback)
+      s_on_after_load_callback();
+  }
+
+  return success;
+}
+
+bool HasMemoryState(u32 slot)
+{
+  if (slot >= NUM_MEMORY_SLOTS)
+    return false;
+
+  std::lock_guard lk(s_memory_slots_mutex);
+  return !s_memory_slots[slot].empty();
+}
+
+void ClearMemoryStates()
+{
+  std::lock_guard lk(s_memory_slots_mutex);
+  for (std::vector<u8>& buffer : s_memory_slots)
+    std::vector<u8>().swap(buffer);
+}
+
+bool SaveToMemory(std::vector<u8>& buffer)
+{
+  if (!Core::IsRunning())
+    return false;
+
+  bool success = false;
+  Core::RunOnCPUThread([&] { success = SerializeState(buffer, 0); }, true);
+  return success;
+}
+
+bool LoadFromMemory(std::vector<u8>& buffer)
+{
+  if (!Core::IsRunning())
+    return false;
+
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
+    return false;
+  }
+
+  bool success = false;
+  Core::RunOnCPUThread([&] { success = DeserializeState(buffer, 0); }, true);
+
+  if (success)
+  {
+    Movie::OnMemoryStateLoaded();
+    if (s_on_after_load_callback)
+      s_on_after_load_callback();
+  }
+
+  return success;
+}
+
+bool CaptureDeltaBase(Memory::StateRAMBase& base)
+{
+  if (!Core::IsRunning())
+    return false;
+
+  Core::RunOnCPUThread([&] { Memory::CaptureStateRAMBase(&base); }, true);
+  return true;
+}
+
+bool SaveDeltaToBuffer(Memory::StateRAMBase& base, std::vector<u8>& buffer)
+{
+  if (!Core::IsRunning() || base.id == 0)
+    return false;
+
+  bool success = false;
+
   Core::RunOnCPUThread(
       [&] {
-        u8* ptr = nullptr;
-        PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+        Memory::SetStateRAMBase(&base);
+        success = SerializeState(buffer, base.id);
+        Memory::SetStateRAMBase(nullptr);
+      },
+      true);
+
+  return success;
+}
+
+bool LoadDeltaFromBuffer(Memory::StateRAMBase& base, std::vector<u8>& buffer)
+{
+  if (!Core::IsRunning() || base.id == 0)
+    return false;
+
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
+    return false;
+  }
 
-        DoState(p);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+  bool success = false;
 
-        ptr = &buffer[0];
-        p.SetMode(PointerWrap::MODE_WRITE);
-        DoState(p);
+  Core::RunOnCPUThread(
+      [&] {
+        Memory::SetStateRAMBase(&base);
+        success = DeserializeState(buffer, base.id);
+        Memory::SetStateRAMBase(nullptr);
       },
       true);
+
+  if (success)
+  {
+    Movie::OnMemoryStateLoaded();
+    if (s_on_after_load_callback)
+      s_on_after_load_callback();
+  }
+
+  return success;
+}
+
+void SetDeltaBase()
+{
+  std::lock_guard lk(s_delta_base_mutex);
+  CaptureDeltaBase(s_delta_base);
+}
+
+void ClearDeltaBase()
+{
+  std::lock_guard lk(s_delta_base_mutex);
+  s_delta_base = {};
+}
+
+bool HasDeltaBase()
+{
+  std::lock_guard lk(s_delta_base_mutex);
+  return s_delta_base.id != 0;
+}
+
+bool SaveDeltaToBuffer(std::vector<u8>& buffer)
+{
+  std::lock_guard lk(s_delta_base_mutex);
+  return SaveDeltaToBuffer(s_delta_base, buffer);
+}
+
+bool LoadDeltaFromBuffer(std::vector<u8>& buffer)
+{
+  std::lock_guard lk(s_delta_base_mutex);
+  return LoadDeltaFromBuffer(s_delta_base, buffer);
 }
 
 // return state number not in map
@@ -271,26 +608,162 @@ static int GetEmptySlot(std::map<double, int> m)
 
 static std::string MakeStateFilename(int number);
 
+// What the slot menus show of each slot of a game is kept in a small index file next to the
+// states, so that they don't open every slot file, which is slow on network mounted user
+// directories. Dolphin updates it whenever it saves to a slot. The size and modification time of
+// the slot files are checked once per game and session, to pick up states copied in from outside.
+enum class SlotStatus : u8
+{
+  Empty,
+  Unreadable,
+  Saved,
+};
+
+struct SlotIndexEntry
+{
+  double time;
+  u64 file_size;
+  s64 file_time;
+  SlotStatus status;
+  u8 padding[7];
+};
+
+constexpr u32 SLOT_INDEX_MAGIC = 0x58444953;  // SIDX
+constexpr u32 SLOT_INDEX_VERSION = 1;
+
+static std::mutex s_slot_index_mutex;
+static std::string s_slot_index_game_id;
+static std::array<SlotIndexEntry, NUM_STATES> s_slot_index;
+
+static std::string MakeSlotIndexFilename(const std::string& game_id)
+{
+  return fmt::format("{}{}.sidx", File::GetUserPath(D_STATESAVES_IDX), game_id);
+}
+
+static bool IsIndexedSlot(int slot)
+{
+  return slot >= 1 && slot <= static_cast<int>(NUM_STATES);
+}
+
+static SlotIndexEntry ReadSlotIndexEntry(const std::string& filename)
+{
+  SlotIndexEntry entry{};
+  const File::FileInfo info(filename);
+  if (!info.IsFile())
+    return entry;
+
+  entry.file_size = info.GetSize();
+  entry.file_time = info.GetModificationTime();
+  entry.status = SlotStatus::Unreadable;
+
+  StateHeader header;
+  File::IOFile f(filename, "rb");
+  if (f.ReadArray(&header, 1))
+  {
+    entry.time = header.time;
+    entry.status = SlotStatus::Saved;
+  }
+  return entry;
+}
+
+static void WriteSlotIndex()
+{
+  // Nothing is running, the slots are only looked at for the menus
+  if (s_slot_index_game_id.empty())
+    return;
+
+  File::IOFile f(MakeSlotIndexFilename(s_slot_index_game_id), "wb");
+  const u32 count = NUM_STATES;
+  if (!f.WriteArray(&SLOT_INDEX_MAGIC, 1) || !f.WriteArray(&SLOT_INDEX_VERSION, 1) ||
+      !f.WriteArray(&count, 1) || !f.WriteArray(s_slot_index.data(), s_slot_index.size()))
+  {
+    WARN_LOG_FMT(CORE, "Failed to write the savestate slot index of {}", s_slot_index_game_id);
+  }
+}
+
+// Must be called with s_slot_index_mutex held
+static void LoadSlotIndex()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (s_slot_index_game_id == game_id)
+    return;
+
+  s_slot_index_game_id = game_id;
+
+  u32 magic = 0, version = 0, count = 0;
+  File::IOFile f(MakeSlotIndexFilename(game_id), "rb");
+  const bool loaded = f.ReadArray(&magic, 1) && f.ReadArray(&version, 1) &&
+                      f.ReadArray(&count, 1) && magic == SLOT_INDEX_MAGIC &&
+                      version == SLOT_INDEX_VERSION && count == NUM_STATES &&
+                      f.ReadArray(s_slot_index.data(), s_slot_index.size());
+  f.Close();
+
+  bool changed = !loaded;
+  for (u32 i = 0; i < NUM_STATES; i++)
+  {
+    const std::string filename = MakeStateFilename(i + 1);
+    SlotIndexEntry& entry = s_slot_index[i];
+    if (loaded)
+    {
+      const File::FileInfo info(filename);
+      const bool exists = info.IsFile();
+      if (exists == (entry.status != SlotStatus::Empty) &&
+          (!exists ||
+           (info.GetSize() == entry.file_size && info.GetModificationTime() == entry.file_time)))
+      {
+        continue;
+      }
+    }
+
+    entry = ReadSlotIndexEntry(filename);
+    changed = true;
+  }
+
+  if (changed)
+    WriteSlotIndex();
+}
+
+static SlotIndexEntry GetSlotIndexEntry(int slot)
+{
+  // A save may still be writing the slot
+  Flush();
+
+  std::lock_guard lk(s_slot_index_mutex);
+  LoadSlotIndex();
+  return s_slot_index[slot - 1];
+}
+
+static void UpdateSlotIndex(const std::string& filename)
+{
+  std::lock_guard lk(s_slot_index_mutex);
+  LoadSlotIndex();
+  for (int slot = 1; slot <= static_cast<int>(NUM_STATES); slot++)
+  {
+    if (MakeStateFilename(slot) != filename)
+      continue;
+
+    s_slot_index[slot - 1] = ReadSlotIndexEntry(filename);
+    WriteSlotIndex();
+    return;
+  }
+}
+
 // read state timestamps
 static std::map<double, int> GetSavedStates()
 {
-  StateHeader header;
   std::map<double, int> m;
   for (int i = 1; i <= (int)NUM_STATES; i++)
   {
-    std::string filename = MakeStateFilename(i);
-    if (File::Exists(filename))
+    const SlotIndexEntry entry = GetSlotIndexEntry(i);
+    if (entry.status == SlotStatus::Saved)
     {
-      if (ReadHeader(filename, header))
-      {
-        double d = Common::Timer::GetDoubleTime() - header.time;
+      double d = Common::Timer::GetDoubleTime() - entry.time;
 
-        // increase time until unique value is obtained
-        while (m.find(d) != m.end())
-          d += .001;
+      // increase time until unique value is obtained
+      while (m.find(d) != m.end())
+        d += .001;
 
-        m.emplace(d, i);
-      }
+      m.emplace(d, i);
     }
   }
   return m;
@@ -302,8 +775,125 @@ struct CompressAndDumpState_args
   std::mutex* buffer_mutex;
   std::string filename;
   bool wait;
+  StateThumbnail thumbnail;
 };
 
+// Runs job(i) for every i < chunk_count on up to MAIN_SAVESTATE_COMPRESSION_THREADS threads
+template <typename Job>
+static void ForEachChunk(size_t chunk_count, const Job& job)
+{
+  int thread_count = Config::Get(Config::MAIN_SAVESTATE_COMPRESSION_THREADS);
+  if (thread_count <= 0)
+    thread_count = static_cast<int>(std::thread::hardware_concurrency());
+  thread_count = std::clamp(thread_count, 1, static_cast<int>(std::max<size_t>(chunk_count, 1)));
+
+  std::atomic<size_t> next_chunk{0};
+  const auto worker = [&] {
+    for (size_t i = next_chunk++; i < chunk_count; i = next_chunk++)
+      job(i);
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < thread_count; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+// Layout: magic, chunk size, chunk count, the compressed size of each chunk, the chunks
+static bool WriteZstdState(File::IOFile& f, const u8* data, size_t size)
+{
+  const u32 chunk_count =
+      static_cast<u32>((size + ZSTD_STATE_CHUNK_SIZE - 1) / ZSTD_STATE_CHUNK_SIZE);
+  std::vector<std::vector<u8>> chunks(chunk_count);
+  std::atomic<bool> failed{false};
+
+  ForEachChunk(chunk_count, [&](size_t i) {
+    const size_t offset = i * ZSTD_STATE_CHUNK_SIZE;
+    const size_t length = std::min<size_t>(ZSTD_STATE_CHUNK_SIZE, size - offset);
+
+    std::vector<u8>& chunk = chunks[i];
+    chunk.resize(ZSTD_compressBound(length));
+    const size_t result =
+        ZSTD_compress(chunk.data(), chunk.size(), data + offset, length, ZSTD_STATE_LEVEL);
+    if (ZSTD_isError(result))
+      failed = true;
+    else
+      chunk.resize(result);
+  });
+
+  if (failed)
+    return false;
+
+  std::vector<u32> chunk_sizes(chunk_count);
+  for (u32 i = 0; i < chunk_count; ++i)
+    chunk_sizes[i] = static_cast<u32>(chunks[i].size());
+
+  bool success = f.WriteArray(&ZSTD_STATE_MAGIC, 1) && f.WriteArray(&ZSTD_STATE_CHUNK_SIZE, 1) &&
+                 f.WriteArray(&chunk_count, 1) && f.WriteArray(chunk_sizes.data(), chunk_count);
+  for (const std::vector<u8>& chunk : chunks)
+    success = success && f.WriteBytes(chunk.data(), chunk.size());
+
+  return success;
+}
+
+// Decompresses the chunks that follow the magic into the buffer, which must already have the
+// uncompressed size. The chunks are read straight from the mapped file.
+static bool ReadZstdState(const u8* src, size_t src_size, std::vector<u8>& buffer)
+{
+  u32 chunk_size = 0;
+  u32 chunk_count = 0;
+  if (src_size < sizeof(u32) * 2)
+    return false;
+
+  std::memcpy(&chunk_size, src, sizeof(u32));
+  std::memcpy(&chunk_count, src + sizeof(u32), sizeof(u32));
+  src += sizeof(u32) * 2;
+  src_size -= sizeof(u32) * 2;
+
+  if (chunk_size == 0 || static_cast<u64>(chunk_size) * chunk_count < buffer.size() ||
+      src_size < static_cast<u64>(chunk_count) * sizeof(u32))
+  {
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(chunk_count);
+  std::memcpy(chunk_sizes.data(), src, chunk_count * sizeof(u32));
+  src += chunk_count * sizeof(u32);
+  src_size -= chunk_count * sizeof(u32);
+
+  std::vector<size_t> chunk_offsets(chunk_count);
+  size_t compressed_size = 0;
+  for (u32 i = 0; i < chunk_count; ++i)
+  {
+    chunk_offsets[i] = compressed_size;
+    compressed_size += chunk_sizes[i];
+  }
+
+  if (compressed_size > src_size)
+    return false;
+
+  std::atomic<bool> failed{false};
+
+  ForEachChunk(chunk_count, [&](size_t i) {
+    const size_t offset = i * chunk_size;
+    if (offset >= buffer.size())
+    {
+      failed = true;
+      return;
+    }
+
+    const size_t length = std::min<size_t>(chunk_size, buffer.size() - offset);
+    const size_t result =
+        ZSTD_decompress(buffer.data() + offset, length, src + chunk_offsets[i], chunk_sizes[i]);
+    if (ZSTD_isError(result) || result != length)
+      failed = true;
+  });
+
+  return !failed;
+}
+
 static void CompressAndDumpState(CompressAndDumpState_args save_args)
 {
   std::lock_guard lk(*save_args.buffer_mutex);
@@ -327,6 +917,7 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   // For easy debugging
   Common::SetCurrentThreadName("SaveState thread");
+  Common::ApplyThreadRole(Common::ThreadRole::Background);
 
   // Moving to last overwritten save-state
   if (File::Exists(filename))
@@ -335,11 +926,29 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
       File::Delete((File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav"));
     if (File::Exists(File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.dtm"))
       File::Delete((File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.dtm"));
+    if (File::Exists(File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.png"))
+      File::Delete((File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.png"));
 
     if (!File::Rename(filename, File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav"))
+    {
       Core::DisplayMessage("Failed to move previous state to state undo backup", 1000);
-    else if (File::Exists(filename + ".dtm"))
-      File::Rename(filename + ".dtm", File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.dtm");
+    }
+    else
+    {
+      if (File::Exists(filename + ".dtm"))
+        File::Rename(filename + ".dtm", File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.dtm");
+      if (File::Exists(filename + ".png"))
+        File::Rename(filename + ".png", File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.png");
+    }
+  }
+
+  // The thumbnail is kept next to the state, so that it can be shown without reading the state
+  const StateThumbnail& thumbnail = save_args.thumbnail;
+  if (thumbnail.data.empty() ||
+      !Common::ConvertRGBAToRGBAndSavePNG(filename + ".png", thumbnail.data.data(),
+                                          thumbnail.width, thumbnail.height))
+  {
+    File::Delete(filename + ".png");
   }
 
   if ((Movie::IsMovieActive()) && !Movie::IsJustStartingRecordingInputFromSaveState())
@@ -350,6 +959,7 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   File::IOFile f(filename, "wb");
   if (!f)
   {
+    UpdateSlotIndex(filename);
     Core::DisplayMessage("Could not save state", 2000);
     return;
   }
@@ -364,32 +974,12 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
+    if (!WriteZstdState(f, buffer_data, buffer_size))
     {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
+      f.Close();
+      UpdateSlotIndex(filename);
+      Core::DisplayMessage("Could not save state", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -397,12 +987,16 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
     f.WriteBytes(buffer_data, buffer_size);
   }
 
+  f.Close();
+  UpdateSlotIndex(filename);
+
   Core::DisplayMessage(fmt::format("Saved State to {}", filename), 2000);
   Host_UpdateMainFrame();
 }
 
 void SaveAs(const std::string& filename, bool wait)
 {
+  TRACE_SCOPE("State::SaveAs");
   if (s_load_or_save_in_progress)
     return;
 
@@ -410,22 +1004,16 @@ void SaveAs(const std::string& filename, bool wait)
 
   Core::RunOnCPUThread(
       [&] {
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-        DoState(p);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+        g_renderer->RequestStateThumbnail();
 
-        // Then actually do the write.
+        bool success;
         {
           std::lock_guard lk(g_cs_current_buffer);
-          g_current_buffer.resize(buffer_size);
-          ptr = &g_current_buffer[0];
-          p.SetMode(PointerWrap::MODE_WRITE);
-          DoState(p);
+          success = WriteState(g_current_buffer, &s_full_state_size_hint,
+                               [](PointerWrap& p) { DoState(p); });
         }
 
-        if (p.GetMode() == PointerWrap::MODE_WRITE)
+        if (success)
         {
           Core::DisplayMessage("Saving State...", 1000);
 
@@ -434,13 +1022,16 @@ void SaveAs(const std::string& filename, bool wait)
           save_args.buffer_mutex = &g_cs_current_buffer;
           save_args.filename = filename;
           save_args.wait = wait;
+          save_args.thumbnail = g_renderer->TakeStateThumbnail();
 
           Flush();
-          g_save_thread = std::thread(CompressAndDumpState, save_args);
+          g_save_thread = std::thread(CompressAndDumpState, std::move(save_args));
           g_compressAndDumpStateSyncEvent.Wait();
         }
         else
         {
+          g_renderer->TakeStateThumbnail();
+
           // someone aborted the save by changing the mode?
           Core::DisplayMessage("Unable to save: Internal DoState Error", 4000);
         }
@@ -459,6 +1050,16 @@ bool ReadHeader(const std::string& filename, StateHeader& header)
 
 std::string GetInfoStringOfSlot(int slot, bool translate)
 {
+  if (IsIndexedSlot(slot))
+  {
+    const SlotIndexEntry entry = GetSlotIndexEntry(slot);
+    if (entry.status == SlotStatus::Empty)
+      return translate ? Common::GetStringT("Empty") : "Empty";
+    if (entry.status == SlotStatus::Unreadable)
+      return translate ? Common::GetStringT("Unknown") : "Unknown";
+    return Common::Timer::GetDateTimeFormatted(entry.time);
+  }
+
   std::string filename = MakeStateFilename(slot);
   if (!File::Exists(filename))
     return translate ? Common::GetStringT("Empty") : "Empty";
@@ -472,84 +1073,135 @@ std::string GetInfoStringOfSlot(int slot, bool translate)
 
 u64 GetUnixTimeOfSlot(int slot)
 {
-  State::StateHeader header;
-  if (!ReadHeader(MakeStateFilename(slot), header))
-    return 0;
+  double time;
+  if (IsIndexedSlot(slot))
+  {
+    const SlotIndexEntry entry = GetSlotIndexEntry(slot);
+    if (entry.status != SlotStatus::Saved)
+      return 0;
+    time = entry.time;
+  }
+  else
+  {
+    State::StateHeader header;
+    if (!ReadHeader(MakeStateFilename(slot), header))
+      return 0;
+    time = header.time;
+  }
 
   constexpr u64 MS_PER_SEC = 1000;
-  return static_cast<u64>(header.time * MS_PER_SEC) +
-         (Common::Timer::DOUBLE_TIME_OFFSET * MS_PER_SEC);
+  return static_cast<u64>(time * MS_PER_SEC) + (Common::Timer::DOUBLE_TIME_OFFSET * MS_PER_SEC);
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+// The contents of a savestate file. Uncompressed states are read straight from the mapped file,
+// compressed ones are decompressed from the mapping into the buffer.
+struct StateFileData
+{
+  File::MappedFile file;
+  std::vector<u8> buffer;
+  const u8* data = nullptr;
+  size_t size = 0;
+};
+
+static bool LoadFileStateData(const std::string& filename, StateFileData& ret_data)
 {
   Flush();
-  File::IOFile f(filename, "rb");
+  File::MappedFile& f = ret_data.file;
 
   StateHeader header;
-  if (!f.ReadArray(&header, 1))
+  if (!f.Open(filename) || f.GetSize() < sizeof(StateHeader))
   {
     Core::DisplayMessage("State not found", 2000);
-    return;
+    return false;
   }
 
+  std::memcpy(&header, f.GetData(), sizeof(StateHeader));
+
   if (strncmp(SConfig::GetInstance().GetGameID().c_str(), header.gameID, 6))
   {
     Core::DisplayMessage(fmt::format("State belongs to a different game (ID {})",
                                      std::string_view{header.gameID, std::size(header.gameID)}),
                          2000);
-    return;
+    return false;
   }
 
-  std::vector<u8> buffer;
+  const u8* src = f.GetData() + sizeof(StateHeader);
+  const size_t src_size = f.GetSize() - sizeof(StateHeader);
 
-  if (header.size != 0)  // non-zero size means the state is compressed
+  if (header.size == 0)  // uncompressed
   {
-    Core::DisplayMessage("Decompressing State...", 500);
+    if (src_size == 0)
+    {
+      PanicAlertFmt("Error reading bytes: {0}", src_size);
+      return false;
+    }
+
+    ret_data.data = src;
+    ret_data.size = src_size;
+    return true;
+  }
 
-    buffer.resize(header.size);
+  // non-zero size means the state is compressed
+  Core::DisplayMessage("Decompressing State...", 500);
 
+  std::vector<u8>& buffer = ret_data.buffer;
+  buffer.resize(header.size);
+
+  u32 magic = 0;
+  if (src_size >= sizeof(magic))
+    std::memcpy(&magic, src, sizeof(magic));
+
+  if (magic == ZSTD_STATE_MAGIC)
+  {
+    if (!ReadZstdState(src + sizeof(magic), src_size - sizeof(magic), buffer))
+    {
+      PanicAlertFmtT("Failed to decompress the savestate");
+      return false;
+    }
+  }
+  else
+  {
+    size_t offset = 0;
     lzo_uint i = 0;
-    while (true)
+    while (offset + sizeof(lzo_uint32) <= src_size)
     {
       lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
+      std::memcpy(&cur_len, src + offset, sizeof(cur_len));
+      offset += sizeof(cur_len);
 
-      if (!f.ReadArray(&cur_len, 1))
-        break;
+      // number of bytes to write, the space that is left on input
+      lzo_uint new_len = buffer.size() - i;
 
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
+      const int res =
+          cur_len > src_size - offset ?
+              LZO_E_INPUT_OVERRUN :
+              lzo1x_decompress_safe(src + offset, cur_len, &buffer[i], &new_len, nullptr);
       if (res != LZO_E_OK)
       {
         // This doesn't seem to happen anymore.
         PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
                        "Try loading the state again",
                        res, i, new_len);
-        return;
+        return false;
       }
 
+      offset += cur_len;
       i += new_len;
     }
   }
-  else  // uncompressed
-  {
-    const auto size = static_cast<size_t>(f.GetSize() - sizeof(StateHeader));
-    buffer.resize(size);
 
-    if (!f.ReadBytes(&buffer[0], size))
-    {
-      PanicAlertFmt("Error reading bytes: {0}", size);
-      return;
-    }
-  }
+  // The compressed data isn't needed anymore
+  f.Close();
 
   // all good
-  ret_data.swap(buffer);
+  ret_data.data = buffer.data();
+  ret_data.size = buffer.size();
+  return true;
 }
 
 void LoadAs(const std::string& filename)
 {
+  TRACE_SCOPE("State::LoadAs");
   if (!Core::IsRunning() || s_load_or_save_in_progress)
   {
     return;
@@ -578,16 +1230,15 @@ void LoadAs(const std::string& filename)
         bool loaded = false;
         bool loadedSuccessfully = false;
 
-        // brackets here are so buffer gets freed ASAP
+        // brackets here are so the file data gets freed ASAP
         {
-          std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
-
-          if (!buffer.empty())
+          StateFileData state_data;
+          if (LoadFileStateData(filename, state_data))
           {
-            u8* ptr = &buffer[0];
+            // PointerWrap doesn't write to the data in MODE_READ, so the read-only mapping is fine
+            u8* ptr = const_cast<u8*>(state_data.data);
             PointerWrap p(&ptr, PointerWrap::MODE_READ);
-            DoState(p);
+            DoStateKeepingJitCache(p);
             loaded = true;
             loadedSuccessfully = (p.GetMode() == PointerWrap::MODE_READ);
           }
@@ -648,6 +1299,9 @@ void Shutdown()
     std::lock_guard lk(g_cs_undo_load_buffer);
     std::vector<u8>().swap(g_undo_load_buffer);
   }
+
+  ClearMemoryStates();
+  ClearDeltaBase();
 }
 
 static std::string MakeStateFilename(int number)
@@ -11,10 +11,17 @@
 
 #include "Common/CommonTypes.h"
 
+namespace Memory
+{
+struct StateRAMBase;
+}
+
 namespace State
 {
 // number of states
 static const u32 NUM_STATES = 10;
+// number of in-memory states
+static const u32 NUM_MEMORY_SLOTS = 10;
 
 struct StateHeader
 {
@@ -52,6 +59,34 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// In-memory savestate slots (0 to NUM_MEMORY_SLOTS - 1). These never touch the disk, are not
+// compressed and show no messages, so a round trip costs only the state serialization.
+// Unlike the buffer functions above they report whether the state was saved or loaded.
+bool SaveToMemory(u32 slot);
+bool LoadFromMemory(u32 slot);
+bool HasMemoryState(u32 slot);
+// Frees the memory held by all in-memory slots
+void ClearMemoryStates();
+
+// Incremental savestates. SetDeltaBase takes a copy of MEM1/MEM2, after which delta states store
+// only the 4 KiB RAM pages that differ from that copy (everything else is stored in full).
+// A delta state can only be loaded while the base it was saved against is still set.
+void SetDeltaBase();
+void ClearDeltaBase();
+bool HasDeltaBase();
+bool SaveDeltaToBuffer(std::vector<u8>& buffer);
+bool LoadDeltaFromBuffer(std::vector<u8>& buffer);
+
+// The same with a base owned by the caller, for those that need more than one (e.g. rewind)
+bool CaptureDeltaBase(Memory::StateRAMBase& base);
+bool SaveDeltaToBuffer(Memory::StateRAMBase& base, std::vector<u8>& buffer);
+bool LoadDeltaFromBuffer(Memory::StateRAMBase& base, std::vector<u8>& buffer);
+
+// In-memory states with storage owned by the caller (e.g. the greenzone), saved and loaded the
+// same way as the slots above
+bool SaveToMemory(std::vector<u8>& buffer);
+bool LoadFromMemory(std::vector<u8>& buffer);
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
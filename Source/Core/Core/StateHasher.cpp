@@ -0,0 +1,94 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateHasher.h"
+
+#include <algorithm>
+#include <array>
+
+#include <xxhash.h>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+
+// Slices end on page boundaries
+constexpr u64 SLICE_ALIGNMENT = 0x1000;
+
+// Hashes the given range of MEM1 followed by MEM2
+static u64 HashMemory(u64 offset, u64 length, u64 seed)
+{
+  const u64 ram_size = Memory::GetRamSizeReal();
+  if (offset < ram_size)
+  {
+    const u64 ram_length = std::min(length, ram_size - offset);
+    seed = XXH64(Memory::m_pRAM + offset, ram_length, seed);
+    offset += ram_length;
+    length -= ram_length;
+  }
+
+  if (length != 0 && Memory::m_pEXRAM)
+    seed = XXH64(Memory::m_pEXRAM + (offset - ram_size), length, seed);
+  return seed;
+}
+
+static u64 HashRegisters(u64 seed)
+{
+  const PowerPC::PowerPCState& state = PowerPC::ppcState;
+
+  // The condition register and the XER are stored in a form which depends on the CPU core, so they
+  // are hashed in their architectural form. The time base is left out, as it's only updated on
+  // reads.
+  std::array<u64, 32 + 64 + 7> registers;
+  auto out = std::copy(std::begin(state.gpr), std::end(state.gpr), registers.begin());
+  for (const PowerPC::PairedSingle& ps : state.ps)
+  {
+    *out++ = ps.PS0AsU64();
+    *out++ = ps.PS1AsU64();
+  }
+  *out++ = state.pc;
+  *out++ = state.cr.Get();
+  *out++ = state.msr.Hex;
+  *out++ = state.fpscr.Hex;
+  *out++ = PowerPC::GetXER().Hex;
+  *out++ = state.spr[SPR_LR];
+  *out++ = state.spr[SPR_CTR];
+  return XXH64(registers.data(), sizeof(registers), seed);
+}
+
+StateHasher::StateHasher(u32 interval_frames) : m_interval(std::max(interval_frames, 1u))
+{
+}
+
+std::optional<u64> StateHasher::OnFrame(u64 frame)
+{
+  const u64 slice = frame % m_interval;
+  if (slice == 0)
+  {
+    m_started = true;
+    m_hash = 0;
+  }
+  if (!m_started)
+    return std::nullopt;
+
+  const u64 memory_size =
+      u64{Memory::GetRamSizeReal()} + (Memory::m_pEXRAM ? Memory::GetExRamSizeReal() : 0);
+  const u64 slice_size = Common::AlignUp((memory_size + m_interval - 1) / m_interval,
+                                         SLICE_ALIGNMENT);
+  const u64 slice_start = std::min(slice * slice_size, memory_size);
+  const u64 slice_end = std::min(slice_start + slice_size, memory_size);
+  m_hash = HashMemory(slice_start, slice_end - slice_start, m_hash);
+
+  if (slice != m_interval - 1)
+    return std::nullopt;
+
+  m_started = false;
+  const u64 hash = HashRegisters(m_hash);
+  return hash != 0 ? hash : 1;
+}
+
+void StateHasher::Reset()
+{
+  m_started = false;
+}
@@ -0,0 +1,33 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+
+#include "Common/CommonTypes.h"
+
+// Hashes MEM1, MEM2 and the PowerPC registers over an interval of emulated frames, to find out
+// early when two runs which should be identical have diverged, e.g. a movie playback or the peers
+// of a netplay session. Every frame of an interval hashes the next slice of the memory, so the cost
+// is spread evenly over the frames instead of stalling one of them. The registers are hashed at the
+// last frame. Runs which stay in sync compute the same hashes at the same frames.
+class StateHasher
+{
+public:
+  explicit StateHasher(u32 interval_frames);
+
+  // Hashes the slice of the given frame. Must be called on the CPU thread once per frame. Returns
+  // the hash of the whole interval at its last frame, which is never 0, unless the hasher was
+  // created or reset in the middle of the interval.
+  std::optional<u64> OnFrame(u64 frame);
+  // Drops the hash of the current interval, e.g. because a state was loaded
+  void Reset();
+
+  u32 GetInterval() const { return m_interval; }
+
+private:
+  u32 m_interval;
+  bool m_started = false;
+  u64 m_hash = 0;
+};
@@ -202,6 +202,8 @@ void InitializeWiiRoot(bool use_temporary)
     File::SetUserPath(D_SESSION_WIIROOT_IDX, File::GetUserPath(D_WIIROOT_IDX));
   }
 
+  // The NAND may have been changed on the host since it was last used.
+  FS::OnDirectoryTreeChanged();
   s_wii_root_initialized = true;
 }
 
@@ -61,6 +61,26 @@ constexpr u8 ENTRY_SIZE = 0x0c;
 constexpr u8 FILE_ENTRY = 0;
 constexpr u8 DIRECTORY_ENTRY = 1;
 
+File::IOFile* OpenFileCache::Get(const std::string& path)
+{
+  const auto it = std::find_if(m_files.begin(), m_files.end(),
+                               [&path](const auto& entry) { return entry.first == path; });
+  if (it != m_files.end())
+  {
+    m_files.splice(m_files.begin(), m_files, it);
+    return &m_files.front().second;
+  }
+
+  File::IOFile file(path, "rb");
+  if (!file)
+    return nullptr;
+
+  m_files.emplace_front(path, std::move(file));
+  if (m_files.size() > MAX_OPEN_FILES)
+    m_files.pop_back();
+  return &m_files.front().second;
+}
+
 DiscContent::DiscContent(u64 offset, u64 size, const std::string& path)
     : m_offset(offset), m_size(size), m_content_source(path)
 {
@@ -95,7 +115,7 @@ u64 DiscContent::GetSize() const
   return m_size;
 }
 
-bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
+bool DiscContent::Read(u64* offset, u64* length, u8** buffer, OpenFileCache* file_cache) const
 {
   if (m_size == 0)
     return true;
@@ -109,9 +129,14 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
 
     if (std::holds_alternative<std::string>(m_content_source))
     {
-      File::IOFile file(std::get<std::string>(m_content_source), "rb");
-      if (!file.Seek(offset_in_content, SEEK_SET) || !file.ReadBytes(*buffer, bytes_to_read))
+      File::IOFile* file = file_cache->Get(std::get<std::string>(m_content_source));
+      if (!file)
         return false;
+      if (!file->Seek(offset_in_content, SEEK_SET) || !file->ReadBytes(*buffer, bytes_to_read))
+      {
+        file->Clear();
+        return false;
+      }
     }
     else if (std::holds_alternative<const u8*>(m_content_source))
     {
@@ -182,7 +207,7 @@ bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
     if (length == 0)
       return true;
 
-    if (!it->Read(&offset, &length, &buffer))
+    if (!it->Read(&offset, &length, &buffer, &m_file_cache))
       return false;
 
     ++it;
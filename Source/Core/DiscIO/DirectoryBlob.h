@@ -5,6 +5,7 @@
 
 #include <array>
 #include <cstddef>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -15,6 +16,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/WiiEncryptionCache.h"
 
@@ -33,6 +35,20 @@ class DirectoryBlobReader;
 // Returns true if the path is inside a DirectoryBlob and doesn't represent the DirectoryBlob itself
 bool ShouldHideFromGameList(const std::string& volume_path);
 
+// Keeps the most recently read files open, so that a file which is read in several chunks
+// doesn't get opened again for every chunk
+class OpenFileCache
+{
+public:
+  File::IOFile* Get(const std::string& path);
+
+private:
+  static constexpr size_t MAX_OPEN_FILES = 8;
+
+  // Most recently used first
+  std::list<std::pair<std::string, File::IOFile>> m_files;
+};
+
 class DiscContent
 {
 public:
@@ -52,7 +68,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, OpenFileCache* file_cache) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -85,6 +101,7 @@ public:
 
 private:
   std::set<DiscContent> m_contents;
+  mutable OpenFileCache m_file_cache;
 };
 
 class DirectoryBlobPartition
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
@@ -68,11 +70,20 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
       buffer_size *= 2;
   }
 
-  std::vector<u8> buffer(buffer_size);
+  // Each buffer is written on another thread while the next one is being read
+  std::array<std::vector<u8>, 2> buffers{std::vector<u8>(buffer_size),
+                                         std::vector<u8>(buffer_size)};
+  std::future<bool> write_future;
   const u64 num_buffers = (infile->GetDataSize() + buffer_size - 1) / buffer_size;
   int progress_monitor = std::max<int>(1, num_buffers / 100);
   bool success = true;
 
+  const auto write_failed = [&outfile_path] {
+    PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
+                   "Check that you have enough space available on the target drive.",
+                   outfile_path);
+  };
+
   for (u64 i = 0; i < num_buffers; i++)
   {
     if (i % progress_monitor == 0)
@@ -87,20 +98,28 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
     }
     const u64 inpos = i * buffer_size;
     const u64 sz = std::min(buffer_size, infile->GetDataSize() - inpos);
+    std::vector<u8>& buffer = buffers[i % buffers.size()];
     if (!infile->Read(inpos, sz, buffer.data()))
     {
       PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
       success = false;
       break;
     }
-    if (!outfile.WriteBytes(buffer.data(), sz))
+    if (write_future.valid() && !write_future.get())
     {
-      PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
-                     "Check that you have enough space available on the target drive.",
-                     outfile_path);
+      write_failed();
       success = false;
       break;
     }
+    write_future = std::async(std::launch::async, [&outfile, &buffer, sz] {
+      return outfile.WriteBytes(buffer.data(), sz);
+    });
+  }
+
+  if (write_future.valid() && !write_future.get() && success)
+  {
+    write_failed();
+    success = false;
   }
 
   if (!success)
@@ -10,7 +10,9 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include <mbedtls/md5.h>
 #include <mbedtls/sha1.h>
@@ -1209,14 +1211,43 @@ void VolumeVerifier::Process()
     m_group_future = std::async(std::launch::async, [this, read_succeeded,
                                                      group_index = m_group_index] {
       const GroupToVerify& group = m_groups[group_index];
+      const u64 blocks = group.block_index_end - group.block_index_start;
+
+      // The blocks are independent of each other, so they are checked on several threads
+      std::vector<char> blocks_valid(blocks, false);
+      const auto check_blocks = [&](u64 start, u64 end) {
+        for (u64 i = start; i < end; ++i)
+        {
+          blocks_valid[i] = read_succeeded && m_volume.CheckBlockIntegrity(
+                                                  group.block_index_start + i,
+                                                  m_data.data() + i * VolumeWii::BLOCK_TOTAL_SIZE,
+                                                  group.partition);
+        }
+      };
+
+      // The first block is checked on its own. This makes sure that the lazily loaded key and
+      // H3 table of the partition are loaded before they are used from several threads.
+      check_blocks(0, std::min<u64>(1, blocks));
+
+      const u64 remaining_blocks = blocks > 1 ? blocks - 1 : 0;
+      const u64 threads = std::clamp<u64>(std::thread::hardware_concurrency(), 1,
+                                          std::max<u64>(1, remaining_blocks));
+      std::vector<std::future<void>> block_futures;
+      for (u64 i = 0; i < threads && remaining_blocks > 0; ++i)
+      {
+        block_futures.push_back(std::async(std::launch::async, check_blocks,
+                                           1 + i * remaining_blocks / threads,
+                                           1 + (i + 1) * remaining_blocks / threads));
+      }
+      for (std::future<void>& future : block_futures)
+        future.get();
+
       u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
+      for (u64 i = 0; i < blocks; ++i, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
       {
         const u64 block_offset = group.offset + offset_in_group;
 
-        if (read_succeeded && m_volume.CheckBlockIntegrity(
-                                  block_index, m_data.data() + offset_in_group, group.partition))
+        if (blocks_valid[i])
         {
           m_biggest_verified_offset =
               std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
@@ -191,6 +191,24 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
                                offset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
     u64 data_offset_in_block = offset % BLOCK_DATA_SIZE;
 
+    // Runs of whole blocks are read in one go and decrypted straight into the output buffer
+    const u64 whole_blocks =
+        data_offset_in_block == 0 ? std::min<u64>(length / BLOCK_DATA_SIZE, BLOCKS_PER_GROUP) : 0;
+    if (whole_blocks > 1)
+    {
+      read_buffer.resize(whole_blocks * BLOCK_TOTAL_SIZE);
+      if (!m_reader->Read(block_offset_on_disc, read_buffer.size(), read_buffer.data()))
+        return false;
+
+      DecryptBlocksData(read_buffer.data(), buffer, whole_blocks, aes_context);
+
+      const u64 copy_size = whole_blocks * BLOCK_DATA_SIZE;
+      length -= copy_size;
+      buffer += copy_size;
+      offset += copy_size;
+      continue;
+    }
+
     if (m_last_decrypted_block != block_offset_on_disc)
     {
       // Read the current block
@@ -629,4 +647,30 @@ void VolumeWii::DecryptBlockData(const u8* in, u8* out, mbedtls_aes_context* aes
                         &in[BLOCK_HEADER_SIZE], out);
 }
 
+void VolumeWii::DecryptBlocksData(const u8* in, u8* out, u64 blocks,
+                                  mbedtls_aes_context* aes_context)
+{
+  // Starting a thread costs about as much as decrypting a few blocks
+  constexpr u64 MIN_BLOCKS_PER_THREAD = 8;
+  const u64 threads = std::clamp<u64>(blocks / MIN_BLOCKS_PER_THREAD, 1,
+                                      std::max<u64>(1, std::thread::hardware_concurrency()));
+
+  const auto decrypt = [in, out, aes_context](u64 start, u64 end) {
+    for (u64 i = start; i < end; ++i)
+      DecryptBlockData(in + i * BLOCK_TOTAL_SIZE, out + i * BLOCK_DATA_SIZE, aes_context);
+  };
+
+  std::vector<std::future<void>> decryption_futures;
+  for (u64 i = 1; i < threads; ++i)
+  {
+    decryption_futures.push_back(
+        std::async(std::launch::async, decrypt, i * blocks / threads, (i + 1) * blocks / threads));
+  }
+
+  decrypt(0, blocks / threads);
+
+  for (std::future<void>& future : decryption_futures)
+    future.get();
+}
+
 }  // namespace DiscIO
@@ -109,6 +109,9 @@ public:
 
   static void DecryptBlockHashes(const u8* in, HashBlock* out, mbedtls_aes_context* aes_context);
   static void DecryptBlockData(const u8* in, u8* out, mbedtls_aes_context* aes_context);
+  // Decrypts the data of consecutive blocks, splitting the work across threads for larger counts
+  static void DecryptBlocksData(const u8* in, u8* out, u64 blocks,
+                                mbedtls_aes_context* aes_context);
 
 protected:
   u32 GetOffsetShift() const override { return 2; }
@@ -76,13 +76,16 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_encryption_cache(this)
+    : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  m_prefetch_thread.Cancel();
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -495,6 +498,7 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_offset -= skipped_data;
   data_size += skipped_data;
 
+  const u64 full_chunk_size = chunk_size;
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
@@ -509,35 +513,22 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
-
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
-
-      group_data_size &= 0x7FFFFFFF;
 
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
-
-    if (group_data_size == 0)
+    ChunkParameters parameters;
+    if (!GetChunkParameters(group, chunk_size, exception_lists, group_offset_in_data, &parameters))
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+      Chunk& chunk = ReadCompressedData(
+          parameters.offset_in_file, parameters.compressed_size, parameters.decompressed_size,
+          parameters.compression_type, parameters.exception_lists, parameters.rvz_packed_size,
+          parameters.data_offset);
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        m_cached_chunks.pop_front();  // Invalidate the cache
         return false;
       }
 
@@ -552,6 +543,9 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
       }
     }
 
+    OnGroupRead(total_group_index, i, group_index, number_of_groups, full_chunk_size, data_size,
+                exception_lists);
+
     *offset += bytes_to_read;
     *size -= bytes_to_read;
     *out_ptr += bytes_to_read;
@@ -560,6 +554,155 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::GetChunkParameters(const GroupEntry& group, u64 chunk_size,
+                                               u32 exception_lists, u64 group_offset_in_data,
+                                               ChunkParameters* parameters) const
+{
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  if (group_data_size == 0)
+    return false;
+
+  parameters->offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+  parameters->compressed_size = group_data_size;
+  parameters->decompressed_size = chunk_size;
+  parameters->compression_type = compression_type;
+  parameters->exception_lists = exception_lists;
+  parameters->rvz_packed_size = rvz_packed_size;
+  parameters->data_offset = group_offset_in_data;
+  return true;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::OnGroupRead(u64 total_group_index, u64 group_index_in_data,
+                                        u32 group_index, u32 number_of_groups, u64 chunk_size,
+                                        u64 data_size, u32 exception_lists)
+{
+  if (total_group_index == m_last_group_read)
+    return;
+
+  const bool sequential = total_group_index == m_last_group_read + 1;
+  m_last_group_read = total_group_index;
+
+  if (!sequential)
+  {
+    // Whatever was prefetched is unlikely to be needed after a seek
+    CancelPrefetches();
+    return;
+  }
+
+  for (u64 i = group_index_in_data + 1;
+       i <= group_index_in_data + PREFETCH_GROUPS && i < number_of_groups; ++i)
+  {
+    const u64 group_offset_in_data = i * chunk_size;
+    if (group_offset_in_data >= data_size || group_index + i >= m_group_entries.size())
+      break;
+
+    ChunkParameters parameters;
+    if (GetChunkParameters(m_group_entries[group_index + i],
+                           std::min(chunk_size, data_size - group_offset_in_data),
+                           exception_lists, group_offset_in_data, &parameters))
+    {
+      PrefetchChunk(parameters);
+    }
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::PrefetchChunk(const ChunkParameters& parameters)
+{
+  const u64 offset_in_file = parameters.offset_in_file;
+  if (std::any_of(m_cached_chunks.begin(), m_cached_chunks.end(),
+                  [offset_in_file](const auto& entry) { return entry.first == offset_in_file; }))
+  {
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_prefetch_mutex);
+    if (!m_prefetched_chunks.try_emplace(offset_in_file).second)
+      return;
+  }
+
+  if (!m_prefetch_thread.IsRunning())
+    m_prefetch_thread.Reset([this](ChunkParameters item) { DecompressPrefetchedChunk(item); });
+  m_prefetch_thread.EmplaceItem(parameters);
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::DecompressPrefetchedChunk(const ChunkParameters& parameters)
+{
+  {
+    std::lock_guard lk(m_prefetch_mutex);
+    if (m_prefetched_chunks.find(parameters.offset_in_file) == m_prefetched_chunks.end())
+      return;
+  }
+
+  if (!m_prefetch_file.IsOpen())
+    m_prefetch_file.Open(m_path, "rb");
+
+  // Reading the last byte makes the chunk decompress all of its data
+  Chunk chunk = CreateChunk(&m_prefetch_file, parameters);
+  u8 last_byte;
+  const bool success = chunk.Read(parameters.decompressed_size - 1, 1, &last_byte);
+
+  {
+    std::lock_guard lk(m_prefetch_mutex);
+    const auto it = m_prefetched_chunks.find(parameters.offset_in_file);
+    if (it != m_prefetched_chunks.end())
+    {
+      if (success)
+        it->second = std::move(chunk);
+      else
+        m_prefetched_chunks.erase(it);
+    }
+  }
+  m_prefetch_cv.notify_all();
+}
+
+template <bool RVZ>
+std::optional<typename WIARVZFileReader<RVZ>::Chunk>
+WIARVZFileReader<RVZ>::TakePrefetchedChunk(u64 offset_in_file)
+{
+  std::unique_lock lk(m_prefetch_mutex);
+
+  // If the chunk is still being decompressed, waiting for it is faster than starting over
+  auto it = m_prefetched_chunks.end();
+  m_prefetch_cv.wait(lk, [&] {
+    it = m_prefetched_chunks.find(offset_in_file);
+    return it == m_prefetched_chunks.end() || it->second.has_value();
+  });
+
+  if (it == m_prefetched_chunks.end())
+    return std::nullopt;
+
+  std::optional<Chunk> chunk = std::move(it->second);
+  m_prefetched_chunks.erase(it);
+  return chunk;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::CancelPrefetches()
+{
+  m_prefetch_thread.Clear();
+
+  std::lock_guard lk(m_prefetch_mutex);
+  m_prefetched_chunks.clear();
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -567,11 +710,37 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  const auto it =
+      std::find_if(m_cached_chunks.begin(), m_cached_chunks.end(),
+                   [offset_in_file](const auto& entry) { return entry.first == offset_in_file; });
+  if (it != m_cached_chunks.end())
+  {
+    m_cached_chunks.splice(m_cached_chunks.begin(), m_cached_chunks, it);
+    return m_cached_chunks.front().second;
+  }
+
+  std::optional<Chunk> chunk = TakePrefetchedChunk(offset_in_file);
+  if (!chunk)
+  {
+    chunk = CreateChunk(&m_file, {offset_in_file, compressed_size, decompressed_size,
+                                  compression_type, exception_lists, rvz_packed_size, data_offset});
+  }
+
+  m_cached_chunks.emplace_front(offset_in_file, std::move(*chunk));
+  if (m_cached_chunks.size() > CHUNK_CACHE_SIZE)
+    m_cached_chunks.pop_back();
+  return m_cached_chunks.front().second;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const
+{
+  const u64 decompressed_size = parameters.decompressed_size;
+  const u32 rvz_packed_size = parameters.rvz_packed_size;
 
   std::unique_ptr<Decompressor> decompressor;
-  switch (compression_type)
+  switch (parameters.compression_type)
   {
   case WIARVZCompressionType::None:
     decompressor = std::make_unique<NoneDecompressor>();
@@ -596,13 +765,12 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
     break;
   }
 
-  const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
+  const bool compressed_exception_lists =
+      parameters.compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, parameters.offset_in_file, parameters.compressed_size, decompressed_size,
+               parameters.exception_lists, compressed_exception_lists, rvz_packed_size,
+               parameters.data_offset, std::move(decompressor));
 }
 
 template <bool RVZ>
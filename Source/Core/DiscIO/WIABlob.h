@@ -4,16 +4,21 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <type_traits>
 #include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -220,6 +225,18 @@ private:
     u64 m_data_offset = 0;
   };
 
+  // Where a group is stored in the file and how to decompress it
+  struct ChunkParameters
+  {
+    u64 offset_in_file;
+    u64 compressed_size;
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 exception_lists;
+    u32 rvz_packed_size;
+    u64 data_offset;
+  };
+
   explicit WIARVZFileReader(File::IOFile file, const std::string& path);
   bool Initialize(const std::string& path);
   bool HasDataOverlap() const;
@@ -232,6 +249,20 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const;
+
+  // Returns false if the group has no data in the file, which means that it only contains zeroes
+  bool GetChunkParameters(const GroupEntry& group, u64 chunk_size, u32 exception_lists,
+                          u64 group_offset_in_data, ChunkParameters* parameters) const;
+
+  // When groups are read sequentially, the following groups are decompressed ahead of time on
+  // a worker thread. The worker reads through its own handle of the file.
+  void OnGroupRead(u64 total_group_index, u64 group_index_in_data, u32 group_index,
+                   u32 number_of_groups, u64 chunk_size, u64 data_size, u32 exception_lists);
+  void PrefetchChunk(const ChunkParameters& parameters);
+  void DecompressPrefetchedChunk(const ChunkParameters& parameters);
+  std::optional<Chunk> TakePrefetchedChunk(u64 offset_in_file);
+  void CancelPrefetches();
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -357,9 +388,22 @@ private:
   bool m_valid;
   WIARVZCompressionType m_compression_type;
 
+  static constexpr size_t CHUNK_CACHE_SIZE = 8;
+  static constexpr u32 PREFETCH_GROUPS = 2;
+
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  std::string m_path;
+
+  // Decompressed chunks keyed by their offset in the file, most recently used first
+  std::list<std::pair<u64, Chunk>> m_cached_chunks;
+
+  u64 m_last_group_read = std::numeric_limits<u64>::max();
+  File::IOFile m_prefetch_file;
+  // An entry without a value is a chunk which is queued or being decompressed
+  std::map<u64, std::optional<Chunk>> m_prefetched_chunks;
+  std::mutex m_prefetch_mutex;
+  std::condition_variable m_prefetch_cv;
+  Common::WorkQueueThread<ChunkParameters> m_prefetch_thread;
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -4,12 +4,19 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <signal.h>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
+#include <xxhash.h>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -17,12 +24,26 @@
 #include <Windows.h>
 #endif
 
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Image.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Common/Tracing.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/HW/Memmap.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/InstructionTrace.h"
+#include "Core/PowerPC/ProfileTrace.h"
+#include "Core/StartupTrace.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -30,13 +51,19 @@
 #endif
 #include "UICommon/UICommon.h"
 
+#include "VideoCommon/FrameBenchmark.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 
 static std::unique_ptr<Platform> s_platform;
 
+// Set by a signal, so that the games of a job list after the running one aren't booted
+static volatile sig_atomic_t s_stop_job_list = 0;
+
 static void signal_handler(int)
 {
+  s_stop_job_list = 1;
+
   const char message[] = "A signal was received. A second signal will force Dolphin to stop.\n";
 #ifdef _WIN32
   puts(message);
@@ -149,6 +176,199 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+// Parses a comma-separated list of frame numbers, returning them sorted
+// Parses a comma separated list of frame numbers, and returns them sorted without duplicates
+static std::optional<std::vector<u64>> ParseFrameList(const std::string& list)
+{
+  std::vector<u64> frames;
+  for (const std::string& token : SplitString(list, ','))
+  {
+    u64 frame;
+    if (!TryParse(std::string(StripSpaces(token)), &frame))
+      return std::nullopt;
+    frames.push_back(frame);
+  }
+  if (frames.empty())
+    return std::nullopt;
+
+  std::sort(frames.begin(), frames.end());
+  frames.erase(std::unique(frames.begin(), frames.end()), frames.end());
+  return frames;
+}
+
+// Prints one JSON object per line with the RAM hashes at each requested frame, and stops the
+// emulator once the last one has been printed or the movie has ended.
+static void InstallMovieVerifier(std::vector<u64> frames)
+{
+  Core::SetOnFrameEndCallback([frames = std::move(frames), next = size_t(0)]() mutable {
+    if (next >= frames.size())
+      return;
+
+    const u64 frame = Movie::GetCurrentFrame();
+    if (frame >= frames[next])
+    {
+      const u64 ram_hash = XXH64(Memory::m_pRAM, Memory::GetRamSizeReal(), 0);
+      const u64 exram_hash =
+          Memory::m_pEXRAM ? XXH64(Memory::m_pEXRAM, Memory::GetExRamSizeReal(), 0) : 0;
+      std::fprintf(stdout, "{\"frame\": %" PRIu64 ", \"ram\": \"%016" PRIx64
+                           "\", \"exram\": \"%016" PRIx64 "\"}\n",
+                   frame, ram_hash, exram_hash);
+      std::fflush(stdout);
+
+      while (next < frames.size() && frames[next] <= frame)
+        next++;
+    }
+
+    if (next >= frames.size() || !Movie::IsPlayingInput())
+    {
+      if (next < frames.size())
+      {
+        std::fprintf(stderr, "The movie ended at frame %" PRIu64 " before all frames were hashed\n",
+                     frame);
+      }
+      next = frames.size();
+      s_platform->Stop();
+    }
+  });
+}
+
+static std::string s_movie_benchmark_report;
+
+// Records a FrameBenchmark from the first to the last frame of the movie, and stops the emulator
+// at the last frame or when the movie ends.
+static void InstallMovieBenchmark(u64 first_frame, u64 last_frame)
+{
+  Core::SetOnFrameEndCallback([first_frame, last_frame, started = false, done = false]() mutable {
+    if (done)
+      return;
+
+    const u64 frame = Movie::GetCurrentFrame();
+    if (!started && frame >= first_frame)
+    {
+      FrameBenchmark::Start();
+      started = true;
+    }
+
+    if (frame >= last_frame || !Movie::IsPlayingInput())
+    {
+      if (frame < last_frame)
+      {
+        std::fprintf(stderr, "The movie ended at frame %" PRIu64 " before the benchmark ended\n",
+                     frame);
+      }
+      s_movie_benchmark_report = FrameBenchmark::Stop();
+      done = true;
+      s_platform->Stop();
+    }
+  });
+}
+
+struct Job
+{
+  std::string game_path;
+  std::string movie_path;
+};
+
+// Reads a job list, with one game per line optionally followed by a tab and the movie to play.
+// Empty lines and lines starting with # are skipped.
+static std::optional<std::vector<Job>> ReadJobList(const std::string& path)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+    return std::nullopt;
+
+  std::vector<Job> jobs;
+  for (const std::string& line : SplitString(contents, '\n'))
+  {
+    const std::string_view stripped = StripSpaces(line);
+    if (stripped.empty() || stripped[0] == '#')
+      continue;
+
+    const std::vector<std::string> fields = SplitString(std::string(stripped), '\t');
+    if (fields.size() > 2)
+      return std::nullopt;
+    jobs.push_back({fields[0], fields.size() == 2 ? fields[1] : std::string()});
+  }
+  if (jobs.empty())
+    return std::nullopt;
+  return jobs;
+}
+
+static bool LoadFrameDump(const std::string& path, std::vector<u8>* data, u32* width, u32* height)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+    return false;
+
+  return Common::LoadPNG(std::vector<u8>(contents.begin(), contents.end()), data, width, height);
+}
+
+// Compares the PNG frame dumps of two directories frame by frame. Prints one JSON object per line
+// for each frame and a summary at the end.
+static int CompareFrameDumps(const std::string& list)
+{
+  const std::vector<std::string> dirs = SplitString(list, ',');
+  if (dirs.size() != 2)
+  {
+    fprintf(stderr, "--compare_frame_dumps needs two directories\n");
+    return 1;
+  }
+
+  u32 frames = 0;
+  u32 mismatched_frames = 0;
+  double min_psnr = INFINITY;
+  for (u32 frame = 1;; ++frame)
+  {
+    const std::string name = fmt::format("/framedump_{}.png", frame);
+    const bool exists_a = File::Exists(dirs[0] + name);
+    const bool exists_b = File::Exists(dirs[1] + name);
+    if (!exists_a && !exists_b)
+      break;
+
+    frames++;
+    std::vector<u8> data_a, data_b;
+    u32 width_a, height_a, width_b, height_b;
+    const char* error = nullptr;
+    if (!exists_a || !exists_b)
+      error = "missing";
+    else if (!LoadFrameDump(dirs[0] + name, &data_a, &width_a, &height_a) ||
+             !LoadFrameDump(dirs[1] + name, &data_b, &width_b, &height_b))
+      error = "unreadable";
+    else if (width_a != width_b || height_a != height_b)
+      error = "size";
+
+    if (error)
+    {
+      mismatched_frames++;
+      min_psnr = 0.0;
+      std::fprintf(stdout, "{\"frame\": %u, \"error\": \"%s\"}\n", frame, error);
+      continue;
+    }
+
+    const size_t num_pixels = size_t{width_a} * height_a;
+    const Common::ImageDifference difference =
+        Common::CompareRGBAImages(data_a.data(), data_b.data(), num_pixels);
+    const double psnr = Common::GetPSNR(difference, num_pixels);
+    if (difference.mismatched_pixels != 0)
+      mismatched_frames++;
+    min_psnr = std::min(min_psnr, psnr);
+
+    // JSON has no infinity, identical frames have a PSNR of null
+    std::fprintf(stdout,
+                 "{\"frame\": %u, \"width\": %u, \"height\": %u, \"psnr\": %s, "
+                 "\"mismatched_pixels\": %" PRIu64 "}\n",
+                 frame, width_a, height_a,
+                 std::isinf(psnr) ? "null" : fmt::format("{:.3f}", psnr).c_str(),
+                 difference.mismatched_pixels);
+  }
+
+  std::fprintf(stdout, "{\"frames\": %u, \"mismatched_frames\": %u, \"min_psnr\": %s}\n",
+               frames, mismatched_frames,
+               std::isinf(min_psnr) ? "null" : fmt::format("{:.3f}", min_psnr).c_str());
+  std::fflush(stdout);
+  return 0;
+}
+
 int main(int argc, char* argv[])
 {
   auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
@@ -170,6 +390,84 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--verify_frames")
+      .action("store")
+      .metavar("<frame>,<frame>,...")
+      .type("string")
+      .help("Play the movie as fast as possible with the Null video and audio backends, print the "
+            "RAM hashes at each given frame as JSON, then exit (requires --movie)");
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .metavar("<loops>")
+      .type("int")
+      .help("Play the FIFO log the given number of times without a frame limiter, print the frame "
+            "times, draw counts and pipeline compile stalls as JSON, then exit");
+  parser->add_option("--benchmark_frames")
+      .action("store")
+      .metavar("<first>,<last>")
+      .type("string")
+      .help("Play the movie without a frame limiter, print the frame times, CPU idle time, JIT "
+            "compile time and shader compile counts between the two frames as JSON, then exit "
+            "(requires --movie)");
+  parser->add_option("--fifo_dump_frames")
+      .action("store_true")
+      .help("Play the FIFO log once without a frame limiter and dump every frame as a PNG at the "
+            "internal resolution to Dump/Frames in the user directory, then exit");
+  parser->add_option("--compare_frame_dumps")
+      .action("store")
+      .metavar("<dir>,<dir>")
+      .type("string")
+      .help("Compare the PNG frame dumps of two directories, print the PSNR and the number of "
+            "mismatched pixels of each frame as JSON, then exit");
+  parser->add_option("--cpu_core")
+      .action("store")
+      .metavar("<index>")
+      .type("int")
+      .help("Pin Dolphin to a single host CPU core");
+  parser->add_option("--profile_trace")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Profile the JIT blocks and write the time spent per guest function every second of "
+            "emulated frames to a Chrome trace event file");
+  parser->add_option("--instruction_trace")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Record the executed guest instructions, their register writes and memory addresses "
+            "and write the newest ones to a binary trace when emulation stops, see "
+            "Tools/trace-diff.py");
+  parser->add_option("--instruction_trace_size")
+      .action("store")
+      .metavar("<MiB>")
+      .type("int")
+      .set_default(256)
+      .help("Size of the instruction trace ring buffer");
+  parser->add_option("--startup_trace")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write the time spent in each stage of starting up until the first frame to a "
+            "Chrome trace event file");
+#ifdef USE_TRACING
+  parser->add_option("--trace")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write spans of the CPU, GPU, JIT, DVD and savestate hot paths on every thread to a "
+            "Chrome trace event file");
+#endif
+  parser->add_option("--job_list")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Run the games of a file one after the other in this process, one per line optionally "
+            "followed by a tab and a movie to play. The other options apply to every game, and "
+            "a line with the index of the game is printed as JSON before its output");
+  parser->add_option("--fast_boot")
+      .action("store_true")
+      .help("Boot without the IPL, compile the shaders of the pipeline UID cache before starting "
+            "and don't scan for Wii Remotes, for short unattended runs");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -180,6 +478,85 @@ int main(int argc, char* argv[])
     save_state_path = static_cast<const char*>(options.get("save_state"));
   }
 
+  std::optional<std::vector<Job>> job_list;
+  if (options.is_set("job_list"))
+  {
+    const std::string job_list_path = static_cast<const char*>(options.get("job_list"));
+    job_list = ReadJobList(job_list_path);
+    if (!job_list)
+    {
+      fprintf(stderr, "Could not read the job list %s\n", job_list_path.c_str());
+      return 1;
+    }
+    if (save_state_path || options.is_set("movie") || options.is_set("exec") ||
+        options.is_set("nand_title") || !args.empty())
+    {
+      fprintf(stderr, "--job_list can't be combined with a game, a movie or a save state\n");
+      return 1;
+    }
+  }
+
+  std::optional<std::vector<u64>> verify_frames;
+  if (options.is_set("verify_frames"))
+  {
+    verify_frames = ParseFrameList(static_cast<const char*>(options.get("verify_frames")));
+    if (!verify_frames || (!options.is_set("movie") && !job_list))
+    {
+      fprintf(stderr, "--verify_frames needs a list of frame numbers and a movie to play\n");
+      parser->print_help();
+      return 1;
+    }
+  }
+
+  std::optional<std::vector<u64>> benchmark_frames;
+  if (options.is_set("benchmark_frames"))
+  {
+    benchmark_frames = ParseFrameList(static_cast<const char*>(options.get("benchmark_frames")));
+    if (!benchmark_frames || benchmark_frames->size() != 2 ||
+        (!options.is_set("movie") && !job_list) || verify_frames)
+    {
+      fprintf(stderr, "--benchmark_frames needs the first and the last frame and a movie to play, "
+                      "and can't be combined with --verify_frames\n");
+      parser->print_help();
+      return 1;
+    }
+  }
+
+  if (options.is_set("compare_frame_dumps"))
+    return CompareFrameDumps(static_cast<const char*>(options.get("compare_frame_dumps")));
+
+  std::optional<u32> fifo_benchmark_loops;
+  if (options.is_set("fifo_benchmark"))
+  {
+    const int loops = static_cast<int>(options.get("fifo_benchmark"));
+    if (loops <= 0)
+    {
+      fprintf(stderr, "--fifo_benchmark needs a positive number of loops\n");
+      return 1;
+    }
+    fifo_benchmark_loops = static_cast<u32>(loops);
+  }
+  const bool fifo_dump_frames = options.is_set("fifo_dump_frames");
+  if (fifo_dump_frames && !fifo_benchmark_loops)
+    fifo_benchmark_loops = 1;
+  if (fifo_benchmark_loops && job_list)
+  {
+    fprintf(stderr, "--fifo_benchmark and --fifo_dump_frames can't be combined with --job_list\n");
+    return 1;
+  }
+
+  if (options.is_set("cpu_core"))
+  {
+    // Threads created later inherit the affinity of the main thread on POSIX systems.
+    const int core = static_cast<int>(options.get("cpu_core"));
+    if (core < 0 || core >= 32)
+    {
+      fprintf(stderr, "Invalid CPU core index\n");
+      return 1;
+    }
+    Common::SetCurrentThreadAffinity(1u << core);
+  }
+
   std::unique_ptr<BootParameters> boot;
   bool game_specified = false;
   if (options.is_set("exec"))
@@ -208,12 +585,19 @@ int main(int argc, char* argv[])
     args.erase(args.begin());
     game_specified = true;
   }
-  else
+  else if (!job_list)
   {
     parser->print_help();
     return 0;
   }
 
+  if (fifo_benchmark_loops &&
+      (!boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters)))
+  {
+    fprintf(stderr, "--fifo_benchmark and --fifo_dump_frames need a FIFO log to play\n");
+    return 1;
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
@@ -221,7 +605,49 @@ int main(int argc, char* argv[])
   UICommon::SetUserDirectory(user_directory);
   UICommon::Init();
 
-  s_platform = GetPlatform(options);
+  if (verify_frames)
+  {
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string("Null"));
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  }
+
+  if (fifo_benchmark_loops || benchmark_frames)
+  {
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::GFX_VSYNC, false);
+  }
+  if (fifo_benchmark_loops)
+    FifoPlayer::GetInstance().SetLoopLimit(*fifo_benchmark_loops);
+
+  // SConfig is saved when shutting down, and the fast boot settings must not end up in the ini
+  const bool fast_boot = options.is_set("fast_boot");
+  const bool previous_hle_bs2 = SConfig::GetInstance().bHLE_BS2;
+  const bool previous_continuous_scanning = SConfig::GetInstance().m_WiimoteContinuousScanning;
+  if (fast_boot)
+  {
+    // With a warm shader cache this loads every shader up front, so the first frames don't stall
+    // or, with asynchronous compilation, render incompletely while shaders compile
+    Config::SetCurrent(Config::GFX_SHADER_CACHE, true);
+    Config::SetCurrent(Config::GFX_WAIT_FOR_SHADERS_BEFORE_STARTING, true);
+    SConfig::GetInstance().bHLE_BS2 = true;
+    SConfig::GetInstance().m_WiimoteContinuousScanning = false;
+  }
+
+  if (fifo_dump_frames)
+  {
+    Config::SetCurrent(Config::GFX_DUMP_FRAMES_AS_IMAGES, true);
+    Config::SetCurrent(Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS, true);
+    Config::SetCurrent(Config::GFX_FAST_FRAME_DUMPS, true);
+    SConfig::GetInstance().m_DumpFrames = true;
+    SConfig::GetInstance().m_DumpFramesSilent = true;
+  }
+
+  if ((verify_frames || fifo_benchmark_loops || benchmark_frames) && !options.is_set("platform"))
+    s_platform = Platform::CreateHeadlessPlatform();
+  else
+    s_platform = GetPlatform(options);
   if (!s_platform || !s_platform->Init())
   {
     fprintf(stderr, "No platform found, or failed to initialize.\n");
@@ -252,24 +678,147 @@ int main(int argc, char* argv[])
   sigaction(SIGTERM, &sa, nullptr);
 #endif
 
-  DolphinAnalytics::Instance().ReportDolphinStart("nogui");
+  if (options.is_set("profile_trace"))
+  {
+    const std::string trace_path = static_cast<const char*>(options.get("profile_trace"));
+    if (!ProfileTrace::Start(trace_path, 60))
+    {
+      fprintf(stderr, "Could not create the profile trace %s\n", trace_path.c_str());
+      return 1;
+    }
+  }
 
-  if (!BootManager::BootCore(std::move(boot), s_platform->GetWindowSystemInfo()))
+  if (options.is_set("instruction_trace"))
   {
-    fprintf(stderr, "Could not boot the specified file\n");
-    return 1;
+    const std::string trace_path = static_cast<const char*>(options.get("instruction_trace"));
+    const int size_mib = static_cast<int>(options.get("instruction_trace_size"));
+    if (size_mib <= 0)
+    {
+      fprintf(stderr, "Invalid instruction trace size\n");
+      return 1;
+    }
+    if (!InstructionTrace::Start(trace_path, static_cast<u64>(size_mib) << 20))
+    {
+      fprintf(stderr, "Could not create the instruction trace %s\n", trace_path.c_str());
+      return 1;
+    }
   }
 
+  if (options.is_set("startup_trace"))
+    StartupTrace::SetOutputFile(static_cast<const char*>(options.get("startup_trace")));
+
+#ifdef USE_TRACING
+  const bool trace = options.is_set("trace");
+  if (trace)
+  {
+    const std::string trace_path = static_cast<const char*>(options.get("trace"));
+    if (!Common::Tracing::Start(trace_path))
+    {
+      fprintf(stderr, "Could not create the trace %s\n", trace_path.c_str());
+      return 1;
+    }
+  }
+#endif
+
+  const bool fifo_benchmark = options.is_set("fifo_benchmark");
+  if (fifo_benchmark)
+    FrameBenchmark::Start();
+
+  DolphinAnalytics::Instance().ReportDolphinStart("nogui");
+
+  // Boots a game, plays the movie if there is one and emulates until the platform is stopped
+  const auto run_game = [&](std::unique_ptr<BootParameters> game_boot,
+                            const std::string& movie_path) {
+    if (!game_boot)
+    {
+      fprintf(stderr, "Could not boot the specified file\n");
+      return false;
+    }
+    if (!movie_path.empty() && !Movie::PlayInput(movie_path, &game_boot->savestate_path))
+    {
+      fprintf(stderr, "Could not play the movie %s\n", movie_path.c_str());
+      return false;
+    }
+
+    if (verify_frames)
+      InstallMovieVerifier(*verify_frames);
+    if (benchmark_frames)
+      InstallMovieBenchmark((*benchmark_frames)[0], (*benchmark_frames)[1]);
+
+    if (!BootManager::BootCore(std::move(game_boot), s_platform->GetWindowSystemInfo()))
+    {
+      fprintf(stderr, "Could not boot the specified file\n");
+      Core::SetOnFrameEndCallback({});
+      return false;
+    }
+
 #ifdef USE_DISCORD_PRESENCE
-  Discord::UpdateDiscordPresence();
+    Discord::UpdateDiscordPresence();
 #endif
 
-  s_platform->MainLoop();
-  Core::Stop();
+    s_platform->MainLoop();
+    Core::Stop();
 
-  Core::Shutdown();
+    Core::Shutdown();
+    Core::SetOnFrameEndCallback({});
+
+    if (benchmark_frames)
+    {
+      std::fprintf(stdout, "%s\n", s_movie_benchmark_report.c_str());
+      std::fflush(stdout);
+      s_movie_benchmark_report.clear();
+    }
+    return true;
+  };
+
+  int result = 0;
+  if (job_list)
+  {
+    // The games share the process, the user directory, the config and the platform, which saves
+    // setting them up for every game
+    u32 failed_jobs = 0;
+    for (size_t i = 0; i < job_list->size() && !s_stop_job_list; i++)
+    {
+      std::fprintf(stdout, "{\"job\": %zu}\n", i);
+      std::fflush(stdout);
+
+      const Job& job = (*job_list)[i];
+      s_platform->ResetRunningFlag();
+      if (!run_game(BootParameters::GenerateFromFile(job.game_path), job.movie_path))
+        failed_jobs++;
+    }
+    if (failed_jobs != 0)
+    {
+      fprintf(stderr, "%u of %zu jobs failed\n", failed_jobs, job_list->size());
+      result = 1;
+    }
+  }
+  else
+  {
+    const std::string movie_path =
+        options.is_set("movie") ? static_cast<const char*>(options.get("movie")) : "";
+    if (!run_game(std::move(boot), movie_path))
+      return 1;
+  }
+
+#ifdef USE_TRACING
+  if (trace)
+    Common::Tracing::Stop();
+#endif
+
+  if (fifo_benchmark)
+  {
+    std::fprintf(stdout, "%s\n", FrameBenchmark::Stop().c_str());
+    std::fflush(stdout);
+  }
   s_platform.reset();
+
+  if (fast_boot)
+  {
+    SConfig::GetInstance().bHLE_BS2 = previous_hle_bs2;
+    SConfig::GetInstance().m_WiimoteContinuousScanning = previous_continuous_scanning;
+  }
   UICommon::Shutdown();
 
-  return 0;
+  return result;
 }
@@ -50,3 +50,10 @@ void Platform::RequestShutdown()
 {
   m_shutdown_requested.Set();
 }
+
+void Platform::ResetRunningFlag()
+{
+  m_shutdown_requested.Clear();
+  m_tried_graceful_shutdown.Clear();
+  m_running.Set();
+}
@@ -19,7 +19,8 @@ public:
 
 void PlatformHeadless::SetTitle(const std::string& title)
 {
-  std::fprintf(stdout, "%s\n", title.c_str());
+  // stderr, so that stdout only carries output that was asked for (such as movie verification)
+  std::fprintf(stderr, "%s\n", title.c_str());
 }
 
 void PlatformHeadless::MainLoop()
@@ -101,6 +101,7 @@ void AdvancedWidget::CreateWidgets()
 
   m_use_fullres_framedumps = new GraphicsBool(tr("Dump at Internal Resolution"),
                                               Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
+  m_fast_framedumps = new GraphicsBool(tr("Dump Without Presenting"), Config::GFX_FAST_FRAME_DUMPS);
   m_dump_use_ffv1 = new GraphicsBool(tr("Use Lossless Codec (FFV1)"), Config::GFX_USE_FFV1);
   m_dump_bitrate = new GraphicsInteger(0, 1000000, Config::GFX_BITRATE_KBPS, 1000);
 
@@ -110,6 +111,7 @@ void AdvancedWidget::CreateWidgets()
   dump_layout->addWidget(new QLabel(tr("Bitrate (kbps):")), 1, 0);
   dump_layout->addWidget(m_dump_bitrate, 1, 1);
 #endif
+  dump_layout->addWidget(m_fast_framedumps, 2, 0);
 
   // Misc.
   auto* misc_box = new QGroupBox(tr("Misc"));
@@ -243,6 +245,11 @@ void AdvancedWidget::AddDescriptions()
       "the size of the window it is displayed within.<br><br>If the aspect ratio is widescreen, "
       "the output image will be scaled horizontally to preserve the vertical resolution.<br><br>"
       "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_FAST_FRAME_DUMPS_DESCRIPTION[] = QT_TR_NOOP(
+      "While dumping frames, renders them only to the dump at the internal resolution of the "
+      "renderer. Nothing is presented to the window and emulation runs as fast as rendering and "
+      "encoding allow, without affecting the timing of the dumped video.<br><br>"
+      "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
 #if defined(HAVE_FFMPEG)
   static const char TR_USE_FFV1_DESCRIPTION[] =
       QT_TR_NOOP("Encodes frame dumps using the FFV1 codec.<br><br><dolphin_emphasis>If "
@@ -289,6 +296,7 @@ void AdvancedWidget::AddDescriptions()
   m_dump_xfb_target->SetDescription(tr(TR_DUMP_XFB_DESCRIPTION));
   m_disable_vram_copies->SetDescription(tr(TR_DISABLE_VRAM_COPIES_DESCRIPTION));
   m_use_fullres_framedumps->SetDescription(tr(TR_INTERNAL_RESOLUTION_FRAME_DUMPING_DESCRIPTION));
+  m_fast_framedumps->SetDescription(tr(TR_FAST_FRAME_DUMPS_DESCRIPTION));
 #ifdef HAVE_FFMPEG
   m_dump_use_ffv1->SetDescription(tr(TR_USE_FFV1_DESCRIPTION));
 #endif
@@ -51,6 +51,7 @@ private:
   // Frame dumping
   GraphicsBool* m_dump_use_ffv1;
   GraphicsBool* m_use_fullres_framedumps;
+  GraphicsBool* m_fast_framedumps;
   GraphicsInteger* m_dump_bitrate;
 
   // Misc
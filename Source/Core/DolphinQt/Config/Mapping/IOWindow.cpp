@@ -342,7 +342,8 @@ void IOWindow::CreateMainLayout()
     m_option_list->setItemDelegate(new InputStateDelegate(this, 1, [&](int row) {
       std::lock_guard lock(m_selected_device_mutex);
       // Clamp off negative values but allow greater than one in the text display.
-      return std::max(GetSelectedDevice()->Inputs()[row]->GetState(), 0.0);
+      const auto device = GetSelectedDevice();
+      return std::max(device->GetInputState(device->Inputs()[row]), 0.0);
     }));
   }
   else
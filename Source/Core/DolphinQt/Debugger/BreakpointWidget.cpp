@@ -10,6 +10,8 @@
 #include <QToolBar>
 #include <QVBoxLayout>
 
+#include <utility>
+
 #include "Common/FileUtil.h"
 #include "Common/IniFile.h"
 #include "Core/ConfigManager.h"
@@ -200,6 +202,9 @@ void BreakpointWidget::Update()
     if (bp.log_on_hit)
       flags.append(QLatin1Char{'l'});
 
+    if (bp.condition)
+      flags.append(QStringLiteral(" %1").arg(QString::fromStdString(bp.condition->ToString())));
+
     m_table->setItem(i, 4, create_item(flags));
 
     i++;
@@ -388,9 +393,10 @@ void BreakpointWidget::AddBP(u32 addr)
   AddBP(addr, false, true, true);
 }
 
-void BreakpointWidget::AddBP(u32 addr, bool temp, bool break_on_hit, bool log_on_hit)
+void BreakpointWidget::AddBP(u32 addr, bool temp, bool break_on_hit, bool log_on_hit,
+                             std::optional<TBreakPointCondition> condition)
 {
-  PowerPC::breakpoints.Add(addr, temp, break_on_hit, log_on_hit);
+  PowerPC::breakpoints.Add(addr, temp, break_on_hit, log_on_hit, std::move(condition));
 
   emit BreakpointsChanged();
   Update();
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <optional>
+
 #include <QDockWidget>
 
 #include "Common/CommonTypes.h"
+#include "Core/PowerPC/BreakPoints.h"
 
 class QAction;
 class QCloseEvent;
@@ -21,7 +24,8 @@ public:
   ~BreakpointWidget();
 
   void AddBP(u32 addr);
-  void AddBP(u32 addr, bool temp, bool break_on_hit, bool log_on_hit);
+  void AddBP(u32 addr, bool temp, bool break_on_hit, bool log_on_hit,
+             std::optional<TBreakPointCondition> condition = std::nullopt);
   void AddAddressMBP(u32 addr, bool on_read = true, bool on_write = true, bool do_log = true,
                      bool do_break = true);
   void AddRangedMBP(u32 from, u32 to, bool do_read = true, bool do_write = true, bool do_log = true,
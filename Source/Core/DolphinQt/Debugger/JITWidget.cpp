@@ -3,6 +3,7 @@
 
 #include "DolphinQt/Debugger/JITWidget.h"
 
+#include <QHeaderView>
 #include <QPushButton>
 #include <QSplitter>
 #include <QTableWidget>
@@ -12,6 +13,7 @@
 #include "Common/GekkoDisassembler.h"
 #include "Common/StringUtil.h"
 #include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PPCTables.h"
 #include "UICommon/Disassembler.h"
 
 #include "DolphinQt/Host.h"
@@ -88,6 +90,16 @@ void JITWidget::CreateWidgets()
        // i18n: Performance cost, not monetary cost
        tr("Cost")});
 
+  m_fallback_table = new QTableWidget;
+  m_fallback_table->setTabKeyNavigation(false);
+  m_fallback_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  m_fallback_table->setColumnCount(2);
+  m_fallback_table->setHorizontalHeaderLabels(
+      {tr("Instruction"),
+       // i18n: The number of times the JIT had to run an instruction in the interpreter
+       tr("Interpreter Fallbacks")});
+  m_fallback_table->verticalHeader()->hide();
+
   m_ppc_asm_widget = new QTextBrowser;
   m_host_asm_widget = new QTextBrowser;
 
@@ -97,6 +109,7 @@ void JITWidget::CreateWidgets()
   m_refresh_button = new QPushButton(tr("Refresh"));
 
   m_table_splitter->addWidget(m_table_widget);
+  m_table_splitter->addWidget(m_fallback_table);
   m_table_splitter->addWidget(m_asm_splitter);
 
   m_asm_splitter->addWidget(m_ppc_asm_widget);
@@ -129,6 +142,8 @@ void JITWidget::Update()
   if (!isVisible())
     return;
 
+  UpdateFallbackTable();
+
   if (!m_address)
   {
     m_ppc_asm_widget->setHtml(QStringLiteral("<i>%1</i>").arg(tr("(ppc)")));
@@ -215,6 +230,18 @@ void JITWidget::Update()
   }
 }
 
+void JITWidget::UpdateFallbackTable()
+{
+  const auto counts = PPCTables::GetInterpreterFallbackCounts();
+
+  m_fallback_table->setRowCount(static_cast<int>(counts.size()));
+  for (int i = 0; i < static_cast<int>(counts.size()); i++)
+  {
+    m_fallback_table->setItem(i, 0, new QTableWidgetItem(QString::fromUtf8(counts[i].first)));
+    m_fallback_table->setItem(i, 1, new QTableWidgetItem(QString::number(counts[i].second)));
+  }
+}
+
 void JITWidget::closeEvent(QCloseEvent*)
 {
   Settings::Instance().SetJITVisible(false);
@@ -27,6 +27,7 @@ public:
 
 private:
   void Update();
+  void UpdateFallbackTable();
   void CreateWidgets();
   void ConnectWidgets();
 
@@ -34,6 +35,7 @@ private:
   void showEvent(QShowEvent* event) override;
 
   QTableWidget* m_table_widget;
+  QTableWidget* m_fallback_table;
   QTextBrowser* m_ppc_asm_widget;
   QTextBrowser* m_host_asm_widget;
   QSplitter* m_table_splitter;
@@ -37,7 +37,7 @@ MemoryViewWidget::MemoryViewWidget(QWidget* parent) : QTableWidget(parent)
 
   connect(&Settings::Instance(), &Settings::DebugFontChanged, this, &QWidget::setFont);
   connect(&Settings::Instance(), &Settings::EmulationStateChanged, this, [this] { Update(); });
-  connect(Host::GetInstance(), &Host::UpdateDisasmDialog, this, &MemoryViewWidget::Update);
+  connect(Host::GetInstance(), &Host::UpdateDisasmDialog, this, &MemoryViewWidget::UpdateValues);
   connect(this, &MemoryViewWidget::customContextMenuRequested, this,
           &MemoryViewWidget::OnContextMenu);
   connect(&Settings::Instance(), &Settings::ThemeChanged, this, &MemoryViewWidget::Update);
@@ -64,6 +64,30 @@ static int GetColumnCount(MemoryViewWidget::Type type)
   }
 }
 
+static QString ValueToString(const AddressSpace::Accessors* accessors,
+                             MemoryViewWidget::Type type, u32 address)
+{
+  switch (type)
+  {
+  case MemoryViewWidget::Type::U8:
+    return QStringLiteral("%1").arg(accessors->ReadU8(address), 2, 16, QLatin1Char('0'));
+  case MemoryViewWidget::Type::ASCII:
+  {
+    const char value = accessors->ReadU8(address);
+    return IsPrintableCharacter(value) ? QString{QChar::fromLatin1(value)} :
+                                         QString{QChar::fromLatin1('.')};
+  }
+  case MemoryViewWidget::Type::U16:
+    return QStringLiteral("%1").arg(accessors->ReadU16(address), 4, 16, QLatin1Char('0'));
+  case MemoryViewWidget::Type::U32:
+    return QStringLiteral("%1").arg(accessors->ReadU32(address), 8, 16, QLatin1Char('0'));
+  case MemoryViewWidget::Type::Float32:
+    return QString::number(accessors->ReadF32(address));
+  default:
+    return QStringLiteral("-");
+  }
+}
+
 void MemoryViewWidget::Update()
 {
   clearSelection();
@@ -82,6 +106,8 @@ void MemoryViewWidget::Update()
 
   setRowCount(rows);
 
+  m_showing_values = Core::GetState() == Core::State::Paused;
+
   for (int i = 0; i < rows; i++)
   {
     setRowHeight(i, 24);
@@ -130,67 +156,33 @@ void MemoryViewWidget::Update()
     }
     bool row_breakpoint = true;
 
-    auto update_values = [&](auto value_to_string) {
-      for (int c = 0; c < GetColumnCount(m_type); c++)
+    for (int c = 0; c < GetColumnCount(m_type); c++)
+    {
+      auto* hex_item = new QTableWidgetItem;
+      hex_item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+      const u32 address = addr + c * (16 / GetColumnCount(m_type));
+
+      if (m_address_space == AddressSpace::Type::Effective &&
+          PowerPC::memchecks.OverlapsMemcheck(address, 16 / GetColumnCount(m_type)))
       {
-        auto* hex_item = new QTableWidgetItem;
-        hex_item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-        const u32 address = addr + c * (16 / GetColumnCount(m_type));
-
-        if (m_address_space == AddressSpace::Type::Effective &&
-            PowerPC::memchecks.OverlapsMemcheck(address, 16 / GetColumnCount(m_type)))
-        {
-          hex_item->setBackground(Qt::red);
-        }
-        else
-        {
-          row_breakpoint = false;
-        }
-        setItem(i, 2 + c, hex_item);
-
-        if (accessors->IsValidAddress(address))
-        {
-          hex_item->setText(value_to_string(address));
-          hex_item->setData(Qt::UserRole, address);
-        }
-        else
-        {
-          hex_item->setFlags({});
-          hex_item->setText(QStringLiteral("-"));
-        }
+        hex_item->setBackground(Qt::red);
+      }
+      else
+      {
+        row_breakpoint = false;
+      }
+      setItem(i, 2 + c, hex_item);
+
+      if (accessors->IsValidAddress(address))
+      {
+        hex_item->setText(ValueToString(accessors, m_type, address));
+        hex_item->setData(Qt::UserRole, address);
+      }
+      else
+      {
+        hex_item->setFlags({});
+        hex_item->setText(QStringLiteral("-"));
       }
-    };
-    switch (m_type)
-    {
-    case Type::U8:
-      update_values([&accessors](u32 address) {
-        const u8 value = accessors->ReadU8(address);
-        return QStringLiteral("%1").arg(value, 2, 16, QLatin1Char('0'));
-      });
-      break;
-    case Type::ASCII:
-      update_values([&accessors](u32 address) {
-        const char value = accessors->ReadU8(address);
-        return IsPrintableCharacter(value) ? QString{QChar::fromLatin1(value)} :
-                                             QString{QChar::fromLatin1('.')};
-      });
-      break;
-    case Type::U16:
-      update_values([&accessors](u32 address) {
-        const u16 value = accessors->ReadU16(address);
-        return QStringLiteral("%1").arg(value, 4, 16, QLatin1Char('0'));
-      });
-      break;
-    case Type::U32:
-      update_values([&accessors](u32 address) {
-        const u32 value = accessors->ReadU32(address);
-        return QStringLiteral("%1").arg(value, 8, 16, QLatin1Char('0'));
-      });
-      break;
-    case Type::Float32:
-      update_values(
-          [&accessors](u32 address) { return QString::number(accessors->ReadF32(address)); });
-      break;
     }
 
     if (row_breakpoint)
@@ -212,6 +204,38 @@ void MemoryViewWidget::Update()
   update();
 }
 
+void MemoryViewWidget::UpdateValues()
+{
+  if (!isVisible())
+    return;
+
+  // Float widths vary, so their columns have to be resized
+  if (!m_showing_values || Core::GetState() != Core::State::Paused || m_type == Type::Float32)
+  {
+    Update();
+    return;
+  }
+
+  // The layout only changes through the setters, so when the CPU stops again only the cells of
+  // memory which changed have to be repainted
+  const AddressSpace::Accessors* accessors = AddressSpace::GetAccessors(m_address_space);
+  for (int i = 0; i < rowCount(); i++)
+  {
+    for (int c = 2; c < 2 + GetColumnCount(m_type); c++)
+    {
+      QTableWidgetItem* hex_item = item(i, c);
+      // Placeholders and invalid addresses aren't selectable
+      if (!hex_item || !hex_item->flags().testFlag(Qt::ItemIsSelectable))
+        continue;
+
+      const QString text =
+          ValueToString(accessors, m_type, hex_item->data(Qt::UserRole).toUInt());
+      if (hex_item->text() != text)
+        hex_item->setText(text);
+    }
+  }
+}
+
 void MemoryViewWidget::SetAddressSpace(AddressSpace::Type address_space)
 {
   if (m_address_space == address_space)
@@ -35,6 +35,8 @@ public:
   explicit MemoryViewWidget(QWidget* parent = nullptr);
 
   void Update();
+  // Refreshes the values of the visible memory, keeping the layout of the last Update.
+  void UpdateValues();
   void ToggleBreakpoint();
   void ToggleRowBreakpoint(bool row);
 
@@ -69,4 +71,6 @@ private:
   bool m_do_log = true;
   u32 m_context_address;
   u32 m_address = 0;
+  // Whether the last Update read the values from memory, rather than showing placeholders.
+  bool m_showing_values = false;
 };
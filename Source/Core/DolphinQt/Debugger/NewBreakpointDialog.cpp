@@ -37,11 +37,15 @@ void NewBreakpointDialog::CreateWidgets()
   m_instruction_bp->setChecked(true);
   m_instruction_box = new QGroupBox;
   m_instruction_address = new QLineEdit;
+  m_instruction_condition = new QLineEdit;
+  m_instruction_condition->setPlaceholderText(tr("Optional, e.g. r3==80001234"));
 
   auto* instruction_layout = new QHBoxLayout;
   m_instruction_box->setLayout(instruction_layout);
   instruction_layout->addWidget(new QLabel(tr("Address:")));
   instruction_layout->addWidget(m_instruction_address);
+  instruction_layout->addWidget(new QLabel(tr("Condition:")));
+  instruction_layout->addWidget(m_instruction_condition);
 
   // Memory BP
   m_memory_bp = new QRadioButton(tr("Memory Breakpoint"));
@@ -167,7 +171,19 @@ void NewBreakpointDialog::accept()
       return;
     }
 
-    m_parent->AddBP(address, false, do_break, do_log);
+    std::optional<TBreakPointCondition> condition;
+    const QString condition_text = m_instruction_condition->text().trimmed();
+    if (!condition_text.isEmpty())
+    {
+      condition = TBreakPointCondition::Parse(condition_text.toStdString());
+      if (!condition)
+      {
+        invalid_input(tr("Condition"));
+        return;
+      }
+    }
+
+    m_parent->AddBP(address, false, do_break, do_log, std::move(condition));
   }
   else
   {
@@ -10,6 +10,7 @@
 #include <QToolBar>
 #include <QVBoxLayout>
 
+#include "Common/BitUtils.h"
 #include "Common/FileUtil.h"
 #include "Common/IniFile.h"
 #include "Core/ConfigManager.h"
@@ -50,7 +51,7 @@ WatchWidget::WatchWidget(QWidget* parent) : QDockWidget(parent)
       Update();
   });
 
-  connect(Host::GetInstance(), &Host::UpdateDisasmDialog, this, &WatchWidget::Update);
+  connect(Host::GetInstance(), &Host::UpdateDisasmDialog, this, &WatchWidget::UpdateValues);
 
   connect(&Settings::Instance(), &Settings::WatchVisibilityChanged, this,
           [this](bool visible) { setHidden(!visible); });
@@ -181,16 +182,7 @@ void WatchWidget::Update()
       brush.setColor(Qt::red);
 
     if (Core::IsRunning())
-    {
-      if (PowerPC::HostIsRAMAddress(entry.address))
-      {
-        hex->setText(QStringLiteral("%1").arg(PowerPC::HostRead_U32(entry.address), 8, 16,
-                                              QLatin1Char('0')));
-        decimal->setText(QString::number(PowerPC::HostRead_U32(entry.address)));
-        string->setText(QString::fromStdString(PowerPC::HostGetString(entry.address, 32)));
-        floatValue->setText(QString::number(PowerPC::HostRead_F32(entry.address)));
-      }
-    }
+      SetValues(entry.address, hex, decimal, string, floatValue);
 
     address->setForeground(brush);
     string->setFlags(Qt::ItemIsEnabled);
@@ -216,9 +208,51 @@ void WatchWidget::Update()
     m_table->setItem(size, i, no_edit);
   }
 
+  m_values_shown = Core::IsRunning();
   m_updating = false;
 }
 
+void WatchWidget::UpdateValues()
+{
+  if (!isVisible())
+    return;
+
+  const int size = static_cast<int>(PowerPC::debug_interface.GetWatches().size());
+  if (!m_values_shown || !Core::IsRunning() || m_table->rowCount() != size + 1)
+  {
+    Update();
+    return;
+  }
+
+  // The watches only change through this widget, which rebuilds the table, so when the CPU stops
+  // only the values have to be read again
+  m_updating = true;
+  for (int i = 0; i < size; i++)
+  {
+    SetValues(PowerPC::debug_interface.GetWatch(i).address, m_table->item(i, 2),
+              m_table->item(i, 3), m_table->item(i, 4), m_table->item(i, 5));
+  }
+  m_updating = false;
+}
+
+void WatchWidget::SetValues(u32 address, QTableWidgetItem* hex, QTableWidgetItem* decimal,
+                            QTableWidgetItem* string, QTableWidgetItem* float_value)
+{
+  if (!PowerPC::HostIsRAMAddress(address))
+    return;
+
+  const u32 value = PowerPC::HostRead_U32(address);
+  const auto set_text = [](QTableWidgetItem* item, const QString& text) {
+    // Unchanged cells aren't repainted
+    if (item->text() != text)
+      item->setText(text);
+  };
+  set_text(hex, QStringLiteral("%1").arg(value, 8, 16, QLatin1Char('0')));
+  set_text(decimal, QString::number(value));
+  set_text(string, QString::fromStdString(PowerPC::HostGetString(address, 32)));
+  set_text(float_value, QString::number(Common::BitCast<float>(value)));
+}
+
 void WatchWidget::closeEvent(QCloseEvent*)
 {
   Settings::Instance().SetWatchVisible(false);
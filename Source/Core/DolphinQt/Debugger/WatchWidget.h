@@ -42,6 +42,10 @@ private:
 
   void UpdateButtonsEnabled();
   void Update();
+  // Reads the values of the watches again, keeping the rows of the last Update.
+  void UpdateValues();
+  void SetValues(u32 address, QTableWidgetItem* hex, QTableWidgetItem* decimal,
+                 QTableWidgetItem* string, QTableWidgetItem* float_value);
 
   void ShowContextMenu();
   void OnItemChanged(QTableWidgetItem* item);
@@ -59,6 +63,8 @@ private:
   QTableWidget* m_table;
 
   bool m_updating = false;
+  // Whether the last Update read the values from memory.
+  bool m_values_shown = false;
 
   static constexpr int NUM_COLUMNS = 6;
 };
@@ -207,14 +207,14 @@ void FIFOAnalyzer::UpdateDetails()
   const u32 object_nr = items[0]->data(0, OBJECT_ROLE).toUInt();
 
   const auto& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const auto& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
 
   // Note that frame_info.objectStarts[object_nr] is the start of the primitive data,
   // but we want to start with the register updates which happen before that.
   const u32 object_start = (object_nr == 0 ? 0 : frame_info.objectEnds[object_nr - 1]);
   const u32 object_size = frame_info.objectEnds[object_nr] - object_start;
 
-  const u8* const object = &fifo_frame.fifoData[object_start];
+  const u8* const object = &fifo_frame->fifoData[object_start];
 
   u32 object_offset = 0;
   while (object_offset < object_size)
@@ -452,12 +452,12 @@ void FIFOAnalyzer::BeginSearch()
   const u32 object_nr = items[0]->data(0, OBJECT_ROLE).toUInt();
 
   const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
 
   const u32 object_start = (object_nr == 0 ? 0 : frame_info.objectEnds[object_nr - 1]);
   const u32 object_size = frame_info.objectEnds[object_nr] - object_start;
 
-  const u8* const object = &fifo_frame.fifoData[object_start];
+  const u8* const object = &fifo_frame->fifoData[object_start];
 
   // TODO: Support searching for bit patterns
   for (u32 cmd_nr = 0; cmd_nr < m_object_data_offsets.size(); cmd_nr++)
@@ -557,12 +557,12 @@ void FIFOAnalyzer::UpdateDescription()
   const u32 entry_nr = m_detail_list->currentRow();
 
   const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
 
   const u32 object_start = (object_nr == 0 ? 0 : frame_info.objectEnds[object_nr - 1]);
   const u32 entry_start = m_object_data_offsets[entry_nr];
 
-  const u8* cmddata = &fifo_frame.fifoData[object_start + entry_start];
+  const u8* cmddata = &fifo_frame->fifoData[object_start + entry_start];
 
   // TODO: Not sure whether we should bother translating the descriptions
 
@@ -16,8 +16,12 @@
 
 const QSize LARGE_BANNER_SIZE(144, 48);
 
+// Enough for the thumbnails of a few hundred games
+constexpr int THUMBNAIL_CACHE_SIZE_KIB = 64 * 1024;
+
 GridProxyModel::GridProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
+  m_thumbnails.setMaxCost(THUMBNAIL_CACHE_SIZE_KIB);
   setSortCaseSensitivity(Qt::CaseInsensitive);
   sort(static_cast<int>(GameListModel::Column::Title));
 }
@@ -35,40 +39,62 @@ QVariant GridProxyModel::data(const QModelIndex& i, int role) const
   {
     auto* model = static_cast<GameListModel*>(sourceModel());
 
-    const auto& buffer = model->GetGameFile(source_index.row())->GetCoverImage().buffer;
-
-    QSize size = Config::Get(Config::MAIN_USE_GAME_COVERS) ? QSize(160, 224) : LARGE_BANNER_SIZE;
-    QPixmap pixmap(size * model->GetScale() * QPixmap().devicePixelRatio());
+    const std::shared_ptr<const UICommon::GameFile> game = model->GetGameFile(source_index.row());
+    const bool use_covers = Config::Get(Config::MAIN_USE_GAME_COVERS);
+    const QString key = QString::fromStdString(game->GetFilePath());
 
-    if (buffer.empty() || !Config::Get(Config::MAIN_USE_GAME_COVERS))
+    // The entry only counts if it was made from this exact GameFile, since the game list replaces
+    // the GameFile when a cover or banner changes
+    const Thumbnail* thumbnail = m_thumbnails.object(key);
+    if (thumbnail && thumbnail->game.lock() == game && thumbnail->scale == model->GetScale() &&
+        thumbnail->use_covers == use_covers)
     {
-      QPixmap banner = model
-                           ->data(model->index(source_index.row(),
-                                               static_cast<int>(GameListModel::Column::Banner)),
-                                  Qt::DecorationRole)
-                           .value<QPixmap>();
+      return thumbnail->pixmap;
+    }
 
-      banner = banner.scaled(pixmap.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QPixmap pixmap = CreateThumbnail(source_index.row(), use_covers);
+    const int cost_kib = pixmap.width() * pixmap.height() * 4 / 1024;
+    m_thumbnails.insert(key, new Thumbnail{game, model->GetScale(), use_covers, pixmap}, cost_kib);
+    return pixmap;
+  }
+  return QVariant();
+}
 
-      pixmap.fill();
+QPixmap GridProxyModel::CreateThumbnail(int source_row, bool use_covers) const
+{
+  auto* model = static_cast<GameListModel*>(sourceModel());
 
-      QPainter painter(&pixmap);
+  const auto& buffer = model->GetGameFile(source_row)->GetCoverImage().buffer;
 
-      painter.drawPixmap(0, pixmap.height() / 2 - banner.height() / 2, banner.width(),
-                         banner.height(), banner);
+  QSize size = use_covers ? QSize(160, 224) : LARGE_BANNER_SIZE;
+  QPixmap pixmap(size * model->GetScale() * QPixmap().devicePixelRatio());
 
-      return pixmap;
-    }
-    else
-    {
-      pixmap = QPixmap::fromImage(QImage::fromData(
-          reinterpret_cast<const unsigned char*>(&buffer[0]), static_cast<int>(buffer.size())));
+  if (buffer.empty() || !use_covers)
+  {
+    QPixmap banner =
+        model->data(model->index(source_row, static_cast<int>(GameListModel::Column::Banner)),
+                    Qt::DecorationRole)
+            .value<QPixmap>();
 
-      return pixmap.scaled(QSize(160, 224) * model->GetScale() * pixmap.devicePixelRatio(),
-                           Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
+    banner = banner.scaled(pixmap.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    pixmap.fill();
+
+    QPainter painter(&pixmap);
+
+    painter.drawPixmap(0, pixmap.height() / 2 - banner.height() / 2, banner.width(),
+                       banner.height(), banner);
+
+    return pixmap;
+  }
+  else
+  {
+    pixmap = QPixmap::fromImage(QImage::fromData(
+        reinterpret_cast<const unsigned char*>(&buffer[0]), static_cast<int>(buffer.size())));
+
+    return pixmap.scaled(QSize(160, 224) * model->GetScale() * pixmap.devicePixelRatio(),
+                         Qt::KeepAspectRatio, Qt::SmoothTransformation);
   }
-  return QVariant();
 }
 
 bool GridProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
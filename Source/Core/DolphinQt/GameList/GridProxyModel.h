@@ -3,7 +3,17 @@
 
 #pragma once
 
+#include <memory>
+
+#include <QCache>
+#include <QPixmap>
 #include <QSortFilterProxyModel>
+#include <QString>
+
+namespace UICommon
+{
+class GameFile;
+}
 
 // This subclass of QSortFilterProxyModel transforms the raw data into a
 // single-column large icon + name to be displayed in a QListView.
@@ -15,4 +25,19 @@ public:
   explicit GridProxyModel(QObject* parent = nullptr);
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
   bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+
+private:
+  struct Thumbnail
+  {
+    std::weak_ptr<const UICommon::GameFile> game;
+    float scale;
+    bool use_covers;
+    QPixmap pixmap;
+  };
+
+  QPixmap CreateThumbnail(int source_row, bool use_covers) const;
+
+  // Decoding and smoothly scaling the covers is slow enough to make scrolling stutter, so the
+  // thumbnails of the most recently shown games are kept, keyed by path
+  mutable QCache<QString, Thumbnail> m_thumbnails;
 };
@@ -26,6 +26,7 @@
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/USB/Bluetooth/BTBase.h"
 #include "Core/IOS/USB/Bluetooth/BTReal.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
 #include "Core/WiiUtils.h"
 
@@ -587,6 +588,14 @@ void HotkeyScheduler::Run()
 
     if (IsHotkey(HK_SAVE_STATE_FILE))
       emit StateSaveFile();
+
+    if (IsHotkey(HK_SAVE_STATE_MEMORY))
+      emit StateSaveMemory();
+
+    if (IsHotkey(HK_LOAD_STATE_MEMORY))
+      emit StateLoadMemory();
+
+    Rewind::SetRewinding(IsHotkey(HK_REWIND, true));
   }
 }
 
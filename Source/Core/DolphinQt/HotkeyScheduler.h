@@ -46,6 +46,8 @@ signals:
   void StateSaveFile();
   void StateLoadUndo();
   void StateSaveUndo();
+  void StateSaveMemory();
+  void StateLoadMemory();
   void StartRecording();
   void ExportRecording();
   void ToggleReadOnlyMode();
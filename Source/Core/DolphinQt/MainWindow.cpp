@@ -577,6 +577,10 @@ void MainWindow::ConnectHotkeys()
           &MainWindow::StateLoadLastSavedAt);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadUndo, this, &MainWindow::StateLoadUndo);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveUndo, this, &MainWindow::StateSaveUndo);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveMemory, this,
+          &MainWindow::StateSaveMemory);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadMemory, this,
+          &MainWindow::StateLoadMemory);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveOldest, this,
           &MainWindow::StateSaveOldest);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveFile, this, &MainWindow::StateSave);
@@ -1324,6 +1328,21 @@ void MainWindow::StateSaveUndo()
   State::UndoSaveState();
 }
 
+// The in-memory slots follow the selected state slot
+void MainWindow::StateSaveMemory()
+{
+  if (State::SaveToMemory(m_state_slot - 1))
+    Core::DisplayMessage(StringFromFormat("Saved state to memory slot %d", m_state_slot), 1000);
+}
+
+void MainWindow::StateLoadMemory()
+{
+  if (State::LoadFromMemory(m_state_slot - 1))
+    Core::DisplayMessage(StringFromFormat("Loaded state from memory slot %d", m_state_slot), 1000);
+  else
+    Core::DisplayMessage(StringFromFormat("Memory slot %d is empty", m_state_slot), 2000);
+}
+
 void MainWindow::StateSaveOldest()
 {
   State::SaveFirstSaved();
@@ -99,6 +99,8 @@ private:
   void StateLoadLastSavedAt(int slot);
   void StateLoadUndo();
   void StateSaveUndo();
+  void StateSaveMemory();
+  void StateLoadMemory();
   void StateSaveOldest();
   void SetStateSlot(int slot);
   void BootWiiSystemMenu();
@@ -4,11 +4,13 @@
 #include "InputCommon/ControlReference/ExpressionParser.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <string>
 #include <utility>
@@ -266,7 +268,7 @@ public:
     // FYI: Clamping values greater than 1.0 is purposely not done to support unbounded values in
     // the future. (e.g. raw accelerometer/gyro data)
 
-    return std::max(0.0, m_input->GetState());
+    return std::max(0.0, m_device->GetInputState(m_input));
   }
   void SetValue(ControlState value) override
   {
@@ -283,6 +285,15 @@ public:
 
   Device::Input* GetInput() const { return m_input; };
 
+  bool Compile(ExpressionProgram* program) const override
+  {
+    if (m_input)
+      program->PushInput(m_device.get(), m_input);
+    else
+      program->PushLiteral(0.0);
+    return true;
+  }
+
 private:
   // Keep a shared_ptr to the device so the control pointer doesn't become invalid.
   std::shared_ptr<Device> m_device;
@@ -412,6 +423,50 @@ public:
     lhs->UpdateReferences(env);
     rhs->UpdateReferences(env);
   }
+
+  bool Compile(ExpressionProgram* program) const override
+  {
+    const std::optional<ExpressionProgram::Opcode> opcode = GetOpcode();
+    if (!opcode || !lhs->Compile(program) || !rhs->Compile(program))
+      return false;
+
+    program->PushOperation(*opcode);
+    return true;
+  }
+
+private:
+  std::optional<ExpressionProgram::Opcode> GetOpcode() const
+  {
+    using Opcode = ExpressionProgram::Opcode;
+    switch (op)
+    {
+    case TOK_AND:
+      return Opcode::And;
+    case TOK_OR:
+      return Opcode::Or;
+    case TOK_ADD:
+      return Opcode::Add;
+    case TOK_SUB:
+      return Opcode::Sub;
+    case TOK_MUL:
+      return Opcode::Mul;
+    case TOK_DIV:
+      return Opcode::Div;
+    case TOK_MOD:
+      return Opcode::Mod;
+    case TOK_LTHAN:
+      return Opcode::LessThan;
+    case TOK_GTHAN:
+      return Opcode::GreaterThan;
+    case TOK_COMMA:
+      return Opcode::Comma;
+    case TOK_XOR:
+      return Opcode::Xor;
+    default:
+      // Assignments have side effects
+      return std::nullopt;
+    }
+  }
 };
 
 class LiteralExpression : public Expression
@@ -442,6 +497,12 @@ public:
 
   std::string GetName() const override { return ValueToString(m_value); }
 
+  bool Compile(ExpressionProgram* program) const override
+  {
+    program->PushLiteral(m_value);
+    return true;
+  }
+
 private:
   const ControlState m_value{};
 };
@@ -475,6 +536,15 @@ public:
     m_variable_ptr = env.GetVariablePtr(m_name);
   }
 
+  bool Compile(ExpressionProgram* program) const override
+  {
+    if (m_variable_ptr)
+      program->PushVariable(m_variable_ptr.get());
+    else
+      program->PushLiteral(0.0);
+    return true;
+  }
+
 protected:
   const std::string m_name;
   std::shared_ptr<ControlState> m_variable_ptr;
@@ -588,6 +658,12 @@ public:
     m_rhs->UpdateReferences(env);
   }
 
+  // The active child only changes with the references
+  bool Compile(ExpressionProgram* program) const override
+  {
+    return GetActiveChild()->Compile(program);
+  }
+
 private:
   const std::unique_ptr<Expression>& GetActiveChild() const
   {
@@ -598,6 +674,198 @@ private:
   std::unique_ptr<Expression> m_rhs;
 };
 
+// Evaluates an expression with its program when the whole expression could be compiled. The
+// program is rebuilt whenever the references change, e.g. when devices are added or removed.
+class CompiledExpression : public Expression
+{
+public:
+  explicit CompiledExpression(std::unique_ptr<Expression>&& expr) : m_expr(std::move(expr)) {}
+
+  ControlState GetValue() const override
+  {
+    return m_is_compiled ? m_program.Evaluate() : m_expr->GetValue();
+  }
+  void SetValue(ControlState value) override { m_expr->SetValue(value); }
+  int CountNumControls() const override { return m_expr->CountNumControls(); }
+  void UpdateReferences(ControlEnvironment& env) override
+  {
+    m_expr->UpdateReferences(env);
+
+    m_program.Clear();
+    m_is_compiled = m_expr->Compile(&m_program) && m_program.IsValid();
+    if (!m_is_compiled)
+      m_program.Clear();
+  }
+  bool Compile(ExpressionProgram* program) const override { return m_expr->Compile(program); }
+
+private:
+  std::unique_ptr<Expression> m_expr;
+  ExpressionProgram m_program;
+  bool m_is_compiled = false;
+};
+
+void ExpressionProgram::Clear()
+{
+  m_instructions.clear();
+  m_stack_size = 0;
+  m_max_stack_size = 0;
+}
+
+bool ExpressionProgram::IsValid() const
+{
+  return m_stack_size == 1 && m_max_stack_size <= MAX_STACK_SIZE;
+}
+
+void ExpressionProgram::PushInput(const Device* device, Device::Input* input)
+{
+  Instruction& instruction = m_instructions.emplace_back(Instruction{Opcode::Input, {}});
+  instruction.input = {device, input};
+  m_max_stack_size = std::max(m_max_stack_size, ++m_stack_size);
+}
+
+void ExpressionProgram::PushLiteral(ControlState value)
+{
+  Instruction& instruction = m_instructions.emplace_back(Instruction{Opcode::Literal, {}});
+  instruction.literal = value;
+  m_max_stack_size = std::max(m_max_stack_size, ++m_stack_size);
+}
+
+void ExpressionProgram::PushVariable(const ControlState* variable)
+{
+  Instruction& instruction = m_instructions.emplace_back(Instruction{Opcode::Variable, {}});
+  instruction.variable = variable;
+  m_max_stack_size = std::max(m_max_stack_size, ++m_stack_size);
+}
+
+void ExpressionProgram::PushOperation(Opcode opcode)
+{
+  const u32 operand_count = GetOperandCount(opcode);
+  ASSERT(operand_count != 0 && m_stack_size >= operand_count);
+  m_instructions.emplace_back(Instruction{opcode, {}});
+  m_stack_size = m_stack_size - operand_count + 1;
+}
+
+u32 ExpressionProgram::GetOperandCount(Opcode opcode)
+{
+  switch (opcode)
+  {
+  case Opcode::Input:
+  case Opcode::Literal:
+  case Opcode::Variable:
+    return 0;
+  case Opcode::Not:
+  case Opcode::Negate:
+    return 1;
+  case Opcode::Clamp:
+  case Opcode::If:
+    return 3;
+  default:
+    return 2;
+  }
+}
+
+ControlState ExpressionProgram::Evaluate() const
+{
+  // Must match GetValue() of the compiled expressions
+  std::array<ControlState, MAX_STACK_SIZE> stack;
+  u32 size = 0;
+  for (const Instruction& instruction : m_instructions)
+  {
+    switch (instruction.opcode)
+    {
+    case Opcode::Input:
+    {
+      const auto [device, input] = instruction.input;
+      // Inputs may return negative values, which are clamped off like in ControlExpression
+      stack[size++] = s_hotkey_suppressions.IsSuppressed(input) ?
+                          0.0 :
+                          std::max(0.0, device->GetInputState(input));
+      continue;
+    }
+    case Opcode::Literal:
+      stack[size++] = instruction.literal;
+      continue;
+    case Opcode::Variable:
+      stack[size++] = *instruction.variable;
+      continue;
+    case Opcode::Not:
+      stack[size - 1] = 1.0 - stack[size - 1];
+      continue;
+    case Opcode::Negate:
+      stack[size - 1] = 0.0 - stack[size - 1];
+      continue;
+    case Opcode::Clamp:
+      stack[size - 3] = std::clamp(stack[size - 3], stack[size - 2], stack[size - 1]);
+      size -= 2;
+      continue;
+    case Opcode::If:
+      stack[size - 3] = stack[size - 3] > CONDITION_THRESHOLD ? stack[size - 2] : stack[size - 1];
+      size -= 2;
+      continue;
+    default:
+      break;
+    }
+
+    const ControlState lhs = stack[size - 2];
+    const ControlState rhs = stack[size - 1];
+    ControlState result;
+    switch (instruction.opcode)
+    {
+    case Opcode::And:
+      result = std::min(lhs, rhs);
+      break;
+    case Opcode::Or:
+      result = std::max(lhs, rhs);
+      break;
+    case Opcode::Add:
+      result = lhs + rhs;
+      break;
+    case Opcode::Sub:
+      result = lhs - rhs;
+      break;
+    case Opcode::Mul:
+      result = lhs * rhs;
+      break;
+    case Opcode::Div:
+      result = lhs / rhs;
+      if (std::isinf(result))
+        result = 0.0;
+      break;
+    case Opcode::Mod:
+      result = std::fmod(lhs, rhs);
+      if (std::isnan(result))
+        result = 0.0;
+      break;
+    case Opcode::LessThan:
+      result = lhs < rhs;
+      break;
+    case Opcode::GreaterThan:
+      result = lhs > rhs;
+      break;
+    case Opcode::Comma:
+      result = rhs;
+      break;
+    case Opcode::Xor:
+      result = std::max(std::min(1 - lhs, rhs), std::min(lhs, 1 - rhs));
+      break;
+    case Opcode::Min:
+      result = std::min(lhs, rhs);
+      break;
+    case Opcode::Max:
+      result = std::max(lhs, rhs);
+      break;
+    default:
+      ASSERT(false);
+      result = 0.0;
+      break;
+    }
+    stack[size - 2] = result;
+    --size;
+  }
+
+  return stack[0];
+}
+
 std::shared_ptr<Device> ControlEnvironment::FindDevice(ControlQualifier qualifier) const
 {
   if (qualifier.has_device)
@@ -990,12 +1258,13 @@ ParseResult ParseExpression(const std::string& str)
   {
     // This is a bit odd.
     // Return the error status of the complex expression with the fallback barewords expression.
-    complex_result.expr = std::move(bareword_expr);
+    complex_result.expr = std::make_unique<CompiledExpression>(std::move(bareword_expr));
     return complex_result;
   }
 
-  complex_result.expr = std::make_unique<CoalesceExpression>(std::move(bareword_expr),
-                                                             std::move(complex_result.expr));
+  complex_result.expr =
+      std::make_unique<CompiledExpression>(std::make_unique<CoalesceExpression>(
+          std::move(bareword_expr), std::move(complex_result.expr)));
   return complex_result;
 }
 }  // namespace ciface::ExpressionParser
@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "InputCommon/ControllerInterface/CoreDevice.h"
 
@@ -164,6 +165,78 @@ private:
   const Core::DeviceQualifier& default_device;
 };
 
+// The postfix form of an expression, with its inputs and variables resolved. Evaluating it is a
+// single loop over a flat array instead of a virtual call per node of the expression.
+class ExpressionProgram
+{
+public:
+  enum class Opcode : u8
+  {
+    // Push a value:
+    Input,
+    Literal,
+    Variable,
+    // Pop one value and push the result:
+    Not,
+    Negate,
+    // Pop two values and push the result:
+    And,
+    Or,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    LessThan,
+    GreaterThan,
+    Comma,
+    Xor,
+    Min,
+    Max,
+    // Pop three values and push the result:
+    Clamp,
+    If,
+  };
+
+  // Programs needing a deeper stack are left to the expression tree
+  static constexpr u32 MAX_STACK_SIZE = 32;
+
+  void Clear();
+  // True if the program computes exactly one value within the stack limit
+  bool IsValid() const;
+
+  void PushInput(const Core::Device* device, Core::Device::Input* input);
+  void PushLiteral(ControlState value);
+  void PushVariable(const ControlState* variable);
+  void PushOperation(Opcode opcode);
+
+  ControlState Evaluate() const;
+
+private:
+  struct InputReference
+  {
+    const Core::Device* device;
+    Core::Device::Input* input;
+  };
+
+  struct Instruction
+  {
+    Opcode opcode;
+    union
+    {
+      ControlState literal;
+      const ControlState* variable;
+      InputReference input;
+    };
+  };
+
+  static u32 GetOperandCount(Opcode opcode);
+
+  std::vector<Instruction> m_instructions;
+  u32 m_stack_size = 0;
+  u32 m_max_stack_size = 0;
+};
+
 class Expression
 {
 public:
@@ -172,6 +245,9 @@ public:
   virtual void SetValue(ControlState state) = 0;
   virtual int CountNumControls() const = 0;
   virtual void UpdateReferences(ControlEnvironment& finder) = 0;
+  // Appends the instructions computing GetValue() to the program, with the references of the last
+  // UpdateReferences(). Only expressions without state or side effects can be compiled.
+  virtual bool Compile(ExpressionProgram*) const { return false; }
 };
 
 class ParseResult
@@ -67,6 +67,11 @@ private:
 
   ControlState GetValue() const override { return 1.0 - GetArg(0).GetValue(); }
   void SetValue(ControlState value) override { GetArg(0).SetValue(1.0 - value); }
+
+  bool Compile(ExpressionProgram* program) const override
+  {
+    return CompileWithArguments(program, ExpressionProgram::Opcode::Not);
+  }
 };
 
 // usage: sin(expression)
@@ -236,6 +241,11 @@ private:
   {
     return std::min(GetArg(0).GetValue(), GetArg(1).GetValue());
   }
+
+  bool Compile(ExpressionProgram* program) const override
+  {
+    return CompileWithArguments(program, ExpressionProgram::Opcode::Min);
+  }
 };
 
 // usage: max(a, b)
@@ -255,6 +265,11 @@ private:
   {
     return std::max(GetArg(0).GetValue(), GetArg(1).GetValue());
   }
+
+  bool Compile(ExpressionProgram* program) const override
+  {
+    return CompileWithArguments(program, ExpressionProgram::Opcode::Max);
+  }
 };
 
 // usage: clamp(value, min, max)
@@ -274,6 +289,11 @@ private:
   {
     return std::clamp(GetArg(0).GetValue(), GetArg(1).GetValue(), GetArg(2).GetValue());
   }
+
+  bool Compile(ExpressionProgram* program) const override
+  {
+    return CompileWithArguments(program, ExpressionProgram::Opcode::Clamp);
+  }
 };
 
 // usage: timer(seconds)
@@ -337,6 +357,11 @@ private:
     return (GetArg(0).GetValue() > CONDITION_THRESHOLD) ? GetArg(1).GetValue() :
                                                           GetArg(2).GetValue();
   }
+
+  bool Compile(ExpressionProgram* program) const override
+  {
+    return CompileWithArguments(program, ExpressionProgram::Opcode::If);
+  }
 };
 
 // usage: minus(expression)
@@ -357,6 +382,11 @@ private:
     // Subtraction for clarity:
     return 0.0 - GetArg(0).GetValue();
   }
+
+  bool Compile(ExpressionProgram* program) const override
+  {
+    return CompileWithArguments(program, ExpressionProgram::Opcode::Negate);
+  }
 };
 
 // usage: deadzone(input, amount)
@@ -726,6 +756,19 @@ u32 FunctionExpression::GetArgCount() const
   return u32(m_args.size());
 }
 
+bool FunctionExpression::CompileWithArguments(ExpressionProgram* program,
+                                              ExpressionProgram::Opcode opcode) const
+{
+  for (auto& arg : m_args)
+  {
+    if (!arg->Compile(program))
+      return false;
+  }
+
+  program->PushOperation(opcode);
+  return true;
+}
+
 void FunctionExpression::SetValue(ControlState)
 {
 }
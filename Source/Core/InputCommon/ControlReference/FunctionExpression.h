@@ -45,6 +45,9 @@ protected:
   const Expression& GetArg(u32 number) const;
   u32 GetArgCount() const;
 
+  // For functions without state, compiles the arguments followed by the opcode of the function
+  bool CompileWithArguments(ExpressionProgram* program, ExpressionProgram::Opcode opcode) const;
+
 private:
   std::vector<std::unique_ptr<Expression>> m_args;
 };
@@ -4,9 +4,12 @@
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
 #include <algorithm>
+#include <chrono>
+#include <iterator>
 
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #ifdef CIFACE_USE_WIN32
@@ -43,6 +46,11 @@ ControllerInterface g_controller_interface;
 // will never interfere with game threads.
 static thread_local ciface::InputChannel tls_input_channel = ciface::InputChannel::Host;
 
+// How often the devices polled in background are updated, and how often the polling thread checks
+// for such devices when there are none
+constexpr std::chrono::milliseconds POLLING_INTERVAL{1};
+constexpr std::chrono::milliseconds IDLE_POLLING_INTERVAL{100};
+
 void ControllerInterface::Initialize(const WindowSystemInfo& wsi)
 {
   if (m_is_init)
@@ -93,6 +101,9 @@ void ControllerInterface::Initialize(const WindowSystemInfo& wsi)
 
   if (m_populating_devices_counter.fetch_sub(1) == 1 && !devices_empty)
     InvokeDevicesChangedCallbacks();
+
+  m_polling_thread_running.Set();
+  m_polling_thread = std::thread(&ControllerInterface::PollingThread, this);
 }
 
 void ControllerInterface::ChangeWindow(void* hwnd, WindowChangeReason reason)
@@ -242,6 +253,11 @@ void ControllerInterface::Shutdown()
   // Additional safety measure to avoid InvokeDevicesChangedCallbacks()
   m_populating_devices_counter = 1;
 
+  // The backends must not be shut down while the polling thread updates their devices
+  m_polling_thread_running.Clear();
+  if (m_polling_thread.joinable())
+    m_polling_thread.join();
+
   // Update control references so shared_ptr<Device>s are freed up BEFORE we shutdown the backends.
   ClearDevices();
 
@@ -336,6 +352,8 @@ bool ControllerInterface::AddDevice(std::shared_ptr<ciface::Core::Device> device
       device->SetId(id);
     }
 
+    device->InitializeInputSnapshot();
+
     NOTICE_LOG_FMT(CONTROLLERINTERFACE, "Added device: {}", device->GetQualifiedName());
     m_devices.emplace_back(std::move(device));
 
@@ -404,8 +422,37 @@ void ControllerInterface::UpdateInput()
     {
       // Theoretically we could avoid updating input on devices that don't have any references to
       // them, but in practice a few devices types could break in different ways, so we don't
+      if (!d->IsPolledInBackground())
+        d->UpdateInput();
+    }
+  }
+}
+
+void ControllerInterface::PollingThread()
+{
+  Common::SetCurrentThreadName("Input polling");
+
+  std::vector<std::shared_ptr<ciface::Core::Device>> devices;
+  while (m_polling_thread_running.IsSet())
+  {
+    {
+      std::lock_guard lk(m_devices_mutex);
+      std::copy_if(m_devices.begin(), m_devices.end(), std::back_inserter(devices),
+                   [](const auto& d) { return d->IsPolledInBackground(); });
+    }
+
+    // The devices are updated without holding the devices mutex, so a slow update never makes the
+    // emulation threads skip the update of the other devices
+    for (const auto& d : devices)
+    {
       d->UpdateInput();
+      d->PublishInputSnapshot();
     }
+
+    const bool idle = devices.empty();
+    // Don't keep removed devices alive while sleeping
+    devices.clear();
+    std::this_thread::sleep_for(idle ? IDLE_POLLING_INTERVAL : POLLING_INTERVAL);
   }
 }
 
@@ -8,7 +8,9 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 
+#include "Common/Flag.h"
 #include "Common/Matrix.h"
 #include "Common/WindowSystemInfo.h"
 #include "InputCommon/ControllerInterface/CoreDevice.h"
@@ -93,6 +95,7 @@ public:
   // Without this, our devices list might end up in a mixed state.
   void PlatformPopulateDevices(std::function<void()> callback);
   bool IsInit() const { return m_is_init; }
+  // Updates the devices which aren't polled in background
   void UpdateInput();
 
   // Set adjustment from the full render window aspect-ratio to the drawn aspect-ratio.
@@ -112,6 +115,7 @@ public:
 
 private:
   void ClearDevices();
+  void PollingThread();
 
   std::list<std::function<void()>> m_devices_changed_callbacks;
   mutable std::recursive_mutex m_devices_population_mutex;
@@ -124,6 +128,9 @@ private:
   std::atomic<int> m_populating_devices_counter;
   WindowSystemInfo m_wsi;
   std::atomic<float> m_aspect_ratio_adjustment = 1;
+  // Updates the devices polled in background independently of the emulated poll rate
+  std::thread m_polling_thread;
+  Common::Flag m_polling_thread_running;
 };
 
 namespace ciface
@@ -21,6 +21,10 @@ namespace ciface::Core
 // Note: Detect() logic assumes this is greater than 0.5.
 constexpr ControlState INPUT_DETECT_THRESHOLD = 0.55;
 
+// Inputs of a device polled in background are released if its updates stall for this long, so
+// a blocked backend can't keep buttons held down.
+constexpr std::chrono::milliseconds INPUT_SNAPSHOT_TIMEOUT{500};
+
 class CombinedInput final : public Device::Input
 {
 public:
@@ -71,6 +75,7 @@ std::optional<int> Device::GetPreferredId() const
 
 void Device::AddInput(Device::Input* const i)
 {
+  i->m_index = m_inputs.size();
   m_inputs.push_back(i);
 }
 
@@ -79,6 +84,40 @@ void Device::AddOutput(Device::Output* const o)
   m_outputs.push_back(o);
 }
 
+void Device::InitializeInputSnapshot()
+{
+  if (!IsPolledInBackground() || m_input_snapshot)
+    return;
+
+  m_input_snapshot_size = m_inputs.size();
+  m_input_snapshot = std::make_unique<std::atomic<ControlState>[]>(m_input_snapshot_size);
+}
+
+void Device::PublishInputSnapshot()
+{
+  if (!m_input_snapshot)
+    return;
+
+  for (std::size_t i = 0; i != m_input_snapshot_size; ++i)
+    m_input_snapshot[i].store(m_inputs[i]->GetState(), std::memory_order_relaxed);
+
+  m_input_snapshot_time.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                              std::memory_order_release);
+}
+
+ControlState Device::GetInputState(const Input* input) const
+{
+  if (!m_input_snapshot || input->m_index >= m_input_snapshot_size)
+    return input->GetState();
+
+  const std::chrono::steady_clock::duration snapshot_time{
+      m_input_snapshot_time.load(std::memory_order_acquire)};
+  if (std::chrono::steady_clock::now().time_since_epoch() - snapshot_time > INPUT_SNAPSHOT_TIMEOUT)
+    return 0;
+
+  return m_input_snapshot[input->m_index].load(std::memory_order_relaxed);
+}
+
 std::string Device::GetQualifiedName() const
 {
   return fmt::format("{}/{}/{}", GetSource(), GetId(), GetName());
@@ -314,10 +353,15 @@ auto DeviceContainer::DetectInput(const std::vector<std::string>& device_strings
 {
   struct InputState
   {
-    InputState(ciface::Core::Device::Input* input_) : input{input_} { stats.Push(0.0); }
+    InputState(const Device* device_, ciface::Core::Device::Input* input_)
+        : device{device_}, input{input_}
+    {
+      stats.Push(0.0);
+    }
 
+    const Device* device;
     ciface::Core::Device::Input* input;
-    ControlState initial_state = input->GetState();
+    ControlState initial_state = device->GetInputState(input);
     ControlState last_state = initial_state;
     MathUtil::RunningVariance<ControlState> stats;
 
@@ -326,7 +370,7 @@ auto DeviceContainer::DetectInput(const std::vector<std::string>& device_strings
 
     void Update()
     {
-      const auto new_state = input->GetState();
+      const auto new_state = device->GetInputState(input);
 
       if (!is_ready && new_state < (1 - INPUT_DETECT_THRESHOLD))
       {
@@ -379,7 +423,7 @@ auto DeviceContainer::DetectInput(const std::vector<std::string>& device_strings
 
       // Undesirable axes will have negative values here when trying to map a
       // "FullAnalogSurface".
-      input_states.push_back(InputState{input});
+      input_states.push_back(InputState{device.get(), input});
     }
 
     if (!input_states.empty())
@@ -437,7 +481,8 @@ auto DeviceContainer::DetectInput(const std::vector<std::string>& device_strings
     // Check for any releases of our detected inputs.
     for (auto& d : detections)
     {
-      if (!d.release_time.has_value() && d.input->GetState() < (1 - INPUT_DETECT_THRESHOLD))
+      if (!d.release_time.has_value() &&
+          d.device->GetInputState(d.input) < (1 - INPUT_DETECT_THRESHOLD))
         d.release_time = Clock::now();
     }
   }
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -90,6 +92,12 @@ public:
     // so hotkey logic knows Ctrl, L_Ctrl, and R_Ctrl are the same,
     // and so input detection can return the parent name.
     virtual bool IsChild(const Input*) const { return false; }
+
+  private:
+    friend class Device;
+
+    // Position in the inputs of the device, used to find the input in the snapshot
+    std::size_t m_index = 0;
   };
 
   class RelativeInput : public Input
@@ -120,6 +128,20 @@ public:
   std::string GetQualifiedName() const;
   virtual void UpdateInput() {}
 
+  // May be overridden by devices whose UpdateInput() is slow or can block (e.g. on the network).
+  // These are updated on the input polling thread of ControllerInterface instead of the emulation
+  // and UI threads, which read the snapshot of their input states published after every update.
+  virtual bool IsPolledInBackground() const { return false; }
+
+  // The current state of an input of this device. Must be used instead of Input::GetState() for
+  // devices polled in background, whose inputs read as 0 while their snapshot is stale.
+  ControlState GetInputState(const Input* input) const;
+
+  // Called by ControllerInterface once all the inputs have been added
+  void InitializeInputSnapshot();
+  // Called by the input polling thread after UpdateInput()
+  void PublishInputSnapshot();
+
   // May be overridden to implement hotplug removal.
   // Currently handled on a per-backend basis but this could change.
   virtual bool IsValid() const { return true; }
@@ -177,6 +199,11 @@ private:
   int m_id;
   std::vector<Input*> m_inputs;
   std::vector<Output*> m_outputs;
+
+  // Only allocated for devices polled in background
+  std::unique_ptr<std::atomic<ControlState>[]> m_input_snapshot;
+  std::size_t m_input_snapshot_size = 0;
+  std::atomic<std::chrono::steady_clock::rep> m_input_snapshot_time{0};
 };
 
 //
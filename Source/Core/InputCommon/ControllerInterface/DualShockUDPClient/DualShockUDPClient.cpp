@@ -129,6 +129,8 @@ private:
 
 public:
   void UpdateInput() override;
+  // The pad data arrives over the network
+  bool IsPolledInBackground() const override { return true; }
 
   Device(std::string name, int index, std::string server_address, u16 server_port);
 
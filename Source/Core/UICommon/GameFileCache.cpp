@@ -20,6 +20,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/ThreadPool.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -28,6 +29,7 @@
 namespace UICommon
 {
 static constexpr u32 CACHE_REVISION = 20;  // Last changed in PR 9461
+static constexpr unsigned int MAX_SCAN_THREADS = 8;
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -132,19 +134,37 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // Opening the volumes mostly waits for the storage, so it is done on several threads. The files
+  // are added in batches so that game_added_to_cache still gets called while the scan goes on.
+  if (!game_paths.empty())
   {
-    if (processing_halted)
-      break;
+    const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+    Common::ThreadPool thread_pool(MAX_SCAN_THREADS);
+    const size_t batch_size = thread_pool.GetThreadCount() * 4;
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    std::vector<std::shared_ptr<GameFile>> batch;
+    for (size_t batch_start = 0; batch_start < new_paths.size(); batch_start += batch_size)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      if (processing_halted)
+        break;
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+      batch.assign(std::min(batch_size, new_paths.size() - batch_start), nullptr);
+      thread_pool.Run(batch.size(), [&](size_t i) {
+        if (!processing_halted)
+          batch[i] = std::make_shared<GameFile>(new_paths[batch_start + i]);
+      });
+
+      for (std::shared_ptr<GameFile>& file : batch)
+      {
+        if (file && file->IsValid())
+        {
+          if (game_added_to_cache)
+            game_added_to_cache(file);
+
+          cache_changed = true;
+          m_cached_files.push_back(std::move(file));
+        }
+      }
     }
   }
 
@@ -206,49 +206,65 @@ bool VertexManager::UploadTexelBuffer(const void* data, u32 data_size, TexelBuff
 
 void VertexManager::ResetBuffer(u32 vertex_stride)
 {
-  m_base_buffer_pointer = m_cpu_vertex_buffer.data();
-  m_cur_buffer_pointer = m_base_buffer_pointer;
-  m_end_buffer_pointer = m_base_buffer_pointer + m_cpu_vertex_buffer.size();
-  m_index_generator.Start(m_cpu_index_buffer.data());
-}
-
-void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_indices,
-                                 u32* out_base_vertex, u32* out_base_index)
-{
-  D3D11_MAPPED_SUBRESOURCE map;
-
-  u32 vertexBufferSize = Common::AlignUp(num_vertices * vertex_stride, sizeof(u16));
-  u32 indexBufferSize = num_indices * sizeof(u16);
-  u32 totalBufferSize = vertexBufferSize + indexBufferSize;
+  // A batch which ended up culled never got committed.
+  UnmapBuffer();
 
+  // D3D11 has no persistent mapping, so the buffer stays mapped while the vertex loaders write
+  // into it, until the batch is committed. Room for the largest batch is reserved.
   u32 cursor = m_buffer_cursor;
-  u32 padding = vertex_stride > 0 ? (m_buffer_cursor % vertex_stride) : 0;
+  const u32 padding = vertex_stride > 0 ? (cursor % vertex_stride) : 0;
   if (padding)
-  {
     cursor += vertex_stride - padding;
-  }
 
-  D3D11_MAP MapType = D3D11_MAP_WRITE_NO_OVERWRITE;
-  if (cursor + totalBufferSize >= BUFFER_SIZE)
+  D3D11_MAP map_type = D3D11_MAP_WRITE_NO_OVERWRITE;
+  if (cursor + MAXVBUFFERSIZE + MAXIBUFFERSIZE * sizeof(u16) > BUFFER_SIZE)
   {
     // Wrap around
     m_current_buffer = (m_current_buffer + 1) % BUFFER_COUNT;
     cursor = 0;
-    MapType = D3D11_MAP_WRITE_DISCARD;
+    map_type = D3D11_MAP_WRITE_DISCARD;
   }
 
-  *out_base_vertex = vertex_stride > 0 ? (cursor / vertex_stride) : 0;
-  *out_base_index = (cursor + vertexBufferSize) / sizeof(u16);
+  D3D11_MAPPED_SUBRESOURCE map;
+  D3D::context->Map(m_buffers[m_current_buffer].Get(), 0, map_type, 0, &map);
+  m_mapped_buffer = reinterpret_cast<u8*>(map.pData);
+  m_buffer_cursor = cursor;
+
+  m_base_buffer_pointer = m_mapped_buffer + cursor;
+  m_cur_buffer_pointer = m_base_buffer_pointer;
+  m_end_buffer_pointer = m_base_buffer_pointer + MAXVBUFFERSIZE;
+
+  // Where the indices go depends on the number of vertices, they are copied behind them on commit.
+  m_index_generator.Start(m_cpu_index_buffer.data());
+}
+
+void VertexManager::UnmapBuffer()
+{
+  if (!m_mapped_buffer)
+    return;
 
-  D3D::context->Map(m_buffers[m_current_buffer].Get(), 0, MapType, 0, &map);
-  u8* mappedData = reinterpret_cast<u8*>(map.pData);
-  if (vertexBufferSize > 0)
-    std::memcpy(mappedData + cursor, m_base_buffer_pointer, vertexBufferSize);
-  if (indexBufferSize > 0)
-    std::memcpy(mappedData + cursor + vertexBufferSize, m_cpu_index_buffer.data(), indexBufferSize);
   D3D::context->Unmap(m_buffers[m_current_buffer].Get(), 0);
+  m_mapped_buffer = nullptr;
+}
+
+void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_indices,
+                                 u32* out_base_vertex, u32* out_base_index)
+{
+  const u32 vertexBufferSize = Common::AlignUp(num_vertices * vertex_stride, sizeof(u16));
+  const u32 indexBufferSize = num_indices * sizeof(u16);
+
+  *out_base_vertex = vertex_stride > 0 ? (m_buffer_cursor / vertex_stride) : 0;
+  *out_base_index = (m_buffer_cursor + vertexBufferSize) / sizeof(u16);
+
+  ASSERT(m_mapped_buffer);
+  if (indexBufferSize > 0)
+  {
+    std::memcpy(m_mapped_buffer + m_buffer_cursor + vertexBufferSize, m_cpu_index_buffer.data(),
+                indexBufferSize);
+  }
+  UnmapBuffer();
 
-  m_buffer_cursor = cursor + totalBufferSize;
+  m_buffer_cursor += vertexBufferSize + indexBufferSize;
 
   ADDSTAT(g_stats.this_frame.bytes_vertex_streamed, vertexBufferSize);
   ADDSTAT(g_stats.this_frame.bytes_index_streamed, indexBufferSize);
@@ -54,11 +54,17 @@ private:
   static constexpr u32 BUFFER_SIZE =
       (VERTEX_STREAM_BUFFER_SIZE + INDEX_STREAM_BUFFER_SIZE) / BUFFER_COUNT;
 
+  static_assert(MAXVBUFFERSIZE + MAXIBUFFERSIZE * sizeof(u16) <= BUFFER_SIZE,
+                "The largest batch must fit in a buffer");
+
+  void UnmapBuffer();
   bool MapTexelBuffer(u32 required_size, D3D11_MAPPED_SUBRESOURCE& sr);
 
   ComPtr<ID3D11Buffer> m_buffers[BUFFER_COUNT] = {};
   u32 m_current_buffer = 0;
   u32 m_buffer_cursor = 0;
+  // The current buffer while the vertex loaders write into it
+  u8* m_mapped_buffer = nullptr;
 
   ComPtr<ID3D11Buffer> m_vertex_constant_buffer = nullptr;
   ComPtr<ID3D11Buffer> m_geometry_constant_buffer = nullptr;
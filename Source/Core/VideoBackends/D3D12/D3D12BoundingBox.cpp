@@ -5,6 +5,7 @@
 #include "Common/Logging/Log.h"
 #include "VideoBackends/D3D12/D3D12Renderer.h"
 #include "VideoBackends/D3D12/DX12Context.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace DX12
 {
@@ -73,13 +74,32 @@ bool BoundingBox::CreateBuffers()
 void BoundingBox::Readback()
 {
   // Copy from GPU->CPU buffer, and wait for the GPU to finish the copy.
+  QueueReadback();
+  Renderer::GetInstance()->ExecuteCommandList(true);
+  ReadValues();
+  m_valid = true;
+}
+
+void BoundingBox::QueueReadback()
+{
   ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
                   D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
   g_dx_context->GetCommandList()->CopyBufferRegion(m_readback_buffer.Get(), 0, m_gpu_buffer.Get(),
                                                    0, BUFFER_SIZE);
   ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
                   D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-  Renderer::GetInstance()->ExecuteCommandList(true);
+
+  m_readback_fence = g_dx_context->GetCurrentFenceValue();
+  m_readback_pending = true;
+}
+
+void BoundingBox::ReadValues()
+{
+  // The copy has to be submitted before it can be waited for.
+  if (m_readback_fence == g_dx_context->GetCurrentFenceValue())
+    Renderer::GetInstance()->ExecuteCommandList(false);
+  g_dx_context->WaitForFence(m_readback_fence);
+  m_readback_pending = false;
 
   // Read back to cached values.
   static constexpr D3D12_RANGE read_range = {0, BUFFER_SIZE};
@@ -100,13 +120,27 @@ void BoundingBox::Readback()
     if (!m_dirty[i])
       m_values[i] = new_values[i];
   }
-  m_valid = true;
 }
 
 s32 BoundingBox::Get(size_t index)
 {
   if (!m_valid)
-    Readback();
+  {
+    if (g_ActiveConfig.bBBoxDeferReadback)
+    {
+      // Return the values of the previous readback, which has most likely completed by now, and
+      // start another one which the next invalidated read picks up.
+      if (m_readback_pending)
+        ReadValues();
+      QueueReadback();
+      Renderer::GetInstance()->ExecuteCommandList(false);
+      m_valid = true;
+    }
+    else
+    {
+      Readback();
+    }
+  }
 
   return m_values[index];
 }
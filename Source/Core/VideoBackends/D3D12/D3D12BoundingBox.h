@@ -35,6 +35,8 @@ private:
 
   bool CreateBuffers();
   void Readback();
+  void QueueReadback();
+  void ReadValues();
 
   // Three buffers: GPU for read/write, CPU for reading back, and CPU for staging changes.
   ComPtr<ID3D12Resource> m_gpu_buffer;
@@ -44,5 +46,9 @@ private:
   std::array<ValueType, NUM_VALUES> m_values = {};
   std::array<bool, NUM_VALUES> m_dirty = {};
   bool m_valid = true;
+
+  // Readback which was queued without waiting for it, see Get()
+  u64 m_readback_fence = 0;
+  bool m_readback_pending = false;
 };
 };  // namespace DX12
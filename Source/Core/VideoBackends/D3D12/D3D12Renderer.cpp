@@ -481,6 +481,7 @@ void Renderer::ExecuteCommandList(bool wait_for_completion)
   PerfQuery::GetInstance()->ResolveQueries();
   g_dx_context->ExecuteCommandList(wait_for_completion);
   m_dirty_bits = DirtyState_All;
+  m_srv_table_cache.clear();
 }
 
 void Renderer::SetConstantBuffer(u32 index, D3D12_GPU_VIRTUAL_ADDRESS address)
@@ -670,16 +671,28 @@ void Renderer::UpdateDescriptorTables()
 
 bool Renderer::UpdateSRVDescriptorTable()
 {
-  static constexpr std::array<UINT, MAX_TEXTURES> src_sizes = {1, 1, 1, 1, 1, 1, 1, 1};
-  DescriptorHandle dst_base_handle;
-  const UINT dst_handle_sizes = 8;
-  if (!g_dx_context->GetDescriptorAllocator()->Allocate(MAX_TEXTURES, &dst_base_handle))
-    return false;
+  // Games tend to switch between the same few sets of textures, so reuse a table if this set has
+  // already been written in this command list.
+  std::array<SIZE_T, MAX_TEXTURES> key;
+  for (u32 i = 0; i < MAX_TEXTURES; i++)
+    key[i] = m_state.textures[i].ptr;
+
+  auto it = m_srv_table_cache.find(key);
+  if (it == m_srv_table_cache.end())
+  {
+    static constexpr std::array<UINT, MAX_TEXTURES> src_sizes = {1, 1, 1, 1, 1, 1, 1, 1};
+    DescriptorHandle dst_base_handle;
+    const UINT dst_handle_sizes = 8;
+    if (!g_dx_context->GetDescriptorAllocator()->Allocate(MAX_TEXTURES, &dst_base_handle))
+      return false;
+
+    g_dx_context->GetDevice()->CopyDescriptors(
+        1, &dst_base_handle.cpu_handle, &dst_handle_sizes, MAX_TEXTURES, m_state.textures.data(),
+        src_sizes.data(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    it = m_srv_table_cache.emplace(key, dst_base_handle.gpu_handle).first;
+  }
 
-  g_dx_context->GetDevice()->CopyDescriptors(
-      1, &dst_base_handle.cpu_handle, &dst_handle_sizes, MAX_TEXTURES, m_state.textures.data(),
-      src_sizes.data(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-  m_state.srv_descriptor_base = dst_base_handle.gpu_handle;
+  m_state.srv_descriptor_base = it->second;
   m_dirty_bits = (m_dirty_bits & ~DirtyState_Textures) | DirtyState_SRV_Descriptor;
   return true;
 }
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <array>
 #include <d3d12.h>
+#include <map>
 #include "VideoBackends/D3D12/DescriptorAllocator.h"
 #include "VideoBackends/D3D12/DescriptorHeapManager.h"
 #include "VideoCommon/RenderBase.h"
@@ -174,5 +176,10 @@ private:
     bool using_integer_rtv = false;
   } m_state;
   u32 m_dirty_bits = DirtyState_All;
+
+  // SRV descriptor tables written to the current command list's descriptor heap, by the CPU
+  // handles of the textures in them. Descriptors are only freed once the command list is done, so
+  // the same handles refer to the same textures until then.
+  std::map<std::array<SIZE_T, MAX_TEXTURES>, D3D12_GPU_DESCRIPTOR_HANDLE> m_srv_table_cache;
 };
 }  // namespace DX12
@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLContext.h"
@@ -441,6 +442,7 @@ Renderer::Renderer(std::unique_ptr<GLContext> main_gl_context, float backbuffer_
        GLExtensions::Supports("GL_OES_copy_image")) &&
       !DriverDetails::HasBug(DriverDetails::BUG_BROKEN_COPYIMAGE);
   g_ogl_config.bSupportsTextureSubImage = GLExtensions::Supports("ARB_get_texture_sub_image");
+  g_ogl_config.bSupportsTimerQuery = GLExtensions::Supports("GL_ARB_timer_query");
 
   // Desktop OpenGL supports the binding layout if it supports 420pack
   // OpenGL ES 3.1 supports it implicitly without an extension
@@ -805,6 +807,16 @@ void Renderer::Shutdown()
 
   glDeleteFramebuffers(1, &m_shared_draw_framebuffer);
   glDeleteFramebuffers(1, &m_shared_read_framebuffer);
+
+  for (const std::vector<GLuint>& group : m_pending_timestamp_groups)
+    m_free_timestamp_queries.insert(m_free_timestamp_queries.end(), group.begin(), group.end());
+  m_free_timestamp_queries.insert(m_free_timestamp_queries.end(), m_timestamp_queries.begin(),
+                                  m_timestamp_queries.end());
+  if (!m_free_timestamp_queries.empty())
+  {
+    glDeleteQueries(static_cast<GLsizei>(m_free_timestamp_queries.size()),
+                    m_free_timestamp_queries.data());
+  }
 }
 
 std::unique_ptr<AbstractTexture> Renderer::CreateTexture(const TextureConfig& config,
@@ -1072,6 +1084,65 @@ void Renderer::WaitForGPUIdle()
   glFinish();
 }
 
+bool Renderer::SupportsGPUTimestamps() const
+{
+  return g_ogl_config.bSupportsTimerQuery;
+}
+
+void Renderer::WriteGPUTimestamp()
+{
+  if (!g_ogl_config.bSupportsTimerQuery)
+    return;
+
+  GLuint query;
+  if (!m_free_timestamp_queries.empty())
+  {
+    query = m_free_timestamp_queries.back();
+    m_free_timestamp_queries.pop_back();
+  }
+  else
+  {
+    glGenQueries(1, &query);
+  }
+
+  glQueryCounter(query, GL_TIMESTAMP);
+  m_timestamp_queries.push_back(query);
+}
+
+void Renderer::EndGPUTimestampGroup()
+{
+  m_pending_timestamp_groups.push_back(std::move(m_timestamp_queries));
+  m_timestamp_queries.clear();
+}
+
+bool Renderer::ReadGPUTimestampGroup(std::vector<u64>* timestamps)
+{
+  if (m_pending_timestamp_groups.empty())
+    return false;
+
+  // Queries complete in order, so the last one being available means the whole group is.
+  std::vector<GLuint>& group = m_pending_timestamp_groups.front();
+  if (!group.empty())
+  {
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(group.back(), GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available != GL_TRUE)
+      return false;
+  }
+
+  timestamps->resize(group.size());
+  for (size_t i = 0; i < group.size(); ++i)
+  {
+    GLuint64 result;
+    glGetQueryObjectui64v(group[i], GL_QUERY_RESULT, &result);
+    (*timestamps)[i] = result;
+  }
+
+  m_free_timestamp_queries.insert(m_free_timestamp_queries.end(), group.begin(), group.end());
+  m_pending_timestamp_groups.pop_front();
+  return true;
+}
+
 void Renderer::CheckForSurfaceChange()
 {
   if (!m_surface_changed.TestAndClear())
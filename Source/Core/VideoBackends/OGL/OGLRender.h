@@ -4,8 +4,10 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "Common/GL/GLContext.h"
 #include "Common/GL/GLExtensions/GLExtensions.h"
@@ -70,6 +72,7 @@ struct VideoConfig
   bool bSupportsTextureSubImage;
   EsFbFetchType SupportedFramebufferFetch;
   bool bSupportsShaderThreadShuffleNV;
+  bool bSupportsTimerQuery;
 
   const char* gl_vendor;
   const char* gl_renderer;
@@ -128,6 +131,11 @@ public:
   void BindBackbuffer(const ClearColor& clear_color = {}) override;
   void PresentBackbuffer() override;
 
+  bool SupportsGPUTimestamps() const override;
+  void WriteGPUTimestamp() override;
+  void EndGPUTimestampGroup() override;
+  bool ReadGPUTimestampGroup(std::vector<u64>* timestamps) override;
+
   u16 BBoxReadImpl(int index) override;
   void BBoxWriteImpl(int index, u16 value) override;
   void BBoxFlushImpl() override;
@@ -181,5 +189,11 @@ private:
   BlendingState m_current_blend_state;
   GLuint m_shared_read_framebuffer = 0;
   GLuint m_shared_draw_framebuffer = 0;
+
+  // GL_TIMESTAMP queries of the current frame, the frames waiting for their results, and the ones
+  // that can be reused.
+  std::vector<GLuint> m_timestamp_queries;
+  std::deque<std::vector<GLuint>> m_pending_timestamp_groups;
+  std::vector<GLuint> m_free_timestamp_queries;
 };
 }  // namespace OGL
@@ -318,6 +318,7 @@ public:
   ~BufferSubData() { delete[] m_pointer; }
   std::pair<u8*, u32> Map(u32 size) override { return std::make_pair(m_pointer, 0); }
   void Unmap(u32 used_size) override { glBufferSubData(m_buffertype, 0, used_size, m_pointer); }
+  bool IsRingBuffer() const override { return false; }
   u8* m_pointer;
 };
 
@@ -341,6 +342,7 @@ public:
   {
     glBufferData(m_buffertype, used_size, m_pointer, GL_STREAM_DRAW);
   }
+  bool IsRingBuffer() const override { return false; }
 
   u8* m_pointer;
 };
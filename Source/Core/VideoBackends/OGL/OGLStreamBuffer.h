@@ -22,6 +22,10 @@ public:
   u32 GetSize() const { return m_size; }
   u32 GetCurrentOffset() const { return m_iterator; }
 
+  // Whether data which was written before stays valid until the buffer wraps around. The
+  // fallbacks without base vertex support reupload everything to offset zero instead.
+  virtual bool IsRingBuffer() const { return true; }
+
   /* This mapping function will return a pair of:
    * - the pointer to the mapped buffer
    * - the offset into the real GPU buffer (always multiple of stride)
@@ -217,36 +217,57 @@ u32 ProgramShaderCache::GetUniformBufferAlignment()
 
 void ProgramShaderCache::UploadConstants()
 {
-  if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty)
-  {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
-
-    memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &VertexShaderManager::constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
+  if (!PixelShaderManager::dirty && !VertexShaderManager::dirty && !GeometryShaderManager::dirty)
+    return;
 
-    s_buffer->Unmap(s_ubo_buffer_size);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
+  // Usually only one of the blocks changes between draws, so the others are left bound to the
+  // range they were last uploaded to. That range stays untouched until the buffer wraps around,
+  // so everything gets uploaded again when this allocation could cause a wrap.
+  const u32 current_offset = Common::AlignUp(s_buffer->GetCurrentOffset(), s_ubo_align);
+  const bool upload_all = !s_buffer->IsRingBuffer() ||
+                          current_offset + s_ubo_buffer_size >= s_buffer->GetSize();
+  const bool upload_ps = upload_all || PixelShaderManager::dirty;
+  const bool upload_vs = upload_all || VertexShaderManager::dirty;
+  const bool upload_gs = upload_all || GeometryShaderManager::dirty;
+
+  const u32 ps_size = Common::AlignUp(static_cast<u32>(sizeof(PixelShaderConstants)), s_ubo_align);
+  const u32 vs_size = Common::AlignUp(static_cast<u32>(sizeof(VertexShaderConstants)), s_ubo_align);
+  const u32 gs_size =
+      Common::AlignUp(static_cast<u32>(sizeof(GeometryShaderConstants)), s_ubo_align);
+  const u32 upload_size =
+      (upload_ps ? ps_size : 0) + (upload_vs ? vs_size : 0) + (upload_gs ? gs_size : 0);
+
+  auto buffer = s_buffer->Map(upload_size, s_ubo_align);
+  u32 offset = 0;
+  if (upload_ps)
+  {
+    memcpy(buffer.first + offset, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
+    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second + offset,
                       sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
+    offset += ps_size;
+  }
+  if (upload_vs)
+  {
+    memcpy(buffer.first + offset, &VertexShaderManager::constants, sizeof(VertexShaderConstants));
+    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer, buffer.second + offset,
                       sizeof(VertexShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
+    offset += vs_size;
+  }
+  if (upload_gs)
+  {
+    memcpy(buffer.first + offset, &GeometryShaderManager::constants,
+           sizeof(GeometryShaderConstants));
+    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer, buffer.second + offset,
                       sizeof(GeometryShaderConstants));
+    offset += gs_size;
+  }
+  s_buffer->Unmap(upload_size);
 
-    PixelShaderManager::dirty = false;
-    VertexShaderManager::dirty = false;
-    GeometryShaderManager::dirty = false;
+  PixelShaderManager::dirty = false;
+  VertexShaderManager::dirty = false;
+  GeometryShaderManager::dirty = false;
 
-    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, s_ubo_buffer_size);
-  }
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, upload_size);
 }
 
 void ProgramShaderCache::UploadConstants(const void* data, u32 data_size)
@@ -0,0 +1,155 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Software/PixelMath.h"
+
+#include <cstring>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
+
+namespace PixelMath
+{
+namespace
+{
+constexpr s32 BIAS[4] = {0, 128, -128, 0};
+constexpr u32 SCALE_LSHIFT[4] = {0, 1, 2, 0};
+constexpr u32 SCALE_RSHIFT[4] = {0, 0, 0, 1};
+
+// The rounding of the lerp differs between adding and subtracting, and dividing by two doesn't
+// round at all
+s32 GetColorRounding(const TevStageCombiner::ColorCombiner& cc)
+{
+  if (cc.scale == TevScale::Divide2)
+    return 0;
+  return cc.op == TevOp::Sub ? 127 : 128;
+}
+
+std::array<u32, 4> GetBilinearWeights(s32 fract_s, s32 fract_t)
+{
+  return {static_cast<u32>((128 - fract_s) * (128 - fract_t)),
+          static_cast<u32>(fract_s * (128 - fract_t)), static_cast<u32>((128 - fract_s) * fract_t),
+          static_cast<u32>(fract_s * fract_t)};
+}
+}  // namespace
+
+void CombineColorRegularScalar(const TevStageCombiner::ColorCombiner& cc,
+                               const ColorOperands& operands, s16* result)
+{
+  const u32 scale = static_cast<u32>(cc.scale.Value());
+  const s32 bias = BIAS[static_cast<u32>(cc.bias.Value())];
+
+  for (int i = 1; i < 4; i++)
+  {
+    const s32 a = static_cast<u8>(operands.a[i]);
+    const s32 b = static_cast<u8>(operands.b[i]);
+    const s32 c8 = static_cast<u8>(operands.c[i]);
+    const s32 d = static_cast<s32>(static_cast<u32>(operands.d[i]) << 21) >> 21;
+
+    const s32 c = c8 + (c8 >> 7);
+
+    s32 temp = a * (256 - c) + (b * c);
+    temp <<= SCALE_LSHIFT[scale];
+    temp += GetColorRounding(cc);
+    temp >>= 8;
+    temp = cc.op == TevOp::Sub ? -temp : temp;
+
+    s32 value = ((d + bias) << SCALE_LSHIFT[scale]) + temp;
+    value = value >> SCALE_RSHIFT[scale];
+
+    result[i] = static_cast<s16>(value);
+  }
+}
+
+void FilterBilinearScalar(const u8 texels[4][4], s32 fract_s, s32 fract_t, u8* sample)
+{
+  const std::array<u32, 4> weights = GetBilinearWeights(fract_s, fract_t);
+
+  for (int comp = 0; comp < 4; comp++)
+  {
+    u32 value = 0;
+    for (int i = 0; i < 4; i++)
+      value += texels[i][comp] * weights[i];
+    sample[comp] = static_cast<u8>(value >> 14);
+  }
+}
+
+#if defined(_M_X86_64)
+void CombineColorRegular(const TevStageCombiner::ColorCombiner& cc, const ColorOperands& operands,
+                         s16* result)
+{
+  const u32 scale = static_cast<u32>(cc.scale.Value());
+  const __m128i lshift = _mm_cvtsi32_si128(SCALE_LSHIFT[scale]);
+  const __m128i rshift = _mm_cvtsi32_si128(SCALE_RSHIFT[scale]);
+
+  // All four components are computed in 16-bit lanes, with the products and sums in 32 bits
+  const __m128i mask8 = _mm_set1_epi16(0xFF);
+  const __m128i a = _mm_and_si128(_mm_loadl_epi64((const __m128i*)operands.a.data()), mask8);
+  const __m128i b = _mm_and_si128(_mm_loadl_epi64((const __m128i*)operands.b.data()), mask8);
+  __m128i c = _mm_and_si128(_mm_loadl_epi64((const __m128i*)operands.c.data()), mask8);
+  const __m128i d16 =
+      _mm_srai_epi16(_mm_slli_epi16(_mm_loadl_epi64((const __m128i*)operands.d.data()), 5), 5);
+
+  c = _mm_add_epi16(c, _mm_srli_epi16(c, 7));
+  const __m128i inv_c = _mm_sub_epi16(_mm_set1_epi16(256), c);
+
+  // a * (256 - c) + b * c
+  __m128i temp = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), _mm_unpacklo_epi16(inv_c, c));
+  temp = _mm_sll_epi32(temp, lshift);
+  temp = _mm_add_epi32(temp, _mm_set1_epi32(GetColorRounding(cc)));
+  temp = _mm_srai_epi32(temp, 8);
+  if (cc.op == TevOp::Sub)
+    temp = _mm_sub_epi32(_mm_setzero_si128(), temp);
+
+  const __m128i d = _mm_srai_epi32(_mm_unpacklo_epi16(d16, d16), 16);
+  const __m128i bias = _mm_set1_epi32(BIAS[static_cast<u32>(cc.bias.Value())]);
+  __m128i value = _mm_add_epi32(_mm_sll_epi32(_mm_add_epi32(d, bias), lshift), temp);
+  value = _mm_sra_epi32(value, rshift);
+
+  // The results are within 16 bits, so the saturation of the pack never applies. Merge them with
+  // the alpha component that is already in result.
+  const __m128i alpha_mask = _mm_setr_epi16(-1, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i old_result = _mm_loadl_epi64((const __m128i*)result);
+  const __m128i merged = _mm_or_si128(_mm_and_si128(alpha_mask, old_result),
+                                      _mm_andnot_si128(alpha_mask, _mm_packs_epi32(value, value)));
+  _mm_storel_epi64((__m128i*)result, merged);
+}
+
+void FilterBilinear(const u8 texels[4][4], s32 fract_s, s32 fract_t, u8* sample)
+{
+  const std::array<u32, 4> weights = GetBilinearWeights(fract_s, fract_t);
+
+  // The weights are at most 128 * 128, so pairs of texels can be blended with one 16-bit
+  // multiply-add per component
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i all_texels = _mm_loadu_si128((const __m128i*)texels);
+  const __m128i texels01 = _mm_unpacklo_epi8(all_texels, zero);
+  const __m128i texels23 = _mm_unpackhi_epi8(all_texels, zero);
+  const __m128i pairs01 = _mm_unpacklo_epi16(texels01, _mm_srli_si128(texels01, 8));
+  const __m128i pairs23 = _mm_unpacklo_epi16(texels23, _mm_srli_si128(texels23, 8));
+  const __m128i weights01 = _mm_set1_epi32(static_cast<s32>(weights[0] | (weights[1] << 16)));
+  const __m128i weights23 = _mm_set1_epi32(static_cast<s32>(weights[2] | (weights[3] << 16)));
+
+  __m128i value =
+      _mm_add_epi32(_mm_madd_epi16(pairs01, weights01), _mm_madd_epi16(pairs23, weights23));
+  value = _mm_srli_epi32(value, 14);
+  value = _mm_packs_epi32(value, value);
+  value = _mm_packus_epi16(value, value);
+
+  const u32 packed = static_cast<u32>(_mm_cvtsi128_si32(value));
+  std::memcpy(sample, &packed, sizeof(packed));
+}
+#else
+void CombineColorRegular(const TevStageCombiner::ColorCombiner& cc, const ColorOperands& operands,
+                         s16* result)
+{
+  CombineColorRegularScalar(cc, operands, result);
+}
+
+void FilterBilinear(const u8 texels[4][4], s32 fract_s, s32 fract_t, u8* sample)
+{
+  FilterBilinearScalar(texels, fract_s, fract_t, sample);
+}
+#endif
+}  // namespace PixelMath
@@ -0,0 +1,37 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+
+// Integer math of the TEV combiner and the texture sampler. The default versions use SSE2 where
+// available, the scalar versions are the reference they must match bit for bit.
+namespace PixelMath
+{
+// Operands of a colour combiner stage in Tev's component order (alpha, blue, green, red). Only the
+// colour components are combined. Like on hardware, a, b and c are used as unsigned 8-bit values
+// and d as a signed 11-bit value.
+struct ColorOperands
+{
+  std::array<s16, 4> a;
+  std::array<s16, 4> b;
+  std::array<s16, 4> c;
+  std::array<s16, 4> d;
+};
+
+// Computes a regular (not compare mode) colour stage and writes the colour components of result.
+// The alpha component of result is left untouched.
+void CombineColorRegular(const TevStageCombiner::ColorCombiner& cc, const ColorOperands& operands,
+                         s16* result);
+void CombineColorRegularScalar(const TevStageCombiner::ColorCombiner& cc,
+                               const ColorOperands& operands, s16* result);
+
+// Blends four RGBA texels, ordered (s, t), (s + 1, t), (s, t + 1) and (s + 1, t + 1), with the
+// 7-bit fractional parts of the sample location.
+void FilterBilinear(const u8 texels[4][4], s32 fract_s, s32 fract_t, u8* sample);
+void FilterBilinearScalar(const u8 texels[4][4], s32 fract_s, s32 fract_t, u8* sample);
+}  // namespace PixelMath
@@ -5,8 +5,11 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Tev.h"
@@ -20,6 +23,10 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// Triangles with a smaller bounding rectangle are drawn on the calling thread
+static constexpr s32 PARALLEL_RASTER_MIN_PIXELS = 64 * 64;
+static constexpr unsigned int MAX_RASTER_THREADS = 8;
+
 static Slope ZSlope;
 static Slope WSlope;
 static Slope ColorSlopes[2][4];
@@ -30,12 +37,27 @@ static s32 vertex0Y;
 static float vertexOffsetX;
 static float vertexOffsetY;
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// State of a thread drawing a part of the current triangle
+struct ThreadState
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+};
+
+static std::vector<std::unique_ptr<ThreadState>> s_thread_states;
+
+static Common::ThreadPool& GetThreadPool()
+{
+  static Common::ThreadPool s_pool(MAX_RASTER_THREADS);
+  return s_pool;
+}
 
 void Init()
 {
-  tev.Init();
+  // Tev keeps pointers to its own members, so the states must not move
+  s_thread_states.clear();
+  for (size_t i = 0; i < GetThreadPool().GetThreadCount(); i++)
+    s_thread_states.emplace_back(std::make_unique<ThreadState>())->tev.Init();
 
   // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the
   // first primitive.
@@ -68,12 +90,22 @@ static inline int iround(float x)
 
 void SetTevReg(int reg, int comp, s16 color)
 {
-  tev.SetRegColor(reg, comp, color);
+  for (const auto& state : s_thread_states)
+    state->tev.SetRegColor(reg, comp, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+void SetupTevStages()
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  for (const auto& state : s_thread_states)
+    state->tev.SetupStages();
+}
+
+static void Draw(ThreadState& state, s32 x, s32 y, s32 xi, s32 yi)
+{
+  Tev& tev = state.tev;
+  const RasterBlock& rasterBlock = state.rasterBlock;
+
+  tev.counters.rasterized_pixels++;
 
   float dx = vertexOffsetX + (float)(x - vertex0X);
   float dy = vertexOffsetY + (float)(y - vertex0Y);
@@ -83,17 +115,17 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   if (bpmem.UseEarlyDepthTest() && g_ActiveConfig.bZComploc)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.counters.perf_quads[PQ_ZCOMP_INPUT_ZCOMPLOC]++;
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.counters.perf_quads[PQ_ZCOMP_OUTPUT_ZCOMPLOC]++;
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -161,7 +193,8 @@ static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, fl
   slope->f0 = f1;
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
@@ -174,17 +207,17 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   float sDelta, tDelta;
   if (tm0.diag_lod == LODType::Diagonal)
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
 
     sDelta = fabsf(uv0[0] - uv1[0]);
     tDelta = fabsf(uv0[1] - uv1[1]);
   }
   else
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
-    float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
+    const float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
     sDelta = std::max(fabsf(uv0[0] - uv1[0]), fabsf(uv0[0] - uv2[0]));
     tDelta = std::max(fabsf(uv0[1] - uv1[1]), fabsf(uv0[1] - uv2[1]));
@@ -210,7 +243,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -246,7 +279,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -258,7 +292,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -387,83 +422,108 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   minx &= ~(BLOCK_SIZE - 1);
   miny &= ~(BLOCK_SIZE - 1);
 
-  // Loop through blocks
-  for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
-  {
-    for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
+  // Draws the block rows starting at first_y, advancing by y_step
+  const auto draw_block_rows = [&](ThreadState& state, s32 first_y, s32 y_step) {
+    for (s32 y = first_y; y < maxy; y += y_step)
     {
-      // Corners of block
-      s32 x0 = x << 4;
-      s32 x1 = (x + BLOCK_SIZE - 1) << 4;
-      s32 y0 = y << 4;
-      s32 y1 = (y + BLOCK_SIZE - 1) << 4;
-
-      // Evaluate half-space functions
-      bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
-      bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
-      bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
-      bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
-      int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
-
-      bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
-      bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
-      bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
-      bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
-      int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
-
-      bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
-      bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
-      bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
-      bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
-      int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
-
-      // Skip block when outside an edge
-      if (a == 0x0 || b == 0x0 || c == 0x0)
-        continue;
-
-      BuildBlock(x, y);
-
-      // Accept whole block when totally covered
-      if (a == 0xF && b == 0xF && c == 0xF)
+      for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
       {
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+        // Corners of block
+        s32 x0 = x << 4;
+        s32 x1 = (x + BLOCK_SIZE - 1) << 4;
+        s32 y0 = y << 4;
+        s32 y1 = (y + BLOCK_SIZE - 1) << 4;
+
+        // Evaluate half-space functions
+        bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
+        bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
+        bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
+        bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
+        int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
+
+        bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
+        bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
+        bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
+        bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
+        int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
+
+        bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
+        bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
+        bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
+        bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
+        int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
+
+        // Skip block when outside an edge
+        if (a == 0x0 || b == 0x0 || c == 0x0)
+          continue;
+
+        BuildBlock(state.rasterBlock, x, y);
+
+        // Accept whole block when totally covered
+        if (a == 0xF && b == 0xF && c == 0xF)
         {
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+          for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+            {
+              Draw(state, x + ix, y + iy, ix, iy);
+            }
           }
         }
-      }
-      else  // Partially covered block
-      {
-        s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
-        s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
-        s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
-
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+        else  // Partially covered block
         {
-          s32 CX1 = CY1;
-          s32 CX2 = CY2;
-          s32 CX3 = CY3;
+          s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
+          s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
+          s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
 
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+          for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
           {
-            if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+            s32 CX1 = CY1;
+            s32 CX2 = CY2;
+            s32 CX3 = CY3;
+
+            for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
             {
-              Draw(x + ix, y + iy, ix, iy);
+              if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+              {
+                Draw(state, x + ix, y + iy, ix, iy);
+              }
+
+              CX1 -= FDY12;
+              CX2 -= FDY23;
+              CX3 -= FDY31;
             }
 
-            CX1 -= FDY12;
-            CX2 -= FDY23;
-            CX3 -= FDY31;
+            CY1 += FDX12;
+            CY2 += FDX23;
+            CY3 += FDX31;
           }
-
-          CY1 += FDX12;
-          CY2 += FDX23;
-          CY3 += FDX31;
         }
       }
     }
+  };
+
+  // Every pixel of a triangle is drawn at most once, so the block rows can be drawn in parallel
+  // without changing the output. Each thread draws an interleaved set of rows with its own Tev.
+  // The TEV stage dumps share global buffers and are always drawn on one thread.
+  const size_t block_rows = static_cast<size_t>((maxy - miny + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  const bool parallel = (maxx - minx) * (maxy - miny) >= PARALLEL_RASTER_MIN_PIXELS &&
+                        !g_ActiveConfig.bDumpTevStages && !g_ActiveConfig.bDumpTevTextureFetches;
+  const size_t jobs = parallel ? std::min(block_rows, s_thread_states.size()) : 1;
+
+  if (jobs == 1)
+  {
+    draw_block_rows(*s_thread_states[0], miny, BLOCK_SIZE);
+  }
+  else
+  {
+    GetThreadPool().Run(jobs, [&](size_t job) {
+      draw_block_rows(*s_thread_states[job], miny + static_cast<s32>(job) * BLOCK_SIZE,
+                      static_cast<s32>(jobs) * BLOCK_SIZE);
+    });
   }
+
+  for (size_t i = 0; i < jobs; i++)
+    s_thread_states[i]->tev.FlushCounters();
 }
 }  // namespace Rasterizer
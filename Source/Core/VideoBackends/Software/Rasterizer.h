@@ -15,6 +15,8 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
                            const OutputVertexData* v2);
 
 void SetTevReg(int reg, int comp, s16 color);
+// Needs to be called before drawing whenever the TEV stages may have changed
+void SetupTevStages();
 
 struct Slope
 {
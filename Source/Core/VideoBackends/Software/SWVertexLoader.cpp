@@ -63,6 +63,7 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     Rasterizer::SetTevReg(i, Tev::BLU_C, PixelShaderManager::constants.kcolors[i][2]);
     Rasterizer::SetTevReg(i, Tev::ALP_C, PixelShaderManager::constants.kcolors[i][3]);
   }
+  Rasterizer::SetupTevStages();
 
   for (u32 i = 0; i < m_index_generator.GetIndexLen(); i++)
   {
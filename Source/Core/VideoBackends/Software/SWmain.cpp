@@ -83,6 +83,7 @@ void VideoSoftware::InitBackendInfo()
   g_Config.backend_info.bSupportsLogicOp = true;
   g_Config.backend_info.bSupportsShaderBinaries = false;
   g_Config.backend_info.bSupportsPipelineCacheData = false;
+  g_Config.backend_info.bSkipsDraws = false;
 
   // aamodes
   g_Config.backend_info.AAModes = {1};
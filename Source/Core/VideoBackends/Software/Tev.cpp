@@ -11,6 +11,7 @@
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Software/DebugUtil.h"
 #include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/PixelMath.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/BoundingBox.h"
@@ -172,28 +173,26 @@ static inline s16 Clamp1024(s16 in)
   return in > 1023 ? 1023 : (in < -1024 ? -1024 : in);
 }
 
-void Tev::SetRasColor(RasColorChan colorChan, int swaptable)
+void Tev::SetRasColor(RasColorChan colorChan, const u8 swap[4])
 {
   switch (colorChan)
   {
   case RasColorChan::Color0:
   {
     const u8* color = Color[0];
-    RasColor[RED_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
-    swaptable++;
-    RasColor[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
+    RasColor[RED_C] = color[swap[RED_C]];
+    RasColor[GRN_C] = color[swap[GRN_C]];
+    RasColor[BLU_C] = color[swap[BLU_C]];
+    RasColor[ALP_C] = color[swap[ALP_C]];
   }
   break;
   case RasColorChan::Color1:
   {
     const u8* color = Color[1];
-    RasColor[RED_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
-    swaptable++;
-    RasColor[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
+    RasColor[RED_C] = color[swap[RED_C]];
+    RasColor[GRN_C] = color[swap[GRN_C]];
+    RasColor[BLU_C] = color[swap[BLU_C]];
+    RasColor[ALP_C] = color[swap[ALP_C]];
   }
   break;
   case RasColorChan::AlphaBump:
@@ -227,29 +226,6 @@ void Tev::SetRasColor(RasColorChan colorChan, int swaptable)
   }
 }
 
-void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
-{
-  for (int i = BLU_C; i <= RED_C; i++)
-  {
-    const InputRegType& InputReg = inputs[i];
-
-    const u16 c = InputReg.c + (InputReg.c >> 7);
-
-    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-    temp <<= m_ScaleLShiftLUT[u32(cc.scale.Value())];
-    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
-    temp >>= 8;
-    temp = cc.op == TevOp::Sub ? -temp : temp;
-
-    s32 result = ((InputReg.d + m_BiasLUT[u32(cc.bias.Value())])
-                  << m_ScaleLShiftLUT[u32(cc.scale.Value())]) +
-                 temp;
-    result = result >> m_ScaleRShiftLUT[u32(cc.scale.Value())];
-
-    Reg[u32(cc.dest.Value())][i] = result;
-  }
-}
-
 void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
 {
   for (int i = BLU_C; i <= RED_C; i++)
@@ -543,7 +519,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  counters.tev_pixels_in++;
 
   // initial color values
   for (int i = 0; i < 4; i++)
@@ -590,27 +566,14 @@ void Tev::Draw()
 
   for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
   {
-    const int stageNum2 = stageNum >> 1;
-    const int stageOdd = stageNum & 1;
-    const TwoTevStageOrders& order = bpmem.tevorders[stageNum2];
-    const TevKSel& kSel = bpmem.tevksel[stageNum2];
+    const StageState& stage = m_stages[stageNum];
+    const TevStageCombiner::ColorCombiner& cc = stage.cc;
+    const TevStageCombiner::AlphaCombiner& ac = stage.ac;
 
-    // stage combiners
-    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stageNum].colorC;
-    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
-
-    u32 texcoordSel = order.getTexCoord(stageOdd);
-    const u32 texmap = order.getTexMap(stageOdd);
-
-    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
-    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
-
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
+    Indirect(stageNum, Uv[stage.texcoord].s, Uv[stage.texcoord].t);
 
     // sample texture
-    if (order.getEnable(stageOdd))
+    if (stage.texture_enabled)
     {
       // RGBA
       u8 texel[4];
@@ -618,7 +581,7 @@ void Tev::Draw()
       if (bpmem.genMode.numtexgens > 0)
       {
         TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
+                               TextureLinear[stageNum], stage.texmap, texel);
       }
       else
       {
@@ -632,56 +595,69 @@ void Tev::Draw()
         DebugUtil::DrawTempBuffer(texel, DIRECT_TFETCH + stageNum);
 #endif
 
-      int swaptable = ac.tswap * 2;
-
-      TexColor[RED_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[GRN_C] = texel[bpmem.tevksel[swaptable].swap2];
-      swaptable++;
-      TexColor[BLU_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[ALP_C] = texel[bpmem.tevksel[swaptable].swap2];
+      TexColor[RED_C] = texel[stage.tex_swap[RED_C]];
+      TexColor[GRN_C] = texel[stage.tex_swap[GRN_C]];
+      TexColor[BLU_C] = texel[stage.tex_swap[BLU_C]];
+      TexColor[ALP_C] = texel[stage.tex_swap[ALP_C]];
     }
 
     // set konst for this stage
-    const auto kc = u32(kSel.getKC(stageOdd));
-    const auto ka = u32(kSel.getKA(stageOdd));
-    StageKonst[RED_C] = *(m_KonstLUT[kc][RED_C]);
-    StageKonst[GRN_C] = *(m_KonstLUT[kc][GRN_C]);
-    StageKonst[BLU_C] = *(m_KonstLUT[kc][BLU_C]);
-    StageKonst[ALP_C] = *(m_KonstLUT[ka][ALP_C]);
+    StageKonst[RED_C] = *stage.konst[RED_C];
+    StageKonst[GRN_C] = *stage.konst[GRN_C];
+    StageKonst[BLU_C] = *stage.konst[BLU_C];
+    StageKonst[ALP_C] = *stage.konst[ALP_C];
 
     // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap * 2);
+    SetRasColor(stage.ras_chan, stage.ras_swap);
 
     // combine inputs
     InputRegType inputs[4];
-    for (int i = 0; i < 3; i++)
+    inputs[ALP_C].a = *stage.alpha_inputs[0];
+    inputs[ALP_C].b = *stage.alpha_inputs[1];
+    inputs[ALP_C].c = *stage.alpha_inputs[2];
+    inputs[ALP_C].d = *stage.alpha_inputs[3];
+
+    // The compare modes of both combiners read the colour inputs
+    if (cc.bias == TevBias::Compare || ac.bias == TevBias::Compare)
     {
-      inputs[BLU_C + i].a = *m_ColorInputLUT[u32(cc.a.Value())][i];
-      inputs[BLU_C + i].b = *m_ColorInputLUT[u32(cc.b.Value())][i];
-      inputs[BLU_C + i].c = *m_ColorInputLUT[u32(cc.c.Value())][i];
-      inputs[BLU_C + i].d = *m_ColorInputLUT[u32(cc.d.Value())][i];
+      for (int i = 0; i < 3; i++)
+      {
+        inputs[BLU_C + i].a = *stage.color_inputs[0][i];
+        inputs[BLU_C + i].b = *stage.color_inputs[1][i];
+        inputs[BLU_C + i].c = *stage.color_inputs[2][i];
+        inputs[BLU_C + i].d = *stage.color_inputs[3][i];
+      }
     }
-    inputs[ALP_C].a = *m_AlphaInputLUT[u32(ac.a.Value())];
-    inputs[ALP_C].b = *m_AlphaInputLUT[u32(ac.b.Value())];
-    inputs[ALP_C].c = *m_AlphaInputLUT[u32(ac.c.Value())];
-    inputs[ALP_C].d = *m_AlphaInputLUT[u32(ac.d.Value())];
 
     if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
+    {
+      PixelMath::ColorOperands operands{};
+      for (int i = 0; i < 3; i++)
+      {
+        operands.a[BLU_C + i] = *stage.color_inputs[0][i];
+        operands.b[BLU_C + i] = *stage.color_inputs[1][i];
+        operands.c[BLU_C + i] = *stage.color_inputs[2][i];
+        operands.d[BLU_C + i] = *stage.color_inputs[3][i];
+      }
+      PixelMath::CombineColorRegular(cc, operands, stage.color_dest);
+    }
     else
+    {
       DrawColorCompare(cc, inputs);
+    }
 
+    s16* const color_dest = stage.color_dest;
     if (cc.clamp)
     {
-      Reg[u32(cc.dest.Value())][RED_C] = Clamp255(Reg[u32(cc.dest.Value())][RED_C]);
-      Reg[u32(cc.dest.Value())][GRN_C] = Clamp255(Reg[u32(cc.dest.Value())][GRN_C]);
-      Reg[u32(cc.dest.Value())][BLU_C] = Clamp255(Reg[u32(cc.dest.Value())][BLU_C]);
+      color_dest[RED_C] = Clamp255(color_dest[RED_C]);
+      color_dest[GRN_C] = Clamp255(color_dest[GRN_C]);
+      color_dest[BLU_C] = Clamp255(color_dest[BLU_C]);
     }
     else
     {
-      Reg[u32(cc.dest.Value())][RED_C] = Clamp1024(Reg[u32(cc.dest.Value())][RED_C]);
-      Reg[u32(cc.dest.Value())][GRN_C] = Clamp1024(Reg[u32(cc.dest.Value())][GRN_C]);
-      Reg[u32(cc.dest.Value())][BLU_C] = Clamp1024(Reg[u32(cc.dest.Value())][BLU_C]);
+      color_dest[RED_C] = Clamp1024(color_dest[RED_C]);
+      color_dest[GRN_C] = Clamp1024(color_dest[GRN_C]);
+      color_dest[BLU_C] = Clamp1024(color_dest[BLU_C]);
     }
 
     if (ac.bias != TevBias::Compare)
@@ -690,9 +666,9 @@ void Tev::Draw()
       DrawAlphaCompare(ac, inputs);
 
     if (ac.clamp)
-      Reg[u32(ac.dest.Value())][ALP_C] = Clamp255(Reg[u32(ac.dest.Value())][ALP_C]);
+      *stage.alpha_dest = Clamp255(*stage.alpha_dest);
     else
-      Reg[u32(ac.dest.Value())][ALP_C] = Clamp1024(Reg[u32(ac.dest.Value())][ALP_C]);
+      *stage.alpha_dest = Clamp1024(*stage.alpha_dest);
 
 #if ALLOW_TEV_DUMPS
     if (g_ActiveConfig.bDumpTevStages)
@@ -829,18 +805,20 @@ void Tev::Draw()
   if (late_ztest && bpmem.zmode.testenable)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    counters.perf_quads[PQ_ZCOMP_INPUT]++;
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    counters.perf_quads[PQ_ZCOMP_OUTPUT]++;
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BoundingBox::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  counters.bbox_left = std::min(counters.bbox_left, static_cast<u16>(Position[0] & ~1));
+  counters.bbox_right = std::max(counters.bbox_right, static_cast<u16>(Position[0] | 1));
+  counters.bbox_top = std::min(counters.bbox_top, static_cast<u16>(Position[1] & ~1));
+  counters.bbox_bottom = std::max(counters.bbox_bottom, static_cast<u16>(Position[1] | 1));
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
@@ -862,12 +840,97 @@ void Tev::Draw()
   }
 #endif
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  counters.tev_pixels_out++;
+  counters.perf_quads[PQ_BLEND_INPUT]++;
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
 
+void Tev::SetupStages()
+{
+  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
+  {
+    StageState& stage = m_stages[stageNum];
+
+    const int stageNum2 = stageNum >> 1;
+    const int stageOdd = stageNum & 1;
+    const TwoTevStageOrders& order = bpmem.tevorders[stageNum2];
+    const TevKSel& kSel = bpmem.tevksel[stageNum2];
+
+    // stage combiners
+    stage.cc.hex = bpmem.combiners[stageNum].colorC.hex;
+    stage.ac.hex = bpmem.combiners[stageNum].alphaC.hex;
+    const TevStageCombiner::ColorCombiner& cc = stage.cc;
+    const TevStageCombiner::AlphaCombiner& ac = stage.ac;
+
+    stage.texcoord = order.getTexCoord(stageOdd);
+    stage.texmap = order.getTexMap(stageOdd);
+
+    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
+    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
+    if (stage.texcoord >= bpmem.genMode.numtexgens)
+      stage.texcoord = 0;
+
+    stage.texture_enabled = order.getEnable(stageOdd) != 0;
+
+    const int tex_swaptable = ac.tswap * 2;
+    stage.tex_swap[RED_C] = bpmem.tevksel[tex_swaptable].swap1;
+    stage.tex_swap[GRN_C] = bpmem.tevksel[tex_swaptable].swap2;
+    stage.tex_swap[BLU_C] = bpmem.tevksel[tex_swaptable + 1].swap1;
+    stage.tex_swap[ALP_C] = bpmem.tevksel[tex_swaptable + 1].swap2;
+
+    const int ras_swaptable = ac.rswap * 2;
+    stage.ras_swap[RED_C] = bpmem.tevksel[ras_swaptable].swap1;
+    stage.ras_swap[GRN_C] = bpmem.tevksel[ras_swaptable].swap2;
+    stage.ras_swap[BLU_C] = bpmem.tevksel[ras_swaptable + 1].swap1;
+    stage.ras_swap[ALP_C] = bpmem.tevksel[ras_swaptable + 1].swap2;
+    stage.ras_chan = order.getColorChan(stageOdd);
+
+    const auto kc = u32(kSel.getKC(stageOdd));
+    const auto ka = u32(kSel.getKA(stageOdd));
+    stage.konst[RED_C] = m_KonstLUT[kc][RED_C];
+    stage.konst[GRN_C] = m_KonstLUT[kc][GRN_C];
+    stage.konst[BLU_C] = m_KonstLUT[kc][BLU_C];
+    stage.konst[ALP_C] = m_KonstLUT[ka][ALP_C];
+
+    for (int i = 0; i < 3; i++)
+    {
+      stage.color_inputs[0][i] = m_ColorInputLUT[u32(cc.a.Value())][i];
+      stage.color_inputs[1][i] = m_ColorInputLUT[u32(cc.b.Value())][i];
+      stage.color_inputs[2][i] = m_ColorInputLUT[u32(cc.c.Value())][i];
+      stage.color_inputs[3][i] = m_ColorInputLUT[u32(cc.d.Value())][i];
+    }
+    stage.alpha_inputs[0] = m_AlphaInputLUT[u32(ac.a.Value())];
+    stage.alpha_inputs[1] = m_AlphaInputLUT[u32(ac.b.Value())];
+    stage.alpha_inputs[2] = m_AlphaInputLUT[u32(ac.c.Value())];
+    stage.alpha_inputs[3] = m_AlphaInputLUT[u32(ac.d.Value())];
+
+    stage.color_dest = Reg[u32(cc.dest.Value())];
+    stage.alpha_dest = &Reg[u32(ac.dest.Value())][ALP_C];
+  }
+}
+
+void Tev::FlushCounters()
+{
+  ADDSTAT(g_stats.this_frame.rasterized_pixels, counters.rasterized_pixels);
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, counters.tev_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, counters.tev_pixels_out);
+
+  for (u32 i = 0; i < PQ_NUM_MEMBERS; ++i)
+  {
+    if (counters.perf_quads[i] != 0)
+      EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i), counters.perf_quads[i]);
+  }
+
+  if (counters.bbox_left <= counters.bbox_right)
+  {
+    BoundingBox::Update(counters.bbox_left, counters.bbox_right, counters.bbox_top,
+                        counters.bbox_bottom);
+  }
+
+  counters = {};
+}
+
 void Tev::SetRegColor(int reg, int comp, s16 color)
 {
   KonstantColors[reg][comp] = color;
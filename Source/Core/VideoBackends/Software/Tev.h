@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <array>
+
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -56,9 +60,28 @@ class Tev
     INDIRECT = 32
   };
 
-  void SetRasColor(RasColorChan colorChan, int swaptable);
+  // State of a TEV stage, decoded from bpmem once per batch so that the per-pixel loop doesn't
+  // have to go through the register fields
+  struct StageState
+  {
+    TevStageCombiner::ColorCombiner cc;
+    TevStageCombiner::AlphaCombiner ac;
+    const s16* color_inputs[4][3];  // a, b, c and d for each colour component
+    const s16* alpha_inputs[4];     // a, b, c and d
+    const s16* konst[4];
+    s16* color_dest;
+    s16* alpha_dest;
+    u32 texcoord;
+    u32 texmap;
+    bool texture_enabled;
+    RasColorChan ras_chan;
+    u8 tex_swap[4];
+    u8 ras_swap[4];
+  };
+  StageState m_stages[16];
+
+  void SetRasColor(RasColorChan colorChan, const u8 swap[4]);
 
-  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
@@ -82,9 +105,31 @@ public:
     RED_C
   };
 
+  // Statistics, performance counter quads and bounding box extents of the pixels drawn since the
+  // last FlushCounters(). They are gathered per instance so that several instances can draw
+  // different pixels of a primitive on separate threads.
+  struct Counters
+  {
+    u32 rasterized_pixels = 0;
+    u32 tev_pixels_in = 0;
+    u32 tev_pixels_out = 0;
+    std::array<u32, PQ_NUM_MEMBERS> perf_quads{};
+    u16 bbox_left = 0xFFFF;
+    u16 bbox_right = 0;
+    u16 bbox_top = 0xFFFF;
+    u16 bbox_bottom = 0;
+  };
+  Counters counters;
+
   void Init();
 
   void Draw();
 
+  // Decodes the TEV stages from bpmem, needs to be called whenever they may have changed.
+  void SetupStages();
+
+  // Applies and resets the counters.
+  void FlushCounters();
+
   void SetRegColor(int reg, int comp, s16 color);
 };
@@ -13,6 +13,7 @@
 #include "VideoBackends/Vulkan/VKBoundingBox.h"
 #include "VideoBackends/Vulkan/VKRenderer.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace Vulkan
 {
@@ -67,8 +68,7 @@ void BoundingBox::Flush()
       if (!m_values_dirty[start + count])
         break;
 
-      m_readback_buffer->Read((start + count) * sizeof(s32), &write_values[count], sizeof(s32),
-                              false);
+      write_values[count] = m_values[start + count];
       m_values_dirty[start + count] = false;
     }
 
@@ -118,29 +118,36 @@ s32 BoundingBox::Get(size_t index)
   ASSERT(index < NUM_VALUES);
 
   if (!m_valid)
-    Readback();
+  {
+    if (g_ActiveConfig.bBBoxDeferReadback)
+    {
+      // Return the values of the previous readback, which has most likely completed by now, and
+      // start another one which the next invalidated read picks up.
+      if (m_readback_pending)
+        ReadValues();
+      QueueReadback();
+      Renderer::GetInstance()->ExecuteCommandBuffer(true, false);
+      m_valid = true;
+    }
+    else
+    {
+      Readback();
+    }
+  }
 
-  s32 value;
-  m_readback_buffer->Read(index * sizeof(s32), &value, sizeof(value), false);
-  return value;
+  return m_values[index];
 }
 
 void BoundingBox::Set(size_t index, s32 value)
 {
   ASSERT(index < NUM_VALUES);
 
-  // If we're currently valid, update the stored value in both our cache and the GPU buffer.
-  if (m_valid)
-  {
-    // Skip when it hasn't changed.
-    s32 current_value;
-    m_readback_buffer->Read(index * sizeof(s32), &current_value, sizeof(current_value), false);
-    if (current_value == value)
-      return;
-  }
+  // If we're currently valid, skip when the value hasn't changed.
+  if (m_valid && m_values[index] == value)
+    return;
 
   // Flag as dirty, and update values.
-  m_readback_buffer->Write(index * sizeof(s32), &value, sizeof(value), true);
+  m_values[index] = value;
   m_values_dirty[index] = true;
 }
 
@@ -216,6 +223,16 @@ bool BoundingBox::CreateReadbackBuffer()
 }
 
 void BoundingBox::Readback()
+{
+  QueueReadback();
+
+  // Wait until these commands complete.
+  Renderer::GetInstance()->ExecuteCommandBuffer(false, true);
+  ReadValues();
+  m_valid = true;
+}
+
+void BoundingBox::QueueReadback()
 {
   // Can't be done within a render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -242,12 +259,27 @@ void BoundingBox::Readback()
   m_readback_buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
-  // Wait until these commands complete.
-  Renderer::GetInstance()->ExecuteCommandBuffer(false, true);
+  m_readback_fence_counter = g_command_buffer_mgr->GetCurrentFenceCounter();
+  m_readback_pending = true;
+}
 
-  // Cache is now valid.
-  m_readback_buffer->InvalidateCPUCache();
-  m_valid = true;
+void BoundingBox::ReadValues()
+{
+  // The copy has to be submitted before it can be waited for.
+  if (m_readback_fence_counter == g_command_buffer_mgr->GetCurrentFenceCounter())
+    Renderer::GetInstance()->ExecuteCommandBuffer(false, false);
+  g_command_buffer_mgr->WaitForFenceCounter(m_readback_fence_counter);
+
+  std::array<s32, NUM_VALUES> new_values;
+  m_readback_buffer->Read(0, new_values.data(), BUFFER_SIZE, true);
+
+  // Preserve dirty values, they haven't been written to the GPU buffer yet.
+  for (size_t i = 0; i < NUM_VALUES; i++)
+  {
+    if (!m_values_dirty[i])
+      m_values[i] = new_values[i];
+  }
+  m_readback_pending = false;
 }
 
 }  // namespace Vulkan
@@ -33,6 +33,8 @@ private:
   bool CreateGPUBuffer();
   bool CreateReadbackBuffer();
   void Readback();
+  void QueueReadback();
+  void ReadValues();
 
   VkBuffer m_gpu_buffer = VK_NULL_HANDLE;
   VkDeviceMemory m_gpu_memory = VK_NULL_HANDLE;
@@ -41,8 +43,13 @@ private:
   static const size_t BUFFER_SIZE = sizeof(u32) * NUM_VALUES;
 
   std::unique_ptr<StagingBuffer> m_readback_buffer;
+  std::array<s32, NUM_VALUES> m_values = {};
   std::array<bool, NUM_VALUES> m_values_dirty = {};
   bool m_valid = true;
+
+  // Readback which was queued without waiting for it, see Get()
+  u64 m_readback_fence_counter = 0;
+  bool m_readback_pending = false;
 };
 
 }  // namespace Vulkan
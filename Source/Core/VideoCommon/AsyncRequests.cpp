@@ -150,7 +150,7 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
 
   case Event::SWAP_EVENT:
     g_renderer->Swap(e.swap_event.xfbAddr, e.swap_event.fbWidth, e.swap_event.fbStride,
-                     e.swap_event.fbHeight, e.time);
+                     e.swap_event.fbHeight, e.time, e.swap_event.output_time_us);
     break;
 
   case Event::BBOX_READ:
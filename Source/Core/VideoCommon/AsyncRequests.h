@@ -54,6 +54,8 @@ public:
         u32 fbWidth;
         u32 fbStride;
         u32 fbHeight;
+        // Host time at which the CPU thread output the frame, for the latency display
+        u64 output_time_us;
       } swap_event;
 
       struct
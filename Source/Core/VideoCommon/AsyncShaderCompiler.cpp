@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "VideoCommon/AsyncShaderCompiler.h"
+#include <algorithm>
 #include <thread>
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
@@ -36,6 +37,20 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   }
 }
 
+void AsyncShaderCompiler::PromoteWorkItem(const WorkItem* item, u32 priority)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  const auto iter = std::find_if(m_pending_work.begin(), m_pending_work.end(),
+                                 [item](const auto& it) { return it.second.get() == item; });
+  if (iter == m_pending_work.end() || iter->first <= priority)
+    return;
+
+  // Items of the same priority stay in the order they were queued in.
+  auto node = m_pending_work.extract(iter);
+  node.key() = priority;
+  m_pending_work.insert(std::move(node));
+}
+
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
   std::deque<WorkItemPtr> completed_work;
@@ -57,6 +72,12 @@ bool AsyncShaderCompiler::HasPendingWork()
   return !m_pending_work.empty() || m_busy_workers.load() != 0;
 }
 
+size_t AsyncShaderCompiler::GetPendingWorkCount()
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  return m_pending_work.size() + m_busy_workers.load();
+}
+
 bool AsyncShaderCompiler::HasCompletedWork()
 {
   std::lock_guard<std::mutex> guard(m_completed_work_lock);
@@ -193,6 +214,7 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
+  Common::ApplyThreadRole(Common::ThreadRole::Background);
 
   // Initialize worker thread with backend-specific method.
   if (!WorkerThreadInitWorkerThread(param))
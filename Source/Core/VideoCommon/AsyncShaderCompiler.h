@@ -45,8 +45,13 @@ public:
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
   // this work item will be compiled, relative to the other work items.
   void QueueWorkItem(WorkItemPtr item, u32 priority);
+  // Moves a queued work item ahead of the ones with a higher priority value. Nothing happens if it
+  // is already being compiled or has completed.
+  void PromoteWorkItem(const WorkItem* item, u32 priority);
   void RetrieveWorkItems();
   bool HasPendingWork();
+  // Work items which are queued or being compiled
+  size_t GetPendingWorkCount();
   bool HasCompletedWork();
 
   // Simpler version without progress updates.
@@ -36,7 +36,7 @@ void SetGenerationMode()
   g_vertex_manager->SetRasterizationStateChanged();
 }
 
-void SetScissor()
+MathUtil::Rectangle<int> GetScissorRect()
 {
   /* NOTE: the minimum value here for the scissor rect is -342.
    * GX SDK functions internally add an offset of 342 to scissor coords to
@@ -65,8 +65,12 @@ void SetScissor()
   MathUtil::Rectangle<int> native_rc(bpmem.scissorTL.x - xoff, bpmem.scissorTL.y - yoff,
                                      bpmem.scissorBR.x - xoff + 1, bpmem.scissorBR.y - yoff + 1);
   native_rc.ClampUL(0, 0, EFB_WIDTH, EFB_HEIGHT);
+  return native_rc;
+}
 
-  auto target_rc = g_renderer->ConvertEFBRectangle(native_rc);
+void SetScissor()
+{
+  auto target_rc = g_renderer->ConvertEFBRectangle(GetScissorRect());
   auto converted_rc =
       g_renderer->ConvertFramebufferRectangle(target_rc, g_renderer->GetCurrentFramebuffer());
   g_renderer->SetScissorRect(converted_rc);
@@ -214,6 +218,7 @@ void ClearScreen(const MathUtil::Rectangle<int>& rc)
       color = RGBA8ToRGB565ToRGBA8(color);
       z = Z24ToZ16ToZ24(z);
     }
+    g_framebuffer_manager->OnEFBClear(rc, colorEnable, alphaEnable);
     g_renderer->ClearScreen(rc, colorEnable, alphaEnable, zEnable, color, z);
   }
 }
@@ -15,6 +15,8 @@ namespace BPFunctions
 {
 void FlushPipeline();
 void SetGenerationMode();
+// The native EFB rectangle draws are scissored to.
+MathUtil::Rectangle<int> GetScissorRect();
 void SetScissor();
 void SetViewport();
 void SetDepthMode();
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 
@@ -13,6 +14,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Tracing.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -24,6 +26,8 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -33,6 +37,10 @@ namespace Fifo
 static constexpr u32 FIFO_SIZE = 2 * 1024 * 1024;
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
 
+// The pointers and counters written by one thread and polled by the other get a cache line each,
+// so that the writes of one thread don't evict the lines the other one keeps reading.
+static constexpr size_t CACHE_LINE_SIZE = 64;
+
 static Common::BlockingLoop s_gpu_mainloop;
 
 static Common::Flag s_emu_running_state;
@@ -51,9 +59,9 @@ static CoreTiming::EventType* s_event_sync_gpu;
 // STATE_TO_SAVE
 static u8* s_video_buffer;
 static u8* s_video_buffer_read_ptr;
-static std::atomic<u8*> s_video_buffer_write_ptr;
-static std::atomic<u8*> s_video_buffer_seen_ptr;
-static u8* s_video_buffer_pp_read_ptr;
+alignas(CACHE_LINE_SIZE) static std::atomic<u8*> s_video_buffer_write_ptr;
+alignas(CACHE_LINE_SIZE) static std::atomic<u8*> s_video_buffer_seen_ptr;
+alignas(CACHE_LINE_SIZE) static u8* s_video_buffer_pp_read_ptr;
 // The read_ptr is always owned by the GPU thread.  In normal mode, so is the
 // write_ptr, despite it being atomic.  In deterministic GPU thread mode,
 // things get a bit more complicated:
@@ -66,7 +74,7 @@ static u8* s_video_buffer_pp_read_ptr;
 // polls, it's just atomic.
 // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
-static std::atomic<int> s_sync_ticks;
+alignas(CACHE_LINE_SIZE) static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
 
@@ -307,6 +315,7 @@ void RunGpuLoop()
         if (!s_emu_running_state.IsSet())
           return;
 
+        TRACE_SCOPE("Fifo::RunGpuLoop");
         if (s_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
@@ -366,6 +375,8 @@ void RunGpuLoop()
             {
               cyclesExecuted = (int)(cyclesExecuted / param.fSyncGpuOverclock);
               int old = s_sync_ticks.fetch_sub(cyclesExecuted);
+              g_stats.this_frame.max_gpu_sync_distance =
+                  std::max(g_stats.this_frame.max_gpu_sync_distance, old);
               if (old >= param.iSyncGpuMaxDistance &&
                   old - (int)cyclesExecuted < param.iSyncGpuMaxDistance)
                 s_sync_wakeup_event.Set();
@@ -412,6 +423,11 @@ void GpuMaySleep()
   s_gpu_mainloop.AllowSleep();
 }
 
+u64 GetGpuTimeSleptUs()
+{
+  return s_gpu_mainloop.GetTimeSleptUs();
+}
+
 bool AtBreakpoint()
 {
   CommandProcessor::SCPFifoStruct& fifo = CommandProcessor::fifo;
@@ -463,6 +479,7 @@ static int RunGpuOnCpu(int ticks)
         FPURoundMode::SaveSIMDState();
         FPURoundMode::LoadDefaultSIMDState();
         reset_simd_state = true;
+        g_texture_cache->BeginTextureHashReuse();
       }
       ReadDataFromFifo(fifo.CPReadPointer.load(std::memory_order_relaxed));
       u32 cycles = 0;
@@ -489,6 +506,7 @@ static int RunGpuOnCpu(int ticks)
 
   if (reset_simd_state)
   {
+    g_texture_cache->EndTextureHashReuse();
     FPURoundMode::LoadSIMDState();
   }
 
@@ -42,6 +42,9 @@ void* PopFifoAuxBuffer(size_t size);
 void FlushGpu();
 void RunGpu();
 void GpuMaySleep();
+// Host time the GPU thread has spent sleeping since Dolphin was started, can be called from any
+// thread. Only meaningful in dual core mode.
+u64 GetGpuTimeSleptUs();
 void RunGpuLoop();
 void ExitGpuLoop();
 void EmulatorState(bool running);
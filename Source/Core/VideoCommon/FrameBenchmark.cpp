@@ -0,0 +1,169 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameBenchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+#include "Core/CoreTiming.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "VideoCommon/VideoBackendBase.h"
+
+namespace FrameBenchmark
+{
+struct FrameSample
+{
+  // Host time since the previous presented frame
+  u64 time_us;
+  int draw_calls;
+  int primitives;
+  int pipeline_compile_stalls;
+  int pipeline_compile_stall_us;
+  int async_pipeline_misses;
+};
+
+// Running totals, which are compared between the first and the last recorded frame
+struct Counters
+{
+  u64 ticks;
+  u64 idle_ticks;
+  JitInterface::CompileStats jit;
+  int shaders_created;
+};
+
+static Counters GetCounters()
+{
+  return {CoreTiming::GetTicks(), CoreTiming::GetIdleTicks(), JitInterface::GetCompileStats(),
+          g_stats.num_vertex_shaders_created + g_stats.num_pixel_shaders_created};
+}
+
+static std::mutex s_mutex;
+static std::atomic<bool> s_active{false};
+static std::optional<u64> s_last_frame_time_us;
+static std::vector<FrameSample> s_samples;
+static Counters s_first_counters;
+static Counters s_last_counters;
+
+void Start()
+{
+  std::lock_guard lk(s_mutex);
+  s_last_frame_time_us.reset();
+  s_samples.clear();
+  s_active.store(true);
+}
+
+bool IsActive()
+{
+  return s_active.load(std::memory_order_relaxed);
+}
+
+void OnFramePresented(const Statistics::ThisFrame& stats)
+{
+  const u64 now_us = Common::Timer::GetTimeUs();
+  // Read on the GPU thread while the CPU thread runs, like the extended FPS display of Core does
+  const Counters counters = GetCounters();
+
+  std::lock_guard lk(s_mutex);
+  if (!s_active.load())
+    return;
+
+  // The first frame only provides the starting point for the frame times
+  if (s_last_frame_time_us)
+  {
+    s_samples.push_back({now_us - *s_last_frame_time_us, stats.num_draw_calls,
+                         stats.num_prims + stats.num_dl_prims, stats.num_pipeline_compile_stalls,
+                         stats.pipeline_compile_stall_us, stats.num_async_pipeline_misses});
+  }
+  else
+  {
+    s_first_counters = counters;
+  }
+  s_last_frame_time_us = now_us;
+  s_last_counters = counters;
+}
+
+// Nearest-rank percentile of sorted values
+template <typename T>
+static T Percentile(const std::vector<T>& sorted, double percent)
+{
+  const size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+std::string Stop()
+{
+  std::lock_guard lk(s_mutex);
+  s_active.store(false);
+
+  const std::string backend = g_video_backend ? g_video_backend->GetName() : "";
+  if (s_samples.empty())
+    return fmt::format("{{\"backend\": \"{}\", \"frames\": 0}}", backend);
+
+  std::vector<double> frame_ms;
+  std::vector<int> draw_calls;
+  u64 total_us = 0;
+  u64 primitives = 0;
+  u64 compile_stalls = 0;
+  u64 compile_stall_us = 0;
+  u64 async_misses = 0;
+  for (const FrameSample& sample : s_samples)
+  {
+    frame_ms.push_back(sample.time_us / 1000.0);
+    draw_calls.push_back(sample.draw_calls);
+    total_us += sample.time_us;
+    primitives += sample.primitives;
+    compile_stalls += sample.pipeline_compile_stalls;
+    compile_stall_us += sample.pipeline_compile_stall_us;
+    async_misses += sample.async_pipeline_misses;
+  }
+  std::sort(frame_ms.begin(), frame_ms.end());
+  std::sort(draw_calls.begin(), draw_calls.end());
+
+  const size_t frames = s_samples.size();
+  const double mean_ms = total_us / 1000.0 / frames;
+  const double fps = mean_ms > 0.0 ? 1000.0 / mean_ms : 0.0;
+  const double mean_draw_calls =
+      std::accumulate(draw_calls.begin(), draw_calls.end(), u64(0)) / static_cast<double>(frames);
+
+  const u64 ticks = s_last_counters.ticks - s_first_counters.ticks;
+  const u64 idle_ticks = s_last_counters.idle_ticks - s_first_counters.idle_ticks;
+  const double idle_percent = ticks > 0 ? 100.0 * idle_ticks / ticks : 0.0;
+  const u64 jit_calls = s_last_counters.jit.calls - s_first_counters.jit.calls;
+  const u64 jit_time_us = s_last_counters.jit.time_us - s_first_counters.jit.time_us;
+  const u64 jit_blocks =
+      s_last_counters.jit.blocks_compiled - s_first_counters.jit.blocks_compiled;
+  const u64 jit_cache_full_clears =
+      s_last_counters.jit.cache_full_clears - s_first_counters.jit.cache_full_clears;
+  // The shader cache resets its statistics when it is reloaded
+  const int first_shaders = s_first_counters.shaders_created;
+  const int last_shaders = s_last_counters.shaders_created;
+  const int shaders_created = last_shaders >= first_shaders ? last_shaders - first_shaders :
+                                                              last_shaders;
+
+  return fmt::format(
+      "{{\"backend\": \"{}\", \"frames\": {}, \"fps\": {:.2f}, \"frame_time_ms\": {{\"mean\": "
+      "{:.3f}, \"min\": {:.3f}, \"p50\": {:.3f}, \"p90\": {:.3f}, \"p95\": {:.3f}, \"p99\": "
+      "{:.3f}, \"max\": {:.3f}}}, \"draw_calls\": {{\"mean\": {:.1f}, \"p50\": {}, \"max\": {}}}, "
+      "\"primitives_per_frame\": {:.1f}, \"pipeline_compile_stalls\": {}, "
+      "\"pipeline_compile_stall_ms\": {:.3f}, \"async_pipeline_misses\": {}, "
+      "\"shaders_created\": {}, \"idle_percent\": {:.2f}, \"jit_calls\": {}, "
+      "\"jit_compile_ms\": {:.3f}, \"jit_blocks_compiled\": {}, \"jit_cache_full_clears\": {}}}",
+      backend, frames, fps, mean_ms, frame_ms.front(), Percentile(frame_ms, 50),
+      Percentile(frame_ms, 90), Percentile(frame_ms, 95), Percentile(frame_ms, 99),
+      frame_ms.back(), mean_draw_calls, Percentile(draw_calls, 50), draw_calls.back(),
+      primitives / static_cast<double>(frames), compile_stalls, compile_stall_us / 1000.0,
+      async_misses, shaders_created, idle_percent, jit_calls, jit_time_us / 1000.0, jit_blocks,
+      jit_cache_full_clears);
+}
+}  // namespace FrameBenchmark
@@ -0,0 +1,27 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Records the host time and the statistics of every presented frame, and summarizes them as a JSON
+// report together with the CPU idle time, JIT compile time and shader compiles of those frames.
+// Used by the FIFO log and movie benchmarks of DolphinNoGUI.
+
+#pragma once
+
+#include <string>
+
+#include "VideoCommon/Statistics.h"
+
+namespace FrameBenchmark
+{
+// Discards any previous recording and starts recording at the next presented frame.
+void Start();
+bool IsActive();
+
+// Called from Renderer::Swap on the GPU thread for every new frame, before the per-frame
+// statistics are reset.
+void OnFramePresented(const Statistics::ThisFrame& stats);
+
+// Stops recording and returns the report, a single line JSON object. Start and Stop can be called
+// from any thread.
+std::string Stop();
+}  // namespace FrameBenchmark
@@ -7,6 +7,7 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -16,6 +17,7 @@
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
 #include <libavutil/mathematics.h>
 #include <libswscale/swscale.h>
 }
@@ -24,8 +26,10 @@ extern "C" {
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Swap.h"
 
 #include "Core/ConfigManager.h"
+#include "Core/HW/AudioInterface.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 
@@ -41,6 +45,14 @@ struct FrameDumpContext
   AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  AVStream* audio_stream = nullptr;
+  AVCodecContext* audio_codec = nullptr;
+  AVFrame* audio_frame = nullptr;
+  // Interleaved stereo samples which don't fill an encoder frame yet.
+  std::vector<s16> audio_buffer;
+  s64 audio_next_pts = AV_NOPTS_VALUE;
+  bool gave_audio_rate_warning = false;
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -139,6 +151,7 @@ bool FrameDump::PrepareEncoding(int w, int h, u64 start_ticks, u32 savestate_ind
     CloseVideoFile();
     OSD::AddMessage("FrameDump Start failed");
   }
+  m_audio_enabled.store(success && m_context->audio_codec != nullptr);
   return success;
 }
 
@@ -213,9 +226,14 @@ bool FrameDump::CreateVideoFile()
   m_context->codec->height = m_context->height;
   m_context->codec->time_base = time_base;
   m_context->codec->gop_size = 1;
-  m_context->codec->level = 1;
+  // FFV1 only supports slices, and with them threaded encoding, from version 3 onwards.
+  m_context->codec->level = g_Config.bUseFFV1 ? 3 : 1;
   m_context->codec->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGR0 : AV_PIX_FMT_YUV420P;
 
+  // Let software encoders use all cores. High internal resolution dumps are otherwise limited to
+  // the speed of a single encoding thread.
+  m_context->codec->thread_count = 0;
+
   if (output_format->flags & AVFMT_GLOBALHEADER)
     m_context->codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 
@@ -245,6 +263,8 @@ bool FrameDump::CreateVideoFile()
 
   m_context->stream->time_base = m_context->codec->time_base;
 
+  CreateAudioStream();
+
   NOTICE_LOG_FMT(FRAMEDUMP, "Opening file {} for dumping", dump_path);
   if (avio_open(&m_context->format->pb, dump_path.c_str(), AVIO_FLAG_WRITE) < 0 ||
       avformat_write_header(m_context->format, nullptr))
@@ -313,7 +333,8 @@ void FrameDump::AddFrame(const FrameData& frame)
   m_context->sws = sws_getCachedContext(
       m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
       m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
+  // With frame threading, the encoder may still hold a reference to the previous frame's buffer.
+  if (m_context->sws && av_frame_make_writable(m_context->scaled_frame) >= 0)
   {
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
               frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
@@ -322,6 +343,8 @@ void FrameDump::AddFrame(const FrameData& frame)
   m_context->last_pts = pts;
   m_context->scaled_frame->pts = pts;
 
+  ProcessAudio();
+
   if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", error);
@@ -368,6 +391,16 @@ void FrameDump::Stop()
   if (!IsStarted())
     return;
 
+  m_audio_enabled.store(false);
+  if (m_context->audio_codec)
+  {
+    ProcessAudio();
+    EncodeAudio(true);
+    if (const int flush_error = avcodec_send_frame(m_context->audio_codec, nullptr))
+      WARN_LOG_FMT(FRAMEDUMP, "Error sending audio flush packet: {}", flush_error);
+    ProcessAudioPackets();
+  }
+
   // Signal end of stream to encoder.
   if (const int flush_error = avcodec_send_frame(m_context->codec, nullptr))
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", flush_error);
@@ -380,6 +413,238 @@ void FrameDump::Stop()
   OSD::AddMessage("Stopped dumping frames");
 }
 
+void FrameDump::CreateAudioStream()
+{
+  const std::string& codec_name = g_Config.sDumpAudioCodec;
+  if (codec_name.empty())
+    return;
+
+  const AVCodec* codec = avcodec_find_encoder_by_name(codec_name.c_str());
+  if (!codec)
+  {
+    const AVCodecDescriptor* const codec_desc = avcodec_descriptor_get_by_name(codec_name.c_str());
+    if (codec_desc)
+      codec = avcodec_find_encoder(codec_desc->id);
+  }
+  if (!codec || codec->type != AVMEDIA_TYPE_AUDIO)
+  {
+    WARN_LOG_FMT(FRAMEDUMP, "Invalid audio codec {}, not dumping audio", codec_name);
+    return;
+  }
+
+  // The samples are not resampled or converted other than to planar float, so the encoder has to
+  // take them at the DSP sample rate and as 16-bit or planar float samples.
+  const int sample_rate = static_cast<int>(AudioInterface::GetAIDSampleRate());
+  if (codec->supported_samplerates)
+  {
+    bool rate_supported = false;
+    for (const int* rate = codec->supported_samplerates; *rate != 0; ++rate)
+      rate_supported |= *rate == sample_rate;
+    if (!rate_supported)
+    {
+      WARN_LOG_FMT(FRAMEDUMP, "Audio codec {} does not support {} Hz, not dumping audio",
+                   codec_name, sample_rate);
+      return;
+    }
+  }
+
+  AVSampleFormat sample_format = AV_SAMPLE_FMT_NONE;
+  for (const AVSampleFormat* format = codec->sample_fmts; format && *format != AV_SAMPLE_FMT_NONE;
+       ++format)
+  {
+    if (*format == AV_SAMPLE_FMT_S16)
+    {
+      sample_format = *format;
+      break;
+    }
+    if (*format == AV_SAMPLE_FMT_FLTP)
+      sample_format = *format;
+  }
+  if (sample_format == AV_SAMPLE_FMT_NONE)
+  {
+    WARN_LOG_FMT(FRAMEDUMP, "Audio codec {} has no supported sample format, not dumping audio",
+                 codec_name);
+    return;
+  }
+
+  m_context->audio_codec = avcodec_alloc_context3(codec);
+  if (!m_context->audio_codec)
+    return;
+
+  AVCodecContext* const audio_codec = m_context->audio_codec;
+  audio_codec->codec_type = AVMEDIA_TYPE_AUDIO;
+  audio_codec->sample_fmt = sample_format;
+  audio_codec->sample_rate = sample_rate;
+  audio_codec->channels = 2;
+  audio_codec->channel_layout = AV_CH_LAYOUT_STEREO;
+  audio_codec->time_base = AVRational{1, sample_rate};
+
+  if (m_context->format->oformat->flags & AVFMT_GLOBALHEADER)
+    audio_codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+  if (avcodec_open2(audio_codec, codec, nullptr) < 0)
+  {
+    WARN_LOG_FMT(FRAMEDUMP, "Could not open audio codec {}, not dumping audio", codec_name);
+    avcodec_free_context(&m_context->audio_codec);
+    return;
+  }
+
+  m_context->audio_stream = avformat_new_stream(m_context->format, codec);
+  if (!m_context->audio_stream ||
+      avcodec_parameters_from_context(m_context->audio_stream->codecpar, audio_codec) < 0)
+  {
+    WARN_LOG_FMT(FRAMEDUMP, "Could not create audio stream, not dumping audio");
+    avcodec_free_context(&m_context->audio_codec);
+    return;
+  }
+  m_context->audio_stream->time_base = audio_codec->time_base;
+  m_context->audio_frame = av_frame_alloc();
+
+  INFO_LOG_FMT(FRAMEDUMP, "Dumping audio with {} at {} Hz", codec->name, sample_rate);
+}
+
+void FrameDump::AddAudioSamples(const s16* samples, u32 num_samples, u32 sample_rate, u64 ticks)
+{
+  if (!m_audio_enabled.load())
+    return;
+
+  AudioChunk chunk{std::vector<s16>(num_samples * 2), sample_rate, ticks};
+  for (u32 i = 0; i < num_samples * 2; ++i)
+    chunk.samples[i] = static_cast<s16>(Common::swap16(static_cast<u16>(samples[i])));
+  m_audio_queue.Push(std::move(chunk));
+}
+
+void FrameDump::ProcessAudio()
+{
+  AudioChunk chunk;
+  while (m_audio_queue.Pop(chunk))
+  {
+    if (!m_context->audio_codec || chunk.ticks < m_context->start_ticks)
+      continue;
+
+    const int sample_rate = m_context->audio_codec->sample_rate;
+    if (chunk.sample_rate != static_cast<u32>(sample_rate))
+    {
+      if (!m_context->gave_audio_rate_warning)
+      {
+        WARN_LOG_FMT(FRAMEDUMP, "DSP sample rate changed to {} Hz, dropping audio",
+                     chunk.sample_rate);
+        m_context->gave_audio_rate_warning = true;
+      }
+      continue;
+    }
+
+    // The first samples are placed at the time they started playing, like the video frames.
+    // Later samples follow without gaps, so timing jitter of the DMA doesn't cause any.
+    if (m_context->audio_next_pts == AV_NOPTS_VALUE)
+    {
+      m_context->audio_next_pts =
+          av_rescale(static_cast<s64>(chunk.ticks - m_context->start_ticks), sample_rate,
+                     SystemTimers::GetTicksPerSecond());
+    }
+
+    m_context->audio_buffer.insert(m_context->audio_buffer.end(), chunk.samples.begin(),
+                                   chunk.samples.end());
+    EncodeAudio(false);
+  }
+}
+
+void FrameDump::EncodeAudio(bool flush)
+{
+  AVCodecContext* const audio_codec = m_context->audio_codec;
+  AVFrame* const frame = m_context->audio_frame;
+  std::vector<s16>& buffer = m_context->audio_buffer;
+
+  const bool variable_frame_size =
+      audio_codec->frame_size == 0 ||
+      (audio_codec->codec->capabilities & AV_CODEC_CAP_VARIABLE_FRAME_SIZE) != 0;
+
+  while (!buffer.empty())
+  {
+    const int buffered_samples = static_cast<int>(buffer.size() / 2);
+    int frame_samples = variable_frame_size ? buffered_samples : audio_codec->frame_size;
+    if (buffered_samples < frame_samples)
+    {
+      if (!flush)
+        return;
+
+      // Pad the last frame with silence unless the encoder accepts a short one.
+      if (audio_codec->codec->capabilities & AV_CODEC_CAP_SMALL_LAST_FRAME)
+        frame_samples = buffered_samples;
+      else
+        buffer.resize(static_cast<size_t>(frame_samples) * 2);
+    }
+
+    av_frame_unref(frame);
+    frame->format = audio_codec->sample_fmt;
+    frame->channel_layout = audio_codec->channel_layout;
+    frame->channels = audio_codec->channels;
+    frame->sample_rate = audio_codec->sample_rate;
+    frame->nb_samples = frame_samples;
+    if (av_frame_get_buffer(frame, 0) < 0)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate audio frame");
+      buffer.clear();
+      return;
+    }
+
+    if (audio_codec->sample_fmt == AV_SAMPLE_FMT_S16)
+    {
+      std::copy_n(buffer.data(), frame_samples * 2, reinterpret_cast<s16*>(frame->data[0]));
+    }
+    else
+    {
+      float* const left = reinterpret_cast<float*>(frame->data[0]);
+      float* const right = reinterpret_cast<float*>(frame->data[1]);
+      for (int i = 0; i < frame_samples; ++i)
+      {
+        left[i] = buffer[i * 2] / 32768.0f;
+        right[i] = buffer[i * 2 + 1] / 32768.0f;
+      }
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + frame_samples * 2);
+
+    frame->pts = m_context->audio_next_pts;
+    m_context->audio_next_pts += frame_samples;
+
+    if (const int error = avcodec_send_frame(audio_codec, frame))
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding audio: {}", error);
+      return;
+    }
+    ProcessAudioPackets();
+  }
+}
+
+void FrameDump::ProcessAudioPackets()
+{
+  while (true)
+  {
+    AVPacket pkt;
+    av_init_packet(&pkt);
+
+    const int receive_error = avcodec_receive_packet(m_context->audio_codec, &pkt);
+    if (receive_error == AVERROR(EAGAIN) || receive_error == AVERROR_EOF)
+      break;
+
+    if (receive_error)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Error receiving audio packet: {}", receive_error);
+      break;
+    }
+
+    av_packet_rescale_ts(&pkt, m_context->audio_codec->time_base,
+                         m_context->audio_stream->time_base);
+    pkt.stream_index = m_context->audio_stream->index;
+
+    if (const int write_error = av_interleaved_write_frame(m_context->format, &pkt))
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Error writing audio packet: {}", write_error);
+      break;
+    }
+  }
+}
+
 bool FrameDump::IsStarted() const
 {
   return m_context != nullptr;
@@ -387,10 +652,14 @@ bool FrameDump::IsStarted() const
 
 void FrameDump::CloseVideoFile()
 {
+  m_audio_enabled.store(false);
+
   av_frame_free(&m_context->src_frame);
   av_frame_free(&m_context->scaled_frame);
+  av_frame_free(&m_context->audio_frame);
 
   avcodec_free_context(&m_context->codec);
+  avcodec_free_context(&m_context->audio_codec);
 
   if (m_context->format)
     avio_closep(&m_context->format->pb);
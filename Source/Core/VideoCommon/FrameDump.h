@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <ctime>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/SPSCQueue.h"
 
 struct FrameDumpContext;
 class PointerWrap;
@@ -39,6 +42,9 @@ public:
 
   bool Start(int w, int h, u64 start_ticks);
   void AddFrame(const FrameData&);
+  // Queues big-endian stereo samples of the DSP audio, which started playing at the given ticks.
+  // Called from the CPU thread. The samples are encoded when the next frame is added.
+  void AddAudioSamples(const s16* samples, u32 num_samples, u32 sample_rate, u64 ticks);
   void Stop();
   void DoState(PointerWrap&);
   bool IsStarted() const;
@@ -51,9 +57,23 @@ private:
   void CloseVideoFile();
   void CheckForConfigChange(const FrameData&);
   void ProcessPackets();
+  void CreateAudioStream();
+  void ProcessAudio();
+  void EncodeAudio(bool flush);
+  void ProcessAudioPackets();
 
 #if defined(HAVE_FFMPEG)
   std::unique_ptr<FrameDumpContext> m_context;
+
+  struct AudioChunk
+  {
+    std::vector<s16> samples;
+    u32 sample_rate;
+    u64 ticks;
+  };
+  Common::SPSCQueue<AudioChunk, false> m_audio_queue;
+  // Set while the current file has an audio stream, so that no samples are queued otherwise.
+  std::atomic<bool> m_audio_enabled{false};
 #endif
 
   // Used for FetchState:
@@ -72,4 +92,8 @@ inline FrameDump::FrameState FrameDump::FetchState(u64 ticks, int frame_number)
 {
   return {};
 }
+
+inline void FrameDump::AddAudioSamples(const s16*, u32, u32, u64)
+{
+}
 #endif
@@ -0,0 +1,129 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameTimes.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cinttypes>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <imgui.h>
+
+#include "Common/Logging/Log.h"
+#include "Core/HW/DVD/DVDThread.h"
+#include "Core/PowerPC/JitInterface.h"
+
+namespace VideoCommon
+{
+// Frames before stutters are detected, so that the median means something
+constexpr u32 MIN_FRAMES_FOR_STUTTERS = 60;
+// Subsystems which took less than this in a stuttering frame aren't blamed for it
+constexpr u64 MIN_CAUSE_TIME_US = 1000;
+constexpr size_t MAX_STUTTERS_SHOWN = 8;
+
+void FrameTimes::OnFramePresented(u64 frame_number, double frame_time_ms,
+                                  const Statistics::ThisFrame& frame)
+{
+  const JitInterface::CompileStats jit = JitInterface::GetCompileStats();
+  const u64 dvd_wait_us = DVDThread::GetReadWaitTimeUs();
+
+  // The threshold is based on the frames before this one, so that a stutter can't raise it
+  if (m_history_count >= MIN_FRAMES_FOR_STUTTERS && frame_time_ms > 2.0 * m_percentiles.p50)
+  {
+    Stutter stutter{frame_number, static_cast<float>(frame_time_ms),
+                    GetStutterCauses(frame, jit.time_us - m_last_jit_compile_us,
+                                     jit.cache_full_clears - m_last_jit_clears,
+                                     dvd_wait_us - m_last_dvd_wait_us)};
+    INFO_LOG_FMT(VIDEO, "Stutter in frame {}: {:.1f} ms, median {:.1f} ms, {}",
+                 stutter.frame_number, stutter.frame_time_ms, m_percentiles.p50, stutter.causes);
+
+    m_stutters.push_front(std::move(stutter));
+    if (m_stutters.size() > MAX_STUTTERS_SHOWN)
+      m_stutters.pop_back();
+  }
+
+  m_last_jit_compile_us = jit.time_us;
+  m_last_jit_clears = jit.cache_full_clears;
+  m_last_dvd_wait_us = dvd_wait_us;
+
+  m_history[m_history_pos] = static_cast<float>(frame_time_ms);
+  m_history_pos = (m_history_pos + 1) % HISTORY_SIZE;
+  m_history_count = std::min(m_history_count + 1, HISTORY_SIZE);
+  UpdatePercentiles();
+}
+
+void FrameTimes::UpdatePercentiles()
+{
+  // Until the history is full, the entries from m_history_pos on are still zero
+  std::vector<float> sorted(m_history.begin(), m_history.begin() + m_history_count);
+  const auto percentile = [&](u32 percent) {
+    const auto nth = sorted.begin() + (sorted.size() - 1) * percent / 100;
+    std::nth_element(sorted.begin(), nth, sorted.end());
+    return *nth;
+  };
+
+  m_percentiles.p50 = percentile(50);
+  m_percentiles.p99 = percentile(99);
+  m_percentiles.max = *std::max_element(sorted.begin(), sorted.end());
+}
+
+std::string FrameTimes::GetStutterCauses(const Statistics::ThisFrame& frame, u64 jit_compile_us,
+                                         u64 jit_clears, u64 dvd_wait_us) const
+{
+  const std::pair<const char*, u64> causes[] = {
+      {"shader compile wait",
+       static_cast<u64>(frame.pipeline_compile_stall_us + frame.shader_compile_wait_us)},
+      {"texture decode", static_cast<u64>(frame.texture_decode_us)},
+      {"EFB readback", static_cast<u64>(frame.efb_readback_us)},
+      {"JIT compile", jit_compile_us},
+      {"DVD read wait", dvd_wait_us},
+  };
+
+  std::string result;
+  const auto append = [&](const std::string& cause) {
+    if (!result.empty())
+      result += ", ";
+    result += cause;
+  };
+
+  if (jit_clears != 0)
+    append("JIT cache clear");
+  for (const auto& [name, time_us] : causes)
+  {
+    if (time_us >= MIN_CAUSE_TIME_US)
+      append(fmt::format("{} {:.1f} ms", name, time_us / 1000.0));
+  }
+  return result.empty() ? "unknown cause" : result;
+}
+
+void FrameTimes::Draw()
+{
+  const float scale = ImGui::GetIO().DisplayFramebufferScale.x;
+  ImGui::SetNextWindowSize(ImVec2(360.0f * scale, 0.0f), ImGuiCond_FirstUseEver);
+  if (!ImGui::Begin("Frame Times", nullptr, ImGuiWindowFlags_NoNavInputs))
+  {
+    ImGui::End();
+    return;
+  }
+
+  ImGui::Text("p50: %.2f ms  p99: %.2f ms  max: %.2f ms", m_percentiles.p50, m_percentiles.p99,
+              m_percentiles.max);
+  ImGui::PlotLines("##FrameTimes", m_history.data(), HISTORY_SIZE, m_history_pos, nullptr, 0.0f,
+                   FLT_MAX, ImVec2(-1.0f, 60.0f * scale));
+
+  if (!m_stutters.empty())
+  {
+    ImGui::Separator();
+    for (const Stutter& stutter : m_stutters)
+    {
+      ImGui::TextWrapped("Frame %" PRIu64 ": %.1f ms, %s", stutter.frame_number,
+                         stutter.frame_time_ms, stutter.causes.c_str());
+    }
+  }
+
+  ImGui::End();
+}
+}  // namespace VideoCommon
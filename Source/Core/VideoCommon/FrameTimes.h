@@ -0,0 +1,65 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/Statistics.h"
+
+namespace VideoCommon
+{
+// Keeps the time of the most recently presented frames, so that single frame hitches stay visible
+// unlike in the FPS average, and detects stutters. A stutter is a frame taking more than twice the
+// median frame time. It is logged together with the subsystems which spent a notable amount of
+// host time in that frame.
+class FrameTimes
+{
+public:
+  static constexpr u32 HISTORY_SIZE = 600;
+
+  struct Percentiles
+  {
+    float p50 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+  };
+
+  // Called after presenting a frame, with the statistics of that frame.
+  void OnFramePresented(u64 frame_number, double frame_time_ms,
+                        const Statistics::ThisFrame& frame);
+
+  const Percentiles& GetPercentiles() const { return m_percentiles; }
+
+  // Draws the overlay window, only valid while building an ImGui frame.
+  void Draw();
+
+private:
+  struct Stutter
+  {
+    u64 frame_number;
+    float frame_time_ms;
+    std::string causes;
+  };
+
+  void UpdatePercentiles();
+  std::string GetStutterCauses(const Statistics::ThisFrame& frame, u64 jit_compile_us,
+                               u64 jit_clears, u64 dvd_wait_us) const;
+
+  // Milliseconds taken by the most recent frames, indexed by m_history_pos
+  std::array<float, HISTORY_SIZE> m_history{};
+  u32 m_history_pos = 0;
+  u32 m_history_count = 0;
+  Percentiles m_percentiles;
+
+  // Totals of the CPU thread counters when the previous frame was presented
+  u64 m_last_jit_compile_us = 0;
+  u64 m_last_jit_clears = 0;
+  u64 m_last_dvd_wait_us = 0;
+
+  std::deque<Stutter> m_stutters;
+};
+}  // namespace VideoCommon
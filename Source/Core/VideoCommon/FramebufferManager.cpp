@@ -3,11 +3,13 @@
 
 #include "VideoCommon/FramebufferManager.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractPipeline.h"
@@ -16,7 +18,9 @@
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/GPUTimings.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -213,6 +217,8 @@ bool FramebufferManager::CreateEFBFramebuffer()
   g_renderer->SetAndClearFramebuffer(
       m_efb_framebuffer.get(), {{0.0f, 0.0f, 0.0f, 0.0f}},
       g_ActiveConfig.backend_info.bSupportsReversedDepthRange ? 1.0f : 0.0f);
+  m_pending_reinterpret.reset();
+  m_efb_written_rect = {};
   return true;
 }
 
@@ -235,6 +241,8 @@ void FramebufferManager::BindEFBFramebuffer()
 
 AbstractTexture* FramebufferManager::ResolveEFBColorTexture(const MathUtil::Rectangle<int>& region)
 {
+  ApplyPendingReinterpret();
+
   // Return the normal EFB texture if multisampling is off.
   if (!IsEFBMultisampled())
     return m_efb_color_texture.get();
@@ -282,11 +290,60 @@ AbstractTexture* FramebufferManager::ResolveEFBDepthTexture(const MathUtil::Rect
   return m_efb_depth_resolve_texture.get();
 }
 
+static void AddToRect(MathUtil::Rectangle<int>* rect, const MathUtil::Rectangle<int>& other)
+{
+  if (other.GetWidth() <= 0 || other.GetHeight() <= 0)
+    return;
+
+  if (rect->GetWidth() <= 0 || rect->GetHeight() <= 0)
+  {
+    *rect = other;
+    return;
+  }
+
+  rect->left = std::min(rect->left, other.left);
+  rect->top = std::min(rect->top, other.top);
+  rect->right = std::max(rect->right, other.right);
+  rect->bottom = std::max(rect->bottom, other.bottom);
+}
+
 bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
 {
   if (!m_format_conversion_pipelines[static_cast<u32>(convtype)])
     return false;
 
+  // The conversions other than RGB8 <-> RGBA6 copy the texels unchanged, and a cleared EFB is zero
+  // in every format.
+  if ((convtype != EFBReinterpretType::RGB8ToRGBA6 &&
+       convtype != EFBReinterpretType::RGBA6ToRGB8) ||
+      m_efb_written_rect.GetWidth() <= 0 || m_efb_written_rect.GetHeight() <= 0)
+  {
+    return true;
+  }
+
+  // Both conversions keep the bits of the pixels, RGBA6ToRGB8 only sets the alpha channel, which
+  // the formats without alpha never read. Converting back and forth is therefore a no-op.
+  if (m_pending_reinterpret && *m_pending_reinterpret != convtype)
+  {
+    m_pending_reinterpret.reset();
+    return true;
+  }
+
+  ApplyPendingReinterpret();
+  m_pending_reinterpret = convtype;
+  return true;
+}
+
+void FramebufferManager::ApplyPendingReinterpret()
+{
+  if (!m_pending_reinterpret)
+    return;
+
+  const EFBReinterpretType convtype = *m_pending_reinterpret;
+  m_pending_reinterpret.reset();
+
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::TextureConversion);
+
   // Draw to the secondary framebuffer.
   // We don't discard here because discarding the framebuffer also throws away the depth
   // buffer, which we want to preserve. If we find this to be hindering performance in the
@@ -304,7 +361,39 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   std::swap(m_efb_framebuffer, m_efb_convert_framebuffer);
   g_renderer->EndUtilityDrawing();
   InvalidatePeekCache(true);
-  return true;
+}
+
+void FramebufferManager::OnEFBDraw(const MathUtil::Rectangle<int>& rc)
+{
+  ApplyPendingReinterpret();
+  AddToRect(&m_efb_written_rect, rc);
+}
+
+void FramebufferManager::OnEFBClear(const MathUtil::Rectangle<int>& rc, bool clear_color,
+                                    bool clear_alpha)
+{
+  if (!clear_color && !clear_alpha)
+    return;
+
+  // A clear of everything that was written replaces the data instead of converting it. The alpha
+  // channel only has to be cleared too when the new format has one.
+  if (m_pending_reinterpret)
+  {
+    const bool needs_alpha = *m_pending_reinterpret == EFBReinterpretType::RGB8ToRGBA6;
+    if (clear_color && (clear_alpha || !needs_alpha) && rc.left <= m_efb_written_rect.left &&
+        rc.top <= m_efb_written_rect.top && rc.right >= m_efb_written_rect.right &&
+        rc.bottom >= m_efb_written_rect.bottom)
+    {
+      m_pending_reinterpret.reset();
+      InvalidatePeekCache(true);
+    }
+    else
+    {
+      ApplyPendingReinterpret();
+    }
+  }
+
+  AddToRect(&m_efb_written_rect, rc);
 }
 
 bool FramebufferManager::CompileConversionPipelines()
@@ -377,6 +466,8 @@ MathUtil::Rectangle<int> FramebufferManager::GetEFBCacheTileRect(u32 tile_index)
 
 u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
 {
+  ApplyPendingReinterpret();
+
   // The y coordinate here assumes upper-left origin, but the readback texture is lower-left in GL.
   if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
     y = EFB_HEIGHT - 1 - y;
@@ -384,6 +475,7 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
   u32 tile_index;
   if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
     PopulateEFBCache(false, tile_index);
+  MarkEFBCacheTileRead(false, tile_index);
 
   u32 value;
   m_efb_color_cache.readback_texture->ReadTexel(x, y, &value);
@@ -399,6 +491,7 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
   u32 tile_index;
   if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
     PopulateEFBCache(true, tile_index);
+  MarkEFBCacheTileRead(true, tile_index);
 
   float value;
   m_efb_depth_cache.readback_texture->ReadTexel(x, y, &value);
@@ -417,24 +510,39 @@ void FramebufferManager::SetEFBCacheTileSize(u32 size)
     PanicAlertFmt("Failed to create EFB readback framebuffers");
 }
 
+void FramebufferManager::MarkEFBCacheTileRead(bool depth, u32 tile_index)
+{
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  if (data.out_of_date)
+    INCSTAT(g_stats.this_frame.num_efb_peeks_stale);
+  if (IsUsingTiledEFBCache())
+    data.read_tiles[tile_index] = true;
+}
+
 void FramebufferManager::InvalidatePeekCache(bool forced)
 {
-  if (forced || m_efb_color_cache.out_of_date)
-  {
-    if (m_efb_color_cache.valid)
-      std::fill(m_efb_color_cache.tiles.begin(), m_efb_color_cache.tiles.end(), false);
+  // With deferred invalidation, the tiles that were read until now are remembered so that they can
+  // be read back together the next time one of them is needed. A forced invalidation means the
+  // EFB has changed completely, so the old accesses say nothing about the next ones.
+  auto InvalidateCache = [forced](EFBCacheData& data) {
+    if (data.valid)
+    {
+      std::fill(data.tiles.begin(), data.tiles.end(), false);
+      if (!forced)
+        data.predicted_tiles.swap(data.read_tiles);
+    }
+    if (forced)
+      std::fill(data.predicted_tiles.begin(), data.predicted_tiles.end(), false);
+    std::fill(data.read_tiles.begin(), data.read_tiles.end(), false);
 
-    m_efb_color_cache.valid = false;
-    m_efb_color_cache.out_of_date = false;
-  }
-  if (forced || m_efb_depth_cache.out_of_date)
-  {
-    if (m_efb_depth_cache.valid)
-      std::fill(m_efb_depth_cache.tiles.begin(), m_efb_depth_cache.tiles.end(), false);
+    data.valid = false;
+    data.out_of_date = false;
+  };
 
-    m_efb_depth_cache.valid = false;
-    m_efb_depth_cache.out_of_date = false;
-  }
+  if (forced || m_efb_color_cache.out_of_date)
+    InvalidateCache(m_efb_color_cache);
+  if (forced || m_efb_depth_cache.out_of_date)
+    InvalidateCache(m_efb_depth_cache);
 }
 
 void FramebufferManager::FlagPeekCacheAsOutOfDate()
@@ -561,10 +669,12 @@ bool FramebufferManager::CreateReadbackFramebuffer()
     const u32 tiles_wide = ((EFB_WIDTH + (m_efb_cache_tile_size - 1)) / m_efb_cache_tile_size);
     const u32 tiles_high = ((EFB_HEIGHT + (m_efb_cache_tile_size - 1)) / m_efb_cache_tile_size);
     const u32 total_tiles = tiles_wide * tiles_high;
-    m_efb_color_cache.tiles.resize(total_tiles);
-    std::fill(m_efb_color_cache.tiles.begin(), m_efb_color_cache.tiles.end(), false);
-    m_efb_depth_cache.tiles.resize(total_tiles);
-    std::fill(m_efb_depth_cache.tiles.begin(), m_efb_depth_cache.tiles.end(), false);
+    for (EFBCacheData* data : {&m_efb_color_cache, &m_efb_depth_cache})
+    {
+      data->tiles.assign(total_tiles, false);
+      data->read_tiles.assign(total_tiles, false);
+      data->predicted_tiles.assign(total_tiles, false);
+    }
     m_efb_cache_tiles_wide = tiles_wide;
   }
 
@@ -583,10 +693,8 @@ void FramebufferManager::DestroyReadbackFramebuffer()
   DestroyCache(m_efb_depth_cache);
 }
 
-void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
+void FramebufferManager::CopyToEFBCache(bool depth, u32 tile_index)
 {
-  g_vertex_manager->OnCPUEFBAccess();
-
   // Force the path through the intermediate texture, as we can't do an image copy from a depth
   // buffer directly to a staging texture (must be the whole resource).
   const bool force_intermediate_copy =
@@ -640,6 +748,32 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
   {
     data.readback_texture->CopyFromTexture(src_texture, rect, 0, 0, rect);
   }
+}
+
+void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
+{
+  const u64 start_time_us = Common::Timer::GetTimeUs();
+  g_vertex_manager->OnCPUEFBAccess();
+  INCSTAT(g_stats.this_frame.num_efb_peek_readbacks);
+
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  CopyToEFBCache(depth, tile_index);
+
+  // Games that peek the EFB tend to read the same tiles every frame, so instead of waiting for each
+  // of them separately, copy the ones read before the last invalidation along with this one.
+  if (IsUsingTiledEFBCache() && g_ActiveConfig.bEFBAccessDeferInvalidation)
+  {
+    for (u32 i = 0; i < static_cast<u32>(data.tiles.size()); i++)
+    {
+      if (i == tile_index || !data.predicted_tiles[i] || (data.valid && data.tiles[i]))
+        continue;
+
+      CopyToEFBCache(depth, i);
+      data.tiles[i] = true;
+      INCSTAT(g_stats.this_frame.num_efb_tiles_prefetched);
+    }
+    std::fill(data.predicted_tiles.begin(), data.predicted_tiles.end(), false);
+  }
 
   // Wait until the copy is complete.
   data.readback_texture->Flush();
@@ -647,6 +781,7 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
   data.out_of_date = false;
   if (IsUsingTiledEFBCache())
     data.tiles[tile_index] = true;
+  ADDSTAT(g_stats.this_frame.efb_readback_us, Common::Timer::GetTimeUs() - start_time_us);
 }
 
 void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool clear_color,
@@ -742,6 +877,7 @@ void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
     FlushEFBPokes();
 
   CreatePokeVertices(&m_color_poke_vertices, x, y, 0.0f, color);
+  AddToRect(&m_efb_written_rect, MathUtil::Rectangle<int>(x, y, x + 1, y + 1));
 
   // See comment above for reasoning for lower-left coordinates.
   if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
@@ -803,6 +939,7 @@ void FramebufferManager::FlushEFBPokes()
 {
   if (!m_color_poke_vertices.empty())
   {
+    ApplyPendingReinterpret();
     DrawPokeVertices(m_color_poke_vertices.data(), static_cast<u32>(m_color_poke_vertices.size()),
                      m_color_poke_pipeline.get());
     m_color_poke_vertices.clear();
@@ -942,9 +1079,15 @@ void FramebufferManager::DoLoadState(PointerWrap& p)
     g_renderer->SetAndClearFramebuffer(
         m_efb_framebuffer.get(), {{0.0f, 0.0f, 0.0f, 0.0f}},
         g_ActiveConfig.backend_info.bSupportsReversedDepthRange ? 1.0f : 0.0f);
+    m_pending_reinterpret.reset();
+    m_efb_written_rect = {};
     return;
   }
 
+  // The saved contents were converted before they were written.
+  m_pending_reinterpret.reset();
+  m_efb_written_rect = MathUtil::Rectangle<int>(0, 0, EFB_WIDTH, EFB_HEIGHT);
+
   // Size differences are okay here, since the linear filtering will downscale/upscale it.
   // Depth buffer is always point sampled, since we don't want to interpolate depth values.
   const bool rescale = color_tex->texture->GetWidth() != m_efb_color_texture->GetWidth() ||
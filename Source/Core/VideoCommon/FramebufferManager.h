@@ -76,10 +76,19 @@ public:
   AbstractTexture* ResolveEFBDepthTexture(const MathUtil::Rectangle<int>& region,
                                           bool force_r32f = false);
 
-  // Reinterpret pixel format of EFB color texture.
+  // Reinterpret pixel format of EFB color texture. The conversion is deferred until the EFB
+  // contents are drawn over, read or copied, and skipped if a clear overwrites them first.
+  bool ReinterpretPixelData(EFBReinterpretType convtype);
+
+  // Runs the deferred conversion, if any.
   // Assumes no render pass is currently in progress.
   // Swaps EFB framebuffers, so re-bind afterwards.
-  bool ReinterpretPixelData(EFBReinterpretType convtype);
+  void ApplyPendingReinterpret();
+
+  // Called before drawing to or clearing native EFB rectangles, to keep track of which part of the
+  // EFB holds data that a format change has to convert.
+  void OnEFBDraw(const MathUtil::Rectangle<int>& rc);
+  void OnEFBClear(const MathUtil::Rectangle<int>& rc, bool clear_color, bool clear_alpha);
 
   // Clears the EFB using shaders.
   void ClearEFB(const MathUtil::Rectangle<int>& rc, bool clear_color, bool clear_alpha,
@@ -117,6 +126,9 @@ protected:
     std::unique_ptr<AbstractStagingTexture> readback_texture;
     std::unique_ptr<AbstractPipeline> copy_pipeline;
     std::vector<bool> tiles;
+    // Tiles the CPU has read since the last invalidation, and the ones it read before that
+    std::vector<bool> read_tiles;
+    std::vector<bool> predicted_tiles;
     bool out_of_date;
     bool valid;
   };
@@ -143,6 +155,8 @@ protected:
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index);
+  void CopyToEFBCache(bool depth, u32 tile_index);
+  void MarkEFBCacheTileRead(bool depth, u32 tile_index);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -170,6 +184,11 @@ protected:
   // Format conversion shaders
   std::array<std::unique_ptr<AbstractPipeline>, 6> m_format_conversion_pipelines;
 
+  // Conversion which the EFB contents are still waiting for, and the native rectangle which was
+  // drawn to or cleared since the EFB was created. The rest of the EFB is zero in every format.
+  std::optional<EFBReinterpretType> m_pending_reinterpret;
+  MathUtil::Rectangle<int> m_efb_written_rect;
+
   // EFB cache - for CPU EFB access
   u32 m_efb_cache_tile_size = 0;
   u32 m_efb_cache_tiles_wide = 0;
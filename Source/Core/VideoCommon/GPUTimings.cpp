@@ -0,0 +1,168 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/GPUTimings.h"
+
+#include <cfloat>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+#include <imgui.h>
+
+#include "Common/FileUtil.h"
+#include "VideoCommon/RenderBase.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace VideoCommon
+{
+namespace
+{
+struct PassNames
+{
+  const char* display_name;
+  const char* log_name;
+};
+
+constexpr std::array<PassNames, static_cast<size_t>(GPUPass::Count)> PASS_NAMES = {{
+    {"Draws", "draws"},
+    {"EFB copies", "efb_copies"},
+    {"Texture conversion", "texture_conversion"},
+    {"Bounding box", "bounding_box"},
+    {"Post-processing", "post_processing"},
+    {"Present", "present"},
+}};
+
+bool IsMeasuring()
+{
+  return (g_ActiveConfig.bShowGPUTimings || g_ActiveConfig.bLogGPUTimingsToFile) &&
+         g_renderer->SupportsGPUTimestamps();
+}
+}  // namespace
+
+void GPUTimings::SetPass(GPUPass pass)
+{
+  if (m_pass == pass)
+    return;
+
+  m_pass = pass;
+  if (!m_recording)
+    return;
+
+  g_renderer->WriteGPUTimestamp();
+  m_frame_passes.push_back(pass);
+}
+
+void GPUTimings::EndFrame()
+{
+  if (m_recording)
+  {
+    g_renderer->WriteGPUTimestamp();
+    g_renderer->EndGPUTimestampGroup();
+    m_pending_frames.push_back(std::move(m_frame_passes));
+    m_frame_passes.clear();
+    m_recording = false;
+  }
+
+  // Frames which finished after the overlay was turned off are still read, so that the backend
+  // can reuse their queries.
+  std::vector<u64> timestamps;
+  while (!m_pending_frames.empty() && g_renderer->ReadGPUTimestampGroup(&timestamps))
+  {
+    ProcessFrame(m_pending_frames.front(), timestamps);
+    m_pending_frames.pop_front();
+  }
+
+  if (IsMeasuring())
+  {
+    m_recording = true;
+    m_frame_passes.push_back(m_pass);
+    g_renderer->WriteGPUTimestamp();
+  }
+}
+
+void GPUTimings::ProcessFrame(const std::vector<GPUPass>& passes,
+                              const std::vector<u64>& timestamps)
+{
+  std::array<float, PASS_COUNT> pass_ms{};
+  for (size_t i = 0; i < passes.size() && i + 1 < timestamps.size(); ++i)
+  {
+    if (timestamps[i + 1] > timestamps[i])
+    {
+      pass_ms[static_cast<u32>(passes[i])] +=
+          static_cast<float>(timestamps[i + 1] - timestamps[i]) / 1000000.0f;
+    }
+  }
+
+  for (u32 i = 0; i < PASS_COUNT; ++i)
+    m_history[i][m_history_pos] = pass_ms[i];
+  m_history_pos = (m_history_pos + 1) % HISTORY_SIZE;
+  m_frames_measured++;
+
+  if (g_ActiveConfig.bLogGPUTimingsToFile)
+    LogFrameToFile(pass_ms);
+}
+
+void GPUTimings::LogFrameToFile(const std::array<float, PASS_COUNT>& pass_ms)
+{
+  if (!m_log_file.is_open())
+  {
+    File::OpenFStream(m_log_file, File::GetUserPath(D_LOGS_IDX) + "gpu_timings.csv",
+                      std::ios_base::out);
+
+    m_log_file << "frame";
+    for (const PassNames& names : PASS_NAMES)
+      m_log_file << ',' << names.log_name;
+    m_log_file << '\n';
+  }
+
+  std::string line = fmt::format("{}", m_frames_measured);
+  for (const float ms : pass_ms)
+    line += fmt::format(",{:.4f}", ms);
+  m_log_file << line << '\n';
+}
+
+void GPUTimings::Draw()
+{
+  const float scale = ImGui::GetIO().DisplayFramebufferScale.x;
+  ImGui::SetNextWindowSize(ImVec2(300.0f * scale, 0.0f), ImGuiCond_FirstUseEver);
+  if (!ImGui::Begin("GPU Timings", nullptr, ImGuiWindowFlags_NoNavInputs))
+  {
+    ImGui::End();
+    return;
+  }
+
+  if (!g_renderer->SupportsGPUTimestamps())
+  {
+    ImGui::TextUnformatted("Not supported by this backend.");
+    ImGui::End();
+    return;
+  }
+
+  const u32 last_frame = (m_history_pos + HISTORY_SIZE - 1) % HISTORY_SIZE;
+  float frame_ms = 0.0f;
+  for (u32 i = 0; i < PASS_COUNT; ++i)
+    frame_ms += m_history[i][last_frame];
+  ImGui::Text("Frame: %.2f ms", frame_ms);
+
+  for (u32 i = 0; i < PASS_COUNT; ++i)
+  {
+    const std::string overlay = fmt::format("{:.2f} ms", m_history[i][last_frame]);
+    ImGui::PlotLines(PASS_NAMES[i].display_name, m_history[i].data(), HISTORY_SIZE,
+                     m_history_pos, overlay.c_str(), 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f * scale));
+  }
+
+  ImGui::End();
+}
+
+ScopedGPUPass::ScopedGPUPass(GPUPass pass)
+    : m_previous_pass(g_renderer->GetGPUTimings().GetPass())
+{
+  g_renderer->GetGPUTimings().SetPass(pass);
+}
+
+ScopedGPUPass::~ScopedGPUPass()
+{
+  g_renderer->GetGPUTimings().SetPass(m_previous_pass);
+}
+}  // namespace VideoCommon
@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <fstream>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+// Categories of GPU work that the timing overlay breaks a frame down into
+enum class GPUPass : u32
+{
+  Draws,
+  EFBCopies,
+  TextureConversion,
+  BoundingBox,
+  PostProcessing,
+  Present,
+  Count
+};
+
+// Measures how much GPU time each pass takes per frame with the renderer's timestamp queries.
+// A timestamp is written whenever the pass changes, and the time until the next timestamp is
+// attributed to that pass. Results are read back a few frames later to avoid stalling.
+class GPUTimings
+{
+public:
+  static constexpr u32 HISTORY_SIZE = 120;
+
+  GPUPass GetPass() const { return m_pass; }
+  void SetPass(GPUPass pass);
+
+  // Called after presenting a frame, starts the next one and processes finished results.
+  void EndFrame();
+
+  // Draws the overlay window, only valid while building an ImGui frame.
+  void Draw();
+
+private:
+  static constexpr u32 PASS_COUNT = static_cast<u32>(GPUPass::Count);
+
+  void ProcessFrame(const std::vector<GPUPass>& passes, const std::vector<u64>& timestamps);
+  void LogFrameToFile(const std::array<float, PASS_COUNT>& pass_ms);
+
+  GPUPass m_pass = GPUPass::Draws;
+  bool m_recording = false;
+  std::vector<GPUPass> m_frame_passes;
+  std::deque<std::vector<GPUPass>> m_pending_frames;
+
+  // Milliseconds taken by each pass in the most recent frames, indexed by m_history_pos
+  std::array<std::array<float, HISTORY_SIZE>, PASS_COUNT> m_history{};
+  u32 m_history_pos = 0;
+  u64 m_frames_measured = 0;
+
+  std::ofstream m_log_file;
+};
+
+// Attributes the GPU work submitted during its lifetime to the given pass.
+class ScopedGPUPass
+{
+public:
+  explicit ScopedGPUPass(GPUPass pass);
+  ~ScopedGPUPass();
+  ScopedGPUPass(const ScopedGPUPass&) = delete;
+  ScopedGPUPass& operator=(const ScopedGPUPass&) = delete;
+
+private:
+  GPUPass m_previous_pass;
+};
+}  // namespace VideoCommon
@@ -4,6 +4,7 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -28,8 +29,8 @@
 #include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
-#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/StartupTrace.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -39,15 +40,82 @@ struct DiskTexture
   bool has_arbitrary_mipmaps;
 };
 
+struct CachedTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  size_t size;
+  // Value of s_textureCacheUseCounter when the texture was last looked up
+  u64 last_use;
+};
+
 constexpr std::string_view s_format_prefix{"tex1_"};
 
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
+static std::unordered_map<std::string, CachedTexture> s_textureCache;
 static std::mutex s_textureCacheMutex;
 static Common::Flag s_textureCacheAbortLoading;
+// Total size of the texture data in s_textureCache
+static size_t s_textureCacheSize;
+static u64 s_textureCacheUseCounter;
 
 static std::thread s_prefetcher;
 
+// The texture files of each texture directory of a game
+using TextureDirectoryIndex = std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+// Started by StartIndexing while the rest of the emulation is starting up
+static std::future<TextureDirectoryIndex> s_pending_index;
+static std::string s_pending_index_game_id;
+
+static TextureDirectoryIndex IndexTextureDirectories(const std::string& root_directory,
+                                                     const std::string& game_id)
+{
+  const std::vector<std::string> extensions{".png", ".dds"};
+  TextureDirectoryIndex index;
+  for (const std::string& directory : GetTextureDirectoriesWithGameId(root_directory, game_id))
+  {
+    index.emplace_back(directory,
+                       Common::DoFileSearch({directory}, extensions, /*recursive*/ true));
+  }
+  return index;
+}
+
+static size_t GetMaxCacheSize()
+{
+  const size_t sys_mem = Common::MemPhysical();
+  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
+  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
+  return (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+}
+
+static size_t GetTextureDataSize(const HiresTexture& texture)
+{
+  size_t size = 0;
+  for (const HiresTexture::Level& level : texture.m_levels)
+    size += level.data.size();
+  return size;
+}
+
+// Adds a texture to the cache, and makes room for it by dropping the textures that haven't been
+// used for the longest time. Must be called with s_textureCacheMutex held.
+static void InsertIntoCache(const std::string& base_filename, std::shared_ptr<HiresTexture> texture)
+{
+  const size_t size = GetTextureDataSize(*texture);
+  const size_t max_size = GetMaxCacheSize();
+  while (s_textureCacheSize + size > max_size && !s_textureCache.empty())
+  {
+    const auto oldest = std::min_element(
+        s_textureCache.begin(), s_textureCache.end(),
+        [](const auto& a, const auto& b) { return a.second.last_use < b.second.last_use; });
+    s_textureCacheSize -= oldest->second.size;
+    s_textureCache.erase(oldest);
+  }
+
+  s_textureCacheSize += size;
+  s_textureCache[base_filename] =
+      CachedTexture{std::move(texture), size, ++s_textureCacheUseCounter};
+}
+
 void HiresTexture::Init()
 {
   // Note: Update is not called here so that we handle dynamic textures on startup more gracefully
@@ -58,6 +126,19 @@ void HiresTexture::Shutdown()
   Clear();
 }
 
+void HiresTexture::StartIndexing(const std::string& game_id)
+{
+  if (s_pending_index.valid())
+    s_pending_index.wait();
+
+  const std::string root_directory = File::GetUserPath(D_HIRESTEXTURES_IDX);
+  s_pending_index_game_id = game_id;
+  s_pending_index = std::async(std::launch::async, [root_directory, game_id] {
+    StartupTrace::Span span("Index custom textures");
+    return IndexTextureDirectories(root_directory, game_id);
+  });
+}
+
 void HiresTexture::Update()
 {
   if (s_prefetcher.joinable())
@@ -75,20 +156,24 @@ void HiresTexture::Update()
   if (!g_ActiveConfig.bCacheHiresTextures)
   {
     s_textureCache.clear();
+    s_textureCacheSize = 0;
   }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
-  const std::set<std::string> texture_directories =
-      GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
-
-  for (const auto& texture_directory : texture_directories)
+  TextureDirectoryIndex index;
+  if (s_pending_index.valid())
   {
-    const auto texture_paths =
-        Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
+    index = s_pending_index.get();
+    if (s_pending_index_game_id != game_id)
+      index.clear();
+  }
+  if (index.empty())
+    index = IndexTextureDirectories(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
 
+  for (const auto& [texture_directory, texture_paths] : index)
+  {
     bool failed_insert = false;
-    for (auto& path : texture_paths)
+    for (const std::string& path : texture_paths)
     {
       std::string filename;
       SplitPath(path, nullptr, &filename, nullptr);
@@ -124,6 +209,7 @@ void HiresTexture::Update()
     {
       if (s_textureMap.find(iter->first) == s_textureMap.end())
       {
+        s_textureCacheSize -= iter->second.size;
         iter = s_textureCache.erase(iter);
       }
       else
@@ -144,8 +230,12 @@ void HiresTexture::Clear()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  // A pending index may be outdated by the time that custom textures get enabled again
+  if (s_pending_index.valid())
+    s_pending_index.get();
   s_textureMap.clear();
   s_textureCache.clear();
+  s_textureCacheSize = 0;
 }
 
 void HiresTexture::Prefetch()
@@ -153,11 +243,7 @@ void HiresTexture::Prefetch()
   Common::SetCurrentThreadName("Prefetcher");
 
   size_t size_sum = 0;
-  const size_t sys_mem = Common::MemPhysical();
-  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  const size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  const size_t max_mem = GetMaxCacheSize();
 
   const u32 start_time = Common::Timer::GetTimeMs();
   for (const auto& entry : s_textureMap)
@@ -178,14 +264,14 @@ void HiresTexture::Prefetch()
         lk.lock();
         if (texture)
         {
-          std::shared_ptr<HiresTexture> ptr(std::move(texture));
-          iter = s_textureCache.insert(iter, std::make_pair(base_filename, ptr));
+          size_sum += GetTextureDataSize(*texture);
+          if (size_sum <= max_mem)
+            InsertIntoCache(base_filename, std::move(texture));
         }
       }
-      if (iter != s_textureCache.end())
+      else
       {
-        for (const Level& l : iter->second->m_levels)
-          size_sum += l.data.size();
+        size_sum += iter->second.size;
       }
     }
 
@@ -194,14 +280,14 @@ void HiresTexture::Prefetch()
       return;
     }
 
+    // The textures that don't fit are loaded when they are used, replacing the ones that have
+    // been used least recently
     if (size_sum > max_mem)
     {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
       OSD::AddMessage(
-          fmt::format(
-              "Custom Textures prefetching after {:.1f} MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
+          fmt::format("Custom Textures prefetching stopped after {:.1f} MB, not enough RAM "
+                      "available. The remaining textures will be loaded on use.",
+                      size_sum / (1024.0 * 1024.0)),
           10000);
       return;
     }
@@ -270,7 +356,8 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(TextureInfo& texture_info)
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
-    return iter->second;
+    iter->second.last_use = ++s_textureCacheUseCounter;
+    return iter->second.texture;
   }
 
   std::shared_ptr<HiresTexture> ptr(
@@ -278,7 +365,7 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(TextureInfo& texture_info)
 
   if (ptr && g_ActiveConfig.bCacheHiresTextures)
   {
-    s_textureCache[base_filename] = ptr;
+    InsertIntoCache(base_filename, ptr);
   }
 
   return ptr;
@@ -21,6 +21,9 @@ class HiresTexture
 {
 public:
   static void Init();
+  // Searches the texture directories of the game on another thread, so that the next Update
+  // doesn't have to. The files that are added meanwhile are only found by the Update after that.
+  static void StartIndexing(const std::string& game_id);
   static void Update();
   static void Clear();
   static void Shutdown();
@@ -7,6 +7,12 @@
 #include <cstddef>
 #include <cstring>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -16,6 +22,88 @@ namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// The index patterns of several consecutive primitives, relative to the first vertex. They are
+// sized to whole vectors of eight indices.
+template <size_t N, typename F>
+constexpr std::array<u16, N> MakePattern(F f)
+{
+  static_assert(N % 8 == 0);
+  std::array<u16, N> pattern{};
+  for (size_t i = 0; i < N; ++i)
+    pattern[i] = f(i);
+  return pattern;
+}
+
+// 8 points or 4 lines
+constexpr auto s_ramp_pattern = MakePattern<8>([](size_t i) { return u16(i); });
+// 8 triangles
+constexpr auto s_list_pattern = MakePattern<24>([](size_t i) { return u16(i); });
+// 2 triangles
+constexpr auto s_list_restart_pattern = MakePattern<8>(
+    [](size_t i) { return i % 4 == 3 ? s_primitive_restart : u16(i / 4 * 3 + i % 4); });
+// 8 triangles, alternating the winding
+constexpr auto s_strip_pattern = MakePattern<24>([](size_t i) {
+  constexpr u16 offsets[] = {0, 1, 2, 1, 3, 2};
+  return u16(i / 6 * 2 + offsets[i % 6]);
+});
+// 4 lines
+constexpr auto s_line_strip_pattern = MakePattern<8>([](size_t i) { return u16((i + 1) / 2); });
+// 4 quads
+constexpr auto s_quad_pattern = MakePattern<24>([](size_t i) {
+  constexpr u16 offsets[] = {0, 1, 2, 0, 2, 3};
+  return u16(i / 6 * 4 + offsets[i % 6]);
+});
+// 8 quads
+constexpr auto s_quad_restart_pattern = MakePattern<40>([](size_t i) {
+  constexpr u16 offsets[] = {1, 2, 0, 3, s_primitive_restart};
+  return i % 5 == 4 ? s_primitive_restart : u16(i / 5 * 4 + offsets[i % 5]);
+});
+
+// Writes the pattern `count` times, advancing its vertices by `vertex_step` each time. The
+// additions saturate, which keeps the restart indices intact, while the other indices never get
+// that far as GetRemainingIndices keeps the vertex count below the restart index.
+template <size_t N>
+u16* WritePattern(u16* index_ptr, const std::array<u16, N>& pattern, u32 count, u32 index,
+                  u32 vertex_step)
+{
+#if defined(_M_X86_64)
+  __m128i offset = _mm_set1_epi16(static_cast<s16>(index));
+  const __m128i step = _mm_set1_epi16(static_cast<s16>(vertex_step));
+  for (u32 i = 0; i < count; ++i)
+  {
+    for (size_t j = 0; j < N; j += 8)
+    {
+      const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pattern[j]));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr + j), _mm_adds_epu16(indices, offset));
+    }
+    offset = _mm_add_epi16(offset, step);
+    index_ptr += N;
+  }
+#elif defined(_M_ARM_64)
+  uint16x8_t offset = vdupq_n_u16(static_cast<u16>(index));
+  const uint16x8_t step = vdupq_n_u16(static_cast<u16>(vertex_step));
+  for (u32 i = 0; i < count; ++i)
+  {
+    for (size_t j = 0; j < N; j += 8)
+      vst1q_u16(index_ptr + j, vqaddq_u16(vld1q_u16(&pattern[j]), offset));
+    offset = vaddq_u16(offset, step);
+    index_ptr += N;
+  }
+#else
+  for (u32 i = 0; i < count; ++i)
+  {
+    for (size_t j = 0; j < N; ++j)
+    {
+      index_ptr[j] = pattern[j] == s_primitive_restart ?
+                         s_primitive_restart :
+                         static_cast<u16>(pattern[j] + index + i * vertex_step);
+    }
+    index_ptr += N;
+  }
+#endif
+  return index_ptr;
+}
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -30,7 +118,21 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 template <bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
+  u32 i = 2;
+  if constexpr (pr)
+  {
+    const u32 count = num_verts / 6;
+    index_ptr = WritePattern(index_ptr, s_list_restart_pattern, count, index, 6);
+    i += count * 6;
+  }
+  else
+  {
+    const u32 count = num_verts / 24;
+    index_ptr = WritePattern(index_ptr, s_list_pattern, count, index, 24);
+    i += count * 24;
+  }
+
+  for (; i < num_verts; i += 3)
   {
     index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
   }
@@ -42,7 +144,9 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
+    const u32 count = num_verts / 8;
+    index_ptr = WritePattern(index_ptr, s_ramp_pattern, count, index, 8);
+    for (u32 i = count * 8; i < num_verts; ++i)
     {
       *index_ptr++ = index + i;
     }
@@ -50,8 +154,12 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
+    // Whole blocks of the pattern end on an even number of triangles, so the winding restarts
+    const u32 count = num_verts > 2 ? (num_verts - 2) / 8 : 0;
+    index_ptr = WritePattern(index_ptr, s_strip_pattern, count, index, 8);
+
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    for (u32 i = 2 + count * 8; i < num_verts; ++i)
     {
       index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -135,6 +243,19 @@ template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 3;
+  if constexpr (pr)
+  {
+    const u32 count = num_verts / 32;
+    index_ptr = WritePattern(index_ptr, s_quad_restart_pattern, count, index, 32);
+    i += count * 32;
+  }
+  else
+  {
+    const u32 count = num_verts / 16;
+    index_ptr = WritePattern(index_ptr, s_quad_pattern, count, index, 16);
+    i += count * 16;
+  }
+
   for (; i < num_verts; i += 4)
   {
     if constexpr (pr)
@@ -170,7 +291,10 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
+  const u32 count = num_verts / 8;
+  index_ptr = WritePattern(index_ptr, s_ramp_pattern, count, index, 8);
+
+  for (u32 i = 1 + count * 8; i < num_verts; i += 2)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -182,7 +306,10 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  const u32 count = num_verts > 1 ? (num_verts - 1) / 4 : 0;
+  index_ptr = WritePattern(index_ptr, s_line_strip_pattern, count, index, 4);
+
+  for (u32 i = 1 + count * 4; i < num_verts; ++i)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -192,7 +319,10 @@ u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 0; i != num_verts; ++i)
+  const u32 count = num_verts / 8;
+  index_ptr = WritePattern(index_ptr, s_ramp_pattern, count, index, 8);
+
+  for (u32 i = count * 8; i != num_verts; ++i)
   {
     *index_ptr++ = index + i;
   }
@@ -13,10 +13,9 @@
 #include <imgui.h>
 
 #include "Common/CommonTypes.h"
-#include "Common/Config/Config.h"
 #include "Common/Timer.h"
 
-#include "Core/Config/MainSettings.h"
+#include "Core/Config/ConfigSnapshot.h"
 
 namespace OSD
 {
@@ -105,7 +104,7 @@ void AddMessage(std::string message, u32 ms, u32 argb)
 
 void DrawMessages()
 {
-  const bool draw_messages = Config::Get(Config::MAIN_OSD_MESSAGES);
+  const bool draw_messages = Config::GetSnapshot().osd_messages;
   const u32 now = Common::Timer::GetTimeMs();
   const float current_x =
       LEFT_MARGIN * ImGui::GetIO().DisplayFramebufferScale.x + s_obscured_pixels_left;
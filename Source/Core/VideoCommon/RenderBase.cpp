@@ -16,10 +16,13 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <imgui.h>
@@ -37,8 +40,10 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
 
-#include "Core/Config/NetplaySettings.h"
+#include "Core/CPUTimeBreakdown.h"
+#include "Core/Config/ConfigSnapshot.h"
 #include "Core/Config/SYSCONFSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -48,6 +53,7 @@
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
+#include "Core/LUA/Lua.h"
 #include "Core/Movie.h"
 
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
@@ -60,6 +66,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/FrameBenchmark.h"
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
@@ -71,6 +78,7 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/PostProcessing.h"
+#include "VideoCommon/ScriptOverlay.h"
 #include "VideoCommon/ShaderCache.h"
 #include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/Statistics.h"
@@ -91,6 +99,14 @@ static float AspectToWidescreen(float aspect)
   return aspect * ((16.0f / 9.0f) / (4.0f / 3.0f));
 }
 
+// At most this many threads encode PNG frame dumps, and each of them has at most this many frames
+// queued before the frame dump thread waits.
+constexpr u32 MAX_IMAGE_DUMP_THREADS = 8;
+constexpr size_t IMAGE_DUMPS_PER_THREAD = 2;
+
+// Savestate thumbnails are scaled to this width, keeping the displayed aspect ratio.
+constexpr u32 STATE_THUMBNAIL_WIDTH = 160;
+
 static bool DumpFrameToPNG(const FrameDump::FrameData& frame, const std::string& file_name)
 {
   return Common::ConvertRGBAToRGBAndSavePNG(file_name, frame.data, frame.width, frame.height,
@@ -189,6 +205,7 @@ u16 Renderer::BBoxRead(int index)
   if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
     return m_bounding_box_fallback[index];
 
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::BoundingBox);
   return BBoxReadImpl(index);
 }
 
@@ -205,6 +222,7 @@ void Renderer::BBoxWrite(int index, u16 value)
 
 void Renderer::BBoxFlush()
 {
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::BoundingBox);
   BBoxFlushImpl();
 }
 
@@ -422,6 +440,113 @@ void Renderer::SaveScreenshot(std::string filename)
   m_screenshot_request.Set();
 }
 
+void Renderer::RequestStateThumbnail()
+{
+  m_state_thumbnail_requested.Set();
+}
+
+void Renderer::QueueStateThumbnail()
+{
+  m_state_thumbnail_queued = false;
+  if (!m_state_thumbnail_requested.IsSet() || !m_last_xfb_addr || !m_last_xfb_width ||
+      !m_last_xfb_stride || !m_last_xfb_height)
+  {
+    return;
+  }
+
+  // Don't decode the XFB from RAM, that would add a copy to the texture cache while it is saved.
+  MathUtil::Rectangle<int> xfb_rect;
+  const auto* xfb_entry = g_texture_cache->GetCachedXFBTexture(
+      m_last_xfb_addr, m_last_xfb_width, m_last_xfb_height, m_last_xfb_stride, &xfb_rect);
+  if (!xfb_entry)
+    return;
+
+  const auto [output_width, output_height] =
+      CalculateOutputDimensions(xfb_rect.GetWidth(), xfb_rect.GetHeight());
+  const u32 width = STATE_THUMBNAIL_WIDTH;
+  const u32 height = std::max<u32>(
+      static_cast<u32>(u64{width} * std::max(output_height, 1) / std::max(output_width, 1)), 1);
+  if (!CheckStateThumbnailTextures(width, height))
+    return;
+
+  ScaleTexture(m_state_thumbnail_framebuffer.get(), m_state_thumbnail_framebuffer->GetRect(),
+               xfb_entry->texture.get(), xfb_rect);
+  m_state_thumbnail_readback->CopyFromTexture(m_state_thumbnail_texture.get(),
+                                              m_state_thumbnail_texture->GetRect(), 0, 0,
+                                              m_state_thumbnail_readback->GetRect());
+  m_state_thumbnail_queued = true;
+}
+
+StateThumbnail Renderer::TakeStateThumbnail()
+{
+  m_state_thumbnail_requested.Clear();
+  return std::exchange(m_state_thumbnail, {});
+}
+
+bool Renderer::CheckStateThumbnailTextures(u32 width, u32 height)
+{
+  if (m_state_thumbnail_texture && m_state_thumbnail_texture->GetWidth() == width &&
+      m_state_thumbnail_texture->GetHeight() == height)
+  {
+    return true;
+  }
+
+  m_state_thumbnail_framebuffer.reset();
+  m_state_thumbnail_texture.reset();
+  m_state_thumbnail_readback.reset();
+  m_state_thumbnail_texture =
+      CreateTexture(TextureConfig(width, height, 1, 1, 1, AbstractTextureFormat::RGBA8,
+                                  AbstractTextureFlag_RenderTarget));
+  if (!m_state_thumbnail_texture)
+    return false;
+
+  m_state_thumbnail_framebuffer = CreateFramebuffer(m_state_thumbnail_texture.get(), nullptr);
+  m_state_thumbnail_readback =
+      CreateStagingTexture(StagingTextureType::Readback,
+                           TextureConfig(width, height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
+  if (!m_state_thumbnail_framebuffer || !m_state_thumbnail_readback)
+  {
+    m_state_thumbnail_framebuffer.reset();
+    m_state_thumbnail_texture.reset();
+    m_state_thumbnail_readback.reset();
+    return false;
+  }
+
+  return true;
+}
+
+void Renderer::FinishStateThumbnail()
+{
+  if (!m_state_thumbnail_queued)
+    return;
+
+  m_state_thumbnail_queued = false;
+
+  // The readbacks of the EFB and the texture cache were queued after the thumbnail and have
+  // already waited for the GPU, so this doesn't stall again.
+  m_state_thumbnail_readback->Flush();
+  if (!m_state_thumbnail_readback->Map())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to map the savestate thumbnail");
+    return;
+  }
+
+  const u32 width = m_state_thumbnail_readback->GetWidth();
+  const u32 height = m_state_thumbnail_readback->GetHeight();
+  const size_t row_size = width * sizeof(u32);
+  m_state_thumbnail.width = width;
+  m_state_thumbnail.height = height;
+  m_state_thumbnail.data.resize(row_size * height);
+  for (u32 y = 0; y < height; y++)
+  {
+    std::memcpy(&m_state_thumbnail.data[y * row_size],
+                m_state_thumbnail_readback->GetMappedPointer() +
+                    y * m_state_thumbnail_readback->GetMappedStride(),
+                row_size);
+  }
+  m_state_thumbnail_readback->Unmap();
+}
+
 void Renderer::CheckForConfigChanges()
 {
   const ShaderHostConfig old_shader_host_config = ShaderHostConfig::GetCurrent();
@@ -542,6 +667,11 @@ void Renderer::DrawDebugText()
                          ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
     {
       ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "FPS: %.2f", m_fps_counter.GetFPS());
+      if (IsPresentingToWindow())
+      {
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "Latency: %.1f ms",
+                           m_present_latency_ms);
+      }
     }
     ImGui::End();
   }
@@ -581,17 +711,59 @@ void Renderer::DrawDebugText()
   }
 
   if (g_ActiveConfig.bOverlayStats)
+  {
     g_stats.Display();
 
+    const std::vector<Lua::ScriptTiming> lua_timings = Lua::GetScriptTimings();
+    if (!lua_timings.empty())
+    {
+      if (ImGui::Begin("Lua Scripts", nullptr,
+                       ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_AlwaysAutoResize))
+      {
+        for (const Lua::ScriptTiming& timing : lua_timings)
+        {
+          ImGui::Text("%s: %.2f ms (avg %.2f ms)", timing.fileName.c_str(),
+                      timing.lastFrameUs / 1000.0,
+                      timing.frames ? timing.totalUs / 1000.0 / timing.frames : 0.0);
+        }
+      }
+      ImGui::End();
+    }
+
+    const CPUTimeBreakdown::FrameBreakdown breakdown = CPUTimeBreakdown::GetLastFrame();
+    if (breakdown.frame_ms > 0.0)
+    {
+      if (ImGui::Begin("CPU Thread", nullptr,
+                       ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_AlwaysAutoResize))
+      {
+        ImGui::Text("Frame: %.2f ms", breakdown.frame_ms);
+        ImGui::Text("Emulated code: %.2f ms", breakdown.emulated_code_ms);
+        for (const CPUTimeBreakdown::FrameEntry& entry : breakdown.entries)
+        {
+          ImGui::Text("%s %s: %.2f ms (%" PRIu64 " calls)",
+                      CPUTimeBreakdown::GetCategoryName(entry.category), entry.name.c_str(),
+                      entry.time_ms, entry.calls);
+        }
+      }
+      ImGui::End();
+    }
+  }
+
   if (g_ActiveConfig.bShowNetPlayMessages && g_netplay_chat_ui)
     g_netplay_chat_ui->Display();
 
-  if (Config::Get(Config::NETPLAY_GOLF_MODE_OVERLAY) && g_netplay_golf_ui)
+  if (Config::GetSnapshot().netplay_golf_mode_overlay && g_netplay_golf_ui)
     g_netplay_golf_ui->Display();
 
   if (g_ActiveConfig.bOverlayProjStats)
     g_stats.DisplayProj();
 
+  if (g_ActiveConfig.bShowGPUTimings)
+    m_gpu_timings.Draw();
+
+  if (g_ActiveConfig.bShowFrameTimes)
+    m_frame_times.Draw();
+
   const std::string profile_output = Common::Profiler::ToString();
   if (!profile_output.empty())
     ImGui::TextUnformatted(profile_output.c_str());
@@ -1236,8 +1408,11 @@ void Renderer::UpdateWidescreenHeuristic()
   m_was_orthographically_anamorphic = ortho_looks_anamorphic;
 }
 
-void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks)
+void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks,
+                    u64 output_time_us)
 {
+  TRACE_SCOPE("Renderer::Swap");
+
   if (SConfig::GetInstance().bWii)
     m_is_game_widescreen = Config::Get(Config::SYSCONF_WIDESCREEN);
 
@@ -1284,13 +1459,14 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         auto lock = GetImGuiLock();
 
         DrawDebugText();
+        ScriptOverlay::Draw();
         OSD::DrawMessages();
         ImGui::Render();
       }
 
       // Render the XFB to the screen.
       BeginUtilityDrawing();
-      if (!IsHeadless())
+      if (IsPresentingToWindow())
       {
         BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
 
@@ -1304,15 +1480,29 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         auto render_source_rc = xfb_rect;
         AdjustRectanglesToFitBounds(&render_target_rc, &render_source_rc, m_backbuffer_width,
                                     m_backbuffer_height);
-        RenderXFBToScreen(render_target_rc, xfb_entry->texture.get(), render_source_rc);
-
-        DrawImGui();
+        {
+          VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::PostProcessing);
+          RenderXFBToScreen(render_target_rc, xfb_entry->texture.get(), render_source_rc);
+        }
 
-        // Present to the window system.
         {
+          VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::Present);
+          DrawImGui();
+
+          // Present to the window system.
           std::lock_guard<std::mutex> guard(m_swap_mutex);
           PresentBackbuffer();
         }
+        m_gpu_timings.EndFrame();
+
+        if (!is_duplicate_frame)
+        {
+          // This covers the GPU thread catching up with the CPU thread and the wait for the
+          // swap chain, but not the display's own latency.
+          const double latency_ms =
+              static_cast<double>(Common::Timer::GetTimeUs() - output_time_us) / 1000.0;
+          m_present_latency_ms = m_present_latency_ms * 0.9 + latency_ms * 0.1;
+        }
 
         // Update the window size based on the frame that was just rendered.
         // Due to depending on guest state, we need to call this every frame.
@@ -1322,6 +1512,8 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
       if (!is_duplicate_frame)
       {
         m_fps_counter.Update();
+        m_frame_times.OnFramePresented(m_frame_count, m_fps_counter.GetDeltaTime() * 1000.0,
+                                       g_stats.this_frame);
 
         DolphinAnalytics::PerformanceSample perf_sample;
         perf_sample.speed_ratio = SystemTimers::GetEstimatedEmulationPerformance();
@@ -1332,6 +1524,9 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         if (IsFrameDumping())
           DumpCurrentFrame(xfb_entry->texture.get(), xfb_rect, ticks, m_frame_count);
 
+        if (FrameBenchmark::IsActive())
+          FrameBenchmark::OnFramePresented(g_stats.this_frame);
+
         // Begin new frame
         m_frame_count++;
         g_stats.ResetFrame();
@@ -1424,6 +1619,14 @@ bool Renderer::IsFrameDumping() const
   return false;
 }
 
+bool Renderer::IsPresentingToWindow() const
+{
+  if (IsHeadless())
+    return false;
+
+  return !(g_ActiveConfig.bFastFrameDumps && SConfig::GetInstance().m_DumpFrames);
+}
+
 void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
                                 const MathUtil::Rectangle<int>& src_rect, u64 ticks,
                                 int frame_number)
@@ -1431,7 +1634,7 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
   int source_width = src_rect.GetWidth();
   int source_height = src_rect.GetHeight();
   int target_width, target_height;
-  if (!g_ActiveConfig.bInternalResolutionFrameDumps && !IsHeadless())
+  if (!g_ActiveConfig.bInternalResolutionFrameDumps && IsPresentingToWindow())
   {
     auto target_rect = GetTargetRectangle();
     target_width = target_rect.GetWidth();
@@ -1654,9 +1857,10 @@ void Renderer::FrameDumpThreadFunc()
 
   if (frame_dump_started)
   {
-    // No additional cleanup is needed when dumping to images.
     if (dump_to_ffmpeg)
       StopFrameDumpToFFMPEG();
+    else
+      StopFrameDumpToImage();
   }
 }
 
@@ -1707,6 +1911,7 @@ std::string Renderer::GetFrameDumpNextImageFileName() const
 bool Renderer::StartFrameDumpToImage(const FrameDump::FrameData&)
 {
   m_frame_dump_image_counter = 1;
+  m_next_image_dump_worker = 0;
   if (!SConfig::GetInstance().m_DumpFramesSilent)
   {
     // Only check for the presence of the first image to confirm overwriting.
@@ -1720,15 +1925,59 @@ bool Renderer::StartFrameDumpToImage(const FrameDump::FrameData&)
     }
   }
 
+  const u32 worker_count =
+      std::clamp(std::thread::hardware_concurrency(), 2u, MAX_IMAGE_DUMP_THREADS + 1) - 1;
+  for (u32 i = 0; i < worker_count; ++i)
+  {
+    m_image_dump_workers.push_back(std::make_unique<Common::WorkQueueThread<ImageDumpJob>>(
+        [this](ImageDumpJob job) {
+          Common::ConvertRGBAToRGBAndSavePNG(job.file_name, job.data.data(), job.width,
+                                             job.height, job.stride);
+
+          std::lock_guard lk(m_image_dump_mutex);
+          m_pending_image_dumps--;
+          m_image_dump_done.notify_one();
+        }));
+  }
+
   return true;
 }
 
 void Renderer::DumpFrameToImage(const FrameDump::FrameData& frame)
 {
-  DumpFrameToPNG(frame, GetFrameDumpNextImageFileName());
+  const size_t max_pending = m_image_dump_workers.size() * IMAGE_DUMPS_PER_THREAD;
+  {
+    std::unique_lock lk(m_image_dump_mutex);
+    if (m_pending_image_dumps >= max_pending)
+    {
+      OSD::AddTypedMessage(
+          OSD::MessageType::FrameDumpQueue,
+          fmt::format("Frame dump: waiting for {} queued images to be written",
+                      m_pending_image_dumps),
+          OSD::Duration::SHORT, OSD::Color::RED);
+      m_image_dump_done.wait(lk, [&] { return m_pending_image_dumps < max_pending; });
+    }
+    m_pending_image_dumps++;
+  }
+
+  // The frame data is only valid until the next frame is dumped, so the workers get a copy.
+  const size_t size = static_cast<size_t>(frame.stride) * frame.height;
+  m_image_dump_workers[m_next_image_dump_worker]->EmplaceItem(
+      ImageDumpJob{std::vector<u8>(frame.data, frame.data + size), frame.width, frame.height,
+                   frame.stride, GetFrameDumpNextImageFileName()});
+  m_next_image_dump_worker = (m_next_image_dump_worker + 1) % m_image_dump_workers.size();
   m_frame_dump_image_counter++;
 }
 
+void Renderer::StopFrameDumpToImage()
+{
+  {
+    std::unique_lock lk(m_image_dump_mutex);
+    m_image_dump_done.wait(lk, [this] { return m_pending_image_dumps == 0; });
+  }
+  m_image_dump_workers.clear();
+}
+
 bool Renderer::UseVertexDepthRange() const
 {
   // We can't compute the depth range in the vertex shader if we don't support depth clamp.
@@ -1760,6 +2009,9 @@ void Renderer::DoState(PointerWrap& p)
   p.Do(m_last_xfb_height);
   p.DoArray(m_bounding_box_fallback);
 
+  if (p.GetMode() == PointerWrap::MODE_WRITE)
+    FinishStateThumbnail();
+
   if (p.GetMode() == PointerWrap::MODE_READ)
   {
     // Force the next xfb to be displayed.
@@ -1768,7 +2020,8 @@ void Renderer::DoState(PointerWrap& p)
     m_was_orthographically_anamorphic = false;
 
     // And actually display it.
-    Swap(m_last_xfb_addr, m_last_xfb_width, m_last_xfb_stride, m_last_xfb_height, m_last_xfb_ticks);
+    Swap(m_last_xfb_addr, m_last_xfb_width, m_last_xfb_stride, m_last_xfb_height, m_last_xfb_ticks,
+         Common::Timer::GetTimeUs());
   }
 
 #if defined(HAVE_FFMPEG)
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -26,10 +27,13 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/AsyncShaderCompiler.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/FrameDump.h"
+#include "VideoCommon/FrameTimes.h"
+#include "VideoCommon/GPUTimings.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/TextureConfig.h"
 
@@ -62,6 +66,14 @@ struct EfbPokeData
   u32 data;
 };
 
+// A downscaled copy of the last presented frame, in RGBA8 without padding.
+struct StateThumbnail
+{
+  std::vector<u8> data;
+  u32 width = 0;
+  u32 height = 0;
+};
+
 // Renderer really isn't a very good name for this class - it's more like "Misc".
 // The long term goal is to get rid of this class and replace it with others that make
 // more sense.
@@ -124,6 +136,14 @@ public:
   // Presents the backbuffer to the window system, or "swaps buffers".
   virtual void PresentBackbuffer() {}
 
+  // Timestamp queries for the GPU timing overlay. A timestamp is taken once all previously
+  // submitted GPU work has completed. Timestamps are grouped per frame, and groups are read back
+  // in the order they were ended, in nanoseconds. Returns false if the oldest group isn't ready.
+  virtual bool SupportsGPUTimestamps() const { return false; }
+  virtual void WriteGPUTimestamp() {}
+  virtual void EndGPUTimestampGroup() {}
+  virtual bool ReadGPUTimestampGroup(std::vector<u64>* timestamps) { return false; }
+
   // Shader modules/objects.
   virtual std::unique_ptr<AbstractShader> CreateShaderFromSource(ShaderStage stage,
                                                                  std::string_view source,
@@ -202,6 +222,12 @@ public:
 
   // Random utilities
   void SaveScreenshot(std::string filename);
+
+  // Thumbnails of savestates. The CPU thread requests one before writing the state, the copy is
+  // queued on the GPU with the other readbacks of the state and taken after the state is written.
+  void RequestStateThumbnail();
+  void QueueStateThumbnail();
+  StateThumbnail TakeStateThumbnail();
   void DrawDebugText();
 
   virtual void ClearScreen(const MathUtil::Rectangle<int>& rc, bool colorEnable, bool alphaEnable,
@@ -220,8 +246,10 @@ public:
   virtual void Flush() {}
   virtual void WaitForGPUIdle() {}
 
-  // Finish up the current frame, print some stats
-  void Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks);
+  // Finish up the current frame, print some stats. output_time_us is the host time at which the
+  // emulated console output the frame, which is used to measure the latency until presentation.
+  void Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks,
+            u64 output_time_us);
 
   void UpdateWidescreenHeuristic();
 
@@ -238,6 +266,8 @@ public:
   void StorePixelFormat(PixelFormat new_format) { m_prev_efb_format = new_format; }
   bool EFBHasAlphaChannel() const;
   VideoCommon::PostProcessing* GetPostProcessor() const { return m_post_processor.get(); }
+  VideoCommon::GPUTimings& GetGPUTimings() { return m_gpu_timings; }
+  FrameDump& GetFrameDump() { return m_frame_dump; }
   // Final surface changing
   // This is called when the surface is resized (WX) or the window changes (Android).
   void ChangeSurface(void* new_surface_handle);
@@ -331,6 +361,10 @@ protected:
   int m_frame_count = 0;
 
   FPSCounter m_fps_counter;
+  VideoCommon::GPUTimings m_gpu_timings;
+  VideoCommon::FrameTimes m_frame_times;
+  // Smoothed time from the console outputting a frame until it was presented
+  double m_present_latency_ms = 0.0;
 
   std::unique_ptr<VideoCommon::PostProcessing> m_post_processor;
 
@@ -388,6 +422,30 @@ private:
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
 
+  // Savestate thumbnails, the staging texture is mapped by DoState.
+  Common::Flag m_state_thumbnail_requested;
+  std::unique_ptr<AbstractTexture> m_state_thumbnail_texture;
+  std::unique_ptr<AbstractFramebuffer> m_state_thumbnail_framebuffer;
+  std::unique_ptr<AbstractStagingTexture> m_state_thumbnail_readback;
+  bool m_state_thumbnail_queued = false;
+  StateThumbnail m_state_thumbnail;
+
+  // PNG frame dumps are encoded on several threads. The frame dump thread waits when too many
+  // frames are queued, which bounds the memory used by the copies of the frames.
+  struct ImageDumpJob
+  {
+    std::vector<u8> data;
+    int width;
+    int height;
+    int stride;
+    std::string file_name;
+  };
+  std::vector<std::unique_ptr<Common::WorkQueueThread<ImageDumpJob>>> m_image_dump_workers;
+  size_t m_next_image_dump_worker = 0;
+  std::mutex m_image_dump_mutex;
+  std::condition_variable m_image_dump_done;
+  size_t m_pending_image_dumps = 0;
+
   // Tracking of XFB textures so we don't render duplicate frames.
   u64 m_last_xfb_id = std::numeric_limits<u64>::max();
   u64 m_last_xfb_ticks = 0;
@@ -416,17 +474,27 @@ private:
   std::string GetFrameDumpNextImageFileName() const;
   bool StartFrameDumpToImage(const FrameDump::FrameData&);
   void DumpFrameToImage(const FrameDump::FrameData&);
+  void StopFrameDumpToImage();
 
   void ShutdownFrameDumping();
 
   bool IsFrameDumping() const;
 
+  // Frames are only dumped, not presented to the window, while fast frame dumps are enabled.
+  bool IsPresentingToWindow() const;
+
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
   // Checks that the frame dump readback texture exists and is the correct size.
   bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
 
+  // Checks that the savestate thumbnail textures exist and are the correct size.
+  bool CheckStateThumbnailTextures(u32 width, u32 height);
+
+  // Copies the queued savestate thumbnail out of its staging texture.
+  void FinishStateThumbnail();
+
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks, int frame_number);
@@ -34,6 +34,11 @@ void DepthState::Generate(const BPMemory& bp)
   testenable = bp.zmode.testenable.Value();
   updateenable = bp.zmode.updateenable.Value();
   func = bp.zmode.func.Value();
+
+  // Nothing is written without the test, and a test that always passes without writing is the same
+  // as no test. Leaving the other bits out keeps these from becoming separate pipelines.
+  if (!testenable || (func == CompareMode::Always && !updateenable))
+    hex = 0;
 }
 
 DepthState& DepthState::operator=(const DepthState& rhs)
@@ -177,6 +182,13 @@ void BlendingState::Generate(const BPMemory& bp)
       }
     }
   }
+
+  // When neither color nor alpha is written, the blend mode makes no difference.
+  if (!colorupdate && !alphaupdate)
+  {
+    hex = 0;
+    usedualsrc = true;
+  }
 }
 
 void BlendingState::ApproximateLogicOpWithBlending()
@@ -0,0 +1,157 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/ScriptOverlay.h"
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <imgui.h>
+
+#include "Common/CommonTypes.h"
+
+namespace ScriptOverlay
+{
+namespace
+{
+enum class CommandType : u8
+{
+  Text,
+  Line,
+  Rect,
+  FilledRect,
+};
+
+struct Command
+{
+  CommandType type;
+  u32 color;
+  float x1;
+  float y1;
+  float x2;
+  float y2;
+  float thickness;
+  // The range of the text in the text of the list
+  u32 text_offset;
+  u32 text_length;
+};
+
+struct CommandList
+{
+  std::vector<Command> commands;
+  std::string text;
+};
+
+// Set in the index of the published list until the video thread takes it
+constexpr u8 NEW_LIST = 0x80;
+}  // namespace
+
+static std::array<CommandList, 3> s_lists;
+// Owned by the CPU thread and the video thread respectively
+static u8 s_write_index = 0;
+static u8 s_read_index = 1;
+static std::atomic<u8> s_published_index{2};
+// Whether the list being written has to be published at the end of the frame
+static bool s_write_dirty = false;
+
+static ImU32 ToImGuiColor(u32 color)
+{
+  // ImGui stores red in the lowest byte
+  return (color & 0xFF00FF00) | ((color >> 16) & 0xFF) | ((color & 0xFF) << 16);
+}
+
+static void AddCommand(const Command& command)
+{
+  s_lists[s_write_index].commands.push_back(command);
+  s_write_dirty = true;
+}
+
+void AddText(float x, float y, u32 color, std::string_view text)
+{
+  std::string& list_text = s_lists[s_write_index].text;
+  const u32 offset = static_cast<u32>(list_text.size());
+  list_text.append(text);
+  AddCommand({CommandType::Text, color, x, y, 0.0f, 0.0f, 0.0f, offset,
+              static_cast<u32>(text.size())});
+}
+
+void AddLine(float x1, float y1, float x2, float y2, u32 color, float thickness)
+{
+  AddCommand({CommandType::Line, color, x1, y1, x2, y2, thickness, 0, 0});
+}
+
+void AddRect(float x1, float y1, float x2, float y2, u32 color, float thickness, bool filled)
+{
+  AddCommand({filled ? CommandType::FilledRect : CommandType::Rect, color, x1, y1, x2, y2,
+              thickness, 0, 0});
+}
+
+void ClearFrame()
+{
+  s_write_dirty = true;
+}
+
+void EndFrame()
+{
+  if (!s_write_dirty)
+    return;
+
+  // The list which comes back is either the one the video thread dropped or the one it never took
+  s_write_index =
+      s_published_index.exchange(s_write_index | NEW_LIST, std::memory_order_acq_rel) & ~NEW_LIST;
+  CommandList& list = s_lists[s_write_index];
+  list.commands.clear();
+  list.text.clear();
+  s_write_dirty = false;
+}
+
+void Clear()
+{
+  CommandList& list = s_lists[s_write_index];
+  list.commands.clear();
+  list.text.clear();
+  ClearFrame();
+  EndFrame();
+}
+
+void Draw()
+{
+  if (s_published_index.load(std::memory_order_relaxed) & NEW_LIST)
+  {
+    s_read_index =
+        s_published_index.exchange(s_read_index, std::memory_order_acq_rel) & ~NEW_LIST;
+  }
+
+  const CommandList& list = s_lists[s_read_index];
+  if (list.commands.empty())
+    return;
+
+  ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+  for (const Command& command : list.commands)
+  {
+    const ImVec2 p1(command.x1, command.y1);
+    const ImVec2 p2(command.x2, command.y2);
+    const ImU32 color = ToImGuiColor(command.color);
+    switch (command.type)
+    {
+    case CommandType::Text:
+    {
+      const char* text = list.text.data() + command.text_offset;
+      draw_list->AddText(p1, color, text, text + command.text_length);
+      break;
+    }
+    case CommandType::Line:
+      draw_list->AddLine(p1, p2, color, command.thickness);
+      break;
+    case CommandType::Rect:
+      draw_list->AddRect(p1, p2, color, 0.0f, ImDrawCornerFlags_All, command.thickness);
+      break;
+    case CommandType::FilledRect:
+      draw_list->AddRectFilled(p1, p2, color);
+      break;
+    }
+  }
+}
+}  // namespace ScriptOverlay
@@ -0,0 +1,34 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+
+// Text and shapes drawn over the game by scripts. The scripts add commands to a list on the CPU
+// thread, which is published at the end of each frame and drawn with ImGui on the video thread
+// until the next one is published. The lists take turns in three buffers which are handed over
+// with an atomic exchange, so neither thread waits for the other, and their capacity is reused
+// so that steady HUDs don't allocate.
+//
+// Positions are in pixels of the render window. Colors are 0xAARRGGBB.
+namespace ScriptOverlay
+{
+// Only called from the CPU thread
+void AddText(float x, float y, u32 color, std::string_view text);
+void AddLine(float x1, float y1, float x2, float y2, u32 color, float thickness);
+void AddRect(float x1, float y1, float x2, float y2, u32 color, float thickness, bool filled);
+// Publishes an empty list at the end of the frame even if nothing was added
+void ClearFrame();
+// Publishes the commands added since the last frame, if there are any. Otherwise the previous
+// list stays on screen.
+void EndFrame();
+
+// Removes the overlay, from the thread which stopped the CPU thread
+void Clear();
+
+// Draws the last published list, only valid while building an ImGui frame on the video thread
+void Draw();
+}  // namespace ScriptOverlay
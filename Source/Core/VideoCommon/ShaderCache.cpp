@@ -3,9 +3,15 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <set>
+#include <string>
+#include <vector>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/FramebufferManager.h"
@@ -23,6 +29,31 @@ std::unique_ptr<VideoCommon::ShaderCache> g_shader_cache;
 
 namespace VideoCommon
 {
+template <typename Uid>
+static std::pair<const u8*, u32>
+FindPipelineCacheData(const std::map<Uid, std::pair<const u8*, u32>>& cache_data, const Uid& uid)
+{
+  const auto iter = cache_data.find(uid);
+  return iter != cache_data.end() ? iter->second : std::pair<const u8*, u32>(nullptr, 0);
+}
+
+// Creates the pipeline from its data in the disk cache if there is any. Drivers reject the data
+// after an update, in which case the pipeline is compiled from scratch.
+static std::unique_ptr<AbstractPipeline>
+CreatePipelineFromCacheData(const AbstractPipelineConfig& config,
+                            const std::pair<const u8*, u32>& cache_data, bool* from_cache_data)
+{
+  if (cache_data.first)
+  {
+    auto pipeline = g_renderer->CreatePipeline(config, cache_data.first, cache_data.second);
+    *from_cache_data = pipeline != nullptr;
+    if (pipeline)
+      return pipeline;
+  }
+
+  return g_renderer->CreatePipeline(config);
+}
+
 ShaderCache::ShaderCache() : m_api_type{APIType::Nothing}
 {
 }
@@ -46,6 +77,13 @@ bool ShaderCache::Initialize()
 
 void ShaderCache::InitializeShaderCache()
 {
+  // Nothing is compiled when only collecting pipeline UIDs.
+  if (g_ActiveConfig.IsCollectingPipelineUIDs())
+  {
+    OpenPipelineUIDCollectionFile();
+    return;
+  }
+
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
 
   // Load shader and UID caches.
@@ -53,6 +91,8 @@ void ShaderCache::InitializeShaderCache()
   {
     LoadCaches();
     LoadPipelineUIDCache();
+    if (g_ActiveConfig.bSharedPipelineUIDCache)
+      LoadSharedPipelineUIDCache();
   }
 
   // Queue ubershader precompiling if required.
@@ -70,6 +110,9 @@ void ShaderCache::InitializeShaderCache()
 
 void ShaderCache::Reload()
 {
+  if (g_ActiveConfig.IsCollectingPipelineUIDs())
+    return;
+
   WaitForAsyncCompiler();
   ClosePipelineUIDCache();
   ClearCaches();
@@ -110,17 +153,30 @@ void ShaderCache::Shutdown()
 const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 {
   auto it = m_gx_pipeline_cache.find(uid);
+  if (it != m_gx_pipeline_cache.end() && !m_shared_only_pipeline_uids.empty())
+    RecordSharedPipelineUID(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
+  const u64 start_time_us = Common::Timer::GetTimeUs();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
+  bool from_cache_data = false;
   if (pipeline_config)
-    pipeline = g_renderer->CreatePipeline(*pipeline_config);
+  {
+    // The pipeline may still be queued for creation from the disk cache.
+    const auto cache_data = FindPipelineCacheData(m_gx_pipeline_cache_data, uid);
+    pipeline = CreatePipelineFromCacheData(*pipeline_config, cache_data, &from_cache_data);
+    if (cache_data.first && !from_cache_data)
+      OnStalePipelineCacheData();
+  }
+  INCSTAT(g_stats.this_frame.num_pipeline_compile_stalls);
+  ADDSTAT(g_stats.this_frame.pipeline_compile_stall_us,
+          Common::Timer::GetTimeUs() - start_time_us);
   if (g_ActiveConfig.bShaderCache && !exists_in_cache)
     AppendGXPipelineUID(uid);
-  return InsertGXPipeline(uid, std::move(pipeline));
+  return InsertGXPipeline(uid, std::move(pipeline), from_cache_data);
 }
 
 std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
@@ -128,13 +184,19 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end())
   {
+    if (!m_shared_only_pipeline_uids.empty())
+      RecordSharedPipelineUID(uid);
+
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
       return it->second.first.get();
-    else
-      return {};
+
+    INCSTAT(g_stats.this_frame.num_async_pipeline_misses);
+    PromotePipelineCompile(uid);
+    return {};
   }
 
+  INCSTAT(g_stats.this_frame.num_async_pipeline_misses);
   AppendGXPipelineUID(uid);
   QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
   return {};
@@ -146,15 +208,43 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  const u64 start_time_us = Common::Timer::GetTimeUs();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
+  bool from_cache_data = false;
   if (pipeline_config)
-    pipeline = g_renderer->CreatePipeline(*pipeline_config);
-  return InsertGXUberPipeline(uid, std::move(pipeline));
+  {
+    const auto cache_data = FindPipelineCacheData(m_gx_uber_pipeline_cache_data, uid);
+    pipeline = CreatePipelineFromCacheData(*pipeline_config, cache_data, &from_cache_data);
+    if (cache_data.first && !from_cache_data)
+      OnStalePipelineCacheData();
+  }
+  INCSTAT(g_stats.this_frame.num_pipeline_compile_stalls);
+  ADDSTAT(g_stats.this_frame.pipeline_compile_stall_us,
+          Common::Timer::GetTimeUs() - start_time_us);
+  return InsertGXUberPipeline(uid, std::move(pipeline), from_cache_data);
+}
+
+std::optional<const AbstractPipeline*>
+ShaderCache::GetUberPipelineForUidAsync(const GXUberPipelineUid& uid)
+{
+  auto it = m_gx_uber_pipeline_cache.find(uid);
+  if (it != m_gx_uber_pipeline_cache.end())
+  {
+    // .second is the pending flag, i.e. compiling in the background.
+    if (!it->second.second)
+      return it->second.first.get();
+
+    return {};
+  }
+
+  QueueUberPipelineCompile(uid, COMPILE_PRIORITY_PARTIAL_UBERSHADER_PIPELINE);
+  return {};
 }
 
 void ShaderCache::WaitForAsyncCompiler()
 {
+  const u64 start_time_us = Common::Timer::GetTimeUs();
   while (m_async_shader_compiler->HasPendingWork() || m_async_shader_compiler->HasCompletedWork())
   {
     m_async_shader_compiler->WaitUntilCompletion([](size_t completed, size_t total) {
@@ -181,6 +271,7 @@ void ShaderCache::WaitForAsyncCompiler()
     });
     m_async_shader_compiler->RetrieveWorkItems();
   }
+  ADDSTAT(g_stats.this_frame.shader_compile_wait_us, Common::Timer::GetTimeUs() - start_time_us);
 }
 
 template <typename SerializedUidType, typename UidType>
@@ -218,27 +309,9 @@ void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type,
     CacheReader(T& cache_) : cache(cache_) {}
     void Read(const K& key, const u8* value, u32 value_size)
     {
-      auto shader = g_renderer->CreateShaderFromBinary(stage, value, value_size);
-      if (shader)
-      {
-        auto& entry = cache.shader_map[key];
-        entry.shader = std::move(shader);
-        entry.pending = false;
-
-        switch (stage)
-        {
-        case ShaderStage::Vertex:
-          INCSTAT(g_stats.num_vertex_shaders_created);
-          INCSTAT(g_stats.num_vertex_shaders_alive);
-          break;
-        case ShaderStage::Pixel:
-          INCSTAT(g_stats.num_pixel_shaders_created);
-          INCSTAT(g_stats.num_pixel_shaders_alive);
-          break;
-        default:
-          break;
-        }
-      }
+      // Creating every shader up front takes seconds with large caches, so they are only created
+      // once they are used. Later entries of the same UID replace earlier ones.
+      cache.cached_binaries.insert_or_assign(key, std::make_pair(value, value_size));
     }
 
   private:
@@ -248,80 +321,100 @@ void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type,
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
   CacheReader reader(cache);
   u32 count = cache.disk_cache.OpenAndRead(filename, reader);
-  INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
+  INFO_LOG_FMT(VIDEO, "Found {} cached shaders in {}", count, filename);
 }
 
 template <typename T>
 void ShaderCache::ClearShaderCache(T& cache)
 {
+  // The binaries point into the mapping of the disk cache
+  cache.cached_binaries.clear();
   cache.disk_cache.Sync();
   cache.disk_cache.Close();
   cache.shader_map.clear();
 }
 
+template <typename Uid>
+typename std::map<Uid, typename ShaderCache::ShaderModuleCache<Uid>::Shader>::iterator
+ShaderCache::ShaderModuleCache<Uid>::Find(ShaderStage stage, const Uid& uid)
+{
+  auto it = shader_map.find(uid);
+  if (it != shader_map.end())
+    return it;
+
+  const auto binary = cached_binaries.find(uid);
+  if (binary == cached_binaries.end())
+    return shader_map.end();
+
+  // A binary which the driver doesn't accept anymore is compiled from source by the caller
+  std::unique_ptr<AbstractShader> shader =
+      g_renderer->CreateShaderFromBinary(stage, binary->second.first, binary->second.second);
+  cached_binaries.erase(binary);
+  if (!shader)
+    return shader_map.end();
+
+  switch (stage)
+  {
+  case ShaderStage::Vertex:
+    INCSTAT(g_stats.num_vertex_shaders_created);
+    INCSTAT(g_stats.num_vertex_shaders_alive);
+    break;
+  case ShaderStage::Pixel:
+    INCSTAT(g_stats.num_pixel_shaders_created);
+    INCSTAT(g_stats.num_pixel_shaders_alive);
+    break;
+  default:
+    break;
+  }
+
+  return shader_map.emplace(uid, Shader{std::move(shader), false}).first;
+}
+
 template <typename KeyType, typename DiskKeyType, typename T>
-void ShaderCache::LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>& disk_cache,
-                                    APIType api_type, const char* type, bool include_gameid)
+void ShaderCache::LoadPipelineCache(T& cache,
+                                    std::map<KeyType, std::pair<const u8*, u32>>& cache_data,
+                                    LinearDiskCache<DiskKeyType, u8>& disk_cache, APIType api_type,
+                                    const char* type, bool include_gameid)
 {
   class CacheReader : public LinearDiskCacheReader<DiskKeyType, u8>
   {
   public:
-    CacheReader(ShaderCache* this_ptr_, T& cache_) : this_ptr(this_ptr_), cache(cache_) {}
-    bool AnyFailed() const { return failed; }
+    CacheReader(T& cache_, std::map<KeyType, std::pair<const u8*, u32>>& cache_data_)
+        : cache(cache_), cache_data(cache_data_)
+    {
+    }
     void Read(const DiskKeyType& key, const u8* value, u32 value_size)
     {
       KeyType real_uid;
       UnserializePipelineUid(key, real_uid);
 
       // Skip those which are already compiled.
-      if (failed || cache.find(real_uid) != cache.end())
-        return;
-
-      auto config = this_ptr->GetGXPipelineConfig(real_uid);
-      if (!config)
-        return;
-
-      auto pipeline = g_renderer->CreatePipeline(*config, value, value_size);
-      if (!pipeline)
-      {
-        // If any of the pipelines fail to create, consider the cache stale.
-        failed = true;
+      auto& entry = cache[real_uid];
+      if (entry.first)
         return;
-      }
 
-      auto& entry = cache[real_uid];
-      entry.first = std::move(pipeline);
-      entry.second = false;
+      // Creating every pipeline up front takes seconds with large caches, so the compiler threads
+      // create them from this data after CompileMissingPipelines queues them. Later entries of the
+      // same UID replace earlier ones, which is how recompiled stale pipelines take over.
+      cache_data.insert_or_assign(real_uid, std::make_pair(value, value_size));
     }
 
   private:
-    ShaderCache* this_ptr;
     T& cache;
-    bool failed = false;
+    std::map<KeyType, std::pair<const u8*, u32>>& cache_data;
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(this, cache);
+  CacheReader reader(cache, cache_data);
   const u32 count = disk_cache.OpenAndRead(filename, reader);
-  INFO_LOG_FMT(VIDEO, "Loaded {} cached pipelines from {}", count, filename);
-
-  // If any of the pipelines in the cache failed to create, it's likely because of a change of
-  // driver version, or system configuration. In this case, when the UID cache picks up the pipeline
-  // later on, we'll write a duplicate entry to the pipeline cache. There's also no point in keeping
-  // the old cache data around, so discard and recreate the disk cache.
-  if (reader.AnyFailed())
-  {
-    WARN_LOG_FMT(VIDEO, "Failed to load one or more pipelines from cache '{}'. Discarding.",
-                 filename);
-    disk_cache.Close();
-    File::Delete(filename);
-    disk_cache.OpenAndRead(filename, reader);
-  }
+  INFO_LOG_FMT(VIDEO, "Found {} cached pipelines in {}", count, filename);
 }
 
-template <typename T, typename Y>
-void ShaderCache::ClearPipelineCache(T& cache, Y& disk_cache)
+template <typename T, typename D, typename Y>
+void ShaderCache::ClearPipelineCache(T& cache, D& cache_data, Y& disk_cache)
 {
+  // The data points into the mapping of the disk cache
+  cache_data.clear();
   disk_cache.Sync();
   disk_cache.Close();
 
@@ -358,21 +451,25 @@ void ShaderCache::LoadCaches()
   if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
   {
     LoadPipelineCache<GXPipelineUid, SerializedGXPipelineUid>(
-        m_gx_pipeline_cache, m_gx_pipeline_disk_cache, m_api_type, "specialized-pipeline", true);
+        m_gx_pipeline_cache, m_gx_pipeline_cache_data, m_gx_pipeline_disk_cache, m_api_type,
+        "specialized-pipeline", true);
     LoadPipelineCache<GXUberPipelineUid, SerializedGXUberPipelineUid>(
-        m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache, m_api_type, "uber-pipeline",
-        false);
+        m_gx_uber_pipeline_cache, m_gx_uber_pipeline_cache_data, m_gx_uber_pipeline_disk_cache,
+        m_api_type, "uber-pipeline", false);
   }
 }
 
 void ShaderCache::ClearCaches()
 {
-  ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_cache_data, m_gx_pipeline_disk_cache);
+  m_queued_gx_pipeline_compiles.clear();
+  m_stale_pipeline_cache_data = false;
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
 
-  ClearPipelineCache(m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache);
+  ClearPipelineCache(m_gx_uber_pipeline_cache, m_gx_uber_pipeline_cache_data,
+                     m_gx_uber_pipeline_disk_cache);
   ClearShaderCache(m_uber_vs_cache);
   ClearShaderCache(m_uber_ps_cache);
 
@@ -401,21 +498,32 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Queue all uids with a null pipeline for compilation, unless they are queued already.
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
-      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+    if (it.second.first || it.second.second)
+      continue;
+
+    if (m_gx_pipeline_cache_data.count(it.first) != 0)
+    {
+      QueuePipelineCompile(it.first, COMPILE_PRIORITY_CACHED_PIPELINE);
+      continue;
+    }
+
+    const bool shared_only = m_shared_only_pipeline_uids.count(it.first) != 0;
+    QueuePipelineCompile(it.first, shared_only ? COMPILE_PRIORITY_SHARED_SHADERCACHE_PIPELINE :
+                                                 COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
-    if (!it.second.first)
+    if (!it.second.first && !it.second.second)
       QueueUberPipelineCompile(it.first, COMPILE_PRIORITY_UBERSHADER_PIPELINE);
   }
 }
 
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
+  TRACE_SCOPE("ShaderCache::CompileVertexShader");
   const ShaderCode source_code =
       GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
@@ -424,6 +532,7 @@ std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexSha
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
+  TRACE_SCOPE("ShaderCache::CompileVertexUberShader");
   const ShaderCode source_code =
       UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
@@ -431,6 +540,7 @@ ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) con
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
+  TRACE_SCOPE("ShaderCache::CompilePixelShader");
   const ShaderCode source_code =
       GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
@@ -439,6 +549,7 @@ std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShade
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
+  TRACE_SCOPE("ShaderCache::CompilePixelUberShader");
   const ShaderCode source_code =
       UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
@@ -534,6 +645,7 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
 const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid& uid)
 {
+  TRACE_SCOPE("ShaderCache::CreateGeometryShader");
   const ShaderCode source_code =
       GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
   std::unique_ptr<AbstractShader> shader =
@@ -596,7 +708,7 @@ AbstractPipelineConfig ShaderCache::GetGXPipelineConfig(
 std::optional<AbstractPipelineConfig> ShaderCache::GetGXPipelineConfig(const GXPipelineUid& config)
 {
   const AbstractShader* vs;
-  auto vs_iter = m_vs_cache.shader_map.find(config.vs_uid);
+  auto vs_iter = m_vs_cache.Find(ShaderStage::Vertex, config.vs_uid);
   if (vs_iter != m_vs_cache.shader_map.end() && !vs_iter->second.pending)
     vs = vs_iter->second.shader.get();
   else
@@ -606,7 +718,7 @@ std::optional<AbstractPipelineConfig> ShaderCache::GetGXPipelineConfig(const GXP
   ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
 
   const AbstractShader* ps;
-  auto ps_iter = m_ps_cache.shader_map.find(ps_uid);
+  auto ps_iter = m_ps_cache.Find(ShaderStage::Pixel, ps_uid);
   if (ps_iter != m_ps_cache.shader_map.end() && !ps_iter->second.pending)
     ps = ps_iter->second.shader.get();
   else
@@ -618,7 +730,7 @@ std::optional<AbstractPipelineConfig> ShaderCache::GetGXPipelineConfig(const GXP
   const AbstractShader* gs = nullptr;
   if (NeedsGeometryShader(config.gs_uid))
   {
-    auto gs_iter = m_gs_cache.shader_map.find(config.gs_uid);
+    auto gs_iter = m_gs_cache.Find(ShaderStage::Geometry, config.gs_uid);
     if (gs_iter != m_gs_cache.shader_map.end() && !gs_iter->second.pending)
       gs = gs_iter->second.shader.get();
     else
@@ -635,7 +747,7 @@ std::optional<AbstractPipelineConfig>
 ShaderCache::GetGXPipelineConfig(const GXUberPipelineUid& config)
 {
   const AbstractShader* vs;
-  auto vs_iter = m_uber_vs_cache.shader_map.find(config.vs_uid);
+  auto vs_iter = m_uber_vs_cache.Find(ShaderStage::Vertex, config.vs_uid);
   if (vs_iter != m_uber_vs_cache.shader_map.end() && !vs_iter->second.pending)
     vs = vs_iter->second.shader.get();
   else
@@ -645,7 +757,7 @@ ShaderCache::GetGXPipelineConfig(const GXUberPipelineUid& config)
   UberShader::ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
 
   const AbstractShader* ps;
-  auto ps_iter = m_uber_ps_cache.shader_map.find(ps_uid);
+  auto ps_iter = m_uber_ps_cache.Find(ShaderStage::Pixel, ps_uid);
   if (ps_iter != m_uber_ps_cache.shader_map.end() && !ps_iter->second.pending)
     ps = ps_iter->second.shader.get();
   else
@@ -657,7 +769,7 @@ ShaderCache::GetGXPipelineConfig(const GXUberPipelineUid& config)
   const AbstractShader* gs = nullptr;
   if (NeedsGeometryShader(config.gs_uid))
   {
-    auto gs_iter = m_gs_cache.shader_map.find(config.gs_uid);
+    auto gs_iter = m_gs_cache.Find(ShaderStage::Geometry, config.gs_uid);
     if (gs_iter != m_gs_cache.shader_map.end() && !gs_iter->second.pending)
       gs = gs_iter->second.shader.get();
     else
@@ -671,7 +783,8 @@ ShaderCache::GetGXPipelineConfig(const GXUberPipelineUid& config)
 }
 
 const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& config,
-                                                      std::unique_ptr<AbstractPipeline> pipeline)
+                                                      std::unique_ptr<AbstractPipeline> pipeline,
+                                                      bool from_cache_data)
 {
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
@@ -679,7 +792,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
   {
     entry.first = std::move(pipeline);
 
-    if (g_ActiveConfig.bShaderCache)
+    if (g_ActiveConfig.bShaderCache && !from_cache_data)
     {
       auto cache_data = entry.first->GetCacheData();
       if (!cache_data.empty())
@@ -697,7 +810,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
 
 const AbstractPipeline*
 ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
-                                  std::unique_ptr<AbstractPipeline> pipeline)
+                                  std::unique_ptr<AbstractPipeline> pipeline, bool from_cache_data)
 {
   auto& entry = m_gx_uber_pipeline_cache[config];
   entry.second = false;
@@ -705,7 +818,7 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   {
     entry.first = std::move(pipeline);
 
-    if (g_ActiveConfig.bShaderCache)
+    if (g_ActiveConfig.bShaderCache && !from_cache_data)
     {
       auto cache_data = entry.first->GetCacheData();
       if (!cache_data.empty())
@@ -721,83 +834,154 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   return entry.first.get();
 }
 
-void ShaderCache::LoadPipelineUIDCache()
+// Opens a pipeline UID cache file for appending and reads the UIDs already in it. Returns false if
+// the file didn't exist or was invalid, in which case it is recreated empty.
+static bool OpenPipelineUIDCacheFile(File::IOFile& file, const std::string& filename,
+                                     std::vector<SerializedGXPipelineUid>* uids)
 {
   constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
   constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  bool uid_file_valid = false;
+  if (file.Open(filename, "rb+"))
   {
     // If an existing case exists, validate the version before reading entries.
     u32 existing_magic;
     u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
+    if (file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
+        file.ReadBytes(&existing_version, sizeof(existing_version)) &&
         existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
     {
       // Ensure the expected size matches the actual size of the file. If it doesn't, it means
       // the cache file may be corrupted, and we should not proceed with loading potentially
       // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
+      const u64 file_size = file.GetSize();
       const size_t uid_count =
           static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
       const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
       uid_file_valid = file_size == expected_size;
       if (uid_file_valid)
       {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
+        uids->resize(uid_count);
+        uid_file_valid = file.ReadArray(uids->data(), uid_count);
       }
 
       // We open the file for reading and writing, so we must seek to the end before writing.
       if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, SEEK_SET);
+        uid_file_valid = file.Seek(expected_size, SEEK_SET);
     }
 
     // If the file is invalid, close it. We re-open and truncate it below.
     if (!uid_file_valid)
-      m_gx_pipeline_uid_cache_file.Close();
+    {
+      uids->clear();
+      file.Close();
+    }
   }
 
   // If the file is not open, it means it was either corrupted or didn't exist.
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  if (!file.IsOpen() && file.Open(filename, "wb"))
   {
-    if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
-    {
-      // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
-      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
-                                              sizeof(GX_PIPELINE_UID_VERSION));
-
-      // Write any current UIDs out to the file.
-      // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
-      // we don't lose the existing UIDs which were previously at the beginning.
-      for (const auto& it : m_gx_pipeline_cache)
-        AppendGXPipelineUID(it.first);
-    }
+    // Write the version identifier.
+    file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
+    file.WriteBytes(&GX_PIPELINE_UID_VERSION, sizeof(GX_PIPELINE_UID_VERSION));
+  }
+
+  return uid_file_valid;
+}
+
+static void WritePipelineUID(File::IOFile& file, const GXPipelineUid& config)
+{
+  if (!file.IsOpen())
+    return;
+
+  SerializedGXPipelineUid disk_uid;
+  SerializePipelineUid(config, disk_uid);
+  if (!file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  {
+    WARN_LOG_FMT(VIDEO, "Writing pipeline UID to cache failed, closing file.");
+    file.Close();
+  }
+}
+
+void ShaderCache::LoadPipelineUIDCache()
+{
+  std::string filename =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
+  std::vector<SerializedGXPipelineUid> uids;
+  if (OpenPipelineUIDCacheFile(m_gx_pipeline_uid_cache_file, filename, &uids))
+  {
+    // This just adds the pipelines to the map, they are compiled later.
+    for (const SerializedGXPipelineUid& uid : uids)
+      AddSerializedGXPipelineUID(uid);
+  }
+  else
+  {
+    // Write any current UIDs out to the file.
+    // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
+    // we don't lose the existing UIDs which were previously at the beginning.
+    for (const auto& it : m_gx_pipeline_cache)
+      AppendGXPipelineUID(it.first);
   }
 
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
 }
 
+void ShaderCache::LoadSharedPipelineUIDCache()
+{
+  // Many pipelines are the same for all games built with the same SDK, so compiling the ones that
+  // other games have used avoids stuttering in a game that hasn't been played yet.
+  const std::string filename = File::GetUserPath(D_CACHE_IDX) + "shared.uidcache";
+  std::vector<SerializedGXPipelineUid> serialized_uids;
+  OpenPipelineUIDCacheFile(m_shared_pipeline_uid_cache_file, filename, &serialized_uids);
+
+  std::set<GXPipelineUid> shared_uids;
+  for (const SerializedGXPipelineUid& serialized_uid : serialized_uids)
+  {
+    GXPipelineUid uid;
+    UnserializePipelineUid(serialized_uid, uid);
+    shared_uids.insert(uid);
+
+    // Flag it as empty with a null pipeline object, for later compilation.
+    if (m_gx_pipeline_cache.try_emplace(uid).second)
+      m_shared_only_pipeline_uids.insert(uid);
+  }
+
+  // Add the pipelines of the running game which aren't in the shared cache yet.
+  for (const auto& it : m_gx_pipeline_cache)
+  {
+    if (shared_uids.count(it.first) == 0)
+      WritePipelineUID(m_shared_pipeline_uid_cache_file, it.first);
+  }
+
+  INFO_LOG_FMT(VIDEO, "Read {} shared pipeline UIDs from {}, {} of them new to this game",
+               shared_uids.size(), filename, m_shared_only_pipeline_uids.size());
+}
+
+void ShaderCache::OpenPipelineUIDCollectionFile()
+{
+  // UIDs already in the file are kept, so that several FIFO logs can be collected into one file.
+  const std::string& filename = g_ActiveConfig.sPipelineUIDCollectionFile;
+  std::vector<SerializedGXPipelineUid> uids;
+  OpenPipelineUIDCacheFile(m_gx_pipeline_uid_cache_file, filename, &uids);
+  for (const SerializedGXPipelineUid& uid : uids)
+    AddSerializedGXPipelineUID(uid);
+
+  INFO_LOG_FMT(VIDEO, "Collecting pipeline UIDs into {}, {} already present", filename,
+               m_gx_pipeline_cache.size());
+}
+
+void ShaderCache::CollectPipelineUID(const GXPipelineUid& uid)
+{
+  if (m_gx_pipeline_cache.try_emplace(uid).second)
+    AppendGXPipelineUID(uid);
+}
+
 void ShaderCache::ClosePipelineUIDCache()
 {
   // This is left as a method in case we need to append extra data to the file in the future.
   m_gx_pipeline_uid_cache_file.Close();
+  m_shared_pipeline_uid_cache_file.Close();
+  m_shared_only_pipeline_uids.clear();
 }
 
 void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
@@ -816,16 +1000,15 @@ void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
 {
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
-    return;
+  WritePipelineUID(m_gx_pipeline_uid_cache_file, config);
+  WritePipelineUID(m_shared_pipeline_uid_cache_file, config);
+}
 
-  SerializedGXPipelineUid disk_uid;
-  SerializePipelineUid(config, disk_uid);
-  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
-  {
-    WARN_LOG_FMT(VIDEO, "Writing pipeline UID to cache failed, closing file.");
-    m_gx_pipeline_uid_cache_file.Close();
-  }
+void ShaderCache::RecordSharedPipelineUID(const GXPipelineUid& config)
+{
+  // Pipelines from the shared cache get added to the cache of the running game once it uses them.
+  if (m_shared_only_pipeline_uids.erase(config) != 0)
+    WritePipelineUID(m_gx_pipeline_uid_cache_file, config);
 }
 
 void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
@@ -852,8 +1035,10 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
     VertexShaderUid uid;
   };
 
-  m_vs_cache.shader_map[uid].pending = true;
+  auto& entry = m_vs_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
+  entry.work_item = wi.get();
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -910,8 +1095,10 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
     PixelShaderUid uid;
   };
 
-  m_ps_cache.shader_map[uid].pending = true;
+  auto& entry = m_ps_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
+  entry.work_item = wi.get();
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -955,14 +1142,17 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       // Check if all the stages required for this pipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the pipeline for the next frame.
       if (SetStagesReady())
+      {
         config = shader_cache->GetGXPipelineConfig(uid);
+        cache_data = FindPipelineCacheData(shader_cache->m_gx_pipeline_cache_data, uid);
+      }
     }
 
     bool SetStagesReady()
     {
       stages_ready = true;
 
-      auto vs_it = shader_cache->m_vs_cache.shader_map.find(uid.vs_uid);
+      auto vs_it = shader_cache->m_vs_cache.Find(ShaderStage::Vertex, uid.vs_uid);
       stages_ready &= vs_it != shader_cache->m_vs_cache.shader_map.end() && !vs_it->second.pending;
       if (vs_it == shader_cache->m_vs_cache.shader_map.end())
         shader_cache->QueueVertexShaderCompile(uid.vs_uid, priority);
@@ -970,7 +1160,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       PixelShaderUid ps_uid = uid.ps_uid;
       ClearUnusedPixelShaderUidBits(shader_cache->m_api_type, shader_cache->m_host_config, &ps_uid);
 
-      auto ps_it = shader_cache->m_ps_cache.shader_map.find(ps_uid);
+      auto ps_it = shader_cache->m_ps_cache.Find(ShaderStage::Pixel, ps_uid);
       stages_ready &= ps_it != shader_cache->m_ps_cache.shader_map.end() && !ps_it->second.pending;
       if (ps_it == shader_cache->m_ps_cache.shader_map.end())
         shader_cache->QueuePixelShaderCompile(ps_uid, priority);
@@ -981,22 +1171,28 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     bool Compile() override
     {
       if (config)
-        pipeline = g_renderer->CreatePipeline(*config);
+        pipeline = CreatePipelineFromCacheData(*config, cache_data, &from_cache_data);
       return true;
     }
 
     void Retrieve() override
     {
+      auto queued = shader_cache->m_queued_gx_pipeline_compiles.find(uid);
       if (stages_ready)
       {
-        shader_cache->InsertGXPipeline(uid, std::move(pipeline));
+        if (queued != shader_cache->m_queued_gx_pipeline_compiles.end())
+          shader_cache->m_queued_gx_pipeline_compiles.erase(queued);
+        shader_cache->m_gx_pipeline_cache_data.erase(uid);
+        if (cache_data.first && !from_cache_data)
+          shader_cache->OnStalePipelineCacheData();
+        shader_cache->InsertGXPipeline(uid, std::move(pipeline), from_cache_data);
       }
       else
       {
-        // Re-queue for next frame.
-        auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        // Re-queue for next frame, at the priority a draw may have promoted it to.
+        if (queued != shader_cache->m_queued_gx_pipeline_compiles.end())
+          priority = queued->second.priority;
+        shader_cache->QueuePipelineCompile(uid, priority);
       }
     }
 
@@ -1006,14 +1202,61 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     GXPipelineUid uid;
     u32 priority;
     std::optional<AbstractPipelineConfig> config;
+    std::pair<const u8*, u32> cache_data{};
+    bool from_cache_data = false;
     bool stages_ready;
   };
 
   auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
+  m_queued_gx_pipeline_compiles[uid] = {wi.get(), priority};
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_pipeline_cache[uid].second = true;
 }
 
+void ShaderCache::PromotePipelineCompile(const GXPipelineUid& uid)
+{
+  auto queued = m_queued_gx_pipeline_compiles.find(uid);
+  if (queued == m_queued_gx_pipeline_compiles.end() ||
+      queued->second.priority <= COMPILE_PRIORITY_ONDEMAND_PIPELINE)
+  {
+    return;
+  }
+
+  // A draw needs it, so it goes ahead of the precompiled pipelines along with its stages. Stages
+  // which aren't queued yet are queued at the new priority once the pipeline is re-queued.
+  queued->second.priority = COMPILE_PRIORITY_ONDEMAND_PIPELINE;
+  m_async_shader_compiler->PromoteWorkItem(queued->second.work_item,
+                                           COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+
+  const auto vs_it = m_vs_cache.shader_map.find(uid.vs_uid);
+  if (vs_it != m_vs_cache.shader_map.end() && vs_it->second.pending)
+  {
+    m_async_shader_compiler->PromoteWorkItem(vs_it->second.work_item,
+                                             COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  }
+
+  PixelShaderUid ps_uid = uid.ps_uid;
+  ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
+  const auto ps_it = m_ps_cache.shader_map.find(ps_uid);
+  if (ps_it != m_ps_cache.shader_map.end() && ps_it->second.pending)
+  {
+    m_async_shader_compiler->PromoteWorkItem(ps_it->second.work_item,
+                                             COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  }
+}
+
+void ShaderCache::OnStalePipelineCacheData()
+{
+  // This is likely because of a change of driver version, or system configuration. The
+  // recompiled pipelines are appended to the disk cache and replace the stale entries on the next
+  // load.
+  if (m_stale_pipeline_cache_data)
+    return;
+
+  WARN_LOG_FMT(VIDEO, "Failed to create one or more pipelines from the disk cache, recompiling.");
+  m_stale_pipeline_cache_data = true;
+}
+
 void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority)
 {
   class UberPipelineWorkItem final : public AsyncShaderCompiler::WorkItem
@@ -1025,14 +1268,17 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
       // Check if all the stages required for this UberPipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the UberPipeline for the next frame.
       if (SetStagesReady())
+      {
         config = shader_cache->GetGXPipelineConfig(uid);
+        cache_data = FindPipelineCacheData(shader_cache->m_gx_uber_pipeline_cache_data, uid);
+      }
     }
 
     bool SetStagesReady()
     {
       stages_ready = true;
 
-      auto vs_it = shader_cache->m_uber_vs_cache.shader_map.find(uid.vs_uid);
+      auto vs_it = shader_cache->m_uber_vs_cache.Find(ShaderStage::Vertex, uid.vs_uid);
       stages_ready &=
           vs_it != shader_cache->m_uber_vs_cache.shader_map.end() && !vs_it->second.pending;
       if (vs_it == shader_cache->m_uber_vs_cache.shader_map.end())
@@ -1042,7 +1288,7 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
       UberShader::ClearUnusedPixelShaderUidBits(shader_cache->m_api_type,
                                                 shader_cache->m_host_config, &ps_uid);
 
-      auto ps_it = shader_cache->m_uber_ps_cache.shader_map.find(ps_uid);
+      auto ps_it = shader_cache->m_uber_ps_cache.Find(ShaderStage::Pixel, ps_uid);
       stages_ready &=
           ps_it != shader_cache->m_uber_ps_cache.shader_map.end() && !ps_it->second.pending;
       if (ps_it == shader_cache->m_uber_ps_cache.shader_map.end())
@@ -1054,7 +1300,7 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
     bool Compile() override
     {
       if (config)
-        UberPipeline = g_renderer->CreatePipeline(*config);
+        UberPipeline = CreatePipelineFromCacheData(*config, cache_data, &from_cache_data);
       return true;
     }
 
@@ -1062,7 +1308,10 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
     {
       if (stages_ready)
       {
-        shader_cache->InsertGXUberPipeline(uid, std::move(UberPipeline));
+        shader_cache->m_gx_uber_pipeline_cache_data.erase(uid);
+        if (cache_data.first && !from_cache_data)
+          shader_cache->OnStalePipelineCacheData();
+        shader_cache->InsertGXUberPipeline(uid, std::move(UberPipeline), from_cache_data);
       }
       else
       {
@@ -1079,6 +1328,8 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
     GXUberPipelineUid uid;
     u32 priority;
     std::optional<AbstractPipelineConfig> config;
+    std::pair<const u8*, u32> cache_data{};
+    bool from_cache_data = false;
     bool stages_ready;
   };
 
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -61,13 +62,23 @@ public:
   // Retrieves all pending shaders/pipelines from the async compiler.
   void RetrieveAsyncShaders();
 
+  // Shaders and pipelines which are queued or being compiled asynchronously
+  size_t GetPendingAsyncCompileCount() const
+  {
+    return m_async_shader_compiler->GetPendingWorkCount();
+  }
+
   // Accesses ShaderGen shader caches
   const AbstractPipeline* GetPipelineForUid(const GXPipelineUid& uid);
   const AbstractPipeline* GetUberPipelineForUid(const GXUberPipelineUid& uid);
 
+  // Records a pipeline UID in the collection file without compiling it.
+  void CollectPipelineUID(const GXPipelineUid& uid);
+
   // Accesses ShaderGen shader caches asynchronously.
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
+  std::optional<const AbstractPipeline*> GetUberPipelineForUidAsync(const GXUberPipelineUid& uid);
 
   // Shared shaders
   const AbstractShader* GetScreenQuadVertexShader() const
@@ -119,6 +130,8 @@ private:
   void LoadCaches();
   void ClearCaches();
   void LoadPipelineUIDCache();
+  void LoadSharedPipelineUIDCache();
+  void OpenPipelineUIDCollectionFile();
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
@@ -153,12 +166,16 @@ private:
                       const BlendingState& blending_state);
   std::optional<AbstractPipelineConfig> GetGXPipelineConfig(const GXPipelineUid& uid);
   std::optional<AbstractPipelineConfig> GetGXPipelineConfig(const GXUberPipelineUid& uid);
+  // Pipelines created from their data in the disk cache aren't appended to it again.
   const AbstractPipeline* InsertGXPipeline(const GXPipelineUid& config,
-                                           std::unique_ptr<AbstractPipeline> pipeline);
+                                           std::unique_ptr<AbstractPipeline> pipeline,
+                                           bool from_cache_data = false);
   const AbstractPipeline* InsertGXUberPipeline(const GXUberPipelineUid& config,
-                                               std::unique_ptr<AbstractPipeline> pipeline);
+                                               std::unique_ptr<AbstractPipeline> pipeline,
+                                               bool from_cache_data = false);
   void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
+  void RecordSharedPipelineUID(const GXPipelineUid& config);
 
   // ASync Compiler Methods
   void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
@@ -167,6 +184,8 @@ private:
   void QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority);
   void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority);
   void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority);
+  void PromotePipelineCompile(const GXPipelineUid& uid);
+  void OnStalePipelineCacheData();
 
   // Populating various caches.
   template <ShaderStage stage, typename K, typename T>
@@ -174,20 +193,28 @@ private:
   template <typename T>
   void ClearShaderCache(T& cache);
   template <typename KeyType, typename DiskKeyType, typename T>
-  void LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>& disk_cache, APIType api_type,
+  void LoadPipelineCache(T& cache, std::map<KeyType, std::pair<const u8*, u32>>& cache_data,
+                         LinearDiskCache<DiskKeyType, u8>& disk_cache, APIType api_type,
                          const char* type, bool include_gameid);
-  template <typename T, typename Y>
-  void ClearPipelineCache(T& cache, Y& disk_cache);
+  template <typename T, typename D, typename Y>
+  void ClearPipelineCache(T& cache, D& cache_data, Y& disk_cache);
 
   // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // for as few frames as possible, otherwise we risk framerate drops. Pipelines that only other
+  // games have used come after the ones of the running game. Partially specialized ubershaders
+  // come first, since one of them stands in for every specialized shader with the same stage
+  // count until it is ready. Pipelines with data in the disk cache are created before the ones
+  // compiled from scratch, as they take a fraction of the time.
   enum : u32
   {
+    COMPILE_PRIORITY_PARTIAL_UBERSHADER_PIPELINE = 50,
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
     COMPILE_PRIORITY_UBERSHADER_PIPELINE = 200,
-    COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
+    COMPILE_PRIORITY_CACHED_PIPELINE = 250,
+    COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300,
+    COMPILE_PRIORITY_SHARED_SHADERCACHE_PIPELINE = 400
   };
 
   // Configuration bits.
@@ -212,9 +239,16 @@ private:
     {
       std::unique_ptr<AbstractShader> shader;
       bool pending;
+      // The queued compile while pending, for promoting it
+      const AsyncShaderCompiler::WorkItem* work_item;
     };
     std::map<Uid, Shader> shader_map;
     LinearDiskCache<Uid, u8> disk_cache;
+    // Binaries of the disk cache which haven't been used yet, pointing into its file mapping
+    std::map<Uid, std::pair<const u8*, u32>> cached_binaries;
+
+    // Returns the shader of the UID, creating it from its cached binary on first use
+    typename std::map<Uid, Shader>::iterator Find(ShaderStage stage, const Uid& uid);
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -226,7 +260,23 @@ private:
   std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
+  // Data of the disk cache pipelines which are still being created in the background, pointing
+  // into its file mapping
+  std::map<GXPipelineUid, std::pair<const u8*, u32>> m_gx_pipeline_cache_data;
+  std::map<GXUberPipelineUid, std::pair<const u8*, u32>> m_gx_uber_pipeline_cache_data;
+  bool m_stale_pipeline_cache_data = false;
+  // The queued compile of each pending GX pipeline, so that a draw which needs it can move it to
+  // the front of the queue
+  struct QueuedPipelineCompile
+  {
+    const AsyncShaderCompiler::WorkItem* work_item;
+    u32 priority;
+  };
+  std::map<GXPipelineUid, QueuedPipelineCompile> m_queued_gx_pipeline_compiles;
   File::IOFile m_gx_pipeline_uid_cache_file;
+  // The UIDs of all games, and the ones loaded from it which the running game hasn't used yet
+  File::IOFile m_shared_pipeline_uid_cache_file;
+  std::set<GXPipelineUid> m_shared_only_pipeline_uids;
   LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
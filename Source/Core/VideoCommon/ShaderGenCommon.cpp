@@ -3,6 +3,9 @@
 
 #include "VideoCommon/ShaderGenCommon.h"
 
+#include <string>
+#include <utility>
+
 #include <fmt/format.h>
 
 #include "Common/FileUtil.h"
@@ -10,6 +13,30 @@
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
+namespace
+{
+// Shaders are usually well within this size, so their buffers rarely need to grow
+constexpr size_t SHADER_CODE_RESERVE_SIZE = 16384;
+
+// The largest buffer released by a ShaderCode on this thread
+thread_local std::string s_spare_buffer;
+}  // namespace
+
+std::string ShaderCode::AcquireBuffer()
+{
+  std::string buffer = std::move(s_spare_buffer);
+  s_spare_buffer = {};
+  buffer.clear();
+  buffer.reserve(SHADER_CODE_RESERVE_SIZE);
+  return buffer;
+}
+
+void ShaderCode::ReleaseBuffer(std::string buffer)
+{
+  if (buffer.capacity() > s_spare_buffer.capacity())
+    s_spare_buffer = std::move(buffer);
+}
+
 ShaderHostConfig ShaderHostConfig::GetCurrent()
 {
   ShaderHostConfig bits = {};
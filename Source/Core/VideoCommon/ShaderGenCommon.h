@@ -7,6 +7,7 @@
 #include <iterator>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -100,7 +101,15 @@ private:
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
-  ShaderCode() { m_buffer.reserve(16384); }
+  // The buffer is taken from the one the last shader generated on this thread released, so that
+  // the async compiler's workers don't allocate a new buffer for every shader.
+  ShaderCode() : m_buffer(AcquireBuffer()) {}
+  ~ShaderCode() { ReleaseBuffer(std::move(m_buffer)); }
+  ShaderCode(const ShaderCode&) = default;
+  ShaderCode(ShaderCode&&) = default;
+  ShaderCode& operator=(const ShaderCode&) = default;
+  ShaderCode& operator=(ShaderCode&&) = default;
+
   const std::string& GetBuffer() const { return m_buffer; }
 
   // Writes format strings using fmtlib format strings.
@@ -112,6 +121,10 @@ public:
 
 protected:
   std::string m_buffer;
+
+private:
+  static std::string AcquireBuffer();
+  static void ReleaseBuffer(std::string buffer);
 };
 
 /**
@@ -14,6 +14,7 @@ Statistics g_stats;
 
 void Statistics::ResetFrame()
 {
+  last_frame = this_frame;
   this_frame = {};
 }
 
@@ -25,22 +26,6 @@ void Statistics::SwapDL()
   std::swap(this_frame.num_bp_loads_in_dl, this_frame.num_bp_loads);
 }
 
-void Statistics::ClearLuaText()
-{
-	g_stats.statistics_text = "";
-}
-
-void Statistics::SetString(std::string text)
-{
-	g_stats.statistics_text = text;
-}
-
-std::string Statistics::ToLuaString()
-{
-	return g_stats.statistics_text;
-}
-
-
 void Statistics::Display() const
 {
   const float scale = ImGui::GetIO().DisplayFramebufferScale.x;
@@ -79,6 +64,9 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Textures pooled", "%d", num_textures_pooled);
+  draw_statistic("Texture VRAM", "%i kB", texture_cache_vram_kb);
+  draw_statistic("Texture pool VRAM", "%i kB", texture_pool_vram_kb);
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
@@ -100,7 +88,14 @@ void Statistics::Display() const
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
+  draw_statistic("EFB peeks (stale):", "%d", this_frame.num_efb_peeks_stale);
+  draw_statistic("EFB peek readbacks:", "%d", this_frame.num_efb_peek_readbacks);
+  draw_statistic("EFB tiles prefetched:", "%d", this_frame.num_efb_tiles_prefetched);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("GPU sync distance:", "%d", this_frame.max_gpu_sync_distance);
+  draw_statistic("Pipeline compile stalls:", "%d", this_frame.num_pipeline_compile_stalls);
+  draw_statistic("Pipeline compile stall time:", "%i us", this_frame.pipeline_compile_stall_us);
+  draw_statistic("Async pipeline misses:", "%d", this_frame.num_async_pipeline_misses);
 
   ImGui::Columns(1);
 
@@ -17,6 +17,10 @@ struct Statistics
   int num_textures_created;
   int num_textures_uploaded;
   int num_textures_alive;
+  int num_textures_pooled;
+  // Estimated memory used by the textures of the cache and of the pool, in KiB
+  int texture_cache_vram_kb;
+  int texture_pool_vram_kb;
 
   int num_vertex_loaders;
 
@@ -24,8 +28,6 @@ struct Statistics
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
 
-  std::string statistics_text;
-
   struct ThisFrame
   {
     int num_bp_loads;
@@ -61,17 +63,34 @@ struct Statistics
     int tev_pixels_out;
 
     int num_efb_peeks;
+    int num_efb_peeks_stale;
+    int num_efb_peek_readbacks;
+    int num_efb_tiles_prefetched;
     int num_efb_pokes;
+
+    // Largest number of emulated CPU cycles the GPU thread was behind the CPU with SyncGPU
+    int max_gpu_sync_distance;
+
+    // Pipelines that were compiled on the GPU thread before drawing, and the time that took
+    int num_pipeline_compile_stalls;
+    int pipeline_compile_stall_us;
+    // Pipeline lookups that found the pipeline still being compiled asynchronously
+    int num_async_pipeline_misses;
+
+    // Host time spent waiting for the asynchronous shader compiler, decoding textures and
+    // reading back the EFB for CPU peeks, used to attribute stutters
+    int shader_compile_wait_us;
+    int texture_decode_us;
+    int efb_readback_us;
   };
   ThisFrame this_frame;
+  // The statistics of the previous frame, kept by ResetFrame
+  ThisFrame last_frame;
   void ResetFrame();
   void SwapDL();
   void Display() const;
   void DisplayProj() const;
 
-  static void ClearLuaText();
-  static void SetString(std::string text);
-	static std::string ToLuaString();
 	static std::string ToStringProj();
 };
 
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #if defined(_M_X86) || defined(_M_X86_64)
@@ -22,9 +23,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
+#include "Common/Image.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Timer.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -36,6 +39,7 @@
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUTimings.h"
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/PixelShaderManager.h"
@@ -55,6 +59,25 @@ static const u64 TEXHASH_INVALID = 0;
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
 
+// Texture dumping keeps at most this many levels waiting for their readback, and a few images
+// per PNG writer thread.
+constexpr size_t MAX_TEXTURE_DUMP_READBACKS = 64;
+constexpr size_t TEXTURE_DUMPS_PER_THREAD = 8;
+constexpr u32 MAX_TEXTURE_DUMP_THREADS = 4;
+
+// Estimate of the memory used by a texture, ignoring any padding added by the driver
+static size_t GetTextureMemorySize(const TextureConfig& config)
+{
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(config.format);
+  size_t size = 0;
+  for (u32 level = 0; level < config.levels; ++level)
+  {
+    const u32 rows = (std::max(config.height >> level, 1u) + block_size - 1) / block_size;
+    size += config.GetMipStride(level) * rows;
+  }
+  return size * config.layers * config.samples;
+}
+
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
 std::bitset<8> TextureCacheBase::valid_bind_points;
@@ -103,6 +126,8 @@ TextureCacheBase::~TextureCacheBase()
   // Clear pending EFB copies first, so we don't try to flush them.
   m_pending_efb_copies.clear();
 
+  FlushTextureDumps();
+
   HiresTexture::Shutdown();
   Invalidate();
   Common::FreeAlignedMemory(temp);
@@ -131,7 +156,9 @@ void TextureCacheBase::Invalidate()
     delete tex.second;
   }
   textures_by_address.clear();
+  m_textures_by_page.clear();
   textures_by_hash.clear();
+  m_palette_conversions.clear();
 
   texture_pool.clear();
 }
@@ -173,6 +200,11 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
 void TextureCacheBase::Cleanup(int _frameCount)
 {
+  // The copies for the textures dumped in the last frame should have finished by now.
+  while (m_texture_dump_readbacks_from_last_frame > 0)
+    FinishTextureDumpReadback();
+  m_texture_dump_readbacks_from_last_frame = m_texture_dump_readbacks.size();
+
   TexAddrCache::iterator iter = textures_by_address.begin();
   TexAddrCache::iterator tcend = textures_by_address.end();
   while (iter != tcend)
@@ -232,6 +264,8 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  EnforceVRAMBudget(_frameCount);
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -262,8 +296,29 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 TextureCacheBase::TCacheEntry*
 TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLUTFormat tlutfmt)
 {
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::TextureConversion);
+
   DEBUG_ASSERT(g_ActiveConfig.backend_info.bSupportsPaletteConversion);
 
+  // Copies never change after they were made, so their ID identifies the texture data. The hash
+  // doesn't, copies which were only made in VRAM all hash the same cleared memory.
+  const u32 palette_size = entry->format == TextureFormat::I4 ? 32 : 512;
+  const u64 palette_hash = Common::GetHash64(palette, palette_size, 0);
+  const auto cached =
+      std::find_if(m_palette_conversions.begin(), m_palette_conversions.end(),
+                   [&](const PaletteConversion& conversion) {
+                     return conversion.source_id == entry->id &&
+                            conversion.palette_hash == palette_hash &&
+                            conversion.tlutfmt == tlutfmt;
+                   });
+  if (cached != m_palette_conversions.end())
+  {
+    std::rotate(m_palette_conversions.begin(), cached, cached + 1);
+    TCacheEntry* converted = m_palette_conversions.front().converted;
+    converted->frameCount = FRAMECOUNT_INVALID;
+    return converted;
+  }
+
   const AbstractPipeline* pipeline = g_shader_cache->GetPaletteConversionPipeline(tlutfmt);
   if (!pipeline)
   {
@@ -291,7 +346,6 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLU
 
   g_renderer->BeginUtilityDrawing();
 
-  const u32 palette_size = entry->format == TextureFormat::I4 ? 32 : 512;
   u32 texel_buffer_offset;
   if (g_vertex_manager->UploadTexelBuffer(palette, palette_size,
                                           TexelBufferFormat::TEXEL_BUFFER_FORMAT_R16_UINT,
@@ -317,6 +371,11 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLU
     g_renderer->Draw(0, 3);
     g_renderer->EndUtilityDrawing();
     decoded_entry->texture->FinishedRendering();
+
+    if (m_palette_conversions.size() == PALETTE_CONVERSION_CACHE_SIZE)
+      m_palette_conversions.pop_back();
+    m_palette_conversions.insert(m_palette_conversions.begin(),
+                                 {entry->id, palette_hash, tlutfmt, decoded_entry});
   }
   else
   {
@@ -324,7 +383,7 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLU
     g_renderer->EndUtilityDrawing();
   }
 
-  textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  AddToAddressCache(decoded_entry);
 
   return decoded_entry;
 }
@@ -332,6 +391,8 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLU
 TextureCacheBase::TCacheEntry* TextureCacheBase::ReinterpretEntry(const TCacheEntry* existing_entry,
                                                                   TextureFormat new_format)
 {
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::TextureConversion);
+
   const AbstractPipeline* pipeline =
       g_shader_cache->GetTextureReinterpretPipeline(existing_entry->format.texfmt, new_format);
   if (!pipeline)
@@ -371,7 +432,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ReinterpretEntry(const TCacheEn
   g_renderer->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  AddToAddressCache(reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -414,78 +475,106 @@ void TextureCacheBase::ScaleTextureCacheEntryTo(TextureCacheBase::TCacheEntry* e
       config, TexPoolEntry(std::move(new_texture->texture), std::move(new_texture->framebuffer)));
 }
 
-bool TextureCacheBase::CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format)
+size_t TextureCacheBase::QueueStateReadbacks(const std::vector<TCacheEntry*>& entries,
+                                             size_t first)
 {
-  if (m_readback_texture && m_readback_texture->GetConfig().width >= width &&
-      m_readback_texture->GetConfig().height >= height &&
-      m_readback_texture->GetConfig().format == format)
-  {
-    return true;
+  // Issue the GPU->staging copies for as many textures as fit in the budget before reading any of
+  // them back, so the save only waits on the GPU once per batch instead of once per mip level.
+  static constexpr size_t MAX_QUEUED_READBACK_BYTES = 64 * 1024 * 1024;
+  size_t queued_bytes = 0;
+  size_t next = first;
+  for (; next < entries.size() && (next == first || queued_bytes < MAX_QUEUED_READBACK_BYTES);
+       next++)
+  {
+    const AbstractTexture* tex = entries[next]->texture.get();
+    const TextureConfig& config = tex->GetConfig();
+    for (u32 layer = 0; layer < config.layers; layer++)
+    {
+      for (u32 level = 0; level < config.levels; level++)
+      {
+        const auto rect = config.GetMipRect(level);
+        const TextureConfig staging_config(rect.GetWidth(), rect.GetHeight(), 1, 1, 1,
+                                           config.format, 0);
+        auto staging =
+            g_renderer->CreateStagingTexture(StagingTextureType::Readback, staging_config);
+        if (staging)
+        {
+          staging->CopyFromTexture(tex, rect, layer, level, staging_config.GetRect());
+          const u32 stride =
+              AbstractTexture::CalculateStrideForFormat(config.format, rect.GetWidth());
+          queued_bytes += static_cast<size_t>(stride) * rect.GetHeight();
+        }
+        m_state_readbacks.push_back(std::move(staging));
+      }
+    }
   }
 
-  TextureConfig staging_config(std::max(width, 128u), std::max(height, 128u), 1, 1, 1, format, 0);
-  m_readback_texture.reset();
-  m_readback_texture =
-      g_renderer->CreateStagingTexture(StagingTextureType::Readback, staging_config);
-  return m_readback_texture != nullptr;
+  return next;
 }
 
 void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfig& config,
                                         PointerWrap& p)
 {
-  // If we're in measure mode, skip the actual readback to save some time.
-  const bool skip_readback = p.GetMode() == PointerWrap::MODE_MEASURE;
   p.DoPOD(config);
 
-  if (skip_readback || CheckReadbackTexture(config.width, config.height, config.format))
+  // First, measure the amount of memory needed.
+  u32 total_size = 0;
+  for (u32 layer = 0; layer < config.layers; layer++)
   {
-    // First, measure the amount of memory needed.
-    u32 total_size = 0;
-    for (u32 layer = 0; layer < config.layers; layer++)
+    for (u32 level = 0; level < config.levels; level++)
     {
-      for (u32 level = 0; level < config.levels; level++)
-      {
-        u32 level_width = std::max(config.width >> level, 1u);
-        u32 level_height = std::max(config.height >> level, 1u);
+      u32 level_width = std::max(config.width >> level, 1u);
+      u32 level_height = std::max(config.height >> level, 1u);
 
-        u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
-        u32 size = stride * level_height;
+      u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
+      u32 size = stride * level_height;
 
-        total_size += size;
-      }
+      total_size += size;
     }
+  }
 
-    // Set aside total_size bytes of space for the textures.
-    // When measuring, this will be set aside and not written to,
-    // but when writing we'll use this pointer directly to avoid
-    // needing to allocate/free an extra buffer.
-    u8* texture_data = p.DoExternal(total_size);
+  // Set aside total_size bytes of space for the textures.
+  // When measuring, this will be set aside and not written to,
+  // but when writing we'll use this pointer directly to avoid
+  // needing to allocate/free an extra buffer.
+  u8* texture_data = p.DoExternal(total_size);
+
+  // If we're in measure mode, skip the actual readback to save some time. This also happens when
+  // the space ran out while writing.
+  if (p.GetMode() == PointerWrap::MODE_MEASURE)
+    return;
 
-    if (!skip_readback)
+  // Save out each layer of the texture to the pointer. The copies were already queued by
+  // QueueStateReadbacks, in the same layer/level order.
+  for (u32 layer = 0; layer < config.layers; layer++)
+  {
+    for (u32 level = 0; level < config.levels; level++)
     {
-      // Save out each layer of the texture to the pointer.
-      for (u32 layer = 0; layer < config.layers; layer++)
-      {
-        for (u32 level = 0; level < config.levels; level++)
-        {
-          u32 level_width = std::max(config.width >> level, 1u);
-          u32 level_height = std::max(config.height >> level, 1u);
-          auto rect = tex->GetConfig().GetMipRect(level);
-          m_readback_texture->CopyFromTexture(tex, rect, layer, level, rect);
+      u32 level_width = std::max(config.width >> level, 1u);
+      u32 level_height = std::max(config.height >> level, 1u);
+      u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
+      u32 size = stride * level_height;
 
-          u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
-          u32 size = stride * level_height;
-          m_readback_texture->ReadTexels(rect, texture_data, stride);
+      std::unique_ptr<AbstractStagingTexture> staging;
+      if (!m_state_readbacks.empty())
+      {
+        staging = std::move(m_state_readbacks.front());
+        m_state_readbacks.pop_front();
+      }
 
-          texture_data += size;
-        }
+      if (staging)
+      {
+        staging->ReadTexels(staging->GetConfig().GetRect(), texture_data, stride);
+      }
+      else
+      {
+        PanicAlertFmt("Failed to create staging texture for serialization");
+        std::memset(texture_data, 0, size);
       }
+
+      texture_data += size;
     }
   }
-  else
-  {
-    PanicAlertFmt("Failed to create staging texture for serialization");
-  }
 }
 
 std::optional<TextureCacheBase::TexPoolEntry> TextureCacheBase::DeserializeTexture(PointerWrap& p)
@@ -598,11 +687,17 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
   // Save the texture cache entries out in the order the were referenced.
   u32 size = static_cast<u32>(entries_to_save.size());
   p.Do(size);
-  for (TCacheEntry* entry : entries_to_save)
+  size_t next_queued_entry = 0;
+  for (size_t i = 0; i < entries_to_save.size(); i++)
   {
+    if (p.GetMode() == PointerWrap::MODE_WRITE && i == next_queued_entry)
+      next_queued_entry = QueueStateReadbacks(entries_to_save, i);
+
+    TCacheEntry* entry = entries_to_save[i];
     SerializeTexture(entry->texture.get(), entry->texture->GetConfig(), p);
     entry->DoState(p);
   }
+  m_state_readbacks.clear();
   p.DoMarker("TextureCacheEntries");
 
   // Save references for each cache entry.
@@ -654,7 +749,6 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
 
   // Free the readback texture to potentially save host-mapped GPU memory, depending on where
   // the driver mapped the staging buffer.
-  m_readback_texture.reset();
 }
 
 void TextureCacheBase::DoLoadState(PointerWrap& p)
@@ -715,7 +809,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     TCacheEntry* entry = GetEntry(id);
     if (entry)
-      textures_by_address.emplace(addr, entry);
+      AddToAddressCache(entry);
   }
 
   // Fill in hash map.
@@ -782,10 +876,10 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
 
   u32 numBlocksX = (entry_to_update->native_width + block_width - 1) / block_width;
 
-  auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
-  while (iter.first != iter.second)
+  for (const TexAddrCache::iterator& iter :
+       FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes))
   {
-    TCacheEntry* entry = iter.first->second;
+    TCacheEntry* entry = iter->second;
     if (entry != entry_to_update && entry->IsCopy() && !entry->tmem_only &&
         entry->references.count(entry_to_update) == 0 &&
         entry->OverlapsMemoryRange(entry_to_update->addr, entry_to_update->size_in_bytes) &&
@@ -798,7 +892,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
         {
           if (!CanReinterpretTextureOnGPU(entry_to_update->format.texfmt, entry->format.texfmt))
           {
-            ++iter.first;
             continue;
           }
 
@@ -822,7 +915,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
           }
           else
           {
-            ++iter.first;
             continue;
           }
         }
@@ -884,7 +976,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
             static_cast<u32>(dst_x + copy_width) > entry_to_update->GetWidth() ||
             static_cast<u32>(dst_y + copy_height) > entry_to_update->GetHeight())
         {
-          ++iter.first;
           continue;
         }
 
@@ -910,8 +1001,7 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
         {
           // Remove the temporary converted texture, it won't be used anywhere else
           // TODO: It would be nice to convert and copy in one step, but this code path isn't common
-          iter.first = InvalidateTexture(iter.first);
-          continue;
+          InvalidateTexture(iter);
         }
         else
         {
@@ -924,11 +1014,9 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
-        continue;
+        InvalidateTexture(iter);
       }
     }
-    ++iter.first;
   }
 
   return entry_to_update;
@@ -960,11 +1048,105 @@ void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, uns
       return;
   }
 
-  const std::string filename = fmt::format("{}/{}.png", szDir, basename);
-  if (File::Exists(filename))
+  // The file name contains the hash, so each texture only has to be looked for on disk once.
+  std::string filename = fmt::format("{}/{}.png", szDir, basename);
+  if (!m_dumped_textures.insert(filename).second || File::Exists(filename))
     return;
 
-  entry->texture->Save(filename, level);
+  // We can't dump compressed textures currently, see AbstractTexture::Save.
+  const TextureConfig& config = entry->texture->GetConfig();
+  ASSERT(!AbstractTexture::IsCompressedFormat(config.format));
+  const u32 level_width = std::max(1u, config.width >> level);
+  const u32 level_height = std::max(1u, config.height >> level);
+
+  std::unique_ptr<AbstractStagingTexture> staging_texture;
+  const auto pooled = std::find_if(
+      m_texture_dump_staging_pool.begin(), m_texture_dump_staging_pool.end(),
+      [&](const auto& texture) {
+        return texture->GetWidth() == level_width && texture->GetHeight() == level_height;
+      });
+  if (pooled != m_texture_dump_staging_pool.end())
+  {
+    staging_texture = std::move(*pooled);
+    m_texture_dump_staging_pool.erase(pooled);
+  }
+  else
+  {
+    staging_texture = g_renderer->CreateStagingTexture(
+        StagingTextureType::Readback,
+        TextureConfig(level_width, level_height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
+    if (!staging_texture)
+    {
+      WARN_LOG_FMT(VIDEO, "Failed to create staging texture for dumping {}", filename);
+      return;
+    }
+  }
+
+  staging_texture->CopyFromTexture(entry->texture.get(), 0, level);
+  m_texture_dump_readbacks.push_back({std::move(staging_texture), std::move(filename)});
+
+  // Don't let a new area which loads lots of textures pile up staging textures.
+  if (m_texture_dump_readbacks.size() > MAX_TEXTURE_DUMP_READBACKS)
+    FinishTextureDumpReadback();
+}
+
+void TextureCacheBase::FinishTextureDumpReadback()
+{
+  TextureDumpReadback readback = std::move(m_texture_dump_readbacks.front());
+  m_texture_dump_readbacks.pop_front();
+  if (m_texture_dump_readbacks_from_last_frame > 0)
+    m_texture_dump_readbacks_from_last_frame--;
+
+  AbstractStagingTexture* texture = readback.texture.get();
+  TextureDumpJob job{std::vector<u8>(texture->GetWidth() * texture->GetHeight() * sizeof(u32)),
+                     texture->GetWidth(), texture->GetHeight(), std::move(readback.file_name)};
+  texture->ReadTexels(texture->GetRect(), job.data.data(), job.width * sizeof(u32));
+
+  if (m_texture_dump_staging_pool.size() < MAX_TEXTURE_DUMP_READBACKS)
+    m_texture_dump_staging_pool.push_back(std::move(readback.texture));
+
+  if (m_texture_dump_workers.empty())
+  {
+    const u32 worker_count =
+        std::clamp(std::thread::hardware_concurrency(), 2u, MAX_TEXTURE_DUMP_THREADS + 1) - 1;
+    for (u32 i = 0; i < worker_count; ++i)
+    {
+      m_texture_dump_workers.push_back(std::make_unique<Common::WorkQueueThread<TextureDumpJob>>(
+          [this](TextureDumpJob dump_job) {
+            Common::SavePNG(dump_job.file_name, dump_job.data.data(), Common::ImageByteFormat::RGBA,
+                            dump_job.width, dump_job.height);
+
+            std::lock_guard lk(m_texture_dump_mutex);
+            m_pending_texture_dumps--;
+            m_texture_dump_done.notify_one();
+          }));
+    }
+    m_next_texture_dump_worker = 0;
+  }
+
+  // Bound the memory used by the queued images, like the frame dumper does.
+  {
+    const size_t max_pending = m_texture_dump_workers.size() * TEXTURE_DUMPS_PER_THREAD;
+    std::unique_lock lk(m_texture_dump_mutex);
+    m_texture_dump_done.wait(lk, [&] { return m_pending_texture_dumps < max_pending; });
+    m_pending_texture_dumps++;
+  }
+
+  m_texture_dump_workers[m_next_texture_dump_worker]->EmplaceItem(std::move(job));
+  m_next_texture_dump_worker = (m_next_texture_dump_worker + 1) % m_texture_dump_workers.size();
+}
+
+void TextureCacheBase::FlushTextureDumps()
+{
+  while (!m_texture_dump_readbacks.empty())
+    FinishTextureDumpReadback();
+
+  {
+    std::unique_lock lk(m_texture_dump_mutex);
+    m_texture_dump_done.wait(lk, [this] { return m_pending_texture_dumps == 0; });
+  }
+  m_texture_dump_workers.clear();
+  m_texture_dump_staging_pool.clear();
 }
 
 static void SetSamplerState(u32 index, float custom_tex_scale, bool custom_tex,
@@ -1257,8 +1439,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  base_hash = GetTextureDataHash(texture_info, textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
@@ -1511,13 +1692,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   const u32 texLevels = hires_tex ? (u32)hires_tex->m_levels.size() : texture_info.GetLevelCount();
 
   // We can decode on the GPU if it is a supported format and the flag is enabled.
-  // Currently we don't decode RGBA8 textures from Tmem, as that would require copying from both
-  // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
-  // there's no conversion between formats. In the future this could be extended with a separate
-  // shader, however.
-  const bool decode_on_gpu =
-      !hires_tex && g_ActiveConfig.UseGPUTextureDecoding() &&
-      !(texture_info.IsFromTmem() && texture_info.GetTextureFormat() == TextureFormat::RGBA8);
+  const bool decode_on_gpu = !hires_tex && g_ActiveConfig.UseGPUTextureDecoding();
 
   // create the entry/texture
   const TextureConfig config(width, height, texLevels, 1, 1,
@@ -1526,6 +1701,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   if (!entry)
     return nullptr;
 
+  const u64 decode_start_time_us = Common::Timer::GetTimeUs();
   ArbitraryMipmapDetector arbitrary_mip_detector;
   if (hires_tex)
   {
@@ -1539,8 +1715,21 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
 
   if (!hires_tex)
   {
+    // RGBA8 textures from Tmem are split across both banks. For the GPU, the halves are put back
+    // together in the main memory layout, which only takes a copy of each block.
+    const u8* gpu_src_data = texture_info.GetData();
+    if (decode_on_gpu && texture_info.IsFromTmem() &&
+        texture_info.GetTextureFormat() == TextureFormat::RGBA8)
+    {
+      CheckTempSize(texture_info.GetTextureSize());
+      TexDecoder_InterleaveRGBA8FromTmem(temp, texture_info.GetData(),
+                                         texture_info.GetTmemOddAddress(), expanded_width,
+                                         expanded_height);
+      gpu_src_data = temp;
+    }
+
     if (!decode_on_gpu ||
-        !DecodeTextureOnGPU(entry, 0, texture_info.GetData(), texture_info.GetTextureSize(),
+        !DecodeTextureOnGPU(entry, 0, gpu_src_data, texture_info.GetTextureSize(),
                             texture_info.GetTextureFormat(), width, height, expanded_width,
                             expanded_height,
                             bytes_per_block * (expanded_width / texture_info.GetBlockWidth()),
@@ -1587,7 +1776,6 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
     }
   }
 
-  iter = textures_by_address.emplace(texture_info.GetRawAddress(), entry);
   if (textureCacheSafetyColorSampleSize == 0 ||
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
@@ -1597,6 +1785,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
 
   entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
                               full_format, false);
+  iter = AddToAddressCache(entry);
   entry->SetDimensions(texture_info.GetRawWidth(), texture_info.GetRawHeight(),
                        texture_info.GetLevelCount());
   entry->SetHashes(base_hash, full_hash);
@@ -1652,6 +1841,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
     }
   }
 
+  ADDSTAT(g_stats.this_frame.texture_decode_us, Common::Timer::GetTimeUs() - decode_start_time_us);
+
   entry->has_arbitrary_mips = hires_tex ? hires_tex->HasArbitraryMipmaps() :
                                           arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
 
@@ -1684,6 +1875,16 @@ static void GetDisplayRectForXFBEntry(TextureCacheBase::TCacheEntry* entry, u32
   display_rect->bottom = static_cast<int>(height * entry->GetHeight() / entry->native_height);
 }
 
+TextureCacheBase::TCacheEntry*
+TextureCacheBase::GetCachedXFBTexture(u32 address, u32 width, u32 height, u32 stride,
+                                      MathUtil::Rectangle<int>* display_rect)
+{
+  TCacheEntry* entry = GetXFBFromCache(address, width, height, stride);
+  if (entry)
+    GetDisplayRectForXFBEntry(entry, width, height, display_rect);
+  return entry;
+}
+
 TextureCacheBase::TCacheEntry*
 TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
                                 MathUtil::Rectangle<int>* display_rect)
@@ -1699,11 +1900,8 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   TCacheEntry* entry = GetXFBFromCache(address, width, height, stride);
   if (entry)
   {
-    if (entry->is_xfb_container)
-    {
-      StitchXFBCopy(entry);
+    if (entry->is_xfb_container && StitchXFBCopy(entry))
       entry->texture->FinishedRendering();
-    }
 
     GetDisplayRectForXFBEntry(entry, width, height, display_rect);
     return entry;
@@ -1741,7 +1939,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  textures_by_address.emplace(entry->addr, entry);
+  AddToAddressCache(entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1770,7 +1968,8 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetXFBFromCache(u32 address, u3
     // The only thing which has to match exactly is the stride. We can use a partial rectangle if
     // the VI width/height differs from that of the XFB copy.
     if (entry->is_xfb_copy && entry->memory_stride == stride && entry->native_width >= width &&
-        entry->native_height >= height && !entry->may_have_overlapping_textures)
+        entry->native_height >= height &&
+        (!entry->may_have_overlapping_textures || !IsXFBCopyPartiallyOverwritten(entry)))
     {
       if (entry->hash == entry->CalculateHash() && !entry->reference_changed)
       {
@@ -1792,26 +1991,52 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetXFBFromCache(u32 address, u3
   return nullptr;
 }
 
-void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
+bool TextureCacheBase::IsXFBCopyPartiallyOverwritten(TCacheEntry* entry)
+{
+  // may_have_overlapping_textures is never cleared by the copies themselves, so it stays set after
+  // the copy which overlapped this one is gone. Only a newer copy which is still live can have
+  // replaced part of the image, older ones are below this copy anyway.
+  for (const TexAddrCache::iterator& iter :
+       FindOverlappingTextures(entry->addr, entry->size_in_bytes))
+  {
+    const TCacheEntry* overlapping_entry = iter->second;
+    if (overlapping_entry != entry && overlapping_entry->id > entry->id &&
+        overlapping_entry->IsCopy() && !overlapping_entry->tmem_only &&
+        overlapping_entry->OverlapsMemoryRange(entry->addr, entry->size_in_bytes) &&
+        overlapping_entry->memory_stride == entry->memory_stride)
+    {
+      return true;
+    }
+  }
+
+  // Present straight from this copy from now on, until another copy overlaps it.
+  entry->may_have_overlapping_textures = false;
+  return false;
+}
+
+bool TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
 {
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::TextureConversion);
+
   // It is possible that some of the overlapping textures overlap each other. This behavior has been
   // seen with XFB copies in Rogue Leader. To get the correct result, we apply the texture updates
   // in the order the textures were originally loaded. This ensures that the parts of the texture
   // that would have been overwritten in memory on real hardware get overwritten the same way here
   // too. This should work, but it may be a better idea to keep track of partial XFB copy
   // invalidations instead, which would reduce the amount of copying work here.
-  std::vector<TCacheEntry*> candidates;
+  std::vector<TCacheEntry*>& candidates = m_stitch_candidates;
+  candidates.clear();
   bool create_upscaled_copy = false;
 
-  auto iter = FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes);
-  while (iter.first != iter.second)
+  for (const TexAddrCache::iterator& iter :
+       FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes))
   {
     // Currently, this checks the stride of the VRAM copy against the VI request. Therefore, for
     // interlaced modes, VRAM copies won't be considered candidates. This is okay for now, because
     // our force progressive hack means that an XFB copy should always have a matching stride. If
     // the hack is disabled, XFB2RAM should also be enabled. Should we wish to implement interlaced
     // stitching in the future, this would require a shader which grabs every second line.
-    TCacheEntry* entry = iter.first->second;
+    TCacheEntry* entry = iter->second;
     if (entry != stitched_entry && entry->IsCopy() && !entry->tmem_only &&
         entry->OverlapsMemoryRange(stitched_entry->addr, stitched_entry->size_in_bytes) &&
         entry->memory_stride == stitched_entry->memory_stride)
@@ -1827,19 +2052,30 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
-        continue;
+        InvalidateTexture(iter);
       }
     }
-    ++iter.first;
   }
 
-  if (candidates.empty())
-    return;
-
   std::sort(candidates.begin(), candidates.end(),
             [](const TCacheEntry* a, const TCacheEntry* b) { return a->id < b->id; });
 
+  // Copies which an earlier present already stitched into this entry don't have to be applied
+  // again. Everything after the first new copy still has to be, to keep the overwrite order.
+  const auto first_new_copy =
+      std::find_if(candidates.begin(), candidates.end(), [stitched_entry](TCacheEntry* entry) {
+        return entry->references.count(stitched_entry) == 0;
+      });
+  for (auto iter = candidates.begin(); iter != first_new_copy; ++iter)
+    (*iter)->frameCount = FRAMECOUNT_INVALID;
+  candidates.erase(candidates.begin(), first_new_copy);
+  if (candidates.empty())
+    return false;
+
+  // An entry which was upscaled by an earlier stitch stays at the internal resolution.
+  if (stitched_entry->native_width != stitched_entry->GetWidth())
+    create_upscaled_copy = true;
+
   // We only upscale when necessary to preserve resolution. i.e. when there are upscaled partial
   // copies to be stitched together.
   if (create_upscaled_copy)
@@ -1937,6 +2173,8 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
     // Mark the texture update as used, as if it was loaded directly
     entry->frameCount = FRAMECOUNT_INVALID;
   }
+
+  return true;
 }
 
 EFBCopyFilterCoefficients
@@ -2057,6 +2295,9 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     return;
   }
 
+  // The copy may write to RAM
+  m_reusable_texture_hashes.clear();
+
   // tex_w and tex_h are the native size of the texture in the GC memory.
   // The size scaled_* represents the emulated texture. Those differ
   // because of upscaling and because of yscaling of XFB copies.
@@ -2223,10 +2464,9 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   // as our efb copy are marked to check them for partial texture updates.
   // TODO: The logic to detect overlapping strided efb copies is not 100% accurate.
   bool strided_efb_copy = dstStride != bytes_per_row;
-  auto iter = FindOverlappingTextures(dstAddr, covered_range);
-  while (iter.first != iter.second)
+  for (const TexAddrCache::iterator& iter : FindOverlappingTextures(dstAddr, covered_range))
   {
-    TCacheEntry* overlapping_entry = iter.first->second;
+    TCacheEntry* overlapping_entry = iter->second;
 
     if (overlapping_entry->addr == dstAddr && overlapping_entry->is_xfb_copy)
     {
@@ -2248,7 +2488,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       {
         // Pending EFB copies which are completely covered by this new copy can simply be tossed,
         // instead of having to flush them later on, since this copy will write over everything.
-        iter.first = InvalidateTexture(iter.first, true);
+        InvalidateTexture(iter, true);
         continue;
       }
 
@@ -2278,7 +2518,6 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         overlapping_entry->textures_by_hash_iter = textures_by_hash.end();
       }
     }
-    ++iter.first;
   }
 
   if (OpcodeDecoder::g_record_fifo_data)
@@ -2299,8 +2538,38 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    textures_by_address.emplace(dstAddr, entry);
+    AddToAddressCache(entry);
+  }
+}
+
+void TextureCacheBase::BeginTextureHashReuse()
+{
+  m_reuse_texture_hashes = true;
+}
+
+void TextureCacheBase::EndTextureHashReuse()
+{
+  m_reuse_texture_hashes = false;
+  m_reusable_texture_hashes.clear();
+}
+
+u64 TextureCacheBase::GetTextureDataHash(const TextureInfo& texture_info, int color_samples)
+{
+  // TMEM changes with every preload, which happens in the middle of the FIFO
+  if (!m_reuse_texture_hashes || texture_info.IsFromTmem())
+  {
+    return Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+                             color_samples);
+  }
+
+  const auto [iter, inserted] = m_reusable_texture_hashes.try_emplace(
+      {texture_info.GetRawAddress(), texture_info.GetTextureSize(), color_samples});
+  if (inserted)
+  {
+    iter->second =
+        Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(), color_samples);
   }
+  return iter->second;
 }
 
 void TextureCacheBase::FlushEFBCopies()
@@ -2308,8 +2577,25 @@ void TextureCacheBase::FlushEFBCopies()
   if (m_pending_efb_copies.empty())
     return;
 
-  for (TCacheEntry* entry : m_pending_efb_copies)
+  for (auto it = m_pending_efb_copies.begin(); it != m_pending_efb_copies.end(); ++it)
+  {
+    // A copy that was already taken out of the cache gets written over completely if a later copy
+    // to the same address is at least as large, so there is no need to wait for its readback.
+    TCacheEntry* entry = *it;
+    if (entry->pending_efb_copy_invalidated &&
+        std::any_of(it + 1, m_pending_efb_copies.end(), [entry](const TCacheEntry* later) {
+          return later->addr == entry->addr && later->memory_stride == entry->memory_stride &&
+                 later->pending_efb_copy_width >= entry->pending_efb_copy_width &&
+                 later->pending_efb_copy_height >= entry->pending_efb_copy_height;
+        }))
+    {
+      ReleaseEFBCopyStagingTexture(std::move(entry->pending_efb_copy));
+      delete entry;
+      continue;
+    }
+
     FlushEFBCopy(entry);
+  }
   m_pending_efb_copies.clear();
 }
 
@@ -2318,6 +2604,7 @@ void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32
 {
   MathUtil::Rectangle<int> copy_rect(0, 0, static_cast<int>(width), static_cast<int>(height));
   staging_texture->ReadTexels(copy_rect, dst_ptr, stride);
+  m_reusable_texture_hashes.clear();
   ReleaseEFBCopyStagingTexture(std::move(staging_texture));
 }
 
@@ -2347,8 +2634,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   if (entry->is_xfb_copy)
   {
     const u32 covered_range = entry->pending_efb_copy_height * entry->memory_stride;
-    auto range = FindOverlappingTextures(entry->addr, covered_range);
-    for (auto iter = range.first; iter != range.second; ++iter)
+    for (const TexAddrCache::iterator& iter : FindOverlappingTextures(entry->addr, covered_range))
     {
       TCacheEntry* overlapping_entry = iter->second;
       if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
@@ -2489,6 +2775,83 @@ TextureCacheBase::FindMatchingTextureFromPool(const TextureConfig& config)
   return matching_iter != range.second ? matching_iter : texture_pool.end();
 }
 
+void TextureCacheBase::EnforceVRAMBudget(int frame_count)
+{
+  size_t cache_size = 0;
+  for (const auto& [address, entry] : textures_by_address)
+    cache_size += GetTextureMemorySize(entry->texture->GetConfig());
+  size_t pool_size = 0;
+  for (const auto& [config, pool_entry] : texture_pool)
+    pool_size += GetTextureMemorySize(config);
+
+  const size_t budget = static_cast<size_t>(std::max(g_ActiveConfig.iTextureCacheVRAMBudget, 0))
+                        << 20;
+
+  // Drops the least recently used pool textures until the pool fits into what the cache leaves
+  const auto trim_pool = [&] {
+    if (cache_size + pool_size <= budget)
+      return;
+
+    std::vector<TexPool::iterator> pool_entries;
+    pool_entries.reserve(texture_pool.size());
+    for (auto iter = texture_pool.begin(); iter != texture_pool.end(); ++iter)
+      pool_entries.push_back(iter);
+    std::sort(pool_entries.begin(), pool_entries.end(), [](const auto& a, const auto& b) {
+      return a->second.frameCount < b->second.frameCount;
+    });
+
+    for (const TexPool::iterator& iter : pool_entries)
+    {
+      if (cache_size + pool_size <= budget)
+        break;
+      pool_size -= GetTextureMemorySize(iter->first);
+      texture_pool.erase(iter);
+    }
+  };
+
+  if (budget != 0 && cache_size + pool_size > budget)
+  {
+    // The pool only exists to avoid reallocations, so it goes first
+    trim_pool();
+
+    if (cache_size > budget)
+    {
+      // EFB copies can't be recreated, and textures used in this frame would just be loaded again
+      std::vector<TexAddrCache::iterator> entries;
+      for (auto iter = textures_by_address.begin(); iter != textures_by_address.end(); ++iter)
+      {
+        const TCacheEntry* entry = iter->second;
+        if (!entry->IsCopy() && !entry->tmem_only && entry->frameCount != FRAMECOUNT_INVALID &&
+            entry->frameCount < frame_count)
+        {
+          entries.push_back(iter);
+        }
+      }
+      std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a->second->frameCount < b->second->frameCount;
+      });
+
+      for (const TexAddrCache::iterator& iter : entries)
+      {
+        if (cache_size <= budget)
+          break;
+        const size_t size = GetTextureMemorySize(iter->second->texture->GetConfig());
+        cache_size -= size;
+        pool_size += size;
+        InvalidateTexture(iter);
+      }
+
+      // The invalidated textures were moved to the pool
+      trim_pool();
+    }
+  }
+
+  SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
+  SETSTAT(g_stats.num_textures_pooled, static_cast<int>(texture_pool.size()));
+  SETSTAT(g_stats.texture_cache_vram_kb, static_cast<int>(cache_size >> 10));
+  SETSTAT(g_stats.texture_pool_vram_kb, static_cast<int>(pool_size >> 10));
+}
+
 TextureCacheBase::TexAddrCache::iterator
 TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
 {
@@ -2505,21 +2868,62 @@ TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
   return textures_by_address.end();
 }
 
-std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddToAddressCache(TCacheEntry* entry)
+{
+  const TexAddrCache::iterator iter = textures_by_address.emplace(entry->addr, entry);
+  const auto [first_page, last_page] = GetAddressPages(entry->addr, entry->size_in_bytes);
+  for (u32 page = first_page; page <= last_page; page++)
+    m_textures_by_page[page].push_back(iter);
+  return iter;
+}
+
+void TextureCacheBase::RemoveFromPageIndex(TexAddrCache::iterator iter)
+{
+  const auto [first_page, last_page] = GetAddressPages(iter->second->addr,
+                                                       iter->second->size_in_bytes);
+  for (u32 page = first_page; page <= last_page; page++)
+  {
+    const auto bucket = m_textures_by_page.find(page);
+    if (bucket == m_textures_by_page.end())
+      continue;
+
+    std::vector<TexAddrCache::iterator>& textures = bucket->second;
+    const auto texture = std::find(textures.begin(), textures.end(), iter);
+    if (texture != textures.end())
+    {
+      *texture = textures.back();
+      textures.pop_back();
+    }
+    if (textures.empty())
+      m_textures_by_page.erase(bucket);
+  }
+}
+
+const std::vector<TextureCacheBase::TexAddrCache::iterator>&
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
-  // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
+  m_overlapping_textures.clear();
+
+  // A texture is listed in every page it touches. Textures which also touch an earlier page of the
+  // range were already found there, so later pages only add the textures which start in them.
+  const auto [first_page, last_page] = GetAddressPages(addr, size_in_bytes);
+  for (u32 page = first_page; page <= last_page; page++)
+  {
+    const auto bucket = m_textures_by_page.find(page);
+    if (bucket == m_textures_by_page.end())
+      continue;
 
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
-  auto begin = textures_by_address.lower_bound(lower_addr);
-  auto end = textures_by_address.upper_bound(addr + size_in_bytes);
+    for (const TexAddrCache::iterator& iter : bucket->second)
+    {
+      if (page == first_page || iter->first >> ADDRESS_PAGE_SHIFT == page)
+        m_overlapping_textures.push_back(iter);
+    }
+  }
 
-  return std::make_pair(begin, end);
+  // Keep the order of textures_by_address, the callers apply partial updates in that order
+  std::stable_sort(m_overlapping_textures.begin(), m_overlapping_textures.end(),
+                   [](const auto& a, const auto& b) { return a->first < b->first; });
+  return m_overlapping_textures;
 }
 
 TextureCacheBase::TexAddrCache::iterator
@@ -2536,6 +2940,13 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
     entry->textures_by_hash_iter = textures_by_hash.end();
   }
 
+  m_palette_conversions.erase(
+      std::remove_if(m_palette_conversions.begin(), m_palette_conversions.end(),
+                     [entry](const PaletteConversion& conversion) {
+                       return conversion.converted == entry || conversion.source_id == entry->id;
+                     }),
+      m_palette_conversions.end());
+
   for (size_t i = 0; i < bound_textures.size(); ++i)
   {
     // If the entry is currently bound and not invalidated, keep it, but mark it as invalidated.
@@ -2578,6 +2989,8 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
   texture_pool.emplace(config,
                        TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
 
+  RemoveFromPageIndex(iter);
+
   // Don't delete if there's a pending EFB copy, as we need the TCacheEntry alive.
   if (!entry->pending_efb_copy)
     delete entry;
@@ -2616,6 +3029,8 @@ void TextureCacheBase::CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_cop
                                            bool clamp_top, bool clamp_bottom,
                                            const EFBCopyFilterCoefficients& filter_coefficients)
 {
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::EFBCopies);
+
   // Flush EFB pokes first, as they're expected to be included.
   g_framebuffer_manager->FlushEFBPokes();
 
@@ -2687,6 +3102,8 @@ void TextureCacheBase::CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams&
                                bool clamp_top, bool clamp_bottom,
                                const EFBCopyFilterCoefficients& filter_coefficients)
 {
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::EFBCopies);
+
   // Flush EFB pokes first, as they're expected to be included.
   g_framebuffer_manager->FlushEFBPokes();
 
@@ -2760,6 +3177,8 @@ bool TextureCacheBase::DecodeTextureOnGPU(TCacheEntry* entry, u32 dst_level, con
                                           u32 row_stride, const u8* palette,
                                           TLUTFormat palette_format)
 {
+  VideoCommon::ScopedGPUPass gpu_pass(VideoCommon::GPUPass::TextureConversion);
+
   const auto* info = TextureConversionShaderTiled::GetDecodingShaderInfo(format);
   if (!info)
     return false;
@@ -3,10 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -16,6 +20,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
@@ -208,7 +213,8 @@ public:
   void ForceReload();
 
   // Removes textures which aren't used for more than TEXTURE_KILL_THRESHOLD frames,
-  // frameCount is the current frame number.
+  // frameCount is the current frame number. Textures which weren't used in this frame are also
+  // removed, least recently used first, while the VRAM budget is exceeded.
   void Cleanup(int _frameCount);
 
   void Invalidate();
@@ -219,6 +225,9 @@ public:
   TCacheEntry* GetTexture(const int textureCacheSafetyColorSampleSize, TextureInfo& texture_info);
   TCacheEntry* GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
                              MathUtil::Rectangle<int>* display_rect);
+  // Like GetXFBTexture, but only returns a copy already in VRAM, without creating entries.
+  TCacheEntry* GetCachedXFBTexture(u32 address, u32 width, u32 height, u32 stride,
+                                   MathUtil::Rectangle<int>* display_rect);
 
   virtual void BindTextures();
   void CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstFormat, u32 width, u32 height,
@@ -233,6 +242,12 @@ public:
   // Flushes all pending EFB copies to emulated RAM.
   void FlushEFBCopies();
 
+  // While the GPU runs on the CPU thread, emulated RAM can only change through the GPU's own EFB
+  // copies, so the hashes of textures in RAM can be reused until the CPU runs again. Fifo brackets
+  // those runs with these calls.
+  void BeginTextureHashReuse();
+  void EndTextureHashReuse();
+
   // Texture Serialization
   void SerializeTexture(AbstractTexture* tex, const TextureConfig& config, PointerWrap& p);
   std::optional<TexPoolEntry> DeserializeTexture(PointerWrap& p);
@@ -282,26 +297,44 @@ private:
 
   TCacheEntry* GetXFBFromCache(u32 address, u32 width, u32 height, u32 stride);
 
+  u64 GetTextureDataHash(const TextureInfo& texture_info, int color_samples);
+
   TCacheEntry* ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLUTFormat tlutfmt);
 
   TCacheEntry* ReinterpretEntry(const TCacheEntry* existing_entry, TextureFormat new_format);
 
   TCacheEntry* DoPartialTextureUpdates(TCacheEntry* entry_to_update, const u8* palette,
                                        TLUTFormat tlutfmt);
-  void StitchXFBCopy(TCacheEntry* entry_to_update);
+  bool IsXFBCopyPartiallyOverwritten(TCacheEntry* entry);
+  // Returns false if there was nothing to stitch into the entry.
+  bool StitchXFBCopy(TCacheEntry* entry_to_update);
 
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
+  // Hands the oldest texture dump readback to the PNG writers.
+  void FinishTextureDumpReadback();
+  void FlushTextureDumps();
   void CheckTempSize(size_t required_size);
 
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
+  void EnforceVRAMBudget(int frame_count);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
-  // Return all possible overlapping textures. As addr+size of the textures is not
-  // indexed, this may return false positives.
-  std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
-  FindOverlappingTextures(u32 addr, u32 size_in_bytes);
+  // Inserts the texture into textures_by_address and the page index.
+  TexAddrCache::iterator AddToAddressCache(TCacheEntry* entry);
+  void RemoveFromPageIndex(TexAddrCache::iterator iter);
+
+  // First and last page of a guest memory range in m_textures_by_page.
+  static std::pair<u32, u32> GetAddressPages(u32 addr, u32 size_in_bytes)
+  {
+    const u64 end = static_cast<u64>(addr) + std::max(size_in_bytes, 1u);
+    return {addr >> ADDRESS_PAGE_SHIFT, static_cast<u32>((end - 1) >> ADDRESS_PAGE_SHIFT)};
+  }
+
+  // Return all possible overlapping textures, in address order. Textures are only indexed by the
+  // pages they touch, so this may return false positives. The list is valid until the next call.
+  const std::vector<TexAddrCache::iterator>& FindOverlappingTextures(u32 addr, u32 size_in_bytes);
 
   // Removes and unlinks texture from texture cache and returns it to the pool
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
@@ -326,11 +359,18 @@ private:
   // Returns an EFB copy staging texture to the pool, so it can be re-used.
   void ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> tex);
 
-  bool CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format);
+  // Queues staging copies for entries[first..] up to a memory budget, and returns the index of the
+  // first entry that was not queued. SerializeTexture consumes the copies in the same order.
+  size_t QueueStateReadbacks(const std::vector<TCacheEntry*>& entries, size_t first);
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
   TexAddrCache textures_by_address;
+  // The textures_by_address entries of the textures touching each 16 KiB page of guest memory, so
+  // that overlap queries for EFB copies only visit nearby textures.
+  static constexpr u32 ADDRESS_PAGE_SHIFT = 14;
+  std::unordered_map<u32, std::vector<TexAddrCache::iterator>> m_textures_by_page;
+  std::vector<TexAddrCache::iterator> m_overlapping_textures;
   TexHashCache textures_by_hash;
   TexPool texture_pool;
   u64 last_entry_id = 0;
@@ -366,10 +406,53 @@ private:
   // so that overlapping textures are written to guest RAM in the order they are issued.
   std::vector<TCacheEntry*> m_pending_efb_copies;
 
-  // Staging texture used for readbacks.
-  // We store this in the class so that the same staging texture can be used for multiple
-  // readbacks, saving the overhead of allocating a new buffer every time.
-  std::unique_ptr<AbstractStagingTexture> m_readback_texture;
+  // Results of ApplyPaletteToEntry, most recently used first. Games which cycle the palette of an
+  // EFB copy every frame reuse these instead of converting the copy again for each palette.
+  struct PaletteConversion
+  {
+    u64 source_id;
+    u64 palette_hash;
+    TLUTFormat tlutfmt;
+    TCacheEntry* converted;
+  };
+  static constexpr size_t PALETTE_CONVERSION_CACHE_SIZE = 16;
+  std::vector<PaletteConversion> m_palette_conversions;
+
+  // Dumped textures are copied to staging textures, which are only read back a frame later, once
+  // the GPU is done with them. The PNGs are then compressed on worker threads.
+  struct TextureDumpReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    std::string file_name;
+  };
+  struct TextureDumpJob
+  {
+    std::vector<u8> data;
+    u32 width;
+    u32 height;
+    std::string file_name;
+  };
+  std::deque<TextureDumpReadback> m_texture_dump_readbacks;
+  size_t m_texture_dump_readbacks_from_last_frame = 0;
+  std::vector<std::unique_ptr<AbstractStagingTexture>> m_texture_dump_staging_pool;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<TextureDumpJob>>> m_texture_dump_workers;
+  size_t m_next_texture_dump_worker = 0;
+  std::mutex m_texture_dump_mutex;
+  std::condition_variable m_texture_dump_done;
+  size_t m_pending_texture_dumps = 0;
+  // Files which were dumped or found on disk already, so they aren't read back again.
+  std::unordered_set<std::string> m_dumped_textures;
+
+  // Scratch list of StitchXFBCopy, kept so that stitching every XFB doesn't allocate.
+  std::vector<TCacheEntry*> m_stitch_candidates;
+
+  // Staging textures with copies queued for the save state currently being written, one per
+  // layer/level of each texture, in serialization order.
+  std::deque<std::unique_ptr<AbstractStagingTexture>> m_state_readbacks;
+
+  // Hashes of texture data in RAM by address, size and color samples, see BeginTextureHashReuse.
+  std::map<std::tuple<u32, u32, int>, u64> m_reusable_texture_hashes;
+  bool m_reuse_texture_hashes = false;
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -4,10 +4,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
+#include "Common/Tracing.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -373,10 +376,52 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, TextureFormat
   }
 }
 
+namespace
+{
+// Textures with fewer texels are decoded on the calling thread
+constexpr int PARALLEL_DECODE_MIN_TEXELS = 256 * 256;
+constexpr unsigned int MAX_DECODE_THREADS = 4;
+}  // Anonymous namespace
+
+// Splits the texture into bands of whole block rows and decodes them in parallel. Every block is
+// decoded independently of the others, so the result is the same as decoding it at once.
+static bool TexDecoder_DecodeParallel(u8* dst, const u8* src, int width, int height,
+                                      TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  if (width * height < PARALLEL_DECODE_MIN_TEXELS)
+    return false;
+
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  if (height % block_height != 0 || width % TexDecoder_GetBlockWidthInTexels(texformat) != 0)
+    return false;
+
+  static Common::ThreadPool s_pool(MAX_DECODE_THREADS);
+
+  const size_t block_rows = height / block_height;
+  const size_t bands = std::min(block_rows, s_pool.GetThreadCount());
+  const size_t rows_per_band = (block_rows + bands - 1) / bands;
+  const size_t src_row_size = TexDecoder_GetTextureSizeInBytes(width, block_height, texformat);
+  const size_t dst_row_size = static_cast<size_t>(width) * block_height * sizeof(u32);
+
+  s_pool.Run(bands, [&](size_t band) {
+    const size_t first_row = band * rows_per_band;
+    if (first_row >= block_rows)
+      return;
+    const size_t row_count = std::min(rows_per_band, block_rows - first_row);
+    _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(dst + first_row * dst_row_size),
+                           src + first_row * src_row_size, width,
+                           static_cast<int>(row_count) * block_height, texformat, tlut, tlutfmt);
+  });
+  return true;
+}
+
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt)
 {
-  _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+  TRACE_SCOPE("TexDecoder_Decode");
+
+  if (!TexDecoder_DecodeParallel(dst, src, width, height, texformat, tlut, tlutfmt))
+    _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
 
   if (TexFmt_Overlay_Enable)
     TexDecoder_DrawOverlay(dst, width, height, texformat);
@@ -754,6 +799,21 @@ void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb,
   }
 }
 
+void TexDecoder_InterleaveRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
+                                        int height)
+{
+  // Each 4x4 block has 32 bytes of AR in the even bank and 32 bytes of GB in the odd bank, while
+  // in main memory the GB half directly follows the AR half
+  constexpr u32 HALF_BLOCK_SIZE = 32;
+  const u32 num_blocks = (width / 4) * (height / 4);
+  for (u32 i = 0; i < num_blocks; ++i)
+  {
+    std::memcpy(dst, src_ar + i * HALF_BLOCK_SIZE, HALF_BLOCK_SIZE);
+    std::memcpy(dst + HALF_BLOCK_SIZE, src_gb + i * HALF_BLOCK_SIZE, HALF_BLOCK_SIZE);
+    dst += HALF_BLOCK_SIZE * 2;
+  }
+}
+
 void TexDecoder_DecodeXFB(u8* dst, const u8* src, u32 width, u32 height, u32 stride)
 {
   const u8* src_ptr = src;
@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <cmath>
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
@@ -171,6 +175,24 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     colors[3] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 0);
   }
 
+#ifdef _M_ARM_64
+  // Each row is looked up from the four colors with one table lookup
+  static constexpr s8 SELECTOR_SHIFT[16] = {-6, -6, -6, -6, -4, -4, -4, -4,
+                                            -2, -2, -2, -2, 0,  0,  0,  0};
+  static constexpr u8 COLOR_BYTE[16] = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3};
+  const int8x16_t selector_shift = vld1q_s8(SELECTOR_SHIFT);
+  const uint8x16_t color_byte = vld1q_u8(COLOR_BYTE);
+  const uint8x16_t table = vld1q_u8(reinterpret_cast<const u8*>(colors));
+
+  for (int y = 0; y < 4; y++)
+  {
+    const uint8x16_t selector =
+        vandq_u8(vshlq_u8(vdupq_n_u8(src->lines[y]), selector_shift), vdupq_n_u8(3));
+    const uint8x16_t index = vorrq_u8(vshlq_n_u8(selector, 2), color_byte);
+    vst1q_u8(reinterpret_cast<u8*>(dst), vqtbl1q_u8(table, index));
+    dst += pitch;
+  }
+#else
   for (int y = 0; y < 4; y++)
   {
     int val = src->lines[y];
@@ -181,7 +203,108 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     }
     dst += pitch;
   }
+#endif
+}
+
+#ifdef _M_ARM_64
+// NEON versions of the most common formats. These produce the same output as the reference
+// implementations below.
+
+// Expands 8 intensities to 8 RGBA pixels
+static inline void StoreIntensities_NEON(u32* dst, uint8x8_t intensity)
+{
+  const uint8x8x2_t i2 = vzip_u8(intensity, intensity);
+  const uint8x16_t i2q = vcombine_u8(i2.val[0], i2.val[1]);
+  const uint8x16x2_t i4 = vzipq_u8(i2q, i2q);
+  vst1q_u8(reinterpret_cast<u8*>(dst), i4.val[0]);
+  vst1q_u8(reinterpret_cast<u8*>(dst + 4), i4.val[1]);
+}
+
+static void DecodeImpl_I4_NEON(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 8)
+    for (int x = 0; x < width; x += 8)
+      for (int iy = 0; iy < 8; iy += 2, src += 8)
+      {
+        // Two rows of 8 texels
+        const uint8x8_t val = vld1_u8(src);
+        const uint8x8_t high = vsri_n_u8(val, val, 4);
+        const uint8x8_t low = vsli_n_u8(val, val, 4);
+        const uint8x8x2_t rows = vzip_u8(high, low);
+        StoreIntensities_NEON(dst + (y + iy) * width + x, rows.val[0]);
+        StoreIntensities_NEON(dst + (y + iy + 1) * width + x, rows.val[1]);
+      }
+}
+
+static void DecodeImpl_I8_NEON(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+    for (int x = 0; x < width; x += 8)
+      for (int iy = 0; iy < 4; ++iy, src += 8)
+        StoreIntensities_NEON(dst + (y + iy) * width + x, vld1_u8(src));
+}
+
+static void DecodeImpl_IA8_NEON(u32* dst, const u8* src, int width, int height)
+{
+  // Each texel is an alpha byte followed by an intensity byte
+  static constexpr u8 ROW0[16] = {1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6};
+  static constexpr u8 ROW1[16] = {9, 9, 9, 8, 11, 11, 11, 10, 13, 13, 13, 12, 15, 15, 15, 14};
+  const uint8x16_t row0 = vld1q_u8(ROW0);
+  const uint8x16_t row1 = vld1q_u8(ROW1);
+  for (int y = 0; y < height; y += 4)
+    for (int x = 0; x < width; x += 4)
+      for (int iy = 0; iy < 4; iy += 2, src += 16)
+      {
+        const uint8x16_t val = vld1q_u8(src);
+        vst1q_u8(reinterpret_cast<u8*>(dst + (y + iy) * width + x), vqtbl1q_u8(val, row0));
+        vst1q_u8(reinterpret_cast<u8*>(dst + (y + iy + 1) * width + x), vqtbl1q_u8(val, row1));
+      }
+}
+
+static void DecodeImpl_RGB5A3_NEON(u32* dst, const u8* src, int width, int height)
+{
+  const uint16x8_t mask3 = vdupq_n_u16(0x7);
+  const uint16x8_t mask4 = vdupq_n_u16(0xf);
+  const uint16x8_t mask5 = vdupq_n_u16(0x1f);
+  for (int y = 0; y < height; y += 4)
+    for (int x = 0; x < width; x += 4)
+      for (int iy = 0; iy < 4; iy += 2, src += 16)
+      {
+        // Two rows of 4 big endian texels
+        const uint16x8_t val = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(src)));
+        const uint16x8_t opaque = vtstq_u16(val, vdupq_n_u16(0x8000));
+
+        // RGB555: Convert5To8
+        const uint16x8_t r5 = vandq_u16(vshrq_n_u16(val, 10), mask5);
+        const uint16x8_t g5 = vandq_u16(vshrq_n_u16(val, 5), mask5);
+        const uint16x8_t b5 = vandq_u16(val, mask5);
+        const uint16x8_t r8 = vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2));
+        const uint16x8_t g8 = vorrq_u16(vshlq_n_u16(g5, 3), vshrq_n_u16(g5, 2));
+        const uint16x8_t b8 = vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2));
+
+        // RGB4A3: Convert4To8 and Convert3To8
+        const uint16x8_t a3 = vandq_u16(vshrq_n_u16(val, 12), mask3);
+        const uint16x8_t r4 = vandq_u16(vshrq_n_u16(val, 8), mask4);
+        const uint16x8_t g4 = vandq_u16(vshrq_n_u16(val, 4), mask4);
+        const uint16x8_t b4 = vandq_u16(val, mask4);
+        const uint16x8_t a = vorrq_u16(vorrq_u16(vshlq_n_u16(a3, 5), vshlq_n_u16(a3, 2)),
+                                       vshrq_n_u16(a3, 1));
+
+        const uint8x8_t r = vmovn_u16(vbslq_u16(opaque, r8, vorrq_u16(vshlq_n_u16(r4, 4), r4)));
+        const uint8x8_t g = vmovn_u16(vbslq_u16(opaque, g8, vorrq_u16(vshlq_n_u16(g4, 4), g4)));
+        const uint8x8_t b = vmovn_u16(vbslq_u16(opaque, b8, vorrq_u16(vshlq_n_u16(b4, 4), b4)));
+        const uint8x8_t alpha = vmovn_u16(vbslq_u16(opaque, vdupq_n_u16(0xff), a));
+
+        const uint8x8x2_t rg = vzip_u8(r, g);
+        const uint8x8x2_t ba = vzip_u8(b, alpha);
+        const uint16x8x2_t rgba =
+            vzipq_u16(vreinterpretq_u16_u8(vcombine_u8(rg.val[0], rg.val[1])),
+                      vreinterpretq_u16_u8(vcombine_u8(ba.val[0], ba.val[1])));
+        vst1q_u16(reinterpret_cast<u16*>(dst + (y + iy) * width + x), rgba.val[0]);
+        vst1q_u16(reinterpret_cast<u16*>(dst + (y + iy + 1) * width + x), rgba.val[1]);
+      }
 }
+#endif
 
 // JSD 01/06/11:
 // TODO: we really should ensure BOTH the source and destination addresses are aligned to 16-byte
@@ -210,6 +333,9 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
   case TextureFormat::I4:
   {
+#ifdef _M_ARM_64
+    DecodeImpl_I4_NEON(dst, src, width, height);
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 8)
       for (int x = 0; x < width; x += 8)
@@ -222,10 +348,14 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
             memset(dst + (y + iy) * width + x + ix * 2, i1, 4);
             memset(dst + (y + iy) * width + x + ix * 2 + 1, i2, 4);
           }
+#endif
   }
   break;
   case TextureFormat::I8:  // speed critical
   {
+#ifdef _M_ARM_64
+    DecodeImpl_I8_NEON(dst, src, width, height);
+#else
     // Reference C implementation
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 8)
@@ -252,6 +382,7 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           srcval = newsrc[0];
           newdst[0] = srcval | (srcval << 8) | (srcval << 16) | (srcval << 24);
         }
+#endif
   }
   break;
   case TextureFormat::C8:
@@ -270,6 +401,9 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   break;
   case TextureFormat::IA8:
   {
+#ifdef _M_ARM_64
+    DecodeImpl_IA8_NEON(dst, src, width, height);
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 4)
@@ -282,6 +416,7 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           ptr[2] = DecodePixel_IA8(s[2]);
           ptr[3] = DecodePixel_IA8(s[3]);
         }
+#endif
   }
   break;
   case TextureFormat::C14X2:
@@ -306,11 +441,15 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   break;
   case TextureFormat::RGB5A3:
   {
+#ifdef _M_ARM_64
+    DecodeImpl_RGB5A3_NEON(dst, src, width, height);
+#else
     // Reference C implementation:
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 4)
         for (int iy = 0; iy < 4; iy++, src += 8)
           DecodeBytes_RGB5A3(dst + (y + iy) * width + x, (u16*)src);
+#endif
   }
   break;
   case TextureFormat::RGBA8:  // speed critical
@@ -34,6 +34,18 @@ PixelShaderUid GetPixelShaderUid()
   return out;
 }
 
+PixelShaderUid GetPartiallySpecializedPixelShaderUid()
+{
+  PixelShaderUid out = GetPixelShaderUid();
+
+  pixel_ubershader_uid_data* const uid_data = out.GetUidData();
+  uid_data->partially_specialized = 1;
+  uid_data->num_stages = bpmem.genMode.numtevstages;
+  uid_data->fog_enabled = bpmem.fog.c_proj_fsel.fsel != FogType::Off;
+
+  return out;
+}
+
 void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& host_config,
                                    PixelShaderUid* uid)
 {
@@ -59,10 +71,17 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
   const bool per_pixel_depth = uid_data->per_pixel_depth != 0;
   const bool bounding_box = host_config.bounding_box;
   const u32 numTexgen = uid_data->num_texgens;
+  const bool partially_specialized = uid_data->partially_specialized != 0;
+  const bool fog_enabled = !partially_specialized || uid_data->fog_enabled != 0;
   ShaderCode out;
 
   out.Write("// Pixel UberShader for {} texgens{}{}\n", numTexgen,
             early_depth ? ", early-depth" : "", per_pixel_depth ? ", per-pixel depth" : "");
+  if (partially_specialized)
+  {
+    out.Write("// Partially specialized for {} stages{}\n", uid_data->num_stages + 1,
+              fog_enabled ? "" : ", no fog");
+  }
   WritePixelShaderCommonHeader(out, api_type, host_config, bounding_box);
   WriteUberShaderCommonHeader(out, api_type, host_config);
   if (per_pixel_lighting)
@@ -750,8 +769,16 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
     color_input_prefix = "lit_";
   }
 
-  out.Write("  uint num_stages = {};\n\n",
-            BitfieldExtract<&GenMode::numtevstages>("bpmem_genmode"));
+  // A constant loop count lets the driver drop the loop overhead and the unused stages
+  if (partially_specialized)
+  {
+    out.Write("  uint num_stages = {}u;\n\n", uid_data->num_stages);
+  }
+  else
+  {
+    out.Write("  uint num_stages = {};\n\n",
+              BitfieldExtract<&GenMode::numtevstages>("bpmem_genmode"));
+  }
 
   out.Write("  // Main tev loop\n");
   if (api_type == APIType::D3D)
@@ -1170,9 +1197,19 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
 
   // FIXME: Fog is implemented the same as ShaderGen, but ShaderGen's fog is all hacks.
   //        Should be fixed point, and should not make guesses about Range-Based adjustments.
-  out.Write("  // Fog\n"
-            "  uint fog_function = {};\n",
-            BitfieldExtract<&FogParam3::fsel>("bpmem_fogParam3"));
+  // Without fog, a constant function lets the compiler drop the whole block below
+  if (fog_enabled)
+  {
+    out.Write("  // Fog\n"
+              "  uint fog_function = {};\n",
+              BitfieldExtract<&FogParam3::fsel>("bpmem_fogParam3"));
+  }
+  else
+  {
+    out.Write("  // Fog\n"
+              "  uint fog_function = {:s};\n",
+              FogType::Off);
+  }
   out.Write("  if (fog_function != {:s}) {{\n", FogType::Off);
   out.Write("    // TODO: This all needs to be converted from float to fixed point\n"
             "    float ze;\n"
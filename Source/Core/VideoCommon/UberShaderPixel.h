@@ -19,6 +19,13 @@ struct pixel_ubershader_uid_data
   u32 per_pixel_depth : 1;
   u32 uint_output : 1;
 
+  // Partially specialized ubershaders also bake the fields below in, which change much less often
+  // than the TEV configuration. They are compiled on demand and used in place of the full
+  // ubershader until the specialized shader is ready.
+  u32 partially_specialized : 1;
+  u32 num_stages : 4;
+  u32 fog_enabled : 1;
+
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
 #pragma pack()
@@ -26,6 +33,7 @@ struct pixel_ubershader_uid_data
 using PixelShaderUid = ShaderUid<pixel_ubershader_uid_data>;
 
 PixelShaderUid GetPixelShaderUid();
+PixelShaderUid GetPartiallySpecializedPixelShaderUid();
 
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data* uid_data);
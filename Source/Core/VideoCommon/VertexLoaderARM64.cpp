@@ -607,7 +607,6 @@ void VertexLoaderARM64::GenerateVertexLoader()
 
 int VertexLoaderARM64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
   return ((int (*)(u8 * src, u8 * dst, int count)) region)(src.GetPointer(), dst.GetPointer(),
                                                            count);
 }
@@ -67,6 +67,8 @@ public:
                                                               const VAT& vtx_attr);
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(DataReader src, DataReader dst, int count) = 0;
+  // Whether RunVertices may be called from several threads at once
+  virtual bool CanRunInParallel() const { return false; }
 
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
@@ -75,7 +77,6 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
@@ -4,6 +4,7 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -15,6 +16,7 @@
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
@@ -30,6 +32,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace VertexLoaderManager
 {
@@ -239,6 +242,64 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
   return loader;
 }
 
+// Draws with fewer vertices are converted on the calling thread
+constexpr int PARALLEL_LOAD_MIN_VERTICES = 4096;
+constexpr unsigned int MAX_LOAD_THREADS = 3;
+
+// Converts the vertices of a large draw in chunks on several threads. Vertices with an invalid
+// position index are skipped and leave a gap at the end of their chunk, which gets closed here.
+static bool RunVerticesParallel(VertexLoaderBase* loader, DataReader src, DataReader dst,
+                                int* count)
+{
+  if (*count < PARALLEL_LOAD_MIN_VERTICES || !loader->CanRunInParallel())
+    return false;
+
+  static Common::ThreadPool s_pool(MAX_LOAD_THREADS);
+
+  const size_t chunks = s_pool.GetThreadCount();
+  const int vertices_per_chunk = (*count + static_cast<int>(chunks) - 1) / static_cast<int>(chunks);
+  const u32 src_stride = loader->m_vertex_size;
+  const u32 dst_stride = loader->m_native_vtx_decl.stride;
+  u8* const src_end = src.GetPointer() + src.size();
+  u8* const dst_end = dst.GetPointer() + dst.size();
+  std::vector<int> loaded(chunks, 0);
+
+  s_pool.Run(chunks, [&](size_t chunk) {
+    const int first = static_cast<int>(chunk) * vertices_per_chunk;
+    if (first >= *count)
+      return;
+    const int chunk_count = std::min(vertices_per_chunk, *count - first);
+    loaded[chunk] =
+        loader->RunVertices(DataReader(src.GetPointer() + first * src_stride, src_end),
+                            DataReader(dst.GetPointer() + first * dst_stride, dst_end), chunk_count);
+  });
+
+  int total = 0;
+  for (size_t chunk = 0; chunk < chunks; ++chunk)
+  {
+    const int first = static_cast<int>(chunk) * vertices_per_chunk;
+    if (total != first && loaded[chunk] != 0)
+    {
+      std::memmove(dst.GetPointer() + total * dst_stride, dst.GetPointer() + first * dst_stride,
+                   loaded[chunk] * dst_stride);
+    }
+    total += loaded[chunk];
+  }
+
+  // Every chunk wrote its last vertices to the zfreeze caches, so load the last vertices of the
+  // draw once more to leave them the way a single call would have
+  static std::vector<u8> s_cache_vertices;
+  constexpr int CACHE_VERTICES = 3;
+  s_cache_vertices.resize(CACHE_VERTICES * dst_stride + 4);
+  loader->RunVertices(
+      DataReader(src.GetPointer() + (*count - CACHE_VERTICES) * src_stride, src_end),
+      DataReader(s_cache_vertices.data(), s_cache_vertices.data() + s_cache_vertices.size()),
+      CACHE_VERTICES);
+
+  *count = total;
+  return true;
+}
+
 int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess)
 {
   if (!count)
@@ -253,6 +314,16 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   if (is_preprocess)
     return size;
 
+  // Backends which don't draw only need to skip over the vertices. Only the BP/CP/XF state and
+  // EFB copies affect the emulated console, so no vertex conversion or draw setup is done. The
+  // draws still have to be set up when collecting the pipeline UIDs they use.
+  if (g_ActiveConfig.backend_info.bSkipsDraws && !g_ActiveConfig.IsCollectingPipelineUIDs())
+  {
+    ADDSTAT(g_stats.this_frame.num_prims, count);
+    INCSTAT(g_stats.this_frame.num_primitive_joins);
+    return size;
+  }
+
   // If the native vertex format changed, force a flush.
   if (loader->m_native_vertex_format != s_current_vtx_fmt ||
       loader->m_native_components != g_current_components)
@@ -271,7 +342,8 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  if (!RunVerticesParallel(loader, src, dst, &count))
+    count = loader->RunVertices(src, dst, count);
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
@@ -344,9 +416,14 @@ void LoadCPReg(u32 sub_cmd, u32 value, bool is_preprocess)
                    VCD_LO, sub_cmd);
     }
 
-    state->vtx_desc.low.Hex = value;
-    state->attr_dirty = BitSet32::AllTrue(CP_NUM_VAT_REG);
-    state->bases_dirty = true;
+    // Games tend to write the same values again before each draw, which doesn't need a new
+    // vertex loader to be looked up
+    if (state->vtx_desc.low.Hex != value)
+    {
+      state->vtx_desc.low.Hex = value;
+      state->attr_dirty = BitSet32::AllTrue(CP_NUM_VAT_REG);
+      state->bases_dirty = true;
+    }
     break;
 
   case VCD_HI:
@@ -359,9 +436,12 @@ void LoadCPReg(u32 sub_cmd, u32 value, bool is_preprocess)
                    VCD_HI, sub_cmd);
     }
 
-    state->vtx_desc.high.Hex = value;
-    state->attr_dirty = BitSet32::AllTrue(CP_NUM_VAT_REG);
-    state->bases_dirty = true;
+    if (state->vtx_desc.high.Hex != value)
+    {
+      state->vtx_desc.high.Hex = value;
+      state->attr_dirty = BitSet32::AllTrue(CP_NUM_VAT_REG);
+      state->bases_dirty = true;
+    }
     break;
 
   case CP_VAT_REG_A:
@@ -370,8 +450,11 @@ void LoadCPReg(u32 sub_cmd, u32 value, bool is_preprocess)
       DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_MAYBE_INVALID_CP_COMMAND);
       WARN_LOG_FMT(VIDEO, "CP_VAT_REG_A: Invalid VAT {}", sub_cmd - CP_VAT_REG_A);
     }
-    state->vtx_attr[sub_cmd & CP_VAT_MASK].g0.Hex = value;
-    state->attr_dirty[sub_cmd & CP_VAT_MASK] = true;
+    if (state->vtx_attr[sub_cmd & CP_VAT_MASK].g0.Hex != value)
+    {
+      state->vtx_attr[sub_cmd & CP_VAT_MASK].g0.Hex = value;
+      state->attr_dirty[sub_cmd & CP_VAT_MASK] = true;
+    }
     break;
 
   case CP_VAT_REG_B:
@@ -380,8 +463,11 @@ void LoadCPReg(u32 sub_cmd, u32 value, bool is_preprocess)
       DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_MAYBE_INVALID_CP_COMMAND);
       WARN_LOG_FMT(VIDEO, "CP_VAT_REG_B: Invalid VAT {}", sub_cmd - CP_VAT_REG_B);
     }
-    state->vtx_attr[sub_cmd & CP_VAT_MASK].g1.Hex = value;
-    state->attr_dirty[sub_cmd & CP_VAT_MASK] = true;
+    if (state->vtx_attr[sub_cmd & CP_VAT_MASK].g1.Hex != value)
+    {
+      state->vtx_attr[sub_cmd & CP_VAT_MASK].g1.Hex = value;
+      state->attr_dirty[sub_cmd & CP_VAT_MASK] = true;
+    }
     break;
 
   case CP_VAT_REG_C:
@@ -390,16 +476,24 @@ void LoadCPReg(u32 sub_cmd, u32 value, bool is_preprocess)
       DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_MAYBE_INVALID_CP_COMMAND);
       WARN_LOG_FMT(VIDEO, "CP_VAT_REG_C: Invalid VAT {}", sub_cmd - CP_VAT_REG_C);
     }
-    state->vtx_attr[sub_cmd & CP_VAT_MASK].g2.Hex = value;
-    state->attr_dirty[sub_cmd & CP_VAT_MASK] = true;
+    if (state->vtx_attr[sub_cmd & CP_VAT_MASK].g2.Hex != value)
+    {
+      state->vtx_attr[sub_cmd & CP_VAT_MASK].g2.Hex = value;
+      state->attr_dirty[sub_cmd & CP_VAT_MASK] = true;
+    }
     break;
 
   // Pointers to vertex arrays in GC RAM
   case ARRAY_BASE:
-    state->array_bases[sub_cmd & CP_ARRAY_MASK] =
-        value & CommandProcessor::GetPhysicalAddressMask();
-    state->bases_dirty = true;
+  {
+    const u32 base = value & CommandProcessor::GetPhysicalAddressMask();
+    if (state->array_bases[sub_cmd & CP_ARRAY_MASK] != base)
+    {
+      state->array_bases[sub_cmd & CP_ARRAY_MASK] = base;
+      state->bases_dirty = true;
+    }
     break;
+  }
 
   case ARRAY_STRIDE:
     state->array_strides[sub_cmd & CP_ARRAY_MASK] = value & 0xFF;
@@ -541,7 +541,6 @@ void VertexLoaderX64::GenerateVertexLoader()
 
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
   return ((int (*)(u8*, u8*, int, const void*))region)(src.GetPointer(), dst.GetPointer(), count,
                                                        memory_base_ptr);
 }
@@ -18,6 +18,7 @@ public:
 
 protected:
   int RunVertices(DataReader src, DataReader dst, int count) override;
+  bool CanRunInParallel() const override { return true; }
 
 private:
   u32 m_src_ofs = 0;
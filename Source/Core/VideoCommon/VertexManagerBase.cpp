@@ -12,10 +12,12 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/Tracing.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/DolphinAnalytics.h"
 
+#include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
@@ -118,6 +120,7 @@ DataReader VertexManagerBase::PrepareForAdditionalData(int primitive, u32 count,
 {
   // Flush all EFB pokes. Since the buffer is shared, we can't draw pokes+primitives concurrently.
   g_framebuffer_manager->FlushEFBPokes();
+  g_framebuffer_manager->OnEFBDraw(BPFunctions::GetScissorRect());
 
   // The SSE vertex loader can write up to 4 bytes past the end
   u32 const needed_vertex_bytes = count * stride + 4;
@@ -358,6 +361,7 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  TRACE_SCOPE("VertexManager::Flush");
   m_is_flushed = true;
 
   if (xfmem.numTexGen.numTexGens != bpmem.genMode.numtexgens ||
@@ -617,6 +621,7 @@ void VertexManagerBase::UpdatePipelineConfig()
   {
     m_current_pipeline_config.ps_uid = ps_uid;
     m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
+    m_current_partial_uber_ps_uid = UberShader::GetPartiallySpecializedPixelShaderUid();
     m_pipeline_config_changed = true;
   }
 
@@ -679,6 +684,12 @@ void VertexManagerBase::UpdatePipelineObject()
   m_current_pipeline_object = nullptr;
   m_pipeline_config_changed = false;
 
+  if (g_ActiveConfig.IsCollectingPipelineUIDs())
+  {
+    g_shader_cache->CollectPipelineUID(m_current_pipeline_config);
+    return;
+  }
+
   switch (g_ActiveConfig.iShaderCompilationMode)
   {
   case ShaderCompilationMode::Synchronous:
@@ -691,8 +702,7 @@ void VertexManagerBase::UpdatePipelineObject()
   case ShaderCompilationMode::SynchronousUberShaders:
   {
     // Exclusive ubershader mode, always use ubershaders.
-    m_current_pipeline_object =
-        g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+    m_current_pipeline_object = GetUberPipelineObject();
   }
   break;
 
@@ -711,8 +721,7 @@ void VertexManagerBase::UpdatePipelineObject()
     if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders)
     {
       // Specialized shaders not ready, use the ubershaders.
-      m_current_pipeline_object =
-          g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+      m_current_pipeline_object = GetUberPipelineObject();
     }
     else
     {
@@ -725,6 +734,19 @@ void VertexManagerBase::UpdatePipelineObject()
   }
 }
 
+const AbstractPipeline* VertexManagerBase::GetUberPipelineObject()
+{
+  // Prefer the ubershader specialized on the stage count and fog once it's compiled, it's much
+  // cheaper to run than the full one.
+  VideoCommon::GXUberPipelineUid partial_config = m_current_uber_pipeline_config;
+  partial_config.ps_uid = m_current_partial_uber_ps_uid;
+  auto res = g_shader_cache->GetUberPipelineForUidAsync(partial_config);
+  if (res && *res)
+    return *res;
+
+  return g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+}
+
 void VertexManagerBase::OnDraw()
 {
   m_draw_counter++;
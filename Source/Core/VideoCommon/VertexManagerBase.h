@@ -180,6 +180,7 @@ protected:
 
   VideoCommon::GXPipelineUid m_current_pipeline_config;
   VideoCommon::GXUberPipelineUid m_current_uber_pipeline_config;
+  UberShader::PixelShaderUid m_current_partial_uber_ps_uid;
   const AbstractPipeline* m_current_pipeline_object = nullptr;
   PrimitiveType m_current_primitive_type = PrimitiveType::Points;
   bool m_pipeline_config_changed = true;
@@ -196,6 +197,7 @@ private:
 
   void UpdatePipelineConfig();
   void UpdatePipelineObject();
+  const AbstractPipeline* GetUberPipelineObject();
 
   bool m_is_flushed = true;
   FlushStatistics m_flush_statistics = {};
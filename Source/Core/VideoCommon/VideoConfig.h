@@ -87,6 +87,9 @@ struct VideoConfig final
   bool bTexFmtOverlayEnable;
   bool bTexFmtOverlayCenter;
   bool bLogRenderTimeToFile;
+  bool bShowGPUTimings;
+  bool bShowFrameTimes;
+  bool bLogGPUTimingsToFile;
 
   // Render
   bool bWireFrame;
@@ -104,9 +107,13 @@ struct VideoConfig final
   bool bUseFFV1;
   std::string sDumpCodec;
   std::string sDumpEncoder;
+  // Encoder or codec name for the audio stream of frame dumps. Empty disables the audio stream.
+  std::string sDumpAudioCodec;
   std::string sDumpFormat;
   std::string sDumpPath;
   bool bInternalResolutionFrameDumps;
+  // Frame dumps run at internal resolution without presenting to the window or throttling.
+  bool bFastFrameDumps;
   bool bBorderlessFullscreen;
   bool bEnableGPUTextureDecoding;
   int iBitrateKbps;
@@ -116,6 +123,8 @@ struct VideoConfig final
   bool bEFBAccessDeferInvalidation;
   bool bPerfQueriesEnable;
   bool bBBoxEnable;
+  // Bounding box reads return the result of the previous readback instead of waiting for the GPU
+  bool bBBoxDeferReadback;
   bool bForceProgressive;
 
   bool bEFBEmulateFormatChanges;
@@ -127,6 +136,7 @@ struct VideoConfig final
   bool bSkipPresentingDuplicateXFBs;
   bool bCopyEFBScaled;
   int iSafeTextureCache_ColorSamples;
+  int iTextureCacheVRAMBudget;
   float fAspectRatioHackW, fAspectRatioHackH;
   bool bEnablePixelLighting;
   bool bFastDepthCalc;
@@ -169,8 +179,13 @@ struct VideoConfig final
 
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting;
+  bool bSharedPipelineUIDCache;
   ShaderCompilationMode iShaderCompilationMode;
 
+  // When set, the pipeline UIDs used are appended to this UID cache file, and nothing is compiled
+  // or drawn. Used to build UID caches from FIFO logs.
+  std::string sPipelineUIDCollectionFile;
+
   // Number of shader compiler threads.
   // 0 disables background compilation.
   // -1 uses an automatic number based on the CPU threads.
@@ -225,6 +240,7 @@ struct VideoConfig final
     bool bSupportsDepthReadback;
     bool bSupportsShaderBinaries;
     bool bSupportsPipelineCacheData;
+    bool bSkipsDraws;  // Nothing is rendered, so vertex loading and draw setup can be skipped
   } backend_info;
 
   // Utility
@@ -239,6 +255,7 @@ struct VideoConfig final
   }
   bool UseVertexRounding() const { return bVertexRounding && iEFBScale != 1; }
   bool UsingUberShaders() const;
+  bool IsCollectingPipelineUIDs() const { return !sPipelineUIDCollectionFile.empty(); }
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
 };
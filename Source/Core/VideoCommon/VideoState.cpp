@@ -74,6 +74,10 @@ void VideoCommon_DoState(PointerWrap& p)
   BoundingBox::DoState(p);
   p.DoMarker("BoundingBox");
 
+  // Queued ahead of the EFB and texture readbacks, so that mapping it doesn't wait for the GPU
+  if (p.GetMode() == PointerWrap::MODE_WRITE)
+    g_renderer->QueueStateThumbnail();
+
   g_framebuffer_manager->DoState(p);
   p.DoMarker("FramebufferManager");
 
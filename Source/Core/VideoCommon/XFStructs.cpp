@@ -3,6 +3,8 @@
 
 #include "VideoCommon/XFStructs.h"
 
+#include <algorithm>
+
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -26,6 +28,19 @@ static void XFMemWritten(u32 transferSize, u32 baseAddress)
   VertexShaderManager::InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Whether any of the values in src differs from what is in XF memory at the given address. Games
+// often load the same matrices and viewport again, which then doesn't need to end the batch.
+static bool XFDataChanged(u32 address, u32 count, const DataReader& src, u32 data_index)
+{
+  const u32* current = reinterpret_cast<const u32*>(&xfmem) + address;
+  for (u32 i = 0; i < count; ++i)
+  {
+    if (current[i] != src.Peek<u32>((data_index + i) * sizeof(u32)))
+      return true;
+  }
+  return false;
+}
+
 static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
 {
   u32 address = baseAddress;
@@ -120,10 +135,14 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetViewportChanged();
-      PixelShaderManager::SetViewportChanged();
-      GeometryShaderManager::SetViewportChanged();
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETVIEWPORT + 6 - address, transferSize), src,
+                        dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetViewportChanged();
+        PixelShaderManager::SetViewportChanged();
+        GeometryShaderManager::SetViewportChanged();
+      }
 
       nextAddress = XFMEM_SETVIEWPORT + 6;
       break;
@@ -135,9 +154,13 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetProjectionChanged();
-      GeometryShaderManager::SetProjectionChanged();
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETPROJECTION + 7 - address, transferSize),
+                        src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetProjectionChanged();
+        GeometryShaderManager::SetProjectionChanged();
+      }
 
       nextAddress = XFMEM_SETPROJECTION + 7;
       break;
@@ -155,8 +178,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETTEXMTXINFO + 8 - address, transferSize),
+                        src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      }
 
       nextAddress = XFMEM_SETTEXMTXINFO + 8;
       break;
@@ -169,8 +196,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETPOSTMTXINFO + 8 - address, transferSize),
+                        src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
+      }
 
       nextAddress = XFMEM_SETPOSTMTXINFO + 8;
       break;
@@ -246,10 +277,17 @@ void LoadXFReg(u32 transferSize, u32 baseAddress, DataReader src)
       transferSize = 0;
     }
 
-    XFMemWritten(xfMemTransferSize, xfMemBase);
-    for (u32 i = 0; i < xfMemTransferSize; i++)
+    if (XFDataChanged(xfMemBase, xfMemTransferSize, src, 0))
+    {
+      XFMemWritten(xfMemTransferSize, xfMemBase);
+      for (u32 i = 0; i < xfMemTransferSize; i++)
+      {
+        ((u32*)&xfmem)[xfMemBase + i] = src.Read<u32>();
+      }
+    }
+    else
     {
-      ((u32*)&xfmem)[xfMemBase + i] = src.Read<u32>();
+      src.Skip<u32>(xfMemTransferSize);
     }
   }
 
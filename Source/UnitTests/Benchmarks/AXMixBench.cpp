@@ -0,0 +1,49 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+
+#include "Benchmark.h"
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+namespace
+{
+// The samples of one AX frame of 5 ms at 32 kHz
+constexpr u32 SAMPLES_PER_FRAME = 160;
+// Each voice is mixed into several buses (main, aux A and aux B, left, right and surround)
+constexpr u32 MIXES_PER_FRAME = 64 * 9;
+
+using RampFunction = void (*)(const s16*, s16*, u32, u16, u16);
+
+void RunVolumeRamp(Benchmark::State& state, RampFunction ramp)
+{
+  std::mt19937 rng(0x5eed);
+  std::array<s16, SAMPLES_PER_FRAME> input;
+  for (s16& sample : input)
+    sample = static_cast<s16>(rng());
+  std::array<s16, SAMPLES_PER_FRAME> output;
+
+  while (state.KeepRunning())
+  {
+    for (u32 i = 0; i < MIXES_PER_FRAME; ++i)
+    {
+      ramp(input.data(), output.data(), SAMPLES_PER_FRAME, static_cast<u16>(0x4000 + i),
+           static_cast<u16>(i & 7));
+      Benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetItemsPerIteration(u64{SAMPLES_PER_FRAME} * MIXES_PER_FRAME);
+}
+
+const bool s_registered = [] {
+  Benchmark::Register("AXMix/ApplyVolumeRamp", [](Benchmark::State& state) {
+    RunVolumeRamp(state, DSP::HLE::ApplyVolumeRamp);
+  });
+  Benchmark::Register("AXMix/ApplyVolumeRampScalar", [](Benchmark::State& state) {
+    RunVolumeRamp(state, DSP::HLE::ApplyVolumeRampScalar);
+  });
+  return true;
+}();
+}  // namespace
@@ -0,0 +1,108 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Benchmark.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace Benchmark
+{
+namespace
+{
+struct Entry
+{
+  std::string name;
+  Function function;
+};
+
+std::vector<Entry>& GetRegistry()
+{
+  static std::vector<Entry> registry;
+  return registry;
+}
+}  // namespace
+
+bool Register(std::string name, Function function)
+{
+  GetRegistry().push_back({std::move(name), std::move(function)});
+  return true;
+}
+}  // namespace Benchmark
+
+// Usage: dolphin-bench [--filter <substring>] [--min_time <seconds>] [--list]
+int main(int argc, char** argv)
+{
+  std::string_view filter;
+  double min_time = 0.5;
+  bool list = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+    {
+      filter = argv[++i];
+    }
+    else if (!std::strcmp(argv[i], "--min_time") && i + 1 < argc)
+    {
+      min_time = std::atof(argv[++i]);
+    }
+    else if (!std::strcmp(argv[i], "--list"))
+    {
+      list = true;
+    }
+    else
+    {
+      fmt::print(stderr, "Usage: {} [--filter <substring>] [--min_time <seconds>] [--list]\n",
+                 argv[0]);
+      return 1;
+    }
+  }
+
+  const auto min_duration = std::chrono::duration_cast<Benchmark::State::Clock::duration>(
+      std::chrono::duration<double>(min_time));
+
+  if (!list)
+    fmt::print("{:<48} {:>12} {:>14} {:>12} {:>14}\n", "Benchmark", "Iterations", "ns/iteration",
+               "MB/s", "Mitems/s");
+
+  for (const auto& [name, function] : Benchmark::GetRegistry())
+  {
+    if (name.find(filter) == std::string::npos)
+      continue;
+
+    if (list)
+    {
+      fmt::print("{}\n", name);
+      continue;
+    }
+
+    Benchmark::State state(min_duration);
+    function(state);
+
+    const double seconds = std::chrono::duration<double>(state.GetElapsedTime()).count();
+    const u64 iterations = state.GetIterations();
+    if (iterations == 0 || seconds <= 0)
+    {
+      fmt::print("{:<48} {:>12}\n", name, "skipped");
+      continue;
+    }
+
+    const auto per_second = [&](u64 per_iteration) -> std::string {
+      if (per_iteration == 0)
+        return "";
+      return fmt::format("{:.1f}", per_iteration * iterations / seconds / 1e6);
+    };
+
+    fmt::print("{:<48} {:>12} {:>14.1f} {:>12} {:>14}\n", name, iterations,
+               seconds * 1e9 / iterations, per_second(state.GetBytesPerIteration()),
+               per_second(state.GetItemsPerIteration()));
+  }
+
+  return 0;
+}
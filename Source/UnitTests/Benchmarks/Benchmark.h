@@ -0,0 +1,77 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// A minimal microbenchmark harness for dolphin-bench. Benchmarks are registered at static
+// initialization and run their kernel in a loop for a minimum amount of time:
+//
+//   static const bool s_registered = Benchmark::Register("Name", [](Benchmark::State& state) {
+//     while (state.KeepRunning())
+//       Benchmark::DoNotOptimize(Kernel());
+//     state.SetBytesPerIteration(size);
+//   });
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace Benchmark
+{
+class State
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit State(Clock::duration min_time) : m_min_time(min_time) {}
+
+  // Returns true while another iteration should be run
+  bool KeepRunning()
+  {
+    const Clock::time_point now = Clock::now();
+    if (m_iterations == 0)
+      m_start = now;
+    m_end = now;
+    if (now - m_start >= m_min_time)
+      return false;
+    ++m_iterations;
+    return true;
+  }
+
+  // Used to report the throughput
+  void SetBytesPerIteration(u64 bytes) { m_bytes_per_iteration = bytes; }
+  void SetItemsPerIteration(u64 items) { m_items_per_iteration = items; }
+
+  u64 GetIterations() const { return m_iterations; }
+  Clock::duration GetElapsedTime() const { return m_end - m_start; }
+  u64 GetBytesPerIteration() const { return m_bytes_per_iteration; }
+  u64 GetItemsPerIteration() const { return m_items_per_iteration; }
+
+private:
+  const Clock::duration m_min_time;
+  Clock::time_point m_start;
+  Clock::time_point m_end;
+  u64 m_iterations = 0;
+  u64 m_bytes_per_iteration = 0;
+  u64 m_items_per_iteration = 0;
+};
+
+using Function = std::function<void(State&)>;
+
+// Always returns true, so it can initialize a static variable
+bool Register(std::string name, Function function);
+
+// Keeps the compiler from optimizing away the computation of value
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#ifdef _MSC_VER
+  static const void* volatile sink;
+  sink = &value;
+#else
+  asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+}  // namespace Benchmark
@@ -0,0 +1,61 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <xxhash.h>
+
+#include "Benchmark.h"
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+namespace
+{
+// The size of a 256x256 RGBA8 texture
+constexpr size_t DATA_SIZE = 256 * 256 * 4;
+
+std::vector<u8> MakeData()
+{
+  std::mt19937 rng(0x5eed);
+  std::vector<u8> data(DATA_SIZE);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+  return data;
+}
+
+void RunHash(Benchmark::State& state, u64 (*hash)(const u8*, size_t))
+{
+  // Selects the CRC32 or Murmur implementation of sampled hashes like the texture cache does
+  Common::SetHash64Function();
+
+  const std::vector<u8> data = MakeData();
+  while (state.KeepRunning())
+    Benchmark::DoNotOptimize(hash(data.data(), data.size()));
+  state.SetBytesPerIteration(data.size());
+}
+
+u64 GetHash64(const u8* data, size_t size)
+{
+  return Common::GetHash64(data, static_cast<u32>(size), 0);
+}
+
+// Like the texture cache with a hash sample size of 1024
+u64 GetHash64Sampled(const u8* data, size_t size)
+{
+  return Common::GetHash64(data, static_cast<u32>(size), 1024);
+}
+
+u64 GetXXH64(const u8* data, size_t size)
+{
+  return XXH64(data, size, 0);
+}
+
+const bool s_registered = [] {
+  Benchmark::Register("GetHash64", [](Benchmark::State& state) { RunHash(state, GetHash64); });
+  Benchmark::Register("GetHash64/Sampled",
+                      [](Benchmark::State& state) { RunHash(state, GetHash64Sampled); });
+  Benchmark::Register("XXH64", [](Benchmark::State& state) { RunHash(state, GetXXH64); });
+  return true;
+}();
+}  // namespace
@@ -0,0 +1,63 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+constexpr std::pair<int, const char*> PRIMITIVES[] = {
+    {OpcodeDecoder::GX_DRAW_QUADS, "Quads"},
+    {OpcodeDecoder::GX_DRAW_TRIANGLES, "Triangles"},
+    {OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, "TriangleStrip"},
+    {OpcodeDecoder::GX_DRAW_TRIANGLE_FAN, "TriangleFan"},
+    {OpcodeDecoder::GX_DRAW_LINES, "Lines"},
+    {OpcodeDecoder::GX_DRAW_POINTS, "Points"},
+};
+
+// Draws of a few hundred vertices, as games usually issue them
+constexpr u32 VERTICES_PER_DRAW = 240;
+constexpr u32 DRAW_COUNT = 64;
+
+void GenerateIndices(Benchmark::State& state, int primitive,
+                     bool primitive_restart)
+{
+  g_Config.backend_info.bSupportsPrimitiveRestart = primitive_restart;
+  IndexGenerator generator;
+  generator.Init();
+
+  // Fans and quads need the most indices, with two triangles per vertex at worst
+  std::vector<u16> indices(VERTICES_PER_DRAW * DRAW_COUNT * 6);
+  while (state.KeepRunning())
+  {
+    generator.Start(indices.data());
+    for (u32 i = 0; i < DRAW_COUNT; ++i)
+      generator.AddIndices(primitive, VERTICES_PER_DRAW);
+    Benchmark::DoNotOptimize(indices);
+  }
+  state.SetItemsPerIteration(VERTICES_PER_DRAW * DRAW_COUNT);
+}
+
+const bool s_registered = [] {
+  for (const auto& [primitive, name] : PRIMITIVES)
+  {
+    for (const bool primitive_restart : {false, true})
+    {
+      Benchmark::Register(fmt::format("IndexGenerator/{}{}", name,
+                                      primitive_restart ? "/PrimitiveRestart" : ""),
+                          [primitive = primitive, primitive_restart](Benchmark::State& state) {
+                            GenerateIndices(state, primitive, primitive_restart);
+                          });
+    }
+  }
+  return true;
+}();
+}  // namespace
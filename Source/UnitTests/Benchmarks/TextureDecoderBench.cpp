@@ -0,0 +1,61 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+constexpr std::pair<TextureFormat, const char*> FORMATS[] = {
+    {TextureFormat::I4, "I4"},         {TextureFormat::I8, "I8"},
+    {TextureFormat::IA4, "IA4"},       {TextureFormat::IA8, "IA8"},
+    {TextureFormat::RGB565, "RGB565"}, {TextureFormat::RGB5A3, "RGB5A3"},
+    {TextureFormat::RGBA8, "RGBA8"},   {TextureFormat::C4, "C4"},
+    {TextureFormat::C8, "C8"},         {TextureFormat::C14X2, "C14X2"},
+    {TextureFormat::CMPR, "CMPR"},
+};
+
+constexpr int WIDTH = 512;
+constexpr int HEIGHT = 512;
+// The size of a C14X2 palette, which is the largest one
+constexpr size_t TLUT_SIZE = 0x4000 * 2;
+
+void DecodeTexture(Benchmark::State& state, TextureFormat format)
+{
+  std::mt19937 rng(0x5eed);
+  std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, format));
+  for (u8& byte : src)
+    byte = static_cast<u8>(rng());
+  std::vector<u8> tlut(TLUT_SIZE);
+  for (u8& byte : tlut)
+    byte = static_cast<u8>(rng());
+
+  std::vector<u32> decoded(WIDTH * HEIGHT);
+  while (state.KeepRunning())
+  {
+    TexDecoder_Decode(reinterpret_cast<u8*>(decoded.data()), src.data(), WIDTH, HEIGHT, format,
+                      tlut.data(), TLUTFormat::RGB5A3);
+    Benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesPerIteration(src.size());
+  state.SetItemsPerIteration(WIDTH * HEIGHT);
+}
+
+const bool s_registered = [] {
+  for (const auto& [format, name] : FORMATS)
+  {
+    Benchmark::Register(fmt::format("TexDecoder_Decode/{}", name),
+                        [format = format](Benchmark::State& state) {
+                          DecodeTexture(state, format);
+                        });
+  }
+  return true;
+}();
+}  // namespace
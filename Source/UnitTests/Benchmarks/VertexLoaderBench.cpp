@@ -0,0 +1,148 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+
+#ifdef _M_X86_64
+#include "VideoCommon/VertexLoaderX64.h"
+#elif defined(_M_ARM_64)
+#include "VideoCommon/VertexLoaderARM64.h"
+#endif
+
+namespace
+{
+constexpr int VERTEX_COUNT = 0x10000;
+// Large enough for the input, the output and the arrays of all the configurations
+constexpr size_t BUFFER_SIZE = 4 * 1024 * 1024;
+
+struct VertexConfig
+{
+  const char* name;
+  std::function<void(TVtxDesc*, VAT*)> setup;
+};
+
+const VertexConfig CONFIGS[] = {
+    {"PositionFloat",
+     [](TVtxDesc* desc, VAT* vat) {
+       desc->low.Position = VertexComponentFormat::Direct;
+       vat->g0.PosFormat = ComponentFormat::Float;
+       vat->g0.PosElements = CoordComponentCount::XYZ;
+     }},
+    // Typical for models: fixed point positions and texture coordinates, and a color
+    {"DirectMixed",
+     [](TVtxDesc* desc, VAT* vat) {
+       desc->low.Position = VertexComponentFormat::Direct;
+       desc->low.Normal = VertexComponentFormat::Direct;
+       desc->low.Color0 = VertexComponentFormat::Direct;
+       desc->high.Tex0Coord = VertexComponentFormat::Direct;
+       vat->g0.PosFormat = ComponentFormat::Short;
+       vat->g0.PosElements = CoordComponentCount::XYZ;
+       vat->g0.PosFrac = 8;
+       vat->g0.NormalFormat = ComponentFormat::Byte;
+       vat->g0.NormalElements = NormalComponentCount::N;
+       vat->g0.Color0Comp = ColorFormat::RGBA8888;
+       vat->g0.Color0Elements = ColorComponentCount::RGBA;
+       vat->g0.Tex0CoordFormat = ComponentFormat::Short;
+       vat->g0.Tex0CoordElements = TexComponentCount::ST;
+       vat->g0.Tex0Frac = 8;
+     }},
+    {"Indexed16",
+     [](TVtxDesc* desc, VAT* vat) {
+       desc->low.Position = VertexComponentFormat::Index16;
+       desc->low.Normal = VertexComponentFormat::Index16;
+       desc->high.Tex0Coord = VertexComponentFormat::Index16;
+       vat->g0.PosFormat = ComponentFormat::Float;
+       vat->g0.PosElements = CoordComponentCount::XYZ;
+       vat->g0.NormalFormat = ComponentFormat::Float;
+       vat->g0.NormalElements = NormalComponentCount::N;
+       vat->g0.Tex0CoordFormat = ComponentFormat::Float;
+       vat->g0.Tex0CoordElements = TexComponentCount::ST;
+     }},
+};
+
+using LoaderFactory = std::function<std::unique_ptr<VertexLoaderBase>(const TVtxDesc&, const VAT&)>;
+
+void RunVertexLoader(Benchmark::State& state, const VertexConfig& config,
+                     const LoaderFactory& create_loader)
+{
+  TVtxDesc desc;
+  desc.low.Hex = 0;
+  desc.high.Hex = 0;
+  VAT vat;
+  vat.g0.Hex = 0;
+  vat.g1.Hex = 0;
+  vat.g2.Hex = 0;
+  config.setup(&desc, &vat);
+
+  // Random indices and array contents, which keeps the float conversions away from denormals
+  std::mt19937 rng(0x5eed);
+  std::vector<u8> input(BUFFER_SIZE);
+  for (u8& byte : input)
+    byte = static_cast<u8>(rng() & 0x3f);
+  std::vector<u8> arrays(BUFFER_SIZE);
+  for (u8& byte : arrays)
+    byte = static_cast<u8>(rng() & 0x3f);
+  std::vector<u8> output(BUFFER_SIZE);
+
+  for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; ++i)
+  {
+    VertexLoaderManager::cached_arraybases[i] = arrays.data();
+    g_main_cp_state.array_strides[i] = 12;
+  }
+
+  const std::unique_ptr<VertexLoaderBase> loader = create_loader(desc, vat);
+  const int count =
+      std::min<int>(VERTEX_COUNT, static_cast<int>(BUFFER_SIZE / loader->m_vertex_size));
+  while (state.KeepRunning())
+  {
+    loader->RunVertices(DataReader(input.data(), input.data() + input.size()),
+                        DataReader(output.data(), output.data() + output.size()), count);
+    Benchmark::DoNotOptimize(output);
+  }
+  state.SetBytesPerIteration(u64{loader->m_vertex_size} * count);
+  state.SetItemsPerIteration(count);
+}
+
+const bool s_registered = [] {
+  std::vector<std::pair<const char*, LoaderFactory>> loaders;
+  loaders.emplace_back("VertexLoader", [](const TVtxDesc& desc, const VAT& vat) {
+    return std::make_unique<VertexLoader>(desc, vat);
+  });
+#ifdef _M_X86_64
+  loaders.emplace_back("VertexLoaderX64", [](const TVtxDesc& desc, const VAT& vat) {
+    return std::make_unique<VertexLoaderX64>(desc, vat);
+  });
+#elif defined(_M_ARM_64)
+  loaders.emplace_back("VertexLoaderARM64", [](const TVtxDesc& desc, const VAT& vat) {
+    return std::make_unique<VertexLoaderARM64>(desc, vat);
+  });
+#endif
+
+  for (const VertexConfig& config : CONFIGS)
+  {
+    for (const auto& [loader_name, create_loader] : loaders)
+    {
+      Benchmark::Register(fmt::format("{}/{}", loader_name, config.name),
+                          [&config, create_loader = create_loader](Benchmark::State& state) {
+                            RunVertexLoader(state, config, create_loader);
+                          });
+    }
+  }
+  return true;
+}();
+}  // namespace
@@ -0,0 +1,76 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Image.h"
+
+TEST(Image, CompareRGBAImagesIdentical)
+{
+  std::vector<u8> a(37 * 4);
+  for (size_t i = 0; i < a.size(); ++i)
+    a[i] = static_cast<u8>(i * 7);
+  std::vector<u8> b = a;
+  // Alpha is ignored
+  for (size_t i = 3; i < b.size(); i += 4)
+    b[i] = ~b[i];
+
+  const Common::ImageDifference difference = Common::CompareRGBAImages(a.data(), b.data(), 37);
+  EXPECT_EQ(difference.squared_error, 0u);
+  EXPECT_EQ(difference.mismatched_pixels, 0u);
+  EXPECT_TRUE(std::isinf(Common::GetPSNR(difference, 37)));
+}
+
+TEST(Image, CompareRGBAImagesMatchesReference)
+{
+  std::mt19937 rng(0x5eed);
+
+  // Enough pixels for several SIMD blocks and a tail that is handled one pixel at a time
+  constexpr size_t NUM_PIXELS = 3 * 4096 + 13;
+  std::vector<u8> a(NUM_PIXELS * 4);
+  std::vector<u8> b(NUM_PIXELS * 4);
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    a[i] = static_cast<u8>(rng());
+    // Most pixels are equal and some are as different as they can be
+    if (rng() % 4 == 0)
+      b[i] = static_cast<u8>(rng());
+    else if (rng() % 64 == 0)
+      b[i] = a[i] < 128 ? 255 : 0;
+    else
+      b[i] = a[i];
+  }
+
+  u64 squared_error = 0;
+  u64 mismatched_pixels = 0;
+  for (size_t pixel = 0; pixel < NUM_PIXELS; ++pixel)
+  {
+    bool mismatch = false;
+    for (size_t c = 0; c < 3; ++c)
+    {
+      const int diff = a[pixel * 4 + c] - b[pixel * 4 + c];
+      squared_error += diff * diff;
+      mismatch |= diff != 0;
+    }
+    mismatched_pixels += mismatch;
+  }
+
+  const Common::ImageDifference difference =
+      Common::CompareRGBAImages(a.data(), b.data(), NUM_PIXELS);
+  EXPECT_EQ(difference.squared_error, squared_error);
+  EXPECT_EQ(difference.mismatched_pixels, mismatched_pixels);
+}
+
+TEST(Image, GetPSNR)
+{
+  // A difference of 1 in every component
+  Common::ImageDifference difference;
+  difference.squared_error = 300;
+  difference.mismatched_pixels = 100;
+  EXPECT_NEAR(Common::GetPSNR(difference, 100), 48.1308, 0.0001);
+}
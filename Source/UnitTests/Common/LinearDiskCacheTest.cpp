@@ -0,0 +1,126 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+class EntryCollector : public LinearDiskCacheReader<u32, u8>
+{
+public:
+  void Read(const u32& key, const u8* value, u32 value_size) override
+  {
+    entries.emplace_back(key, std::vector<u8>(value, value + value_size));
+    values.push_back(value);
+  }
+
+  std::vector<std::pair<u32, std::vector<u8>>> entries;
+  std::vector<const u8*> values;
+};
+}  // namespace
+
+class LinearDiskCacheTest : public testing::Test
+{
+protected:
+  LinearDiskCacheTest()
+      : m_parent_directory(File::CreateTempDir()), m_file_path(m_parent_directory + "/cache.bin")
+  {
+  }
+
+  ~LinearDiskCacheTest() override
+  {
+    if (!m_parent_directory.empty())
+      File::DeleteDirRecursively(m_parent_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_parent_directory.empty())
+      FAIL();
+  }
+
+  void WriteEntries()
+  {
+    LinearDiskCache<u32, u8> cache;
+    EntryCollector reader;
+    ASSERT_EQ(cache.OpenAndRead(m_file_path, reader), 0u);
+    cache.Append(1, FIRST_VALUE.data(), static_cast<u32>(FIRST_VALUE.size()));
+    cache.Append(2, FIRST_VALUE.data(), 0);
+    cache.Append(3, SECOND_VALUE.data(), static_cast<u32>(SECOND_VALUE.size()));
+    cache.Close();
+  }
+
+  const std::vector<u8> FIRST_VALUE{1, 2, 3, 4, 5};
+  const std::vector<u8> SECOND_VALUE{6, 7, 8};
+  const std::string m_parent_directory;
+  const std::string m_file_path;
+};
+
+TEST_F(LinearDiskCacheTest, ReadsAppendedEntries)
+{
+  WriteEntries();
+
+  LinearDiskCache<u32, u8> cache;
+  EntryCollector reader;
+  ASSERT_EQ(cache.OpenAndRead(m_file_path, reader), 3u);
+  ASSERT_EQ(reader.entries.size(), 3u);
+  EXPECT_EQ(reader.entries[0], std::make_pair(u32{1}, FIRST_VALUE));
+  EXPECT_EQ(reader.entries[1], std::make_pair(u32{2}, std::vector<u8>()));
+  EXPECT_EQ(reader.entries[2], std::make_pair(u32{3}, SECOND_VALUE));
+
+  // The values stay readable after OpenAndRead, until the cache is closed
+  EXPECT_EQ(std::vector<u8>(reader.values[2], reader.values[2] + SECOND_VALUE.size()),
+            SECOND_VALUE);
+}
+
+TEST_F(LinearDiskCacheTest, DropsTruncatedEntryAndAppendsAfterTheRest)
+{
+  WriteEntries();
+  const u64 size = File::GetSize(m_file_path);
+  {
+    File::IOFile file(m_file_path, "r+b");
+    ASSERT_TRUE(file.Resize(size - 1));
+  }
+
+  {
+    LinearDiskCache<u32, u8> cache;
+    EntryCollector reader;
+    ASSERT_EQ(cache.OpenAndRead(m_file_path, reader), 2u);
+    cache.Append(4, SECOND_VALUE.data(), static_cast<u32>(SECOND_VALUE.size()));
+    cache.Close();
+  }
+
+  LinearDiskCache<u32, u8> cache;
+  EntryCollector reader;
+  ASSERT_EQ(cache.OpenAndRead(m_file_path, reader), 3u);
+  EXPECT_EQ(reader.entries[2], std::make_pair(u32{4}, SECOND_VALUE));
+}
+
+TEST_F(LinearDiskCacheTest, RecreatesFileWithBadHeader)
+{
+  {
+    File::IOFile file(m_file_path, "wb");
+    ASSERT_TRUE(file.WriteBytes("not a cache", 11));
+  }
+
+  {
+    LinearDiskCache<u32, u8> cache;
+    EntryCollector reader;
+    EXPECT_EQ(cache.OpenAndRead(m_file_path, reader), 0u);
+    cache.Append(1, FIRST_VALUE.data(), static_cast<u32>(FIRST_VALUE.size()));
+  }
+
+  LinearDiskCache<u32, u8> cache;
+  EntryCollector reader;
+  ASSERT_EQ(cache.OpenAndRead(m_file_path, reader), 1u);
+  EXPECT_EQ(reader.entries[0], std::make_pair(u32{1}, FIRST_VALUE));
+}
@@ -0,0 +1,70 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32, 4> q;
+
+  u32 v;
+  EXPECT_FALSE(q.TryPop(v));
+  EXPECT_EQ(0u, q.Size());
+
+  // Test the FIFO order across several laps.
+  for (u32 lap = 0; lap < 3; ++lap)
+  {
+    for (u32 i = 0; i < 4; ++i)
+      EXPECT_TRUE(q.TryPush(lap * 4 + i));
+    EXPECT_EQ(4u, q.Size());
+    EXPECT_FALSE(q.TryPush(100u));
+
+    for (u32 i = 0; i < 4; ++i)
+    {
+      EXPECT_TRUE(q.TryPop(v));
+      EXPECT_EQ(lap * 4 + i, v);
+    }
+    EXPECT_FALSE(q.TryPop(v));
+    EXPECT_EQ(0u, q.Size());
+  }
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 PRODUCERS = 4;
+  constexpr u32 VALUES_PER_PRODUCER = 100000;
+  Common::MPSCQueue<u32, 256> q;
+
+  auto inserter = [&q](u32 producer) {
+    for (u32 i = 0; i < VALUES_PER_PRODUCER; ++i)
+    {
+      while (!q.TryPush(producer * VALUES_PER_PRODUCER + i))
+        std::this_thread::yield();
+    }
+  };
+
+  std::vector<std::thread> inserter_threads;
+  for (u32 producer = 0; producer < PRODUCERS; ++producer)
+    inserter_threads.emplace_back(inserter, producer);
+
+  // The values of every producer must be popped in the order they were pushed
+  std::vector<u32> next_value(PRODUCERS, 0);
+  for (u32 popped = 0; popped < PRODUCERS * VALUES_PER_PRODUCER; ++popped)
+  {
+    u32 v;
+    while (!q.TryPop(v))
+      std::this_thread::yield();
+    const u32 producer = v / VALUES_PER_PRODUCER;
+    ASSERT_LT(producer, PRODUCERS);
+    EXPECT_EQ(next_value[producer], v % VALUES_PER_PRODUCER);
+    next_value[producer] = v % VALUES_PER_PRODUCER + 1;
+  }
+
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+  EXPECT_EQ(0u, q.Size());
+}
@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+
+class MappedFileTest : public testing::Test
+{
+protected:
+  MappedFileTest()
+      : m_parent_directory(File::CreateTempDir()), m_file_path(m_parent_directory + "/file.bin")
+  {
+  }
+
+  ~MappedFileTest() override
+  {
+    if (!m_parent_directory.empty())
+      File::DeleteDirRecursively(m_parent_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_parent_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_parent_directory;
+  const std::string m_file_path;
+};
+
+TEST_F(MappedFileTest, MapsContents)
+{
+  constexpr std::array<u8, 5> contents = {1, 2, 3, 4, 5};
+  {
+    File::IOFile file(m_file_path, "wb");
+    ASSERT_TRUE(file.WriteBytes(contents.data(), contents.size()));
+  }
+
+  File::MappedFile mapping(m_file_path);
+  ASSERT_TRUE(mapping.IsOpen());
+  ASSERT_EQ(mapping.GetSize(), contents.size());
+  EXPECT_EQ(std::memcmp(mapping.GetData(), contents.data(), contents.size()), 0);
+
+  mapping.Close();
+  EXPECT_FALSE(mapping.IsOpen());
+  EXPECT_EQ(mapping.GetData(), nullptr);
+}
+
+TEST_F(MappedFileTest, FailsOnMissingAndEmptyFiles)
+{
+  File::MappedFile mapping;
+  EXPECT_FALSE(mapping.Open(m_file_path));
+
+  File::CreateEmptyFile(m_file_path);
+  EXPECT_FALSE(mapping.Open(m_file_path));
+  EXPECT_FALSE(mapping.IsOpen());
+}
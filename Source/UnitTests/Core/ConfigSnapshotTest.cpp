@@ -0,0 +1,47 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Common/Config/Config.h"
+#include "Core/Config/ConfigSnapshot.h"
+#include "Core/Config/MainSettings.h"
+
+class ConfigSnapshotTest : public testing::Test
+{
+protected:
+  void SetUp() override { Config::Init(); }
+  void TearDown() override { Config::Shutdown(); }
+};
+
+TEST_F(ConfigSnapshotTest, FollowsConfigChanges)
+{
+  Config::SetCurrent(Config::MAIN_ENABLE_CHEATS, true);
+  Config::SetCurrent(Config::MAIN_REWIND_INTERVAL, 7);
+  EXPECT_TRUE(Config::GetSnapshot().enable_cheats);
+  EXPECT_EQ(7, Config::GetSnapshot().rewind_interval);
+  EXPECT_EQ(Config::GetConfigVersion(), Config::GetSnapshot().config_version);
+
+  Config::SetCurrent(Config::MAIN_ENABLE_CHEATS, false);
+  EXPECT_FALSE(Config::GetSnapshot().enable_cheats);
+  EXPECT_EQ(7, Config::GetSnapshot().rewind_interval);
+}
+
+TEST_F(ConfigSnapshotTest, SharedBetweenThreads)
+{
+  Config::SetCurrent(Config::MAIN_REWIND_INTERVAL, 3);
+  const Config::Snapshot* snapshot = &Config::GetSnapshot();
+  EXPECT_EQ(snapshot, &Config::GetSnapshot());
+
+  const Config::Snapshot* other_snapshot = nullptr;
+  std::thread([&] { other_snapshot = &Config::GetSnapshot(); }).join();
+  EXPECT_EQ(snapshot, other_snapshot);
+
+  // A snapshot stays valid for the thread that holds it while another thread moves on
+  Config::SetCurrent(Config::MAIN_REWIND_INTERVAL, 4);
+  std::thread([] { EXPECT_EQ(4, Config::GetSnapshot().rewind_interval); }).join();
+  EXPECT_EQ(3, snapshot->rewind_interval);
+  EXPECT_EQ(4, Config::GetSnapshot().rewind_interval);
+}
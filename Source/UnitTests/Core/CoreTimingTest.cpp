@@ -115,6 +115,37 @@ TEST(CoreTiming, BasicOrder)
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
 
+TEST(CoreTiming, RemoveEvent)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = CoreTiming::RegisterEvent("callbackB", CallbackTemplate<1>);
+  CoreTiming::EventType* cb_c = CoreTiming::RegisterEvent("callbackC", CallbackTemplate<2>);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  // Interleave enough events to fill several levels of the queue
+  for (int i = 0; i < 10; ++i)
+  {
+    CoreTiming::ScheduleEvent(100 + i * 30, cb_a, CB_IDS[0]);
+    CoreTiming::ScheduleEvent(110 + i * 30, cb_b, CB_IDS[1]);
+  }
+  CoreTiming::ScheduleEvent(1000, cb_c, CB_IDS[2]);
+
+  CoreTiming::RemoveEvent(cb_b);
+  CoreTiming::RemoveEvent(cb_b);
+  CoreTiming::RemoveEvent(cb_c);
+  CoreTiming::ScheduleEvent(600, cb_c, CB_IDS[2]);
+
+  for (int i = 0; i < 9; ++i)
+    AdvanceAndCheck(0, 30);
+  AdvanceAndCheck(0, 230);
+  AdvanceAndCheck(2, MAX_SLICE_LENGTH);
+}
+
 namespace SharedSlotTest
 {
 static unsigned int s_counter = 0;
@@ -0,0 +1,47 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+TEST(AXMix, ApplyVolumeRampMatchesScalar)
+{
+  std::mt19937 rng(0x5eed);
+
+  // Volumes and deltas covering both ends of the range, including ramps which wrap around
+  constexpr std::array<u16, 8> volumes = {0, 1, 0x4000, 0x7FFF, 0x8000, 0xC000, 0xFFF0, 0xFFFF};
+  constexpr std::array<u16, 6> deltas = {0, 1, 0x20, 0x7FFF, 0xFFFF, 0xFF00};
+  for (const u16 volume : volumes)
+  {
+    for (const u16 delta : deltas)
+    {
+      for (u32 count = 0; count <= 96; count++)
+      {
+        SCOPED_TRACE(fmt::format("volume {} delta {} count {}", volume, delta, count));
+
+        std::array<s16, 96> input;
+        for (s16& sample : input)
+          sample = static_cast<s16>(rng());
+        input[0] = -32768;
+        input[1] = 32767;
+
+        std::array<s16, 96> expected{};
+        std::array<s16, 96> actual{};
+        DSP::HLE::ApplyVolumeRampScalar(input.data(), expected.data(), count, volume, delta);
+        DSP::HLE::ApplyVolumeRamp(input.data(), actual.data(), count, volume, delta);
+        ASSERT_EQ(expected, actual);
+
+        // In place, as it is used for the volume envelope
+        DSP::HLE::ApplyVolumeRamp(input.data(), input.data(), count, volume, delta);
+        for (u32 i = 0; i < count; i++)
+          ASSERT_EQ(expected[i], input[i]);
+      }
+    }
+  }
+}
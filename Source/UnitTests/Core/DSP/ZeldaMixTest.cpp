@@ -0,0 +1,156 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/ZeldaMix.h"
+
+namespace ZeldaMix = DSP::HLE::ZeldaMix;
+
+// The renderer works on buffers of 0x50 samples, the partial counts cover the scalar tails
+constexpr u32 MAX_COUNT = 0x50;
+
+template <size_t N>
+static void FillRandom(std::array<s16, N>* buffer, std::mt19937* rng)
+{
+  for (s16& sample : *buffer)
+    sample = static_cast<s16>((*rng)());
+  (*buffer)[0] = -32768;
+  (*buffer)[1] = 32767;
+  (*buffer)[2] = -32768;
+}
+
+TEST(ZeldaMix, AddWithVolumeRampMatchesScalar)
+{
+  std::mt19937 rng(0x2e1da);
+
+  // Ramps as LoadInputSamples and AddVoice set them up, from full negative to full positive
+  constexpr std::array<s32, 6> volumes = {0, 1 << 16, 0x4000 << 16, 0x7FFF << 16, -0x8000 * 65536,
+                                          -0x10000};
+  constexpr std::array<s32, 6> steps = {0, 1, -1, 0x1000000 / MAX_COUNT, -0x7FFF0000 / MAX_COUNT,
+                                        0x7FFF0000 / MAX_COUNT};
+  for (const s32 volume : volumes)
+  {
+    for (const s32 step : steps)
+    {
+      for (u32 count = 0; count <= MAX_COUNT; count++)
+      {
+        SCOPED_TRACE(fmt::format("volume {:#x} step {:#x} count {}", volume, step, count));
+
+        // Stay within the range of an s32, the scalar version would overflow otherwise
+        const s64 last_volume = static_cast<s64>(volume) + static_cast<s64>(step) * count;
+        if (last_volume < INT32_MIN || last_volume > INT32_MAX)
+          continue;
+
+        std::array<s16, MAX_COUNT> src;
+        std::array<s16, MAX_COUNT> expected;
+        FillRandom(&src, &rng);
+        FillRandom(&expected, &rng);
+        std::array<s16, MAX_COUNT> actual = expected;
+
+        const s32 expected_volume =
+            ZeldaMix::AddWithVolumeRampScalar(expected.data(), src.data(), count, volume, step);
+        const s32 actual_volume =
+            ZeldaMix::AddWithVolumeRamp(actual.data(), src.data(), count, volume, step);
+        ASSERT_EQ(expected_volume, actual_volume);
+        ASSERT_EQ(expected, actual);
+      }
+    }
+  }
+}
+
+TEST(ZeldaMix, AddWithVolumeMatchesScalar)
+{
+  std::mt19937 rng(0x2e1db);
+
+  // 0x7FFF and 0xB820 are the reverb mixing volumes
+  constexpr std::array<u16, 7> volumes = {0, 1, 0x4000, 0x7FFF, 0x8000, 0xB820, 0xFFFF};
+  for (const u16 volume : volumes)
+  {
+    for (u32 count = 0; count <= MAX_COUNT; count++)
+    {
+      SCOPED_TRACE(fmt::format("volume {:#x} count {}", volume, count));
+
+      std::array<s16, MAX_COUNT> src;
+      std::array<s16, MAX_COUNT> expected;
+      FillRandom(&src, &rng);
+      FillRandom(&expected, &rng);
+      std::array<s16, MAX_COUNT> actual = expected;
+
+      ZeldaMix::AddWithVolumeScalar(expected.data(), src.data(), count, volume);
+      ZeldaMix::AddWithVolume(actual.data(), src.data(), count, volume);
+      ASSERT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(ZeldaMix, ApplyVolumeMatchesScalar)
+{
+  std::mt19937 rng(0x2e1dc);
+
+  // The 1.15 and 4.12 formats, 0x6784 is the back buffer volume
+  constexpr std::array<u32, 2> shifts = {15, 12};
+  constexpr std::array<u16, 7> volumes = {0, 1, 0x1000, 0x6784, 0x7FFF, 0x8000, 0xFFFF};
+  for (const u32 shift : shifts)
+  {
+    for (const u16 volume : volumes)
+    {
+      for (u32 count = 0; count <= MAX_COUNT; count++)
+      {
+        SCOPED_TRACE(fmt::format("shift {} volume {:#x} count {}", shift, volume, count));
+
+        std::array<s16, MAX_COUNT> expected;
+        FillRandom(&expected, &rng);
+        std::array<s16, MAX_COUNT> actual = expected;
+
+        ZeldaMix::ApplyVolumeScalar(expected.data(), count, volume, shift);
+        ZeldaMix::ApplyVolume(actual.data(), count, volume, shift);
+        ASSERT_EQ(expected, actual);
+      }
+    }
+  }
+}
+
+TEST(ZeldaMix, ResampleMatchesScalar)
+{
+  std::mt19937 rng(0x2e1dd);
+
+  // Filters with extreme coefficients, where the sum of the four products needs 34 bits
+  std::array<s16, 0x100> coeffs;
+  FillRandom(&coeffs, &rng);
+  for (size_t i = 0; i < 0x10; i++)
+    coeffs[i] = (i & 1) ? 32767 : -32768;
+
+  // Interpolation is only used below a 4:1 ratio
+  constexpr std::array<u32, 6> ratios = {0, 0x1, 0x800, 0x1000, 0x1234, 0x3FFF};
+  constexpr std::array<u32, 4> positions = {0, 0x3F, 0x800, 0xFFF};
+  for (const u32 ratio : ratios)
+  {
+    for (const u32 pos : positions)
+    {
+      for (u32 count = 0; count <= MAX_COUNT; count++)
+      {
+        SCOPED_TRACE(fmt::format("ratio {:#x} pos {:#x} count {}", ratio, pos, count));
+
+        std::array<s16, 4 * MAX_COUNT + 8> src;
+        FillRandom(&src, &rng);
+        for (size_t i = 0; i < 8; i++)
+          src[i] = (i & 1) ? 32767 : -32768;
+
+        std::array<s16, MAX_COUNT> expected{};
+        std::array<s16, MAX_COUNT> actual{};
+        const u32 expected_pos = ZeldaMix::ResampleScalar(src.data(), expected.data(), count, pos,
+                                                          ratio, coeffs.data());
+        const u32 actual_pos =
+            ZeldaMix::Resample(src.data(), actual.data(), count, pos, ratio, coeffs.data());
+        ASSERT_EQ(expected_pos, actual_pos);
+        ASSERT_EQ(expected, actual);
+      }
+    }
+  }
+}
@@ -469,3 +469,22 @@ TEST_F(FileSystemTest, CreateFullPath)
   EXPECT_EQ(m_fs->CreateFullPath(Uid{0x1000}, Gid{1}, "/shared2/wc24/mbox/Readme.txt", 0, modes),
             ResultCode::Success);
 }
+
+TEST_F(FileSystemTest, MetadataPersistsAcrossInstances)
+{
+  constexpr u8 ArbitraryAttribute = 0xE1;
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", ArbitraryAttribute, modes),
+            ResultCode::Success);
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/d"), ResultCode::Success);
+
+  // Metadata writes are batched, so make sure they are flushed when the filesystem goes away.
+  m_fs.reset();
+  m_fs = IOS::HLE::Kernel{}.GetFS();
+
+  const Result<Metadata> stats = m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f");
+  ASSERT_TRUE(stats.Succeeded());
+  EXPECT_EQ(stats->modes, modes);
+  EXPECT_EQ(stats->attribute, ArbitraryAttribute);
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/d").Error(), ResultCode::NotFound);
+}
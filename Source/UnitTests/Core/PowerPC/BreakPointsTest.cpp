@@ -0,0 +1,52 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#include "Core/PowerPC/BreakPoints.h"
+
+using Comparison = TBreakPointCondition::Comparison;
+
+TEST(BreakPointCondition, Parse)
+{
+  const std::optional<TBreakPointCondition> equal = TBreakPointCondition::Parse("r3==80001234");
+  ASSERT_TRUE(equal);
+  EXPECT_EQ(3u, equal->gpr);
+  EXPECT_EQ(Comparison::Equal, equal->comparison);
+  EXPECT_EQ(0x80001234u, equal->value);
+
+  const std::optional<TBreakPointCondition> less_equal = TBreakPointCondition::Parse("r31<=ff");
+  ASSERT_TRUE(less_equal);
+  EXPECT_EQ(31u, less_equal->gpr);
+  EXPECT_EQ(Comparison::LessEqual, less_equal->comparison);
+  EXPECT_EQ(0xffu, less_equal->value);
+
+  EXPECT_FALSE(TBreakPointCondition::Parse(""));
+  EXPECT_FALSE(TBreakPointCondition::Parse("r32==0"));
+  EXPECT_FALSE(TBreakPointCondition::Parse("r==0"));
+  EXPECT_FALSE(TBreakPointCondition::Parse("r3=="));
+  EXPECT_FALSE(TBreakPointCondition::Parse("r3=0"));
+  EXPECT_FALSE(TBreakPointCondition::Parse("f1==0"));
+}
+
+TEST(BreakPointCondition, RoundTrip)
+{
+  for (const char* text : {"r0==0", "r3!=1", "r4<80000000", "r5<=a", "r6>b", "r7>=ffffffff"})
+  {
+    const std::optional<TBreakPointCondition> condition = TBreakPointCondition::Parse(text);
+    ASSERT_TRUE(condition) << text;
+    EXPECT_EQ(text, condition->ToString());
+  }
+}
+
+TEST(BreakPointCondition, IsMet)
+{
+  EXPECT_TRUE(TBreakPointCondition::Parse("r1<10")->IsMet(0xf));
+  EXPECT_FALSE(TBreakPointCondition::Parse("r1<10")->IsMet(0x10));
+  // Comparisons are unsigned
+  EXPECT_TRUE(TBreakPointCondition::Parse("r1>10")->IsMet(0xffffffff));
+  EXPECT_TRUE(TBreakPointCondition::Parse("r1>=10")->IsMet(0x10));
+  EXPECT_TRUE(TBreakPointCondition::Parse("r1!=10")->IsMet(0));
+}
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+
+# Renders every FIFO log of a directory with two configurations of dolphin-emu-nogui and compares
+# the frame dumps pixel by pixel. Each FIFO log is played once per configuration, in parallel, with
+# its own temporary user directory.
+#
+# Example: compare two builds with the Vulkan backend
+#
+# $ Tools/fifo-regression.py --binary-a old/dolphin-emu-nogui --binary-b new/dolphin-emu-nogui \
+#     --backend-a Vulkan --backend-b Vulkan ~/fifologs
+#
+# Example: compare two backends with the same build
+#
+# $ Tools/fifo-regression.py --binary-a build/Binaries/dolphin-emu-nogui \
+#     --backend-a OGL --backend-b Vulkan ~/fifologs
+
+import argparse
+import concurrent.futures
+import json
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def render(binary, backend, dff, user_dir, timeout):
+    cmd = [binary, "-u", user_dir, "--fifo_dump_frames", "-e", str(dff)]
+    if backend:
+        cmd += ["-v", backend]
+    result = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True,
+                            timeout=timeout)
+    if result.returncode != 0:
+        raise RuntimeError(f"{' '.join(cmd)} failed:\n{result.stderr}")
+    return os.path.join(user_dir, "Dump", "Frames")
+
+
+def compare(binary, dir_a, dir_b):
+    result = subprocess.run([binary, "--compare_frame_dumps", f"{dir_a},{dir_b}"],
+                            stdout=subprocess.PIPE, check=True, text=True)
+    lines = [json.loads(line) for line in result.stdout.splitlines() if line.startswith("{")]
+    return lines[:-1], lines[-1]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare the frame dumps of FIFO logs rendered with two configurations")
+    parser.add_argument("fifologs", type=pathlib.Path, help="directory of .dff files")
+    parser.add_argument("--binary-a", required=True, help="dolphin-emu-nogui of the reference")
+    parser.add_argument("--binary-b", help="dolphin-emu-nogui to test, defaults to --binary-a")
+    parser.add_argument("--backend-a", help="video backend of the reference")
+    parser.add_argument("--backend-b", help="video backend to test, defaults to --backend-a")
+    parser.add_argument("--min-psnr", type=float, default=float("inf"),
+                        help="lowest PSNR in dB a frame may have, by default frames must be "
+                        "identical")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(),
+                        help="number of emulator instances to run at once")
+    parser.add_argument("--timeout", type=float, default=600, help="timeout of one render in s")
+    parser.add_argument("--keep", action="store_true", help="keep the frame dumps")
+    args = parser.parse_args()
+
+    binary_b = args.binary_b or args.binary_a
+    backend_b = args.backend_b or args.backend_a
+
+    dffs = sorted(args.fifologs.glob("*.dff"))
+    if not dffs:
+        sys.exit(f"no FIFO logs in {args.fifologs}")
+
+    work_dir = tempfile.mkdtemp(prefix="fifo-regression-")
+    failures = 0
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        renders = {}
+        for dff in dffs:
+            for side, binary, backend in (("a", args.binary_a, args.backend_a),
+                                          ("b", binary_b, backend_b)):
+                user_dir = os.path.join(work_dir, dff.stem, side)
+                os.makedirs(user_dir)
+                renders[(dff, side)] = executor.submit(render, binary, backend, dff, user_dir,
+                                                       args.timeout)
+
+        for dff in dffs:
+            try:
+                dir_a = renders[(dff, "a")].result()
+                dir_b = renders[(dff, "b")].result()
+            except (RuntimeError, subprocess.TimeoutExpired) as e:
+                print(f"{dff.name}: FAIL\n{e}")
+                failures += 1
+                continue
+
+            frames, summary = compare(args.binary_a, dir_a, dir_b)
+            bad_frames = []
+            for frame in frames:
+                psnr = frame.get("psnr")
+                if "error" in frame or (psnr is not None and psnr < args.min_psnr):
+                    bad_frames.append(frame)
+
+            status = "FAIL" if bad_frames or summary["frames"] == 0 else "OK"
+            min_psnr = summary["min_psnr"]
+            print(f"{dff.name}: {status}, {summary['frames']} frames, "
+                  f"{summary['mismatched_frames']} mismatched, min PSNR "
+                  f"{'inf' if min_psnr is None else f'{min_psnr:.3f} dB'}")
+            for frame in bad_frames:
+                if "error" in frame:
+                    print(f"  frame {frame['frame']}: {frame['error']}")
+                else:
+                    print(f"  frame {frame['frame']}: PSNR {frame['psnr']:.3f} dB, "
+                          f"{frame['mismatched_pixels']} mismatched pixels")
+            if status == "FAIL":
+                failures += 1
+
+    if args.keep:
+        print(f"frame dumps kept in {work_dir}")
+    else:
+        shutil.rmtree(work_dir)
+
+    print(f"{len(dffs) - failures}/{len(dffs)} FIFO logs passed")
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+
+# Replays a manifest of movies and FIFO logs with dolphin-emu-nogui as fast as possible, writes the
+# emulation speed, CPU idle time, JIT compile time and shader compile counts of every entry to a
+# JSON report, and optionally compares them against the report of a baseline build.
+#
+# The manifest is a JSON list of entries. Paths are relative to the manifest:
+#
+#   [
+#     {"name": "smg-intro", "game": "smg.rvz", "movie": "smg-intro.dtm", "frames": [600, 2400]},
+#     {"name": "mkdd-race", "fifolog": "mkdd-race.dff", "loops": 3}
+#   ]
+#
+# Every entry runs on its own in a fresh user directory, so all of them use the default
+# configuration apart from the options given on the command line.
+#
+# Example: record a baseline, then compare a new build against it
+#
+# $ Tools/perf-regression.py --binary old/dolphin-emu-nogui --output baseline.json manifest.json
+# $ Tools/perf-regression.py --binary new/dolphin-emu-nogui --baseline baseline.json \
+#     --output new.json manifest.json
+
+import argparse
+import json
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import tempfile
+
+# Metrics which are compared against the baseline, and whether higher values are better. The idle
+# percentage depends on the emulated game rather than on the host, so it is only reported.
+METRICS = {
+    "fps": True,
+    "jit_compile_ms": False,
+    "shaders_created": False,
+    "pipeline_compile_stalls": False,
+    "jit_cache_full_clears": False,
+}
+
+
+def run(binary, entry, base_dir, user_dir, args):
+    cmd = [binary, "-u", user_dir]
+    if args.backend:
+        cmd += ["-v", args.backend]
+    if args.cpu_core is not None:
+        cmd += ["--cpu_core", str(args.cpu_core)]
+    if "movie" in entry:
+        first, last = entry["frames"]
+        cmd += ["--movie", str(base_dir / entry["movie"]), "--benchmark_frames", f"{first},{last}",
+                "-e", str(base_dir / entry["game"])]
+    else:
+        cmd += ["--fifo_benchmark", str(entry.get("loops", 1)), "-e",
+                str(base_dir / entry["fifolog"])]
+
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True,
+                            timeout=args.timeout)
+    if result.returncode != 0:
+        raise RuntimeError(f"{' '.join(cmd)} failed:\n{result.stderr}")
+    reports = [json.loads(line) for line in result.stdout.splitlines() if line.startswith("{")]
+    if not reports or reports[-1].get("frames", 0) == 0:
+        raise RuntimeError(f"{' '.join(cmd)} recorded no frames:\n{result.stderr}")
+    return reports[-1]
+
+
+def compare(report, baseline, max_regression):
+    regressions = []
+    for metric, higher_is_better in METRICS.items():
+        if metric not in report or metric not in baseline:
+            continue
+        old = baseline[metric]
+        new = report[metric]
+        change = (new - old) / old * 100 if old else 0.0
+        regressed = -change > max_regression if higher_is_better else change > max_regression
+        # Counts which were zero before are regressions as soon as they appear
+        if not old and not higher_is_better and new > 0:
+            regressed = True
+        print(f"  {metric}: {old} -> {new} ({change:+.1f}%){' REGRESSION' if regressed else ''}")
+        if regressed:
+            regressions.append(metric)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure the emulation speed of a manifest of movies and FIFO logs")
+    parser.add_argument("manifest", type=pathlib.Path, help="JSON list of entries to replay")
+    parser.add_argument("--binary", required=True, help="dolphin-emu-nogui to measure")
+    parser.add_argument("--backend", help="video backend to use")
+    parser.add_argument("--cpu-core", type=int, help="host CPU core to pin Dolphin to")
+    parser.add_argument("--runs", type=int, default=1,
+                        help="number of runs of each entry, the fastest one is reported")
+    parser.add_argument("--output", help="file to write the report to")
+    parser.add_argument("--baseline", help="report of an earlier run to compare against")
+    parser.add_argument("--max-regression", type=float, default=5,
+                        help="largest change in percent of a metric for the worse that passes")
+    parser.add_argument("--timeout", type=float, default=1800, help="timeout of one run in s")
+    args = parser.parse_args()
+
+    with open(args.manifest) as f:
+        entries = json.load(f)
+    base_dir = args.manifest.parent
+
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)["entries"]
+
+    # The runs are sequential, parallel instances would slow down each other
+    work_dir = tempfile.mkdtemp(prefix="perf-regression-")
+    results = {}
+    failures = 0
+    for entry in entries:
+        name = entry["name"]
+        try:
+            best = None
+            for i in range(args.runs):
+                user_dir = os.path.join(work_dir, name, str(i))
+                os.makedirs(user_dir)
+                report = run(args.binary, entry, base_dir, user_dir, args)
+                if best is None or report["fps"] > best["fps"]:
+                    best = report
+        except (RuntimeError, subprocess.TimeoutExpired) as e:
+            print(f"{name}: FAIL\n{e}")
+            failures += 1
+            continue
+
+        results[name] = best
+        print(f"{name}: {best['frames']} frames, {best['fps']:.2f} FPS, "
+              f"{best['idle_percent']:.2f}% idle, {best['jit_compile_ms']:.1f} ms JIT, "
+              f"{best['shaders_created']} shaders")
+        if name in baseline and compare(best, baseline[name], args.max_regression):
+            failures += 1
+    shutil.rmtree(work_dir)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"binary": args.binary, "backend": args.backend, "entries": results}, f,
+                      indent=2)
+
+    print(f"{len(entries) - failures}/{len(entries)} entries passed")
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+
+# Plays several movies which start from the same savestate in parallel dolphin-emu-nogui processes,
+# and prints the RAM hashes of every movie at the given frames as one JSON object. This turns a
+# search over input sequences (load the state, apply the inputs, run some frames, compare the RAM)
+# into independent runs which scale with the number of host cores.
+#
+# Every movie is a branch recorded from a savestate. By default each movie uses its own copy of the
+# state next to it (<movie>.sav), as Dolphin saves it when recording. With --state, all branches
+# start from the given state instead.
+#
+# Example: hash MEM1 and MEM2 of 16 branches after 60 and 300 frames
+#
+# $ Tools/run-branches.py --binary dolphin-emu-nogui --game smg.rvz --frames 60,300 \
+#     --state base.sav branches/*.dtm
+
+import argparse
+import concurrent.futures
+import json
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def run(binary, game, movie, frames, work_dir, args):
+    user_dir = os.path.join(work_dir, "user")
+    os.makedirs(user_dir)
+    if args.state:
+        # Dolphin loads the state of a movie from the file next to it
+        linked_movie = os.path.join(work_dir, movie.name)
+        os.symlink(movie.resolve(), linked_movie)
+        os.symlink(args.state.resolve(), linked_movie + ".sav")
+        movie = pathlib.Path(linked_movie)
+
+    cmd = [binary, "-u", user_dir, "-p", "headless", "--movie", str(movie), "--verify_frames",
+           frames, "-e", str(game)]
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True,
+                            timeout=args.timeout)
+    if result.returncode != 0:
+        raise RuntimeError(f"{' '.join(cmd)} failed:\n{result.stderr}")
+
+    hashes = {}
+    for line in result.stdout.splitlines():
+        if line.startswith("{"):
+            report = json.loads(line)
+            hashes[report["frame"]] = {"ram": report["ram"], "exram": report["exram"]}
+    if not hashes:
+        raise RuntimeError(f"{' '.join(cmd)} hashed no frames:\n{result.stderr}")
+    return hashes
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Play movies branching from one savestate in parallel and hash their RAM")
+    parser.add_argument("movies", type=pathlib.Path, nargs="+", help="movies to play")
+    parser.add_argument("--binary", required=True, help="dolphin-emu-nogui to run")
+    parser.add_argument("--game", required=True, type=pathlib.Path, help="game of the movies")
+    parser.add_argument("--frames", required=True,
+                        help="comma separated frames at which the RAM is hashed")
+    parser.add_argument("--state", type=pathlib.Path,
+                        help="savestate all movies start from, instead of their own")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(),
+                        help="number of Dolphin processes running at the same time")
+    parser.add_argument("--output", help="file to write the hashes to instead of stdout")
+    parser.add_argument("--timeout", type=float, default=600, help="timeout of one movie in s")
+    args = parser.parse_args()
+
+    # Every process gets a fresh user directory, so the branches can't affect each other
+    work_dir = tempfile.mkdtemp(prefix="run-branches-")
+    results = {}
+    failures = 0
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        futures = {
+            executor.submit(run, args.binary, args.game, movie, args.frames,
+                            os.path.join(work_dir, str(i)), args): str(movie)
+            for i, movie in enumerate(args.movies)
+        }
+        for future in concurrent.futures.as_completed(futures):
+            name = futures[future]
+            try:
+                results[name] = future.result()
+            except (RuntimeError, subprocess.TimeoutExpired) as e:
+                print(f"{name}: FAIL\n{e}", file=sys.stderr)
+                failures += 1
+    shutil.rmtree(work_dir)
+
+    report = json.dumps({name: results[name] for name in sorted(results)}, indent=2)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(report + "\n")
+    else:
+        print(report)
+
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+
+# Compares two instruction traces written by dolphin-emu-nogui --instruction_trace and prints the
+# first entry at which they diverge, with the entries which led up to it. The format is described
+# in Source/Core/Core/PowerPC/InstructionTrace.h.
+#
+# Entries are matched by their number, counted from the start of the recording, so both traces
+# must start at the same point, e.g. the start of a movie. When the ring buffer of a trace dropped
+# its oldest entries, only the entries which are in both traces are compared.
+#
+# Example: find where a movie desyncs between two builds
+#
+# $ dolphin-emu-nogui -p headless --movie run.dtm --instruction_trace good.trace -e game.rvz
+# $ dolphin-emu-nogui -p headless --movie run.dtm --instruction_trace bad.trace -e game.rvz
+# $ Tools/trace-diff.py good.trace bad.trace
+
+import argparse
+import collections
+import struct
+import sys
+
+MAGIC = b"DTRC"
+VERSION = 1
+
+FLAG_PC = 1 << 0
+FLAG_EFFECTIVE_ADDRESS = 1 << 1
+FLAG_FPRS = 1 << 2
+GPR_COUNT_SHIFT = 4
+GPR_COUNT_EXTENDED = 15
+
+
+def read_entries(path):
+    """Yields (number, pc, effective address or None, GPR writes, FPR writes) for each entry."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[0:4] != MAGIC:
+        raise ValueError(f"{path} is not an instruction trace")
+    (version,) = struct.unpack_from("<I", data, 4)
+    if version != VERSION:
+        raise ValueError(f"{path} has the unsupported version {version}")
+
+    offset = 8
+    while offset < len(data):
+        number, num_entries, size = struct.unpack_from("<QII", data, offset)
+        offset += 16
+        end = offset + size
+        pc = 0
+        for _ in range(num_entries):
+            flags = data[offset]
+            offset += 1
+            if flags & FLAG_PC:
+                (pc,) = struct.unpack_from("<I", data, offset)
+                offset += 4
+            else:
+                pc += 4
+            ea = None
+            if flags & FLAG_EFFECTIVE_ADDRESS:
+                (ea,) = struct.unpack_from("<I", data, offset)
+                offset += 4
+            num_gprs = flags >> GPR_COUNT_SHIFT
+            if num_gprs == GPR_COUNT_EXTENDED:
+                num_gprs = data[offset]
+                offset += 1
+            num_fprs = 0
+            if flags & FLAG_FPRS:
+                num_fprs = data[offset]
+                offset += 1
+            gprs = []
+            for _ in range(num_gprs):
+                gprs.append(struct.unpack_from("<BI", data, offset))
+                offset += 5
+            fprs = []
+            for _ in range(num_fprs):
+                fprs.append(struct.unpack_from("<BQQ", data, offset))
+                offset += 17
+            yield number, pc & 0xFFFFFFFF, ea, tuple(gprs), tuple(fprs)
+            number += 1
+        if offset != end:
+            raise ValueError(f"{path} has a corrupted chunk")
+
+
+def format_entry(entry):
+    number, pc, ea, gprs, fprs = entry
+    text = f"{number:>12} {pc:08x}"
+    if ea is not None:
+        text += f" ea={ea:08x}"
+    for reg, value in gprs:
+        text += f" r{reg}={value:08x}"
+    for reg, ps0, ps1 in fprs:
+        text += f" f{reg}={ps0:016x},{ps1:016x}"
+    return text
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Find the first divergence of two instruction traces")
+    parser.add_argument("first", help="first trace")
+    parser.add_argument("second", help="second trace")
+    parser.add_argument("--context", type=int, default=16,
+                        help="number of matching entries to print before the divergence")
+    args = parser.parse_args()
+
+    first = read_entries(args.first)
+    second = read_entries(args.second)
+    a = next(first, None)
+    b = next(second, None)
+
+    # Skip the entries which were dropped from the ring buffer of the other trace
+    while a is not None and b is not None and a[0] != b[0]:
+        if a[0] < b[0]:
+            a = next(first, None)
+        else:
+            b = next(second, None)
+
+    context = collections.deque(maxlen=args.context)
+    compared = 0
+    while a is not None and b is not None:
+        if a != b:
+            print(f"Traces diverge after {compared} matching entries")
+            for entry in context:
+                print(f"  {format_entry(entry)}")
+            print(f"- {format_entry(a)}")
+            print(f"+ {format_entry(b)}")
+            sys.exit(1)
+        context.append(a)
+        compared += 1
+        a = next(first, None)
+        b = next(second, None)
+
+    if a is not None or b is not None:
+        longer = args.first if a is not None else args.second
+        print(f"Traces match for {compared} entries, then {longer} continues")
+        sys.exit(1)
+    print(f"Traces match for {compared} entries")
+
+
+if __name__ == "__main__":
+    main()